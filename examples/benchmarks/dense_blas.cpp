@@ -126,6 +126,20 @@ void bench(size_t BLAS1_N, size_t BLAS2_M, size_t BLAS2_N, size_t BLAS3_M, size_
     BENCHMARK_OP(lu_factorize(A),                "LU-FACTORIZE", int(2*BLAS3_M*BLAS3_K*BLAS3_K/time_spent*1e-9), "GFLOPs/s");
   }
 
+  //BLAS3, row-major layout and mixed layouts (packing in the host backend makes all combinations run at the same rate)
+  {
+    viennacl::matrix<T,viennacl::row_major> C(BLAS3_M, BLAS3_N);
+    viennacl::matrix<T,viennacl::row_major> A(BLAS3_M, BLAS3_K);
+    viennacl::matrix<T,viennacl::row_major> B(BLAS3_K, BLAS3_N);
+    viennacl::matrix<T,viennacl::column_major> B_col(BLAS3_K, BLAS3_N);
+    init_random(A);
+    init_random(B);
+    init_random(B_col);
+
+    BENCHMARK_OP(C = prod(A, B),                 "GEMM-NN-ROW",  int(2*BLAS3_M*BLAS3_N*BLAS3_K/time_spent*1e-9), "GFLOPs/s");
+    BENCHMARK_OP(C = prod(A, B_col),             "GEMM-NN-MIX",  int(2*BLAS3_M*BLAS3_N*BLAS3_K/time_spent*1e-9), "GFLOPs/s");
+  }
+
 
 }
 
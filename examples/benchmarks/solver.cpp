@@ -49,7 +49,7 @@
 #include "viennacl/linalg/jacobi_precond.hpp"
 #include "viennacl/linalg/row_scaling.hpp"
 
-#ifdef VIENNACL_WITH_OPENCL
+#ifndef VIENNACL_WITH_CUDA
   #include "viennacl/linalg/mixed_precision_cg.hpp"
 #endif
 
@@ -394,7 +394,7 @@ int run_benchmark(viennacl::context ctx)
   std::cout << "------- CG solver (no preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
   run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, cg_solver, viennacl::linalg::no_precond(), cg_ops);
 
-#ifdef VIENNACL_WITH_OPENCL
+#ifndef VIENNACL_WITH_CUDA
   if (sizeof(ScalarType) == sizeof(double))
   {
     std::cout << "------- CG solver, mixed precision (no preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
@@ -27,6 +27,8 @@
 // *** System
 //
 #include <iostream>
+#include <vector>
+#include <string>
 
 // We don't need debug mode in UBLAS:
 #define BOOST_UBLAS_NDEBUG
@@ -52,9 +54,11 @@
 #include "viennacl/matrix.hpp"
 #include "viennacl/matrix_proxy.hpp"
 #include "viennacl/vector.hpp"
+#include "viennacl/vector_proxy.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/linalg/batched_operations.hpp"
 #include "examples/tutorial/Random.hpp"
 //
 // -------------------------------------------------------------
@@ -473,6 +477,207 @@ int test_solve(Epsilon const& epsilon)
 
 
 
+template< typename NumericT, typename F_A, typename F_B, typename Epsilon >
+int test_solve_sizes(Epsilon const& epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+  // sizes around the block size of the recursive host solver, and right hand side counts for a single thread and for several threads
+  std::size_t matrix_sizes[] = {1, 32, 33, 97, 260};
+  std::size_t rhs_nums[] = {1, 5, 150};
+
+  std::cout << "--- Part 3: Testing matrix-matrix solver for various sizes ---" << std::endl;
+
+  for (std::size_t i = 0; i < sizeof(matrix_sizes) / sizeof(matrix_sizes[0]); ++i)
+  {
+    for (std::size_t j = 0; j < sizeof(rhs_nums) / sizeof(rhs_nums[0]); ++j)
+    {
+      std::size_t matrix_size = matrix_sizes[i];
+      std::size_t rhs_num = rhs_nums[j];
+
+      ublas::matrix<NumericT> A(matrix_size, matrix_size);
+      ublas::matrix<NumericT> B(matrix_size, rhs_num);
+      for (std::size_t row = 0; row < A.size1(); ++row)
+      {
+        for (std::size_t col = 0; col < A.size2(); ++col)
+          A(row, col) = static_cast<NumericT>(-0.5) * random<NumericT>() / static_cast<NumericT>(matrix_size);
+        A(row, row) = NumericT(1.0) + NumericT(2.0) * random<NumericT>(); //some extra weight on diagonal for stability
+      }
+      for (std::size_t row = 0; row < B.size1(); ++row)
+        for (std::size_t col = 0; col < B.size2(); ++col)
+          B(row, col) = random<NumericT>();
+
+      viennacl::matrix<NumericT, F_A> vcl_A(matrix_size, matrix_size);
+      viennacl::matrix<NumericT, F_B> vcl_B(matrix_size, rhs_num);
+      viennacl::matrix<NumericT, F_B> vcl_result(matrix_size, rhs_num);
+      viennacl::copy(A, vcl_A);
+      viennacl::copy(B, vcl_B);
+
+      ublas::matrix<NumericT> result;
+      ublas::matrix<NumericT> A_trans = trans(A);
+
+      std::cout << " * " << matrix_size << "x" << matrix_size << ", " << rhs_num << " right hand sides, upper_tag:          ";
+      result = ublas::solve(A, B, ublas::upper_tag());
+      vcl_result = viennacl::linalg::solve(vcl_A, vcl_B, viennacl::linalg::upper_tag());
+      run_solver_check(result, vcl_result, retval, epsilon);
+
+      std::cout << " * " << matrix_size << "x" << matrix_size << ", " << rhs_num << " right hand sides, unit_lower_tag:     ";
+      result = ublas::solve(A, B, ublas::unit_lower_tag());
+      vcl_result = viennacl::linalg::solve(vcl_A, vcl_B, viennacl::linalg::unit_lower_tag());
+      run_solver_check(result, vcl_result, retval, epsilon);
+
+      std::cout << " * " << matrix_size << "x" << matrix_size << ", " << rhs_num << " right hand sides, A^T with lower_tag: ";
+      result = ublas::solve(A_trans, B, ublas::lower_tag());
+      vcl_result = viennacl::linalg::solve(trans(vcl_A), vcl_B, viennacl::linalg::lower_tag());
+      run_solver_check(result, vcl_result, retval, epsilon);
+    }
+  }
+
+  if (retval == EXIT_SUCCESS)
+    std::cout << "Test matrix-matrix solver for various sizes passed!" << std::endl;
+
+  return retval;
+}
+
+
+//
+// Batched solvers for many small systems
+//
+
+/** @brief Returns max_i |x_i - x_ref_i| / max_i |x_ref_i| over block 'b' of size n */
+template<typename NumericT>
+NumericT batched_block_diff(std::vector<NumericT> const & x, std::vector<NumericT> const & x_ref, std::size_t b, std::size_t n)
+{
+  NumericT max_diff = 0;
+  NumericT max_ref = 0;
+  for (std::size_t i = b * n; i < (b + 1) * n; ++i)
+  {
+    max_diff = std::max(max_diff, static_cast<NumericT>(std::fabs(x[i] - x_ref[i])));
+    max_ref  = std::max(max_ref,  static_cast<NumericT>(std::fabs(x_ref[i])));
+  }
+  return max_diff / max_ref;
+}
+
+/** @brief Checks the solutions of a batch in which the system 'singular_block' is singular with a zero last column */
+template<typename NumericT, typename Epsilon>
+void check_batched_solution(std::vector<NumericT> const & x, std::vector<NumericT> const & x_ref, std::vector<NumericT> const & b_ref,
+                            std::vector<unsigned int> const & info, std::size_t n, std::size_t batch_count, std::size_t singular_block,
+                            bool check_singular_rhs, std::string const & name, int & retval, Epsilon const & epsilon)
+{
+  for (std::size_t b = 0; b < batch_count; ++b)
+  {
+    if (b == singular_block)
+    {
+      if (info[b] != n)
+      {
+        std::cout << "# Error at operation: " << name << " (status of singular system)" << std::endl;
+        std::cout << "  n: " << n << ", expected status: " << n << ", got: " << info[b] << std::endl;
+        retval = EXIT_FAILURE;
+      }
+      if (check_singular_rhs && batched_block_diff(x, b_ref, b, n) > 0)
+      {
+        std::cout << "# Error at operation: " << name << " (right hand side of singular system modified)" << std::endl;
+        std::cout << "  n: " << n << std::endl;
+        retval = EXIT_FAILURE;
+      }
+      continue;
+    }
+
+    NumericT act_diff = batched_block_diff(x, x_ref, b, n);
+    if (info[b] != 0 || !(act_diff < epsilon))
+    {
+      std::cout << "# Error at operation: " << name << std::endl;
+      std::cout << "  n: " << n << ", system: " << b << ", status: " << info[b] << ", diff: " << act_diff << std::endl;
+      retval = EXIT_FAILURE;
+    }
+  }
+}
+
+template<typename NumericT, typename Epsilon>
+int test_batched_solve(Epsilon const & epsilon, std::size_t stride)
+{
+  int retval = EXIT_SUCCESS;
+  viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+
+  std::size_t sizes[] = {2, 3, 5, 8, 27, 64};
+  std::size_t batch_count = 7;
+  std::size_t singular_block = 3;
+
+  for (std::size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+  {
+    std::size_t n = sizes[s];
+
+    std::vector<NumericT> matrices(n * n * batch_count);
+    std::vector<NumericT> x_ref(n * batch_count);
+    std::vector<NumericT> b_ref(n * batch_count);
+    for (std::size_t b = 0; b < batch_count; ++b)
+    {
+      NumericT * A = &(matrices[b * n * n]);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        for (std::size_t j = 0; j < n; ++j)
+          A[i * n + j] = static_cast<NumericT>(-0.5) * random<NumericT>();
+        A[i * n + i] = NumericT(1.0) + NumericT(2.0) * random<NumericT>(); //some extra weight on diagonal for stability
+        x_ref[b * n + i] = NumericT(1.0) + random<NumericT>();
+      }
+      if (b == singular_block)  // zero last column: the last diagonal entry of U and R vanishes
+        for (std::size_t i = 0; i < n; ++i)
+          A[i * n + n - 1] = 0;
+
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        NumericT value = 0;
+        for (std::size_t j = 0; j < n; ++j)
+          value += A[i * n + j] * x_ref[b * n + j];
+        b_ref[b * n + i] = value;
+      }
+    }
+
+    viennacl::vector<NumericT>     vcl_matrices_storage(stride * matrices.size(), host_ctx);
+    viennacl::vector<NumericT>     vcl_rhs_storage(stride * b_ref.size(), host_ctx);
+    viennacl::vector_slice< viennacl::vector<NumericT> > vcl_matrices(vcl_matrices_storage, viennacl::slice(0, stride, matrices.size()));
+    viennacl::vector_slice< viennacl::vector<NumericT> > vcl_rhs(vcl_rhs_storage, viennacl::slice(stride - 1, stride, b_ref.size()));
+    viennacl::vector<unsigned int> vcl_pivots(n * batch_count, host_ctx);
+    viennacl::vector<NumericT>     vcl_tau(n * batch_count, host_ctx);
+    viennacl::vector<unsigned int> vcl_info(batch_count, host_ctx);
+
+    std::vector<NumericT>     x(b_ref.size());
+    std::vector<unsigned int> info(batch_count);
+
+    // LU factorization, then substitution:
+    viennacl::copy(matrices, vcl_matrices);
+    viennacl::copy(b_ref, vcl_rhs);
+    viennacl::linalg::batched_lu_factorize(vcl_matrices, vcl_pivots, n, batch_count, vcl_info);
+    viennacl::linalg::batched_lu_substitute(vcl_matrices, vcl_pivots, vcl_rhs, n, batch_count);
+    viennacl::copy(vcl_rhs, x);
+    viennacl::copy(vcl_info, info);
+    check_batched_solution(x, x_ref, b_ref, info, n, batch_count, singular_block, false, "batched_lu_factorize/batched_lu_substitute", retval, epsilon);
+
+    // LU factorization and substitution in one pass:
+    viennacl::copy(matrices, vcl_matrices);
+    viennacl::copy(b_ref, vcl_rhs);
+    viennacl::linalg::batched_lu_solve(vcl_matrices, vcl_rhs, n, batch_count, vcl_info);
+    viennacl::copy(vcl_rhs, x);
+    viennacl::copy(vcl_info, info);
+    check_batched_solution(x, x_ref, b_ref, info, n, batch_count, singular_block, true, "batched_lu_solve", retval, epsilon);
+
+    // QR factorization, then solve:
+    viennacl::copy(matrices, vcl_matrices);
+    viennacl::copy(b_ref, vcl_rhs);
+    viennacl::linalg::batched_qr_factorize(vcl_matrices, vcl_tau, n, batch_count, vcl_info);
+    viennacl::linalg::batched_qr_solve(vcl_matrices, vcl_tau, vcl_rhs, n, batch_count);
+    viennacl::copy(vcl_rhs, x);
+    viennacl::copy(vcl_info, info);
+    check_batched_solution(x, x_ref, b_ref, info, n, batch_count, singular_block, false, "batched_qr_factorize/batched_qr_solve", retval, epsilon);
+  }
+
+  if (retval == EXIT_SUCCESS)
+    std::cout << "Test batched LU/QR (stride " << stride << ") passed!" << std::endl;
+
+  return retval;
+}
+
+
 //
 // Control functions
 //
@@ -489,12 +694,18 @@ int test(Epsilon const& epsilon)
   ret = test_solve<NumericT, viennacl::row_major, viennacl::row_major>(epsilon);
   if (ret != EXIT_SUCCESS)
     return ret;
+  ret = test_solve_sizes<NumericT, viennacl::row_major, viennacl::row_major>(epsilon);
+  if (ret != EXIT_SUCCESS)
+    return ret;
 
 
   std::cout << "////////////////////////////////" << std::endl;
   std::cout << "/// Now testing A=row, B=col ///" << std::endl;
   std::cout << "////////////////////////////////" << std::endl;
   ret = test_solve<NumericT, viennacl::row_major, viennacl::column_major>(epsilon);
+  if (ret != EXIT_SUCCESS)
+    return ret;
+  ret = test_solve_sizes<NumericT, viennacl::row_major, viennacl::column_major>(epsilon);
   if (ret != EXIT_SUCCESS)
     return ret;
 
@@ -502,6 +713,9 @@ int test(Epsilon const& epsilon)
   std::cout << "/// Now testing A=col, B=row ///" << std::endl;
   std::cout << "////////////////////////////////" << std::endl;
   ret = test_solve<NumericT, viennacl::column_major, viennacl::row_major>(epsilon);
+  if (ret != EXIT_SUCCESS)
+    return ret;
+  ret = test_solve_sizes<NumericT, viennacl::column_major, viennacl::row_major>(epsilon);
   if (ret != EXIT_SUCCESS)
     return ret;
 
@@ -511,6 +725,20 @@ int test(Epsilon const& epsilon)
   ret = test_solve<NumericT, viennacl::column_major, viennacl::column_major>(epsilon);
   if (ret != EXIT_SUCCESS)
     return ret;
+  ret = test_solve_sizes<NumericT, viennacl::column_major, viennacl::column_major>(epsilon);
+  if (ret != EXIT_SUCCESS)
+    return ret;
+
+  std::cout << "////////////////////////////////" << std::endl;
+  std::cout << "/// Now testing batched LU/QR ///" << std::endl;
+  std::cout << "////////////////////////////////" << std::endl;
+  ret = test_batched_solve<NumericT>(epsilon, 1);
+  if (ret != EXIT_SUCCESS)
+    return ret;
+
+  ret = test_batched_solve<NumericT>(epsilon, 3);
+  if (ret != EXIT_SUCCESS)
+    return ret;
 
 
 
@@ -985,6 +985,98 @@ int run_test(double epsilon)
         std::cout << std::endl << "TEST failed!" << std::endl;
         return EXIT_FAILURE;
       }
+
+      // non-square transposes into both layouts:
+      MatrixType ublas_A_trans = trans(ublas_A);
+
+      std::cout << "Testing row-major matrix created from transposed matrix... ";
+      viennacl::matrix<ScalarType, viennacl::row_major> vcl_trans_row = viennacl::trans(vcl_A);
+      if (!check_for_equality(ublas_A_trans, vcl_trans_row, epsilon))
+        return EXIT_FAILURE;
+
+      std::cout << "Testing column-major matrix created from transposed matrix... ";
+      viennacl::matrix<ScalarType, viennacl::column_major> vcl_trans_col = viennacl::trans(vcl_A);
+      if (!check_for_equality(ublas_A_trans, vcl_trans_col, epsilon))
+        return EXIT_FAILURE;
+
+      std::cout << "Testing row-major matrix created from transposed range... ";
+      viennacl::matrix<ScalarType, viennacl::row_major> vcl_trans_range = viennacl::trans(vcl_range_A);
+      if (!check_for_equality(ublas_A_trans, vcl_trans_range, epsilon))
+        return EXIT_FAILURE;
+
+      std::cout << "Testing column-major matrix created from transposed slice... ";
+      viennacl::matrix<ScalarType, viennacl::column_major> vcl_trans_slice = viennacl::trans(vcl_slice_A);
+      if (!check_for_equality(ublas_A_trans, vcl_trans_slice, epsilon))
+        return EXIT_FAILURE;
+
+      std::cout << "Testing assignment of transposed matrix to empty matrix... ";
+      viennacl::matrix<ScalarType, viennacl::column_major> vcl_trans_empty;
+      vcl_trans_empty = viennacl::trans(vcl_A);
+      if (!check_for_equality(ublas_A_trans, vcl_trans_empty, epsilon))
+        return EXIT_FAILURE;
+
+      std::cout << "Testing assignment of transposed slice to row-major matrix... ";
+      vcl_trans_row.clear();
+      vcl_trans_row = viennacl::trans(vcl_slice_A);
+      if (!check_for_equality(ublas_A_trans, vcl_trans_row, epsilon))
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "//" << std::endl;
+    std::cout << "////////// Test: In-place transposition //////////" << std::endl;
+    std::cout << "//" << std::endl;
+
+    {
+      // square sizes which are not multiples of the tile size, with partial tiles at the boundary:
+      std::size_t trans_dims[] = {45, 131};
+      for (std::size_t k=0; k<sizeof(trans_dims) / sizeof(trans_dims[0]); ++k)
+      {
+        std::size_t n = trans_dims[k];
+        MatrixType ublas_square(n, n);
+        for (std::size_t i=0; i<n; ++i)
+          for (std::size_t j=0; j<n; ++j)
+            ublas_square(i,j) = ScalarType(i * n + j);
+        MatrixType ublas_square_trans = trans(ublas_square);
+
+        VCLMatrixType vcl_square(n, n);
+        viennacl::copy(ublas_square, vcl_square);
+
+        std::cout << "Testing inplace_trans() of " << n << "x" << n << " matrix... ";
+        viennacl::linalg::inplace_trans(vcl_square);
+        if (!check_for_equality(ublas_square_trans, vcl_square, epsilon))
+          return EXIT_FAILURE;
+
+        std::cout << "Testing A = trans(A) of " << n << "x" << n << " matrix... ";
+        vcl_square = viennacl::trans(vcl_square);
+        if (!check_for_equality(ublas_square, vcl_square, epsilon))
+          return EXIT_FAILURE;
+
+        // square slice of a larger matrix: entries outside of the slice must not change
+        MatrixType ublas_full(2 * n + 1, 3 * n);
+        for (std::size_t i=0; i<ublas_full.size1(); ++i)
+          for (std::size_t j=0; j<ublas_full.size2(); ++j)
+            ublas_full(i,j) = -ScalarType(i * ublas_full.size2() + j);
+        VCLMatrixType vcl_full(ublas_full.size1(), ublas_full.size2());
+        viennacl::copy(ublas_full, vcl_full);
+
+        viennacl::slice vcl_s1(1, 2, n);
+        viennacl::slice vcl_s2(0, 3, n);
+        viennacl::matrix_slice<VCLMatrixType> vcl_slice_square(vcl_full, vcl_s1, vcl_s2);
+        MatrixType ublas_full_trans = ublas_full;
+        for (std::size_t i=0; i<n; ++i)
+          for (std::size_t j=0; j<n; ++j)
+            ublas_full_trans(1 + 2 * i, 3 * j) = ublas_full(1 + 2 * j, 3 * i);
+
+        std::cout << "Testing inplace_trans() of " << n << "x" << n << " slice... ";
+        viennacl::linalg::inplace_trans(vcl_slice_square);
+        if (!check_for_equality(ublas_full_trans, vcl_full, epsilon))
+          return EXIT_FAILURE;
+
+        std::cout << "Testing A = trans(A) of " << n << "x" << n << " slice... ";
+        vcl_slice_square = viennacl::trans(vcl_slice_square);
+        if (!check_for_equality(ublas_full, vcl_full, epsilon))
+          return EXIT_FAILURE;
+      }
     }
 
     std::cout << "//" << std::endl;
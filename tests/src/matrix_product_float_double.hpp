@@ -194,6 +194,20 @@ void init_rand(MatrixType & A)
       A(i, j) = static_cast<T>(0.1) * random<T>();
 }
 
+template<typename T>
+int test_block_boundaries(int M, int N, int K, T epsilon)
+{
+  ublas::matrix<T> A(M, K), B(K, N), C(M, N);
+  init_rand(A);
+  init_rand(B);
+  init_rand(C);
+  ublas::matrix<T> AT = ublas::trans(A);
+  ublas::matrix<T> BT = ublas::trans(B);
+
+  std::cout << ">> matrix = matrix.matrix, M = " << M << ", N = " << N << ", K = " << K << std::endl;
+  return test_all_layouts<T>(M, N, C, M, K, A, AT, K, N, B, BT, epsilon);
+}
+
 template<typename T>
 int run_test(T epsilon)
 {
@@ -301,6 +315,16 @@ int run_test(T epsilon)
 
 #undef TEST_ALL_LAYOUTS
 
+    // sizes which are not multiples of the register and cache blocks of the host GEMM, including K larger than KC:
+    if (test_block_boundaries<T>(1, 1, 1, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (test_block_boundaries<T>(3, 17, 1, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (test_block_boundaries<T>(257, 35, 397, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (test_block_boundaries<T>(29, 301, 785, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
     return EXIT_SUCCESS;
 }
 
@@ -49,6 +49,7 @@
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
 #include "viennacl/linalg/lu.hpp"
+#include "viennacl/linalg/cholesky.hpp"
 #include "examples/tutorial/Random.hpp"
 
 //
@@ -1047,6 +1048,120 @@ int test(Epsilon const& epsilon)
       retval = EXIT_FAILURE;
    }
 
+   ////////////// LU decomposition with partial pivoting:
+
+   std::cout << "Full solver with partial pivoting" << std::endl;
+   // three panels of 128 columns, so that the look-ahead update of the trailing columns is exercised:
+   unsigned int pivot_dim = 300;
+   unsigned int pivot_rhs_num = 3;
+   ublas::matrix<NumericT> pivot_matrix(pivot_dim, pivot_dim);
+   ublas::vector<NumericT> pivot_rhs(pivot_dim);
+   ublas::matrix<NumericT> pivot_rhs_matrix(pivot_dim, pivot_rhs_num);
+   viennacl::matrix<NumericT, F> vcl_pivot_matrix(pivot_dim, pivot_dim);
+   viennacl::vector<NumericT> vcl_pivot_rhs(pivot_dim);
+   viennacl::matrix<NumericT, F> vcl_pivot_rhs_matrix(pivot_dim, pivot_rhs_num);
+
+   //small off-diagonal entries keep the matrix well conditioned, so that the comparison in single precision does not depend on the random entries:
+   for (std::size_t i=0; i<pivot_dim; ++i)
+     for (std::size_t j=0; j<pivot_dim; ++j)
+       pivot_matrix(i,j) = -static_cast<NumericT>(0.05) * random<NumericT>();
+
+   //put large weights on a shifted diagonal, hence rows need to be interchanged:
+   for (std::size_t j=0; j<pivot_dim; ++j)
+   {
+     pivot_matrix(j, (j + 1) % pivot_dim) = static_cast<NumericT>(20.0) + random<NumericT>();
+     pivot_rhs(j) = random<NumericT>();
+     for (std::size_t k=0; k<pivot_rhs_num; ++k)
+       pivot_rhs_matrix(j, k) = random<NumericT>();
+   }
+
+   viennacl::copy(pivot_matrix, vcl_pivot_matrix);
+   viennacl::copy(pivot_rhs, vcl_pivot_rhs);
+   viennacl::copy(pivot_rhs_matrix, vcl_pivot_rhs_matrix);
+
+   //ublas::
+   ublas::permutation_matrix<std::size_t> ublas_pivots(pivot_dim);
+   ublas::lu_factorize(pivot_matrix, ublas_pivots);
+   ublas::lu_substitute(pivot_matrix, ublas_pivots, pivot_rhs);
+   ublas::lu_substitute(pivot_matrix, ublas_pivots, pivot_rhs_matrix);
+
+   // ViennaCL:
+   viennacl::vector<unsigned int> vcl_pivots(pivot_dim);
+   viennacl::linalg::lu_factorize(vcl_pivot_matrix, vcl_pivots);
+   viennacl::linalg::lu_substitute(vcl_pivot_matrix, vcl_pivots, vcl_pivot_rhs);
+   viennacl::linalg::lu_substitute(vcl_pivot_matrix, vcl_pivots, vcl_pivot_rhs_matrix);
+
+   if ( std::fabs(diff(pivot_rhs, vcl_pivot_rhs)) > epsilon )
+   {
+      std::cout << "# Error at operation: dense solver with partial pivoting" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(pivot_rhs, vcl_pivot_rhs)) << std::endl;
+      retval = EXIT_FAILURE;
+   }
+
+   if ( std::fabs(diff(pivot_rhs_matrix, vcl_pivot_rhs_matrix)) > epsilon )
+   {
+      std::cout << "# Error at operation: dense solver with partial pivoting and multiple right hand sides" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(pivot_rhs_matrix, vcl_pivot_rhs_matrix)) << std::endl;
+      retval = EXIT_FAILURE;
+   }
+
+   ////////////// Cholesky decomposition:
+
+   std::cout << "Cholesky solver" << std::endl;
+   // several block columns, the last one incomplete:
+   std::size_t cholesky_block_size = viennacl::linalg::detail::cholesky_blocking::block_size;
+   std::size_t cholesky_dim = 3 * cholesky_block_size + 17;
+   ublas::matrix<NumericT> cholesky_factor(cholesky_dim, cholesky_dim);
+   ublas::vector<NumericT> cholesky_rhs(cholesky_dim);
+   viennacl::matrix<NumericT, F> vcl_cholesky_matrix(cholesky_dim, cholesky_dim);
+   viennacl::vector<NumericT> vcl_cholesky_rhs(cholesky_dim);
+
+   for (std::size_t i=0; i<cholesky_dim; ++i)
+     for (std::size_t j=0; j<cholesky_dim; ++j)
+       cholesky_factor(i,j) = static_cast<NumericT>(0.1) * random<NumericT>();
+
+   for (std::size_t j=0; j<cholesky_dim; ++j)
+     cholesky_rhs(j) = random<NumericT>();
+
+   //symmetric positive definite system matrix:
+   ublas::matrix<NumericT> cholesky_matrix = ublas::prod(cholesky_factor, ublas::trans(cholesky_factor));
+   for (std::size_t j=0; j<cholesky_dim; ++j)
+     cholesky_matrix(j,j) += static_cast<NumericT>(20.0);
+
+   viennacl::copy(cholesky_matrix, vcl_cholesky_matrix);
+   viennacl::copy(cholesky_rhs, vcl_cholesky_rhs);
+   ublas::matrix<NumericT> cholesky_matrix_start = cholesky_matrix;
+
+   //ublas::
+   ublas::lu_factorize(cholesky_matrix);
+   ublas::inplace_solve (cholesky_matrix, cholesky_rhs, ublas::unit_lower_tag ());
+   ublas::inplace_solve (cholesky_matrix, cholesky_rhs, ublas::upper_tag ());
+
+   // ViennaCL:
+   viennacl::linalg::cholesky_factorize(vcl_cholesky_matrix);
+   viennacl::linalg::cholesky_substitute(vcl_cholesky_matrix, vcl_cholesky_rhs);
+
+   if ( std::fabs(diff(cholesky_rhs, vcl_cholesky_rhs)) > epsilon )
+   {
+      std::cout << "# Error at operation: Cholesky solver" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(cholesky_rhs, vcl_cholesky_rhs)) << std::endl;
+      retval = EXIT_FAILURE;
+   }
+
+   // the strict upper triangle is left unchanged, also within the diagonal blocks:
+   ublas::matrix<NumericT> cholesky_result(cholesky_dim, cholesky_dim);
+   viennacl::copy(vcl_cholesky_matrix, cholesky_result);
+   bool upper_modified = false;
+   for (std::size_t i=0; i<cholesky_dim; ++i)
+     for (std::size_t j=i+1; j<cholesky_dim; ++j)
+       if ( cholesky_result(i,j) != cholesky_matrix_start(i,j) )
+         upper_modified = true;
+   if (upper_modified)
+   {
+      std::cout << "# Error at operation: Cholesky factorization (upper triangle modified)" << std::endl;
+      retval = EXIT_FAILURE;
+   }
+
 
 
    return retval;
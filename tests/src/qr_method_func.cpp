@@ -44,6 +44,7 @@
 #include "viennacl/linalg/qr-method.hpp"
 #include "viennacl/linalg/qr-method-common.hpp"
 #include "viennacl/linalg/matrix_operations.hpp"
+#include "viennacl/linalg/qr.hpp"
 #include "Random.hpp"
 
 #define EPS 10.0e-3
@@ -387,6 +388,163 @@ void test_qr_method_sym(const std::string& fn)
 //--------------------------------------------------------
 }
 
+/** @brief Returns the largest deviation of the entries of 'A' from those of 'B', relative to the largest entry of 'B' */
+ScalarType max_relative_diff(ublas::matrix<ScalarType> const & A, ublas::matrix<ScalarType> const & B)
+{
+  ScalarType max_diff = 0;
+  ScalarType max_entry = 0;
+  for (std::size_t i=0; i<B.size1(); ++i)
+    for (std::size_t j=0; j<B.size2(); ++j)
+    {
+      max_diff  = std::max(max_diff, std::abs(A(i,j) - B(i,j)));
+      max_entry = std::max(max_entry, std::abs(B(i,j)));
+    }
+  return max_diff / max_entry;
+}
+
+template <typename MatrixLayout>
+void test_qr_factorization(std::size_t rows, std::size_t cols, std::size_t block_size)
+{
+  std::cout << "Testing matrix of size " << rows << "-by-" << cols << " with panel width " << block_size << std::endl;
+
+  ublas::matrix<ScalarType> ubl_A(rows, cols);
+  for (std::size_t i=0; i<rows; ++i)
+    for (std::size_t j=0; j<cols; ++j)
+      ubl_A(i,j) = random<ScalarType>();
+
+  std::vector<ScalarType> std_b(rows);
+  fill_vector(std_b);
+
+  viennacl::matrix<ScalarType, MatrixLayout> vcl_A(rows, cols);
+  viennacl::copy(ubl_A, vcl_A);
+  std::vector<ScalarType> betas = viennacl::linalg::inplace_qr(vcl_A, block_size);
+
+  ublas::matrix<ScalarType> ubl_QR(rows, cols), ubl_Q(rows, rows), ubl_R(rows, cols);
+  viennacl::copy(vcl_A, ubl_QR);
+  viennacl::linalg::recoverQ(ubl_QR, betas, ubl_Q, ubl_R);
+
+  //--------------------------------------------------------
+  std::cout << std::endl << "Testing inplace_qr: A = QR..." << std::endl;
+  ublas::matrix<ScalarType> ubl_QR_prod = ublas::prod(ubl_Q, ubl_R);
+  if (max_relative_diff(ubl_QR_prod, ubl_A) > EPS)
+  {
+    std::cout << "Relative deviation: " << max_relative_diff(ubl_QR_prod, ubl_A) << std::endl << "TEST failed!" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  std::cout << "PASSED!" << std::endl;
+
+  //--------------------------------------------------------
+  std::cout << std::endl << "Testing inplace_qr: Q^T Q = I..." << std::endl;
+  ublas::matrix<ScalarType> ubl_QTQ = ublas::prod(ublas::trans(ubl_Q), ubl_Q);
+  ublas::matrix<ScalarType> ubl_I = ublas::identity_matrix<ScalarType>(rows);
+  if (max_relative_diff(ubl_QTQ, ubl_I) > EPS)
+  {
+    std::cout << "Relative deviation: " << max_relative_diff(ubl_QTQ, ubl_I) << std::endl << "TEST failed!" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  std::cout << "PASSED!" << std::endl;
+
+  //--------------------------------------------------------
+  std::cout << std::endl << "Testing inplace_qr_apply_trans_Q..." << std::endl;
+  viennacl::vector<ScalarType> vcl_b(rows);
+  viennacl::copy(std_b, vcl_b);
+  viennacl::linalg::inplace_qr_apply_trans_Q(vcl_A, betas, vcl_b);
+  ublas::vector<ScalarType> ubl_b(rows);
+  std::copy(std_b.begin(), std_b.end(), ubl_b.begin());
+  ublas::vector<ScalarType> ubl_QTb = ublas::prod(ublas::trans(ubl_Q), ubl_b);
+  std::vector<ScalarType> std_QTb(ubl_QTb.begin(), ubl_QTb.end()), std_QTb_vcl(rows);
+  viennacl::copy(vcl_b, std_QTb_vcl);
+  if (!check_for_equality(std_QTb, std_QTb_vcl))
+    exit(EXIT_FAILURE);
+
+  //--------------------------------------------------------
+  // TSQR with small row blocks, such that the reduction tree has several levels:
+  std::cout << std::endl << "Testing inplace_tsqr: R agrees with inplace_qr up to the signs of the rows..." << std::endl;
+  viennacl::matrix<ScalarType, MatrixLayout> vcl_A_tsqr(rows, cols);
+  viennacl::copy(ubl_A, vcl_A_tsqr);
+  viennacl::linalg::tsqr_factors<ScalarType> factors(2 * cols);
+  viennacl::linalg::inplace_tsqr(vcl_A_tsqr, factors);
+
+  ublas::matrix<ScalarType> ubl_A_tsqr(rows, cols);
+  viennacl::copy(vcl_A_tsqr, ubl_A_tsqr);
+  ublas::matrix<ScalarType> ubl_R_tsqr(cols, cols), ubl_R_qr(cols, cols);
+  for (std::size_t i=0; i<cols; ++i)
+    for (std::size_t j=0; j<cols; ++j)
+    {
+      ScalarType sign = (ubl_A_tsqr(i,i) * ubl_R(i,i) < 0) ? ScalarType(-1) : ScalarType(1);
+      ubl_R_tsqr(i,j) = (j < i) ? 0 : sign * ubl_A_tsqr(i,j);
+      ubl_R_qr(i,j)   = ubl_R(i,j);
+    }
+  if ((rows >= 16 * cols && factors.betas.size() < 3) || max_relative_diff(ubl_R_tsqr, ubl_R_qr) > EPS)
+  {
+    std::cout << "Levels: " << factors.betas.size() << ", relative deviation: " << max_relative_diff(ubl_R_tsqr, ubl_R_qr) << std::endl << "TEST failed!" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  std::cout << "PASSED!" << std::endl;
+
+  //--------------------------------------------------------
+  std::cout << std::endl << "Testing inplace_tsqr_apply_trans_Q: least-squares residual is orthogonal to the columns of A..." << std::endl;
+  std::vector<ScalarType> std_x = std_b;
+  viennacl::linalg::inplace_tsqr_apply_trans_Q(vcl_A_tsqr, factors, std_x);
+  std_x.resize(cols);
+  for (std::size_t i2=0; i2<cols; ++i2)   // back substitution R x = (Q^T b)(0:n)
+  {
+    std::size_t i = cols - i2 - 1;
+    for (std::size_t j=i+1; j<cols; ++j)
+      std_x[i] -= ubl_A_tsqr(i,j) * std_x[j];
+    std_x[i] /= ubl_A_tsqr(i,i);
+  }
+  ublas::vector<ScalarType> ubl_x(cols);
+  std::copy(std_x.begin(), std_x.end(), ubl_x.begin());
+  ublas::vector<ScalarType> ubl_residual = ubl_b - ublas::prod(ubl_A, ubl_x);
+  ublas::vector<ScalarType> ubl_AT_residual = ublas::prod(ublas::trans(ubl_A), ubl_residual);
+  ScalarType orthogonality = ublas::norm_inf(ubl_AT_residual) / (ublas::norm_frobenius(ubl_A) * ublas::norm_2(ubl_residual));
+  if (orthogonality > EPS)
+  {
+    std::cout << "Relative deviation: " << orthogonality << std::endl << "TEST failed!" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  std::cout << "PASSED!" << std::endl;
+}
+
+// For tall panels (rows * panel width > 16384) the panel factorization is distributed over the threads.
+// Q is too large to be formed explicitly, hence Q^T is applied to the columns of A, which must give R.
+template <typename MatrixLayout>
+void test_large_qr_factorization(std::size_t rows, std::size_t cols, std::size_t block_size)
+{
+  std::cout << "Testing large matrix of size " << rows << "-by-" << cols << " with panel width " << block_size << std::endl;
+
+  ublas::matrix<ScalarType> ubl_A(rows, cols);
+  for (std::size_t i=0; i<rows; ++i)
+    for (std::size_t j=0; j<cols; ++j)
+      ubl_A(i,j) = random<ScalarType>();
+
+  viennacl::matrix<ScalarType, MatrixLayout> vcl_A(rows, cols);
+  viennacl::copy(ubl_A, vcl_A);
+  std::vector<ScalarType> betas = viennacl::linalg::inplace_qr(vcl_A, block_size);
+
+  ublas::matrix<ScalarType> ubl_QR(rows, cols);
+  viennacl::copy(vcl_A, ubl_QR);
+
+  //--------------------------------------------------------
+  std::cout << std::endl << "Testing inplace_qr: Q^T A = R..." << std::endl;
+  ublas::matrix<ScalarType> ubl_QTA(rows, cols), ubl_R(rows, cols);
+  for (std::size_t j=0; j<cols; ++j)
+  {
+    ublas::vector<ScalarType> ubl_column = ublas::column(ubl_A, j);
+    viennacl::linalg::inplace_qr_apply_trans_Q(ubl_QR, betas, ubl_column);
+    ublas::column(ubl_QTA, j) = ubl_column;
+    for (std::size_t i=0; i<rows; ++i)
+      ubl_R(i,j) = (i <= j) ? ubl_QR(i,j) : 0;
+  }
+  if (max_relative_diff(ubl_QTA, ubl_R) > EPS)
+  {
+    std::cout << "Relative deviation: " << max_relative_diff(ubl_QTA, ubl_R) << std::endl << "TEST failed!" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  std::cout << "PASSED!" << std::endl;
+}
+
 int main()
 {
 
@@ -397,5 +555,16 @@ int main()
   test_qr_method_sym<viennacl::column_major>("../examples/testdata/eigen/symm5.example");
 
 
+  // panel widths not dividing the number of columns, and tall-skinny matrices:
+  std::cout << std::endl << "Test QR factorizations for row_major matrix" << std::endl;
+  test_qr_factorization<viennacl::row_major>(150, 70, 32);
+  test_qr_factorization<viennacl::row_major>(700, 12, 5);
+  test_large_qr_factorization<viennacl::row_major>(2000, 70, 32);
+
+  std::cout << std::endl << "Test QR factorizations for column_major matrix" << std::endl;
+  test_qr_factorization<viennacl::column_major>(150, 70, 32);
+  test_qr_factorization<viennacl::column_major>(700, 12, 5);
+  test_large_qr_factorization<viennacl::column_major>(2000, 70, 32);
+
   std::cout << std::endl <<"--------TEST SUCCESSFULLY COMPLETED----------" << std::endl;
 }
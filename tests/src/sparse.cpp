@@ -28,7 +28,16 @@
 //
 // *** System
 //
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
 
 //
 // *** Boost
@@ -55,11 +64,27 @@
 #include "viennacl/ell_matrix.hpp"
 #include "viennacl/sliced_ell_matrix.hpp"
 #include "viennacl/hyb_matrix.hpp"
+#include "viennacl/matrix.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/vector_proxy.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/norm_frobenius.hpp"
 #include "viennacl/linalg/ilu.hpp"
+#include "viennacl/linalg/ichol.hpp"
+#include "viennacl/linalg/ssor.hpp"
+#include "viennacl/linalg/sparse_cholesky.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/deflated_cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/bicgstabl.hpp"
+#include "viennacl/linalg/idrs.hpp"
+#include "viennacl/linalg/chebyshev.hpp"
+#include "viennacl/linalg/gmres.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+#include "viennacl/linalg/mixed_precision_cg.hpp"
+#include "viennacl/linalg/amg.hpp"
+#include "viennacl/linalg/detail/multi_vector.hpp"
 #include "viennacl/linalg/detail/ilu/common.hpp"
 #include "viennacl/io/matrix_market.hpp"
 #include "examples/tutorial/Random.hpp"
@@ -175,6 +200,119 @@ ScalarType diff(ublas::compressed_matrix<ScalarType> & cpu_matrix, VCL_MATRIX &
 }
 
 
+//
+// Helpers for the solver and preconditioner tests: 2D Laplace operator (five-point stencil) and relative residual norm
+//
+template<typename NumericT>
+void generate_laplace_2d(ublas::compressed_matrix<NumericT> & ublas_matrix, std::size_t points_per_dim)
+{
+  std::size_t N = points_per_dim * points_per_dim;
+  ublas_matrix.resize(N, N, false);
+  for (std::size_t i=0; i<points_per_dim; ++i)
+  {
+    for (std::size_t j=0; j<points_per_dim; ++j)
+    {
+      std::size_t row = i * points_per_dim + j;
+      if (i > 0)
+        ublas_matrix(row, row - points_per_dim) = NumericT(-1);
+      if (j > 0)
+        ublas_matrix(row, row - 1) = NumericT(-1);
+      ublas_matrix(row, row) = NumericT(4);
+      if (j < points_per_dim - 1)
+        ublas_matrix(row, row + 1) = NumericT(-1);
+      if (i < points_per_dim - 1)
+        ublas_matrix(row, row + points_per_dim) = NumericT(-1);
+    }
+  }
+}
+
+/** @brief Five-point Laplace operator with an additional convection term along the grid lines, which makes it nonsymmetric */
+template<typename NumericT>
+void generate_convection_diffusion_2d(ublas::compressed_matrix<NumericT> & ublas_matrix, std::size_t points_per_dim)
+{
+  generate_laplace_2d(ublas_matrix, points_per_dim);
+  for (std::size_t row=1; row<ublas_matrix.size1(); ++row)
+  {
+    if (row % points_per_dim != 0) // coupling to the left neighbor within the same grid line
+    {
+      ublas_matrix(row, row - 1) = NumericT(-1.5);
+      ublas_matrix(row - 1, row) = NumericT(-0.5);
+    }
+  }
+}
+
+template<typename NumericT>
+NumericT relative_residual(ublas::compressed_matrix<NumericT> const & ublas_matrix, ublas::vector<NumericT> const & rhs, viennacl::vector<NumericT> const & vcl_x)
+{
+  ublas::vector<NumericT> x(vcl_x.size());
+  viennacl::copy(vcl_x, x);
+  ublas::vector<NumericT> residual = rhs - ublas::prod(ublas_matrix, x);
+  return ublas::norm_2(residual) / ublas::norm_2(rhs);
+}
+
+template<typename NumericT, typename VCLMatrixT, typename SolverTagT, typename PrecondT>
+int check_preconditioned_solve(ublas::compressed_matrix<NumericT> const & ublas_matrix, ublas::vector<NumericT> const & rhs,
+                               VCLMatrixT const & vcl_matrix, viennacl::vector<NumericT> const & vcl_rhs,
+                               SolverTagT tag, PrecondT const & precond, std::size_t max_iters, std::string const & name)
+{
+  std::cout << "Testing " << name << std::endl;
+  viennacl::vector<NumericT> vcl_result = viennacl::linalg::solve(vcl_matrix, vcl_rhs, tag, precond);
+
+  NumericT residual = relative_residual(ublas_matrix, rhs, vcl_result);
+  if ( residual > NumericT(10 * tag.tolerance()) || tag.iters() > max_iters )
+  {
+    std::cout << "# Error at operation: " << name << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << tag.iters() << " (expected at most " << max_iters << ")" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+/** @brief Five-point Laplace operator with a constant right hand side in main memory, shared by the preconditioner and solver tests.
+*
+* The iteration count of unpreconditioned CG is kept in plain_tag as the reference for the preconditioned solves.
+*/
+template<typename NumericT>
+struct laplace_2d_system
+{
+  laplace_2d_system(NumericT epsilon, std::size_t points_per_dim = 40)
+    : host_ctx(viennacl::MAIN_MEMORY),
+      vcl_matrix(points_per_dim * points_per_dim, points_per_dim * points_per_dim, host_ctx),
+      vcl_rhs(points_per_dim * points_per_dim, host_ctx),
+      solver_tol(std::sqrt(epsilon)),
+      plain_tag(solver_tol, 1000)
+  {
+    generate_laplace_2d(ublas_matrix, points_per_dim);
+    rhs = ublas::scalar_vector<NumericT>(ublas_matrix.size1(), NumericT(1));
+    viennacl::copy(ublas_matrix, vcl_matrix);
+    viennacl::copy(rhs, vcl_rhs);
+    viennacl::linalg::solve(vcl_matrix, vcl_rhs, plain_tag);
+  }
+
+  template<typename SolverTagT, typename PrecondT>
+  int check_solve(SolverTagT const & tag, PrecondT const & precond, std::size_t max_iters, std::string const & name) const
+  {
+    return check_preconditioned_solve(ublas_matrix, rhs, vcl_matrix, vcl_rhs, tag, precond, max_iters, name);
+  }
+
+  ublas::compressed_matrix<NumericT> ublas_matrix;
+  ublas::vector<NumericT> rhs;
+  viennacl::context host_ctx;
+  viennacl::compressed_matrix<NumericT> vcl_matrix;
+  viennacl::vector<NumericT> vcl_rhs;
+  NumericT solver_tol;
+  viennacl::linalg::cg_tag plain_tag;
+};
+
+/** @brief Returns the preconditioner applied to a copy of the given vector */
+template<typename NumericT, typename PrecondT>
+viennacl::vector<NumericT> apply_precond(PrecondT const & precond, viennacl::vector<NumericT> const & vec)
+{
+  viennacl::vector<NumericT> result(vec);
+  precond.apply(result);
+  return result;
+}
+
 template<typename NumericT, typename VCL_MatrixT, typename Epsilon, typename UblasVectorT, typename VCLVectorT>
 int strided_matrix_vector_product_test(Epsilon epsilon,
                                         UblasVectorT & result, UblasVectorT const & rhs,
@@ -220,181 +358,1799 @@ int strided_matrix_vector_product_test(Epsilon epsilon,
       retval = EXIT_FAILURE;
     }
 
-    return retval;
-}
+    return retval;
+}
+
+
+template<typename NumericT, typename VCL_MatrixT, typename Epsilon>
+int imbalanced_matrix_vector_product_test(Epsilon epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+  // a few dense rows among many short and empty rows, so that rows are split across the work partitions:
+  std::size_t N = 3000;
+  ublas::compressed_matrix<NumericT> ublas_matrix(N, N);
+  for (std::size_t i=0; i<N; ++i)
+  {
+    if (i == 0 || i == N / 3 || i == N - 1)
+    {
+      for (std::size_t j=0; j<N; ++j)
+        ublas_matrix(i, j) = NumericT(1) + random<NumericT>();
+    }
+    else if (i % 5 != 0)
+    {
+      for (std::size_t j=0; j<(i % 4); ++j)
+        ublas_matrix(i, (i * 11 + j * 101) % N) = NumericT(1) + random<NumericT>();
+    }
+  }
+
+  ublas::vector<NumericT> rhs(N);
+  for (std::size_t i=0; i<N; ++i)
+    rhs(i) = NumericT(1) + random<NumericT>();
+  ublas::vector<NumericT> result = ublas::prod(ublas_matrix, rhs);
+
+#ifdef VIENNACL_WITH_OPENMP
+  // the work partition of the host kernels has one block per thread, so use several threads even on a single core:
+  int num_threads = omp_get_max_threads();
+  omp_set_num_threads(std::max(num_threads, 4));
+#endif
+
+  VCL_MatrixT vcl_matrix;
+  viennacl::copy(ublas_matrix, vcl_matrix);
+  viennacl::vector<NumericT> vcl_rhs(N);
+  viennacl::vector<NumericT> vcl_result(N);
+  viennacl::copy(rhs, vcl_rhs);
+
+  vcl_result = viennacl::linalg::prod(vcl_matrix, vcl_rhs);
+  if ( std::fabs(diff(result, vcl_result)) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-vector product with rows of very different lengths" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+#ifdef VIENNACL_WITH_OPENMP
+  omp_set_num_threads(num_threads);
+#endif
+
+  return retval;
+}
+
+template<typename NumericT, typename Epsilon>
+int merge_path_matrix_vector_product_test(Epsilon epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+#ifdef VIENNACL_WITH_OPENMP
+  int num_threads = omp_get_max_threads();
+  omp_set_num_threads(std::max(num_threads, 4));
+#endif
+
+  // two dense rows holding most of the nonzeros, each much longer than a block of the nnz-balanced partition:
+  std::size_t N = 2000;
+  ublas::compressed_matrix<NumericT> ublas_matrix(N, N);
+  for (std::size_t i=0; i<N; ++i)
+  {
+    if (i == 1 || i == N / 2)
+      for (std::size_t j=0; j<N; ++j)
+        ublas_matrix(i, j) = NumericT(1) + random<NumericT>();
+    else
+      ublas_matrix(i, i) = NumericT(1) + random<NumericT>();
+  }
+
+  ublas::vector<NumericT> rhs(N);
+  for (std::size_t i=0; i<N; ++i)
+    rhs(i) = NumericT(1) + random<NumericT>();
+  ublas::vector<NumericT> result = ublas::prod(ublas_matrix, rhs);
+
+  viennacl::compressed_matrix<NumericT> vcl_matrix;
+  viennacl::copy(ublas_matrix, vcl_matrix);
+  viennacl::vector<NumericT> vcl_rhs(N);
+  viennacl::vector<NumericT> vcl_result(N);
+  viennacl::copy(rhs, vcl_rhs);
+
+#ifdef VIENNACL_WITH_OPENMP
+  // the partition must split the dense rows, so that the carry-out fix-up is needed:
+  std::vector<unsigned int> row_blocks(2 * (vcl_matrix.blocks1() + 1));
+  std::vector<unsigned int> row_jumper(N + 1);
+  viennacl::backend::memory_read(vcl_matrix.handle3(), 0, sizeof(unsigned int) * row_blocks.size(), &(row_blocks[0]));
+  viennacl::backend::memory_read(vcl_matrix.handle1(), 0, sizeof(unsigned int) * row_jumper.size(), &(row_jumper[0]));
+  std::size_t split_rows = 0;
+  for (std::size_t block=1; block<vcl_matrix.blocks1(); ++block)
+    if (row_blocks[2 * block] < N && row_blocks[2 * block + 1] > row_jumper[row_blocks[2 * block]])
+      ++split_rows;
+  if (vcl_matrix.blocks1() < 4 || split_rows == 0)
+  {
+    std::cout << "# Error at operation: merge-path partition of compressed_matrix" << std::endl;
+    std::cout << "  blocks: " << vcl_matrix.blocks1() << ", blocks starting inside a row: " << split_rows << std::endl;
+    retval = EXIT_FAILURE;
+  }
+#endif
+
+  vcl_result = viennacl::linalg::prod(vcl_matrix, vcl_rhs);
+  if ( std::fabs(diff(result, vcl_result)) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-vector product with rows split across blocks" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+#ifdef VIENNACL_WITH_OPENMP
+  omp_set_num_threads(num_threads);
+#endif
+
+  return retval;
+}
+
+template< typename NumericT, typename VCL_MATRIX, typename Epsilon >
+int resize_test(Epsilon const& epsilon)
+{
+   int retval = EXIT_SUCCESS;
+
+   ublas::compressed_matrix<NumericT> ublas_matrix(5,5);
+   VCL_MATRIX vcl_matrix;
+
+   ublas_matrix(0,0) = NumericT(10.0); ublas_matrix(0, 1) = NumericT(0.1); ublas_matrix(0, 2) = NumericT(0.2); ublas_matrix(0, 3) = NumericT(0.3); ublas_matrix(0, 4) = NumericT(0.4);
+   ublas_matrix(1,0) = NumericT(1.0);  ublas_matrix(1, 1) = NumericT(1.1); ublas_matrix(1, 2) = NumericT(1.2); ublas_matrix(1, 3) = NumericT(1.3); ublas_matrix(1, 4) = NumericT(1.4);
+   ublas_matrix(2,0) = NumericT(2.0);  ublas_matrix(2, 1) = NumericT(2.1); ublas_matrix(2, 2) = NumericT(2.2); ublas_matrix(2, 3) = NumericT(2.3); ublas_matrix(2, 4) = NumericT(2.4);
+   ublas_matrix(3,0) = NumericT(3.0);  ublas_matrix(3, 1) = NumericT(3.1); ublas_matrix(3, 2) = NumericT(3.2); ublas_matrix(3, 3) = NumericT(3.3); ublas_matrix(3, 4) = NumericT(3.4);
+   ublas_matrix(4,0) = NumericT(4.0);  ublas_matrix(4, 1) = NumericT(4.1); ublas_matrix(4, 2) = NumericT(4.2); ublas_matrix(4, 3) = NumericT(4.3); ublas_matrix(4, 4) = NumericT(4.4);
+
+   viennacl::copy(ublas_matrix, vcl_matrix);
+   ublas::compressed_matrix<NumericT> other_matrix(ublas_matrix.size1(), ublas_matrix.size2());
+   viennacl::copy(vcl_matrix, other_matrix);
+
+   std::cout << "Checking for equality after copy..." << std::endl;
+    if ( std::fabs(diff(ublas_matrix, vcl_matrix)) > epsilon )
+    {
+        std::cout << "# Error at operation: equality after copy with sparse matrix" << std::endl;
+        std::cout << "  diff: " << std::fabs(diff(ublas_matrix, vcl_matrix)) << std::endl;
+        return EXIT_FAILURE;
+    }
+
+   std::cout << "Testing resize to larger..." << std::endl;
+   ublas_matrix.resize(10, 10, false); //ublas does not allow preserve = true here
+   ublas_matrix(0,0) = NumericT(10.0); ublas_matrix(0, 1) = NumericT(0.1); ublas_matrix(0, 2) = NumericT(0.2); ublas_matrix(0, 3) = NumericT(0.3); ublas_matrix(0, 4) = NumericT(0.4);
+   ublas_matrix(1,0) = NumericT( 1.0); ublas_matrix(1, 1) = NumericT(1.1); ublas_matrix(1, 2) = NumericT(1.2); ublas_matrix(1, 3) = NumericT(1.3); ublas_matrix(1, 4) = NumericT(1.4);
+   ublas_matrix(2,0) = NumericT( 2.0); ublas_matrix(2, 1) = NumericT(2.1); ublas_matrix(2, 2) = NumericT(2.2); ublas_matrix(2, 3) = NumericT(2.3); ublas_matrix(2, 4) = NumericT(2.4);
+   ublas_matrix(3,0) = NumericT( 3.0); ublas_matrix(3, 1) = NumericT(3.1); ublas_matrix(3, 2) = NumericT(3.2); ublas_matrix(3, 3) = NumericT(3.3); ublas_matrix(3, 4) = NumericT(3.4);
+   ublas_matrix(4,0) = NumericT( 4.0); ublas_matrix(4, 1) = NumericT(4.1); ublas_matrix(4, 2) = NumericT(4.2); ublas_matrix(4, 3) = NumericT(4.3); ublas_matrix(4, 4) = NumericT(4.4);
+   //std::cout << ublas_matrix << std::endl;
+
+   vcl_matrix.resize(10, 10, true);
+
+    if ( std::fabs(diff(ublas_matrix, vcl_matrix)) > epsilon )
+    {
+        std::cout << "# Error at operation: resize (to larger) with sparse matrix" << std::endl;
+        std::cout << "  diff: " << std::fabs(diff(ublas_matrix, vcl_matrix)) << std::endl;
+        return EXIT_FAILURE;
+    }
+
+   ublas_matrix(5,5) = NumericT(5.5); ublas_matrix(5, 6) = NumericT(5.6); ublas_matrix(5, 7) = NumericT(5.7); ublas_matrix(5, 8) = NumericT(5.8); ublas_matrix(5, 9) = NumericT(5.9);
+   ublas_matrix(6,5) = NumericT(6.5); ublas_matrix(6, 6) = NumericT(6.6); ublas_matrix(6, 7) = NumericT(6.7); ublas_matrix(6, 8) = NumericT(6.8); ublas_matrix(6, 9) = NumericT(6.9);
+   ublas_matrix(7,5) = NumericT(7.5); ublas_matrix(7, 6) = NumericT(7.6); ublas_matrix(7, 7) = NumericT(7.7); ublas_matrix(7, 8) = NumericT(7.8); ublas_matrix(7, 9) = NumericT(7.9);
+   ublas_matrix(8,5) = NumericT(8.5); ublas_matrix(8, 6) = NumericT(8.6); ublas_matrix(8, 7) = NumericT(8.7); ublas_matrix(8, 8) = NumericT(8.8); ublas_matrix(8, 9) = NumericT(8.9);
+   ublas_matrix(9,5) = NumericT(9.5); ublas_matrix(9, 6) = NumericT(9.6); ublas_matrix(9, 7) = NumericT(9.7); ublas_matrix(9, 8) = NumericT(9.8); ublas_matrix(9, 9) = NumericT(9.9);
+   viennacl::copy(ublas_matrix, vcl_matrix);
+
+   std::cout << "Testing resize to smaller..." << std::endl;
+   ublas_matrix.resize(7, 7, false); //ublas does not allow preserve = true here
+   ublas_matrix(0,0) = NumericT(10.0); ublas_matrix(0, 1) = NumericT(0.1); ublas_matrix(0, 2) = NumericT(0.2); ublas_matrix(0, 3) = NumericT(0.3); ublas_matrix(0, 4) = NumericT(0.4);
+   ublas_matrix(1,0) = NumericT( 1.0); ublas_matrix(1, 1) = NumericT(1.1); ublas_matrix(1, 2) = NumericT(1.2); ublas_matrix(1, 3) = NumericT(1.3); ublas_matrix(1, 4) = NumericT(1.4);
+   ublas_matrix(2,0) = NumericT( 2.0); ublas_matrix(2, 1) = NumericT(2.1); ublas_matrix(2, 2) = NumericT(2.2); ublas_matrix(2, 3) = NumericT(2.3); ublas_matrix(2, 4) = NumericT(2.4);
+   ublas_matrix(3,0) = NumericT( 3.0); ublas_matrix(3, 1) = NumericT(3.1); ublas_matrix(3, 2) = NumericT(3.2); ublas_matrix(3, 3) = NumericT(3.3); ublas_matrix(3, 4) = NumericT(3.4);
+   ublas_matrix(4,0) = NumericT( 4.0); ublas_matrix(4, 1) = NumericT(4.1); ublas_matrix(4, 2) = NumericT(4.2); ublas_matrix(4, 3) = NumericT(4.3); ublas_matrix(4, 4) = NumericT(4.4);
+   ublas_matrix(5,5) = NumericT( 5.5); ublas_matrix(5, 6) = NumericT(5.6); ublas_matrix(5, 7) = NumericT(5.7); ublas_matrix(5, 8) = NumericT(5.8); ublas_matrix(5, 9) = NumericT(5.9);
+   ublas_matrix(6,5) = NumericT( 6.5); ublas_matrix(6, 6) = NumericT(6.6); ublas_matrix(6, 7) = NumericT(6.7); ublas_matrix(6, 8) = NumericT(6.8); ublas_matrix(6, 9) = NumericT(6.9);
+
+   vcl_matrix.resize(7, 7);
+
+   //std::cout << ublas_matrix << std::endl;
+    if ( std::fabs(diff(ublas_matrix, vcl_matrix)) > epsilon )
+    {
+        std::cout << "# Error at operation: resize (to smaller) with sparse matrix" << std::endl;
+        std::cout << "  diff: " << std::fabs(diff(ublas_matrix, vcl_matrix)) << std::endl;
+        retval = EXIT_FAILURE;
+    }
+
+   ublas::vector<NumericT> ublas_vec = ublas::scalar_vector<NumericT>(ublas_matrix.size1(), NumericT(3.1415));
+   viennacl::vector<NumericT> vcl_vec(ublas_matrix.size1());
+
+
+  std::cout << "Testing transposed unit lower triangular solve: compressed_matrix" << std::endl;
+  viennacl::copy(ublas_vec, vcl_vec);
+  std::cout << "matrix: " << ublas_matrix << std::endl;
+  std::cout << "vector: " << ublas_vec << std::endl;
+  std::cout << "ViennaCL matrix size: " << vcl_matrix.size1() << " x " << vcl_matrix.size2() << std::endl;
+
+  std::cout << "ublas..." << std::endl;
+  boost::numeric::ublas::inplace_solve((ublas_matrix), ublas_vec, boost::numeric::ublas::unit_lower_tag());
+  std::cout << "ViennaCL..." << std::endl;
+  viennacl::linalg::inplace_solve((vcl_matrix), vcl_vec, viennacl::linalg::unit_lower_tag());
+
+  /*
+  std::list< viennacl::backend::mem_handle > multifrontal_L_row_index_arrays_;
+  std::list< viennacl::backend::mem_handle > multifrontal_L_row_buffers_;
+  std::list< viennacl::backend::mem_handle > multifrontal_L_col_buffers_;
+  std::list< viennacl::backend::mem_handle > multifrontal_L_element_buffers_;
+  std::list< std::size_t > multifrontal_L_row_elimination_num_list_;
+
+  viennacl::vector<NumericT> multifrontal_U_diagonal_;
+
+  viennacl::linalg::detail::multifrontal_setup_L(vcl_matrix,
+                                                  multifrontal_U_diagonal_, //dummy
+                                                  multifrontal_L_row_index_arrays_,
+                                                  multifrontal_L_row_buffers_,
+                                                  multifrontal_L_col_buffers_,
+                                                  multifrontal_L_element_buffers_,
+                                                  multifrontal_L_row_elimination_num_list_);
+
+  viennacl::linalg::detail::multifrontal_substitute(vcl_vec,
+                                                    multifrontal_L_row_index_arrays_,
+                                                    multifrontal_L_row_buffers_,
+                                                    multifrontal_L_col_buffers_,
+                                                    multifrontal_L_element_buffers_,
+                                                    multifrontal_L_row_elimination_num_list_);
+
+
+  std::cout << "ublas..." << std::endl;
+  boost::numeric::ublas::inplace_solve((ublas_matrix), ublas_vec, boost::numeric::ublas::upper_tag());
+  std::cout << "ViennaCL..." << std::endl;
+  std::list< viennacl::backend::mem_handle > multifrontal_U_row_index_arrays_;
+  std::list< viennacl::backend::mem_handle > multifrontal_U_row_buffers_;
+  std::list< viennacl::backend::mem_handle > multifrontal_U_col_buffers_;
+  std::list< viennacl::backend::mem_handle > multifrontal_U_element_buffers_;
+  std::list< std::size_t > multifrontal_U_row_elimination_num_list_;
+
+  multifrontal_U_diagonal_.resize(vcl_matrix.size1(), false);
+  viennacl::linalg::single_threaded::detail::row_info(vcl_matrix, multifrontal_U_diagonal_, viennacl::linalg::detail::SPARSE_ROW_DIAGONAL);
+  viennacl::linalg::detail::multifrontal_setup_U(vcl_matrix,
+                                                 multifrontal_U_diagonal_,
+                                                 multifrontal_U_row_index_arrays_,
+                                                 multifrontal_U_row_buffers_,
+                                                 multifrontal_U_col_buffers_,
+                                                 multifrontal_U_element_buffers_,
+                                                 multifrontal_U_row_elimination_num_list_);
+
+  vcl_vec = viennacl::linalg::element_div(vcl_vec, multifrontal_U_diagonal_);
+  viennacl::linalg::detail::multifrontal_substitute(vcl_vec,
+                                                    multifrontal_U_row_index_arrays_,
+                                                    multifrontal_U_row_buffers_,
+                                                    multifrontal_U_col_buffers_,
+                                                    multifrontal_U_element_buffers_,
+                                                    multifrontal_U_row_elimination_num_list_);
+  */
+  for (std::size_t i=0; i<ublas_vec.size(); ++i)
+  {
+    std::cout << ublas_vec[i] << " vs. " << vcl_vec[i] << std::endl;
+  }
+
+  /*std::cout << "Testing transposed unit upper triangular solve: compressed_matrix" << std::endl;
+  viennacl::copy(ublas_vec, vcl_vec);
+  std::cout << "matrix: " << ublas_matrix << std::endl;
+  std::cout << "vector: " << ublas_vec << std::endl;
+  std::cout << "ViennaCL matrix size: " << vcl_matrix.size1() << " x " << vcl_matrix.size2() << std::endl;
+
+  std::cout << "ublas..." << std::endl;
+  boost::numeric::ublas::inplace_solve((ublas_matrix), ublas_vec, boost::numeric::ublas::lower_tag());
+  std::cout << "ViennaCL..." << std::endl;
+  viennacl::linalg::inplace_solve((vcl_matrix), vcl_vec, viennacl::linalg::lower_tag());
+
+  for (std::size_t i=0; i<ublas_vec.size(); ++i)
+  {
+    std::cout << ublas_vec[i] << " vs. " << vcl_vec[i] << std::endl;
+  }*/
+
+  return retval;
+}
+
+
+//
+// -------------------------------------------------------------
+//
+template< typename NumericT, typename Epsilon >
+int sparse_product_test(Epsilon const& epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+  ublas::compressed_matrix<NumericT> ublas_A(300, 200);
+  ublas::compressed_matrix<NumericT> ublas_B(200, 250);
+
+  for (std::size_t i=0; i<ublas_A.size1(); ++i)
+    for (std::size_t j=0; j<4; ++j)
+      ublas_A(i, (i * 7 + j * 31) % ublas_A.size2()) = NumericT(1) + random<NumericT>();
+  for (std::size_t i=0; i<ublas_B.size1(); ++i)
+    for (std::size_t j=0; j<(i % 9); ++j)
+      ublas_B(i, (i * 13 + j * 17) % ublas_B.size2()) = NumericT(1) + random<NumericT>();
+
+  ublas::compressed_matrix<NumericT> ublas_C = ublas::prod(ublas_A, ublas_B);
+
+  viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+  viennacl::compressed_matrix<NumericT> vcl_A(ublas_A.size1(), ublas_A.size2(), host_ctx);
+  viennacl::compressed_matrix<NumericT> vcl_B(ublas_B.size1(), ublas_B.size2(), host_ctx);
+  viennacl::copy(ublas_A, vcl_A);
+  viennacl::copy(ublas_B, vcl_B);
+
+  viennacl::compressed_matrix<NumericT> vcl_C(viennacl::linalg::prod(vcl_A, vcl_B));
+  if ( std::fabs(diff(ublas_C, vcl_C)) > epsilon )
+  {
+    std::cout << "# Error at operation: compressed_matrix-compressed_matrix product (construction)" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(ublas_C, vcl_C)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // assignment to an existing matrix of different sparsity pattern:
+  viennacl::compressed_matrix<NumericT> vcl_C2(ublas_A.size1(), ublas_A.size2(), host_ctx);
+  viennacl::copy(ublas_A, vcl_C2);
+  vcl_C2 = viennacl::linalg::prod(vcl_A, vcl_B);
+  if ( std::fabs(diff(ublas_C, vcl_C2)) > epsilon )
+  {
+    std::cout << "# Error at operation: compressed_matrix-compressed_matrix product (assignment)" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(ublas_C, vcl_C2)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // product involving the result matrix:
+  ublas::compressed_matrix<NumericT> ublas_B2 = ublas::prod(ublas_B, ublas::trans(ublas_B));
+  ublas::compressed_matrix<NumericT> ublas_B3 = ublas::prod(ublas_B2, ublas_B2);
+  viennacl::compressed_matrix<NumericT> vcl_B2(ublas_B2.size1(), ublas_B2.size2(), host_ctx);
+  viennacl::copy(ublas_B2, vcl_B2);
+  vcl_B2 = viennacl::linalg::prod(vcl_B2, vcl_B2);
+  if ( std::fabs(diff(ublas_B3, vcl_B2)) > epsilon )
+  {
+    std::cout << "# Error at operation: compressed_matrix-compressed_matrix product (aliased)" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(ublas_B3, vcl_B2)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // product without any nonzeros, since the columns of A_even and the rows of B_odd are disjoint:
+  ublas::compressed_matrix<NumericT> ublas_A_even(50, 40);
+  ublas::compressed_matrix<NumericT> ublas_B_odd(40, 30);
+  for (std::size_t i=0; i<ublas_A_even.size1(); ++i)
+    ublas_A_even(i, (2 * i) % ublas_A_even.size2()) = NumericT(1) + random<NumericT>();
+  for (std::size_t i=1; i<ublas_B_odd.size1(); i += 2)
+    ublas_B_odd(i, i % ublas_B_odd.size2()) = NumericT(1) + random<NumericT>();
+  ublas::compressed_matrix<NumericT> ublas_C_empty(ublas_A_even.size1(), ublas_B_odd.size2());
+
+  viennacl::compressed_matrix<NumericT> vcl_A_even(ublas_A_even.size1(), ublas_A_even.size2(), host_ctx);
+  viennacl::compressed_matrix<NumericT> vcl_B_odd(ublas_B_odd.size1(), ublas_B_odd.size2(), host_ctx);
+  viennacl::copy(ublas_A_even, vcl_A_even);
+  viennacl::copy(ublas_B_odd, vcl_B_odd);
+
+  viennacl::compressed_matrix<NumericT> vcl_C_empty(viennacl::linalg::prod(vcl_A_even, vcl_B_odd));
+  if ( std::fabs(diff(ublas_C_empty, vcl_C_empty)) > epsilon )
+  {
+    std::cout << "# Error at operation: compressed_matrix-compressed_matrix product (empty result)" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(ublas_C_empty, vcl_C_empty)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  return retval;
+}
+
+
+template< typename NumericT, typename Epsilon >
+int amg_test(Epsilon const& epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+  laplace_2d_system<NumericT> laplace(epsilon);
+
+  std::vector<viennacl::linalg::amg_tag> amg_tags;
+  std::vector<std::string> amg_names;
+  amg_tags.push_back(viennacl::linalg::amg_tag(VIENNACL_AMG_COARSE_RS,      VIENNACL_AMG_INTERPOL_DIRECT,  0.25, 0.2,  0.67, 3, 3, 0)); amg_names.push_back("RS, direct");
+  amg_tags.push_back(viennacl::linalg::amg_tag(VIENNACL_AMG_COARSE_RS,      VIENNACL_AMG_INTERPOL_CLASSIC, 0.25, 0.2,  0.67, 3, 3, 0)); amg_names.push_back("RS, classic");
+  amg_tags.push_back(viennacl::linalg::amg_tag(VIENNACL_AMG_COARSE_ONEPASS, VIENNACL_AMG_INTERPOL_DIRECT,  0.25, 0.2,  0.67, 3, 3, 0)); amg_names.push_back("one-pass, direct");
+  amg_tags.push_back(viennacl::linalg::amg_tag(VIENNACL_AMG_COARSE_AG,      VIENNACL_AMG_INTERPOL_AG,      0.08, 0,    0.67, 3, 3, 0)); amg_names.push_back("AG, AG");
+  amg_tags.push_back(viennacl::linalg::amg_tag(VIENNACL_AMG_COARSE_AG,      VIENNACL_AMG_INTERPOL_SA,      0.08, 0.67, 0.67, 3, 3, 0)); amg_names.push_back("AG, SA");
+
+  for (std::size_t k=0; k<amg_tags.size(); ++k)
+  {
+    std::cout << "Testing CG with AMG preconditioner: " << amg_names[k] << std::endl;
+    viennacl::linalg::amg_precond<viennacl::compressed_matrix<NumericT> > vcl_amg(laplace.vcl_matrix, amg_tags[k]);
+    vcl_amg.setup();
+
+    viennacl::linalg::cg_tag amg_cg_tag(laplace.solver_tol, 1000);
+    viennacl::vector<NumericT> vcl_result = viennacl::linalg::solve(laplace.vcl_matrix, laplace.vcl_rhs, amg_cg_tag, vcl_amg);
+
+    NumericT residual = relative_residual(laplace.ublas_matrix, laplace.rhs, vcl_result);
+    if ( residual > 10 * laplace.solver_tol || amg_cg_tag.iters() >= laplace.plain_tag.iters() )
+    {
+      std::cout << "# Error at operation: CG with AMG preconditioner (" << amg_names[k] << ")" << std::endl;
+      std::cout << "  residual: " << residual << ", iterations: " << amg_cg_tag.iters() << " (without preconditioner: " << laplace.plain_tag.iters() << ")" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+  }
+
+  return retval;
+}
+
+template< typename NumericT, typename Epsilon >
+int amg_resetup_test(Epsilon const& epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+  laplace_2d_system<NumericT> laplace(epsilon);
+
+  // same sparsity pattern, different values (weaker coupling in one direction, diagonally dominant):
+  ublas::compressed_matrix<NumericT> ublas_matrix2(laplace.ublas_matrix);
+  for (typename ublas::compressed_matrix<NumericT>::iterator1 row_it = ublas_matrix2.begin1(); row_it != ublas_matrix2.end1(); ++row_it)
+  {
+    NumericT row_sum = 0;
+    for (typename ublas::compressed_matrix<NumericT>::iterator2 col_it = row_it.begin(); col_it != row_it.end(); ++col_it)
+    {
+      if (col_it.index2() + 1 == col_it.index1() || col_it.index2() == col_it.index1() + 1)
+        *col_it = NumericT(-0.25);
+      if (col_it.index2() != col_it.index1())
+        row_sum -= *col_it;
+    }
+    for (typename ublas::compressed_matrix<NumericT>::iterator2 col_it = row_it.begin(); col_it != row_it.end(); ++col_it)
+      if (col_it.index2() == col_it.index1())
+        *col_it = row_sum + NumericT(0.5);
+  }
+
+  viennacl::compressed_matrix<NumericT> vcl_matrix2(ublas_matrix2.size1(), ublas_matrix2.size2(), laplace.host_ctx);
+  viennacl::copy(ublas_matrix2, vcl_matrix2);
+
+  std::vector<viennacl::linalg::amg_tag> amg_tags;
+  std::vector<std::string> amg_names;
+  amg_tags.push_back(viennacl::linalg::amg_tag(VIENNACL_AMG_COARSE_RS, VIENNACL_AMG_INTERPOL_CLASSIC, 0.25, 0.2,  0.67, 3, 3, 0)); amg_names.push_back("RS, classic");
+  amg_tags.push_back(viennacl::linalg::amg_tag(VIENNACL_AMG_COARSE_AG, VIENNACL_AMG_INTERPOL_SA,      0.08, 0.67, 0.67, 3, 3, 0)); amg_names.push_back("AG, SA");
+  amg_tags.push_back(viennacl::linalg::amg_tag(VIENNACL_AMG_COARSE_RS, VIENNACL_AMG_INTERPOL_DIRECT,  0.25, 0.2,  1.0,  1, 1, 0, VIENNACL_AMG_SMOOTHER_GAUSS_SEIDEL)); amg_names.push_back("RS, direct, Gauss-Seidel smoother");
+
+  for (std::size_t k=0; k<amg_tags.size(); ++k)
+  {
+    std::cout << "Testing AMG resetup for new matrix values: " << amg_names[k] << std::endl;
+
+    // reference: fresh setup for the new values
+    viennacl::linalg::amg_precond<viennacl::compressed_matrix<NumericT> > vcl_amg_fresh(vcl_matrix2, amg_tags[k]);
+    vcl_amg_fresh.setup();
+    viennacl::linalg::cg_tag fresh_tag(laplace.solver_tol, 1000);
+    viennacl::vector<NumericT> vcl_result = viennacl::linalg::solve(vcl_matrix2, laplace.vcl_rhs, fresh_tag, vcl_amg_fresh);
+
+    // setup for the old values, then update:
+    viennacl::linalg::amg_precond<viennacl::compressed_matrix<NumericT> > vcl_amg(laplace.vcl_matrix, amg_tags[k]);
+    vcl_amg.setup();
+    viennacl::linalg::cg_tag old_tag(laplace.solver_tol, 1000);
+    vcl_result = viennacl::linalg::solve(laplace.vcl_matrix, laplace.vcl_rhs, old_tag, vcl_amg);
+
+    vcl_amg.resetup_values(vcl_matrix2);
+    viennacl::linalg::cg_tag resetup_tag(laplace.solver_tol, 1000);
+    vcl_result = viennacl::linalg::solve(vcl_matrix2, laplace.vcl_rhs, resetup_tag, vcl_amg);
+
+    NumericT residual = relative_residual(ublas_matrix2, laplace.rhs, vcl_result);
+    if ( residual > 10 * laplace.solver_tol || resetup_tag.iters() > fresh_tag.iters() + 2 )
+    {
+      std::cout << "# Error at operation: CG with AMG preconditioner after resetup_values() (" << amg_names[k] << ")" << std::endl;
+      std::cout << "  residual: " << residual << ", iterations: " << resetup_tag.iters() << " (fresh setup: " << fresh_tag.iters() << ")" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // back to the original values:
+    vcl_amg.resetup_values(laplace.vcl_matrix);
+    viennacl::linalg::cg_tag back_tag(laplace.solver_tol, 1000);
+    vcl_result = viennacl::linalg::solve(laplace.vcl_matrix, laplace.vcl_rhs, back_tag, vcl_amg);
+
+    residual = relative_residual(laplace.ublas_matrix, laplace.rhs, vcl_result);
+    if ( residual > 10 * laplace.solver_tol || back_tag.iters() != old_tag.iters() )
+    {
+      std::cout << "# Error at operation: CG with AMG preconditioner after resetup_values() with the original values (" << amg_names[k] << ")" << std::endl;
+      std::cout << "  residual: " << residual << ", iterations: " << back_tag.iters() << " (initial setup: " << old_tag.iters() << ")" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+  }
+
+  return retval;
+}
+
+template< typename NumericT, typename Epsilon >
+int ilu_test(Epsilon const& epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+  laplace_2d_system<NumericT> laplace(epsilon);
+  std::size_t max_iters = laplace.plain_tag.iters() - 1;
+
+  viennacl::linalg::ilu0_precond<viennacl::compressed_matrix<NumericT> > vcl_ilu0(laplace.vcl_matrix, viennacl::linalg::ilu0_tag());
+  if (laplace.check_solve(viennacl::linalg::cg_tag(laplace.solver_tol, 1000), vcl_ilu0, max_iters, "CG with ILU0 preconditioner") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  viennacl::linalg::ilut_precond<viennacl::compressed_matrix<NumericT> > vcl_ilut(laplace.vcl_matrix, viennacl::linalg::ilut_tag(10, 1e-4));
+  if (laplace.check_solve(viennacl::linalg::bicgstab_tag(laplace.solver_tol, 1000), vcl_ilut, max_iters, "BiCGStab with ILUT preconditioner") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  viennacl::linalg::ichol0_precond<viennacl::compressed_matrix<NumericT> > vcl_ichol0(laplace.vcl_matrix, viennacl::linalg::ichol0_tag());
+  if (laplace.check_solve(viennacl::linalg::cg_tag(laplace.solver_tol, 1000), vcl_ichol0, max_iters, "CG with IChol0 preconditioner") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  // diagonal matrix: the triangular factors have no off-diagonal entries, so the preconditioners are exact
+  ublas::compressed_matrix<NumericT> ublas_diag(50, 50);
+  for (std::size_t i=0; i<ublas_diag.size1(); ++i)
+    ublas_diag(i, i) = NumericT(1) + NumericT(i);
+  ublas::vector<NumericT> rhs_diag = ublas::scalar_vector<NumericT>(ublas_diag.size1(), NumericT(1));
+
+  viennacl::compressed_matrix<NumericT> vcl_diag(ublas_diag.size1(), ublas_diag.size2(), laplace.host_ctx);
+  viennacl::vector<NumericT> vcl_rhs_diag(rhs_diag.size(), laplace.host_ctx);
+  viennacl::copy(ublas_diag, vcl_diag);
+  viennacl::copy(rhs_diag, vcl_rhs_diag);
+
+  viennacl::linalg::ilu0_precond<viennacl::compressed_matrix<NumericT> > vcl_ilu0_diag(vcl_diag, viennacl::linalg::ilu0_tag());
+  if (check_preconditioned_solve(ublas_diag, rhs_diag, vcl_diag, vcl_rhs_diag, viennacl::linalg::cg_tag(laplace.solver_tol, 10), vcl_ilu0_diag, 1, "CG with ILU0 preconditioner, diagonal matrix") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  viennacl::linalg::ichol0_precond<viennacl::compressed_matrix<NumericT> > vcl_ichol0_diag(vcl_diag, viennacl::linalg::ichol0_tag());
+  if (check_preconditioned_solve(ublas_diag, rhs_diag, vcl_diag, vcl_rhs_diag, viennacl::linalg::cg_tag(laplace.solver_tol, 10), vcl_ichol0_diag, 1, "CG with IChol0 preconditioner, diagonal matrix") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  return retval;
+}
+
+template<typename NumericT, typename TagT>
+std::vector<NumericT> fixed_point_factors(ublas::compressed_matrix<NumericT> const & ublas_matrix, TagT const & tag, int num_threads)
+{
+  viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+  viennacl::compressed_matrix<NumericT> factors(ublas_matrix.size1(), ublas_matrix.size2(), host_ctx);
+  viennacl::copy(ublas_matrix, factors);
+
+#ifdef VIENNACL_WITH_OPENMP
+  int old_num_threads = omp_get_max_threads();
+  omp_set_num_threads(num_threads);
+#else
+  (void)num_threads;
+#endif
+  viennacl::linalg::precondition(factors, tag);
+#ifdef VIENNACL_WITH_OPENMP
+  omp_set_num_threads(old_num_threads);
+#endif
+
+  NumericT const * elements = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(factors.handle());
+  return std::vector<NumericT>(elements, elements + factors.nnz());
+}
+
+template< typename NumericT, typename Epsilon >
+int ilu_fixed_point_test(Epsilon const& epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+  laplace_2d_system<NumericT> laplace(epsilon);
+
+  // reference iteration counts with the sequentially computed factors:
+  viennacl::linalg::ilu0_precond<viennacl::compressed_matrix<NumericT> > vcl_ilu0(laplace.vcl_matrix, viennacl::linalg::ilu0_tag());
+  viennacl::linalg::cg_tag ilu0_tag(laplace.solver_tol, 1000);
+  viennacl::vector<NumericT> vcl_result = viennacl::linalg::solve(laplace.vcl_matrix, laplace.vcl_rhs, ilu0_tag, vcl_ilu0);
+  viennacl::linalg::bicgstab_tag ilu0_bicgstab_tag(laplace.solver_tol, 1000);
+  vcl_result = viennacl::linalg::solve(laplace.vcl_matrix, laplace.vcl_rhs, ilu0_bicgstab_tag, vcl_ilu0);
+
+  viennacl::linalg::ichol0_precond<viennacl::compressed_matrix<NumericT> > vcl_ichol0(laplace.vcl_matrix, viennacl::linalg::ichol0_tag());
+  viennacl::linalg::cg_tag ichol0_tag(laplace.solver_tol, 1000);
+  vcl_result = viennacl::linalg::solve(laplace.vcl_matrix, laplace.vcl_rhs, ichol0_tag, vcl_ichol0);
+
+  // two fixed-point sweeps already give factors of almost the same quality.
+  // The sweeps do not keep U = D L^T, so the ILU0 factors are used with BiCGStab rather than CG:
+  viennacl::linalg::ilu0_precond<viennacl::compressed_matrix<NumericT> > vcl_ilu0_fp(laplace.vcl_matrix, viennacl::linalg::ilu0_tag(false, 2));
+  if (laplace.check_solve(viennacl::linalg::bicgstab_tag(laplace.solver_tol, 1000), vcl_ilu0_fp,
+                          ilu0_bicgstab_tag.iters() + 1, "BiCGStab with ILU0 preconditioner, fixed-point factorization") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  viennacl::linalg::ichol0_precond<viennacl::compressed_matrix<NumericT> > vcl_ichol0_fp(laplace.vcl_matrix, viennacl::linalg::ichol0_tag(2));
+  if (laplace.check_solve(viennacl::linalg::cg_tag(laplace.solver_tol, 1000), vcl_ichol0_fp,
+                          ichol0_tag.iters() + 1, "CG with IChol0 preconditioner, fixed-point factorization") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  // each sweep only reads the values of the previous sweep, so the factors must not depend on the number of threads:
+  std::cout << "Testing fixed-point factorizations with one and with several threads" << std::endl;
+  int many_threads = 4;
+#ifdef VIENNACL_WITH_OPENMP
+  many_threads = std::max(omp_get_max_threads(), 4);
+#endif
+  if (fixed_point_factors(laplace.ublas_matrix, viennacl::linalg::ilu0_tag(false, 2), 1) != fixed_point_factors(laplace.ublas_matrix, viennacl::linalg::ilu0_tag(false, 2), many_threads))
+  {
+    std::cout << "# Error at operation: ILU0 fixed-point factorization depends on the number of threads" << std::endl;
+    retval = EXIT_FAILURE;
+  }
+  if (fixed_point_factors(laplace.ublas_matrix, viennacl::linalg::ichol0_tag(2), 1) != fixed_point_factors(laplace.ublas_matrix, viennacl::linalg::ichol0_tag(2), many_threads))
+  {
+    std::cout << "# Error at operation: IChol0 fixed-point factorization depends on the number of threads" << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // approximate triangular solves by Jacobi sweeps:
+  viennacl::linalg::ilu0_precond<viennacl::compressed_matrix<NumericT> > vcl_ilu0_jacobi(laplace.vcl_matrix, viennacl::linalg::ilu0_tag(false, 0, 3));
+  if (laplace.check_solve(viennacl::linalg::bicgstab_tag(laplace.solver_tol, 1000), vcl_ilu0_jacobi,
+                          laplace.plain_tag.iters() - 1, "BiCGStab with ILU0 preconditioner, Jacobi sweeps") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  viennacl::linalg::ichol0_precond<viennacl::compressed_matrix<NumericT> > vcl_ichol0_jacobi(laplace.vcl_matrix, viennacl::linalg::ichol0_tag(3, 3));
+  if (laplace.check_solve(viennacl::linalg::cg_tag(laplace.solver_tol, 1000), vcl_ichol0_jacobi,
+                          laplace.plain_tag.iters() - 1, "CG with IChol0 preconditioner, fixed-point factorization and Jacobi sweeps") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  // as many Jacobi sweeps as there are levels reproduce the exact substitutions:
+  viennacl::linalg::ilu0_precond<viennacl::compressed_matrix<NumericT> > vcl_ilu0_exact(laplace.vcl_matrix, viennacl::linalg::ilu0_tag(false, 0, 2 * laplace.ublas_matrix.size1()));
+  if (laplace.check_solve(viennacl::linalg::cg_tag(laplace.solver_tol, 1000), vcl_ilu0_exact,
+                          ilu0_tag.iters() + 1, "CG with ILU0 preconditioner, Jacobi sweeps up to the number of levels") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  std::cout << "Testing ILU0 preconditioner, Jacobi sweeps up to the number of levels against exact substitutions" << std::endl;
+  viennacl::vector<NumericT> vcl_exact_sweeps = apply_precond(vcl_ilu0_exact, laplace.vcl_rhs);
+  viennacl::vector<NumericT> vcl_substitutions = apply_precond(vcl_ilu0, laplace.vcl_rhs);
+  NumericT sweep_diff = viennacl::linalg::norm_inf(vcl_exact_sweeps - vcl_substitutions) / viennacl::linalg::norm_inf(vcl_substitutions);
+  if (sweep_diff > epsilon)
+  {
+    std::cout << "# Error at operation: ILU0 preconditioner, Jacobi sweeps up to the number of levels against exact substitutions" << std::endl;
+    std::cout << "  relative diff: " << sweep_diff << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  return retval;
+}
+
+template< typename NumericT, typename Epsilon >
+int block_ilu_test(Epsilon const& epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+  laplace_2d_system<NumericT> laplace(epsilon);
+
+  viennacl::linalg::ilu0_precond<viennacl::compressed_matrix<NumericT> > vcl_ilu0(laplace.vcl_matrix, viennacl::linalg::ilu0_tag());
+  viennacl::linalg::cg_tag ilu0_tag(laplace.solver_tol, 1000);
+  viennacl::vector<NumericT> vcl_result = viennacl::linalg::solve(laplace.vcl_matrix, laplace.vcl_rhs, ilu0_tag, vcl_ilu0);
+
+  // a single block is plain ILU0:
+  viennacl::linalg::block_ilu_precond<viennacl::compressed_matrix<NumericT>, viennacl::linalg::ilu0_tag> vcl_block_ilu0_1(laplace.vcl_matrix, viennacl::linalg::ilu0_tag(), 1);
+  if (laplace.check_solve(viennacl::linalg::cg_tag(laplace.solver_tol, 1000), vcl_block_ilu0_1,
+                          ilu0_tag.iters(), "CG with block-ILU0 preconditioner, one block") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  // block numbers which do not divide the number of rows, and the default of one block per thread:
+  viennacl::linalg::block_ilu_precond<viennacl::compressed_matrix<NumericT>, viennacl::linalg::ilu0_tag> vcl_block_ilu0_7(laplace.vcl_matrix, viennacl::linalg::ilu0_tag(), 7);
+  if (laplace.check_solve(viennacl::linalg::cg_tag(laplace.solver_tol, 1000), vcl_block_ilu0_7,
+                          laplace.plain_tag.iters() - 1, "CG with block-ILU0 preconditioner, seven blocks") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  viennacl::linalg::block_ilu_precond<viennacl::compressed_matrix<NumericT>, viennacl::linalg::ilut_tag> vcl_block_ilut_3(laplace.vcl_matrix, viennacl::linalg::ilut_tag(), 3);
+  if (laplace.check_solve(viennacl::linalg::bicgstab_tag(laplace.solver_tol, 1000), vcl_block_ilut_3,
+                          laplace.plain_tag.iters() - 1, "BiCGStab with block-ILUT preconditioner, three blocks") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  viennacl::linalg::block_ilu_precond<viennacl::compressed_matrix<NumericT>, viennacl::linalg::ilu0_tag> vcl_block_ilu0_default(laplace.vcl_matrix, viennacl::linalg::ilu0_tag());
+  if (laplace.check_solve(viennacl::linalg::cg_tag(laplace.solver_tol, 1000), vcl_block_ilu0_default,
+                          laplace.plain_tag.iters() - 1, "CG with block-ILU0 preconditioner, one block per thread") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  // a single block applies the same triangular solves as ILU0:
+  std::cout << "Testing block-ILU0 preconditioner, one block against ILU0" << std::endl;
+  viennacl::vector<NumericT> vcl_block_apply = apply_precond(vcl_block_ilu0_1, laplace.vcl_rhs);
+  viennacl::vector<NumericT> vcl_ilu0_apply  = apply_precond(vcl_ilu0, laplace.vcl_rhs);
+  NumericT block_diff = viennacl::linalg::norm_inf(vcl_block_apply - vcl_ilu0_apply) / viennacl::linalg::norm_inf(vcl_ilu0_apply);
+  if (block_diff > epsilon)
+  {
+    std::cout << "# Error at operation: block-ILU0 preconditioner, one block against ILU0" << std::endl;
+    std::cout << "  relative diff: " << block_diff << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // the blocks are decoupled: a vector supported in the first of seven blocks stays there
+  std::cout << "Testing block-ILU0 preconditioner, decoupled blocks" << std::endl;
+  std::size_t first_block_size = laplace.ublas_matrix.size1() / 7;
+  std::vector<NumericT> std_unit(laplace.ublas_matrix.size1(), NumericT(0));
+  std_unit[first_block_size / 2] = NumericT(1);
+  viennacl::vector<NumericT> vcl_unit(std_unit.size(), laplace.host_ctx);
+  viennacl::copy(std_unit, vcl_unit);
+  std::vector<NumericT> std_block_apply(std_unit.size());
+  viennacl::copy(apply_precond(vcl_block_ilu0_7, vcl_unit), std_block_apply);
+  bool inside_nonzero = false;
+  bool outside_zero = true;
+  for (std::size_t i=0; i<std_block_apply.size(); ++i)
+  {
+    if (i < first_block_size)
+      inside_nonzero = inside_nonzero || (std_block_apply[i] != 0);
+    else
+      outside_zero = outside_zero && (std_block_apply[i] == 0);
+  }
+  if (!inside_nonzero || !outside_zero)
+  {
+    std::cout << "# Error at operation: block-ILU0 preconditioner, decoupled blocks" << std::endl;
+    std::cout << "  nonzeros in the first block: " << inside_nonzero << ", zeros outside: " << outside_zero << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+#ifdef VIENNACL_WITH_OPENMP
+  // each block is set up and applied by a single thread, so the result does not depend on the number of threads:
+  std::cout << "Testing block-ILU0 preconditioner with one and with several threads" << std::endl;
+  int num_threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  viennacl::linalg::block_ilu_precond<viennacl::compressed_matrix<NumericT>, viennacl::linalg::ilu0_tag> vcl_block_ilu0_sequential(laplace.vcl_matrix, viennacl::linalg::ilu0_tag(), 7);
+  viennacl::vector<NumericT> vcl_sequential_apply = apply_precond(vcl_block_ilu0_sequential, laplace.vcl_rhs);
+  omp_set_num_threads(std::max(num_threads, 4));
+  viennacl::vector<NumericT> vcl_parallel_apply = apply_precond(vcl_block_ilu0_7, laplace.vcl_rhs);
+  omp_set_num_threads(num_threads);
+  if (viennacl::linalg::norm_inf(vcl_sequential_apply - vcl_parallel_apply) > 0)
+  {
+    std::cout << "# Error at operation: block-ILU0 preconditioner with one and with several threads" << std::endl;
+    std::cout << "  diff: " << viennacl::linalg::norm_inf(vcl_sequential_apply - vcl_parallel_apply) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+#endif
+
+  // generic implementation, here with ublas types:
+  std::cout << "Testing CG with block-ILU0 preconditioner, ublas matrix" << std::endl;
+  viennacl::linalg::block_ilu_precond<ublas::compressed_matrix<NumericT>, viennacl::linalg::ilu0_tag> ublas_block_ilu0(laplace.ublas_matrix, viennacl::linalg::ilu0_tag(), 5);
+  viennacl::linalg::cg_tag ublas_tag(laplace.solver_tol, 1000);
+  ublas::vector<NumericT> ublas_result = viennacl::linalg::solve(laplace.ublas_matrix, laplace.rhs, ublas_tag, ublas_block_ilu0);
+  ublas::vector<NumericT> ublas_residual = laplace.rhs - ublas::prod(laplace.ublas_matrix, ublas_result);
+  if ( ublas::norm_2(ublas_residual) > 10 * laplace.solver_tol * ublas::norm_2(laplace.rhs) || ublas_tag.iters() >= laplace.plain_tag.iters() )
+  {
+    std::cout << "# Error at operation: CG with block-ILU0 preconditioner, ublas matrix" << std::endl;
+    std::cout << "  residual: " << ublas::norm_2(ublas_residual) / ublas::norm_2(laplace.rhs) << ", iterations: " << ublas_tag.iters() << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  return retval;
+}
+
+template<typename NumericT, typename VCLMatrixT, typename SolverTagT, typename PrecondT>
+int check_warm_start(ublas::compressed_matrix<NumericT> const & ublas_matrix, ublas::vector<NumericT> const & rhs,
+                     VCLMatrixT const & vcl_matrix, viennacl::vector<NumericT> const & vcl_rhs,
+                     SolverTagT const & tag, SolverTagT const & coarse_tag, SolverTagT const & fine_tag, PrecondT const & precond, std::string const & name)
+{
+  int retval = EXIT_SUCCESS;
+  std::vector<double> history;
+  history.reserve(tag.max_iterations() + 1);
+
+  // zero initial guess, the recorded residuals end with the reported error:
+  std::cout << "Testing " << name << " with residual history" << std::endl;
+  SolverTagT cold_tag = tag;
+  cold_tag.residual_history(&history);
+  viennacl::vector<NumericT> vcl_result = viennacl::linalg::solve(vcl_matrix, vcl_rhs, cold_tag, precond);
+  NumericT residual = relative_residual(ublas_matrix, rhs, vcl_result);
+  if ( residual > NumericT(10 * tag.tolerance()) || history.size() != cold_tag.iters() || history.size() == 0
+      || history.back() >= tag.tolerance() || std::fabs(history.back() - cold_tag.error()) > 1e-3 * tag.tolerance() )
+  {
+    std::cout << "# Error at operation: " << name << " with residual history" << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << cold_tag.iters() << ", recorded residuals: " << history.size() << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // an approximate solution as initial guess saves iterations:
+  std::cout << "Testing " << name << " with initial guess" << std::endl;
+  viennacl::vector<NumericT> vcl_guess = viennacl::linalg::solve(vcl_matrix, vcl_rhs, coarse_tag, precond);
+  SolverTagT warm_tag = tag;
+  warm_tag.residual_history(&history);
+  vcl_result = viennacl::linalg::solve(vcl_matrix, vcl_rhs, warm_tag, precond, vcl_guess);
+  residual = relative_residual(ublas_matrix, rhs, vcl_result);
+  if ( residual > NumericT(10 * tag.tolerance()) || warm_tag.iters() >= cold_tag.iters() || history.size() != warm_tag.iters() )
+  {
+    std::cout << "# Error at operation: " << name << " with initial guess" << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << warm_tag.iters() << " (expected less than " << cold_tag.iters() << ")" << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // an accurate solution as initial guess needs no iterations and leaves the residual history empty:
+  viennacl::vector<NumericT> vcl_converged = viennacl::linalg::solve(vcl_matrix, vcl_rhs, fine_tag, precond);
+  SolverTagT converged_tag = tag;
+  converged_tag.residual_history(&history);
+  vcl_result = viennacl::linalg::solve(vcl_matrix, vcl_rhs, converged_tag, precond, vcl_converged);
+  residual = relative_residual(ublas_matrix, rhs, vcl_result);
+  if ( residual > NumericT(10 * tag.tolerance()) || converged_tag.iters() != 0 || history.size() != 0 )
+  {
+    std::cout << "# Error at operation: " << name << " with converged initial guess" << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << converged_tag.iters() << ", recorded residuals: " << history.size() << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  return retval;
+}
+
+template< typename NumericT, typename Epsilon >
+int warm_start_test(Epsilon const& epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+  laplace_2d_system<NumericT> laplace(epsilon);
+  NumericT coarse_tol = std::sqrt(laplace.solver_tol);
+  NumericT fine_tol   = laplace.solver_tol / 100;
+  viennacl::linalg::jacobi_precond<viennacl::compressed_matrix<NumericT> > vcl_jacobi(laplace.vcl_matrix, viennacl::linalg::jacobi_tag());
+
+  if (check_warm_start(laplace.ublas_matrix, laplace.rhs, laplace.vcl_matrix, laplace.vcl_rhs, viennacl::linalg::cg_tag(laplace.solver_tol, 1000), viennacl::linalg::cg_tag(coarse_tol, 1000), viennacl::linalg::cg_tag(fine_tol, 1000),
+                       viennacl::linalg::no_precond(), "CG") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+  if (check_warm_start(laplace.ublas_matrix, laplace.rhs, laplace.vcl_matrix, laplace.vcl_rhs, viennacl::linalg::cg_tag(laplace.solver_tol, 1000), viennacl::linalg::cg_tag(coarse_tol, 1000), viennacl::linalg::cg_tag(fine_tol, 1000),
+                       vcl_jacobi, "CG with Jacobi preconditioner") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+  if (check_warm_start(laplace.ublas_matrix, laplace.rhs, laplace.vcl_matrix, laplace.vcl_rhs, viennacl::linalg::bicgstab_tag(laplace.solver_tol, 1000), viennacl::linalg::bicgstab_tag(coarse_tol, 1000), viennacl::linalg::bicgstab_tag(fine_tol, 1000),
+                       viennacl::linalg::no_precond(), "BiCGStab") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+  if (check_warm_start(laplace.ublas_matrix, laplace.rhs, laplace.vcl_matrix, laplace.vcl_rhs, viennacl::linalg::bicgstab_tag(laplace.solver_tol, 1000), viennacl::linalg::bicgstab_tag(coarse_tol, 1000), viennacl::linalg::bicgstab_tag(fine_tol, 1000),
+                       vcl_jacobi, "BiCGStab with Jacobi preconditioner") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+  if (check_warm_start(laplace.ublas_matrix, laplace.rhs, laplace.vcl_matrix, laplace.vcl_rhs, viennacl::linalg::gmres_tag(laplace.solver_tol, 1000, 30), viennacl::linalg::gmres_tag(coarse_tol, 1000, 30), viennacl::linalg::gmres_tag(fine_tol, 1000, 30),
+                       viennacl::linalg::no_precond(), "GMRES") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+  if (check_warm_start(laplace.ublas_matrix, laplace.rhs, laplace.vcl_matrix, laplace.vcl_rhs, viennacl::linalg::gmres_tag(laplace.solver_tol, 1000, 30), viennacl::linalg::gmres_tag(coarse_tol, 1000, 30), viennacl::linalg::gmres_tag(fine_tol, 1000, 30),
+                       vcl_jacobi, "GMRES with Jacobi preconditioner") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  return retval;
+}
+
+template< typename NumericT, typename Epsilon >
+int ssor_test(Epsilon const& epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+  laplace_2d_system<NumericT> laplace(epsilon);
+
+  // the five-point stencil admits a red-black ordering:
+  viennacl::linalg::ssor_precond<viennacl::compressed_matrix<NumericT> > vcl_sgs(laplace.vcl_matrix, viennacl::linalg::ssor_tag());
+  if (vcl_sgs.colors() != 2)
+  {
+    std::cout << "# Error at operation: multicolor ordering of the 2D Laplace operator" << std::endl;
+    std::cout << "  colors: " << vcl_sgs.colors() << " (expected 2)" << std::endl;
+    retval = EXIT_FAILURE;
+  }
+  if (laplace.check_solve(viennacl::linalg::cg_tag(laplace.solver_tol, 1000), vcl_sgs,
+                          laplace.plain_tag.iters() * 3 / 4, "CG with symmetric Gauss-Seidel preconditioner") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  viennacl::linalg::ssor_precond<viennacl::compressed_matrix<NumericT> > vcl_ssor(laplace.vcl_matrix, viennacl::linalg::ssor_tag(1.5, 2));
+  if (laplace.check_solve(viennacl::linalg::cg_tag(laplace.solver_tol, 1000), vcl_ssor,
+                          laplace.plain_tag.iters() / 2, "CG with SSOR preconditioner, two sweeps") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  // new values with the same pattern: the result must agree with a preconditioner set up for the new values
+  viennacl::compressed_matrix<NumericT> vcl_matrix2(laplace.ublas_matrix.size1(), laplace.ublas_matrix.size2(), laplace.host_ctx);
+  ublas::compressed_matrix<NumericT> ublas_matrix2(laplace.ublas_matrix);
+  for (typename ublas::compressed_matrix<NumericT>::iterator1 row_it = ublas_matrix2.begin1(); row_it != ublas_matrix2.end1(); ++row_it)
+    for (typename ublas::compressed_matrix<NumericT>::iterator2 col_it = row_it.begin(); col_it != row_it.end(); ++col_it)
+      if (col_it.index1() == col_it.index2())
+        *col_it += NumericT(1);
+  viennacl::copy(ublas_matrix2, vcl_matrix2);
+
+  viennacl::linalg::ssor_precond<viennacl::compressed_matrix<NumericT> > vcl_ssor2(vcl_matrix2, viennacl::linalg::ssor_tag(1.5, 2));
+  vcl_ssor.update_values(vcl_matrix2);
+  viennacl::vector<NumericT> vcl_apply_updated(laplace.vcl_rhs);
+  viennacl::vector<NumericT> vcl_apply_fresh(laplace.vcl_rhs);
+  vcl_ssor.apply(vcl_apply_updated);
+  vcl_ssor2.apply(vcl_apply_fresh);
+  NumericT update_diff = viennacl::linalg::norm_inf(vcl_apply_updated - vcl_apply_fresh);
+  if (update_diff > 0 || vcl_ssor.colors() != 2)
+  {
+    std::cout << "# Error at operation: SSOR preconditioner after update_values()" << std::endl;
+    std::cout << "  diff: " << update_diff << ", colors: " << vcl_ssor.colors() << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  viennacl::linalg::ssor_precond<viennacl::compressed_matrix<NumericT> > vcl_sor(laplace.vcl_matrix, viennacl::linalg::ssor_tag(1.2, 1, false));
+  if (laplace.check_solve(viennacl::linalg::bicgstab_tag(laplace.solver_tol, 1000), vcl_sor,
+                          laplace.plain_tag.iters() - 1, "BiCGStab with SOR preconditioner") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  // Gauss-Seidel smoother in AMG:
+  viennacl::linalg::amg_tag jacobi_amg_tag(VIENNACL_AMG_COARSE_RS, VIENNACL_AMG_INTERPOL_DIRECT, 0.25, 0.2, 0.67, 1, 1, 0);
+  viennacl::linalg::amg_precond<viennacl::compressed_matrix<NumericT> > vcl_jacobi_amg(laplace.vcl_matrix, jacobi_amg_tag);
+  vcl_jacobi_amg.setup();
+  viennacl::linalg::cg_tag jacobi_amg_cg_tag(laplace.solver_tol, 1000);
+  viennacl::vector<NumericT> vcl_result = viennacl::linalg::solve(laplace.vcl_matrix, laplace.vcl_rhs, jacobi_amg_cg_tag, vcl_jacobi_amg);
+
+  viennacl::linalg::amg_tag gs_amg_tag(VIENNACL_AMG_COARSE_RS, VIENNACL_AMG_INTERPOL_DIRECT, 0.25, 0.2, 1.0, 1, 1, 0, VIENNACL_AMG_SMOOTHER_GAUSS_SEIDEL);
+  viennacl::linalg::amg_precond<viennacl::compressed_matrix<NumericT> > vcl_gs_amg(laplace.vcl_matrix, gs_amg_tag);
+  vcl_gs_amg.setup();
+  if (laplace.check_solve(viennacl::linalg::cg_tag(laplace.solver_tol, 1000), vcl_gs_amg,
+                          jacobi_amg_cg_tag.iters(), "CG with AMG preconditioner, Gauss-Seidel smoother") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  return retval;
+}
+
+template< typename NumericT, typename Epsilon >
+int sparse_cholesky_test(Epsilon const& epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+  laplace_2d_system<NumericT> laplace(epsilon);
+  ublas::vector<NumericT> rhs(laplace.ublas_matrix.size1());
+  for (std::size_t i=0; i<rhs.size(); ++i)
+    rhs[i] = random<NumericT>();
+  viennacl::vector<NumericT> vcl_rhs(rhs.size(), laplace.host_ctx);
+  viennacl::copy(rhs, vcl_rhs);
+
+  NumericT direct_tol = 100 * epsilon;
+
+  std::vector<int> orderings;
+  std::vector<std::string> ordering_names;
+  orderings.push_back(viennacl::linalg::sparse_cholesky_tag::natural_ordering);               ordering_names.push_back("natural");
+  orderings.push_back(viennacl::linalg::sparse_cholesky_tag::reverse_cuthill_mckee_ordering); ordering_names.push_back("reverse Cuthill-McKee");
+  orderings.push_back(viennacl::linalg::sparse_cholesky_tag::nested_dissection_ordering);     ordering_names.push_back("nested dissection");
+
+  std::vector<std::size_t> factor_nnz;
+  for (std::size_t k=0; k<orderings.size(); ++k)
+  {
+    std::cout << "Testing sparse Cholesky factorization, " << ordering_names[k] << " ordering" << std::endl;
+    viennacl::linalg::sparse_cholesky<NumericT> factorization(laplace.vcl_matrix, viennacl::linalg::sparse_cholesky_tag(orderings[k]));
+    viennacl::vector<NumericT> vcl_result = vcl_rhs;
+    factorization.solve(vcl_result);
+    factor_nnz.push_back(factorization.nnz());
+
+    std::vector<bool> is_permuted(rhs.size(), false);
+    for (std::size_t i=0; i<factorization.permutation().size(); ++i)
+      if (factorization.permutation()[i] < is_permuted.size())
+        is_permuted[factorization.permutation()[i]] = true;
+    bool is_permutation = (factorization.permutation().size() == rhs.size()) && std::find(is_permuted.begin(), is_permuted.end(), false) == is_permuted.end();
+
+    NumericT residual = relative_residual(laplace.ublas_matrix, rhs, vcl_result);
+    if ( residual > direct_tol || !is_permutation )
+    {
+      std::cout << "# Error at operation: sparse Cholesky factorization, " << ordering_names[k] << " ordering" << std::endl;
+      std::cout << "  residual: " << residual << ", valid permutation: " << is_permutation << std::endl;
+      retval = EXIT_FAILURE;
+    }
+  }
+
+  // the fill-reducing orderings reduce the fill-in compared to the banded natural ordering:
+  if (factor_nnz[2] >= factor_nnz[0] || factor_nnz[1] > factor_nnz[0])
+  {
+    std::cout << "# Error at operation: fill-in of the sparse Cholesky factor" << std::endl;
+    std::cout << "  nonzeros (natural, RCM, ND): " << factor_nnz[0] << ", " << factor_nnz[1] << ", " << factor_nnz[2] << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // single-column supernodes, and the convenience solve() interface:
+  std::cout << "Testing sparse Cholesky factorization, single-column supernodes" << std::endl;
+  viennacl::vector<NumericT> vcl_result = viennacl::linalg::solve(laplace.vcl_matrix, vcl_rhs, viennacl::linalg::sparse_cholesky_tag(viennacl::linalg::sparse_cholesky_tag::nested_dissection_ordering, 1));
+  NumericT residual = relative_residual(laplace.ublas_matrix, rhs, vcl_result);
+  if ( residual > direct_tol )
+  {
+    std::cout << "# Error at operation: sparse Cholesky factorization, single-column supernodes" << std::endl;
+    std::cout << "  residual: " << residual << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // new values with the same sparsity pattern reuse the symbolic analysis:
+  std::cout << "Testing sparse Cholesky refactorization" << std::endl;
+  viennacl::linalg::sparse_cholesky<NumericT> factorization(laplace.vcl_matrix);
+  std::size_t supernodes = factorization.supernodes();
+  ublas::compressed_matrix<NumericT> ublas_matrix2 = NumericT(2) * laplace.ublas_matrix;
+  for (std::size_t i=0; i<ublas_matrix2.size1(); ++i)
+    ublas_matrix2(i, i) += NumericT(1);
+  viennacl::compressed_matrix<NumericT> vcl_matrix2(ublas_matrix2.size1(), ublas_matrix2.size2(), laplace.host_ctx);
+  viennacl::copy(ublas_matrix2, vcl_matrix2);
+  factorization.factorize(vcl_matrix2);
+  vcl_result = vcl_rhs;
+  factorization.solve(vcl_result);
+  residual = relative_residual(ublas_matrix2, rhs, vcl_result);
+  if ( residual > direct_tol || factorization.supernodes() != supernodes )
+  {
+    std::cout << "# Error at operation: sparse Cholesky refactorization" << std::endl;
+    std::cout << "  residual: " << residual << ", supernodes: " << factorization.supernodes() << " (before: " << supernodes << ")" << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // matrices which are not positive definite are rejected:
+  std::cout << "Testing sparse Cholesky factorization of an indefinite matrix" << std::endl;
+  ublas::compressed_matrix<NumericT> ublas_indefinite = NumericT(-1) * laplace.ublas_matrix;
+  viennacl::compressed_matrix<NumericT> vcl_indefinite(ublas_indefinite.size1(), ublas_indefinite.size2(), laplace.host_ctx);
+  viennacl::copy(ublas_indefinite, vcl_indefinite);
+  bool exception_thrown = false;
+  try
+  {
+    factorization.factorize(vcl_indefinite);
+  }
+  catch (...)
+  {
+    exception_thrown = true;
+  }
+  if (!exception_thrown)
+  {
+    std::cout << "# Error at operation: sparse Cholesky factorization of an indefinite matrix" << std::endl;
+    std::cout << "  no exception thrown" << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  return retval;
+}
+
+template< typename NumericT, typename Epsilon >
+int chebyshev_test(Epsilon const& epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+  laplace_2d_system<NumericT> laplace(epsilon);
+
+  // the estimated spectral bounds are stored in the tag. The spectrum of the 2D Laplace operator is contained in (0, 8):
+  std::cout << "Testing Chebyshev iteration" << std::endl;
+  viennacl::linalg::chebyshev_tag cheby_tag(laplace.solver_tol, 5000);
+  viennacl::vector<NumericT> vcl_result = viennacl::linalg::solve(laplace.vcl_matrix, laplace.vcl_rhs, cheby_tag);
+  NumericT residual = relative_residual(laplace.ublas_matrix, laplace.rhs, vcl_result);
+  if ( residual > 10 * laplace.solver_tol || cheby_tag.iters() >= cheby_tag.max_iterations()
+      || cheby_tag.lambda_min() <= 0 || cheby_tag.lambda_min() >= cheby_tag.lambda_max() || cheby_tag.lambda_max() > 8 )
+  {
+    std::cout << "# Error at operation: Chebyshev iteration" << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << cheby_tag.iters()
+              << ", spectral bounds: [" << cheby_tag.lambda_min() << ", " << cheby_tag.lambda_max() << "]" << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // the second run reuses the spectral bounds:
+  unsigned int first_run_iters = cheby_tag.iters();
+  double lambda_min = cheby_tag.lambda_min();
+  double lambda_max = cheby_tag.lambda_max();
+  vcl_result = viennacl::linalg::solve(laplace.vcl_matrix, laplace.vcl_rhs, cheby_tag);
+  if ( cheby_tag.iters() != first_run_iters || cheby_tag.lambda_min() != lambda_min || cheby_tag.lambda_max() != lambda_max )
+  {
+    std::cout << "# Error at operation: Chebyshev iteration, second run" << std::endl;
+    std::cout << "  iterations: " << cheby_tag.iters() << " (first run: " << first_run_iters << ")" << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  std::cout << "Testing Chebyshev iteration with Jacobi preconditioner" << std::endl;
+  viennacl::linalg::jacobi_precond<viennacl::compressed_matrix<NumericT> > vcl_jacobi(laplace.vcl_matrix, viennacl::linalg::jacobi_tag());
+  viennacl::linalg::chebyshev_tag jacobi_tag(laplace.solver_tol, 5000);
+  vcl_result = viennacl::linalg::solve(laplace.vcl_matrix, laplace.vcl_rhs, jacobi_tag, vcl_jacobi);
+  residual = relative_residual(laplace.ublas_matrix, laplace.rhs, vcl_result);
+  if ( residual > 10 * laplace.solver_tol || jacobi_tag.iters() >= jacobi_tag.max_iterations() )
+  {
+    std::cout << "# Error at operation: Chebyshev iteration with Jacobi preconditioner" << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << jacobi_tag.iters() << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  std::cout << "Testing Chebyshev iteration with zero right hand side" << std::endl;
+  viennacl::vector<NumericT> vcl_zero_rhs = viennacl::zero_vector<NumericT>(laplace.rhs.size(), laplace.host_ctx);
+  vcl_result = viennacl::linalg::solve(laplace.vcl_matrix, vcl_zero_rhs, cheby_tag);
+  if ( viennacl::linalg::norm_2(vcl_result) > 0 || cheby_tag.iters() != 0 )
+  {
+    std::cout << "# Error at operation: Chebyshev iteration with zero right hand side" << std::endl;
+    std::cout << "  iterations: " << cheby_tag.iters() << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // polynomial preconditioners:
+  viennacl::linalg::chebyshev_precond<viennacl::compressed_matrix<NumericT> > vcl_cheby_precond(laplace.vcl_matrix, viennacl::linalg::chebyshev_precond_tag(3));
+  if (laplace.check_solve(viennacl::linalg::cg_tag(laplace.solver_tol, 1000), vcl_cheby_precond,
+                          laplace.plain_tag.iters() / 2, "CG with Chebyshev polynomial preconditioner") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  viennacl::linalg::chebyshev_precond<viennacl::compressed_matrix<NumericT> > vcl_neumann_precond(laplace.vcl_matrix, viennacl::linalg::chebyshev_precond_tag(3, 30.0, 20, true));
+  if (laplace.check_solve(viennacl::linalg::cg_tag(laplace.solver_tol, 1000), vcl_neumann_precond,
+                          laplace.plain_tag.iters() - 1, "CG with Neumann polynomial preconditioner") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+
+  // CG requires a symmetric positive definite preconditioner:
+  std::cout << "Testing symmetry of the Chebyshev polynomial preconditioner" << std::endl;
+  std::vector<NumericT> std_x(laplace.rhs.size());
+  std::vector<NumericT> std_y(laplace.rhs.size());
+  for (std::size_t i=0; i<std_x.size(); ++i)
+  {
+    std_x[i] = random<NumericT>();
+    std_y[i] = random<NumericT>();
+  }
+  viennacl::vector<NumericT> vcl_x(std_x.size(), laplace.host_ctx);
+  viennacl::vector<NumericT> vcl_y(std_y.size(), laplace.host_ctx);
+  viennacl::copy(std_x, vcl_x);
+  viennacl::copy(std_y, vcl_y);
+  viennacl::vector<NumericT> vcl_Px = apply_precond(vcl_cheby_precond, vcl_x);
+  viennacl::vector<NumericT> vcl_Py = apply_precond(vcl_cheby_precond, vcl_y);
+  NumericT yPx = viennacl::linalg::inner_prod(vcl_y, vcl_Px);
+  NumericT xPy = viennacl::linalg::inner_prod(vcl_x, vcl_Py);
+  NumericT xPx = viennacl::linalg::inner_prod(vcl_x, vcl_Px);
+  NumericT symmetry_diff = std::fabs(yPx - xPy) / (viennacl::linalg::norm_2(vcl_x) * viennacl::linalg::norm_2(vcl_Py));
+  if (symmetry_diff > epsilon || xPx <= 0)
+  {
+    std::cout << "# Error at operation: symmetry of the Chebyshev polynomial preconditioner" << std::endl;
+    std::cout << "  y^T P x: " << yPx << ", x^T P y: " << xPy << ", x^T P x: " << xPx << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  return retval;
+}
+
+template< typename NumericT, typename Epsilon >
+int deflated_cg_test(Epsilon const& epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+  laplace_2d_system<NumericT> laplace(epsilon);
+
+  // a sequence of systems with the same matrix, the recycle space from each run accelerates the following ones:
+  viennacl::linalg::deflated_cg_tag<NumericT> deflated_tag(laplace.solver_tol, 1000, 8, 16);
+  for (std::size_t k=0; k<4; ++k)
+  {
+    std::cout << "Testing deflated CG, system " << k << std::endl;
+    ublas::vector<NumericT> rhs(laplace.ublas_matrix.size1());
+    for (std::size_t i=0; i<rhs.size(); ++i)
+      rhs[i] = random<NumericT>();
+    viennacl::vector<NumericT> vcl_rhs(rhs.size(), laplace.host_ctx);
+    viennacl::copy(rhs, vcl_rhs);
+
+    viennacl::linalg::cg_tag plain_tag(laplace.solver_tol, 1000);
+    viennacl::vector<NumericT> vcl_result = viennacl::linalg::solve(laplace.vcl_matrix, vcl_rhs, plain_tag);
+
+    vcl_result = viennacl::linalg::solve(laplace.vcl_matrix, vcl_rhs, deflated_tag);
+    NumericT residual = relative_residual(laplace.ublas_matrix, rhs, vcl_result);
+    bool has_recycle_space = deflated_tag.has_recycle_space() && deflated_tag.recycle_space().size1() == rhs.size();
+    std::size_t max_iters = (k == 0) ? plain_tag.iters() + 1 : plain_tag.iters() - 1; // without a recycle space, deflated CG is plain CG
+    if ( residual > 10 * laplace.solver_tol || !has_recycle_space || deflated_tag.iters() > max_iters )
+    {
+      std::cout << "# Error at operation: deflated CG, system " << k << std::endl;
+      std::cout << "  residual: " << residual << ", iterations: " << deflated_tag.iters() << " (expected at most " << max_iters << ")" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+  }
+
+  // right hand side in A * span(W): the deflated initial guess is already the solution, and the recycle space is kept
+  std::cout << "Testing deflated CG with the solution in the recycle space" << std::endl;
+  typedef typename viennacl::linalg::deflated_cg_tag<NumericT>::recycle_space_type RecycleSpaceType;
+  RecycleSpaceType W = deflated_tag.recycle_space();
+  viennacl::vector<NumericT> vcl_coefficients = viennacl::scalar_vector<NumericT>(W.size2(), NumericT(1), laplace.host_ctx);
+  viennacl::vector<NumericT> vcl_solution = viennacl::linalg::prod(W, vcl_coefficients);
+  viennacl::vector<NumericT> vcl_span_rhs = viennacl::linalg::prod(laplace.vcl_matrix, vcl_solution);
+  ublas::vector<NumericT> span_rhs(vcl_span_rhs.size());
+  viennacl::copy(vcl_span_rhs, span_rhs);
+
+  viennacl::vector<NumericT> vcl_span_result = viennacl::linalg::solve(laplace.vcl_matrix, vcl_span_rhs, deflated_tag);
+  NumericT residual = relative_residual(laplace.ublas_matrix, span_rhs, vcl_span_result);
+  bool recycle_space_kept = deflated_tag.has_recycle_space() && deflated_tag.recycle_space().size2() == W.size2()
+                         && viennacl::linalg::norm_frobenius(RecycleSpaceType(deflated_tag.recycle_space() - W)) <= 0;
+  if ( residual > 10 * laplace.solver_tol || deflated_tag.iters() != 0 || !recycle_space_kept )
+  {
+    std::cout << "# Error at operation: deflated CG with the solution in the recycle space" << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << deflated_tag.iters() << ", recycle space kept: " << recycle_space_kept << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // linearly dependent columns make W^T A W singular, so the recycle space is discarded and the solve falls back to plain CG:
+  std::cout << "Testing deflated CG with a linearly dependent recycle space" << std::endl;
+  RecycleSpaceType W_dependent(W.size1(), W.size2() + 1, laplace.host_ctx);
+  viennacl::project(W_dependent, viennacl::range(0, W.size1()), viennacl::range(0, W.size2())) = W;
+  viennacl::project(W_dependent, viennacl::range(0, W.size1()), viennacl::range(W.size2(), W.size2() + 1)) = viennacl::project(W, viennacl::range(0, W.size1()), viennacl::range(0, 1));
+  deflated_tag.recycle_space(W_dependent);
+  viennacl::vector<NumericT> vcl_dependent_result = viennacl::linalg::solve(laplace.vcl_matrix, laplace.vcl_rhs, deflated_tag);
+  residual = relative_residual(laplace.ublas_matrix, laplace.rhs, vcl_dependent_result);
+  if ( residual > 10 * laplace.solver_tol || deflated_tag.iters() > laplace.plain_tag.iters() + 1 || deflated_tag.recycle_space().size2() > deflated_tag.recycle_dim() )
+  {
+    std::cout << "# Error at operation: deflated CG with a linearly dependent recycle space" << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << deflated_tag.iters() << " (without deflation: " << laplace.plain_tag.iters() << ")" << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // a recycle space of the wrong size is discarded:
+  std::cout << "Testing deflated CG with a recycle space of a different system" << std::endl;
+  ublas::compressed_matrix<NumericT> ublas_small_matrix;
+  generate_laplace_2d(ublas_small_matrix, 20);
+  ublas::vector<NumericT> small_rhs = ublas::scalar_vector<NumericT>(ublas_small_matrix.size1(), NumericT(1));
+  viennacl::compressed_matrix<NumericT> vcl_small_matrix(ublas_small_matrix.size1(), ublas_small_matrix.size2(), laplace.host_ctx);
+  viennacl::vector<NumericT> vcl_small_rhs(small_rhs.size(), laplace.host_ctx);
+  viennacl::copy(ublas_small_matrix, vcl_small_matrix);
+  viennacl::copy(small_rhs, vcl_small_rhs);
+
+  viennacl::vector<NumericT> vcl_small_result = viennacl::linalg::solve(vcl_small_matrix, vcl_small_rhs, deflated_tag);
+  residual = relative_residual(ublas_small_matrix, small_rhs, vcl_small_result);
+  if ( residual > 10 * laplace.solver_tol || !deflated_tag.has_recycle_space() || deflated_tag.recycle_space().size1() != small_rhs.size() )
+  {
+    std::cout << "# Error at operation: deflated CG with a recycle space of a different system" << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << deflated_tag.iters() << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  return retval;
+}
+
+template< typename NumericT, typename Epsilon >
+int pipelined_gmres_test(Epsilon const& epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+  // nonsymmetric convection-diffusion operator:
+  ublas::compressed_matrix<NumericT> ublas_matrix;
+  generate_convection_diffusion_2d(ublas_matrix, 40);
+  ublas::vector<NumericT> rhs = ublas::scalar_vector<NumericT>(ublas_matrix.size1(), NumericT(1));
+
+  viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+  viennacl::compressed_matrix<NumericT> vcl_matrix(ublas_matrix.size1(), ublas_matrix.size2(), host_ctx);
+  viennacl::vector<NumericT> vcl_rhs(rhs.size(), host_ctx);
+  viennacl::copy(ublas_matrix, vcl_matrix);
+  viennacl::copy(rhs, vcl_rhs);
+
+  NumericT solver_tol = std::sqrt(epsilon);
+
+  // reference: Householder-based GMRES (generic implementation) with ublas types
+  viennacl::linalg::gmres_tag householder_tag(solver_tol, 1000, 20);
+  ublas::vector<NumericT> ublas_result = viennacl::linalg::solve(ublas_matrix, rhs, householder_tag);
+
+  // the pipelined Arnoldi process spans the same Krylov spaces, so the iteration counts agree up to round-off:
+  std::cout << "Testing pipelined GMRES" << std::endl;
+  viennacl::linalg::gmres_tag pipelined_tag(solver_tol, 1000, 20);
+  viennacl::vector<NumericT> vcl_result = viennacl::linalg::solve(vcl_matrix, vcl_rhs, pipelined_tag);
+  NumericT residual = relative_residual(ublas_matrix, rhs, vcl_result);
+  if ( residual > 10 * solver_tol || pipelined_tag.iters() > householder_tag.iters() + householder_tag.iters() / 10 )
+  {
+    std::cout << "# Error at operation: pipelined GMRES" << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << pipelined_tag.iters() << " (reference: " << householder_tag.iters() << ")" << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // zero right hand side: zero solution, and the tag reports no iterations instead of the values from the previous run
+  std::cout << "Testing pipelined GMRES with zero right hand side" << std::endl;
+  viennacl::vector<NumericT> vcl_zero_rhs = viennacl::zero_vector<NumericT>(rhs.size(), host_ctx);
+  vcl_result = viennacl::linalg::solve(vcl_matrix, vcl_zero_rhs, pipelined_tag);
+  if ( viennacl::linalg::norm_2(vcl_result) > 0 || pipelined_tag.iters() != 0 || pipelined_tag.error() > 0 )
+  {
+    std::cout << "# Error at operation: pipelined GMRES with zero right hand side" << std::endl;
+    std::cout << "  iterations: " << pipelined_tag.iters() << ", estimate: " << pipelined_tag.error() << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // system above the OpenMP threshold, so that the fused reductions are split into several row chunks:
+  std::cout << "Testing pipelined GMRES on a large system" << std::endl;
+  ublas::compressed_matrix<NumericT> ublas_large_matrix;
+  generate_convection_diffusion_2d(ublas_large_matrix, 80);
+  ublas::vector<NumericT> large_rhs = ublas::scalar_vector<NumericT>(ublas_large_matrix.size1(), NumericT(1));
+  viennacl::compressed_matrix<NumericT> vcl_large_matrix(ublas_large_matrix.size1(), ublas_large_matrix.size2(), host_ctx);
+  viennacl::vector<NumericT> vcl_large_rhs(large_rhs.size(), host_ctx);
+  viennacl::copy(ublas_large_matrix, vcl_large_matrix);
+  viennacl::copy(large_rhs, vcl_large_rhs);
+
+  viennacl::linalg::gmres_tag large_householder_tag(solver_tol, 2000, 20);
+  ublas_result = viennacl::linalg::solve(ublas_large_matrix, large_rhs, large_householder_tag);
+
+#ifdef VIENNACL_WITH_OPENMP
+  int num_threads = omp_get_max_threads();
+  omp_set_num_threads(std::max(num_threads, 4));
+#endif
+  viennacl::linalg::gmres_tag large_tag(solver_tol, 2000, 20);
+  viennacl::vector<NumericT> vcl_large_result = viennacl::linalg::solve(vcl_large_matrix, vcl_large_rhs, large_tag);
+#ifdef VIENNACL_WITH_OPENMP
+  omp_set_num_threads(num_threads);
+#endif
+  residual = relative_residual(ublas_large_matrix, large_rhs, vcl_large_result);
+  if ( residual > 10 * solver_tol || large_tag.iters() > large_householder_tag.iters() + large_householder_tag.iters() / 10 )
+  {
+    std::cout << "# Error at operation: pipelined GMRES on a large system" << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << large_tag.iters() << " (reference: " << large_householder_tag.iters() << ")" << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // Krylov dimension larger than the system size:
+  std::cout << "Testing pipelined GMRES on a small system" << std::endl;
+  ublas::compressed_matrix<NumericT> ublas_small_matrix;
+  generate_laplace_2d(ublas_small_matrix, 3);
+  ublas::vector<NumericT> small_rhs = ublas::scalar_vector<NumericT>(ublas_small_matrix.size1(), NumericT(1));
+  viennacl::compressed_matrix<NumericT> vcl_small_matrix(ublas_small_matrix.size1(), ublas_small_matrix.size2(), host_ctx);
+  viennacl::vector<NumericT> vcl_small_rhs(small_rhs.size(), host_ctx);
+  viennacl::copy(ublas_small_matrix, vcl_small_matrix);
+  viennacl::copy(small_rhs, vcl_small_rhs);
+
+  viennacl::linalg::gmres_tag small_tag(solver_tol, 1000, 20);
+  vcl_result = viennacl::linalg::solve(vcl_small_matrix, vcl_small_rhs, small_tag);
+  residual = relative_residual(ublas_small_matrix, small_rhs, vcl_result);
+  if ( residual > 10 * solver_tol || small_tag.iters() > ublas_small_matrix.size1() )
+  {
+    std::cout << "# Error at operation: pipelined GMRES on a small system" << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << small_tag.iters() << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  return retval;
+}
+
+template<typename NumericT, typename MatrixT, typename TagT, typename PreconditionerT>
+int check_short_recurrence_solver(ublas::compressed_matrix<NumericT> const & ublas_matrix, ublas::vector<NumericT> const & rhs,
+                                  MatrixT const & vcl_matrix, viennacl::vector<NumericT> const & vcl_rhs,
+                                  TagT & tag, TagT const & fine_tag, PreconditionerT const & precond, std::string const & name)
+{
+  int retval = EXIT_SUCCESS;
+  viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+
+  std::cout << "Testing " << name << std::endl;
+  std::vector<double> history;
+  tag.residual_history(&history);
+  viennacl::vector<NumericT> vcl_result = viennacl::linalg::solve(vcl_matrix, vcl_rhs, tag, precond);
+  NumericT residual = relative_residual(ublas_matrix, rhs, vcl_result);
+  if ( residual > 10 * tag.tolerance() || tag.error() > tag.tolerance() || tag.iters() >= tag.max_iterations()
+      || history.empty() || history.back() > tag.tolerance() )
+  {
+    std::cout << "# Error at operation: " << name << std::endl;
+    std::cout << "  residual: " << residual << ", estimate: " << tag.error() << ", iterations: " << tag.iters() << ", recorded residuals: " << history.size() << std::endl;
+    retval = EXIT_FAILURE;
+  }
+  tag.residual_history(NULL);
+
+  // initial guess which already satisfies the tolerance: no iterations
+  viennacl::vector<NumericT> vcl_guess = viennacl::linalg::solve(vcl_matrix, vcl_rhs, fine_tag, precond);
+  vcl_result = viennacl::linalg::solve(vcl_matrix, vcl_rhs, tag, precond, vcl_guess);
+  residual = relative_residual(ublas_matrix, rhs, vcl_result);
+  if ( residual > 10 * tag.tolerance() || tag.iters() != 0 )
+  {
+    std::cout << "# Error at operation: " << name << " with converged initial guess" << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << tag.iters() << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // zero right hand side: zero solution, and the tag reports no iterations instead of the values from the previous run
+  viennacl::vector<NumericT> vcl_zero_rhs = viennacl::zero_vector<NumericT>(rhs.size(), host_ctx);
+  vcl_result = viennacl::linalg::solve(vcl_matrix, vcl_zero_rhs, tag, precond);
+  if ( viennacl::linalg::norm_2(vcl_result) > 0 || tag.iters() != 0 || tag.error() > 0 )
+  {
+    std::cout << "# Error at operation: " << name << " with zero right hand side" << std::endl;
+    std::cout << "  iterations: " << tag.iters() << ", estimate: " << tag.error() << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  return retval;
+}
+
+template< typename NumericT, typename Epsilon >
+int idrs_bicgstabl_test(Epsilon const& epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+  // nonsymmetric convection-diffusion operator:
+  ublas::compressed_matrix<NumericT> ublas_matrix;
+  generate_convection_diffusion_2d(ublas_matrix, 40);
+  ublas::vector<NumericT> rhs = ublas::scalar_vector<NumericT>(ublas_matrix.size1(), NumericT(1));
+
+  viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+  viennacl::compressed_matrix<NumericT> vcl_matrix(ublas_matrix.size1(), ublas_matrix.size2(), host_ctx);
+  viennacl::vector<NumericT> vcl_rhs(rhs.size(), host_ctx);
+  viennacl::copy(ublas_matrix, vcl_matrix);
+  viennacl::copy(rhs, vcl_rhs);
+
+  NumericT solver_tol = std::sqrt(epsilon);
+  viennacl::linalg::jacobi_precond< viennacl::compressed_matrix<NumericT> > vcl_jacobi(vcl_matrix, viennacl::linalg::jacobi_tag());
+
+  std::size_t degrees[] = {1, 2, 4};
+  for (std::size_t i=0; i<sizeof(degrees) / sizeof(degrees[0]); ++i)
+  {
+    viennacl::linalg::bicgstabl_tag tag(solver_tol, 1000, degrees[i]);
+    viennacl::linalg::bicgstabl_tag fine_tag(solver_tol / 100, 1000, degrees[i]);
+    std::string name = "BiCGStab(" + std::string(1, char('0' + degrees[i])) + ")";
+    if (check_short_recurrence_solver(ublas_matrix, rhs, vcl_matrix, vcl_rhs, tag, fine_tag, viennacl::linalg::no_precond(), name) != EXIT_SUCCESS)
+      retval = EXIT_FAILURE;
+    if (check_short_recurrence_solver(ublas_matrix, rhs, vcl_matrix, vcl_rhs, tag, fine_tag, vcl_jacobi, name + " with Jacobi preconditioner") != EXIT_SUCCESS)
+      retval = EXIT_FAILURE;
+  }
+
+  std::size_t shadow_dims[] = {1, 2, 4, 8};
+  for (std::size_t i=0; i<sizeof(shadow_dims) / sizeof(shadow_dims[0]); ++i)
+  {
+    viennacl::linalg::idrs_tag tag(solver_tol, 1000, shadow_dims[i]);
+    viennacl::linalg::idrs_tag fine_tag(solver_tol / 100, 1000, shadow_dims[i]);
+    std::string name = "IDR(" + std::string(1, char('0' + shadow_dims[i])) + ")";
+    if (check_short_recurrence_solver(ublas_matrix, rhs, vcl_matrix, vcl_rhs, tag, fine_tag, viennacl::linalg::no_precond(), name) != EXIT_SUCCESS)
+      retval = EXIT_FAILURE;
+    if (check_short_recurrence_solver(ublas_matrix, rhs, vcl_matrix, vcl_rhs, tag, fine_tag, vcl_jacobi, name + " with Jacobi preconditioner") != EXIT_SUCCESS)
+      retval = EXIT_FAILURE;
+  }
+
+  return retval;
+}
+
+template<typename NumericT>
+NumericT scalar_diff(NumericT s1, NumericT s2)
+{
+  if (s1 != s2)
+    return std::fabs(s1 - s2) / std::max(std::fabs(s1), std::fabs(s2));
+  return 0;
+}
+
+template<typename NumericT>
+void run_multi_vector_kernels(std::vector< viennacl::vector<NumericT> > & vecs, viennacl::vector<NumericT> const & y,
+                              std::vector<NumericT> & inner_prods, std::vector<NumericT> & gram, NumericT & y_dot_y, viennacl::vector<NumericT> & y_updated)
+{
+  viennacl::vector_tuple<NumericT> tuple = viennacl::linalg::detail::multi_vector_tuple(vecs, 0, vecs.size());
+  viennacl::linalg::detail::multi_vector_inner_prod(tuple, y, inner_prods);
+  viennacl::linalg::detail::multi_vector_gram_matrix(tuple, gram);
+
+  std::vector<NumericT> coeffs(vecs.size());
+  for (std::size_t i=0; i<coeffs.size(); ++i)
+    coeffs[i] = NumericT(1) / NumericT(i + 2);
+  y_updated = y;
+  y_dot_y = viennacl::linalg::detail::multi_vector_update(y_updated, tuple, coeffs);
+}
+
+template< typename NumericT, typename Epsilon >
+int multi_vector_kernel_test(Epsilon const& epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+  // several chunks of the fused reductions, the last one shorter than the others:
+  std::size_t size = 3 * 5000 + 17;
+  std::size_t num_vecs = 4;
+
+  viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+  std::vector< viennacl::vector<NumericT> > vecs(num_vecs, viennacl::vector<NumericT>(size, host_ctx));
+  viennacl::vector<NumericT> y(size, host_ctx);
+  std::vector<NumericT> host_y(size);
+  std::vector< std::vector<NumericT> > host_vecs(num_vecs, std::vector<NumericT>(size));
+  for (std::size_t k=0; k<size; ++k)
+  {
+    host_y[k] = random<NumericT>();
+    for (std::size_t i=0; i<num_vecs; ++i)
+      host_vecs[i][k] = random<NumericT>();
+  }
+  viennacl::copy(host_y, y);
+  for (std::size_t i=0; i<num_vecs; ++i)
+    viennacl::copy(host_vecs[i], vecs[i]);
+
+  std::cout << "Testing fused multi-vector kernels" << std::endl;
+  std::vector<NumericT> inner_prods, gram;
+  NumericT y_dot_y;
+  viennacl::vector<NumericT> y_updated(size, host_ctx);
+  run_multi_vector_kernels(vecs, y, inner_prods, gram, y_dot_y, y_updated);
+
+  NumericT max_diff = 0;
+  for (std::size_t i=0; i<num_vecs; ++i)
+  {
+    max_diff = std::max(max_diff, scalar_diff<NumericT>(inner_prods[i], viennacl::linalg::inner_prod(vecs[i], y)));
+    for (std::size_t j=0; j<num_vecs; ++j)
+      max_diff = std::max(max_diff, scalar_diff<NumericT>(gram[i * num_vecs + j], viennacl::linalg::inner_prod(vecs[i], vecs[j])));
+  }
+  max_diff = std::max(max_diff, scalar_diff<NumericT>(inner_prods[num_vecs], viennacl::linalg::inner_prod(y, y)));
+  max_diff = std::max(max_diff, scalar_diff<NumericT>(y_dot_y, viennacl::linalg::inner_prod(y_updated, y_updated)));
+  if (max_diff > epsilon)
+  {
+    std::cout << "# Error at operation: fused multi-vector kernels" << std::endl;
+    std::cout << "  diff: " << max_diff << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+#ifdef VIENNACL_WITH_OPENMP
+  // the partial sums must not depend on the number of threads:
+  std::cout << "Testing fused multi-vector kernels with one thread" << std::endl;
+  int num_threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  std::vector<NumericT> inner_prods_1, gram_1;
+  NumericT y_dot_y_1;
+  viennacl::vector<NumericT> y_updated_1(size, host_ctx);
+  run_multi_vector_kernels(vecs, y, inner_prods_1, gram_1, y_dot_y_1, y_updated_1);
+  omp_set_num_threads(num_threads);
+
+  if (inner_prods_1 != inner_prods || gram_1 != gram || y_dot_y_1 != y_dot_y)
+  {
+    std::cout << "# Error at operation: fused multi-vector kernels depend on the number of threads" << std::endl;
+    std::cout << "  y_dot_y: " << y_dot_y_1 << " (one thread) vs. " << y_dot_y << " (" << num_threads << " threads)" << std::endl;
+    retval = EXIT_FAILURE;
+  }
+#endif
+
+  return retval;
+}
+
+template<typename NumericT>
+NumericT max_relative_residual(ublas::compressed_matrix<NumericT> const & ublas_matrix, ublas::matrix<NumericT> const & rhs, viennacl::matrix<NumericT> const & vcl_x)
+{
+  ublas::matrix<NumericT> x(vcl_x.size1(), vcl_x.size2());
+  viennacl::copy(vcl_x, x);
+
+  NumericT max_residual = 0;
+  for (std::size_t j=0; j<rhs.size2(); ++j)
+  {
+    ublas::vector<NumericT> rhs_column = ublas::column(rhs, j);
+    ublas::vector<NumericT> x_column   = ublas::column(x, j);
+    ublas::vector<NumericT> residual   = rhs_column - ublas::prod(ublas_matrix, x_column);
+    if (ublas::norm_2(rhs_column) > 0)
+      max_residual = std::max(max_residual, NumericT(ublas::norm_2(residual) / ublas::norm_2(rhs_column)));
+    else if (ublas::norm_2(x_column) > 0) // zero right hand side must give a zero solution
+      max_residual = std::max(max_residual, NumericT(ublas::norm_2(x_column)));
+  }
+  return max_residual;
+}
+
+template< typename NumericT, typename Epsilon >
+int block_cg_test(Epsilon const& epsilon)
+{
+  int retval = EXIT_SUCCESS;
+
+  ublas::compressed_matrix<NumericT> ublas_matrix;
+  generate_laplace_2d(ublas_matrix, 30);
 
+  viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+  viennacl::compressed_matrix<NumericT> vcl_matrix(ublas_matrix.size1(), ublas_matrix.size2(), host_ctx);
+  viennacl::copy(ublas_matrix, vcl_matrix);
 
-template< typename NumericT, typename VCL_MATRIX, typename Epsilon >
-int resize_test(Epsilon const& epsilon)
-{
-   int retval = EXIT_SUCCESS;
+  std::size_t N = ublas_matrix.size1();
+  NumericT solver_tol = std::sqrt(epsilon);
 
-   ublas::compressed_matrix<NumericT> ublas_matrix(5,5);
-   VCL_MATRIX vcl_matrix;
+  // independent right hand sides:
+  ublas::matrix<NumericT> rhs(N, 4);
+  for (std::size_t i=0; i<N; ++i)
+    for (std::size_t j=0; j<rhs.size2(); ++j)
+      rhs(i, j) = random<NumericT>();
 
-   ublas_matrix(0,0) = NumericT(10.0); ublas_matrix(0, 1) = NumericT(0.1); ublas_matrix(0, 2) = NumericT(0.2); ublas_matrix(0, 3) = NumericT(0.3); ublas_matrix(0, 4) = NumericT(0.4);
-   ublas_matrix(1,0) = NumericT(1.0);  ublas_matrix(1, 1) = NumericT(1.1); ublas_matrix(1, 2) = NumericT(1.2); ublas_matrix(1, 3) = NumericT(1.3); ublas_matrix(1, 4) = NumericT(1.4);
-   ublas_matrix(2,0) = NumericT(2.0);  ublas_matrix(2, 1) = NumericT(2.1); ublas_matrix(2, 2) = NumericT(2.2); ublas_matrix(2, 3) = NumericT(2.3); ublas_matrix(2, 4) = NumericT(2.4);
-   ublas_matrix(3,0) = NumericT(3.0);  ublas_matrix(3, 1) = NumericT(3.1); ublas_matrix(3, 2) = NumericT(3.2); ublas_matrix(3, 3) = NumericT(3.3); ublas_matrix(3, 4) = NumericT(3.4);
-   ublas_matrix(4,0) = NumericT(4.0);  ublas_matrix(4, 1) = NumericT(4.1); ublas_matrix(4, 2) = NumericT(4.2); ublas_matrix(4, 3) = NumericT(4.3); ublas_matrix(4, 4) = NumericT(4.4);
+  // rank-deficient right hand sides: zero column, identical columns, and a column which is a linear combination of two others:
+  ublas::matrix<NumericT> rhs_deficient(N, 5);
+  for (std::size_t i=0; i<N; ++i)
+  {
+    rhs_deficient(i, 0) = rhs(i, 0);
+    rhs_deficient(i, 1) = 0;
+    rhs_deficient(i, 2) = rhs(i, 0);
+    rhs_deficient(i, 3) = rhs(i, 1);
+    rhs_deficient(i, 4) = rhs(i, 0) + NumericT(2) * rhs(i, 1);
+  }
 
-   viennacl::copy(ublas_matrix, vcl_matrix);
-   ublas::compressed_matrix<NumericT> other_matrix(ublas_matrix.size1(), ublas_matrix.size2());
-   viennacl::copy(vcl_matrix, other_matrix);
+  ublas::matrix<NumericT> rhs_zero = ublas::zero_matrix<NumericT>(N, 2);
 
-   std::cout << "Checking for equality after copy..." << std::endl;
-    if ( std::fabs(diff(ublas_matrix, vcl_matrix)) > epsilon )
-    {
-        std::cout << "# Error at operation: equality after copy with sparse matrix" << std::endl;
-        std::cout << "  diff: " << std::fabs(diff(ublas_matrix, vcl_matrix)) << std::endl;
-        return EXIT_FAILURE;
-    }
+  viennacl::matrix<NumericT> vcl_rhs(N, rhs.size2(), host_ctx);
+  viennacl::matrix<NumericT> vcl_rhs_deficient(N, rhs_deficient.size2(), host_ctx);
+  viennacl::matrix<NumericT> vcl_rhs_zero(N, rhs_zero.size2(), host_ctx);
+  viennacl::copy(rhs, vcl_rhs);
+  viennacl::copy(rhs_deficient, vcl_rhs_deficient);
+  viennacl::copy(rhs_zero, vcl_rhs_zero);
 
-   std::cout << "Testing resize to larger..." << std::endl;
-   ublas_matrix.resize(10, 10, false); //ublas does not allow preserve = true here
-   ublas_matrix(0,0) = NumericT(10.0); ublas_matrix(0, 1) = NumericT(0.1); ublas_matrix(0, 2) = NumericT(0.2); ublas_matrix(0, 3) = NumericT(0.3); ublas_matrix(0, 4) = NumericT(0.4);
-   ublas_matrix(1,0) = NumericT( 1.0); ublas_matrix(1, 1) = NumericT(1.1); ublas_matrix(1, 2) = NumericT(1.2); ublas_matrix(1, 3) = NumericT(1.3); ublas_matrix(1, 4) = NumericT(1.4);
-   ublas_matrix(2,0) = NumericT( 2.0); ublas_matrix(2, 1) = NumericT(2.1); ublas_matrix(2, 2) = NumericT(2.2); ublas_matrix(2, 3) = NumericT(2.3); ublas_matrix(2, 4) = NumericT(2.4);
-   ublas_matrix(3,0) = NumericT( 3.0); ublas_matrix(3, 1) = NumericT(3.1); ublas_matrix(3, 2) = NumericT(3.2); ublas_matrix(3, 3) = NumericT(3.3); ublas_matrix(3, 4) = NumericT(3.4);
-   ublas_matrix(4,0) = NumericT( 4.0); ublas_matrix(4, 1) = NumericT(4.1); ublas_matrix(4, 2) = NumericT(4.2); ublas_matrix(4, 3) = NumericT(4.3); ublas_matrix(4, 4) = NumericT(4.4);
-   //std::cout << ublas_matrix << std::endl;
+  std::cout << "Testing CG with multiple right hand sides" << std::endl;
+  viennacl::linalg::cg_tag multi_tag(solver_tol, 1000);
+  viennacl::matrix<NumericT> vcl_result = viennacl::linalg::solve(vcl_matrix, vcl_rhs, multi_tag);
+  NumericT residual = max_relative_residual(ublas_matrix, rhs, vcl_result);
+  if ( residual > 10 * solver_tol || multi_tag.iters() >= multi_tag.max_iterations() )
+  {
+    std::cout << "# Error at operation: CG with multiple right hand sides" << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << multi_tag.iters() << std::endl;
+    retval = EXIT_FAILURE;
+  }
 
-   vcl_matrix.resize(10, 10, true);
+  // the shared Krylov space must not need more iterations than the separate ones:
+  std::cout << "Testing block CG" << std::endl;
+  viennacl::linalg::block_cg_tag block_tag(solver_tol, 1000);
+  vcl_result = viennacl::linalg::solve(vcl_matrix, vcl_rhs, block_tag);
+  residual = max_relative_residual(ublas_matrix, rhs, vcl_result);
+  if ( residual > 10 * solver_tol || block_tag.iters() > multi_tag.iters() )
+  {
+    std::cout << "# Error at operation: block CG" << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << block_tag.iters() << " (expected at most " << multi_tag.iters() << ")" << std::endl;
+    retval = EXIT_FAILURE;
+  }
 
-    if ( std::fabs(diff(ublas_matrix, vcl_matrix)) > epsilon )
-    {
-        std::cout << "# Error at operation: resize (to larger) with sparse matrix" << std::endl;
-        std::cout << "  diff: " << std::fabs(diff(ublas_matrix, vcl_matrix)) << std::endl;
-        return EXIT_FAILURE;
-    }
+  std::cout << "Testing CG with multiple rank-deficient right hand sides" << std::endl;
+  viennacl::linalg::cg_tag multi_deficient_tag(solver_tol, 1000);
+  viennacl::matrix<NumericT> vcl_result_deficient = viennacl::linalg::solve(vcl_matrix, vcl_rhs_deficient, multi_deficient_tag);
+  residual = max_relative_residual(ublas_matrix, rhs_deficient, vcl_result_deficient);
+  if ( residual > 10 * solver_tol || multi_deficient_tag.iters() >= multi_deficient_tag.max_iterations() )
+  {
+    std::cout << "# Error at operation: CG with multiple rank-deficient right hand sides" << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << multi_deficient_tag.iters() << std::endl;
+    retval = EXIT_FAILURE;
+  }
 
-   ublas_matrix(5,5) = NumericT(5.5); ublas_matrix(5, 6) = NumericT(5.6); ublas_matrix(5, 7) = NumericT(5.7); ublas_matrix(5, 8) = NumericT(5.8); ublas_matrix(5, 9) = NumericT(5.9);
-   ublas_matrix(6,5) = NumericT(6.5); ublas_matrix(6, 6) = NumericT(6.6); ublas_matrix(6, 7) = NumericT(6.7); ublas_matrix(6, 8) = NumericT(6.8); ublas_matrix(6, 9) = NumericT(6.9);
-   ublas_matrix(7,5) = NumericT(7.5); ublas_matrix(7, 6) = NumericT(7.6); ublas_matrix(7, 7) = NumericT(7.7); ublas_matrix(7, 8) = NumericT(7.8); ublas_matrix(7, 9) = NumericT(7.9);
-   ublas_matrix(8,5) = NumericT(8.5); ublas_matrix(8, 6) = NumericT(8.6); ublas_matrix(8, 7) = NumericT(8.7); ublas_matrix(8, 8) = NumericT(8.8); ublas_matrix(8, 9) = NumericT(8.9);
-   ublas_matrix(9,5) = NumericT(9.5); ublas_matrix(9, 6) = NumericT(9.6); ublas_matrix(9, 7) = NumericT(9.7); ublas_matrix(9, 8) = NumericT(9.8); ublas_matrix(9, 9) = NumericT(9.9);
-   viennacl::copy(ublas_matrix, vcl_matrix);
+  std::cout << "Testing block CG with rank-deficient right hand sides" << std::endl;
+  viennacl::linalg::block_cg_tag block_deficient_tag(solver_tol, 1000);
+  vcl_result_deficient = viennacl::linalg::solve(vcl_matrix, vcl_rhs_deficient, block_deficient_tag);
+  residual = max_relative_residual(ublas_matrix, rhs_deficient, vcl_result_deficient);
+  if ( residual > 10 * solver_tol || block_deficient_tag.error() > solver_tol || block_deficient_tag.iters() >= block_deficient_tag.max_iterations() )
+  {
+    std::cout << "# Error at operation: block CG with rank-deficient right hand sides" << std::endl;
+    std::cout << "  residual: " << residual << ", estimate: " << block_deficient_tag.error() << ", iterations: " << block_deficient_tag.iters() << std::endl;
+    retval = EXIT_FAILURE;
+  }
 
-   std::cout << "Testing resize to smaller..." << std::endl;
-   ublas_matrix.resize(7, 7, false); //ublas does not allow preserve = true here
-   ublas_matrix(0,0) = NumericT(10.0); ublas_matrix(0, 1) = NumericT(0.1); ublas_matrix(0, 2) = NumericT(0.2); ublas_matrix(0, 3) = NumericT(0.3); ublas_matrix(0, 4) = NumericT(0.4);
-   ublas_matrix(1,0) = NumericT( 1.0); ublas_matrix(1, 1) = NumericT(1.1); ublas_matrix(1, 2) = NumericT(1.2); ublas_matrix(1, 3) = NumericT(1.3); ublas_matrix(1, 4) = NumericT(1.4);
-   ublas_matrix(2,0) = NumericT( 2.0); ublas_matrix(2, 1) = NumericT(2.1); ublas_matrix(2, 2) = NumericT(2.2); ublas_matrix(2, 3) = NumericT(2.3); ublas_matrix(2, 4) = NumericT(2.4);
-   ublas_matrix(3,0) = NumericT( 3.0); ublas_matrix(3, 1) = NumericT(3.1); ublas_matrix(3, 2) = NumericT(3.2); ublas_matrix(3, 3) = NumericT(3.3); ublas_matrix(3, 4) = NumericT(3.4);
-   ublas_matrix(4,0) = NumericT( 4.0); ublas_matrix(4, 1) = NumericT(4.1); ublas_matrix(4, 2) = NumericT(4.2); ublas_matrix(4, 3) = NumericT(4.3); ublas_matrix(4, 4) = NumericT(4.4);
-   ublas_matrix(5,5) = NumericT( 5.5); ublas_matrix(5, 6) = NumericT(5.6); ublas_matrix(5, 7) = NumericT(5.7); ublas_matrix(5, 8) = NumericT(5.8); ublas_matrix(5, 9) = NumericT(5.9);
-   ublas_matrix(6,5) = NumericT( 6.5); ublas_matrix(6, 6) = NumericT(6.6); ublas_matrix(6, 7) = NumericT(6.7); ublas_matrix(6, 8) = NumericT(6.8); ublas_matrix(6, 9) = NumericT(6.9);
+  // a good initial guess saves iterations:
+  std::cout << "Testing block CG with initial guess" << std::endl;
+  viennacl::matrix<NumericT> vcl_guess = viennacl::linalg::solve(vcl_matrix, vcl_rhs, viennacl::linalg::block_cg_tag(NumericT(0.1), 1000));
+  viennacl::linalg::block_cg_tag guess_tag(solver_tol, 1000);
+  vcl_result = viennacl::linalg::solve(vcl_matrix, vcl_rhs, guess_tag, viennacl::linalg::no_precond(), vcl_guess);
+  residual = max_relative_residual(ublas_matrix, rhs, vcl_result);
+  if ( residual > 10 * solver_tol || guess_tag.iters() >= block_tag.iters() )
+  {
+    std::cout << "# Error at operation: block CG with initial guess" << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << guess_tag.iters() << " (expected less than " << block_tag.iters() << ")" << std::endl;
+    retval = EXIT_FAILURE;
+  }
 
-   vcl_matrix.resize(7, 7);
+  // zero right hand sides: no iterations, zero solution
+  std::cout << "Testing CG and block CG with zero right hand sides" << std::endl;
+  viennacl::linalg::cg_tag multi_zero_tag(solver_tol, 1000);
+  viennacl::matrix<NumericT> vcl_result_zero = viennacl::linalg::solve(vcl_matrix, vcl_rhs_zero, multi_zero_tag);
+  if ( max_relative_residual(ublas_matrix, rhs_zero, vcl_result_zero) > 0 || multi_zero_tag.iters() != 0 )
+  {
+    std::cout << "# Error at operation: CG with zero right hand sides" << std::endl;
+    std::cout << "  iterations: " << multi_zero_tag.iters() << std::endl;
+    retval = EXIT_FAILURE;
+  }
 
-   //std::cout << ublas_matrix << std::endl;
-    if ( std::fabs(diff(ublas_matrix, vcl_matrix)) > epsilon )
-    {
-        std::cout << "# Error at operation: resize (to smaller) with sparse matrix" << std::endl;
-        std::cout << "  diff: " << std::fabs(diff(ublas_matrix, vcl_matrix)) << std::endl;
-        retval = EXIT_FAILURE;
-    }
+  viennacl::linalg::block_cg_tag block_zero_tag(solver_tol, 1000);
+  vcl_result_zero = viennacl::linalg::solve(vcl_matrix, vcl_rhs_zero, block_zero_tag);
+  if ( max_relative_residual(ublas_matrix, rhs_zero, vcl_result_zero) > 0 || block_zero_tag.iters() != 0 || block_zero_tag.error() > 0 )
+  {
+    std::cout << "# Error at operation: block CG with zero right hand sides" << std::endl;
+    std::cout << "  iterations: " << block_zero_tag.iters() << ", estimate: " << block_zero_tag.error() << std::endl;
+    retval = EXIT_FAILURE;
+  }
 
-   ublas::vector<NumericT> ublas_vec = ublas::scalar_vector<NumericT>(ublas_matrix.size1(), NumericT(3.1415));
-   viennacl::vector<NumericT> vcl_vec(ublas_matrix.size1());
+  return retval;
+}
 
+template<typename NumericT, typename TagT>
+int check_multi_rhs_solver(ublas::compressed_matrix<NumericT> const & ublas_matrix, viennacl::compressed_matrix<NumericT> const & vcl_matrix,
+                           ublas::matrix<NumericT> const & rhs, TagT const & tag, std::string const & name)
+{
+  int retval = EXIT_SUCCESS;
+  viennacl::context host_ctx(viennacl::MAIN_MEMORY);
 
-  std::cout << "Testing transposed unit lower triangular solve: compressed_matrix" << std::endl;
-  viennacl::copy(ublas_vec, vcl_vec);
-  std::cout << "matrix: " << ublas_matrix << std::endl;
-  std::cout << "vector: " << ublas_vec << std::endl;
-  std::cout << "ViennaCL matrix size: " << vcl_matrix.size1() << " x " << vcl_matrix.size2() << std::endl;
+  std::cout << "Testing " << name << std::endl;
+  viennacl::matrix<NumericT> vcl_rhs(rhs.size1(), rhs.size2(), host_ctx);
+  viennacl::copy(rhs, vcl_rhs);
 
-  std::cout << "ublas..." << std::endl;
-  boost::numeric::ublas::inplace_solve((ublas_matrix), ublas_vec, boost::numeric::ublas::unit_lower_tag());
-  std::cout << "ViennaCL..." << std::endl;
-  viennacl::linalg::inplace_solve((vcl_matrix), vcl_vec, viennacl::linalg::unit_lower_tag());
+  TagT multi_tag = tag;
+  viennacl::matrix<NumericT> vcl_result = viennacl::linalg::solve(vcl_matrix, vcl_rhs, multi_tag, viennacl::linalg::no_precond());
+  NumericT residual = max_relative_residual(ublas_matrix, rhs, vcl_result);
+  if ( residual > 10 * tag.tolerance() || multi_tag.iters() >= multi_tag.max_iterations() )
+  {
+    std::cout << "# Error at operation: " << name << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << multi_tag.iters() << std::endl;
+    retval = EXIT_FAILURE;
+  }
 
-  /*
-  std::list< viennacl::backend::mem_handle > multifrontal_L_row_index_arrays_;
-  std::list< viennacl::backend::mem_handle > multifrontal_L_row_buffers_;
-  std::list< viennacl::backend::mem_handle > multifrontal_L_col_buffers_;
-  std::list< viennacl::backend::mem_handle > multifrontal_L_element_buffers_;
-  std::list< std::size_t > multifrontal_L_row_elimination_num_list_;
+  // each column must agree with the separate solve of that column:
+  ublas::matrix<NumericT> result(rhs.size1(), rhs.size2());
+  viennacl::copy(vcl_result, result);
+  NumericT max_diff = 0;
+  for (std::size_t j=0; j<rhs.size2(); ++j)
+  {
+    ublas::vector<NumericT> rhs_column = ublas::column(rhs, j);
+    viennacl::vector<NumericT> vcl_rhs_column(rhs.size1(), host_ctx);
+    viennacl::copy(rhs_column, vcl_rhs_column);
+
+    TagT single_tag = tag;
+    viennacl::vector<NumericT> vcl_single_result = viennacl::linalg::solve(vcl_matrix, vcl_rhs_column, single_tag, viennacl::linalg::no_precond());
+    ublas::vector<NumericT> single_result(rhs.size1());
+    viennacl::copy(vcl_single_result, single_result);
+
+    ublas::vector<NumericT> diff = ublas::column(result, j) - single_result;
+    if (ublas::norm_2(single_result) > 0)
+      max_diff = std::max(max_diff, NumericT(ublas::norm_2(diff) / ublas::norm_2(single_result)));
+    else
+      max_diff = std::max(max_diff, NumericT(ublas::norm_2(diff)));
+  }
+  if ( max_diff > 10 * tag.tolerance() )
+  {
+    std::cout << "# Error at operation: " << name << " differs from the solves of the individual columns" << std::endl;
+    std::cout << "  diff: " << max_diff << std::endl;
+    retval = EXIT_FAILURE;
+  }
 
-  viennacl::vector<NumericT> multifrontal_U_diagonal_;
+  return retval;
+}
 
-  viennacl::linalg::detail::multifrontal_setup_L(vcl_matrix,
-                                                  multifrontal_U_diagonal_, //dummy
-                                                  multifrontal_L_row_index_arrays_,
-                                                  multifrontal_L_row_buffers_,
-                                                  multifrontal_L_col_buffers_,
-                                                  multifrontal_L_element_buffers_,
-                                                  multifrontal_L_row_elimination_num_list_);
+template< typename NumericT, typename Epsilon >
+int multi_rhs_nonsymmetric_test(Epsilon const& epsilon)
+{
+  int retval = EXIT_SUCCESS;
 
-  viennacl::linalg::detail::multifrontal_substitute(vcl_vec,
-                                                    multifrontal_L_row_index_arrays_,
-                                                    multifrontal_L_row_buffers_,
-                                                    multifrontal_L_col_buffers_,
-                                                    multifrontal_L_element_buffers_,
-                                                    multifrontal_L_row_elimination_num_list_);
+  ublas::compressed_matrix<NumericT> ublas_matrix;
+  generate_convection_diffusion_2d(ublas_matrix, 30);
 
+  viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+  viennacl::compressed_matrix<NumericT> vcl_matrix(ublas_matrix.size1(), ublas_matrix.size2(), host_ctx);
+  viennacl::copy(ublas_matrix, vcl_matrix);
 
-  std::cout << "ublas..." << std::endl;
-  boost::numeric::ublas::inplace_solve((ublas_matrix), ublas_vec, boost::numeric::ublas::upper_tag());
-  std::cout << "ViennaCL..." << std::endl;
-  std::list< viennacl::backend::mem_handle > multifrontal_U_row_index_arrays_;
-  std::list< viennacl::backend::mem_handle > multifrontal_U_row_buffers_;
-  std::list< viennacl::backend::mem_handle > multifrontal_U_col_buffers_;
-  std::list< viennacl::backend::mem_handle > multifrontal_U_element_buffers_;
-  std::list< std::size_t > multifrontal_U_row_elimination_num_list_;
+  std::size_t N = ublas_matrix.size1();
+  NumericT solver_tol = std::sqrt(epsilon);
 
-  multifrontal_U_diagonal_.resize(vcl_matrix.size1(), false);
-  viennacl::linalg::single_threaded::detail::row_info(vcl_matrix, multifrontal_U_diagonal_, viennacl::linalg::detail::SPARSE_ROW_DIAGONAL);
-  viennacl::linalg::detail::multifrontal_setup_U(vcl_matrix,
-                                                 multifrontal_U_diagonal_,
-                                                 multifrontal_U_row_index_arrays_,
-                                                 multifrontal_U_row_buffers_,
-                                                 multifrontal_U_col_buffers_,
-                                                 multifrontal_U_element_buffers_,
-                                                 multifrontal_U_row_elimination_num_list_);
+  ublas::matrix<NumericT> rhs(N, 3);
+  for (std::size_t i=0; i<N; ++i)
+    for (std::size_t j=0; j<rhs.size2(); ++j)
+      rhs(i, j) = random<NumericT>();
 
-  vcl_vec = viennacl::linalg::element_div(vcl_vec, multifrontal_U_diagonal_);
-  viennacl::linalg::detail::multifrontal_substitute(vcl_vec,
-                                                    multifrontal_U_row_index_arrays_,
-                                                    multifrontal_U_row_buffers_,
-                                                    multifrontal_U_col_buffers_,
-                                                    multifrontal_U_element_buffers_,
-                                                    multifrontal_U_row_elimination_num_list_);
-  */
-  for (std::size_t i=0; i<ublas_vec.size(); ++i)
+  // rank-deficient right hand sides with a zero column:
+  ublas::matrix<NumericT> rhs_deficient(N, 4);
+  for (std::size_t i=0; i<N; ++i)
   {
-    std::cout << ublas_vec[i] << " vs. " << vcl_vec[i] << std::endl;
+    rhs_deficient(i, 0) = rhs(i, 0);
+    rhs_deficient(i, 1) = 0;
+    rhs_deficient(i, 2) = rhs(i, 0);
+    rhs_deficient(i, 3) = rhs(i, 0) - NumericT(3) * rhs(i, 1);
   }
 
-  /*std::cout << "Testing transposed unit upper triangular solve: compressed_matrix" << std::endl;
-  viennacl::copy(ublas_vec, vcl_vec);
-  std::cout << "matrix: " << ublas_matrix << std::endl;
-  std::cout << "vector: " << ublas_vec << std::endl;
-  std::cout << "ViennaCL matrix size: " << vcl_matrix.size1() << " x " << vcl_matrix.size2() << std::endl;
+  viennacl::linalg::bicgstab_tag bicgstab_tag(solver_tol, 1000);
+  if (check_multi_rhs_solver(ublas_matrix, vcl_matrix, rhs, bicgstab_tag, "BiCGStab with multiple right hand sides") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+  if (check_multi_rhs_solver(ublas_matrix, vcl_matrix, rhs_deficient, bicgstab_tag, "BiCGStab with multiple rank-deficient right hand sides") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
 
-  std::cout << "ublas..." << std::endl;
-  boost::numeric::ublas::inplace_solve((ublas_matrix), ublas_vec, boost::numeric::ublas::lower_tag());
-  std::cout << "ViennaCL..." << std::endl;
-  viennacl::linalg::inplace_solve((vcl_matrix), vcl_vec, viennacl::linalg::lower_tag());
+  viennacl::linalg::gmres_tag gmres_tag(solver_tol, 1000, 20);
+  if (check_multi_rhs_solver(ublas_matrix, vcl_matrix, rhs, gmres_tag, "GMRES with multiple right hand sides") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
+  if (check_multi_rhs_solver(ublas_matrix, vcl_matrix, rhs_deficient, gmres_tag, "GMRES with multiple rank-deficient right hand sides") != EXIT_SUCCESS)
+    retval = EXIT_FAILURE;
 
-  for (std::size_t i=0; i<ublas_vec.size(); ++i)
+  return retval;
+}
+
+int mixed_precision_cg_test(double epsilon)
+{
+  typedef double NumericT;
+
+  int retval = EXIT_SUCCESS;
+
+  ublas::compressed_matrix<NumericT> ublas_matrix;
+  generate_laplace_2d(ublas_matrix, 40);
+  ublas::vector<NumericT> rhs = ublas::scalar_vector<NumericT>(ublas_matrix.size1(), NumericT(1));
+
+  viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+  viennacl::compressed_matrix<NumericT> vcl_matrix(ublas_matrix.size1(), ublas_matrix.size2(), host_ctx);
+  viennacl::vector<NumericT> vcl_rhs(rhs.size(), host_ctx);
+  viennacl::copy(ublas_matrix, vcl_matrix);
+  viennacl::copy(rhs, vcl_rhs);
+
+  // the tolerance is well below single precision, so the outer corrections in double precision are required:
+  NumericT solver_tol = std::sqrt(epsilon) / 100;
+  std::cout << "Testing mixed-precision CG" << std::endl;
+  viennacl::linalg::mixed_precision_cg_tag tag(solver_tol, 1000);
+  viennacl::vector<NumericT> vcl_result = viennacl::linalg::solve(vcl_matrix, vcl_rhs, tag);
+
+  NumericT residual = relative_residual(ublas_matrix, rhs, vcl_result);
+  if ( residual > 10 * solver_tol || tag.iters() >= tag.max_iterations() )
   {
-    std::cout << ublas_vec[i] << " vs. " << vcl_vec[i] << std::endl;
-  }*/
+    std::cout << "# Error at operation: mixed-precision CG" << std::endl;
+    std::cout << "  residual: " << residual << ", iterations: " << tag.iters() << std::endl;
+    retval = EXIT_FAILURE;
+  }
 
   return retval;
 }
 
-
-//
-// -------------------------------------------------------------
-//
 template< typename NumericT, typename Epsilon >
 int test(Epsilon const& epsilon)
 {
   std::cout << "Testing resizing of compressed_matrix..." << std::endl;
   int retval = resize_test<NumericT, viennacl::compressed_matrix<NumericT> >(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  std::cout << "Testing products: compressed_matrix - compressed_matrix" << std::endl;
+  retval = sparse_product_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  std::cout << "Testing AMG preconditioners" << std::endl;
+  retval = amg_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  retval = amg_resetup_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  std::cout << "Testing ILU preconditioners" << std::endl;
+  retval = ilu_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  retval = ilu_fixed_point_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  retval = block_ilu_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  std::cout << "Testing warm starts and residual histories" << std::endl;
+  retval = warm_start_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  retval = pipelined_gmres_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  std::cout << "Testing IDR(s) and BiCGStab(l)" << std::endl;
+  retval = idrs_bicgstabl_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  retval = multi_vector_kernel_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  std::cout << "Testing multicolor SSOR preconditioners" << std::endl;
+  retval = ssor_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  std::cout << "Testing sparse Cholesky factorization" << std::endl;
+  retval = sparse_cholesky_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  std::cout << "Testing Chebyshev iteration and polynomial preconditioners" << std::endl;
+  retval = chebyshev_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  retval = deflated_cg_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  std::cout << "Testing solvers for multiple right hand sides" << std::endl;
+  retval = block_cg_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  retval = multi_rhs_nonsymmetric_test<NumericT>(epsilon);
   if (retval != EXIT_SUCCESS)
     return retval;
   std::cout << "Testing resizing of coordinate_matrix..." << std::endl;
@@ -472,6 +2228,16 @@ int test(Epsilon const& epsilon)
     retval = EXIT_FAILURE;
   }
 
+  std::cout << "Testing products: compressed_matrix, imbalanced rows" << std::endl;
+  retval = imbalanced_matrix_vector_product_test<NumericT, viennacl::compressed_matrix<NumericT> >(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+
+  std::cout << "Testing products: compressed_matrix, rows split across blocks" << std::endl;
+  retval = merge_path_matrix_vector_product_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+
   std::cout << "Testing products: compressed_matrix, strided vectors" << std::endl;
   retval = strided_matrix_vector_product_test<NumericT, viennacl::compressed_matrix<NumericT> >(epsilon, result, rhs, vcl_result, vcl_rhs);
   if (retval != EXIT_SUCCESS)
@@ -714,6 +2480,11 @@ int test(Epsilon const& epsilon)
     retval = EXIT_FAILURE;
   }
 
+  std::cout << "Testing products: coordinate_matrix, imbalanced rows" << std::endl;
+  retval = imbalanced_matrix_vector_product_test<NumericT, viennacl::coordinate_matrix<NumericT> >(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+
   std::cout << "Testing products: coordinate_matrix, strided vectors" << std::endl;
   //std::cout << " --> SKIPPING <--" << std::endl;
   retval = strided_matrix_vector_product_test<NumericT, viennacl::coordinate_matrix<NumericT> >(epsilon, result, rhs, vcl_result, vcl_rhs);
@@ -771,6 +2542,59 @@ int test(Epsilon const& epsilon)
   if (retval != EXIT_SUCCESS)
     return retval;
 
+  std::cout << "Testing products: sliced_ell_matrix, rows sorted within sigma-windows" << std::endl;
+  viennacl::sliced_ell_matrix<NumericT> vcl_sliced_ell_matrix_sorted(rhs.size(), rhs.size(), 32, 1024);
+  viennacl::copy(ublas_matrix, vcl_sliced_ell_matrix_sorted);
+  result     = viennacl::linalg::prod(ublas_matrix, rhs);
+  vcl_result.clear();
+  vcl_result = viennacl::linalg::prod(vcl_sliced_ell_matrix_sorted, vcl_rhs);
+
+  if ( std::fabs(diff(result, vcl_result)) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-vector product with sliced_ell_matrix (sigma = 1024)" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  std::cout << "Testing products: sliced_ell_matrix, padding next to infinite entries of x" << std::endl;
+  {
+    // rows with a single entry are padded, the last row has its only entry in the column where x is infinite:
+    std::size_t padded_size = 64;
+    ublas::compressed_matrix<NumericT> ublas_padded_matrix(padded_size, padded_size);
+    for (std::size_t i=0; i<padded_size; ++i)
+    {
+      ublas_padded_matrix(i, i) = NumericT(2);
+      if (i % 4 == 0 && i + 1 < padded_size)
+        ublas_padded_matrix(i, i + 1) = NumericT(1);
+    }
+    viennacl::sliced_ell_matrix<NumericT> vcl_padded_matrix(padded_size, padded_size, 32);
+    viennacl::copy(ublas_padded_matrix, vcl_padded_matrix);
+
+    std::vector<NumericT> std_x(padded_size, NumericT(1));
+    std_x[padded_size - 1] = std::numeric_limits<NumericT>::infinity();
+    viennacl::vector<NumericT> vcl_x(padded_size);
+    viennacl::copy(std_x, vcl_x);
+
+    viennacl::vector<NumericT> vcl_y = viennacl::linalg::prod(vcl_padded_matrix, vcl_x);
+    std::vector<NumericT> std_y(padded_size);
+    viennacl::copy(vcl_y, std_y);
+
+    for (std::size_t i=0; i<padded_size; ++i)
+    {
+      // 2 * x_i, plus x_{i+1} in every fourth row. All products are exact, the last row is infinite.
+      NumericT expected = NumericT(2) * std_x[i];
+      if (i % 4 == 0 && i + 1 < padded_size)
+        expected += std_x[i + 1];
+      if (std_y[i] != expected)
+      {
+        std::cout << "# Error at operation: matrix-vector product with sliced_ell_matrix and infinite entries in x" << std::endl;
+        std::cout << "  row " << i << ": " << std_y[i] << " (expected " << expected << ")" << std::endl;
+        retval = EXIT_FAILURE;
+        break;
+      }
+    }
+  }
+
 
   //std::cout << "Copying hyb_matrix" << std::endl;
   viennacl::copy(ublas_matrix, vcl_hyb_matrix);
@@ -980,6 +2804,8 @@ int main()
       std::cout << "  eps:     " << epsilon << std::endl;
       std::cout << "  numeric: double" << std::endl;
       retval = test<NumericT>(epsilon);
+      if ( retval == EXIT_SUCCESS )
+        retval = mixed_precision_cg_test(epsilon);
       if ( retval == EXIT_SUCCESS )
         std::cout << "# Test passed" << std::endl;
       else
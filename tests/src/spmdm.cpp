@@ -221,6 +221,52 @@ int test(NumericT epsilon)
   viennacl::copy( result, temp);
   check_matrices(ublas_result, temp, epsilon);
 
+  /******************************************************************/
+  std::cout << "Testing compressed(COO) lhs with dense rows * dense rhs" << std::endl;
+  {
+    // a few dense rows among short and empty rows, so that rows are shared by the chunks of nonzeros:
+    ublas::compressed_matrix<NumericT> ublas_skewed(2000, 300);
+    for (std::size_t i=0; i<ublas_skewed.size1(); ++i)
+    {
+      if (i == 0 || i == 777 || i == ublas_skewed.size1() - 1)
+      {
+        for (std::size_t j=0; j<ublas_skewed.size2(); ++j)
+          ublas_skewed(i, j) = NumericT(0.5) + NumericT(0.1) * random<NumericT>();
+      }
+      else if (i % 3 != 0)
+        ublas_skewed(i, (i * 7) % ublas_skewed.size2()) = NumericT(0.5) + NumericT(0.1) * random<NumericT>();
+    }
+    viennacl::coordinate_matrix<NumericT> coo_skewed;
+    viennacl::copy(ublas_skewed, coo_skewed);
+
+    ublas::matrix<NumericT> ublas_rhs3(ublas_skewed.size2(), 7);
+    for (std::size_t i = 0; i < ublas_rhs3.size1(); i++)
+      for (std::size_t j = 0; j < ublas_rhs3.size2(); j++)
+        ublas_rhs3(i,j) = NumericT(0.5) + NumericT(0.1) * random<NumericT>();
+    ublas::matrix<NumericT> ublas_rhs3_trans = ublas::trans(ublas_rhs3);
+
+    viennacl::matrix<NumericT, FactorLayoutT> rhs3(ublas_rhs3.size1(), ublas_rhs3.size2());
+    viennacl::matrix<NumericT, FactorLayoutT> rhs3_trans(ublas_rhs3.size2(), ublas_rhs3.size1());
+    viennacl::copy(ublas_rhs3, rhs3);
+    viennacl::copy(ublas_rhs3_trans, rhs3_trans);
+
+    ublas::matrix<NumericT> ublas_result3 = ublas::prod(ublas_skewed, ublas_rhs3);
+    ublas::matrix<NumericT> temp3(ublas_result3.size1(), ublas_result3.size2());
+    viennacl::matrix<NumericT, ResultLayoutT> result3(ublas_result3.size1(), ublas_result3.size2());
+
+    result3 = viennacl::linalg::prod(coo_skewed, rhs3);
+    viennacl::copy(result3, temp3);
+    if (check_matrices(ublas_result3, temp3, epsilon) != EXIT_SUCCESS)
+      retVal = EXIT_FAILURE;
+
+    std::cout << "Testing compressed(COO) lhs with dense rows * transposed dense rhs" << std::endl;
+    result3.clear();
+    result3 = viennacl::linalg::prod(coo_skewed, viennacl::trans(rhs3_trans));
+    viennacl::copy(result3, temp3);
+    if (check_matrices(ublas_result3, temp3, epsilon) != EXIT_SUCCESS)
+      retVal = EXIT_FAILURE;
+  }
+
   /******************************************************************/
   if (retVal == EXIT_SUCCESS) {
     std::cout << "Tests passed successfully" << std::endl;
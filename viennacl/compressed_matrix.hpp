@@ -25,6 +25,7 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <algorithm>
 #include "viennacl/forwards.h"
 #include "viennacl/vector.hpp"
 
@@ -37,11 +38,38 @@
 #include <boost/numeric/ublas/matrix_sparse.hpp>
 #endif
 
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace viennacl
 {
 namespace detail
 {
 
+  /** @brief Finds the point where the given diagonal intersects the merge path of the CSR row end offsets and the sequence of nonzero indices (cf. Merrill and Garland, 2016).
+    *
+    * On return, the first row_index rows and the first nnz_index nonzeros lie before the intersection.
+    */
+  inline void csr_merge_path_search(vcl_size_t diagonal, unsigned int const * row_end_offsets, vcl_size_t num_rows, vcl_size_t nnz,
+                                    vcl_size_t & row_index, vcl_size_t & nnz_index)
+  {
+    vcl_size_t x_min = (diagonal > nnz) ? diagonal - nnz : 0;
+    vcl_size_t x_max = std::min(diagonal, num_rows);
+
+    while (x_min < x_max)
+    {
+      vcl_size_t pivot = (x_min + x_max) / 2;
+      if (row_end_offsets[pivot] <= diagonal - pivot - 1)
+        x_min = pivot + 1;
+      else
+        x_max = pivot;
+    }
+
+    row_index = x_min;
+    nnz_index = diagonal - x_min;
+  }
+
   template<typename CPUMatrixT, typename NumericT, unsigned int AlignmentV>
   void copy_impl(const CPUMatrixT & cpu_matrix,
                  compressed_matrix<NumericT, AlignmentV> & gpu_matrix,
@@ -438,7 +466,7 @@ public:
   typedef vcl_size_t                                                                                 size_type;
 
   /** @brief Default construction of a compressed matrix. No memory is allocated */
-  compressed_matrix() : rows_(0), cols_(0), nonzeros_(0) {}
+  compressed_matrix() : rows_(0), cols_(0), nonzeros_(0), row_block_num_(0) {}
 
   /** @brief Construction of a compressed matrix with the supplied number of rows and columns. If the number of nonzeros is positive, memory is allocated
       *
@@ -448,11 +476,12 @@ public:
       * @param ctx      Optional context in which the matrix is created (one out of multiple OpenCL contexts, CUDA, host)
       */
   explicit compressed_matrix(vcl_size_t rows, vcl_size_t cols, vcl_size_t nonzeros = 0, viennacl::context ctx = viennacl::context())
-    : rows_(rows), cols_(cols), nonzeros_(nonzeros)
+    : rows_(rows), cols_(cols), nonzeros_(nonzeros), row_block_num_(0)
   {
     row_buffer_.switch_active_handle_id(ctx.memory_type());
     col_buffer_.switch_active_handle_id(ctx.memory_type());
     elements_.switch_active_handle_id(ctx.memory_type());
+    row_blocks_.switch_active_handle_id(ctx.memory_type());
 
 #ifdef VIENNACL_WITH_OPENCL
     if (ctx.memory_type() == OPENCL_MEMORY)
@@ -460,6 +489,7 @@ public:
       row_buffer_.opencl_handle().context(ctx.opencl_context());
       col_buffer_.opencl_handle().context(ctx.opencl_context());
       elements_.opencl_handle().context(ctx.opencl_context());
+      row_blocks_.opencl_handle().context(ctx.opencl_context());
     }
 #endif
     if (rows > 0)
@@ -480,11 +510,12 @@ public:
       * @param ctx      Context in which to create the matrix
       */
   explicit compressed_matrix(vcl_size_t rows, vcl_size_t cols, viennacl::context ctx)
-    : rows_(rows), cols_(cols), nonzeros_(0)
+    : rows_(rows), cols_(cols), nonzeros_(0), row_block_num_(0)
   {
     row_buffer_.switch_active_handle_id(ctx.memory_type());
     col_buffer_.switch_active_handle_id(ctx.memory_type());
     elements_.switch_active_handle_id(ctx.memory_type());
+    row_blocks_.switch_active_handle_id(ctx.memory_type());
 
 #ifdef VIENNACL_WITH_OPENCL
     if (ctx.memory_type() == OPENCL_MEMORY)
@@ -492,6 +523,7 @@ public:
       row_buffer_.opencl_handle().context(ctx.opencl_context());
       col_buffer_.opencl_handle().context(ctx.opencl_context());
       elements_.opencl_handle().context(ctx.opencl_context());
+      row_blocks_.opencl_handle().context(ctx.opencl_context());
     }
 #endif
     if (rows > 0)
@@ -500,11 +532,12 @@ public:
     }
   }
 
-  explicit compressed_matrix(viennacl::context ctx) : rows_(0), cols_(0), nonzeros_(0)
+  explicit compressed_matrix(viennacl::context ctx) : rows_(0), cols_(0), nonzeros_(0), row_block_num_(0)
   {
     row_buffer_.switch_active_handle_id(ctx.memory_type());
     col_buffer_.switch_active_handle_id(ctx.memory_type());
     elements_.switch_active_handle_id(ctx.memory_type());
+    row_blocks_.switch_active_handle_id(ctx.memory_type());
 
 #ifdef VIENNACL_WITH_OPENCL
     if (ctx.memory_type() == OPENCL_MEMORY)
@@ -512,6 +545,7 @@ public:
       row_buffer_.opencl_handle().context(ctx.opencl_context());
       col_buffer_.opencl_handle().context(ctx.opencl_context());
       elements_.opencl_handle().context(ctx.opencl_context());
+      row_blocks_.opencl_handle().context(ctx.opencl_context());
     }
 #endif
   }
@@ -520,7 +554,7 @@ public:
 #ifdef VIENNACL_WITH_OPENCL
   explicit compressed_matrix(cl_mem mem_row_buffer, cl_mem mem_col_buffer, cl_mem mem_elements,
                              vcl_size_t rows, vcl_size_t cols, vcl_size_t nonzeros) :
-    rows_(rows), cols_(cols), nonzeros_(nonzeros)
+    rows_(rows), cols_(cols), nonzeros_(nonzeros), row_block_num_(0)
   {
     row_buffer_.switch_active_handle_id(viennacl::OPENCL_MEMORY);
     row_buffer_.opencl_handle() = mem_row_buffer;
@@ -540,6 +574,14 @@ public:
 #endif
 
 
+  /** @brief Creates the compressed matrix from the product of two compressed matrices, i.e. C = prod(A, B). The result resides in the memory context of A. */
+  compressed_matrix(matrix_expression<const compressed_matrix, const compressed_matrix, op_prod> const & proxy)
+    : rows_(0), cols_(0), nonzeros_(0), row_block_num_(0)
+  {
+    switch_memory_context(viennacl::traits::context(proxy.lhs()));
+    viennacl::linalg::prod_impl(proxy.lhs(), proxy.rhs(), *this);
+  }
+
   /** @brief Assignment a compressed matrix from possibly another memory domain. */
   compressed_matrix & operator=(compressed_matrix const & other)
   {
@@ -554,6 +596,30 @@ public:
     viennacl::backend::typesafe_memory_copy<unsigned int>(other.col_buffer_, col_buffer_);
     viennacl::backend::typesafe_memory_copy<NumericT>(other.elements_, elements_);
 
+    row_block_num_ = other.row_block_num_;
+    if (row_block_num_ > 0)
+      viennacl::backend::typesafe_memory_copy<unsigned int>(other.row_blocks_, row_blocks_);
+
+    return *this;
+  }
+
+  /** @brief Assigns the product of two compressed matrices, i.e. C = prod(A, B). */
+  compressed_matrix & operator=(matrix_expression<const compressed_matrix, const compressed_matrix, op_prod> const & proxy)
+  {
+    assert( (rows_ == 0 || rows_ == proxy.lhs().size1()) && bool("Size mismatch") );
+    assert( (cols_ == 0 || cols_ == proxy.rhs().size2()) && bool("Size mismatch") );
+
+    if (rows_ == 0 && nonzeros_ == 0)
+      switch_memory_context(viennacl::traits::context(proxy.lhs()));
+
+    if (&proxy.lhs() == this || &proxy.rhs() == this || memory_context() != proxy.lhs().memory_context())
+    {
+      compressed_matrix temp(proxy);
+      *this = temp;
+    }
+    else
+      viennacl::linalg::prod_impl(proxy.lhs(), proxy.rhs(), *this);
+
     return *this;
   }
 
@@ -591,6 +657,28 @@ public:
     nonzeros_ = nonzeros;
     rows_ = rows;
     cols_ = cols;
+
+    generate_row_block_information(static_cast<unsigned int const *>(row_jumper));
+  }
+
+  /** @brief Allocates the row, column and value arrays for the given dimensions and number of nonzeros in the memory context 'ctx' without initializing them. Old values are discarded.
+      *
+      * For kernels which write the arrays directly through handle1(), handle2() and handle().
+      * Call generate_row_block_information() once the row array is filled.
+      */
+  void resize_uninitialized(vcl_size_t rows, vcl_size_t cols, vcl_size_t nonzeros, viennacl::context ctx)
+  {
+    assert( (rows > 0) && (cols > 0) && (nonzeros > 0) && bool("Error in compressed_matrix::resize_uninitialized(): Dimensions and number of nonzeros must be larger than zero!"));
+
+    viennacl::backend::typesafe_host_array<unsigned int> size_deducer(row_buffer_);
+    viennacl::backend::memory_create(row_buffer_, size_deducer.element_size() * (rows + 1), ctx);
+    viennacl::backend::memory_create(col_buffer_, size_deducer.element_size() * nonzeros,   ctx);
+    viennacl::backend::memory_create(elements_,   sizeof(NumericT) * nonzeros,             ctx);
+
+    rows_ = rows;
+    cols_ = cols;
+    nonzeros_ = nonzeros;
+    row_block_num_ = 0;
   }
 
   /** @brief Allocate memory for the supplied number of nonzeros in the matrix. Old values are preserved. */
@@ -680,6 +768,7 @@ public:
     viennacl::backend::memory_create(elements_,   sizeof(NumericT) * 1,                         viennacl::traits::context(elements_), &(host_elements[0]));
 
     nonzeros_ = 0;
+    row_block_num_ = 0;
   }
 
   /** @brief Returns a reference to the (i,j)-th entry of the sparse matrix. If (i,j) does not exist (zero), it is inserted (slow!) */
@@ -728,11 +817,41 @@ public:
   /** @brief  Returns the OpenCL handle to the matrix entry array */
   handle_type & handle() { return elements_; }
 
+  /** @brief  Returns the handle to the row block array (pairs of row index and nonzero index at which each block starts). See generate_row_block_information() */
+  const handle_type & handle3() const { return row_blocks_; }
+  /** @brief  Returns the handle to the row block array (pairs of row index and nonzero index at which each block starts). See generate_row_block_information() */
+  handle_type & handle3() { return row_blocks_; }
+
+  /** @brief  Returns the number of row blocks used for load-balanced matrix-vector products. Zero if no row block information is available. */
+  vcl_size_t blocks1() const { return row_block_num_; }
+
+  /** @brief Partitions the nonzeros and rows into blocks of equal work for load-balanced sparse matrix-vector products on the host.
+    *
+    * The partition is computed once by splitting the merge path of the row offsets and the nonzero indices into equal pieces, one per OpenMP thread.
+    * Rows may be split across blocks, so rows with a huge number of nonzeros are shared by several threads.
+    * Updated automatically by set(). Call this explicitly after writing to handle1() directly or after changing the number of OpenMP threads.
+    */
+  void generate_row_block_information()
+  {
+    if (rows_ == 0)
+    {
+      row_block_num_ = 0;
+      return;
+    }
+
+    viennacl::backend::typesafe_host_array<unsigned int> row_buffer(row_buffer_, rows_ + 1);
+    viennacl::backend::memory_read(row_buffer_, 0, row_buffer.raw_size(), row_buffer.get());
+
+    generate_row_block_information(static_cast<unsigned int const *>(row_buffer.get()));
+  }
+
   void switch_memory_context(viennacl::context new_ctx)
   {
     viennacl::backend::switch_memory_context<unsigned int>(row_buffer_, new_ctx);
     viennacl::backend::switch_memory_context<unsigned int>(col_buffer_, new_ctx);
     viennacl::backend::switch_memory_context<NumericT>(elements_, new_ctx);
+    if (row_block_num_ > 0)
+      viennacl::backend::switch_memory_context<unsigned int>(row_blocks_, new_ctx);
   }
 
   viennacl::memory_types memory_context() const
@@ -742,6 +861,31 @@ public:
 
 private:
 
+  /** @brief Computes the row blocks from the row array available on the host. */
+  void generate_row_block_information(unsigned int const * row_jumper)
+  {
+    vcl_size_t num_blocks = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    num_blocks = static_cast<vcl_size_t>(omp_get_max_threads());
+#endif
+    vcl_size_t nnz = row_jumper[rows_];
+    vcl_size_t path_length = rows_ + nnz;
+    vcl_size_t block_length = (path_length + num_blocks - 1) / num_blocks;
+
+    viennacl::backend::typesafe_host_array<unsigned int> row_blocks(row_buffer_, 2 * (num_blocks + 1));
+    for (vcl_size_t i = 0; i <= num_blocks; ++i)
+    {
+      vcl_size_t row_index = 0;
+      vcl_size_t nnz_index = 0;
+      viennacl::detail::csr_merge_path_search(std::min(i * block_length, path_length), row_jumper + 1, rows_, nnz, row_index, nnz_index);
+      row_blocks.set(2 * i,     row_index);
+      row_blocks.set(2 * i + 1, nnz_index);
+    }
+
+    viennacl::backend::memory_create(row_blocks_, row_blocks.raw_size(), viennacl::traits::context(row_buffer_), row_blocks.get());
+    row_block_num_ = num_blocks;
+  }
+
   vcl_size_t element_index(vcl_size_t i, vcl_size_t j)
   {
     //read row indices
@@ -772,6 +916,8 @@ private:
   handle_type row_buffer_;
   handle_type col_buffer_;
   handle_type elements_;
+  vcl_size_t row_block_num_;
+  handle_type row_blocks_;
 };
 
 
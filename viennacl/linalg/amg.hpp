@@ -35,8 +35,13 @@
 #include <cmath>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+#include "viennacl/linalg/ssor.hpp"
+#include "viennacl/tools/shared_ptr.hpp"
 
 #include "viennacl/linalg/detail/amg/amg_base.hpp"
 #include "viennacl/linalg/detail/amg/amg_coarse.hpp"
@@ -44,6 +49,10 @@
 
 #include <map>
 
+#ifdef VIENNACL_WITH_OPENCL
+ #include "viennacl/linalg/opencl/kernels/compressed_matrix.hpp"
+#endif
+
 #ifdef VIENNACL_WITH_OPENMP
  #include <omp.h>
 #endif
@@ -74,7 +83,7 @@ void amg_setup(InternalT1 & A, InternalT1 & P, InternalT2 & pointvector, amg_tag
   typedef typename InternalT2::value_type      PointVectorType;
 
   unsigned int i, iterations, c_points, f_points;
-  detail::amg::amg_slicing<InternalT1,InternalT2> slicing;
+  detail::amg::amg_slicing slicing;
 
   // Set number of iterations. If automatic coarse grid construction is chosen (0), then set a maximum size and stop during the process.
   iterations = tag.get_coarselevels();
@@ -89,7 +98,6 @@ void amg_setup(InternalT1 & A, InternalT1 & P, InternalT2 & pointvector, amg_tag
   {
     // Initialize Pointvector on level i and construct points.
     pointvector[i] = PointVectorType(static_cast<unsigned int>(A[i].size1()));
-    pointvector[i].init_points();
 
     // Construct C and F points on coarse level (i is fine level, i+1 coarse level).
     detail::amg::amg_coarse (i, A, pointvector, slicing, tag);
@@ -117,7 +125,8 @@ void amg_setup(InternalT1 & A, InternalT1 & P, InternalT2 & pointvector, amg_tag
     // Test triple matrix product. Very slow for large matrix sizes (ublas).
     // test_triplematprod(A[i],P[i],A[i+1]);
 
-    pointvector[i].delete_points();
+    // The influenced lists are only needed for coarsening. The influencing lists are kept for amg_resetup().
+    pointvector[i].clear_influenced();
 
     #ifdef VIENNACL_AMG_DEBUG
     std::cout << "Coarse Grid Operator Matrix:" << std::endl;
@@ -134,6 +143,34 @@ void amg_setup(InternalT1 & A, InternalT1 & P, InternalT2 & pointvector, amg_tag
   tag.set_coarselevels(i);
 }
 
+/** @brief Recomputes the operators of an existing AMG hierarchy for new values of the system matrix on the finest level.
+*
+* The coarsening (C/F splitting or aggregates) and the strong influences from amg_setup() are reused, only the numerical values of the interpolation and coarse grid operators are recomputed.
+* The sparsity patterns are kept unless the new values require additional entries.
+*
+* @param A            Operator matrices on all levels. A[0] holds the new values.
+* @param P            Prolongation/Interpolation operators on all levels
+* @param pointvector  Vector of points on all levels
+* @param tag          AMG preconditioner tag
+* @return             True if the sparsity patterns of all operators are unchanged
+*/
+template<typename InternalT1, typename InternalT2>
+bool amg_resetup(InternalT1 & A, InternalT1 & P, InternalT2 & pointvector, amg_tag & tag)
+{
+  bool same_pattern = true;
+  for (unsigned int i=0; i<tag.get_coarselevels(); ++i)
+  {
+    // Interpolation for the new values on level i.
+    if (!detail::amg::amg_interpol_values(i, A, P, pointvector, tag))
+      same_pattern = false;
+
+    // Coarse grid operator within the pattern from the previous setup.
+    if (!detail::amg::amg_galerkin_prod_values(A[i], P[i], A[i+1]))
+      same_pattern = false;
+  }
+  return same_pattern;
+}
+
 /** @brief Initialize AMG preconditioner
 *
 * @param mat          System matrix
@@ -187,21 +224,14 @@ void amg_transform_cpu(InternalT1 & A, InternalT1 & P, InternalT1 & R, InternalT
 
   // Transform into matrix type.
   for (unsigned int i=0; i<tag.get_coarselevels()+1; ++i)
-  {
-    A[i].resize(A_setup[i].size1(),A_setup[i].size2(),false);
-    A[i] = A_setup[i];
-  }
+    detail::amg::amg_copy(A_setup[i], A[i]);
   for (unsigned int i=0; i<tag.get_coarselevels(); ++i)
-  {
-    P[i].resize(P_setup[i].size1(),P_setup[i].size2(),false);
-    P[i] = P_setup[i];
-  }
+    detail::amg::amg_copy(P_setup[i], P[i]);
   for (unsigned int i=0; i<tag.get_coarselevels(); ++i)
   {
-    R[i].resize(P_setup[i].size2(),P_setup[i].size1(),false);
-    P_setup[i].set_trans(true);
-    R[i] = P_setup[i];
-    P_setup[i].set_trans(false);
+    typename InternalT2::value_type R_setup;
+    P_setup[i].trans(R_setup);
+    detail::amg::amg_copy(R_setup, R[i]);
   }
 }
 
@@ -223,27 +253,47 @@ void amg_transform_gpu(InternalT1 & A, InternalT1 & P, InternalT1 & R, InternalT
   P.resize(tag.get_coarselevels());
   R.resize(tag.get_coarselevels());
 
-  // Copy to GPU using the internal sparse matrix structure: std::vector<std::map>.
+  // Copy to GPU using the CSR arrays of the internal sparse matrix structure.
   for (unsigned int i=0; i<tag.get_coarselevels()+1; ++i)
   {
     viennacl::switch_memory_context(A[i], ctx);
-    //A[i].resize(A_setup[i].size1(),A_setup[i].size2(),false);
-    viennacl::copy(*(A_setup[i].get_internal_pointer()),A[i]);
+    detail::amg::amg_copy(A_setup[i], A[i]);
   }
   for (unsigned int i=0; i<tag.get_coarselevels(); ++i)
   {
     viennacl::switch_memory_context(P[i], ctx);
-    //P[i].resize(P_setup[i].size1(),P_setup[i].size2(),false);
-    viennacl::copy(*(P_setup[i].get_internal_pointer()),P[i]);
-    //viennacl::copy((boost::numeric::ublas::compressed_matrix<ScalarType>)P_setup[i],P[i]);
+    detail::amg::amg_copy(P_setup[i], P[i]);
   }
   for (unsigned int i=0; i<tag.get_coarselevels(); ++i)
   {
+    typename InternalT2::value_type R_setup;
+    P_setup[i].trans(R_setup);
     viennacl::switch_memory_context(R[i], ctx);
-    //R[i].resize(P_setup[i].size2(),P_setup[i].size1(),false);
-    P_setup[i].set_trans(true);
-    viennacl::copy(*(P_setup[i].get_internal_pointer()),R[i]);
-    P_setup[i].set_trans(false);
+    detail::amg::amg_copy(R_setup, R[i]);
+  }
+}
+
+/** @brief Updates the operators on the GPU after amg_resetup() if all sparsity patterns are unchanged. Only the values are transferred.
+*
+* @param A          Operator matrices on all levels on the GPU
+* @param P          Prolongation/Interpolation operators on all levels on the GPU
+* @param R          Restriction operators on all levels on the GPU
+* @param A_setup    Operators matrices on all levels from setup phase
+* @param P_setup    Prolongation/Interpolation operators on all levels from setup phase
+* @param tag        AMG preconditioner tag
+*/
+template<typename InternalT1, typename InternalT2>
+void amg_transform_gpu_values(InternalT1 & A, InternalT1 & P, InternalT1 & R, InternalT2 & A_setup, InternalT2 & P_setup, amg_tag & tag)
+{
+  for (unsigned int i=0; i<tag.get_coarselevels()+1; ++i)
+    detail::amg::amg_copy_values(A_setup[i], A[i]);
+  for (unsigned int i=0; i<tag.get_coarselevels(); ++i)
+  {
+    detail::amg::amg_copy_values(P_setup[i], P[i]);
+
+    typename InternalT2::value_type R_setup;
+    P_setup[i].trans(R_setup);
+    detail::amg::amg_copy_values(R_setup, R[i]);
   }
 }
 
@@ -319,14 +369,8 @@ void amg_setup_apply(InternalVectorT & result, InternalVectorT & rhs, InternalVe
 template<typename NumericT, typename SparseMatrixT>
 void amg_lu(boost::numeric::ublas::compressed_matrix<NumericT> & op, boost::numeric::ublas::permutation_matrix<> & permutation, SparseMatrixT const & A)
 {
-  typedef typename SparseMatrixT::const_iterator1 ConstRowIterator;
-  typedef typename SparseMatrixT::const_iterator2 ConstColIterator;
-
   // Copy to operator matrix. Needed
-  op.resize(A.size1(),A.size2(),false);
-  for (ConstRowIterator row_iter = A.begin1(); row_iter != A.end1(); ++row_iter)
-    for (ConstColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-      op (col_iter.index1(), col_iter.index2()) = *col_iter;
+  detail::amg::amg_copy(A, op);
 
   // Permutation matrix has to be reinitialized with actual size. Do not clear() or resize()!
   permutation = boost::numeric::ublas::permutation_matrix<> (op.size1());
@@ -343,11 +387,6 @@ class amg_precond
   typedef detail::amg::amg_sparsematrix<NumericType>  SparseMatrixType;
   typedef detail::amg::amg_pointvector                PointVectorType;
 
-  typedef typename SparseMatrixType::const_iterator1  InternalConstRowIterator;
-  typedef typename SparseMatrixType::const_iterator2  InternalConstColIterator;
-  typedef typename SparseMatrixType::iterator1        InternalRowIterator;
-  typedef typename SparseMatrixType::iterator2        InternalColIterator;
-
   boost::numeric::ublas::vector<SparseMatrixType> A_setup_;
   boost::numeric::ublas::vector<SparseMatrixType> P_setup_;
   boost::numeric::ublas::vector<MatrixT>          A_;
@@ -365,15 +404,16 @@ class amg_precond
   mutable bool done_init_apply_;
 
   amg_tag tag_;
+  unsigned int requested_coarselevels_;
 public:
 
-  amg_precond(): permutation_(0) {}
+  amg_precond(): permutation_(0), requested_coarselevels_(0) {}
   /** @brief The constructor. Saves system matrix, tag and builds data structures for setup.
   *
   * @param mat  System matrix
   * @param tag  The AMG tag
   */
-  amg_precond(MatrixT const & mat, amg_tag const & tag): permutation_(0)
+  amg_precond(MatrixT const & mat, amg_tag const & tag): permutation_(0), requested_coarselevels_(tag.get_coarselevels())
   {
     tag_ = tag;
     // Initialize data structures.
@@ -394,6 +434,30 @@ public:
     done_init_apply_ = false;
   }
 
+  /** @brief Updates the preconditioner for new values of the system matrix, e.g. in the next time step of a transient simulation.
+  *
+  *  The coarsening, the interpolation patterns and the coarse grid patterns of the last call to setup() are reused, only numerical values are recomputed.
+  *  A full setup is carried out if the sparsity pattern of the system matrix has changed.
+  *
+  * @param mat  System matrix with new values
+  */
+  void resetup_values(MatrixT const & mat)
+  {
+    SparseMatrixType A0(mat);
+    if (!detail::amg::amg_assign_values(A0, A_setup_[0]))
+    {
+      tag_.set_coarselevels(requested_coarselevels_);
+      amg_init(mat, A_setup_, P_setup_, pointvector_, tag_);
+      setup();
+      return;
+    }
+
+    amg_resetup(A_setup_, P_setup_, pointvector_, tag_);
+    amg_transform_cpu(A_, P_, R_, A_setup_, P_setup_, tag_);
+
+    done_init_apply_ = false;
+  }
+
   /** @brief Prepare data structures for preconditioning:
    *  Build data structures for precondition phase.
    *  Do LU factorization on coarsest level.
@@ -421,17 +485,10 @@ public:
 
     for (unsigned int level=0; level < tag_.get_coarselevels()+1; ++level)
     {
-      level_coefficients = 0;
-      for (InternalRowIterator row_iter = A_setup_[level].begin1(); row_iter != A_setup_[level].end1(); ++row_iter)
-      {
-        for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-        {
-          if (level == 0)
-            systemmat_nonzero++;
-          nonzero++;
-          level_coefficients++;
-        }
-      }
+      level_coefficients = static_cast<unsigned int>(A_setup_[level].nnz());
+      if (level == 0)
+        systemmat_nonzero = level_coefficients;
+      nonzero += level_coefficients;
       avgstencil[level] = level_coefficients/static_cast<NumericType>(A_setup_[level].size1());
     }
     return nonzero / static_cast<NumericType>(systemmat_nonzero);
@@ -526,30 +583,29 @@ public:
   void smooth_jacobi(int level, int const iterations, VectorT & x, VectorT const & rhs_smooth) const
   {
     VectorT old_result(x.size());
-    long index;
-    NumericType sum = 0, diag = 1;
+    NumericType weight = static_cast<NumericType>(tag_.get_jacobiweight());
+
+    std::vector<unsigned int> const & row_buffer = A_setup_[level].row_buffer();
+    std::vector<unsigned int> const & col_buffer = A_setup_[level].col_buffer();
+    std::vector<NumericType>  const & elements   = A_setup_[level].elements();
 
     for (int i=0; i<iterations; ++i)
     {
       old_result = x;
-      x.clear();
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for private (sum,diag) shared (rhs_smooth, x)
+      #pragma omp parallel for
 #endif
-      for (index=0; index < static_cast<long>(A_setup_[level].size1()); ++index)
+      for (long index=0; index < static_cast<long>(A_setup_[level].size1()); ++index)
       {
-        InternalConstRowIterator row_iter = A_setup_[level].begin1();
-        row_iter += index;
-        sum = 0;
-        diag = 1;
-        for (InternalConstColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+        NumericType sum = 0, diag = 1;
+        for (unsigned int k=row_buffer[index]; k<row_buffer[index+1]; ++k)
         {
-          if (col_iter.index1() == col_iter.index2())
-            diag = *col_iter;
+          if (col_buffer[k] == static_cast<unsigned int>(index))
+            diag = elements[k];
           else
-            sum += *col_iter * old_result[col_iter.index2()];
+            sum += elements[k] * old_result[col_buffer[k]];
         }
-        x[index]= static_cast<NumericType>(tag_.get_jacobiweight()) * (rhs_smooth[index] - sum) / diag + (1-static_cast<NumericType>(tag_.get_jacobiweight())) * old_result[index];
+        x[index]= weight * (rhs_smooth[index] - sum) / diag + (1-weight) * old_result[index];
       }
     }
   }
@@ -569,11 +625,6 @@ class amg_precond< compressed_matrix<NumericT, AlignmentV> >
   typedef detail::amg::amg_sparsematrix<NumericT>           SparseMatrixType;
   typedef detail::amg::amg_pointvector                      PointVectorType;
 
-  typedef typename SparseMatrixType::const_iterator1   InternalConstRowIterator;
-  typedef typename SparseMatrixType::const_iterator2   InternalConstColIterator;
-  typedef typename SparseMatrixType::iterator1         InternalRowIterator;
-  typedef typename SparseMatrixType::iterator2         InternalColIterator;
-
   boost::numeric::ublas::vector<SparseMatrixType> A_setup_;
   boost::numeric::ublas::vector<SparseMatrixType> P_setup_;
   boost::numeric::ublas::vector<MatrixType>       A_;
@@ -587,29 +638,32 @@ class amg_precond< compressed_matrix<NumericT, AlignmentV> >
   mutable boost::numeric::ublas::vector<VectorType> result_;
   mutable boost::numeric::ublas::vector<VectorType> rhs_;
   mutable boost::numeric::ublas::vector<VectorType> residual_;
+  mutable boost::numeric::ublas::vector<VectorType> diag_;
+  mutable std::vector<viennacl::tools::shared_ptr<ssor_precond<MatrixType> > > gauss_seidel_;
 
   viennacl::context ctx_;
 
   mutable bool done_init_apply_;
 
   amg_tag tag_;
+  unsigned int requested_coarselevels_;
 
 public:
 
-  amg_precond(): permutation_(0) {}
+  amg_precond(): permutation_(0), requested_coarselevels_(0) {}
 
   /** @brief The constructor. Builds data structures.
   *
   * @param mat  System matrix
   * @param tag  The AMG tag
   */
-  amg_precond(compressed_matrix<NumericT, AlignmentV> const & mat, amg_tag const & tag): permutation_(0), ctx_(viennacl::traits::context(mat))
+  amg_precond(compressed_matrix<NumericT, AlignmentV> const & mat, amg_tag const & tag): permutation_(0), ctx_(viennacl::traits::context(mat)), requested_coarselevels_(tag.get_coarselevels())
   {
     tag_ = tag;
 
-    // Copy to CPU. Internal structure of sparse matrix is used for copy operation.
-    std::vector<std::map<unsigned int, NumericT> > mat2 = std::vector<std::map<unsigned int, NumericT> >(mat.size1());
-    viennacl::copy(mat, mat2);
+    // Copy to CPU. The CSR arrays of the system matrix are read directly into the internal sparse matrix structure.
+    SparseMatrixType mat2;
+    detail::amg::amg_copy(mat, mat2);
 
     // Initialize data structures.
     amg_init (mat2, A_setup_, P_setup_, pointvector_, tag_);
@@ -629,6 +683,39 @@ public:
     done_init_apply_ = false;
   }
 
+  /** @brief Updates the preconditioner for new values of the system matrix, e.g. in the next time step of a transient simulation.
+  *
+  *  The coarsening, the interpolation patterns and the coarse grid patterns of the last call to setup() are reused, only numerical values are recomputed.
+  *  If all patterns are unchanged, only the values are transferred to the device.
+  *  A full setup is carried out if the sparsity pattern of the system matrix has changed.
+  *
+  * @param mat  System matrix with new values
+  */
+  void resetup_values(compressed_matrix<NumericT, AlignmentV> const & mat)
+  {
+    SparseMatrixType A0;
+    detail::amg::amg_copy(mat, A0);
+    if (!detail::amg::amg_assign_values(A0, A_setup_[0]))
+    {
+      tag_.set_coarselevels(requested_coarselevels_);
+      amg_init(A0, A_setup_, P_setup_, pointvector_, tag_);
+      setup();
+      return;
+    }
+
+    if (amg_resetup(A_setup_, P_setup_, pointvector_, tag_))
+    {
+      amg_transform_gpu_values(A_, P_, R_, A_setup_, P_setup_, tag_);
+      // All patterns are unchanged, so the work vectors and the multicolor orderings of the smoother remain valid:
+      if (done_init_apply_)
+        update_apply_values();
+      return;
+    }
+
+    amg_transform_gpu(A_, P_, R_, A_setup_, P_setup_, tag_, ctx_);
+    done_init_apply_ = false;
+  }
+
   /** @brief Prepare data structures for preconditioning:
    *  Build data structures for precondition phase.
    *  Do LU factorization on coarsest level.
@@ -637,12 +724,39 @@ public:
   {
     // Setup precondition phase (Data structures).
     amg_setup_apply(result_, rhs_, residual_, A_setup_, tag_, ctx_);
+
+    // Diagonals for the backend-agnostic Jacobi smoother.
+    diag_.resize(tag_.get_coarselevels());
+    for (unsigned int level=0; level < tag_.get_coarselevels(); ++level)
+    {
+      diag_[level] = VectorType(A_[level].size1(), ctx_);
+      viennacl::linalg::detail::row_info(A_[level], diag_[level], viennacl::linalg::detail::SPARSE_ROW_DIAGONAL);
+    }
+
+    // Multicolor orderings for the Gauss-Seidel smoother, computed once per setup.
+    gauss_seidel_.clear();
+    if (tag_.get_smoother() == VIENNACL_AMG_SMOOTHER_GAUSS_SEIDEL)
+      for (unsigned int level=0; level < tag_.get_coarselevels(); ++level)
+        gauss_seidel_.push_back(viennacl::tools::shared_ptr<ssor_precond<MatrixType> >(new ssor_precond<MatrixType>(A_[level], ssor_tag())));
     // Do LU factorization for direct solve.
     amg_lu(op_, permutation_, A_setup_[tag_.get_coarselevels()]);
 
     done_init_apply_ = true;
   }
 
+  /** @brief Refreshes the data structures of the precondition phase for new values of the operators with unchanged patterns.
+  */
+  void update_apply_values() const
+  {
+    for (unsigned int level=0; level < tag_.get_coarselevels(); ++level)
+      viennacl::linalg::detail::row_info(A_[level], diag_[level], viennacl::linalg::detail::SPARSE_ROW_DIAGONAL);
+
+    for (std::size_t level=0; level < gauss_seidel_.size(); ++level)
+      gauss_seidel_[level]->update_values(A_[level]);
+
+    amg_lu(op_, permutation_, A_setup_[tag_.get_coarselevels()]);
+  }
+
   /** @brief Returns complexity measures
   *
   * @param avgstencil  Average stencil sizes on all levels
@@ -656,17 +770,10 @@ public:
 
     for (unsigned int level=0; level < tag_.get_coarselevels()+1; ++level)
     {
-      level_coefficients = 0;
-      for (InternalRowIterator row_iter = A_setup_[level].begin1(); row_iter != A_setup_[level].end1(); ++row_iter)
-      {
-        for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-        {
-          if (level == 0)
-            systemmat_nonzero++;
-          nonzero++;
-          level_coefficients++;
-        }
-      }
+      level_coefficients = static_cast<unsigned int>(A_setup_[level].nnz());
+      if (level == 0)
+        systemmat_nonzero = level_coefficients;
+      nonzero += level_coefficients;
       avgstencil[level] = level_coefficients/static_cast<double>(A_[level].size1());
     }
     return nonzero/static_cast<double>(systemmat_nonzero);
@@ -691,7 +798,7 @@ public:
       result_[level].clear();
 
       // Apply Smoother presmooth_ times.
-      smooth_jacobi(level, tag_.get_presmooth(), result_[level], rhs_[level]);
+      smooth(level, tag_.get_presmooth(), result_[level], rhs_[level], true);
 
       #ifdef VIENNACL_AMG_DEBUG
       std::cout << "After presmooth: " << std::endl;
@@ -748,7 +855,7 @@ public:
       #endif
 
       // Apply Smoother postsmooth_ times.
-      smooth_jacobi(level, tag_.get_postsmooth(), result_[level], rhs_[level]);
+      smooth(level, tag_.get_postsmooth(), result_[level], rhs_[level], false);
 
       #ifdef VIENNACL_AMG_DEBUG
       std::cout << "After postsmooth: " << std::endl;
@@ -758,6 +865,22 @@ public:
     vec = result_[0];
   }
 
+  /** @brief Applies the smoother selected in the tag
+  * @param level       Coarse level to which smoother is applied to
+  * @param iterations  Number of smoother iterations
+  * @param x           The vector smoothing is applied to
+  * @param rhs         The right hand side of the equation for the smoother
+  * @param forward     Relaxation order for the Gauss-Seidel smoother: forward for presmoothing, backward for postsmoothing
+  */
+  template<typename VectorT>
+  void smooth(int level, unsigned int iterations, VectorT & x, VectorT const & rhs_smooth, bool forward) const
+  {
+    if (tag_.get_smoother() == VIENNACL_AMG_SMOOTHER_GAUSS_SEIDEL)
+      gauss_seidel_[static_cast<vcl_size_t>(level)]->smooth(x, rhs_smooth, iterations, forward);
+    else
+      smooth_jacobi(level, iterations, x, rhs_smooth);
+  }
+
   /** @brief Jacobi Smoother (GPU version)
   * @param level       Coarse level to which smoother is applied to
   * @param iterations  Number of smoother iterations
@@ -769,6 +892,32 @@ public:
   {
     VectorType old_result = x;
 
+#ifdef VIENNACL_WITH_OPENCL
+    if (viennacl::traits::active_handle_id(x) == viennacl::OPENCL_MEMORY)
+    {
+      smooth_jacobi_opencl(level, iterations, x, rhs_smooth, old_result);
+      return;
+    }
+#endif
+
+    // x = old_result + weight * (rhs - A * old_result) ./ diag(A) for all other backends
+    NumericT weight = static_cast<NumericT>(tag_.get_jacobiweight());
+    VectorType temp(x.size(), ctx_);
+    for (unsigned int i=0; i<iterations; ++i)
+    {
+      if (i > 0)
+        old_result = x;
+      temp = viennacl::linalg::prod(A_[level], old_result);
+      temp = rhs_smooth - temp;
+      x = old_result + weight * viennacl::linalg::element_div(temp, diag_[level]);
+    }
+  }
+
+#ifdef VIENNACL_WITH_OPENCL
+  /** @brief Jacobi Smoother using a dedicated OpenCL kernel */
+  template<typename VectorT>
+  void smooth_jacobi_opencl(int level, unsigned int iterations, VectorT & x, VectorT const & rhs_smooth, VectorType & old_result) const
+  {
     viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(x).context());
     viennacl::linalg::opencl::kernels::compressed_matrix<NumericT>::init(ctx);
     viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::compressed_matrix<NumericT>::program_name(), "jacobi");
@@ -787,6 +936,7 @@ public:
 
     }
   }
+#endif
 
   amg_tag & tag() { return tag_; }
 };
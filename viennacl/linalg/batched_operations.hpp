@@ -0,0 +1,177 @@
+#ifndef VIENNACL_LINALG_BATCHED_OPERATIONS_HPP_
+#define VIENNACL_LINALG_BATCHED_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/batched_operations.hpp
+    @brief Batched LU and QR factorizations and solves for large numbers of small dense systems.
+
+    The i-th of the 'batch_count' systems of size n x n is stored in row-major layout in the entries [i*n*n, (i+1)*n*n) of a single vector.
+    Right hand sides, pivots, and Householder scaling factors are stored in the entries [i*n, (i+1)*n) of their respective vectors.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/linalg/host_based/batched_operations.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief Computes the LU factorizations with partial pivoting of a batch of small dense matrices.
+*
+* @param matrices      The matrices, overwritten with their LU factors (the unit diagonal of L is not stored)
+* @param pivots        Pivot indices (n per system): Row k was exchanged with row pivots[k] in step k
+* @param n             Number of rows and columns of each matrix
+* @param batch_count   Number of matrices
+* @param info          Status (one per system) as in LAPACK's getrf: Zero on success, k+1 if U(k,k) is exactly zero (the factorization is completed, but a substitution would divide by zero)
+*/
+template<typename NumericT>
+void batched_lu_factorize(vector_base<NumericT> & matrices, vector_base<unsigned int> & pivots, vcl_size_t n, vcl_size_t batch_count, vector_base<unsigned int> & info)
+{
+  assert(viennacl::traits::size(matrices) >= n * n * batch_count && bool("Size of matrix buffer too small"));
+  assert(viennacl::traits::size(pivots)   >= n * batch_count     && bool("Size of pivot buffer too small"));
+  assert(viennacl::traits::size(info)     >= batch_count         && bool("Size of status buffer too small"));
+
+  switch (viennacl::traits::handle(matrices).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::batched_lu_factorize(matrices, pivots, n, batch_count, info);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Solves a batch of systems with the LU factorizations computed by batched_lu_factorize(). Only systems with zero status in the factorization must be solved.
+*
+* @param matrices      The LU factors
+* @param pivots        The pivot indices
+* @param rhs           The right hand sides (n per system), overwritten with the solutions
+* @param n             Number of rows and columns of each matrix
+* @param batch_count   Number of systems
+*/
+template<typename NumericT>
+void batched_lu_substitute(vector_base<NumericT> const & matrices, vector_base<unsigned int> const & pivots, vector_base<NumericT> & rhs, vcl_size_t n, vcl_size_t batch_count)
+{
+  assert(viennacl::traits::size(matrices) >= n * n * batch_count && bool("Size of matrix buffer too small"));
+  assert(viennacl::traits::size(pivots)   >= n * batch_count     && bool("Size of pivot buffer too small"));
+  assert(viennacl::traits::size(rhs)      >= n * batch_count     && bool("Size of right hand side buffer too small"));
+
+  switch (viennacl::traits::handle(matrices).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::batched_lu_substitute(matrices, pivots, rhs, n, batch_count);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Solves a batch of systems by LU factorization with partial pivoting. Each system is factored and solved while it resides in cache.
+*
+* @param matrices      The matrices, overwritten with their LU factors
+* @param rhs           The right hand sides (n per system), overwritten with the solutions. Right hand sides of singular systems are left unchanged.
+* @param n             Number of rows and columns of each matrix
+* @param batch_count   Number of systems
+* @param info          Status (one per system) as in batched_lu_factorize()
+*/
+template<typename NumericT>
+void batched_lu_solve(vector_base<NumericT> & matrices, vector_base<NumericT> & rhs, vcl_size_t n, vcl_size_t batch_count, vector_base<unsigned int> & info)
+{
+  assert(viennacl::traits::size(matrices) >= n * n * batch_count && bool("Size of matrix buffer too small"));
+  assert(viennacl::traits::size(rhs)      >= n * batch_count     && bool("Size of right hand side buffer too small"));
+  assert(viennacl::traits::size(info)     >= batch_count         && bool("Size of status buffer too small"));
+
+  switch (viennacl::traits::handle(matrices).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::batched_lu_solve(matrices, rhs, n, batch_count, info);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Computes the Householder QR factorizations of a batch of small dense matrices.
+*
+* @param matrices      The matrices, overwritten with R (upper triangle) and the Householder vectors (below the diagonal, with implicit unit leading entry)
+* @param tau           Scaling factors of the Householder reflections I - tau v v^T (n per system)
+* @param n             Number of rows and columns of each matrix
+* @param batch_count   Number of matrices
+* @param info          Status (one per system): Zero on success, k+1 if R(k,k) is exactly zero
+*/
+template<typename NumericT>
+void batched_qr_factorize(vector_base<NumericT> & matrices, vector_base<NumericT> & tau, vcl_size_t n, vcl_size_t batch_count, vector_base<unsigned int> & info)
+{
+  assert(viennacl::traits::size(matrices) >= n * n * batch_count && bool("Size of matrix buffer too small"));
+  assert(viennacl::traits::size(tau)      >= n * batch_count     && bool("Size of Householder coefficient buffer too small"));
+  assert(viennacl::traits::size(info)     >= batch_count         && bool("Size of status buffer too small"));
+
+  switch (viennacl::traits::handle(matrices).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::batched_qr_factorize(matrices, tau, n, batch_count, info);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Solves a batch of systems with the QR factorizations computed by batched_qr_factorize(). Only systems with zero status in the factorization must be solved.
+*
+* @param matrices      The QR factors
+* @param tau           The scaling factors of the Householder reflections
+* @param rhs           The right hand sides (n per system), overwritten with the solutions
+* @param n             Number of rows and columns of each matrix
+* @param batch_count   Number of systems
+*/
+template<typename NumericT>
+void batched_qr_solve(vector_base<NumericT> const & matrices, vector_base<NumericT> const & tau, vector_base<NumericT> & rhs, vcl_size_t n, vcl_size_t batch_count)
+{
+  assert(viennacl::traits::size(matrices) >= n * n * batch_count && bool("Size of matrix buffer too small"));
+  assert(viennacl::traits::size(tau)      >= n * batch_count     && bool("Size of Householder coefficient buffer too small"));
+  assert(viennacl::traits::size(rhs)      >= n * batch_count     && bool("Size of right hand side buffer too small"));
+
+  switch (viennacl::traits::handle(matrices).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::batched_qr_solve(matrices, tau, rhs, n, batch_count);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -27,6 +27,7 @@
 #include <numeric>
 
 #include "viennacl/forwards.h"
+#include "viennacl/linalg/detail/residual_history.hpp"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/inner_prod.hpp"
@@ -36,6 +37,7 @@
 #include "viennacl/traits/context.hpp"
 #include "viennacl/meta/result_of.hpp"
 #include "viennacl/linalg/iterative_operations.hpp"
+#include "viennacl/linalg/detail/multi_rhs.hpp"
 
 namespace viennacl
 {
@@ -44,7 +46,7 @@ namespace linalg
 
 /** @brief A tag for the stabilized Bi-conjugate gradient solver. Used for supplying solver parameters and for dispatching the solve() function
 */
-class bicgstab_tag
+class bicgstab_tag : public detail::residual_history_recorder
 {
 public:
   /** @brief The constructor
@@ -83,121 +85,382 @@ private:
 };
 
 
+namespace detail
+{
+
+  /** @brief Implementation of a pipelined stabilized Bi-conjugate gradient solver. A zero initial guess is used if 'initial_guess' is NULL. */
+  template<typename MatrixT, typename NumericT>
+  viennacl::vector<NumericT> pipelined_bicgstab_solve(MatrixT const & A,
+                                                      viennacl::vector_base<NumericT> const & rhs,
+                                                      bicgstab_tag const & tag,
+                                                      viennacl::vector_base<NumericT> const * initial_guess)
+  {
+    viennacl::vector<NumericT> result = viennacl::zero_vector<NumericT>(rhs.size(), viennacl::traits::context(rhs));
+
+    tag.clear_residual_history();
+
+    viennacl::vector<NumericT> residual = rhs;
+    if (initial_guess)
+    {
+      result = *initial_guess;
+      residual -= viennacl::linalg::prod(A, result);
+    }
+
+    viennacl::vector<NumericT> p = residual;
+    viennacl::vector<NumericT> r0star = residual;
+    viennacl::vector<NumericT> Ap = rhs;
+    viennacl::vector<NumericT> s  = rhs;
+    viennacl::vector<NumericT> As = rhs;
+
+    // Layout of temporary buffer:
+    //  chunk 0: <residual, r_0^*>
+    //  chunk 1: <As, As>
+    //  chunk 2: <As, s>
+    //  chunk 3: <Ap, r_0^*>
+    //  chunk 4: <As, r_0^*>
+    //  chunk 5: <s, s>
+    vcl_size_t buffer_size_per_vector = 256;
+    vcl_size_t num_buffer_chunks = 6;
+    viennacl::vector<NumericT> inner_prod_buffer = viennacl::zero_vector<NumericT>(num_buffer_chunks*buffer_size_per_vector, viennacl::traits::context(rhs)); // temporary buffer
+    std::vector<NumericT>      host_inner_prod_buffer(inner_prod_buffer.size());
+
+    NumericT norm_rhs_host = viennacl::linalg::norm_2(rhs);
+    NumericT beta;
+    NumericT alpha;
+    NumericT omega;
+    NumericT residual_norm = initial_guess ? viennacl::linalg::norm_2(residual) : norm_rhs_host;
+    inner_prod_buffer[0] = residual_norm * residual_norm;
+
+    NumericT  r_dot_r0 = 0;
+    NumericT As_dot_As = 0;
+    NumericT As_dot_s  = 0;
+    NumericT Ap_dot_r0 = 0;
+    NumericT As_dot_r0 = 0;
+    NumericT  s_dot_s  = 0;
+
+    if (norm_rhs_host <= 0) //solution is zero if RHS norm is zero
+    {
+      viennacl::traits::clear(result);
+      return result;
+    }
+
+    if (residual_norm / norm_rhs_host < tag.tolerance()) //initial guess is accurate enough
+    {
+      tag.iters(0);
+      tag.error(residual_norm / norm_rhs_host);
+      return result;
+    }
+
+    for (vcl_size_t i = 0; i < tag.max_iterations(); ++i)
+    {
+      tag.iters(i+1);
+      // Ap = A*p_j
+      // Ap_dot_r0 = <Ap, r_0^*>
+      viennacl::linalg::pipelined_bicgstab_prod(A, p, Ap, r0star,
+                                                inner_prod_buffer, buffer_size_per_vector, 3*buffer_size_per_vector);
+
+      //////// first (weak) synchronization point ////
+
+      ///// method 1: compute alpha on host:
+      //
+      //// we only need the second chunk of the buffer for computing Ap_dot_r0:
+      //viennacl::fast_copy(inner_prod_buffer.begin(), inner_prod_buffer.end(), host_inner_prod_buffer.begin());
+      //Ap_dot_r0 = std::accumulate(host_inner_prod_buffer.begin() +     buffer_size_per_vector, host_inner_prod_buffer.begin() + 2 * buffer_size_per_vector, ScalarType(0));
+
+      //alpha = residual_dot_r0 / Ap_dot_r0;
+
+      //// s_j = r_j - alpha_j q_j
+      //s = residual - alpha * Ap;
+
+      ///// method 2: compute alpha on device:
+      // s = r - alpha * Ap
+      // <s, s> first stage
+      // dump alpha at end of inner_prod_buffer
+      viennacl::linalg::pipelined_bicgstab_update_s(s, residual, Ap,
+                                                    inner_prod_buffer, buffer_size_per_vector, 5*buffer_size_per_vector);
+
+      // As = A*s_j
+      // As_dot_As = <As, As>
+      // As_dot_s  = <As, s>
+      // As_dot_r0 = <As, r_0^*>
+      viennacl::linalg::pipelined_bicgstab_prod(A, s, As, r0star,
+                                                inner_prod_buffer, buffer_size_per_vector, 4*buffer_size_per_vector);
+
+      //////// second (strong) synchronization point ////
+
+      viennacl::fast_copy(inner_prod_buffer.begin(), inner_prod_buffer.end(), host_inner_prod_buffer.begin());
+
+       r_dot_r0 = std::accumulate(host_inner_prod_buffer.begin(),                              host_inner_prod_buffer.begin() +     buffer_size_per_vector, NumericT(0));
+      As_dot_As = std::accumulate(host_inner_prod_buffer.begin() +     buffer_size_per_vector, host_inner_prod_buffer.begin() + 2 * buffer_size_per_vector, NumericT(0));
+      As_dot_s  = std::accumulate(host_inner_prod_buffer.begin() + 2 * buffer_size_per_vector, host_inner_prod_buffer.begin() + 3 * buffer_size_per_vector, NumericT(0));
+      Ap_dot_r0 = std::accumulate(host_inner_prod_buffer.begin() + 3 * buffer_size_per_vector, host_inner_prod_buffer.begin() + 4 * buffer_size_per_vector, NumericT(0));
+      As_dot_r0 = std::accumulate(host_inner_prod_buffer.begin() + 4 * buffer_size_per_vector, host_inner_prod_buffer.begin() + 5 * buffer_size_per_vector, NumericT(0));
+       s_dot_s  = std::accumulate(host_inner_prod_buffer.begin() + 5 * buffer_size_per_vector, host_inner_prod_buffer.begin() + 6 * buffer_size_per_vector, NumericT(0));
+
+      alpha =         r_dot_r0 / Ap_dot_r0;
+      beta  = -1.0 * As_dot_r0 / Ap_dot_r0;
+      omega =        As_dot_s  / As_dot_As;
+
+      residual_norm = std::sqrt(s_dot_s - 2.0 * omega * As_dot_s + omega * omega *  As_dot_As);
+      tag.record_residual(residual_norm / norm_rhs_host);
+      if (std::fabs(residual_norm / norm_rhs_host) < tag.tolerance())
+        break;
+
+      // x_{j+1} = x_j + alpha * p_j + omega * s_j
+      // r_{j+1} = s_j - omega * t_j
+      // p_{j+1} = r_{j+1} + beta * (p_j - omega * q_j)
+      // and compute first stage of r_dot_r0 = <r_{j+1}, r_o^*> for use in next iteration
+       viennacl::linalg::pipelined_bicgstab_vector_update(result, alpha, p, omega, s,
+                                                          residual, As,
+                                                          beta, Ap,
+                                                          r0star, inner_prod_buffer, buffer_size_per_vector);
+    }
+
+    //store last error estimate:
+    tag.error(residual_norm / norm_rhs_host);
+
+    return result;
+  }
+
+}
+
 /** @brief Implementation of a pipelined stabilized Bi-conjugate gradient solver */
 template<typename MatrixT, typename NumericT>
-viennacl::vector<NumericT> solve(MatrixT const & A, //MatrixType const & A,
+viennacl::vector<NumericT> solve(MatrixT const & A,
                                  viennacl::vector_base<NumericT> const & rhs,
                                  bicgstab_tag const & tag,
                                  viennacl::linalg::no_precond)
 {
-  viennacl::vector<NumericT> result = viennacl::zero_vector<NumericT>(rhs.size(), viennacl::traits::context(rhs));
-
-  viennacl::vector<NumericT> residual = rhs;
-  viennacl::vector<NumericT> p = rhs;
-  viennacl::vector<NumericT> r0star = rhs;
-  viennacl::vector<NumericT> Ap = rhs;
-  viennacl::vector<NumericT> s  = rhs;
-  viennacl::vector<NumericT> As = rhs;
-
-  // Layout of temporary buffer:
-  //  chunk 0: <residual, r_0^*>
-  //  chunk 1: <As, As>
-  //  chunk 2: <As, s>
-  //  chunk 3: <Ap, r_0^*>
-  //  chunk 4: <As, r_0^*>
-  //  chunk 5: <s, s>
-  vcl_size_t buffer_size_per_vector = 256;
-  vcl_size_t num_buffer_chunks = 6;
-  viennacl::vector<NumericT> inner_prod_buffer = viennacl::zero_vector<NumericT>(num_buffer_chunks*buffer_size_per_vector, viennacl::traits::context(rhs)); // temporary buffer
-  std::vector<NumericT>      host_inner_prod_buffer(inner_prod_buffer.size());
-
-  NumericT norm_rhs_host = viennacl::linalg::norm_2(residual);
-  NumericT beta;
-  NumericT alpha;
-  NumericT omega;
-  NumericT residual_norm = norm_rhs_host;
-  inner_prod_buffer[0] = norm_rhs_host * norm_rhs_host;
-
-  NumericT  r_dot_r0 = 0;
-  NumericT As_dot_As = 0;
-  NumericT As_dot_s  = 0;
-  NumericT Ap_dot_r0 = 0;
-  NumericT As_dot_r0 = 0;
-  NumericT  s_dot_s  = 0;
-
-  if (norm_rhs_host <= 0) //solution is zero if RHS norm is zero
-    return result;
+  return detail::pipelined_bicgstab_solve(A, rhs, tag, static_cast<viennacl::vector_base<NumericT> const *>(NULL));
+}
 
-  for (vcl_size_t i = 0; i < tag.max_iterations(); ++i)
+/** @brief Pipelined stabilized Bi-conjugate gradient solver starting from the given initial guess. The relative tolerance refers to the norm of the right hand side. */
+template<typename MatrixT, typename NumericT>
+viennacl::vector<NumericT> solve(MatrixT const & A,
+                                 viennacl::vector_base<NumericT> const & rhs,
+                                 bicgstab_tag const & tag,
+                                 viennacl::linalg::no_precond,
+                                 viennacl::vector_base<NumericT> const & initial_guess)
+{
+  return detail::pipelined_bicgstab_solve(A, rhs, tag, &initial_guess);
+}
+
+
+namespace detail
+{
+
+  /** @brief Implementation of the stabilized Bi-conjugate gradient solver
+  *
+  * Following the description in "Iterative Methods for Sparse Linear Systems" by Y. Saad
+  *
+  * @param matrix     The system matrix
+  * @param rhs        The load vector
+  * @param tag        Solver configuration tag
+  * @param initial_guess  Pointer to the initial guess. A zero initial guess is used if NULL.
+  * @return The result vector
+  */
+  template<typename MatrixT, typename VectorT>
+  VectorT bicgstab_solve(MatrixT const & matrix, VectorT const & rhs, bicgstab_tag const & tag, VectorT const * initial_guess)
   {
-    tag.iters(i+1);
-    // Ap = A*p_j
-    // Ap_dot_r0 = <Ap, r_0^*>
-    viennacl::linalg::pipelined_bicgstab_prod(A, p, Ap, r0star,
-                                              inner_prod_buffer, buffer_size_per_vector, 3*buffer_size_per_vector);
-
-    //////// first (weak) synchronization point ////
-
-    ///// method 1: compute alpha on host:
-    //
-    //// we only need the second chunk of the buffer for computing Ap_dot_r0:
-    //viennacl::fast_copy(inner_prod_buffer.begin(), inner_prod_buffer.end(), host_inner_prod_buffer.begin());
-    //Ap_dot_r0 = std::accumulate(host_inner_prod_buffer.begin() +     buffer_size_per_vector, host_inner_prod_buffer.begin() + 2 * buffer_size_per_vector, ScalarType(0));
-
-    //alpha = residual_dot_r0 / Ap_dot_r0;
-
-    //// s_j = r_j - alpha_j q_j
-    //s = residual - alpha * Ap;
-
-    ///// method 2: compute alpha on device:
-    // s = r - alpha * Ap
-    // <s, s> first stage
-    // dump alpha at end of inner_prod_buffer
-    viennacl::linalg::pipelined_bicgstab_update_s(s, residual, Ap,
-                                                  inner_prod_buffer, buffer_size_per_vector, 5*buffer_size_per_vector);
-
-    // As = A*s_j
-    // As_dot_As = <As, As>
-    // As_dot_s  = <As, s>
-    // As_dot_r0 = <As, r_0^*>
-    viennacl::linalg::pipelined_bicgstab_prod(A, s, As, r0star,
-                                              inner_prod_buffer, buffer_size_per_vector, 4*buffer_size_per_vector);
-
-    //////// second (strong) synchronization point ////
-
-    viennacl::fast_copy(inner_prod_buffer.begin(), inner_prod_buffer.end(), host_inner_prod_buffer.begin());
-
-     r_dot_r0 = std::accumulate(host_inner_prod_buffer.begin(),                              host_inner_prod_buffer.begin() +     buffer_size_per_vector, NumericT(0));
-    As_dot_As = std::accumulate(host_inner_prod_buffer.begin() +     buffer_size_per_vector, host_inner_prod_buffer.begin() + 2 * buffer_size_per_vector, NumericT(0));
-    As_dot_s  = std::accumulate(host_inner_prod_buffer.begin() + 2 * buffer_size_per_vector, host_inner_prod_buffer.begin() + 3 * buffer_size_per_vector, NumericT(0));
-    Ap_dot_r0 = std::accumulate(host_inner_prod_buffer.begin() + 3 * buffer_size_per_vector, host_inner_prod_buffer.begin() + 4 * buffer_size_per_vector, NumericT(0));
-    As_dot_r0 = std::accumulate(host_inner_prod_buffer.begin() + 4 * buffer_size_per_vector, host_inner_prod_buffer.begin() + 5 * buffer_size_per_vector, NumericT(0));
-     s_dot_s  = std::accumulate(host_inner_prod_buffer.begin() + 5 * buffer_size_per_vector, host_inner_prod_buffer.begin() + 6 * buffer_size_per_vector, NumericT(0));
-
-    alpha =         r_dot_r0 / Ap_dot_r0;
-    beta  = -1.0 * As_dot_r0 / Ap_dot_r0;
-    omega =        As_dot_s  / As_dot_As;
-
-    residual_norm = std::sqrt(s_dot_s - 2.0 * omega * As_dot_s + omega * omega *  As_dot_As);
-    if (std::fabs(residual_norm / norm_rhs_host) < tag.tolerance())
-      break;
-
-    // x_{j+1} = x_j + alpha * p_j + omega * s_j
-    // r_{j+1} = s_j - omega * t_j
-    // p_{j+1} = r_{j+1} + beta * (p_j - omega * q_j)
-    // and compute first stage of r_dot_r0 = <r_{j+1}, r_o^*> for use in next iteration
-     viennacl::linalg::pipelined_bicgstab_vector_update(result, alpha, p, omega, s,
-                                                        residual, As,
-                                                        beta, Ap,
-                                                        r0star, inner_prod_buffer, buffer_size_per_vector);
+    typedef typename viennacl::result_of::value_type<VectorT>::type            NumericType;
+    typedef typename viennacl::result_of::cpu_value_type<NumericType>::type    CPU_NumericType;
+    VectorT result = rhs;
+    viennacl::traits::clear(result);
+
+    VectorT residual = rhs;
+    VectorT p = rhs;
+    VectorT r0star = rhs;
+    VectorT tmp0 = rhs;
+    VectorT tmp1 = rhs;
+    VectorT s = rhs;
+
+    CPU_NumericType norm_rhs_host = viennacl::linalg::norm_2(residual);
+    CPU_NumericType ip_rr0star = norm_rhs_host * norm_rhs_host;
+    CPU_NumericType beta;
+    CPU_NumericType alpha;
+    CPU_NumericType omega;
+    //ScalarType inner_prod_temp; //temporary variable for inner product computation
+    CPU_NumericType new_ip_rr0star = 0;
+    CPU_NumericType residual_norm = norm_rhs_host;
+
+    if (norm_rhs_host == 0) //solution is zero if RHS norm is zero
+      return result;
+
+    tag.clear_residual_history();
+    if (initial_guess)
+      result = *initial_guess;
+
+    bool restart_flag = true;
+    vcl_size_t last_restart = 0;
+    for (vcl_size_t i = 0; i < tag.max_iterations(); ++i)
+    {
+      if (restart_flag)
+      {
+        residual = rhs;
+        residual -= viennacl::linalg::prod(matrix, result);
+        p = residual;
+        r0star = residual;
+        ip_rr0star = viennacl::linalg::norm_2(residual);
+        ip_rr0star *= ip_rr0star;
+        restart_flag = false;
+        last_restart = i;
+
+        residual_norm = std::sqrt(ip_rr0star);
+        if (residual_norm / norm_rhs_host < tag.tolerance()) //accurate enough, e.g. from the initial guess
+        {
+          tag.iters(static_cast<unsigned int>(i));
+          break;
+        }
+      }
+
+      tag.iters(i+1);
+      tmp0 = viennacl::linalg::prod(matrix, p);
+      alpha = ip_rr0star / viennacl::linalg::inner_prod(tmp0, r0star);
+
+      s = residual - alpha*tmp0;
+
+      tmp1 = viennacl::linalg::prod(matrix, s);
+      CPU_NumericType norm_tmp1 = viennacl::linalg::norm_2(tmp1);
+      omega = viennacl::linalg::inner_prod(tmp1, s) / (norm_tmp1 * norm_tmp1);
+
+      result += alpha * p + omega * s;
+      residual = s - omega * tmp1;
+
+      new_ip_rr0star = viennacl::linalg::inner_prod(residual, r0star);
+      residual_norm = viennacl::linalg::norm_2(residual);
+      tag.record_residual(residual_norm / norm_rhs_host);
+      if (std::fabs(residual_norm / norm_rhs_host) < tag.tolerance())
+        break;
+
+      beta = new_ip_rr0star / ip_rr0star * alpha/omega;
+      ip_rr0star = new_ip_rr0star;
+
+      if (ip_rr0star == 0 || omega == 0 || i - last_restart > tag.max_iterations_before_restart()) //search direction degenerate. A restart might help
+        restart_flag = true;
+
+      // Execution of
+      //  p = residual + beta * (p - omega*tmp0);
+      // without introducing temporary vectors:
+      p -= omega * tmp0;
+      p = residual + beta * p;
+    }
+
+    //store last error estimate:
+    tag.error(residual_norm / norm_rhs_host);
+
+    return result;
   }
 
-  //store last error estimate:
-  tag.error(residual_norm / norm_rhs_host);
+  /** @brief Implementation of the preconditioned stabilized Bi-conjugate gradient solver
+  *
+  * Following the description of the unpreconditioned case in "Iterative Methods for Sparse Linear Systems" by Y. Saad
+  *
+  * @param matrix     The system matrix
+  * @param rhs        The load vector
+  * @param tag        Solver configuration tag
+  * @param precond    A preconditioner. Precondition operation is done via member function apply()
+  * @param initial_guess  Pointer to the initial guess. A zero initial guess is used if NULL.
+  * @return The result vector
+  */
+  template<typename MatrixT, typename VectorT, typename PreconditionerT>
+  VectorT pbicgstab_solve(MatrixT const & matrix, VectorT const & rhs, bicgstab_tag const & tag, PreconditionerT const & precond, VectorT const * initial_guess)
+  {
+    typedef typename viennacl::result_of::value_type<VectorT>::type            NumericType;
+    typedef typename viennacl::result_of::cpu_value_type<NumericType>::type    CPU_NumericType;
+    VectorT result = rhs;
+    viennacl::traits::clear(result);
+
+    VectorT residual = rhs;
+    VectorT r0star = residual;  //can be chosen arbitrarily in fact
+    VectorT tmp0 = rhs;
+    VectorT tmp1 = rhs;
+    VectorT s = rhs;
+
+    VectorT p = residual;
+
+    CPU_NumericType ip_rr0star = viennacl::linalg::norm_2(residual);
+    CPU_NumericType norm_rhs_host = viennacl::linalg::norm_2(residual);
+    CPU_NumericType beta;
+    CPU_NumericType alpha;
+    CPU_NumericType omega;
+    CPU_NumericType new_ip_rr0star = 0;
+    CPU_NumericType residual_norm = norm_rhs_host;
+
+    if (!norm_rhs_host) //solution is zero if RHS norm is zero
+      return result;
+
+    tag.clear_residual_history();
+    if (initial_guess)
+      result = *initial_guess;
+
+    bool restart_flag = true;
+    vcl_size_t last_restart = 0;
+    for (unsigned int i = 0; i < tag.max_iterations(); ++i)
+    {
+      if (restart_flag)
+      {
+        residual = rhs;
+        residual -= viennacl::linalg::prod(matrix, result);
+        precond.apply(residual);
+        p = residual;
+        r0star = residual;
+        ip_rr0star = viennacl::linalg::norm_2(residual);
+        ip_rr0star *= ip_rr0star;
+        restart_flag = false;
+        last_restart = i;
+
+        residual_norm = std::sqrt(ip_rr0star);
+        if (residual_norm / norm_rhs_host < tag.tolerance()) //accurate enough, e.g. from the initial guess
+        {
+          tag.iters(static_cast<unsigned int>(i));
+          break;
+        }
+      }
+
+      tag.iters(i+1);
+      tmp0 = viennacl::linalg::prod(matrix, p);
+      precond.apply(tmp0);
+      alpha = ip_rr0star / viennacl::linalg::inner_prod(tmp0, r0star);
+
+      s = residual - alpha*tmp0;
+
+      tmp1 = viennacl::linalg::prod(matrix, s);
+      precond.apply(tmp1);
+      CPU_NumericType norm_tmp1 = viennacl::linalg::norm_2(tmp1);
+      omega = viennacl::linalg::inner_prod(tmp1, s) / (norm_tmp1 * norm_tmp1);
+
+      result += alpha * p + omega * s;
+      residual = s - omega * tmp1;
+
+      residual_norm = viennacl::linalg::norm_2(residual);
+      tag.record_residual(residual_norm / norm_rhs_host);
+      if (residual_norm / norm_rhs_host < tag.tolerance())
+        break;
+
+      new_ip_rr0star = viennacl::linalg::inner_prod(residual, r0star);
+
+      beta = new_ip_rr0star / ip_rr0star * alpha/omega;
+      ip_rr0star = new_ip_rr0star;
+
+      if (!ip_rr0star || !omega || i - last_restart > tag.max_iterations_before_restart()) //search direction degenerate. A restart might help
+        restart_flag = true;
+
+      // Execution of
+      //  p = residual + beta * (p - omega*tmp0);
+      // without introducing temporary vectors:
+      p -= omega * tmp0;
+      p = residual + beta * p;
+
+      //std::cout << "Rel. Residual in current step: " << std::sqrt(std::fabs(viennacl::linalg::inner_prod(residual, residual) / norm_rhs_host)) << std::endl;
+    }
+
+    //store last error estimate:
+    tag.error(residual_norm / norm_rhs_host);
 
-  return result;
-}
+    return result;
+  }
 
+}
 
 /** @brief Implementation of the stabilized Bi-conjugate gradient solver
 *
@@ -211,87 +474,27 @@ viennacl::vector<NumericT> solve(MatrixT const & A, //MatrixType const & A,
 template<typename MatrixT, typename VectorT>
 VectorT solve(MatrixT const & matrix, VectorT const & rhs, bicgstab_tag const & tag)
 {
-  typedef typename viennacl::result_of::value_type<VectorT>::type            NumericType;
-  typedef typename viennacl::result_of::cpu_value_type<NumericType>::type    CPU_NumericType;
-  VectorT result = rhs;
-  viennacl::traits::clear(result);
-
-  VectorT residual = rhs;
-  VectorT p = rhs;
-  VectorT r0star = rhs;
-  VectorT tmp0 = rhs;
-  VectorT tmp1 = rhs;
-  VectorT s = rhs;
-
-  CPU_NumericType norm_rhs_host = viennacl::linalg::norm_2(residual);
-  CPU_NumericType ip_rr0star = norm_rhs_host * norm_rhs_host;
-  CPU_NumericType beta;
-  CPU_NumericType alpha;
-  CPU_NumericType omega;
-  //ScalarType inner_prod_temp; //temporary variable for inner product computation
-  CPU_NumericType new_ip_rr0star = 0;
-  CPU_NumericType residual_norm = norm_rhs_host;
-
-  if (norm_rhs_host == 0) //solution is zero if RHS norm is zero
-    return result;
-
-  bool restart_flag = true;
-  vcl_size_t last_restart = 0;
-  for (vcl_size_t i = 0; i < tag.max_iterations(); ++i)
-  {
-    if (restart_flag)
-    {
-      residual = rhs;
-      residual -= viennacl::linalg::prod(matrix, result);
-      p = residual;
-      r0star = residual;
-      ip_rr0star = viennacl::linalg::norm_2(residual);
-      ip_rr0star *= ip_rr0star;
-      restart_flag = false;
-      last_restart = i;
-    }
-
-    tag.iters(i+1);
-    tmp0 = viennacl::linalg::prod(matrix, p);
-    alpha = ip_rr0star / viennacl::linalg::inner_prod(tmp0, r0star);
-
-    s = residual - alpha*tmp0;
-
-    tmp1 = viennacl::linalg::prod(matrix, s);
-    CPU_NumericType norm_tmp1 = viennacl::linalg::norm_2(tmp1);
-    omega = viennacl::linalg::inner_prod(tmp1, s) / (norm_tmp1 * norm_tmp1);
-
-    result += alpha * p + omega * s;
-    residual = s - omega * tmp1;
-
-    new_ip_rr0star = viennacl::linalg::inner_prod(residual, r0star);
-    residual_norm = viennacl::linalg::norm_2(residual);
-    if (std::fabs(residual_norm / norm_rhs_host) < tag.tolerance())
-      break;
-
-    beta = new_ip_rr0star / ip_rr0star * alpha/omega;
-    ip_rr0star = new_ip_rr0star;
-
-    if (ip_rr0star == 0 || omega == 0 || i - last_restart > tag.max_iterations_before_restart()) //search direction degenerate. A restart might help
-      restart_flag = true;
-
-    // Execution of
-    //  p = residual + beta * (p - omega*tmp0);
-    // without introducing temporary vectors:
-    p -= omega * tmp0;
-    p = residual + beta * p;
-  }
-
-  //store last error estimate:
-  tag.error(residual_norm / norm_rhs_host);
-
-  return result;
+  return detail::bicgstab_solve(matrix, rhs, tag, static_cast<VectorT const *>(NULL));
 }
 
 template<typename MatrixT, typename VectorT>
 VectorT solve(MatrixT const & matrix, VectorT const & rhs, bicgstab_tag const & tag, viennacl::linalg::no_precond)
 {
-  return solve(matrix, rhs, tag);
+  return detail::bicgstab_solve(matrix, rhs, tag, static_cast<VectorT const *>(NULL));
+}
+
+/** @brief Stabilized Bi-conjugate gradient solver starting from the given initial guess. The relative tolerance refers to the norm of the right hand side.
+*
+* @param matrix         The system matrix
+* @param rhs            The load vector
+* @param tag            Solver configuration tag
+* @param initial_guess  The initial guess, e.g. the solution of the previous time step
+* @return The result vector
+*/
+template<typename MatrixT, typename VectorT>
+VectorT solve(MatrixT const & matrix, VectorT const & rhs, bicgstab_tag const & tag, viennacl::linalg::no_precond, VectorT const & initial_guess)
+{
+  return detail::bicgstab_solve(matrix, rhs, tag, &initial_guess);
 }
 
 /** @brief Implementation of the preconditioned stabilized Bi-conjugate gradient solver
@@ -307,87 +510,243 @@ VectorT solve(MatrixT const & matrix, VectorT const & rhs, bicgstab_tag const &
 template<typename MatrixT, typename VectorT, typename PreconditionerT>
 VectorT solve(MatrixT const & matrix, VectorT const & rhs, bicgstab_tag const & tag, PreconditionerT const & precond)
 {
-  typedef typename viennacl::result_of::value_type<VectorT>::type            NumericType;
-  typedef typename viennacl::result_of::cpu_value_type<NumericType>::type    CPU_NumericType;
-  VectorT result = rhs;
-  viennacl::traits::clear(result);
-
-  VectorT residual = rhs;
-  VectorT r0star = residual;  //can be chosen arbitrarily in fact
-  VectorT tmp0 = rhs;
-  VectorT tmp1 = rhs;
-  VectorT s = rhs;
-
-  VectorT p = residual;
-
-  CPU_NumericType ip_rr0star = viennacl::linalg::norm_2(residual);
-  CPU_NumericType norm_rhs_host = viennacl::linalg::norm_2(residual);
-  CPU_NumericType beta;
-  CPU_NumericType alpha;
-  CPU_NumericType omega;
-  CPU_NumericType new_ip_rr0star = 0;
-  CPU_NumericType residual_norm = norm_rhs_host;
-
-  if (!norm_rhs_host) //solution is zero if RHS norm is zero
-    return result;
+  return detail::pbicgstab_solve(matrix, rhs, tag, precond, static_cast<VectorT const *>(NULL));
+}
+
+/** @brief Preconditioned stabilized Bi-conjugate gradient solver starting from the given initial guess.
+*
+* @param matrix         The system matrix
+* @param rhs            The load vector
+* @param tag            Solver configuration tag
+* @param precond        A preconditioner. Precondition operation is done via member function apply()
+* @param initial_guess  The initial guess, e.g. the solution of the previous time step
+* @return The result vector
+*/
+template<typename MatrixT, typename VectorT, typename PreconditionerT>
+VectorT solve(MatrixT const & matrix, VectorT const & rhs, bicgstab_tag const & tag, PreconditionerT const & precond, VectorT const & initial_guess)
+{
+  return detail::pbicgstab_solve(matrix, rhs, tag, precond, &initial_guess);
+}
 
-  bool restart_flag = true;
-  vcl_size_t last_restart = 0;
-  for (unsigned int i = 0; i < tag.max_iterations(); ++i)
+namespace detail
+{
+
+  /** @brief Implementation of the preconditioned stabilized Bi-conjugate gradient solver for multiple right hand sides, given as the columns of a dense matrix.
+  *
+  * Each column is iterated independently as in the single right hand side case, but the products with the system matrix
+  * are carried out for all columns at once (sparse matrix times dense matrix), so the system matrix is read only twice per iteration.
+  * Columns which have already converged are no longer updated. The estimated relative error stored in the tag is the maximum over all columns.
+  */
+  template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV, typename PreconditionerT>
+  viennacl::matrix<NumericT, F, AlignmentV> solve_multi_rhs(MatrixT const & matrix, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, bicgstab_tag const & tag, PreconditionerT const & precond,
+                                                            viennacl::matrix<NumericT, F, AlignmentV> const * initial_guess)
   {
-    if (restart_flag)
+    typedef viennacl::matrix<NumericT, viennacl::column_major>   DenseMatrixType;   // column-major, so that the columns are contiguous in memory
+
+    vcl_size_t num_rhs = rhs.size2();
+
+    DenseMatrixType B = detail::multi_rhs_convert<DenseMatrixType>(rhs);
+    DenseMatrixType result(rhs.size1(), num_rhs, viennacl::traits::context(rhs));
+    result.clear();
+
+    DenseMatrixType residual(B);
+    DenseMatrixType r0star(B);
+    DenseMatrixType p(B);
+    DenseMatrixType s(B);
+    DenseMatrixType tmp0(B);
+    DenseMatrixType tmp1(B);
+    viennacl::vector<NumericT> precond_tmp(rhs.size1(), viennacl::traits::context(rhs));
+
+    std::vector<NumericT> norm_rhs_host;
+    detail::multi_rhs_column_norms(B, norm_rhs_host);
+
+    std::vector<NumericT>   ip_rr0star(num_rhs);
+    std::vector<NumericT>   alpha(num_rhs);
+    std::vector<NumericT>   rel_error(num_rhs, NumericT(0));
+    std::vector<bool>       active(num_rhs);
+    std::vector<bool>       restart_flag(num_rhs, true);
+    std::vector<vcl_size_t> last_restart(num_rhs, 0);
+
+    vcl_size_t num_active = 0;
+    for (vcl_size_t j = 0; j < num_rhs; ++j)
     {
-      residual = rhs;
-      residual -= viennacl::linalg::prod(matrix, result);
-      precond.apply(residual);
-      p = residual;
-      r0star = residual;
-      ip_rr0star = viennacl::linalg::norm_2(residual);
-      ip_rr0star *= ip_rr0star;
-      restart_flag = false;
-      last_restart = i;
+      active[j] = (norm_rhs_host[j] > 0); //solution is zero if RHS norm is zero
+      if (active[j])
+        ++num_active;
     }
 
-    tag.iters(i+1);
-    tmp0 = viennacl::linalg::prod(matrix, p);
-    precond.apply(tmp0);
-    alpha = ip_rr0star / viennacl::linalg::inner_prod(tmp0, r0star);
-
-    s = residual - alpha*tmp0;
-
-    tmp1 = viennacl::linalg::prod(matrix, s);
-    precond.apply(tmp1);
-    CPU_NumericType norm_tmp1 = viennacl::linalg::norm_2(tmp1);
-    omega = viennacl::linalg::inner_prod(tmp1, s) / (norm_tmp1 * norm_tmp1);
+    tag.clear_residual_history();
+    if (initial_guess) // the residuals are computed from the initial guesses at the first (re)start
+    {
+      DenseMatrixType initial_guess_colmajor = detail::multi_rhs_convert<DenseMatrixType>(*initial_guess);
+      for (vcl_size_t j = 0; j < num_rhs; ++j)
+        if (active[j])
+          detail::multi_rhs_column<NumericT>(result, j) = detail::multi_rhs_column<NumericT>(initial_guess_colmajor, j);
+    }
 
-    result += alpha * p + omega * s;
-    residual = s - omega * tmp1;
+    for (vcl_size_t i = 0; i < tag.max_iterations() && num_active > 0; ++i)
+    {
+      // (re-)initialize the residuals of all columns flagged for a restart with a single product with the system matrix:
+      std::vector<bool> restart_columns(num_rhs, false);
+      bool any_restart = false;
+      for (vcl_size_t j = 0; j < num_rhs; ++j)
+      {
+        restart_columns[j] = active[j] && restart_flag[j];
+        any_restart = any_restart || restart_columns[j];
+      }
+
+      if (any_restart)
+      {
+        detail::multi_rhs_prod(matrix, result, tmp0);
+        for (vcl_size_t j = 0; j < num_rhs; ++j)
+          if (restart_columns[j])
+            detail::multi_rhs_column<NumericT>(residual, j) = detail::multi_rhs_column<NumericT>(B, j) - detail::multi_rhs_column<NumericT>(tmp0, j);
+        detail::multi_rhs_precond_apply(precond, residual, restart_columns, precond_tmp);
+
+        for (vcl_size_t j = 0; j < num_rhs; ++j)
+        {
+          if (!restart_columns[j])
+            continue;
+
+          detail::multi_rhs_column<NumericT> residual_j(residual, j);
+          detail::multi_rhs_column<NumericT>(p, j) = residual_j;
+          detail::multi_rhs_column<NumericT>(r0star, j) = residual_j;
+          ip_rr0star[j] = viennacl::linalg::norm_2(residual_j);
+          ip_rr0star[j] *= ip_rr0star[j];
+          restart_flag[j] = false;
+          last_restart[j] = i;
+
+          if (ip_rr0star[j] == 0) //exact solution, e.g. from the initial guess
+          {
+            rel_error[j] = 0;
+            active[j] = false;
+            --num_active;
+          }
+        }
+
+        if (num_active == 0)
+        {
+          tag.iters(static_cast<unsigned int>(i));
+          break;
+        }
+      }
+
+      tag.iters(i+1);
+      detail::multi_rhs_prod(matrix, p, tmp0);
+      detail::multi_rhs_precond_apply(precond, tmp0, active, precond_tmp);
+
+      for (vcl_size_t j = 0; j < num_rhs; ++j)
+      {
+        if (!active[j])
+          continue;
+
+        detail::multi_rhs_column<NumericT> tmp0_j(tmp0, j);
+        alpha[j] = ip_rr0star[j] / viennacl::linalg::inner_prod(tmp0_j, detail::multi_rhs_column<NumericT>(r0star, j));
+        detail::multi_rhs_column<NumericT>(s, j) = detail::multi_rhs_column<NumericT>(residual, j) - alpha[j] * tmp0_j;
+      }
+
+      detail::multi_rhs_prod(matrix, s, tmp1);
+      detail::multi_rhs_precond_apply(precond, tmp1, active, precond_tmp);
+
+      for (vcl_size_t j = 0; j < num_rhs; ++j)
+      {
+        if (!active[j])
+          continue;
+
+        detail::multi_rhs_column<NumericT> result_j(result, j);
+        detail::multi_rhs_column<NumericT> residual_j(residual, j);
+        detail::multi_rhs_column<NumericT> p_j(p, j);
+        detail::multi_rhs_column<NumericT> s_j(s, j);
+        detail::multi_rhs_column<NumericT> tmp0_j(tmp0, j);
+        detail::multi_rhs_column<NumericT> tmp1_j(tmp1, j);
+
+        NumericT norm_tmp1 = viennacl::linalg::norm_2(tmp1_j);
+        NumericT omega = viennacl::linalg::inner_prod(tmp1_j, s_j) / (norm_tmp1 * norm_tmp1);
+
+        result_j += alpha[j] * p_j + omega * s_j;
+        residual_j = s_j - omega * tmp1_j;
+
+        rel_error[j] = viennacl::linalg::norm_2(residual_j) / norm_rhs_host[j];
+        if (rel_error[j] < tag.tolerance())
+        {
+          active[j] = false;
+          --num_active;
+          continue;
+        }
+
+        NumericT new_ip_rr0star = viennacl::linalg::inner_prod(residual_j, detail::multi_rhs_column<NumericT>(r0star, j));
+
+        NumericT beta = new_ip_rr0star / ip_rr0star[j] * alpha[j] / omega;
+        ip_rr0star[j] = new_ip_rr0star;
+
+        if (!ip_rr0star[j] || !omega || i - last_restart[j] > tag.max_iterations_before_restart()) //search direction degenerate. A restart might help
+          restart_flag[j] = true;
+
+        // Execution of
+        //  p = residual + beta * (p - omega*tmp0);
+        // without introducing temporary vectors:
+        p_j -= omega * tmp0_j;
+        p_j = residual_j + beta * p_j;
+      }
+
+      tag.record_residual(*std::max_element(rel_error.begin(), rel_error.end()));
+    }
 
-    residual_norm = viennacl::linalg::norm_2(residual);
-    if (residual_norm / norm_rhs_host < tag.tolerance())
-      break;
+    //store last error estimate:
+    tag.error(rel_error.size() > 0 ? *std::max_element(rel_error.begin(), rel_error.end()) : 0);
 
-    new_ip_rr0star = viennacl::linalg::inner_prod(residual, r0star);
+    return detail::multi_rhs_convert<viennacl::matrix<NumericT, F, AlignmentV> >(result);
+  }
 
-    beta = new_ip_rr0star / ip_rr0star * alpha/omega;
-    ip_rr0star = new_ip_rr0star;
+}
 
-    if (!ip_rr0star || !omega || i - last_restart > tag.max_iterations_before_restart()) //search direction degenerate. A restart might help
-      restart_flag = true;
+/** @brief Stabilized Bi-conjugate gradient solver for multiple right hand sides (one per column of 'rhs'), all sharing the products with the system matrix.
+*
+* @param matrix     The system matrix
+* @param rhs        The right hand sides, one per column
+* @param tag        Solver configuration tag
+* @param precond    A preconditioner. Precondition operation is done via member function apply()
+* @return The matrix of result vectors
+*/
+template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV, typename PreconditionerT>
+viennacl::matrix<NumericT, F, AlignmentV> solve(MatrixT const & matrix, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, bicgstab_tag const & tag, PreconditionerT const & precond)
+{
+  return detail::solve_multi_rhs(matrix, rhs, tag, precond, static_cast<viennacl::matrix<NumericT, F, AlignmentV> const *>(NULL));
+}
 
-    // Execution of
-    //  p = residual + beta * (p - omega*tmp0);
-    // without introducing temporary vectors:
-    p -= omega * tmp0;
-    p = residual + beta * p;
+/** @brief Stabilized Bi-conjugate gradient solver for multiple right hand sides (one per column) starting from the given initial guesses.
+*
+* @param matrix         The system matrix
+* @param rhs            The right hand sides, one per column
+* @param tag            Solver configuration tag
+* @param precond        A preconditioner. Precondition operation is done via member function apply()
+* @param initial_guess  The initial guesses, one per column
+* @return The matrix of result vectors
+*/
+template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV, typename PreconditionerT>
+viennacl::matrix<NumericT, F, AlignmentV> solve(MatrixT const & matrix, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, bicgstab_tag const & tag, PreconditionerT const & precond,
+                                                viennacl::matrix<NumericT, F, AlignmentV> const & initial_guess)
+{
+  return detail::solve_multi_rhs(matrix, rhs, tag, precond, &initial_guess);
+}
 
-    //std::cout << "Rel. Residual in current step: " << std::sqrt(std::fabs(viennacl::linalg::inner_prod(residual, residual) / norm_rhs_host)) << std::endl;
-  }
+template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV>
+viennacl::matrix<NumericT, F, AlignmentV> solve(MatrixT const & matrix, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, bicgstab_tag const & tag, viennacl::linalg::no_precond,
+                                                viennacl::matrix<NumericT, F, AlignmentV> const & initial_guess)
+{
+  return detail::solve_multi_rhs(matrix, rhs, tag, viennacl::linalg::no_precond(), &initial_guess);
+}
 
-  //store last error estimate:
-  tag.error(residual_norm / norm_rhs_host);
+template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV>
+viennacl::matrix<NumericT, F, AlignmentV> solve(MatrixT const & matrix, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, bicgstab_tag const & tag, viennacl::linalg::no_precond)
+{
+  return detail::solve_multi_rhs(matrix, rhs, tag, viennacl::linalg::no_precond(), static_cast<viennacl::matrix<NumericT, F, AlignmentV> const *>(NULL));
+}
 
-  return result;
+template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV>
+viennacl::matrix<NumericT, F, AlignmentV> solve(MatrixT const & matrix, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, bicgstab_tag const & tag)
+{
+  return detail::solve_multi_rhs(matrix, rhs, tag, viennacl::linalg::no_precond(), static_cast<viennacl::matrix<NumericT, F, AlignmentV> const *>(NULL));
 }
 
 }
@@ -0,0 +1,333 @@
+#ifndef VIENNACL_LINALG_BICGSTABL_HPP_
+#define VIENNACL_LINALG_BICGSTABL_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file bicgstabl.hpp
+    @brief The BiCGStab(l) method is implemented here
+*/
+
+#include <vector>
+#include <cmath>
+
+#include "viennacl/forwards.h"
+#include "viennacl/linalg/detail/residual_history.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/traits/context.hpp"
+#include "viennacl/linalg/detail/multi_vector.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for the BiCGStab(l) solver. Used for supplying solver parameters and for dispatching the solve() function
+*
+* The residual history records the relative residual after each cycle of l iterations.
+*/
+class bicgstabl_tag : public detail::residual_history_recorder
+{
+public:
+  /** @brief The constructor
+  *
+  * @param tol              Relative tolerance for the residual (solver quits if ||r|| < tol * ||rhs||)
+  * @param max_iters        The maximum number of iterations. Each iteration requires two products with the system matrix, as for BiCGStab.
+  * @param l                Degree of the minimal residual polynomial. l = 1 is mathematically equivalent to BiCGStab, l = 2 or l = 4 are more robust for strongly nonsymmetric problems.
+  */
+  bicgstabl_tag(double tol = 1e-8, vcl_size_t max_iters = 400, vcl_size_t l = 2)
+    : tol_(tol), iterations_(max_iters), l_(l > 0 ? l : 1) {}
+
+  /** @brief Returns the relative tolerance */
+  double tolerance() const { return tol_; }
+  /** @brief Returns the maximum number of iterations */
+  vcl_size_t max_iterations() const { return iterations_; }
+  /** @brief Returns the degree of the minimal residual polynomial */
+  vcl_size_t l() const { return l_; }
+
+  /** @brief Return the number of solver iterations: */
+  vcl_size_t iters() const { return iters_taken_; }
+  void iters(vcl_size_t i) const { iters_taken_ = i; }
+
+  /** @brief Returns the estimated relative error at the end of the solver run */
+  double error() const { return last_error_; }
+  /** @brief Sets the estimated relative error at the end of the solver run */
+  void error(double e) const { last_error_ = e; }
+
+private:
+  double tol_;
+  vcl_size_t iterations_;
+  vcl_size_t l_;
+
+  //return values from solver
+  mutable vcl_size_t iters_taken_;
+  mutable double last_error_;
+};
+
+
+namespace detail
+{
+
+  /** @brief Solves the small dense system A x = b (row-major, n x n) by Gaussian elimination with partial pivoting, overwriting b with x. Components belonging to zero pivots are set to zero. */
+  template<typename NumericT>
+  void bicgstabl_small_solve(std::vector<NumericT> & A, std::vector<NumericT> & b, vcl_size_t n)
+  {
+    for (vcl_size_t k = 0; k < n; ++k)
+    {
+      vcl_size_t pivot_row = k;
+      for (vcl_size_t i = k + 1; i < n; ++i)
+        if (std::fabs(A[i * n + k]) > std::fabs(A[pivot_row * n + k]))
+          pivot_row = i;
+      if (pivot_row != k)
+      {
+        for (vcl_size_t j = 0; j < n; ++j)
+          std::swap(A[k * n + j], A[pivot_row * n + j]);
+        std::swap(b[k], b[pivot_row]);
+      }
+      if (A[k * n + k] == 0)
+        continue;
+      for (vcl_size_t i = k + 1; i < n; ++i)
+      {
+        NumericT factor = A[i * n + k] / A[k * n + k];
+        for (vcl_size_t j = k; j < n; ++j)
+          A[i * n + j] -= factor * A[k * n + j];
+        b[i] -= factor * b[k];
+      }
+    }
+
+    for (vcl_size_t i2 = 0; i2 < n; ++i2)
+    {
+      vcl_size_t i = n - i2 - 1;
+      if (A[i * n + i] == 0)
+      {
+        b[i] = 0;
+        continue;
+      }
+      for (vcl_size_t j = i + 1; j < n; ++j)
+        b[i] -= A[i * n + j] * b[j];
+      b[i] /= A[i * n + i];
+    }
+  }
+
+  /** @brief Implementation of the right-preconditioned BiCGStab(l) solver.
+  *
+  * Follows G. L. G. Sleijpen and D. R. Fokkema, "BiCGstab(l) for linear equations involving unsymmetric matrices with complex spectrum", ETNA 1, 1993.
+  * The minimal residual part does not use modified Gram-Schmidt, but computes the Gram matrix of the l+1 residual vectors in a single pass over memory
+  * and solves the normal equations on the host. All updates of the l+1 residual and search vectors are fused into single passes over memory.
+  *
+  * @param A              The system matrix
+  * @param rhs            The load vector
+  * @param tag            Solver configuration tag
+  * @param precond        A preconditioner. Precondition operation is done via member function apply()
+  * @param initial_guess  Pointer to the initial guess. A zero initial guess is used if NULL.
+  * @return The result vector
+  */
+  template<typename MatrixT, typename NumericT, typename PreconditionerT>
+  viennacl::vector<NumericT> bicgstabl_solve(MatrixT const & A,
+                                             viennacl::vector<NumericT> const & rhs,
+                                             bicgstabl_tag const & tag,
+                                             PreconditionerT const & precond,
+                                             viennacl::vector<NumericT> const * initial_guess)
+  {
+    vcl_size_t size = rhs.size();
+    vcl_size_t l = tag.l();
+    viennacl::context ctx = viennacl::traits::context(rhs);
+
+    viennacl::vector<NumericT> result = viennacl::zero_vector<NumericT>(size, ctx);
+
+    tag.iters(0);
+    tag.clear_residual_history();
+
+    NumericT norm_rhs = viennacl::linalg::norm_2(rhs);
+    if (norm_rhs <= 0) //solution is zero if RHS norm is zero
+    {
+      tag.error(0);
+      return result;
+    }
+
+    // residual vectors r_0, ..., r_l and search vectors u_0, ..., u_l. r_j and u_j hold (A precond^{-1})^j applied to r_0 and u_0 up to the current step.
+    std::vector< viennacl::vector<NumericT> > r(l + 1, viennacl::vector<NumericT>(size, ctx));
+    std::vector< viennacl::vector<NumericT> > u(l + 1, viennacl::vector<NumericT>(size, ctx));
+    r[0] = rhs;
+    if (initial_guess)
+    {
+      result = *initial_guess;
+      r[0] -= viennacl::linalg::prod(A, result);
+    }
+    u[0].clear();
+
+    viennacl::vector<NumericT> r0star = r[0];       // shadow residual
+    viennacl::vector<NumericT> correction = viennacl::zero_vector<NumericT>(size, ctx); // solution update before the preconditioner is applied
+    viennacl::vector<NumericT> precond_temp(size, ctx);
+
+    std::vector<viennacl::vector_base<NumericT> const *> r0star_pointer(1, &r0star);
+    viennacl::vector_tuple<NumericT> r0star_tuple(r0star_pointer);
+
+    std::vector<NumericT> inner_prods(2);
+    std::vector<NumericT> gram;
+    std::vector<NumericT> normal_matrix(l * l);
+    std::vector<NumericT> gamma(l);
+
+    NumericT norm_r = viennacl::linalg::norm_2(r[0]);
+    NumericT rho0  = 1;
+    NumericT alpha = 0;
+    NumericT omega = 1;
+    vcl_size_t iters = 0;
+
+    while (norm_r > tag.tolerance() * norm_rhs && iters < tag.max_iterations())
+    {
+      rho0 = -omega * rho0;
+
+      //
+      // BiCG part
+      //
+      bool breakdown = false;
+      for (vcl_size_t j = 0; j < l; ++j)
+      {
+        detail::multi_vector_inner_prod(r0star_tuple, r[j], inner_prods);
+        NumericT rho1 = inner_prods[0];
+        if (rho0 == 0)
+        {
+          breakdown = true;
+          break;
+        }
+        NumericT beta = alpha * rho1 / rho0;
+        rho0 = rho1;
+
+        // u_i = r_i - beta * u_i for i = 0, ..., j
+        detail::multi_vector_axpby(detail::multi_vector_tuple(u, 0, j + 1), NumericT(1), detail::multi_vector_tuple(r, 0, j + 1), -beta);
+
+        detail::multi_vector_precond_prod(A, precond, u[j], u[j+1], precond_temp);
+        detail::multi_vector_inner_prod(r0star_tuple, u[j+1], inner_prods);
+        NumericT gamma_bicg = inner_prods[0];
+        if (gamma_bicg == 0)
+        {
+          breakdown = true;
+          break;
+        }
+        alpha = rho0 / gamma_bicg;
+
+        // r_i -= alpha * u_{i+1} for i = 0, ..., j
+        detail::multi_vector_axpby(detail::multi_vector_tuple(r, 0, j + 1), -alpha, detail::multi_vector_tuple(u, 1, j + 1), NumericT(1));
+
+        detail::multi_vector_precond_prod(A, precond, r[j], r[j+1], precond_temp);
+        correction += alpha * u[0];
+        ++iters;
+      }
+
+      if (breakdown)
+        break;
+
+      //
+      // Minimal residual part: minimize ||r_0 - sum_{j=1}^{l} gamma_j r_j|| via the normal equations
+      //
+      detail::multi_vector_gram_matrix(detail::multi_vector_tuple(r, 0, l + 1), gram);
+      for (vcl_size_t i = 0; i < l; ++i)
+      {
+        for (vcl_size_t j = 0; j < l; ++j)
+          normal_matrix[i * l + j] = gram[(i + 1) * (l + 1) + j + 1];
+        gamma[i] = gram[(i + 1) * (l + 1)];
+      }
+      detail::bicgstabl_small_solve(normal_matrix, gamma, l);
+      omega = gamma[l - 1];
+
+      // u_0 -= sum_j gamma_j u_j,  x += sum_j gamma_j r_{j-1},  r_0 -= sum_j gamma_j r_j
+      detail::multi_vector_update(u[0], detail::multi_vector_tuple(u, 1, l), gamma);
+      for (vcl_size_t i = 0; i < l; ++i)
+        gamma[i] = -gamma[i];
+      detail::multi_vector_update(correction, detail::multi_vector_tuple(r, 0, l), gamma);
+      for (vcl_size_t i = 0; i < l; ++i)
+        gamma[i] = -gamma[i];
+      norm_r = std::sqrt(detail::multi_vector_update(r[0], detail::multi_vector_tuple(r, 1, l), gamma));
+
+      tag.record_residual(norm_r / norm_rhs);
+      if (omega == 0 || norm_r != norm_r)
+        break;
+
+      // the recursively updated residual may drift away from the true residual. Verify convergence and restart from the true residual if necessary.
+      if (norm_r <= tag.tolerance() * norm_rhs)
+      {
+        precond.apply(correction);
+        result += correction;
+        correction.clear();
+
+        r[0] = rhs;
+        r[0] -= viennacl::linalg::prod(A, result);
+        norm_r = viennacl::linalg::norm_2(r[0]);
+
+        r0star = r[0];
+        u[0].clear();
+        rho0  = 1;
+        alpha = 0;
+        omega = 1;
+      }
+    }
+
+    precond.apply(correction);
+    result += correction;
+
+    tag.iters(iters);
+    tag.error(norm_r / norm_rhs);
+
+    return result;
+  }
+
+}
+
+/** @brief Implementation of the preconditioned BiCGStab(l) solver
+*
+* @param A          The system matrix
+* @param rhs        The load vector
+* @param tag        Solver configuration tag
+* @param precond    A preconditioner. Precondition operation is done via member function apply()
+* @return The result vector
+*/
+template<typename MatrixT, typename NumericT, typename PreconditionerT>
+viennacl::vector<NumericT> solve(MatrixT const & A, viennacl::vector<NumericT> const & rhs, bicgstabl_tag const & tag, PreconditionerT const & precond)
+{
+  return detail::bicgstabl_solve(A, rhs, tag, precond, static_cast<viennacl::vector<NumericT> const *>(NULL));
+}
+
+/** @brief Implementation of the BiCGStab(l) solver without preconditioner */
+template<typename MatrixT, typename NumericT>
+viennacl::vector<NumericT> solve(MatrixT const & A, viennacl::vector<NumericT> const & rhs, bicgstabl_tag const & tag)
+{
+  return detail::bicgstabl_solve(A, rhs, tag, viennacl::linalg::no_precond(), static_cast<viennacl::vector<NumericT> const *>(NULL));
+}
+
+/** @brief Preconditioned BiCGStab(l) solver starting from the given initial guess. The relative tolerance refers to the norm of the right hand side.
+*
+* @param A              The system matrix
+* @param rhs            The load vector
+* @param tag            Solver configuration tag
+* @param precond        A preconditioner. Precondition operation is done via member function apply()
+* @param initial_guess  The initial guess, e.g. the solution of the previous time step
+* @return The result vector
+*/
+template<typename MatrixT, typename NumericT, typename PreconditionerT>
+viennacl::vector<NumericT> solve(MatrixT const & A, viennacl::vector<NumericT> const & rhs, bicgstabl_tag const & tag, PreconditionerT const & precond,
+                                 viennacl::vector<NumericT> const & initial_guess)
+{
+  return detail::bicgstabl_solve(A, rhs, tag, precond, &initial_guess);
+}
+
+}
+}
+
+#endif
@@ -26,8 +26,11 @@
 #include <map>
 #include <cmath>
 #include <numeric>
+#include <limits>
+#include <algorithm>
 
 #include "viennacl/forwards.h"
+#include "viennacl/linalg/detail/residual_history.hpp"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/ilu.hpp"
 #include "viennacl/linalg/prod.hpp"
@@ -37,6 +40,7 @@
 #include "viennacl/traits/size.hpp"
 #include "viennacl/meta/result_of.hpp"
 #include "viennacl/linalg/iterative_operations.hpp"
+#include "viennacl/linalg/detail/multi_rhs.hpp"
 
 namespace viennacl
 {
@@ -45,7 +49,7 @@ namespace linalg
 
 /** @brief A tag for the conjugate gradient Used for supplying solver parameters and for dispatching the solve() function
 */
-class cg_tag
+class cg_tag : public detail::residual_history_recorder
 {
 public:
   /** @brief The constructor
@@ -69,7 +73,6 @@ public:
   /** @brief Sets the estimated relative error at the end of the solver run */
   void error(double e) const { last_error_ = e; }
 
-
 private:
   double tol_;
   unsigned int iterations_;
@@ -103,6 +106,93 @@ namespace detail
 
 }
 
+namespace detail
+{
+
+  /** @brief Implementation of the standard conjugate gradient algorithm (no preconditioner), specialized for ViennaCL types.
+  *
+  * Pipelined version from A. T. Chronopoulos and C. W. Gear, J. Comput. Appl. Math. 25(2), 153–168 (1989)
+  *
+  * @param A              The system matrix
+  * @param rhs            The load vector
+  * @param tag            Solver configuration tag
+  * @param initial_guess  Pointer to the initial guess. A zero initial guess is used if NULL.
+  * @return The result vector
+  */
+  template<typename MatrixT, typename NumericT>
+  viennacl::vector<NumericT> pipelined_cg_solve(MatrixT const & A,
+                                                viennacl::vector<NumericT> const & rhs,
+                                                cg_tag const & tag,
+                                                viennacl::vector<NumericT> const * initial_guess)
+  {
+    viennacl::vector<NumericT> result(rhs);
+    viennacl::traits::clear(result);
+
+    tag.clear_residual_history();
+
+    viennacl::vector<NumericT> residual(rhs);
+    NumericT norm_rhs_squared = viennacl::linalg::norm_2(residual); norm_rhs_squared *= norm_rhs_squared;
+
+    if (!norm_rhs_squared) //check for early convergence of A*x = 0
+      return result;
+
+    NumericT inner_prod_rr = norm_rhs_squared;
+    if (initial_guess)
+    {
+      result = *initial_guess;
+      residual -= viennacl::linalg::prod(A, result);
+      inner_prod_rr = viennacl::linalg::norm_2(residual); inner_prod_rr *= inner_prod_rr;
+
+      if (std::fabs(inner_prod_rr / norm_rhs_squared) < tag.tolerance() *  tag.tolerance()) //initial guess is accurate enough
+      {
+        tag.iters(0);
+        tag.error(std::sqrt(std::fabs(inner_prod_rr) / norm_rhs_squared));
+        return result;
+      }
+    }
+
+    viennacl::vector<NumericT> p(residual);
+    viennacl::vector<NumericT> Ap = viennacl::linalg::prod(A, p);
+    viennacl::vector<NumericT> inner_prod_buffer = viennacl::zero_vector<NumericT>(3*256, viennacl::traits::context(rhs)); // temporary buffer
+    std::vector<NumericT>      host_inner_prod_buffer(inner_prod_buffer.size());
+    std::size_t                buffer_size_per_vector = inner_prod_buffer.size() / 3;
+
+    NumericT alpha = inner_prod_rr / viennacl::linalg::inner_prod(p, Ap);
+    NumericT beta  = viennacl::linalg::norm_2(Ap); beta = (alpha * alpha * beta * beta - inner_prod_rr) / inner_prod_rr;
+    NumericT inner_prod_ApAp = 0;
+    NumericT inner_prod_pAp  = 0;
+
+    for (unsigned int i = 0; i < tag.max_iterations(); ++i)
+    {
+      tag.iters(i+1);
+
+      viennacl::linalg::pipelined_cg_vector_update(result, alpha, p, residual, Ap, beta, inner_prod_buffer);
+      viennacl::linalg::pipelined_cg_prod(A, p, Ap, inner_prod_buffer);
+
+      // bring back the partial results to the host:
+      viennacl::fast_copy(inner_prod_buffer.begin(), inner_prod_buffer.end(), host_inner_prod_buffer.begin());
+
+      inner_prod_rr   = std::accumulate(host_inner_prod_buffer.begin(),                              host_inner_prod_buffer.begin() +     buffer_size_per_vector, NumericT(0));
+      inner_prod_ApAp = std::accumulate(host_inner_prod_buffer.begin() +     buffer_size_per_vector, host_inner_prod_buffer.begin() + 2 * buffer_size_per_vector, NumericT(0));
+      inner_prod_pAp  = std::accumulate(host_inner_prod_buffer.begin() + 2 * buffer_size_per_vector, host_inner_prod_buffer.begin() + 3 * buffer_size_per_vector, NumericT(0));
+
+      tag.record_residual(std::sqrt(std::fabs(inner_prod_rr) / norm_rhs_squared));
+
+      if (std::fabs(inner_prod_rr / norm_rhs_squared) < tag.tolerance() *  tag.tolerance())    //squared norms involved here
+        break;
+
+      alpha = inner_prod_rr / inner_prod_pAp;
+      beta  = (alpha*alpha*inner_prod_ApAp - inner_prod_rr) / inner_prod_rr;
+    }
+
+    //store last error estimate:
+    tag.error(std::sqrt(std::fabs(inner_prod_rr) / norm_rhs_squared));
+
+    return result;
+  }
+
+}
+
 /** @brief Implementation of the standard conjugate gradient algorithm (no preconditioner), specialized for ViennaCL types.
 *
 * Pipelined version from A. T. Chronopoulos and C. W. Gear, J. Comput. Appl. Math. 25(2), 153–168 (1989)
@@ -110,62 +200,130 @@ namespace detail
 * @param A          The system matrix
 * @param rhs        The load vector
 * @param tag        Solver configuration tag
-* @param precond    A preconditioner. Precondition operation is done via member function apply()
 * @return The result vector
 */
-//template<typename MatrixType, typename ScalarType>
 template<typename MatrixT, typename NumericT>
-viennacl::vector<NumericT> solve(MatrixT const & A, //MatrixType const & A,
+viennacl::vector<NumericT> solve(MatrixT const & A,
                                  viennacl::vector<NumericT> const & rhs,
                                  cg_tag const & tag,
                                  viennacl::linalg::no_precond)
 {
-  viennacl::vector<NumericT> result(rhs);
-  viennacl::traits::clear(result);
-
-  viennacl::vector<NumericT> residual(rhs);
-  viennacl::vector<NumericT> p(rhs);
-  viennacl::vector<NumericT> Ap = viennacl::linalg::prod(A, p);
-  viennacl::vector<NumericT> inner_prod_buffer = viennacl::zero_vector<NumericT>(3*256, viennacl::traits::context(rhs)); // temporary buffer
-  std::vector<NumericT>      host_inner_prod_buffer(inner_prod_buffer.size());
-  std::size_t                buffer_size_per_vector = inner_prod_buffer.size() / 3;
-
-  NumericT norm_rhs_squared = viennacl::linalg::norm_2(residual); norm_rhs_squared *= norm_rhs_squared;
+  return detail::pipelined_cg_solve(A, rhs, tag, static_cast<viennacl::vector<NumericT> const *>(NULL));
+}
 
-  if (!norm_rhs_squared) //check for early convergence of A*x = 0
-    return result;
+/** @brief Pipelined conjugate gradient algorithm (no preconditioner) starting from the given initial guess. The relative tolerance refers to the norm of the right hand side.
+*
+* @param A              The system matrix
+* @param rhs            The load vector
+* @param tag            Solver configuration tag
+* @param initial_guess  The initial guess, e.g. the solution of the previous time step
+* @return The result vector
+*/
+template<typename MatrixT, typename NumericT>
+viennacl::vector<NumericT> solve(MatrixT const & A,
+                                 viennacl::vector<NumericT> const & rhs,
+                                 cg_tag const & tag,
+                                 viennacl::linalg::no_precond,
+                                 viennacl::vector<NumericT> const & initial_guess)
+{
+  return detail::pipelined_cg_solve(A, rhs, tag, &initial_guess);
+}
 
-  NumericT inner_prod_rr = norm_rhs_squared;
-  NumericT alpha = inner_prod_rr / viennacl::linalg::inner_prod(p, Ap);
-  NumericT beta  = viennacl::linalg::norm_2(Ap); beta = (alpha * alpha * beta * beta - inner_prod_rr) / inner_prod_rr;
-  NumericT inner_prod_ApAp = 0;
-  NumericT inner_prod_pAp  = 0;
+namespace detail
+{
 
-  for (unsigned int i = 0; i < tag.max_iterations(); ++i)
+  /** @brief Implementation of the preconditioned conjugate gradient solver, generic implementation for non-ViennaCL types.
+  *
+  * Following Algorithm 9.1 in "Iterative Methods for Sparse Linear Systems" by Y. Saad
+  *
+  * @param matrix         The system matrix
+  * @param rhs            The load vector
+  * @param tag            Solver configuration tag
+  * @param precond        A preconditioner. Precondition operation is done via member function apply()
+  * @param initial_guess  Pointer to the initial guess. A zero initial guess is used if NULL.
+  * @return The result vector
+  */
+  template<typename MatrixT, typename VectorT, typename PreconditionerT>
+  VectorT pcg_solve(MatrixT const & matrix, VectorT const & rhs, cg_tag const & tag, PreconditionerT const & precond, VectorT const * initial_guess)
   {
-    tag.iters(i+1);
+    typedef typename viennacl::result_of::value_type<VectorT>::type           NumericType;
+    typedef typename viennacl::result_of::cpu_value_type<NumericType>::type   CPU_NumericType;
 
-    viennacl::linalg::pipelined_cg_vector_update(result, alpha, p, residual, Ap, beta, inner_prod_buffer);
-    viennacl::linalg::pipelined_cg_prod(A, p, Ap, inner_prod_buffer);
+    VectorT result = rhs;
+    viennacl::traits::clear(result);
 
-    // bring back the partial results to the host:
-    viennacl::fast_copy(inner_prod_buffer.begin(), inner_prod_buffer.end(), host_inner_prod_buffer.begin());
+    tag.clear_residual_history();
 
-    inner_prod_rr   = std::accumulate(host_inner_prod_buffer.begin(),                              host_inner_prod_buffer.begin() +     buffer_size_per_vector, NumericT(0));
-    inner_prod_ApAp = std::accumulate(host_inner_prod_buffer.begin() +     buffer_size_per_vector, host_inner_prod_buffer.begin() + 2 * buffer_size_per_vector, NumericT(0));
-    inner_prod_pAp  = std::accumulate(host_inner_prod_buffer.begin() + 2 * buffer_size_per_vector, host_inner_prod_buffer.begin() + 3 * buffer_size_per_vector, NumericT(0));
+    VectorT residual = rhs;
+    VectorT tmp = rhs;
+    detail::z_handler<VectorT, PreconditionerT> zhandler(residual);
+    VectorT & z = zhandler.get();
 
-    if (std::fabs(inner_prod_rr / norm_rhs_squared) < tag.tolerance() *  tag.tolerance())    //squared norms involved here
-      break;
+    precond.apply(z);
 
-    alpha = inner_prod_rr / inner_prod_pAp;
-    beta  = (alpha*alpha*inner_prod_ApAp - inner_prod_rr) / inner_prod_rr;
-  }
+    CPU_NumericType ip_rr = viennacl::linalg::inner_prod(residual, z);
+    CPU_NumericType alpha;
+    CPU_NumericType new_ip_rr = 0;
+    CPU_NumericType beta;
+    CPU_NumericType norm_rhs_squared = ip_rr;
+    CPU_NumericType new_ipp_rr_over_norm_rhs;
+
+    if (norm_rhs_squared == 0) //solution is zero if RHS norm is zero
+      return result;
+
+    if (initial_guess)
+    {
+      result = *initial_guess;
+      residual -= viennacl::linalg::prod(matrix, result);
+      z = residual;
+      precond.apply(z);
+
+      ip_rr = viennacl::linalg::inner_prod(residual, z);
+      new_ip_rr = ip_rr;
+      if (std::fabs(ip_rr / norm_rhs_squared) < tag.tolerance() *  tag.tolerance()) //initial guess is accurate enough
+      {
+        tag.iters(0);
+        tag.error(std::sqrt(std::fabs(ip_rr / norm_rhs_squared)));
+        return result;
+      }
+    }
+
+    VectorT p = z;
+
+    for (unsigned int i = 0; i < tag.max_iterations(); ++i)
+    {
+      tag.iters(i+1);
+      tmp = viennacl::linalg::prod(matrix, p);
+
+      alpha = ip_rr / viennacl::linalg::inner_prod(tmp, p);
+
+      result += alpha * p;
+      residual -= alpha * tmp;
+      z = residual;
+      precond.apply(z);
+
+      if (&residual==&z)
+        new_ip_rr = std::pow(viennacl::linalg::norm_2(residual),2);
+      else
+        new_ip_rr = viennacl::linalg::inner_prod(residual, z);
+
+      new_ipp_rr_over_norm_rhs = new_ip_rr / norm_rhs_squared;
+      tag.record_residual(std::sqrt(std::fabs(new_ipp_rr_over_norm_rhs)));
+      if (std::fabs(new_ipp_rr_over_norm_rhs) < tag.tolerance() *  tag.tolerance())    //squared norms involved here
+        break;
+
+      beta = new_ip_rr / ip_rr;
+      ip_rr = new_ip_rr;
+
+      p = z + beta*p;
+    }
+
+    //store last error estimate:
+    tag.error(std::sqrt(std::fabs(new_ip_rr / norm_rhs_squared)));
 
-  //store last error estimate:
-  tag.error(std::sqrt(std::fabs(inner_prod_rr) / norm_rhs_squared));
+    return result;
+  }
 
-  return result;
 }
 
 /** @brief Implementation of the preconditioned conjugate gradient solver, generic implementation for non-ViennaCL types.
@@ -181,65 +339,393 @@ viennacl::vector<NumericT> solve(MatrixT const & A, //MatrixType const & A,
 template<typename MatrixT, typename VectorT, typename PreconditionerT>
 VectorT solve(MatrixT const & matrix, VectorT const & rhs, cg_tag const & tag, PreconditionerT const & precond)
 {
-  typedef typename viennacl::result_of::value_type<VectorT>::type           NumericType;
-  typedef typename viennacl::result_of::cpu_value_type<NumericType>::type   CPU_NumericType;
+  return detail::pcg_solve(matrix, rhs, tag, precond, static_cast<VectorT const *>(NULL));
+}
 
-  VectorT result = rhs;
-  viennacl::traits::clear(result);
+/** @brief Preconditioned conjugate gradient solver starting from the given initial guess. The relative tolerance refers to the (preconditioned) norm of the right hand side.
+*
+* @param matrix         The system matrix
+* @param rhs            The load vector
+* @param tag            Solver configuration tag
+* @param precond        A preconditioner. Precondition operation is done via member function apply()
+* @param initial_guess  The initial guess, e.g. the solution of the previous time step
+* @return The result vector
+*/
+template<typename MatrixT, typename VectorT, typename PreconditionerT>
+VectorT solve(MatrixT const & matrix, VectorT const & rhs, cg_tag const & tag, PreconditionerT const & precond, VectorT const & initial_guess)
+{
+  return detail::pcg_solve(matrix, rhs, tag, precond, &initial_guess);
+}
+
+template<typename MatrixT, typename VectorT>
+VectorT solve(MatrixT const & matrix, VectorT const & rhs, cg_tag const & tag)
+{
+  return solve(matrix, rhs, tag, viennacl::linalg::no_precond());
+}
 
-  VectorT residual = rhs;
-  VectorT tmp = rhs;
-  detail::z_handler<VectorT, PreconditionerT> zhandler(residual);
-  VectorT & z = zhandler.get();
 
-  precond.apply(z);
-  VectorT p = z;
+/** @brief A tag for the block conjugate gradient method for multiple right hand sides. Used for supplying solver parameters and for dispatching the solve() function
+*
+* In contrast to solving for each column of the right hand side matrix independently (cg_tag), the block method searches the sum of the Krylov spaces
+* of all right hand sides (D. P. O'Leary, Linear Algebra Appl. 29, 293-322 (1980)), which usually reduces the number of iterations.
+* Search directions which become (numerically) linearly dependent, e.g. for zero or linearly dependent right hand sides, are dropped from the block.
+*/
+class block_cg_tag : public cg_tag
+{
+public:
+  /** @brief The constructor
+  *
+  * @param tol              Relative tolerance for the residual of each right hand side (solver quits if ||r_j|| < tol * ||r_j_initial|| for all columns j)
+  * @param max_iterations   The maximum number of iterations
+  */
+  block_cg_tag(double tol = 1e-8, unsigned int max_iterations = 300) : cg_tag(tol, max_iterations) {}
+};
 
-  CPU_NumericType ip_rr = viennacl::linalg::inner_prod(residual, z);
-  CPU_NumericType alpha;
-  CPU_NumericType new_ip_rr = 0;
-  CPU_NumericType beta;
-  CPU_NumericType norm_rhs_squared = ip_rr;
-  CPU_NumericType new_ipp_rr_over_norm_rhs;
 
-  if (norm_rhs_squared == 0) //solution is zero if RHS norm is zero
-    return result;
+namespace detail
+{
 
-  for (unsigned int i = 0; i < tag.max_iterations(); ++i)
+  /** @brief Implementation of the preconditioned conjugate gradient solver for multiple right hand sides, given as the columns of a dense matrix.
+  *
+  * Each column is iterated independently following Algorithm 9.1 in "Iterative Methods for Sparse Linear Systems" by Y. Saad,
+  * but the products with the system matrix are carried out for all columns at once (sparse matrix times dense matrix), so the system matrix is read only once per iteration.
+  * Columns which have already converged are no longer updated. The estimated relative error stored in the tag is the maximum over all columns.
+  *
+  * @param matrix     The system matrix
+  * @param rhs        The right hand sides, one per column
+  * @param tag        Solver configuration tag
+  * @param precond    A preconditioner. Precondition operation is done via member function apply()
+  * @param initial_guess  Pointer to the initial guesses, one per column. Zero initial guesses are used if NULL.
+  * @return The matrix of result vectors
+  */
+  template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV, typename PreconditionerT>
+  viennacl::matrix<NumericT, F, AlignmentV> multi_rhs_cg_solve(MatrixT const & matrix, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, cg_tag const & tag, PreconditionerT const & precond,
+                                                               viennacl::matrix<NumericT, F, AlignmentV> const * initial_guess)
   {
-    tag.iters(i+1);
-    tmp = viennacl::linalg::prod(matrix, p);
-
-    alpha = ip_rr / viennacl::linalg::inner_prod(tmp, p);
+    typedef viennacl::matrix<NumericT, viennacl::column_major>   DenseMatrixType;   // column-major, so that the columns are contiguous in memory
+
+    vcl_size_t num_rhs = rhs.size2();
+
+    DenseMatrixType result(rhs.size1(), num_rhs, viennacl::traits::context(rhs));
+    result.clear();
+
+    tag.clear_residual_history();
+
+    DenseMatrixType residual = detail::multi_rhs_convert<DenseMatrixType>(rhs);
+    DenseMatrixType tmp(rhs.size1(), num_rhs, viennacl::traits::context(rhs));
+    detail::z_handler<DenseMatrixType, PreconditionerT> zhandler(residual);
+    DenseMatrixType & z = zhandler.get();
+    viennacl::vector<NumericT> precond_tmp(rhs.size1(), viennacl::traits::context(rhs));
+
+    tag.iters(0);
+
+    std::vector<bool> active(num_rhs, true);
+    detail::multi_rhs_precond_apply(precond, z, active, precond_tmp);
+    DenseMatrixType p = z;
+
+    std::vector<NumericT> ip_rr(num_rhs);
+    std::vector<NumericT> norm_rhs_squared(num_rhs);
+    std::vector<NumericT> rel_error(num_rhs, NumericT(0));
+    vcl_size_t num_active = 0;
+    for (vcl_size_t j = 0; j < num_rhs; ++j)
+    {
+      ip_rr[j] = viennacl::linalg::inner_prod(detail::multi_rhs_column<NumericT>(residual, j), detail::multi_rhs_column<NumericT>(z, j));
+      norm_rhs_squared[j] = ip_rr[j];
+      active[j] = (norm_rhs_squared[j] != 0); //solution is zero if RHS norm is zero
+    }
+
+    if (initial_guess)
+    {
+      DenseMatrixType initial_guess_colmajor = detail::multi_rhs_convert<DenseMatrixType>(*initial_guess);
+      for (vcl_size_t j = 0; j < num_rhs; ++j)
+        if (active[j])
+          detail::multi_rhs_column<NumericT>(result, j) = detail::multi_rhs_column<NumericT>(initial_guess_colmajor, j);
+
+      detail::multi_rhs_prod(matrix, result, tmp);
+      residual -= tmp;
+      if (&residual != &z)
+      {
+        z = residual;
+        detail::multi_rhs_precond_apply(precond, z, active, precond_tmp);
+      }
+      p = z;
+
+      for (vcl_size_t j = 0; j < num_rhs; ++j)
+      {
+        if (!active[j])
+          continue;
+
+        ip_rr[j] = viennacl::linalg::inner_prod(detail::multi_rhs_column<NumericT>(residual, j), detail::multi_rhs_column<NumericT>(z, j));
+        rel_error[j] = std::sqrt(std::fabs(ip_rr[j] / norm_rhs_squared[j]));
+        active[j] = (rel_error[j] >= tag.tolerance()); //initial guess may already be accurate enough
+      }
+    }
+
+    for (vcl_size_t j = 0; j < num_rhs; ++j)
+      if (active[j])
+        ++num_active;
+
+    for (unsigned int i = 0; i < tag.max_iterations() && num_active > 0; ++i)
+    {
+      tag.iters(i+1);
+      detail::multi_rhs_prod(matrix, p, tmp);
+
+      for (vcl_size_t j = 0; j < num_rhs; ++j)
+      {
+        if (!active[j])
+          continue;
+
+        detail::multi_rhs_column<NumericT> p_j(p, j);
+        detail::multi_rhs_column<NumericT> tmp_j(tmp, j);
+        detail::multi_rhs_column<NumericT> residual_j(residual, j);
+        detail::multi_rhs_column<NumericT> result_j(result, j);
+
+        NumericT alpha = ip_rr[j] / viennacl::linalg::inner_prod(tmp_j, p_j);
+        result_j += alpha * p_j;
+        residual_j -= alpha * tmp_j;
+      }
+
+      if (&residual != &z)
+      {
+        for (vcl_size_t j = 0; j < num_rhs; ++j)
+          if (active[j])
+            detail::multi_rhs_column<NumericT>(z, j) = detail::multi_rhs_column<NumericT>(residual, j);
+        detail::multi_rhs_precond_apply(precond, z, active, precond_tmp);
+      }
+
+      for (vcl_size_t j = 0; j < num_rhs; ++j)
+      {
+        if (!active[j])
+          continue;
+
+        detail::multi_rhs_column<NumericT> p_j(p, j);
+        detail::multi_rhs_column<NumericT> z_j(z, j);
+
+        NumericT new_ip_rr = viennacl::linalg::inner_prod(detail::multi_rhs_column<NumericT>(residual, j), z_j);
+        rel_error[j] = std::sqrt(std::fabs(new_ip_rr / norm_rhs_squared[j]));
+        if (rel_error[j] < tag.tolerance())
+        {
+          active[j] = false;
+          --num_active;
+          continue;
+        }
+
+        NumericT beta = new_ip_rr / ip_rr[j];
+        ip_rr[j] = new_ip_rr;
+
+        p_j = z_j + beta * p_j;
+      }
+
+      tag.record_residual(*std::max_element(rel_error.begin(), rel_error.end()));
+    }
+
+    //store last error estimate:
+    tag.error(rel_error.size() > 0 ? *std::max_element(rel_error.begin(), rel_error.end()) : 0);
+
+    return detail::multi_rhs_convert<viennacl::matrix<NumericT, F, AlignmentV> >(result);
+  }
 
-    result += alpha * p;
-    residual -= alpha * tmp;
-    z = residual;
-    precond.apply(z);
+}
 
-    if (&residual==&z)
-      new_ip_rr = std::pow(viennacl::linalg::norm_2(residual),2);
-    else
-      new_ip_rr = viennacl::linalg::inner_prod(residual, z);
+/** @brief Implementation of the preconditioned conjugate gradient solver for multiple right hand sides, given as the columns of a dense matrix.
+*
+* Each column is iterated independently, but the products with the system matrix are carried out for all columns at once (sparse matrix times dense matrix).
+*
+* @param matrix     The system matrix
+* @param rhs        The right hand sides, one per column
+* @param tag        Solver configuration tag
+* @param precond    A preconditioner. Precondition operation is done via member function apply()
+* @return The matrix of result vectors
+*/
+template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV, typename PreconditionerT>
+viennacl::matrix<NumericT, F, AlignmentV> solve(MatrixT const & matrix, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, cg_tag const & tag, PreconditionerT const & precond)
+{
+  return detail::multi_rhs_cg_solve(matrix, rhs, tag, precond, static_cast<viennacl::matrix<NumericT, F, AlignmentV> const *>(NULL));
+}
 
-    new_ipp_rr_over_norm_rhs = new_ip_rr / norm_rhs_squared;
-    if (std::fabs(new_ipp_rr_over_norm_rhs) < tag.tolerance() *  tag.tolerance())    //squared norms involved here
-      break;
+/** @brief Conjugate gradient solver for multiple right hand sides (one per column) starting from the given initial guesses. The relative tolerances refer to the (preconditioned) norms of the right hand sides. */
+template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV, typename PreconditionerT>
+viennacl::matrix<NumericT, F, AlignmentV> solve(MatrixT const & matrix, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, cg_tag const & tag, PreconditionerT const & precond,
+                                                viennacl::matrix<NumericT, F, AlignmentV> const & initial_guess)
+{
+  return detail::multi_rhs_cg_solve(matrix, rhs, tag, precond, &initial_guess);
+}
 
-    beta = new_ip_rr / ip_rr;
-    ip_rr = new_ip_rr;
+namespace detail
+{
 
-    p = z + beta*p;
+  /** @brief Implementation of the preconditioned block conjugate gradient solver for multiple right hand sides, given as the columns of a dense matrix.
+  *
+  * Following the description of the block conjugate gradient method by D. P. O'Leary, Linear Algebra Appl. 29, 293-322 (1980).
+  * All right hand sides share one block Krylov space. The coefficients alpha and beta become small square matrices, which are computed on the host.
+  * The products with the system matrix are carried out for all columns at once (sparse matrix times dense matrix).
+  *
+  * The coefficients are obtained from the conjugate direction conditions, alpha = (P^T A P)^{-1} P^T R and beta = -(P^T A P)^{-1} (A P)^T Z,
+  * using a Cholesky factorization of P^T A P with diagonal pivoting. Search directions which are numerically linearly dependent on the others
+  * (zero or identical right hand sides, converged columns) are dropped from the block for the respective iteration instead of causing a breakdown.
+  *
+  * @param matrix     The system matrix
+  * @param rhs        The right hand sides, one per column
+  * @param tag        Solver configuration tag
+  * @param precond    A preconditioner. Precondition operation is done via member function apply()
+  * @param initial_guess  Pointer to the initial guesses, one per column. Zero initial guesses are used if NULL.
+  * @return The matrix of result vectors
+  */
+  template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV, typename PreconditionerT>
+  viennacl::matrix<NumericT, F, AlignmentV> block_cg_solve(MatrixT const & matrix, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, block_cg_tag const & tag, PreconditionerT const & precond,
+                                                           viennacl::matrix<NumericT, F, AlignmentV> const * initial_guess)
+  {
+    typedef viennacl::matrix<NumericT, viennacl::column_major>   DenseMatrixType;   // column-major, so that the columns are contiguous in memory
+
+    vcl_size_t num_rhs = rhs.size2();
+
+    DenseMatrixType result(rhs.size1(), num_rhs, viennacl::traits::context(rhs));
+    result.clear();
+
+    tag.clear_residual_history();
+    tag.iters(0);
+    tag.error(0);
+
+    DenseMatrixType residual = detail::multi_rhs_convert<DenseMatrixType>(rhs);
+    DenseMatrixType tmp(rhs.size1(), num_rhs, viennacl::traits::context(rhs));
+    detail::z_handler<DenseMatrixType, PreconditionerT> zhandler(residual);
+    DenseMatrixType & z = zhandler.get();
+    DenseMatrixType small_matrix(num_rhs, num_rhs, viennacl::traits::context(rhs));
+    viennacl::vector<NumericT> precond_tmp(rhs.size1(), viennacl::traits::context(rhs));
+
+    std::vector<bool> active(num_rhs, true);
+    detail::multi_rhs_precond_apply(precond, z, active, precond_tmp);
+
+    // R^T Z, P^T A P with its pivoted Cholesky factor, and the coefficient matrices alpha and beta, all row-major on the host:
+    std::vector<NumericT> ip_rz;
+    std::vector<NumericT> ip_pAp;
+    std::vector<vcl_size_t> pivots;
+    std::vector<NumericT> coefficients;
+
+    // directions whose A-norm is reduced below this fraction by the orthogonalization against the other directions are considered linearly dependent:
+    NumericT dependence_tol = NumericT(1000) * std::numeric_limits<NumericT>::epsilon();
+
+    detail::multi_rhs_inner_prod(residual, z, small_matrix, ip_rz);
+
+    std::vector<NumericT> norm_rhs_squared(num_rhs);
+    std::vector<NumericT> rel_error(num_rhs, NumericT(0));
+    for (vcl_size_t j = 0; j < num_rhs; ++j)
+    {
+      norm_rhs_squared[j] = ip_rz[j * num_rhs + j];
+      rel_error[j] = norm_rhs_squared[j] ? NumericT(1) : NumericT(0);
+    }
+
+    if (num_rhs == 0 || *std::max_element(norm_rhs_squared.begin(), norm_rhs_squared.end()) == 0) //solution is zero if RHS norm is zero
+      return detail::multi_rhs_convert<viennacl::matrix<NumericT, F, AlignmentV> >(result);
+
+    if (initial_guess)
+    {
+      DenseMatrixType initial_guess_colmajor = detail::multi_rhs_convert<DenseMatrixType>(*initial_guess);
+      for (vcl_size_t j = 0; j < num_rhs; ++j)
+        if (norm_rhs_squared[j] != 0)
+          detail::multi_rhs_column<NumericT>(result, j) = detail::multi_rhs_column<NumericT>(initial_guess_colmajor, j);
+
+      detail::multi_rhs_prod(matrix, result, tmp);
+      residual -= tmp;
+      if (&residual != &z)
+      {
+        z = residual;
+        detail::multi_rhs_precond_apply(precond, z, active, precond_tmp);
+      }
+
+      detail::multi_rhs_inner_prod(residual, z, small_matrix, ip_rz);
+      for (vcl_size_t j = 0; j < num_rhs; ++j)
+        rel_error[j] = norm_rhs_squared[j] ? std::sqrt(std::fabs(ip_rz[j * num_rhs + j] / norm_rhs_squared[j])) : 0;
+    }
+
+    DenseMatrixType p = z;
+
+    for (unsigned int i = 0; i < tag.max_iterations(); ++i)
+    {
+      if (*std::max_element(rel_error.begin(), rel_error.end()) < tag.tolerance())
+        break;
+
+      tag.iters(i+1);
+      detail::multi_rhs_prod(matrix, p, tmp);
+
+      // select a linearly independent subset of the search directions:
+      detail::multi_rhs_inner_prod(p, tmp, small_matrix, ip_pAp);
+      vcl_size_t rank = detail::multi_rhs_pivoted_cholesky(ip_pAp, pivots, num_rhs, dependence_tol);
+      if (rank == 0) //all search directions vanish
+        break;
+
+      // alpha = (P^T A P)^{-1} P^T R:
+      detail::multi_rhs_inner_prod(p, residual, small_matrix, coefficients);
+      detail::multi_rhs_pivoted_cholesky_solve(ip_pAp, pivots, rank, coefficients, num_rhs, num_rhs);
+      detail::multi_rhs_copy_to_device(coefficients, small_matrix);
+
+      viennacl::linalg::prod_impl(p,   small_matrix, result,   NumericT( 1), NumericT(1));
+      viennacl::linalg::prod_impl(tmp, small_matrix, residual, NumericT(-1), NumericT(1));
+
+      if (&residual != &z)
+      {
+        z = residual;
+        detail::multi_rhs_precond_apply(precond, z, active, precond_tmp);
+      }
+
+      detail::multi_rhs_inner_prod(residual, z, small_matrix, ip_rz);
+
+      NumericT max_rel_error = 0;
+      for (vcl_size_t j = 0; j < num_rhs; ++j)
+      {
+        rel_error[j] = norm_rhs_squared[j] ? std::sqrt(std::fabs(ip_rz[j * num_rhs + j] / norm_rhs_squared[j])) : 0;
+        max_rel_error = std::max(max_rel_error, rel_error[j]);
+      }
+      tag.record_residual(max_rel_error);
+      if (max_rel_error < tag.tolerance())
+        break;
+
+      // beta = (P^T A P)^{-1} (A P)^T Z:
+      detail::multi_rhs_inner_prod(tmp, z, small_matrix, coefficients);
+      detail::multi_rhs_pivoted_cholesky_solve(ip_pAp, pivots, rank, coefficients, num_rhs, num_rhs);
+      detail::multi_rhs_copy_to_device(coefficients, small_matrix);
+
+      // p = z - p * beta
+      tmp = z;
+      viennacl::linalg::prod_impl(p, small_matrix, tmp, NumericT(-1), NumericT(1));
+      p = tmp;
+    }
+
+    //store last error estimate:
+    tag.error(*std::max_element(rel_error.begin(), rel_error.end()));
+
+    return detail::multi_rhs_convert<viennacl::matrix<NumericT, F, AlignmentV> >(result);
   }
 
-  //store last error estimate:
-  tag.error(std::sqrt(std::fabs(new_ip_rr / norm_rhs_squared)));
+}
+
+/** @brief Implementation of the preconditioned block conjugate gradient solver for multiple right hand sides, given as the columns of a dense matrix.
+*
+* All right hand sides share one block Krylov space, see block_cg_tag.
+*
+* @param matrix     The system matrix
+* @param rhs        The right hand sides, one per column
+* @param tag        Solver configuration tag
+* @param precond    A preconditioner. Precondition operation is done via member function apply()
+* @return The matrix of result vectors
+*/
+template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV, typename PreconditionerT>
+viennacl::matrix<NumericT, F, AlignmentV> solve(MatrixT const & matrix, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, block_cg_tag const & tag, PreconditionerT const & precond)
+{
+  return detail::block_cg_solve(matrix, rhs, tag, precond, static_cast<viennacl::matrix<NumericT, F, AlignmentV> const *>(NULL));
+}
 
-  return result;
+/** @brief Block conjugate gradient solver for multiple right hand sides (one per column) starting from the given initial guesses. The relative tolerances refer to the (preconditioned) norms of the right hand sides. */
+template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV, typename PreconditionerT>
+viennacl::matrix<NumericT, F, AlignmentV> solve(MatrixT const & matrix, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, block_cg_tag const & tag, PreconditionerT const & precond,
+                                                viennacl::matrix<NumericT, F, AlignmentV> const & initial_guess)
+{
+  return detail::block_cg_solve(matrix, rhs, tag, precond, &initial_guess);
 }
 
-template<typename MatrixT, typename VectorT>
-VectorT solve(MatrixT const & matrix, VectorT const & rhs, cg_tag const & tag)
+/** @brief Convenience overload of the block conjugate gradient solver without preconditioner. */
+template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV>
+viennacl::matrix<NumericT, F, AlignmentV> solve(MatrixT const & matrix, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, block_cg_tag const & tag)
 {
   return solve(matrix, rhs, tag, viennacl::linalg::no_precond());
 }
@@ -0,0 +1,555 @@
+#ifndef VIENNACL_LINALG_CHEBYSHEV_HPP_
+#define VIENNACL_LINALG_CHEBYSHEV_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/chebyshev.hpp
+    @brief The Chebyshev iteration and Chebyshev/Neumann polynomial preconditioners. Apart from a spectrum estimate computed once, neither requires inner products.
+*/
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/norm_inf.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+#include "viennacl/linalg/iterative_operations.hpp"
+#include "viennacl/traits/clear.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/context.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for the Chebyshev iteration. Used for supplying solver parameters and for dispatching the solve() function
+*
+* The Chebyshev iteration requires bounds on the spectrum of the (preconditioned) system matrix, which is assumed to be symmetric positive definite.
+* Bounds not supplied by the user are estimated by power iterations at the beginning of the first solver run and stored in the tag, so that subsequent runs reuse them.
+*/
+class chebyshev_tag
+{
+public:
+  /** @brief The constructor
+  *
+  * @param tol                Relative tolerance for the residual (solver quits if ||r|| < tol * ||r_initial||)
+  * @param max_iterations     The maximum number of iterations
+  * @param lambda_min         Lower bound on the spectrum of the preconditioned system matrix. Estimated if zero.
+  * @param lambda_max         Upper bound on the spectrum of the preconditioned system matrix. Estimated if zero.
+  * @param check_interval     Number of iterations between two computations of the residual norm (the only inner products of the iteration)
+  * @param power_iterations   Number of power iterations for estimating each of the two spectral bounds
+  */
+  chebyshev_tag(double tol = 1e-8, unsigned int max_iterations = 300,
+                double lambda_min = 0, double lambda_max = 0,
+                unsigned int check_interval = 10, unsigned int power_iterations = 50)
+    : tol_(tol), iterations_(max_iterations), check_interval_(check_interval), power_iterations_(power_iterations),
+      lambda_min_(lambda_min), lambda_max_(lambda_max), iters_taken_(0), last_error_(0) {}
+
+  /** @brief Returns the relative tolerance */
+  double tolerance() const { return tol_; }
+  /** @brief Returns the maximum number of iterations */
+  unsigned int max_iterations() const { return iterations_; }
+  /** @brief Returns the number of iterations between two residual checks */
+  unsigned int check_interval() const { return check_interval_; }
+  /** @brief Returns the number of power iterations used for each spectral bound estimate */
+  unsigned int power_iterations() const { return power_iterations_; }
+
+  /** @brief Returns the lower bound on the spectrum (zero if not yet known) */
+  double lambda_min() const { return lambda_min_; }
+  /** @brief Sets the lower bound on the spectrum. Set to zero in order to enforce a new estimate in the next solver run. */
+  void lambda_min(double value) const { lambda_min_ = value; }
+  /** @brief Returns the upper bound on the spectrum (zero if not yet known) */
+  double lambda_max() const { return lambda_max_; }
+  /** @brief Sets the upper bound on the spectrum. Set to zero in order to enforce a new estimate in the next solver run. */
+  void lambda_max(double value) const { lambda_max_ = value; }
+
+  /** @brief Return the number of solver iterations: */
+  unsigned int iters() const { return iters_taken_; }
+  void iters(unsigned int i) const { iters_taken_ = i; }
+
+  /** @brief Returns the estimated relative error at the end of the solver run */
+  double error() const { return last_error_; }
+  /** @brief Sets the estimated relative error at the end of the solver run */
+  void error(double e) const { last_error_ = e; }
+
+private:
+  double tol_;
+  unsigned int iterations_;
+  unsigned int check_interval_;
+  unsigned int power_iterations_;
+
+  //spectral bounds, possibly estimated by the solver
+  mutable double lambda_min_;
+  mutable double lambda_max_;
+
+  //return values from solver
+  mutable unsigned int iters_taken_;
+  mutable double last_error_;
+};
+
+
+/** @brief A tag for the Chebyshev/Neumann polynomial preconditioner
+*
+* The preconditioner applies a fixed polynomial p(D^{-1} A) D^{-1} to the residual, where D denotes the diagonal of the system matrix.
+* The polynomial is tuned to the interval [lambda_max / eigenvalue_ratio, lambda_max] of the spectrum of D^{-1} A, with lambda_max estimated by a few power iterations during setup
+* (and capped by the Gershgorin bound of D^{-1} A).
+*/
+class chebyshev_precond_tag
+{
+public:
+  /** @brief The constructor
+  *
+  * @param degree             Degree of the polynomial, i.e. the number of sparse matrix-vector products per application of the preconditioner
+  * @param eigenvalue_ratio   Ratio of the upper and the lower end of the interval the polynomial is tuned to
+  * @param power_iterations   Number of power iterations for estimating the largest eigenvalue of D^{-1} A
+  * @param use_neumann        If true, a truncated Neumann series (i.e. damped Jacobi iterations) is used instead of the Chebyshev polynomial
+  */
+  chebyshev_precond_tag(unsigned int degree = 3, double eigenvalue_ratio = 30.0, unsigned int power_iterations = 20, bool use_neumann = false)
+    : degree_(degree), eigenvalue_ratio_(eigenvalue_ratio), power_iterations_(power_iterations), use_neumann_(use_neumann), lambda_max_(0) {}
+
+  /** @brief Returns the degree of the polynomial */
+  unsigned int degree() const { return degree_; }
+  /** @brief Sets the degree of the polynomial */
+  void degree(unsigned int value) { degree_ = value; }
+
+  /** @brief Returns the ratio of the upper and the lower end of the interval the polynomial is tuned to */
+  double eigenvalue_ratio() const { return eigenvalue_ratio_; }
+  /** @brief Sets the ratio of the upper and the lower end of the interval the polynomial is tuned to */
+  void eigenvalue_ratio(double value) { eigenvalue_ratio_ = value; }
+
+  /** @brief Returns the number of power iterations */
+  unsigned int power_iterations() const { return power_iterations_; }
+  /** @brief Sets the number of power iterations */
+  void power_iterations(unsigned int value) { power_iterations_ = value; }
+
+  /** @brief Returns true if a truncated Neumann series is used instead of the Chebyshev polynomial */
+  bool use_neumann() const { return use_neumann_; }
+  /** @brief Selects the truncated Neumann series (true) or the Chebyshev polynomial (false) */
+  void use_neumann(bool value) { use_neumann_ = value; }
+
+  /** @brief Returns the user-supplied upper bound on the spectrum of D^{-1} A, or zero if the bound is estimated */
+  double lambda_max() const { return lambda_max_; }
+  /** @brief Supplies an upper bound on the spectrum of D^{-1} A, which skips the power iterations. Pass zero to enable the estimate again. */
+  void lambda_max(double value) { lambda_max_ = value; }
+
+private:
+  unsigned int degree_;
+  double eigenvalue_ratio_;
+  unsigned int power_iterations_;
+  bool use_neumann_;
+  double lambda_max_;
+};
+
+
+namespace detail
+{
+
+  /** @brief Safety factor applied to estimates of the largest eigenvalue. Power iterations approach the largest eigenvalue from below, while the Chebyshev polynomials grow rapidly beyond the upper end of the interval. */
+  inline double chebyshev_lambda_max_safety_factor() { return 1.1; }
+
+  /** @brief Diagonal scaling by a precomputed inverse diagonal, used by the polynomial preconditioner */
+  template<typename NumericT>
+  class chebyshev_diagonal_scaling
+  {
+  public:
+    chebyshev_diagonal_scaling(viennacl::vector<NumericT> const & inv_diag) : inv_diag_(inv_diag) {}
+
+    void apply(viennacl::vector<NumericT> & vec) const { vec = viennacl::linalg::element_prod(vec, inv_diag_); }
+
+  private:
+    viennacl::vector<NumericT> const & inv_diag_;
+  };
+
+  /** @brief Fills 'v' with a deterministic start vector of unit norm for the power iterations.
+  *
+  * An oscillating start vector is used for the largest eigenvalue, a positive one for the smallest eigenvalue (the eigenvectors of which are smooth for typical discretizations).
+  */
+  template<typename NumericT>
+  void chebyshev_start_vector(viennacl::vector<NumericT> & v, bool smooth)
+  {
+    NumericT shift = smooth ? NumericT(0.5) : NumericT(-0.5);
+    std::vector<NumericT> s(v.size());
+    for (vcl_size_t i = 0; i < s.size(); ++i)
+      s[i] = NumericT((i * 7919) % 1031) / NumericT(1031) + shift;   //'random' entries in [-0.5, 0.5) or [0.5, 1.5)
+    viennacl::copy(s, v);
+    v /= viennacl::linalg::norm_2(v);
+  }
+
+  /** @brief Estimates the largest eigenvalue of M^{-1} A (or the largest eigenvalue of shift * I - M^{-1} A if 'shift' is nonzero) by power iterations.
+  *
+  * @param A            The system matrix
+  * @param precond      The preconditioner M
+  * @param shift        The shift
+  * @param iterations   The number of power iterations
+  * @param v            Work vector
+  * @param tmp          Work vector
+  */
+  template<typename MatrixT, typename NumericT, typename PreconditionerT>
+  double chebyshev_power_iteration(MatrixT const & A, PreconditionerT const & precond, NumericT shift, unsigned int iterations,
+                                   viennacl::vector<NumericT> & v, viennacl::vector<NumericT> & tmp)
+  {
+    chebyshev_start_vector(v, shift != 0);
+
+    NumericT norm = 0;
+    for (unsigned int i = 0; i < iterations; ++i)
+    {
+      tmp = viennacl::linalg::prod(A, v);
+      precond.apply(tmp);
+      if (shift != 0)
+        tmp = shift * v - tmp;
+
+      norm = viennacl::linalg::norm_2(tmp);
+      if (norm <= 0)
+        break;
+      v = tmp / norm;
+    }
+    return static_cast<double>(norm);
+  }
+
+  /** @brief Returns the Gershgorin bound max_i sum_j |a_ij| * inv_diag_i on the spectrum of D^{-1} A. 'tmp' is used as temporary storage. */
+  template<typename MatrixT, typename NumericT>
+  double chebyshev_gershgorin_bound(MatrixT const & A, viennacl::vector<NumericT> const & inv_diag, viennacl::vector<NumericT> & tmp)
+  {
+    detail::row_info(A, tmp, detail::SPARSE_ROW_NORM_1);
+    tmp = viennacl::linalg::element_prod(tmp, inv_diag);
+    return static_cast<double>(viennacl::linalg::norm_inf(tmp));
+  }
+
+  /** @brief One step of a polynomial iteration with diagonal scaling: x += d_in; r -= A * d_in; d_out = alpha * d_in + beta * D^{-1} r. Generic version. */
+  template<typename MatrixT, typename NumericT>
+  void chebyshev_step(MatrixT const & A,
+                      viennacl::vector<NumericT> const & d_in, viennacl::vector<NumericT> & d_out,
+                      viennacl::vector<NumericT> & r, viennacl::vector<NumericT> & x,
+                      viennacl::vector<NumericT> const & inv_diag,
+                      NumericT alpha, NumericT beta,
+                      viennacl::vector<NumericT> & tmp)
+  {
+    x += d_in;
+    tmp = viennacl::linalg::prod(A, d_in);
+    r -= tmp;
+    d_out = viennacl::linalg::element_prod(inv_diag, r);
+    d_out = beta * d_out + alpha * d_in;
+  }
+
+  /** @brief One step of a polynomial iteration with diagonal scaling. Uses a fused kernel for a compressed_matrix in host memory. */
+  template<typename NumericT>
+  void chebyshev_step(viennacl::compressed_matrix<NumericT> const & A,
+                      viennacl::vector<NumericT> const & d_in, viennacl::vector<NumericT> & d_out,
+                      viennacl::vector<NumericT> & r, viennacl::vector<NumericT> & x,
+                      viennacl::vector<NumericT> const & inv_diag,
+                      NumericT alpha, NumericT beta,
+                      viennacl::vector<NumericT> & tmp)
+  {
+    if (viennacl::traits::active_handle_id(x) == viennacl::MAIN_MEMORY)
+    {
+      viennacl::linalg::chebyshev_prod(A, d_in, d_out, r, x, inv_diag, alpha, beta);
+      return;
+    }
+
+    x += d_in;
+    tmp = viennacl::linalg::prod(A, d_in);
+    r -= tmp;
+    d_out = viennacl::linalg::element_prod(inv_diag, r);
+    d_out = beta * d_out + alpha * d_in;
+  }
+
+  /** @brief Computes the spectral bounds of M^{-1} A required by the Chebyshev iteration, unless they are already stored in the tag.
+  *
+  * @param lambda_max_bound   An a-priori upper bound on the spectrum (e.g. from Gershgorin's theorem) which caps the estimate of the largest eigenvalue. Ignored if zero.
+  */
+  template<typename MatrixT, typename NumericT, typename PreconditionerT>
+  void chebyshev_spectral_bounds(MatrixT const & A, PreconditionerT const & precond, chebyshev_tag const & tag,
+                                 viennacl::vector<NumericT> & v, viennacl::vector<NumericT> & tmp, double lambda_max_bound = 0)
+  {
+    if (tag.lambda_max() <= 0)
+    {
+      double lambda_max = chebyshev_lambda_max_safety_factor() * chebyshev_power_iteration(A, precond, NumericT(0), tag.power_iterations(), v, tmp);
+      tag.lambda_max(lambda_max_bound > 0 ? std::min(lambda_max, lambda_max_bound) : lambda_max);
+    }
+
+    if (tag.lambda_min() <= 0)
+    {
+      // power iteration for the largest eigenvalue of lambda_max * I - M^{-1} A:
+      double shifted = chebyshev_power_iteration(A, precond, NumericT(tag.lambda_max()), tag.power_iterations(), v, tmp);
+      double lambda_min = tag.lambda_max() - shifted;
+      if (lambda_min <= 0 || lambda_min >= tag.lambda_max())  //estimate failed, fall back to a fixed ratio
+        lambda_min = tag.lambda_max() / 1000.0;
+      tag.lambda_min(lambda_min);
+    }
+  }
+
+  /** @brief Implementation of the Chebyshev iteration with a diagonal scaling, using the fused update kernel where available.
+  *
+  * Follows Algorithm 12.1 in Y. Saad, Iterative Methods for Sparse Linear Systems, 2nd edition, SIAM (2003).
+  */
+  template<typename MatrixT, typename NumericT>
+  viennacl::vector<NumericT> chebyshev_solve(MatrixT const & A, viennacl::vector<NumericT> const & rhs, chebyshev_tag const & tag,
+                                             viennacl::vector<NumericT> const & inv_diag)
+  {
+    viennacl::vector<NumericT> result(rhs.size(), viennacl::traits::context(rhs));
+    viennacl::vector<NumericT> residual(rhs);
+    viennacl::vector<NumericT> d1(rhs.size(), viennacl::traits::context(rhs));
+    viennacl::vector<NumericT> d2(rhs.size(), viennacl::traits::context(rhs));
+    viennacl::vector<NumericT> tmp(rhs.size(), viennacl::traits::context(rhs));
+    viennacl::traits::clear(result);
+
+    tag.iters(0);
+    tag.error(0);
+
+    NumericT norm_rhs = viennacl::linalg::norm_2(rhs);
+    if (norm_rhs <= 0)
+      return result;
+
+    double gershgorin_bound = (tag.lambda_max() <= 0) ? detail::chebyshev_gershgorin_bound(A, inv_diag, tmp) : 0;
+    detail::chebyshev_spectral_bounds(A, detail::chebyshev_diagonal_scaling<NumericT>(inv_diag), tag, d1, tmp, gershgorin_bound);
+
+    NumericT theta = NumericT(tag.lambda_max() + tag.lambda_min()) / NumericT(2);
+    NumericT delta = NumericT(tag.lambda_max() - tag.lambda_min()) / NumericT(2);
+    NumericT sigma = theta / delta;
+    NumericT rho   = NumericT(1) / sigma;
+
+    d1 = viennacl::linalg::element_prod(inv_diag, residual);
+    d1 /= theta;
+
+    viennacl::vector<NumericT> * d_in  = &d1;
+    viennacl::vector<NumericT> * d_out = &d2;
+
+    unsigned int check_interval = std::max<unsigned int>(tag.check_interval(), 1);
+    double error = 1;
+    for (unsigned int i = 0; i < tag.max_iterations(); ++i)
+    {
+      NumericT rho_new = NumericT(1) / (NumericT(2) * sigma - rho);
+      detail::chebyshev_step(A, *d_in, *d_out, residual, result, inv_diag, rho_new * rho, NumericT(2) * rho_new / delta, tmp);
+      std::swap(d_in, d_out);
+      rho = rho_new;
+
+      tag.iters(i+1);
+      if ((i+1) % check_interval == 0 || i+1 == tag.max_iterations())
+      {
+        error = viennacl::linalg::norm_2(residual) / norm_rhs;
+        if (error < tag.tolerance())
+          break;
+      }
+    }
+
+    tag.error(error);
+    return result;
+  }
+
+} //namespace detail
+
+
+/** @brief Implementation of the Chebyshev iteration with a general preconditioner M.
+*
+* Requires only one sparse matrix-vector product, one preconditioner application, and vector updates per iteration.
+* The residual norm is only computed every tag.check_interval() iterations.
+*
+* @param A          The system matrix
+* @param rhs        The load vector
+* @param tag        Solver configuration tag, holding the spectral bounds of M^{-1} A (estimated if zero)
+* @param precond    A preconditioner. Precondition operation is done via member function apply()
+* @return The result vector
+*/
+template<typename MatrixT, typename NumericT, typename PreconditionerT>
+viennacl::vector<NumericT> solve(MatrixT const & A, viennacl::vector<NumericT> const & rhs, chebyshev_tag const & tag, PreconditionerT const & precond)
+{
+  viennacl::vector<NumericT> result(rhs.size(), viennacl::traits::context(rhs));
+  viennacl::vector<NumericT> residual(rhs);
+  viennacl::vector<NumericT> d(rhs.size(), viennacl::traits::context(rhs));
+  viennacl::vector<NumericT> z(rhs.size(), viennacl::traits::context(rhs));
+  viennacl::vector<NumericT> tmp(rhs.size(), viennacl::traits::context(rhs));
+  viennacl::traits::clear(result);
+
+  tag.iters(0);
+  tag.error(0);
+
+  NumericT norm_rhs = viennacl::linalg::norm_2(rhs);
+  if (norm_rhs <= 0)
+    return result;
+
+  detail::chebyshev_spectral_bounds(A, precond, tag, d, tmp);
+
+  NumericT theta = NumericT(tag.lambda_max() + tag.lambda_min()) / NumericT(2);
+  NumericT delta = NumericT(tag.lambda_max() - tag.lambda_min()) / NumericT(2);
+  NumericT sigma = theta / delta;
+  NumericT rho   = NumericT(1) / sigma;
+
+  d = residual;
+  precond.apply(d);
+  d /= theta;
+
+  unsigned int check_interval = std::max<unsigned int>(tag.check_interval(), 1);
+  double error = 1;
+  for (unsigned int i = 0; i < tag.max_iterations(); ++i)
+  {
+    result += d;
+    tmp = viennacl::linalg::prod(A, d);
+    residual -= tmp;
+
+    z = residual;
+    precond.apply(z);
+
+    NumericT rho_new = NumericT(1) / (NumericT(2) * sigma - rho);
+    d = (rho_new * rho) * d + (NumericT(2) * rho_new / delta) * z;
+    rho = rho_new;
+
+    tag.iters(i+1);
+    if ((i+1) % check_interval == 0 || i+1 == tag.max_iterations())
+    {
+      error = viennacl::linalg::norm_2(residual) / norm_rhs;
+      if (error < tag.tolerance())
+        break;
+    }
+  }
+
+  tag.error(error);
+  return result;
+}
+
+/** @brief Chebyshev iteration without preconditioner. Each iteration consists of a single fused kernel for a compressed_matrix in host memory. */
+template<typename MatrixT, typename NumericT>
+viennacl::vector<NumericT> solve(MatrixT const & A, viennacl::vector<NumericT> const & rhs, chebyshev_tag const & tag, viennacl::linalg::no_precond)
+{
+  viennacl::vector<NumericT> ones = viennacl::scalar_vector<NumericT>(rhs.size(), NumericT(1), viennacl::traits::context(rhs));
+  return detail::chebyshev_solve(A, rhs, tag, ones);
+}
+
+/** @brief Convenience overload of the Chebyshev iteration without preconditioner */
+template<typename MatrixT, typename NumericT>
+viennacl::vector<NumericT> solve(MatrixT const & A, viennacl::vector<NumericT> const & rhs, chebyshev_tag const & tag)
+{
+  return viennacl::linalg::solve(A, rhs, tag, viennacl::linalg::no_precond());
+}
+
+
+
+/** @brief Chebyshev/Neumann polynomial preconditioner for ViennaCL sparse matrices, can be supplied to solve()-routines.
+*
+* Applies p(D^{-1} A) D^{-1}, where D is the diagonal of A and p is either the Chebyshev polynomial for the interval [lambda_max / ratio, lambda_max] or a truncated Neumann series.
+* Each application requires chebyshev_precond_tag::degree() sparse matrix-vector products, each fused with the vector updates, but no inner products.
+* For a symmetric positive definite system matrix the preconditioner is symmetric positive definite and hence can be used with the CG method.
+*
+* The system matrix is referenced, not copied, so it needs to outlive the preconditioner.
+*/
+template<typename MatrixT>
+class chebyshev_precond
+{
+  typedef typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type  NumericType;
+  typedef viennacl::vector<NumericType>                                                    VectorType;
+
+public:
+  chebyshev_precond(MatrixT const & mat, chebyshev_precond_tag const & tag)
+    : A_(&mat), tag_(tag),
+      inv_diag_(mat.size1(), viennacl::traits::context(mat)),
+      r_(mat.size1(), viennacl::traits::context(mat)),
+      x_(mat.size1(), viennacl::traits::context(mat)),
+      d1_(mat.size1(), viennacl::traits::context(mat)),
+      d2_(mat.size1(), viennacl::traits::context(mat)),
+      tmp_(mat.size1(), viennacl::traits::context(mat))
+  {
+    init(mat);
+  }
+
+  /** @brief Sets up the inverse diagonal and estimates the spectrum of D^{-1} A. Reductions are only required here. */
+  void init(MatrixT const & mat)
+  {
+    A_ = &mat;
+
+    detail::row_info(mat, tmp_, detail::SPARSE_ROW_DIAGONAL);
+    inv_diag_ = viennacl::scalar_vector<NumericType>(mat.size1(), NumericType(1), viennacl::traits::context(mat));
+    inv_diag_ = viennacl::linalg::element_div(inv_diag_, tmp_);
+
+    lambda_max_ = tag_.lambda_max();
+    if (lambda_max_ <= 0)
+      lambda_max_ = std::min(detail::chebyshev_gershgorin_bound(mat, inv_diag_, tmp_),
+                             detail::chebyshev_lambda_max_safety_factor()
+                             * detail::chebyshev_power_iteration(mat, detail::chebyshev_diagonal_scaling<NumericType>(inv_diag_), NumericType(0), tag_.power_iterations(), d1_, d2_));
+    lambda_min_ = lambda_max_ / std::max(tag_.eigenvalue_ratio(), 1.0 + 1e-3);
+  }
+
+  /** @brief Applies the polynomial preconditioner to the vector */
+  template<unsigned int AlignmentV>
+  void apply(viennacl::vector<NumericType, AlignmentV> & vec) const
+  {
+    assert(viennacl::traits::size(inv_diag_) == viennacl::traits::size(vec) && bool("Size mismatch"));
+
+    NumericType theta = NumericType(lambda_max_ + lambda_min_) / NumericType(2);
+    NumericType delta = NumericType(lambda_max_ - lambda_min_) / NumericType(2);
+    NumericType sigma = theta / delta;
+    NumericType rho   = NumericType(1) / sigma;
+
+    if (tag_.degree() == 0)
+    {
+      vec = viennacl::linalg::element_prod(vec, inv_diag_);
+      vec /= theta;
+      return;
+    }
+
+    r_ = vec;
+    d1_ = viennacl::linalg::element_prod(inv_diag_, r_);
+    d1_ /= theta;
+    viennacl::traits::clear(x_);
+
+    VectorType * d_in  = &d1_;
+    VectorType * d_out = &d2_;
+    for (unsigned int i = 0; i < tag_.degree(); ++i)
+    {
+      if (tag_.use_neumann())
+        detail::chebyshev_step(*A_, *d_in, *d_out, r_, x_, inv_diag_, NumericType(0), NumericType(1) / theta, tmp_);
+      else
+      {
+        NumericType rho_new = NumericType(1) / (NumericType(2) * sigma - rho);
+        detail::chebyshev_step(*A_, *d_in, *d_out, r_, x_, inv_diag_, rho_new * rho, NumericType(2) * rho_new / delta, tmp_);
+        rho = rho_new;
+      }
+      std::swap(d_in, d_out);
+    }
+
+    vec = x_ + *d_in;
+  }
+
+  /** @brief Returns the upper end of the interval the polynomial is tuned to */
+  double lambda_max() const { return lambda_max_; }
+  /** @brief Returns the lower end of the interval the polynomial is tuned to */
+  double lambda_min() const { return lambda_min_; }
+
+private:
+  MatrixT const * A_;
+  chebyshev_precond_tag tag_;
+  VectorType inv_diag_;
+  double lambda_min_;
+  double lambda_max_;
+
+  // work vectors:
+  mutable VectorType r_;
+  mutable VectorType x_;
+  mutable VectorType d1_;
+  mutable VectorType d2_;
+  mutable VectorType tmp_;
+};
+
+}
+}
+
+#endif
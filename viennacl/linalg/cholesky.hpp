@@ -0,0 +1,296 @@
+#ifndef VIENNACL_LINALG_CHOLESKY_HPP
+#define VIENNACL_LINALG_CHOLESKY_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/cholesky.hpp
+    @brief Implementation of the Cholesky factorization A = L L^T for symmetric positive definite row-major and column-major dense matrices.
+*/
+
+#include <algorithm>    //for std::min
+#include <vector>
+#include <cmath>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/direct_solve.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+  /** @brief Blocking parameters of cholesky_factorize().
+  *
+  * Each step factors block_size columns. The recursive triangular solves and the updates of the diagonal blocks stop at leaf_size columns.
+  */
+  struct cholesky_blocking
+  {
+    static const vcl_size_t block_size = 128;
+    static const vcl_size_t leaf_size = 16;
+  };
+
+  /** @brief Cholesky factorization of the diagonal block A(k:k+block_size, k:k+block_size) held in a host buffer.
+  *
+  * The buffer holds the rows k, ..., k+block_size-1 (row-major) or the columns k, ..., k+block_size-1 (column-major) of the matrix.
+  * Only the lower triangle of the block is referenced.
+  */
+  template<typename NumericT>
+  void cholesky_factorize_block(std::vector<NumericT> & buffer, bool is_row_major, vcl_size_t internal_size,
+                                vcl_size_t k, vcl_size_t block_size)
+  {
+    vcl_size_t inc_row = is_row_major ? internal_size : 1;
+    vcl_size_t inc_col = is_row_major ? 1 : internal_size;
+    NumericT * data = &(buffer[0]) + k; // entry (k, k)
+
+    for (vcl_size_t j = 0; j < block_size; ++j)
+    {
+      NumericT a_jj = data[j * inc_row + j * inc_col];
+      for (vcl_size_t p = 0; p < j; ++p)
+        a_jj -= data[j * inc_row + p * inc_col] * data[j * inc_row + p * inc_col];
+
+      if (a_jj <= 0)
+        throw "ViennaCL: Matrix not positive definite in Cholesky factorization!";
+
+      NumericT l_jj = std::sqrt(a_jj);
+      data[j * inc_row + j * inc_col] = l_jj;
+
+      for (vcl_size_t i = j + 1; i < block_size; ++i)
+      {
+        NumericT a_ij = data[i * inc_row + j * inc_col];
+        for (vcl_size_t p = 0; p < j; ++p)
+          a_ij -= data[i * inc_row + p * inc_col] * data[j * inc_row + p * inc_col];
+        data[i * inc_row + j * inc_col] = a_ij / l_jj;
+      }
+    }
+  }
+
+  /** @brief Computes X = X L^{-T} for X = A(rows, k:k+block_size) and the lower triangular L stored in A(k:k+block_size, k:k+block_size).
+  *
+  * The diagonal block is split recursively, such that most of the work is carried out by matrix-matrix products.
+  */
+  template<typename NumericT, typename MatrixT>
+  void cholesky_solve_block_column(MatrixT & A, vcl_size_t k, vcl_size_t block_size, viennacl::range const & rows)
+  {
+    if (block_size <= cholesky_blocking::leaf_size)
+    {
+      viennacl::range block_range(k, k + block_size);
+      viennacl::matrix_range<MatrixT> L(A, block_range, block_range);
+      viennacl::matrix_range<MatrixT> X(A, rows, block_range);
+      // call the triangular solver kernel directly, which operates on X^T without creating a transposed copy:
+      viennacl::matrix_expression<const matrix_base<NumericT>, const matrix_base<NumericT>, op_trans> X_trans = trans(X);
+      viennacl::linalg::inplace_solve_kernel(L, X_trans, viennacl::linalg::lower_tag());
+      return;
+    }
+
+    vcl_size_t n1 = block_size / 2;
+    viennacl::range  left_range(k, k + n1);
+    viennacl::range right_range(k + n1, k + block_size);
+
+    cholesky_solve_block_column<NumericT>(A, k, n1, rows);
+
+    viennacl::matrix_range<MatrixT> X_right(A, rows, right_range);
+    X_right -= viennacl::linalg::prod(viennacl::matrix_range<MatrixT>(A, rows, left_range),
+                                      trans(viennacl::matrix_range<MatrixT>(A, right_range, left_range)));
+
+    cholesky_solve_block_column<NumericT>(A, k + n1, block_size - n1, rows);
+  }
+
+  /** @brief Computes the lower triangle of A(j:j+block_size, j:j+block_size) -= L L^T for L = A(j:j+block_size, cols).
+  *
+  * The block is split recursively into two diagonal blocks and the rectangular block below the first one, so the strict upper triangle is never written.
+  */
+  template<typename MatrixT>
+  void cholesky_update_diagonal_block(MatrixT & A, vcl_size_t j, vcl_size_t block_size, viennacl::range const & cols)
+  {
+    if (block_size <= cholesky_blocking::leaf_size)
+    {
+      // one column at a time, starting at the diagonal:
+      for (vcl_size_t i = j; i < j + block_size; ++i)
+      {
+        viennacl::range row_range(i, j + block_size);
+        viennacl::range col_range(i, i + 1);
+        viennacl::matrix_range<MatrixT> A_col(A, row_range, col_range);
+        A_col -= viennacl::linalg::prod(viennacl::matrix_range<MatrixT>(A, row_range, cols),
+                                        trans(viennacl::matrix_range<MatrixT>(A, col_range, cols)));
+      }
+      return;
+    }
+
+    vcl_size_t n1 = block_size / 2;
+    viennacl::range  top_range(j, j + n1);
+    viennacl::range bottom_range(j + n1, j + block_size);
+
+    cholesky_update_diagonal_block(A, j, n1, cols);
+
+    viennacl::matrix_range<MatrixT> A_21(A, bottom_range, top_range);
+    A_21 -= viennacl::linalg::prod(viennacl::matrix_range<MatrixT>(A, bottom_range, cols),
+                                   trans(viennacl::matrix_range<MatrixT>(A, top_range, cols)));
+
+    cholesky_update_diagonal_block(A, j + n1, block_size - n1, cols);
+  }
+}
+
+/** @brief Cholesky factorization A = L L^T of a symmetric positive definite dense matrix.
+*
+* Right-looking blocked algorithm: The diagonal block is factored on the host, the block column of L is obtained from a recursively blocked triangular solve,
+* and only the lower triangle of the trailing matrix is updated (SYRK): Each block column of the trailing matrix is split into its lower triangular diagonal block,
+* which is updated by a recursively blocked triangular product, and the rectangular block below it, which is updated by one matrix-matrix product.
+* For matrices in host memory, the triangular solves and the products are distributed over the OpenMP threads.
+*
+* @param A    The system matrix. Only the lower triangle is read and overwritten with L. The strict upper triangle is left unchanged.
+*/
+template<typename NumericT, typename F, unsigned int AlignmentV>
+void cholesky_factorize(matrix<NumericT, F, AlignmentV> & A)
+{
+  typedef matrix<NumericT, F, AlignmentV>  MatrixType;
+
+  assert(A.size1() == A.size2() && bool("Matrix must be square"));
+
+  vcl_size_t size = A.size1();
+  if (size == 0)
+    return;
+
+  bool is_row_major = viennacl::is_row_major<F>::value;
+  vcl_size_t internal_size = is_row_major ? A.internal_size2() : A.internal_size1();
+
+  vcl_size_t max_block_size = detail::cholesky_blocking::block_size;
+  std::vector<NumericT> temp_buffer(internal_size * max_block_size);
+
+  bool on_host = (viennacl::traits::active_handle_id(A) == viennacl::MAIN_MEMORY);
+  long num_threads = 1;
+#ifdef VIENNACL_WITH_OPENMP
+  num_threads = omp_get_max_threads();
+#endif
+
+  for (vcl_size_t k = 0; k < size; k += max_block_size)
+  {
+    vcl_size_t current_block_size = std::min<vcl_size_t>(size - k, max_block_size);
+
+    viennacl::range     block_range(k, k + current_block_size);
+    viennacl::range remainder_range(k + current_block_size, size);
+
+    //
+    // Factor diagonal block on the host:
+    //
+    viennacl::backend::memory_read(A.handle(),
+                                   sizeof(NumericT) * k                  * internal_size,
+                                   sizeof(NumericT) * current_block_size * internal_size,
+                                   &(temp_buffer[0]));
+
+    detail::cholesky_factorize_block(temp_buffer, is_row_major, internal_size, k, current_block_size);
+
+    viennacl::backend::memory_write(A.handle(),
+                                    sizeof(NumericT) * k                  * internal_size,
+                                    sizeof(NumericT) * current_block_size * internal_size,
+                                    &(temp_buffer[0]));
+
+    if (remainder_range.size() == 0)
+      break;
+
+    //
+    // Compute L_21 = A_21 L_11^{-T}, i.e. L_11 L_21^T = A_21^T
+    //
+    vcl_size_t remainder_start = k + current_block_size;
+    long num_remainder_blocks = static_cast<long>((size - remainder_start - 1) / max_block_size + 1);
+
+    // rows are independent, hence they are distributed over the threads for matrices in host memory:
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(dynamic) if (on_host && num_remainder_blocks > 1 && num_threads > 1)
+#endif
+    for (long block = 0; block < num_remainder_blocks; ++block)
+    {
+      vcl_size_t row_start = remainder_start + static_cast<vcl_size_t>(block) * max_block_size;
+      detail::cholesky_solve_block_column<NumericT>(A, k, current_block_size, viennacl::range(row_start, std::min(row_start + max_block_size, size)));
+    }
+
+    //
+    // Update lower triangle of remainder: A_22 -= L_21 L_21^T, one block column at a time.
+    // The diagonal block of each block column is updated triangle-only, the rows below it by a single product.
+    //
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(dynamic) if (on_host && num_remainder_blocks >= num_threads && num_threads > 1)
+#endif
+    for (long block = 0; block < num_remainder_blocks; ++block)
+    {
+      vcl_size_t col_start = remainder_start + static_cast<vcl_size_t>(block) * max_block_size;
+      vcl_size_t col_end   = std::min(col_start + max_block_size, size);
+
+      detail::cholesky_update_diagonal_block(A, col_start, col_end - col_start, block_range);
+
+      if (col_end < size)
+      {
+        viennacl::range col_range(col_start, col_end);
+        viennacl::range row_range(col_end, size);
+
+        viennacl::matrix_range<MatrixType> A_22(A, row_range, col_range);
+        viennacl::matrix_range<MatrixType> L_left(A, row_range, block_range);
+        viennacl::matrix_range<MatrixType> L_top(A, col_range, block_range);
+
+        A_22 -= viennacl::linalg::prod(L_left, trans(L_top));
+      }
+    }
+  }
+}
+
+
+//
+// Convenience layer:
+//
+
+/** @brief Cholesky substitution for the system L L^T = rhs.
+*
+* @param A    The Cholesky factor L as computed by cholesky_factorize(). Only the lower triangle is referenced.
+* @param B    The matrix of load vectors, where the solution is directly written to
+*/
+template<typename NumericT, typename F1, typename F2, unsigned int AlignmentV1, unsigned int AlignmentV2>
+void cholesky_substitute(matrix<NumericT, F1, AlignmentV1> const & A,
+                         matrix<NumericT, F2, AlignmentV2> & B)
+{
+  assert(A.size1() == A.size2() && bool("Matrix must be square"));
+  assert(A.size1() == B.size1() && bool("Matrix must be square"));
+  inplace_solve(A, B, lower_tag());
+  inplace_solve(trans(A), B, upper_tag());
+}
+
+/** @brief Cholesky substitution for the system L L^T = rhs.
+*
+* @param A      The Cholesky factor L as computed by cholesky_factorize(). Only the lower triangle is referenced.
+* @param vec    The load vector, where the solution is directly written to
+*/
+template<typename NumericT, typename F, unsigned int MatAlignmentV, unsigned int VecAlignmentV>
+void cholesky_substitute(matrix<NumericT, F, MatAlignmentV> const & A,
+                         vector<NumericT, VecAlignmentV> & vec)
+{
+  assert(A.size1() == A.size2() && bool("Matrix must be square"));
+  inplace_solve(A, vec, lower_tag());
+  inplace_solve(trans(A), vec, upper_tag());
+}
+
+}
+}
+
+#endif
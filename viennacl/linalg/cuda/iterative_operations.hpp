@@ -405,6 +405,7 @@ template<typename NumericT>
 __global__ void pipelined_cg_sliced_ell_vec_mul_kernel(const unsigned int * columns_per_block,
                                                        const unsigned int * column_indices,
                                                        const unsigned int * block_start,
+                                                       const unsigned int * row_indices,
                                                        const NumericT * elements,
                                                        const NumericT * p,
                                                        NumericT * Ap,
@@ -434,9 +435,10 @@ __global__ void pipelined_cg_sliced_ell_vec_mul_kernel(const unsigned int * colu
 
     if (row < size)
     {
-      Ap[row] = sum;
+      unsigned int row_index = row_indices[row];
+      Ap[row_index] = sum;
       inner_prod_ApAp += sum * sum;
-      inner_prod_pAp  += sum * p[row];
+      inner_prod_pAp  += sum * p[row_index];
     }
   }
 
@@ -474,6 +476,7 @@ void pipelined_cg_prod(sliced_ell_matrix<NumericT> const & A,
   pipelined_cg_sliced_ell_vec_mul_kernel<<<128, A.rows_per_block()>>>(detail::cuda_arg<unsigned int>(A.handle1().cuda_handle()),
                                                                       detail::cuda_arg<unsigned int>(A.handle2().cuda_handle()),
                                                                       detail::cuda_arg<unsigned int>(A.handle3().cuda_handle()),
+                                                                      detail::cuda_arg<unsigned int>(A.handle4().cuda_handle()),
                                                                       detail::cuda_arg<NumericT>(A.handle().cuda_handle()),
                                                                       detail::cuda_arg<NumericT>(p),
                                                                       detail::cuda_arg<NumericT>(Ap),
@@ -1086,6 +1089,7 @@ template<typename NumericT>
 __global__ void pipelined_bicgstab_sliced_ell_vec_mul_kernel(const unsigned int * columns_per_block,
                                                              const unsigned int * column_indices,
                                                              const unsigned int * block_start,
+                                                             const unsigned int * row_indices,
                                                              const NumericT * elements,
                                                              const NumericT * p,
                                                              NumericT * Ap,
@@ -1118,10 +1122,11 @@ __global__ void pipelined_bicgstab_sliced_ell_vec_mul_kernel(const unsigned int
 
     if (row < size)
     {
-      Ap[row] = sum;
+      unsigned int row_index = row_indices[row];
+      Ap[row_index] = sum;
       inner_prod_ApAp += sum * sum;
-      inner_prod_pAp  += sum * p[row];
-      inner_prod_r0Ap += sum * r0star[row];
+      inner_prod_pAp  += sum * p[row_index];
+      inner_prod_r0Ap += sum * r0star[row_index];
     }
   }
 
@@ -1167,6 +1172,7 @@ void pipelined_bicgstab_prod(sliced_ell_matrix<NumericT> const & A,
   pipelined_bicgstab_sliced_ell_vec_mul_kernel<<<128, A.rows_per_block()>>>(detail::cuda_arg<unsigned int>(A.handle1().cuda_handle()),
                                                                             detail::cuda_arg<unsigned int>(A.handle2().cuda_handle()),
                                                                             detail::cuda_arg<unsigned int>(A.handle3().cuda_handle()),
+                                                                            detail::cuda_arg<unsigned int>(A.handle4().cuda_handle()),
                                                                             detail::cuda_arg<NumericT>(A.handle().cuda_handle()),
                                                                             detail::cuda_arg<NumericT>(p),
                                                                             detail::cuda_arg<NumericT>(Ap),
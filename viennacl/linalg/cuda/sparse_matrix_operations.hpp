@@ -1929,6 +1929,7 @@ template<typename NumericT>
 __global__ void sliced_ell_matrix_vec_mul_kernel(const unsigned int * columns_per_block,
                                                  const unsigned int * column_indices,
                                                  const unsigned int * block_start,
+                                                 const unsigned int * row_indices,
                                                  const NumericT * elements,
                                                  const NumericT * x,
                                                  unsigned int start_x,
@@ -1959,7 +1960,7 @@ __global__ void sliced_ell_matrix_vec_mul_kernel(const unsigned int * columns_pe
     }
 
     if (row < num_rows)
-      result[row * inc_result + start_result] = sum;
+      result[row_indices[row] * inc_result + start_result] = sum;
   }
 }
 
@@ -1979,6 +1980,7 @@ void prod_impl(const viennacl::sliced_ell_matrix<NumericT, IndexT> & mat,
   sliced_ell_matrix_vec_mul_kernel<<<128, mat.rows_per_block()>>>(detail::cuda_arg<unsigned int>(mat.handle1().cuda_handle()),
                                                                   detail::cuda_arg<unsigned int>(mat.handle2().cuda_handle()),
                                                                   detail::cuda_arg<unsigned int>(mat.handle3().cuda_handle()),
+                                                                  detail::cuda_arg<unsigned int>(mat.handle4().cuda_handle()),
                                                                   detail::cuda_arg<NumericT>(mat.handle().cuda_handle()),
                                                                   detail::cuda_arg<NumericT>(vec),
                                                                   static_cast<unsigned int>(vec.start()),
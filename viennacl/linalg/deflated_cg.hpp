@@ -0,0 +1,462 @@
+#ifndef VIENNACL_LINALG_DEFLATED_CG_HPP_
+#define VIENNACL_LINALG_DEFLATED_CG_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/deflated_cg.hpp
+    @brief The deflated conjugate gradient method for sequences of related systems, recycling approximate eigenvectors from one solver run to the next.
+*/
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/tools/shared_ptr.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/detail/multi_rhs.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for the deflated conjugate gradient method. Used for supplying solver parameters, for dispatching the solve() function, and for keeping the recycle space.
+*
+* The recycle space W is a dense matrix whose columns span approximate eigenvectors of the system matrix belonging to the smallest eigenvalues.
+* The solver removes these components from the residuals (Y. Saad, M. Yeung, J. Erhel, F. Guyomarc'h, SIAM J. Sci. Comput. 21(5), 1909-1926 (2000)),
+* so that the slow modes need not be rediscovered in every solver run. At the end of each run, the recycle space is replaced by the Ritz vectors
+* of the space spanned by the old recycle space and the first Lanczos vectors (normalized residuals) of the run.
+* The projection of the system matrix onto the Lanczos vectors is obtained from the coefficients already computed by CG, so the update needs no
+* additional products with the system matrix.
+*
+* The recycle space is discarded if it does not match the size of the system.
+*/
+template<typename NumericT>
+class deflated_cg_tag : public cg_tag
+{
+public:
+  typedef viennacl::matrix<NumericT, viennacl::column_major>   recycle_space_type;
+
+  /** @brief The constructor
+  *
+  * @param tol              Relative tolerance for the residual (solver quits if ||r|| < tol * ||b||)
+  * @param max_iterations   The maximum number of iterations
+  * @param recycle_dim      The number of Ritz vectors kept in the recycle space
+  * @param lanczos_dim      The number of Lanczos vectors of each run used for updating the recycle space
+  */
+  deflated_cg_tag(double tol = 1e-8, unsigned int max_iterations = 300, unsigned int recycle_dim = 8, unsigned int lanczos_dim = 16)
+    : cg_tag(tol, max_iterations), recycle_dim_(recycle_dim), lanczos_dim_(lanczos_dim) {}
+
+  /** @brief Returns the number of Ritz vectors kept in the recycle space */
+  unsigned int recycle_dim() const { return recycle_dim_; }
+  /** @brief Returns the number of Lanczos vectors of each run used for updating the recycle space */
+  unsigned int lanczos_dim() const { return lanczos_dim_; }
+
+  /** @brief Returns true if a recycle space is available */
+  bool has_recycle_space() const { return recycle_space_.get() != NULL; }
+  /** @brief Returns the recycle space (one vector per column). Must only be called if has_recycle_space() returns true. */
+  recycle_space_type const & recycle_space() const { return *recycle_space_; }
+  /** @brief Sets the recycle space (one vector per column), e.g. from a previous run or from a-priori knowledge about the slow modes. Also called by the solver. */
+  void recycle_space(recycle_space_type const & W) const { recycle_space_.reset(new recycle_space_type(W)); }
+  /** @brief Discards the recycle space, e.g. if the system matrix has changed substantially */
+  void clear_recycle_space() const { recycle_space_.reset(); }
+
+private:
+  unsigned int recycle_dim_;
+  unsigned int lanczos_dim_;
+  mutable viennacl::tools::shared_ptr<recycle_space_type> recycle_space_;
+};
+
+namespace detail
+{
+
+  /** @brief Relative pivot threshold for the Cholesky factorizations of the small Gram matrices: Vectors which are numerically linearly dependent on the others are dropped */
+  template<typename NumericT>
+  NumericT deflation_dependence_tolerance() { return NumericT(1000) * std::numeric_limits<NumericT>::epsilon(); }
+
+  /** @brief Computes all eigenvalues and eigenvectors of the small symmetric matrix A (row-major, size n x n) on the host using the cyclic Jacobi method.
+  *
+  * The eigenvectors are stored in the columns of V (row-major, size n x n). A is overwritten.
+  */
+  template<typename NumericT>
+  void deflation_symmetric_eigen(std::vector<NumericT> & A, vcl_size_t n, std::vector<NumericT> & eigenvalues, std::vector<NumericT> & V)
+  {
+    V.assign(n * n, NumericT(0));
+    for (vcl_size_t i = 0; i < n; ++i)
+      V[i*n + i] = NumericT(1);
+
+    for (unsigned int sweep = 0; sweep < 50; ++sweep)
+    {
+      NumericT off_diag = 0;
+      NumericT diag = 0;
+      for (vcl_size_t i = 0; i < n; ++i)
+      {
+        diag += A[i*n + i] * A[i*n + i];
+        for (vcl_size_t j = i + 1; j < n; ++j)
+          off_diag += A[i*n + j] * A[i*n + j];
+      }
+      if (off_diag <= std::numeric_limits<NumericT>::epsilon() * std::numeric_limits<NumericT>::epsilon() * diag)
+        break;
+
+      for (vcl_size_t p = 0; p < n; ++p)
+      {
+        for (vcl_size_t q = p + 1; q < n; ++q)
+        {
+          NumericT a_pq = A[p*n + q];
+          if (a_pq == 0)
+            continue;
+
+          // rotation annihilating A(p,q):
+          NumericT theta = (A[q*n + q] - A[p*n + p]) / (NumericT(2) * a_pq);
+          NumericT t = (theta >= 0 ? NumericT(1) : NumericT(-1)) / (std::fabs(theta) + std::sqrt(theta * theta + NumericT(1)));
+          NumericT c = NumericT(1) / std::sqrt(t * t + NumericT(1));
+          NumericT s = t * c;
+
+          for (vcl_size_t k = 0; k < n; ++k)
+          {
+            NumericT a_kp = A[k*n + p];
+            NumericT a_kq = A[k*n + q];
+            A[k*n + p] = c * a_kp - s * a_kq;
+            A[k*n + q] = s * a_kp + c * a_kq;
+          }
+          for (vcl_size_t k = 0; k < n; ++k)
+          {
+            NumericT a_pk = A[p*n + k];
+            NumericT a_qk = A[q*n + k];
+            A[p*n + k] = c * a_pk - s * a_qk;
+            A[q*n + k] = s * a_pk + c * a_qk;
+          }
+          for (vcl_size_t k = 0; k < n; ++k)
+          {
+            NumericT v_kp = V[k*n + p];
+            NumericT v_kq = V[k*n + q];
+            V[k*n + p] = c * v_kp - s * v_kq;
+            V[k*n + q] = s * v_kp + c * v_kq;
+          }
+        }
+      }
+    }
+
+    eigenvalues.resize(n);
+    for (vcl_size_t i = 0; i < n; ++i)
+      eigenvalues[i] = A[i*n + i];
+  }
+
+  /** @brief Helper for sorting eigenvalues in ascending order while keeping track of their indices */
+  template<typename NumericT>
+  struct deflation_eigenvalue_less
+  {
+    deflation_eigenvalue_less(std::vector<NumericT> const & eigenvalues) : eigenvalues_(eigenvalues) {}
+    bool operator()(vcl_size_t i, vcl_size_t j) const { return eigenvalues_[i] < eigenvalues_[j]; }
+
+    std::vector<NumericT> const & eigenvalues_;
+  };
+
+  /** @brief Computes the Ritz vectors of the system matrix with respect to the columns of S (recycle space followed by the Lanczos vectors)
+  *         for the smallest Ritz values and stores them as the new recycle space in the tag.
+  *
+  * @param S          The old recycle space (first num_recycle columns) followed by num_lanczos Lanczos vectors
+  * @param F          The projection S^T A S of the system matrix (row-major, size (num_recycle+num_lanczos)^2)
+  * @param tag        The solver tag receiving the new recycle space
+  */
+  template<typename NumericT>
+  void deflation_update_recycle_space(viennacl::matrix<NumericT, viennacl::column_major> const & S, vcl_size_t num_columns,
+                                      std::vector<NumericT> F,
+                                      deflated_cg_tag<NumericT> const & tag)
+  {
+    typedef viennacl::matrix<NumericT, viennacl::column_major>   DenseMatrixType;
+
+    vcl_size_t q = num_columns;
+    vcl_size_t new_dim = std::min<vcl_size_t>(tag.recycle_dim(), q);
+    if (new_dim == 0)
+      return;
+
+    viennacl::matrix_range<const DenseMatrixType> S_q(S, viennacl::range(0, S.size1()), viennacl::range(0, q));
+
+    // Gram matrix M = S^T S with M(pivots, pivots) = L L^T. Columns of S which are numerically linearly dependent on the others are dropped:
+    DenseMatrixType tmp_small(q, q, viennacl::traits::context(S));
+    std::vector<NumericT> L;
+    std::vector<vcl_size_t> pivots;
+    detail::multi_rhs_inner_prod(S_q, S_q, tmp_small, L);
+    vcl_size_t rank = detail::multi_rhs_pivoted_cholesky(L, pivots, q, deflation_dependence_tolerance<NumericT>());
+    new_dim = std::min(new_dim, rank);
+    if (new_dim == 0)
+      return;
+
+    // F_r <- L^{-1} F(pivots, pivots) L^{-T}  (symmetric standard eigenvalue problem equivalent to F y = theta M y on the selected columns)
+    std::vector<NumericT> F_r(rank * rank);
+    for (vcl_size_t i = 0; i < rank; ++i)   // F_r <- (L^{-1} F(pivots, pivots))^T
+      for (vcl_size_t j = 0; j < rank; ++j)
+        F_r[j*rank + i] = F[pivots[i]*q + pivots[j]];
+    detail::multi_rhs_lower_solve(L, q, rank, F_r, rank);
+    for (vcl_size_t i = 0; i < rank; ++i)
+      for (vcl_size_t j = i + 1; j < rank; ++j)
+        std::swap(F_r[i*rank + j], F_r[j*rank + i]);
+    detail::multi_rhs_lower_solve(L, q, rank, F_r, rank);
+    for (vcl_size_t i = 0; i < rank; ++i)   // remove round-off asymmetry
+      for (vcl_size_t j = i + 1; j < rank; ++j)
+        F_r[i*rank + j] = F_r[j*rank + i] = (F_r[i*rank + j] + F_r[j*rank + i]) / NumericT(2);
+
+    std::vector<NumericT> eigenvalues;
+    std::vector<NumericT> U;
+    detail::deflation_symmetric_eigen(F_r, rank, eigenvalues, U);
+
+    std::vector<vcl_size_t> order(rank);
+    for (vcl_size_t i = 0; i < rank; ++i)
+      order[i] = i;
+    std::sort(order.begin(), order.end(), deflation_eigenvalue_less<NumericT>(eigenvalues));
+
+    // Y = L^{-T} U(:, smallest) on the selected columns, such that the new recycle space S Y has orthonormal columns:
+    std::vector<NumericT> Y_r(rank * new_dim);
+    for (vcl_size_t i = 0; i < rank; ++i)
+      for (vcl_size_t j = 0; j < new_dim; ++j)
+        Y_r[i*new_dim + j] = U[i*rank + order[j]];
+    detail::multi_rhs_lower_trans_solve(L, q, rank, Y_r, new_dim);
+
+    std::vector<NumericT> Y(q * new_dim, NumericT(0));
+    for (vcl_size_t i = 0; i < rank; ++i)
+      for (vcl_size_t j = 0; j < new_dim; ++j)
+        Y[pivots[i]*new_dim + j] = Y_r[i*new_dim + j];
+
+    DenseMatrixType Y_device(q, new_dim, viennacl::traits::context(S));
+    detail::multi_rhs_copy_to_device(Y, Y_device);
+
+    DenseMatrixType W(S.size1(), new_dim, viennacl::traits::context(S));
+    viennacl::linalg::prod_impl(S_q, Y_device, W, NumericT(1), NumericT(0));
+    tag.recycle_space(W);
+  }
+
+  /** @brief Computes the small vector G^{-1} (X^T v), where the Cholesky factorization of the small matrix G is given by multi_rhs_pivoted_cholesky() */
+  template<typename NumericT>
+  void deflation_project(viennacl::matrix<NumericT, viennacl::column_major> const & X, viennacl::vector<NumericT> const & v,
+                         std::vector<NumericT> const & G_factor, std::vector<vcl_size_t> const & G_pivots,
+                         viennacl::vector<NumericT> & tmp, std::vector<NumericT> & tmp_host,
+                         viennacl::vector<NumericT> & result)
+  {
+    vcl_size_t m = X.size2();
+    tmp = viennacl::linalg::prod(viennacl::trans(X), v);
+    viennacl::fast_copy(tmp, tmp_host);
+    detail::multi_rhs_pivoted_cholesky_solve(G_factor, G_pivots, m, tmp_host, m, 1);
+    viennacl::fast_copy(tmp_host, result);
+  }
+
+}
+
+/** @brief Implementation of the deflated conjugate gradient method (no preconditioner).
+*
+* With the recycle space W stored in the tag, the initial guess is chosen such that the initial residual is orthogonal to W, and the
+* search directions are kept A-orthogonal to W. This requires two products of a tall dense matrix with a vector and a few operations on small
+* dense matrices on the host per iteration. At the end, the recycle space in the tag is updated.
+*
+* @param matrix     The system matrix
+* @param rhs        The load vector
+* @param tag        Solver configuration tag, holding the recycle space
+* @return The result vector
+*/
+template<typename MatrixT, typename NumericT>
+viennacl::vector<NumericT> solve(MatrixT const & matrix, viennacl::vector<NumericT> const & rhs, deflated_cg_tag<NumericT> const & tag)
+{
+  typedef viennacl::matrix<NumericT, viennacl::column_major>   DenseMatrixType;
+
+  vcl_size_t problem_size = rhs.size();
+  viennacl::vector<NumericT> result(problem_size, viennacl::traits::context(rhs));
+  result.clear();
+
+  tag.iters(0);
+  tag.clear_residual_history();
+
+  NumericT norm_rhs = viennacl::linalg::norm_2(rhs);
+  if (norm_rhs == 0) //solution is zero if RHS norm is zero
+  {
+    tag.error(0);
+    return result;
+  }
+
+  if (tag.has_recycle_space() && tag.recycle_space().size1() != problem_size)
+    tag.clear_recycle_space();
+
+  vcl_size_t num_recycle = tag.has_recycle_space() ? tag.recycle_space().size2() : 0;
+  vcl_size_t num_lanczos = std::min<vcl_size_t>(tag.lanczos_dim(), problem_size);
+
+  // old recycle space and Lanczos vectors of this run:
+  DenseMatrixType S(problem_size, num_recycle + std::max<vcl_size_t>(num_lanczos, 1), viennacl::traits::context(rhs));
+
+  viennacl::vector<NumericT> residual(rhs);
+  viennacl::vector<NumericT> p(problem_size, viennacl::traits::context(rhs));
+  viennacl::vector<NumericT> tmp(problem_size, viennacl::traits::context(rhs));
+
+  // deflation data: AW = A * W and the Cholesky factorization of the small matrix G = W^T A W:
+  DenseMatrixType AW;
+  std::vector<NumericT> G;
+  std::vector<NumericT> G_factor;
+  std::vector<vcl_size_t> G_pivots;
+  viennacl::vector<NumericT> mu(std::max<vcl_size_t>(num_recycle, 1), viennacl::traits::context(rhs));
+  viennacl::vector<NumericT> small_tmp(std::max<vcl_size_t>(num_recycle, 1), viennacl::traits::context(rhs));
+  std::vector<NumericT> small_tmp_host(num_recycle);
+
+  if (num_recycle > 0)
+  {
+    DenseMatrixType const & W = tag.recycle_space();
+
+    AW.resize(problem_size, num_recycle, false);
+    detail::multi_rhs_prod(matrix, W, AW);
+
+    DenseMatrixType tmp_small(num_recycle, num_recycle, viennacl::traits::context(rhs));
+    detail::multi_rhs_inner_prod(W, AW, tmp_small, G);
+
+    G_factor = G;
+    if (detail::multi_rhs_pivoted_cholesky(G_factor, G_pivots, num_recycle, detail::deflation_dependence_tolerance<NumericT>()) == num_recycle)
+    {
+      for (vcl_size_t j = 0; j < num_recycle; ++j)
+        detail::multi_rhs_column<NumericT>(S, j) = detail::multi_rhs_column<NumericT>(W, j);
+
+      // x_0 = W (W^T A W)^{-1} W^T b,  r_0 = b - A W (W^T A W)^{-1} W^T b
+      detail::deflation_project(W, rhs, G_factor, G_pivots, small_tmp, small_tmp_host, mu);
+      result = viennacl::linalg::prod(W, mu);
+      residual -= viennacl::linalg::prod(AW, mu);
+    }
+    else // W^T A W (numerically) singular: recycle space unusable
+    {
+      tag.clear_recycle_space();
+      num_recycle = 0;
+    }
+  }
+
+  // p_0 = r_0 - W (W^T A W)^{-1} (AW)^T r_0
+  p = residual;
+  if (num_recycle > 0)
+  {
+    detail::deflation_project(AW, residual, G_factor, G_pivots, small_tmp, small_tmp_host, mu);
+    p -= viennacl::linalg::prod(tag.recycle_space(), mu);
+  }
+
+  NumericT ip_rr = viennacl::linalg::inner_prod(residual, residual);
+  std::vector<NumericT> alphas;
+  std::vector<NumericT> betas;
+  vcl_size_t lanczos_size = 0;
+
+  for (unsigned int i = 0; i < tag.max_iterations() && std::sqrt(ip_rr) / norm_rhs >= tag.tolerance(); ++i)
+  {
+    tag.iters(i+1);
+
+    if (i < num_lanczos) // Lanczos vector (-1)^i r_i / ||r_i||
+    {
+      detail::multi_rhs_column<NumericT>(S, num_recycle + i) = ((i % 2) ? NumericT(-1) : NumericT(1)) / std::sqrt(ip_rr) * residual;
+      lanczos_size = i + 1;
+    }
+
+    tmp = viennacl::linalg::prod(matrix, p);
+    NumericT alpha = ip_rr / viennacl::linalg::inner_prod(tmp, p);
+
+    result += alpha * p;
+    residual -= alpha * tmp;
+
+    NumericT new_ip_rr = viennacl::linalg::inner_prod(residual, residual);
+    NumericT beta = new_ip_rr / ip_rr;
+    ip_rr = new_ip_rr;
+
+    alphas.push_back(alpha);
+    betas.push_back(beta);
+
+    tag.record_residual(std::sqrt(ip_rr) / norm_rhs);
+    if (std::sqrt(ip_rr) / norm_rhs < tag.tolerance())
+      break;
+
+    p = residual + beta * p;
+    if (num_recycle > 0)
+    {
+      detail::deflation_project(AW, residual, G_factor, G_pivots, small_tmp, small_tmp_host, mu);
+      p -= viennacl::linalg::prod(tag.recycle_space(), mu);
+    }
+  }
+
+  //store last error estimate:
+  tag.error(std::sqrt(ip_rr) / norm_rhs);
+
+  //
+  // Update of the recycle space: Rayleigh-Ritz on span(W, Z), where Z are the Lanczos vectors of this run.
+  // With C = (AW)^T Z and the tridiagonal Lanczos matrix T built from the CG coefficients:
+  //   S^T A S = [ W^T A W      C             ]
+  //             [ C^T      T + C^T G^{-1} C ]
+  //
+  if (lanczos_size > 0)
+  {
+    vcl_size_t q = num_recycle + lanczos_size;
+    std::vector<NumericT> F(q * q, NumericT(0));
+
+    for (vcl_size_t j = 0; j < lanczos_size; ++j)
+    {
+      vcl_size_t jj = num_recycle + j;
+      F[jj*q + jj] = NumericT(1) / alphas[j] + ((j > 0) ? betas[j-1] / alphas[j-1] : NumericT(0));
+      if (j + 1 < lanczos_size)
+        F[jj*q + jj + 1] = F[(jj+1)*q + jj] = std::sqrt(betas[j]) / alphas[j];
+    }
+
+    if (num_recycle > 0)
+    {
+      viennacl::matrix_range<DenseMatrixType> Z(S, viennacl::range(0, problem_size), viennacl::range(num_recycle, q));
+      DenseMatrixType tmp_small(num_recycle, lanczos_size, viennacl::traits::context(rhs));
+      std::vector<NumericT> C;
+      detail::multi_rhs_inner_prod(AW, Z, tmp_small, C);
+
+      for (vcl_size_t i = 0; i < num_recycle; ++i)
+      {
+        for (vcl_size_t j = 0; j < num_recycle; ++j)
+          F[i*q + j] = G[i*num_recycle + j];
+        for (vcl_size_t j = 0; j < lanczos_size; ++j)
+          F[i*q + num_recycle + j] = F[(num_recycle + j)*q + i] = C[i*lanczos_size + j];
+      }
+
+      // C^T G^{-1} C:
+      std::vector<NumericT> Ginv_C(C);
+      detail::multi_rhs_pivoted_cholesky_solve(G_factor, G_pivots, num_recycle, Ginv_C, num_recycle, lanczos_size);
+      for (vcl_size_t j1 = 0; j1 < lanczos_size; ++j1)
+        for (vcl_size_t j2 = 0; j2 < lanczos_size; ++j2)
+        {
+          NumericT value = 0;
+          for (vcl_size_t i = 0; i < num_recycle; ++i)
+            value += C[i*lanczos_size + j1] * Ginv_C[i*lanczos_size + j2];
+          F[(num_recycle + j1)*q + num_recycle + j2] += value;
+        }
+    }
+
+    detail::deflation_update_recycle_space(S, q, F, tag);
+  }
+
+  return result;
+}
+
+/** @brief Convenience overload of the deflated conjugate gradient method for the no_precond case */
+template<typename MatrixT, typename NumericT>
+viennacl::vector<NumericT> solve(MatrixT const & matrix, viennacl::vector<NumericT> const & rhs, deflated_cg_tag<NumericT> const & tag, viennacl::linalg::no_precond)
+{
+  return viennacl::linalg::solve(matrix, rhs, tag);
+}
+
+}
+}
+
+#endif
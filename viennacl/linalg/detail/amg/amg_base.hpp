@@ -24,18 +24,23 @@
     AMG code contributed by Markus Wagner
 */
 
+#include <boost/numeric/ublas/matrix_sparse.hpp>
 #include <boost/numeric/ublas/operation.hpp>
 #include <boost/numeric/ublas/vector.hpp>
 #include <cmath>
-#include <set>
-#include <list>
+#include <vector>
 #include <algorithm>
+#include <cassert>
 
 #include <map>
 #ifdef VIENNACL_WITH_OPENMP
 #include <omp.h>
 #endif
 
+#include "viennacl/forwards.h"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/backend/memory.hpp"
+
 #include "amg_debug.hpp"
 
 #define VIENNACL_AMG_COARSE_RS 1
@@ -47,6 +52,8 @@
 #define VIENNACL_AMG_INTERPOL_CLASSIC 2
 #define VIENNACL_AMG_INTERPOL_AG 3
 #define VIENNACL_AMG_INTERPOL_SA 4
+#define VIENNACL_AMG_SMOOTHER_JACOBI 1
+#define VIENNACL_AMG_SMOOTHER_GAUSS_SEIDEL 2
 
 namespace viennacl
 {
@@ -72,6 +79,7 @@ public:
   * @param coarselevels  Number of coarse levels that are constructed
   *      (Default: 0 = Optimize coarse levels for direct solver such that coarsest level has a maximum of COARSE_LIMIT points)
   *      (Note: Coarsening stops when number of coarse points = 0 and overwrites the parameter with actual number of coarse levels)
+  * @param smoother  Smoother routine (Default: VIENNACL_AMG_SMOOTHER_JACOBI). VIENNACL_AMG_SMOOTHER_GAUSS_SEIDEL selects multicolor Gauss-Seidel (forward sweeps for presmoothing, backward sweeps for postsmoothing), available for compressed_matrix only.
   */
   amg_tag(unsigned int coarse = 1,
           unsigned int interpol = 1,
@@ -80,10 +88,11 @@ public:
           double jacobiweight = 1,
           unsigned int presmooth = 1,
           unsigned int postsmooth = 1,
-          unsigned int coarselevels = 0)
+          unsigned int coarselevels = 0,
+          unsigned int smoother = VIENNACL_AMG_SMOOTHER_JACOBI)
   : coarse_(coarse), interpol_(interpol),
     threshold_(threshold), interpolweight_(interpolweight), jacobiweight_(jacobiweight),
-    presmooth_(presmooth), postsmooth_(postsmooth), coarselevels_(coarselevels) {}
+    presmooth_(presmooth), postsmooth_(postsmooth), coarselevels_(coarselevels), smoother_(smoother) {}
 
   // Getter-/Setter-Functions
   void set_coarse(unsigned int coarse) { coarse_ = coarse; }
@@ -110,1068 +119,397 @@ public:
   void set_coarselevels(unsigned int coarselevels)  { coarselevels_ = coarselevels; }
   unsigned int get_coarselevels() const { return coarselevels_; }
 
+  void set_smoother(unsigned int smoother) { smoother_ = smoother; }
+  unsigned int get_smoother() const { return smoother_; }
+
 private:
   unsigned int coarse_, interpol_;
   double threshold_, interpolweight_, jacobiweight_;
-  unsigned int presmooth_, postsmooth_, coarselevels_;
-};
-
-/** @brief A class for a scalar that can be written to the sparse matrix or sparse vector datatypes.
-*  @brief Values are only written to those datatypes if non-zero to optimize memory usage and performance.
-*  @brief Needed for the []- and ()-operators.
-*/
-template<typename InternalT, typename IteratorT, typename NumericT>
-class amg_nonzero_scalar
-{
-private:
-  InternalT *m_;
-  IteratorT iter_;
-  unsigned int i_,j_;
-  NumericT s_;
-
-public:
-  amg_nonzero_scalar();
-
-  /** @brief The constructor.
-  *  @param m    Pointer to the sparse vector/matrix the scalar will be written to
-  *  @param iter    Iterator pointing to the respective element in the vector/matrix if available
-  *  @param i    Row index scalar will be written to
-  *  @param j    Col index scalar will be written to
-  *  @param s    Value of the scalar (usually used as dummy here as it will be set by the assignment operator)
-  */
-  amg_nonzero_scalar(InternalT *m,
-                     IteratorT & iter,
-                     unsigned int i,
-                     unsigned int j,
-                     NumericT s = 0): m_(m), iter_(iter), i_(i), j_(j), s_(s) {}
-
-  /** @brief Assignment operator. Writes value into matrix at the given position.
-  *  @param value  Value that will be written
-  */
-  NumericT operator=(const NumericT value)
-  {
-    s_ = value;
-    // Only write if scalar is nonzero
-    if (s_ == 0) return s_;
-    // Write to m_ using iterator iter_ or indices (i_,j_)
-    m_->addscalar(iter_,i_,j_,s_);
-    return s_;
-  }
-
-  /** @brief Addition operator. Adds a constant.
-  *  @param value  Value that will be written
-  */
-  NumericT operator+=(const NumericT value)
-  {
-    // If zero is added, then no change necessary
-    if (value == 0)
-      return s_;
-
-    s_ += value;
-    // Remove entry if resulting scalar is zero
-    if (s_ == 0)
-    {
-      m_->removescalar(iter_,i_);
-      return s_;
-    }
-    //Write to m_ using iterator iter_ or indices (i_,j_)
-    m_->addscalar(iter_,i_,j_,s_);
-    return s_;
-  }
-  NumericT operator++(int)
-  {
-    s_++;
-    if (s_ == 0)
-      m_->removescalar(iter_,i_);
-    m_->addscalar (iter_,i_,j_,s_);
-    return s_;
-  }
-  NumericT operator++()
-  {
-    s_++;
-    if (s_ == 0)
-      m_->removescalar(iter_,i_);
-    m_->addscalar(iter_,i_,j_,s_);
-    return s_;
-  }
-  operator NumericT(void) { return s_; }
-};
-
-/** @brief Defines an iterator for the sparse vector type.
-*/
-template<typename InternalT>
-class amg_sparsevector_iterator
-{
-private:
-  typedef amg_sparsevector_iterator<InternalT> self_type;
-  typedef typename InternalT::mapped_type      ScalarType;
-
-  InternalT &                  internal_vec_;
-  typename InternalT::iterator iter_;
-
-public:
-
-  /** @brief The constructor.
-  *  @param vec    Internal sparse vector
-  *  @param begin  Whether the iterator starts at the beginning or end of vec
-  */
-  amg_sparsevector_iterator(InternalT & vec, bool begin=true): internal_vec_(vec)
-  {
-    if (begin)
-      iter_ = internal_vec_.begin();
-    else
-      iter_ = internal_vec_.end();
-  }
-
-  bool operator == (self_type other)
-  {
-    if (iter_ == other.iter_)
-      return true;
-    else
-      return false;
-  }
-  bool operator != (self_type other)
-  {
-    if (iter_ != other.iter_)
-      return true;
-    else
-      return false;
-  }
-
-  self_type const & operator ++ () const { iter_++; return *this; }
-  self_type       & operator ++ ()       { iter_++; return *this; }
-  self_type const & operator -- () const { iter_--; return *this; }
-  self_type       & operator -- ()       { iter_--; return *this; }
-  ScalarType const & operator * () const { return (*iter_).second; }
-  ScalarType       & operator * ()       { return (*iter_).second; }
-  unsigned int index() const { return (*iter_).first; }
-  unsigned int index()       { return (*iter_).first; }
+  unsigned int presmooth_, postsmooth_, coarselevels_, smoother_;
 };
 
-/** @brief A class for the sparse vector type.
-*/
-template<typename NumericT>
-class amg_sparsevector
+/** @brief Turns the row counts stored in the first v.size()-1 entries into offsets (exclusive prefix sum). The total is stored in the last entry, whose previous value is ignored. */
+inline void amg_exclusive_scan(std::vector<unsigned int> & v)
 {
-public:
-  typedef NumericT value_type;
-
-private:
-  // A map is used internally which saves all non-zero elements with pairs of (index,value)
-  typedef std::map<unsigned int, NumericT>   InternalType;
-  typedef amg_sparsevector<NumericT>         self_type;
-  typedef amg_nonzero_scalar<self_type,typename InternalType::iterator, NumericT> NonzeroScalarType;
-
-  // Size is only a dummy variable. Not needed for internal map structure but for compatible vector interface.
-  unsigned int size_;
-  InternalType internal_vector_;
-
-public:
-  typedef amg_sparsevector_iterator<InternalType> iterator;
-  typedef typename InternalType::const_iterator const_iterator;
-
-public:
-  /** @brief The constructor.
-  *  @param size    Size of the vector
-  */
-  amg_sparsevector(unsigned int size = 0): size_(size) {}
-
-  void resize(unsigned int size) { size_ = size; }
-  unsigned int size() const { return size_;}
-
-  // Returns number of non-zero entries in vector equal to the size of the underlying map.
-  unsigned int internal_size() const { return static_cast<unsigned int>(internal_vector_.size()); }
-  // Delete underlying map.
-  void clear() { internal_vector_.clear();  }
-  // Remove entry at position i.
-  void remove(unsigned int i) { internal_vector_.erase(i); }
-
-  // Add s to the entry at position i
-  void add(unsigned int i, NumericT s)
-  {
-    typename InternalType::iterator iter = internal_vector_.find(i);
-    // If there is no entry at position i, add new entry at that position
-    if (iter == internal_vector_.end())
-      addscalar(iter,i,i,s);
-    else
-    {
-      s += (*iter).second;
-      // If new value is zero, then erase the entry, otherwise write new value
-      if (s != 0)
-        (*iter).second = s;
-      else
-        internal_vector_.erase(iter);
-    }
-  }
-
-  // Write to the map. Is called from non-zero scalar type.
-  template<typename IteratorT>
-  void addscalar(IteratorT & iter, unsigned int i, unsigned int /* j */, NumericT s)
-  {
-    // Don't write if value is zero
-    if (s == 0)
-      return;
-
-    // If entry is already present, overwrite value, otherwise make new entry
-    if (iter != internal_vector_.end())
-      (*iter).second = s;
-    else
-      internal_vector_[i] = s;
-  }
-
-  // Remove value from the map. Is called from non-zero scalar type.
-  template<typename IteratorT>
-  void removescalar(IteratorT & iter, unsigned int /* i */) { internal_vector_.erase(iter); }
-
-  // Bracket operator. Returns non-zero scalar type with actual values of the respective entry which calls addscalar/removescalar after value is altered.
-  NonzeroScalarType operator [] (unsigned int i)
-  {
-    typename InternalType::iterator it = internal_vector_.find(i);
-    // If value is already present then build non-zero scalar with actual value, otherwise 0.
-    if (it != internal_vector_.end())
-      return NonzeroScalarType(this,it,i,i,(*it).second);
-    else
-      return NonzeroScalarType(this,it,i,i,0);
-  }
-
-  // Use internal data structure directly for read-only access. No need to use non-zero scalar as no write access possible.
-  NumericT operator [] (unsigned int i) const
-  {
-    const_iterator it = internal_vector_.find(i);
-
-    if (it != internal_vector_.end())
-      return (*it).second;
-    else
-      return 0;
-  }
-
-  // Iterator functions.
-        iterator begin()       { return iterator(internal_vector_); }
-  const_iterator begin() const { return internal_vector_.begin(); }
-        iterator end()       { return iterator(internal_vector_, false); }
-  const_iterator end() const { return internal_vector_.end(); }
-
-  // checks whether value at index i is nonzero. More efficient than doing [] == 0.
-  bool isnonzero(unsigned int i) const { return internal_vector_.find(i) != internal_vector_.end();  }
-
-  // Copies data into a ublas vector type.
-  operator boost::numeric::ublas::vector<NumericT>(void)
+  unsigned int sum = 0;
+  for (std::size_t i=0; i+1<v.size(); ++i)
   {
-    boost::numeric::ublas::vector<NumericT> vec (size_);
-    for (iterator iter = begin(); iter != end(); ++iter)
-      vec [iter.index()] = *iter;
-    return vec;
+    unsigned int tmp = v[i];
+    v[i] = sum;
+    sum += tmp;
   }
-};
+  v[v.size()-1] = sum;
+}
 
-/** @brief A class for the sparse matrix type.
-*  Uses vector of maps as data structure for higher performance and lower memory usage.
-*  Uses similar interface as ublas::compressed_matrix.
-*  Can deal with transposed of matrix internally: Creation, Storage, Iterators, etc.
+/** @brief A class for the sparse matrix type used in the setup phase.
+*  Stores the matrix in compressed sparse row (CSR) format using three flat arrays, where the column indices are sorted within each row.
+*  All setup routines operate on these arrays directly, so rows can be processed in parallel without allocations per nonzero entry.
 */
 template<typename NumericT>
 class amg_sparsematrix
 {
 public:
   typedef NumericT value_type;
-private:
-  typedef std::map<unsigned int,NumericT> RowType;
-  typedef std::vector<RowType>            InternalType;
-  typedef amg_sparsematrix<NumericT>      self_type;
-
-  // Adapter is used for certain functionality, especially iterators.
-  typedef typename viennacl::tools::sparse_matrix_adapter<NumericT>                AdapterType;
-  typedef typename viennacl::tools::const_sparse_matrix_adapter<NumericT>     ConstAdapterType;
-
-  // Non-zero scalar is used to write to the matrix.
-  typedef amg_nonzero_scalar<self_type,typename RowType::iterator, NumericT> NonzeroScalarType;
-
-  // Holds matrix coefficients.
-  InternalType internal_mat_;
-  // Holds matrix coefficient of transposed matrix if built.
-  // Note: Only internal_mat is written using operators and methods while internal_mat_trans is built from internal_mat using do_trans().
-  InternalType internal_mat_trans_;
-  // Saves sizes.
-  vcl_size_t s1_, s2_;
-
-  // True if the transposed of the matrix is used (for calculations, iteration, etc.).
-  bool transposed_mode_;
-  // True if the transposed is already built (saved in internal_mat_trans) and also up to date (no changes to internal_mat).
-  bool transposed_;
-
-public:
-  typedef typename AdapterType::iterator1                     iterator1;
-  typedef typename AdapterType::iterator2                     iterator2;
-  typedef typename ConstAdapterType::const_iterator1    const_iterator1;
-  typedef typename ConstAdapterType::const_iterator2    const_iterator2;
 
   /** @brief Standard constructor. */
-  amg_sparsematrix()
-  {
-    transposed_mode_ = false;
-    transposed_ = false;
-  }
+  amg_sparsematrix() : s1_(0), s2_(0), row_buffer_(1, 0) {}
 
-  /** @brief Constructor. Builds matrix of size (i,j).
+  /** @brief Constructor. Builds an empty matrix of size (i,j).
     * @param i  Size of first dimension
     * @param j  Size of second dimension
     */
-  amg_sparsematrix(unsigned int i, unsigned int j)
-  {
-    AdapterType a(internal_mat_, i, j);
-    a.resize(i,j,false);
-    AdapterType a_trans(internal_mat_trans_, j, i);
-    a_trans.resize(j,i,false);
-    s1_ = i;
-    s2_ = j;
-    a.clear();
-    a_trans.clear();
-    transposed_mode_ = false;
-    transposed_      = false;
-  }
+  amg_sparsematrix(unsigned int i, unsigned int j) : s1_(i), s2_(j), row_buffer_(i+1, 0) {}
 
   /** @brief Constructor. Builds matrix via std::vector<std::map> by copying memory
-  * (Only necessary feature of this other matrix type is to have const iterators)
   * @param mat  Vector of maps
   */
-  amg_sparsematrix(std::vector<std::map<unsigned int, NumericT> > const & mat)
+  amg_sparsematrix(std::vector<std::map<unsigned int, NumericT> > const & mat) : s1_(mat.size()), s2_(mat.size()), row_buffer_(mat.size()+1, 0)
   {
-    AdapterType a (internal_mat_, mat.size(), mat.size());
-    AdapterType a_trans (internal_mat_trans_, mat.size(), mat.size());
-    a.resize(mat.size(), mat.size());
-    a_trans.resize(mat.size(), mat.size());
+    for (std::size_t i=0; i<mat.size(); ++i)
+      row_buffer_[i+1] = row_buffer_[i] + static_cast<unsigned int>(mat[i].size());
 
-    internal_mat_ = mat;
-    s1_ = s2_ = mat.size();
-
-    transposed_mode_ = false;
-    transposed_      = false;
+    col_buffer_.resize(row_buffer_[s1_]);
+    elements_.resize(row_buffer_[s1_]);
+    for (std::size_t i=0; i<mat.size(); ++i)
+    {
+      unsigned int k = row_buffer_[i];
+      for (typename std::map<unsigned int, NumericT>::const_iterator it = mat[i].begin(); it != mat[i].end(); ++it, ++k)
+      {
+        col_buffer_[k] = it->first;
+        elements_[k]   = it->second;
+      }
+    }
   }
 
-  /** @brief Constructor. Builds matrix via another matrix type.
-    * (Only necessary feature of this other matrix type is to have const iterators)
+  /** @brief Constructor. Builds matrix via another matrix type. Explicit zeros are not stored.
+    * (Only necessary feature of this other matrix type is to have const iterators which traverse each row with increasing column index)
     * @param mat  Matrix
     */
   template<typename MatrixT>
-  amg_sparsematrix(MatrixT const & mat)
+  explicit amg_sparsematrix(MatrixT const & mat) : s1_(mat.size1()), s2_(mat.size2()), row_buffer_(mat.size1()+1, 0)
   {
-    AdapterType a(internal_mat_, mat.size1(), mat.size2());
-    AdapterType a_trans(internal_mat_trans_, mat.size2(), mat.size1());
-    a.resize(mat.size1(), mat.size2());
-    a_trans.resize(mat.size2(), mat.size1());
-    s1_ = mat.size1();
-    s2_ = mat.size2();
-    a.clear();
-    a_trans.clear();
-
     for (typename MatrixT::const_iterator1 row_iter = mat.begin1(); row_iter != mat.end1(); ++row_iter)
-    {
       for (typename MatrixT::const_iterator2 col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-      {
         if (*col_iter != 0)
-        {
-          unsigned int x = static_cast<unsigned int>(col_iter.index1());
-          unsigned int y = static_cast<unsigned int>(col_iter.index2());
-          a(x,y) = *col_iter;
-          a_trans(y,x) = *col_iter;
-        }
-      }
-    }
-    transposed_mode_ = false;
-    transposed_ = true;
-  }
-
-  // Build transposed of the current matrix.
-  void do_trans()
-  {
-    // Do it only once if called in a parallel section
-  #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp critical
-  #endif
-    {
-      // Only build transposed if it is not built or not up to date
-      if (!transposed_)
-      {
-        // Mode has to be set to standard mode temporarily
-        bool save_mode = transposed_mode_;
-        transposed_mode_ = false;
-
-        for (iterator1 row_iter = begin1(); row_iter != end1(); ++row_iter)
-          for (iterator2 col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-            internal_mat_trans_[col_iter.index2()][static_cast<unsigned int>(col_iter.index1())] = *col_iter;
+          ++row_buffer_[col_iter.index1() + 1];
 
-        transposed_mode_ = save_mode;
-        transposed_ = true;
-      }
-    }
-  } //do_trans()
-
-  // Set transposed mode (true=transposed, false=regular)
-  void set_trans(bool mode)
-  {
-    transposed_mode_ = mode;
-    if (mode)
-      do_trans();
-  }
-
-  bool get_trans() const { return transposed_mode_; }
-
-  // Checks whether coefficient (i,j) is non-zero. More efficient than using (i,j) == 0.
-  bool isnonzero (unsigned int i, unsigned int j) const
-  {
-    if (!transposed_mode_)
-    {
-      if (internal_mat_[i].find(j) != internal_mat_[i].end())
-        return true;
-      else
-        return false;
-    }
-    else
-    {
-      if (internal_mat_[j].find(i) != internal_mat_[j].end())
-        return true;
-      else
-        return false;
-    }
-  } //isnonzero()
-
-  // Add s to value at (i,j)
-  void add(unsigned int i, unsigned int j, NumericT s)
-  {
-    // If zero is added then do nothing.
-    if (s == 0)
-      return;
-
-    typename RowType::iterator col_iter = internal_mat_[i].find(j);
-    // If there is no entry at position (i,j), then make new entry.
-    if (col_iter == internal_mat_[i].end())
-      addscalar(col_iter,i,j,s);
-    else
-    {
-      s += (*col_iter).second;
-      // Update value and erase entry if value is zero.
-      if (s != 0)
-        (*col_iter).second = s;
-      else
-        internal_mat_[i].erase(col_iter);
-    }
-    transposed_ = false;
-  } //add()
-
-  // Write to the internal data structure. Is called from non-zero scalar type.
-  template<typename IteratorT>
-  void addscalar(IteratorT & iter, unsigned int i, unsigned int j, NumericT s)
-  {
-    // Don't write if value is zero
-    if (s == 0)
-      return;
+    for (std::size_t i=0; i<s1_; ++i)
+      row_buffer_[i+1] += row_buffer_[i];
 
-    if (iter != internal_mat_[i].end())
-      (*iter).second = s;
-    else
-      internal_mat_[i][j] = s;
+    col_buffer_.resize(row_buffer_[s1_]);
+    elements_.resize(row_buffer_[s1_]);
 
-    transposed_ = false;
+    std::vector<unsigned int> row_pos(row_buffer_.begin(), row_buffer_.end() - 1);
+    for (typename MatrixT::const_iterator1 row_iter = mat.begin1(); row_iter != mat.end1(); ++row_iter)
+      for (typename MatrixT::const_iterator2 col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+        if (*col_iter != 0)
+        {
+          unsigned int k = row_pos[col_iter.index1()]++;
+          col_buffer_[k] = static_cast<unsigned int>(col_iter.index2());
+          elements_[k]   = *col_iter;
+        }
   }
 
-  // Remove entry from internal data structure. Is called from non-zero scalar type.
-  template<typename IteratorT>
-  void removescalar(IteratorT & iter, unsigned int i)
+  /** @brief Resizes the matrix. All entries are discarded. */
+  void resize(unsigned int i, unsigned int j)
   {
-    internal_mat_[i].erase(iter);
-    transposed_ = false;
+    s1_ = i;
+    s2_ = j;
+    row_buffer_.assign(i+1, 0);
+    col_buffer_.clear();
+    elements_.clear();
   }
 
-  // Return non-zero scalar at position (i,j). Value is written to the non-zero scalar and updated via addscalar()/removescalar().
-  NonzeroScalarType operator()(unsigned int i, unsigned int j)
+  /** @brief Allocates the column and value arrays for the row offsets currently stored in row_buffer(). */
+  void reserve_from_row_buffer()
   {
-    typename RowType::iterator iter;
-
-    if (!transposed_mode_)
-    {
-      iter = internal_mat_[i].find(j);
-      if (iter != internal_mat_[i].end())
-        return NonzeroScalarType(this,iter,i,j,(*iter).second);
-      else
-        return NonzeroScalarType(this,iter,i,j,0);
-    }
-    else
-    {
-      iter = internal_mat_[j].find(i);
-      if (iter != internal_mat_[j].end())
-        return NonzeroScalarType(this,iter,j,i,(*iter).second);
-      else
-        return NonzeroScalarType(this,iter,j,i,0);
-    }
+    col_buffer_.resize(row_buffer_[s1_]);
+    elements_.resize(row_buffer_[s1_]);
   }
 
-  // For read-only access return the actual value directly. Non-zero datatype not needed as no write access possible.
-  NumericT operator()(unsigned int i, unsigned int j) const
+  /** @brief Removes unused entries at the end of each row.
+  *
+  *  Row i is assumed to hold row_lengths[i] valid entries starting at row_buffer()[i]. Entries are moved to the front such that the rows are contiguous again.
+  */
+  void compress(std::vector<unsigned int> const & row_lengths)
   {
-    typename RowType::const_iterator iter;
-
-    if (!transposed_mode_)
-    {
-      iter = internal_mat_[i].find(j);
-      if (iter != internal_mat_[i].end())
-        return (*iter).second;
-      else
-        return 0;
-    }
-    else
+    unsigned int k = 0;
+    for (std::size_t i=0; i<s1_; ++i)
     {
-      iter = internal_mat_[j].find(i);
-      if (iter != internal_mat_[j].end())
-        return (*iter).second;
-      else
-        return 0;
+      unsigned int row_start = row_buffer_[i];
+      row_buffer_[i] = k;
+      if (row_start != k)
+        for (unsigned int j=0; j<row_lengths[i]; ++j)
+        {
+          col_buffer_[k+j] = col_buffer_[row_start+j];
+          elements_[k+j]   = elements_[row_start+j];
+        }
+      k += row_lengths[i];
     }
+    row_buffer_[s1_] = k;
+    col_buffer_.resize(k);
+    elements_.resize(k);
   }
 
-  void resize(unsigned int i, unsigned int j, bool preserve = true)
-  {
-    AdapterType a (internal_mat_);
-    a.resize(i,j,preserve);
-    AdapterType a_trans (internal_mat_trans_);
-    a_trans.resize(j,i,preserve);
-    s1_ = i;
-    s2_ = j;
-  }
-
-  void clear()
-  {
-    AdapterType a(internal_mat_, s1_, s2_);
-    a.clear();
-    AdapterType a_trans(internal_mat_trans_, s2_, s1_);
-    a_trans.clear();
-    transposed_ = true;
-  }
+  vcl_size_t size1() const { return s1_; }
+  vcl_size_t size2() const { return s2_; }
+  vcl_size_t nnz()   const { return row_buffer_[s1_]; }
 
-  vcl_size_t size1()
-  {
-    if (!transposed_mode_)
-      return s1_;
-    else
-      return s2_;
-  }
+  std::vector<unsigned int>       & row_buffer()       { return row_buffer_; }
+  std::vector<unsigned int> const & row_buffer() const { return row_buffer_; }
+  std::vector<unsigned int>       & col_buffer()       { return col_buffer_; }
+  std::vector<unsigned int> const & col_buffer() const { return col_buffer_; }
+  std::vector<NumericT>           & elements()         { return elements_; }
+  std::vector<NumericT>     const & elements()   const { return elements_; }
 
-  vcl_size_t size1() const
-  {
-    if (!transposed_mode_)
-      return s1_;
-    else
-      return s2_;
-  }
+  // Checks whether coefficient (i,j) is non-zero.
+  bool isnonzero(unsigned int i, unsigned int j) const { return find(i, j) != row_buffer_[i+1]; }
 
-
-  vcl_size_t size2()
+  // Returns the value at (i,j). Uses a binary search in row i.
+  NumericT operator()(unsigned int i, unsigned int j) const
   {
-    if (!transposed_mode_)
-      return s2_;
-    else
-      return s1_;
+    unsigned int k = find(i, j);
+    return (k != row_buffer_[i+1]) ? elements_[k] : NumericT(0);
   }
 
-  vcl_size_t size2() const
+  /** @brief Computes the transposed matrix. Rows of the result are sorted by construction.
+  *
+  *  The rows are split into contiguous blocks. Each block counts its entries per column first, such that all blocks can then be scattered in parallel.
+  */
+  void trans(amg_sparsematrix & result) const
   {
-    if (!transposed_mode_)
-      return s2_;
-    else
-      return s1_;
-  }
+    result.resize(static_cast<unsigned int>(s2_), static_cast<unsigned int>(s1_));
 
-  iterator1 begin1(bool trans = false)
-  {
-    if (!trans && !transposed_mode_)
-    {
-      AdapterType a(internal_mat_, s1_, s2_);
-      return a.begin1();
-    }
-    else
-    {
-      do_trans();
-      AdapterType a_trans(internal_mat_trans_, s2_, s1_);
-      return a_trans.begin1();
-    }
-  }
+    long blocks = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    blocks = std::max<long>(1, std::min<long>(omp_get_max_threads(), static_cast<long>(s1_)));
+#endif
 
-  iterator1 end1(bool trans = false)
-  {
-    if (!trans && !transposed_mode_)
-    {
-      AdapterType a(internal_mat_, s1_, s2_);
-      return a.end1();
-    }
-    else
+    // block_pos[b*s2_ + j]: Number of entries in column j within row block b, later the position of the next entry of block b in row j of the result
+    std::vector<unsigned int> block_pos(static_cast<std::size_t>(blocks) * s2_);
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long b=0; b<blocks; ++b)
     {
-      //do_trans();
-      AdapterType a_trans(internal_mat_trans_, s2_, s1_);
-      return a_trans.end1();
+      unsigned int * pos = &(block_pos[0]) + static_cast<std::size_t>(b) * s2_;
+      for (std::size_t k=row_buffer_[(b * s1_) / blocks]; k<row_buffer_[((b+1) * s1_) / blocks]; ++k)
+        ++pos[col_buffer_[k]];
     }
-  }
 
-  iterator2 begin2(bool trans = false)
-  {
-    if (!trans && !transposed_mode_)
-    {
-      AdapterType a(internal_mat_, s1_, s2_);
-      return a.begin2();
-    }
-    else
+    std::vector<unsigned int> & result_row_buffer = result.row_buffer();
+    unsigned int offset = 0;
+    for (std::size_t j=0; j<s2_; ++j)
     {
-      do_trans();
-      AdapterType a_trans(internal_mat_trans_, s2_, s1_);
-      return a_trans.begin2();
+      result_row_buffer[j] = offset;
+      for (long b=0; b<blocks; ++b)
+      {
+        unsigned int tmp = block_pos[static_cast<std::size_t>(b) * s2_ + j];
+        block_pos[static_cast<std::size_t>(b) * s2_ + j] = offset;
+        offset += tmp;
+      }
     }
-  }
+    result_row_buffer[s2_] = offset;
+    result.reserve_from_row_buffer();
 
-  iterator2 end2(bool trans = false)
-  {
-    if (!trans && !transposed_mode_)
-    {
-      AdapterType a(internal_mat_, s1_, s2_);
-      return a.end2();
-    }
-    else
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long b=0; b<blocks; ++b)
     {
-      //do_trans();
-      AdapterType a_trans(internal_mat_trans_, s2_, s1_);
-      return a_trans.end2();
+      unsigned int * pos = &(block_pos[0]) + static_cast<std::size_t>(b) * s2_;
+      for (std::size_t i=(b * s1_) / blocks; i<((b+1) * s1_) / blocks; ++i)
+        for (unsigned int k=row_buffer_[i]; k<row_buffer_[i+1]; ++k)
+        {
+          unsigned int p = pos[col_buffer_[k]]++;
+          result.col_buffer()[p] = static_cast<unsigned int>(i);
+          result.elements()[p]   = elements_[k];
+        }
     }
   }
 
-  const_iterator1 begin1() const
-  {
-    // Const_iterator of transposed can only be used if transposed matrix is already built and up to date.
-    assert((!transposed_mode_ || (transposed_mode_ && transposed_)) && bool("Error: Cannot build const_iterator when transposed has not been built yet!"));
-    ConstAdapterType a_const(internal_mat_, s1_, s2_);
-    return a_const.begin1();
-  }
-
-  const_iterator1 end1(bool trans = false) const
-  {
-    assert((!transposed_mode_ || (transposed_mode_ && transposed_)) && bool("Error: Cannot build const_iterator when transposed has not been built yet!"));
-    ConstAdapterType a_const(internal_mat_, trans ? s2_ : s1_, trans ? s1_ : s2_);
-    return a_const.end1();
-  }
-
-  const_iterator2 begin2(bool trans = false) const
+  /** @brief Returns true if both matrices have the same size and the same sparsity pattern. */
+  bool same_pattern(amg_sparsematrix const & other) const
   {
-    assert((!transposed_mode_ || (transposed_mode_ && transposed_)) && bool("Error: Cannot build const_iterator when transposed has not been built yet!"));
-    ConstAdapterType a_const(internal_mat_, trans ? s2_ : s1_, trans ? s1_ : s2_);
-    return a_const.begin2();
+    return s1_ == other.s1_ && s2_ == other.s2_ && row_buffer_ == other.row_buffer_ && col_buffer_ == other.col_buffer_;
   }
 
-  const_iterator2 end2(bool trans = false) const
+  void swap(amg_sparsematrix & other)
   {
-    assert((!transposed_mode_ || (transposed_mode_ && transposed_)) && bool("Error: Cannot build const_iterator when transposed has not been built yet!"));
-    ConstAdapterType a_const(internal_mat_, trans ? s2_ : s1_, trans ? s1_ : s2_);
-    return a_const.end2();
+    std::swap(s1_, other.s1_);
+    std::swap(s2_, other.s2_);
+    row_buffer_.swap(other.row_buffer_);
+    col_buffer_.swap(other.col_buffer_);
+    elements_.swap(other.elements_);
   }
 
-  // Returns pointer to the internal data structure. Improves performance of copy operation to GPU.
-  std::vector<std::map<unsigned int, NumericT> > * get_internal_pointer()
+  operator boost::numeric::ublas::compressed_matrix<NumericT>(void) const
   {
-    if (!transposed_mode_)
-      return &internal_mat_;
-
-    if (!transposed_)
-      do_trans();
-    return &internal_mat_trans_;
-  }
-
-  operator boost::numeric::ublas::compressed_matrix<NumericT>(void)
-  {
-    boost::numeric::ublas::compressed_matrix<NumericT> mat;
-    mat.resize(size1(), size2(), false);
-    mat.clear();
-
-    for (iterator1 row_iter = begin1(); row_iter != end1(); ++row_iter)
-        for (iterator2 col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-          mat(col_iter.index1(), col_iter.index2()) = *col_iter;
-
+    boost::numeric::ublas::compressed_matrix<NumericT> mat(s1_, s2_, nnz());
+    for (std::size_t i=0; i<s1_; ++i)
+      for (unsigned int k=row_buffer_[i]; k<row_buffer_[i+1]; ++k)
+        mat.push_back(i, col_buffer_[k], elements_[k]);
     return mat;
   }
 
-  operator boost::numeric::ublas::matrix<NumericT>(void)
-  {
-    boost::numeric::ublas::matrix<NumericT> mat;
-    mat.resize(size1(), size2(), false);
-    mat.clear();
-
-    for (iterator1 row_iter = begin1(); row_iter != end1(); ++row_iter)
-      for (iterator2 col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-        mat(col_iter.index1(), col_iter.index2()) = *col_iter;
-
-    return mat;
-  }
-};
-
-/** @brief A class for the AMG points.
-*   Saves point index and influence measure
-*  Holds information whether point is undecided, C or F point.
-*  Holds lists of points that are influenced by or influencing this point
-*/
-class amg_point
-{
 private:
-  typedef amg_sparsevector<amg_point*> ListType;
-
-  unsigned int index_;
-  unsigned int influence_;
-  // Determines whether point is undecided.
-  bool undecided_;
-  // Determines wheter point is C point (true) or F point (false).
-  bool cpoint_;
-  unsigned int coarse_index_;
-  // Index offset of parallel coarsening. In that case a point acts as if it had an index of index_-offset_ and treats other points as if they had an index of index+offset_
-  unsigned int offset_;
-  // Aggregate the point belongs to.
-  unsigned int aggregate_;
-
-  // Holds all points influencing this point.
-  ListType influencing_points_;
-  // Holds all points that are influenced by this point.
-  ListType influenced_points_;
-
-public:
-  typedef ListType::iterator iterator;
-  typedef ListType::const_iterator const_iterator;
-
-  /** @brief The constructor.
-  */
-  amg_point (unsigned int index, unsigned int size): index_(index), influence_(0), undecided_(true), cpoint_(false), coarse_index_(0), offset_(0), aggregate_(0)
-  {
-    influencing_points_ = ListType(size);
-    influenced_points_ = ListType(size);
-  }
-
-  void set_offset(unsigned int offset) { offset_ = offset; }
-  unsigned int get_offset() { return offset_; }
-  void set_index(unsigned int index) { index_ = index+offset_; }
-  unsigned int get_index() const { return index_-offset_;  }
-  unsigned int get_influence() const { return influence_;  }
-  void set_aggregate(unsigned int aggregate) { aggregate_ = aggregate; }
-  unsigned int get_aggregate () { return aggregate_; }
-
-  bool is_cpoint() const { return cpoint_ && !undecided_;  }
-  bool is_fpoint() const { return !cpoint_ && !undecided_; }
-  bool is_undecided() const { return undecided_; }
-
-  // Returns number of influencing points
-  unsigned int number_influencing() const  { return influencing_points_.internal_size(); }
-  // Returns true if *point is influencing this point
-  bool is_influencing(amg_point* point) const { return influencing_points_.isnonzero(point->get_index()+offset_); }
-  // Add *point to influencing points
-  void add_influencing_point(amg_point* point) { influencing_points_[point->get_index()+offset_] = point;  }
-  // Add *point to influenced points
-  void add_influenced_point(amg_point* point) { influenced_points_[point->get_index()+offset_] = point; }
-
-  // Clear influencing points
-  void clear_influencing() { influencing_points_.clear(); }
-  // Clear influenced points
-  void clear_influenced() {influenced_points_.clear(); }
-
-
-  unsigned int get_coarse_index() const { return coarse_index_; }
-  void set_coarse_index(unsigned int index) { coarse_index_ = index; }
-
-  // Calculates the initial influence measure equal to the number of influenced points.
-  void calc_influence() { influence_ = influenced_points_.internal_size();  }
-
-  // Add to influence measure.
-  unsigned int add_influence(unsigned int add)
+  unsigned int find(unsigned int i, unsigned int j) const
   {
-    influence_ += add;
-    return influence_;
+    std::vector<unsigned int>::const_iterator row_begin = col_buffer_.begin() + row_buffer_[i];
+    std::vector<unsigned int>::const_iterator row_end   = col_buffer_.begin() + row_buffer_[i+1];
+    std::vector<unsigned int>::const_iterator it = std::lower_bound(row_begin, row_end, j);
+    return (it != row_end && *it == j) ? static_cast<unsigned int>(it - col_buffer_.begin()) : row_buffer_[i+1];
   }
-  // Make this point C point. Only call via amg_pointvector.
-  void make_cpoint()
-  {
-    undecided_ = false;
-    cpoint_ = true;
-    influence_ = 0;
-  }
-  // Make this point F point. Only call via amg_pointvector.
-  void make_fpoint()
-  {
-    undecided_ = false;
-    cpoint_ = false;
-    influence_ = 0;
-  }
-  // Switch point from F to C point. Only call via amg_pointvector.
-  void switch_ftoc() { cpoint_ = true; }
-
-  // Iterator handling for influencing and influenced points.
-  iterator begin_influencing() { return influencing_points_.begin(); }
-  iterator end_influencing() { return influencing_points_.end(); }
-  const_iterator begin_influencing() const { return influencing_points_.begin(); }
-  const_iterator end_influencing() const { return influencing_points_.end(); }
-  iterator begin_influenced() { return influenced_points_.begin();  }
-  iterator end_influenced() { return influenced_points_.end(); }
-  const_iterator begin_influenced() const { return influenced_points_.begin(); }
-  const_iterator end_influenced() const { return influenced_points_.end(); }
-};
 
-/** @brief Comparison class for the sorted set of points in amg_pointvector. Set is sorted by influence measure from lower to higher with the point-index as tie-breaker.
-*/
-struct classcomp
-{
-  // Function returns true if l comes before r in the ordering.
-  bool operator() (amg_point* l, amg_point* r) const
-  {
-    // Map is sorted by influence number starting with the highest
-    // If influence number is the same then lowest point index comes first
-    return (l->get_influence() < r->get_influence() || (l->get_influence() == r->get_influence() && l->get_index() > r->get_index()));
-  }
+  vcl_size_t s1_, s2_;
+  std::vector<unsigned int> row_buffer_;
+  std::vector<unsigned int> col_buffer_;
+  std::vector<NumericT>     elements_;
 };
 
 /** @brief A class for the AMG points.
-*  Holds pointers of type amg_point in a vector that can be accessed using [point-index].
-*  Additional list of pointers sorted by influence number and index to improve coarsening performance (see amg_coarse_classic_onepass() in amg_coarse.hpp)
-*  Constructs indices for C points on the coarse level, needed for interpolation.
+*  Stores the point type (undecided, C or F point), the coarse level index and the aggregate of each point in flat arrays.
+*  The strong influences are kept in CSR format: Row i of the influencing lists holds all points that strongly influence point i,
+*  row i of the influenced lists holds all points that are strongly influenced by point i. Both lists are sorted by point index.
 */
 class amg_pointvector
 {
-private:
-  // Type for the sorted list
-  typedef std::set<amg_point*,classcomp> ListType;
-  // Type for the vector of pointers
-  typedef std::vector<amg_point*>        VectorType;
-
-  VectorType pointvector_;
-  ListType pointlist_;
-  unsigned int size_;
-  unsigned int c_points_, f_points_;
-
 public:
-  typedef VectorType::iterator               iterator;
-  typedef VectorType::const_iterator   const_iterator;
+  enum point_type { POINT_UNDECIDED = 0, POINT_C, POINT_F };
 
   /** @brief The constructor.
   *  @param size    Number of points
   */
-  amg_pointvector(unsigned int size = 0): size_(size)
-  {
-    pointvector_ = VectorType(size);
-    c_points_ = f_points_ = 0;
-  }
+  amg_pointvector(unsigned int size = 0) : size_(size), point_types_(size, POINT_UNDECIDED), coarse_index_(size, 0), aggregate_(size, 0),
+                                           influencing_offsets_(size+1, 0), influencing_points_(1, 0),
+                                           influenced_offsets_(size+1, 0), influenced_points_(1, 0), c_points_(0), f_points_(0) {}
 
-  // Construct all the points dynamically and save pointers into vector.
-  void init_points()
-  {
-    for (unsigned int i=0; i<size(); ++i)
-      pointvector_[i] = new amg_point(i,size());
-  }
-  // Delete all the points.
-  void delete_points()
-  {
-    for (unsigned int i=0; i<size(); ++i)
-      delete pointvector_[i];
-  }
-  // Add point to the vector. Note: User has to make sure that point at point->get_index() does not exist yet, otherwise it will be overwritten!
-  void add_point(amg_point *point)
-  {
-    pointvector_[point->get_index()] = point;
-    if (point->is_cpoint()) c_points_++;
-    else if (point->is_fpoint()) f_points_++;
-  }
+  unsigned int size() const { return size_; }
 
-  // Update C and F count for point *point.
-  // Necessary if C and F points were constructed outside this data structure (e.g. by parallel coarsening RS0 or RS3).
-  void update_cf(amg_point *point)
-  {
-    if (point->is_cpoint()) c_points_++;
-    else if (point->is_fpoint()) f_points_++;
-  }
-  // Clear the C and F point count.
-  void clear_cf() { c_points_ = f_points_ = 0; }
+  bool is_cpoint(unsigned int i)    const { return point_types_[i] == POINT_C; }
+  bool is_fpoint(unsigned int i)    const { return point_types_[i] == POINT_F; }
+  bool is_undecided(unsigned int i) const { return point_types_[i] == POINT_UNDECIDED; }
 
-  // Clear both point lists.
-  void clear_influencelists()
+  // Changing the point type does not update the C and F point counts. Call update_cf() once all points are decided.
+  void make_cpoint(unsigned int i) { point_types_[i] = POINT_C; }
+  void make_fpoint(unsigned int i) { point_types_[i] = POINT_F; }
+  void switch_ftoc(unsigned int i) { point_types_[i] = POINT_C; }
+
+  // Recompute the C and F point counts.
+  void update_cf()
   {
-    for (iterator iter = pointvector_.begin(); iter != pointvector_.end(); ++iter)
+    long c_points = 0, f_points = 0;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for reduction(+: c_points, f_points)
+#endif
+    for (long i=0; i<static_cast<long>(size_); ++i)
     {
-      (*iter)->clear_influencing();
-      (*iter)->clear_influenced();
+      if (point_types_[i] == POINT_C)
+        ++c_points;
+      else if (point_types_[i] == POINT_F)
+        ++f_points;
     }
+    c_points_ = static_cast<unsigned int>(c_points);
+    f_points_ = static_cast<unsigned int>(f_points);
   }
 
-  amg_point* operator[](unsigned int i) const { return pointvector_[i]; }
-  iterator begin() { return pointvector_.begin(); }
-  iterator end() { return pointvector_.end(); }
-  const_iterator begin() const { return pointvector_.begin(); }
-  const_iterator end() const { return pointvector_.end(); }
-
-  void resize(unsigned int size)
-  {
-    size_ = size;
-    pointvector_ = VectorType(size);
-  }
-  unsigned int size() const { return size_; }
-
   // Returns number of C points
   unsigned int get_cpoints() const { return c_points_; }
   // Returns number of F points
   unsigned int get_fpoints() const { return f_points_; }
 
-  // Does the initial sorting of points into the list. Sorting is automatically done by the std::set data type.
-  void sort()
-  {
-    for (iterator iter = begin(); iter != end(); ++iter)
-      pointlist_.insert(*iter);
-  }
-  // Returns the point with the highest influence measure
-  amg_point* get_nextpoint()
-  {
-    // No points remaining? Return NULL such that coarsening will stop.
-    if (pointlist_.size() == 0)
-      return NULL;
-    // If point with highest influence measure (end of the list) has measure of zero, then no further C points can be constructed. Return NULL.
-    if ((*(--pointlist_.end()))->get_influence() == 0)
-      return NULL;
-    // Otherwise, return the point with highest influence measure located at the end of the list.
-    else
-      return *(--pointlist_.end());
-  }
-  // Add "add" to influence measure for point *point in the sorted list.
-  void add_influence(amg_point* point, unsigned int add)
-  {
-    ListType::iterator iter = pointlist_.find(point);
-    // If point is not in the list then stop.
-    if (iter == pointlist_.end()) return;
-
-    // Point has to be erased first as changing the value does not re-order the std::set
-    pointlist_.erase(iter);
-    point->add_influence(add);
-
-    // Insert point back into the list. Using the iterator improves performance. The new position has to be at the same position or to the right of the old.
-    pointlist_.insert(point);
-  }
-  // Make *point to C point and remove from sorted list
-  void make_cpoint(amg_point* point)
-  {
-    pointlist_.erase(point);
-    point->make_cpoint();
-    c_points_++;
-  }
-  // Make *point to F point and remove from sorted list
-  void make_fpoint(amg_point* point)
-  {
-    pointlist_.erase(point);
-    point->make_fpoint();
-    f_points_++;
-  }
-  // Swich *point from F to C point
-  void switch_ftoc(amg_point* point)
-  {
-    point->switch_ftoc();
-    c_points_++;
-    f_points_--;
-  }
-
-  // Build vector of indices for C point on the coarse level.
+  // Build vector of indices for C point on the coarse level. C points keep their relative order.
   void build_index()
   {
     unsigned int count = 0;
-    // Use simple counter for index creation.
-    for (iterator iter = pointvector_.begin(); iter != pointvector_.end(); ++iter)
+    for (unsigned int i=0; i<size_; ++i)
     {
-      // Set index on coarse level using counter variable
-      if ((*iter)->is_cpoint())
-      {
-        (*iter)->set_coarse_index(count);
-        count++;
-      }
+      if (point_types_[i] == POINT_C)
+        coarse_index_[i] = count++;
     }
   }
+  unsigned int get_coarse_index(unsigned int i) const { return coarse_index_[i]; }
 
-  // Return information for debugging purposes
-  template<typename MatrixT>
-  void get_influence_matrix(MatrixT & mat) const
-  {
-    mat = MatrixT(size(),size());
-    mat.clear();
+  void set_aggregate(unsigned int i, unsigned int aggregate) { aggregate_[i] = aggregate; }
+  unsigned int get_aggregate(unsigned int i) const { return aggregate_[i]; }
 
-    for (const_iterator row_iter = begin(); row_iter != end(); ++row_iter)
-      for (amg_point::iterator col_iter = (*row_iter)->begin_influencing(); col_iter != (*row_iter)->end_influencing(); ++col_iter)
-        mat((*row_iter)->get_index(),(*col_iter)->get_index()) = true;
-  }
-  template<typename VectorT>
-  void get_influence(VectorT & vec) const
-  {
-    vec = VectorT(size_);
-    vec.clear();
+  // Strong influences in CSR format. Filled by the coarsening routines: Write the offsets first, then call reserve_influencing() and fill the points.
+  std::vector<unsigned int> & influencing_offsets() { return influencing_offsets_; }
+  std::vector<unsigned int> & influencing_points()  { return influencing_points_; }
 
-    for (const_iterator iter = begin(); iter != end(); ++iter)
-      vec[(*iter)->get_index()] = (*iter)->get_influence();
-  }
-  template<typename VectorT>
-  void get_sorting(VectorT & vec) const
-  {
-    vec = VectorT(pointlist_.size());
-    vec.clear();
-    unsigned int i=0;
+  // Allocates the influencing lists for the offsets stored in influencing_offsets(). Holds an additional sentinel entry such that begin_influencing()/end_influencing() are also valid for empty lists.
+  void reserve_influencing() { influencing_points_.resize(influencing_offsets_[size_] + 1); }
 
-    for (ListType::const_iterator iter = pointlist_.begin(); iter != pointlist_.end(); ++iter)
-    {
-      vec[i] = (*iter)->get_index();
-      i++;
-    }
-  }
-  template<typename VectorT>
-  void get_C(VectorT & vec) const
-  {
-    vec = VectorT(size_);
-    vec.clear();
+  unsigned int const * begin_influencing(unsigned int i) const { return &(influencing_points_[0]) + influencing_offsets_[i]; }
+  unsigned int const * end_influencing(unsigned int i)   const { return &(influencing_points_[0]) + influencing_offsets_[i+1]; }
+  unsigned int const * begin_influenced(unsigned int i)  const { return &(influenced_points_[0]) + influenced_offsets_[i]; }
+  unsigned int const * end_influenced(unsigned int i)    const { return &(influenced_points_[0]) + influenced_offsets_[i+1]; }
 
-    for (const_iterator iter = begin(); iter != end(); ++iter)
-    {
-      if ((*iter)->is_cpoint())
-        vec[(*iter)->get_index()] = true;
-    }
+  // Returns number of influencing points
+  unsigned int number_influencing(unsigned int i) const { return influencing_offsets_[i+1] - influencing_offsets_[i]; }
+  // Returns number of influenced points
+  unsigned int number_influenced(unsigned int i)  const { return influenced_offsets_[i+1] - influenced_offsets_[i]; }
+
+  // Returns true if point j strongly influences point i
+  bool is_influencing(unsigned int i, unsigned int j) const
+  {
+    return std::binary_search(influencing_points_.begin() + influencing_offsets_[i], influencing_points_.begin() + influencing_offsets_[i+1], j);
   }
-  template<typename VectorT>
-  void get_F(VectorT & vec) const
+
+  // Builds the influenced lists as the transpose of the influencing lists.
+  void build_influenced()
   {
-    vec = VectorT(size_);
-    vec.clear();
+    influenced_offsets_.assign(size_+1, 0);
+    for (unsigned int k=0; k<influencing_offsets_[size_]; ++k)
+      ++influenced_offsets_[influencing_points_[k] + 1];
+    for (unsigned int i=0; i<size_; ++i)
+      influenced_offsets_[i+1] += influenced_offsets_[i];
 
-    for (const_iterator iter = begin(); iter != end(); ++iter)
-    {
-      if ((*iter)->is_fpoint())
-        vec[(*iter)->get_index()] = true;
-    }
+    influenced_points_.resize(influenced_offsets_[size_] + 1);
+    std::vector<unsigned int> pos(influenced_offsets_.begin(), influenced_offsets_.end() - 1);
+    for (unsigned int i=0; i<size_; ++i)
+      for (unsigned int k=influencing_offsets_[i]; k<influencing_offsets_[i+1]; ++k)
+        influenced_points_[pos[influencing_points_[k]]++] = i;
   }
-  template<typename MatrixT>
-  void get_Aggregates(MatrixT & mat) const
+
+  // Clear the influenced lists and release their memory. They are only needed during coarsening.
+  void clear_influenced()
   {
-    mat = MatrixT(size_,size_);
-    mat.clear();
+    std::vector<unsigned int>(size_+1, 0).swap(influenced_offsets_);
+    std::vector<unsigned int>(1, 0).swap(influenced_points_);
+  }
 
-    for (const_iterator iter = begin(); iter != end(); ++iter)
-    {
-      if (!(*iter)->is_undecided())
-        mat((*iter)->get_aggregate(),(*iter)->get_index()) = true;
-    }
+  // Clear both point lists and release their memory.
+  void clear_influencelists()
+  {
+    std::vector<unsigned int>(size_+1, 0).swap(influencing_offsets_);
+    std::vector<unsigned int>(size_+1, 0).swap(influenced_offsets_);
+    std::vector<unsigned int>(1, 0).swap(influencing_points_);
+    std::vector<unsigned int>(1, 0).swap(influenced_points_);
   }
+
+private:
+  unsigned int size_;
+  std::vector<char>         point_types_;
+  std::vector<unsigned int> coarse_index_;
+  std::vector<unsigned int> aggregate_;
+
+  std::vector<unsigned int> influencing_offsets_;
+  std::vector<unsigned int> influencing_points_;
+  std::vector<unsigned int> influenced_offsets_;
+  std::vector<unsigned int> influenced_points_;
+
+  unsigned int c_points_, f_points_;
 };
 
 /** @brief A class for the matrix slicing for parallel coarsening schemes (RS0/RS3).
-  * @brief Holds information on a per-processor basis and offers functionality to slice and join the data structures.
+  * @brief Holds the index ranges of the points assigned to each thread on all levels.
   */
-template<typename InternalT1, typename InternalT2>
 class amg_slicing
 {
-  typedef typename InternalT1::value_type    SparseMatrixType;
-  typedef typename InternalT2::value_type    PointVectorType;
-
 public:
-  // Data structures on a per-processor basis.
-  boost::numeric::ublas::vector<InternalT1> A_slice_;
-  boost::numeric::ublas::vector<InternalT2> pointvector_slice_;
-  // Holds the offsets showing the indices for which a new slice begins.
-  boost::numeric::ublas::vector<boost::numeric::ublas::vector<unsigned int> > offset_;
+  // offset_[level][i] is the first point of slice i on the respective level. offset_[level][threads_] holds the total number of points.
+  std::vector<std::vector<unsigned int> > offset_;
 
   unsigned int threads_;
   unsigned int levels_;
@@ -1181,7 +519,7 @@ public:
     // Either use the number of threads chosen by the user or the maximum number of threads available on the processor.
     if (threads == 0)
   #ifdef VIENNACL_WITH_OPENMP
-      threads_ = omp_get_num_procs();
+      threads_ = static_cast<unsigned int>(omp_get_num_procs());
   #else
     threads_ = 1;
   #endif
@@ -1190,220 +528,390 @@ public:
 
     levels_ = levels;
 
-    A_slice_.resize(threads_);
-    pointvector_slice_.resize(threads_);
-    // Offset has threads_+1 entries to also hold the total size
-    offset_.resize(threads_+1);
-
-    for (unsigned int i=0; i<threads_; ++i)
-    {
-      A_slice_[i].resize(levels_);
-      pointvector_slice_[i].resize(levels_);
-      // Offset needs one more level for the build-up of the next offset
-      offset_[i].resize(levels_+1);
-    }
-    offset_[threads_].resize(levels_+1);
+    // Offset needs one more level for the build-up of the next offset
+    offset_.resize(levels_+1);
+    for (unsigned int i=0; i<=levels_; ++i)
+      offset_[i].resize(threads_+1);
   } //init()
 
-  // Slice matrix A into as many parts as threads are used.
-  void slice(unsigned int level, InternalT1 const & A, InternalT2 const & pointvector)
+  // On the finest level, slice the points into as many ranges of (almost) equal size as threads are used.
+  // On coarser levels the slicing is determined by the C points of each slice on the finer level (points stay together on the same thread on all levels).
+  void slice(unsigned int level, unsigned int size)
   {
-    // On the finest level, build a new slicing first.
     if (level == 0)
-      slice_new(level, A);
-
-    // On coarser levels use the same slicing as on the finest level (Points stay together on the same thread on all levels).
-    // This is necessary as due to interpolation and galerkin product there only exist connections between points on the same thread on coarser levels.
-    // Note: Offset is determined in amg_coarse_rs0() after fine level was built.
-    slice_build(level, A, pointvector);
-  }
-
-  // Join point data structure into Pointvector
-  void join(unsigned int level, InternalT2 & pointvector) const
-  {
-    typedef typename InternalT2::value_type PointVectorType;
-
-    // Reset index offset of all points and update overall C and F point count
-    pointvector[level].clear_cf();
-    for (typename PointVectorType::iterator iter = pointvector[level].begin(); iter != pointvector[level].end(); ++iter)
     {
-      (*iter)->set_offset(0);
-      pointvector[level].update_cf(*iter);
+      // Pieces 0,...,threads-2 have equal size while the last one might be greater.
+      for (unsigned int i=0; i<threads_; ++i)
+        offset_[level][i] = i * (size / threads_);
+      offset_[level][threads_] = size;
     }
   }
 
-private:
-  /** @brief Slices mat into this->threads parts of (almost) equal size
-  * @param level    Level for which slicing is requested
-  * @param A     System matrix on all levels
-  */
-  void slice_new(unsigned int level, InternalT1 const & A)
+  // Determine the slicing on the next level from the C points on each slice.
+  void build_next(unsigned int level, amg_pointvector const & pointvector)
   {
-    // Determine index offset of all the slices (index of A[level] when the respective slice starts).
-  #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for
-  #endif
-    for (long i=0; i<=static_cast<long>(threads_); ++i)
+    offset_[level+1][0] = 0;
+    for (unsigned int i=0; i<threads_; ++i)
     {
-      // Offset of first piece is zero. Pieces 1,...,threads-1 have equal size while the last one might be greater.
-      if (i == 0) offset_[i][level] = 0;
-      else if (i == threads_) offset_[i][level] = static_cast<unsigned int>(A[level].size1());
-      else offset_[i][level] = static_cast<unsigned int>(i*(A[level].size1()/threads_));
+      unsigned int c_points = 0;
+      for (unsigned int j=offset_[level][i]; j<offset_[level][i+1]; ++j)
+        if (pointvector.is_cpoint(j))
+          ++c_points;
+      offset_[level+1][i+1] = offset_[level+1][i] + c_points;
     }
   }
+};
 
-  /** @brief Slices mat into pieces determined by this->Offset
-  * @param level    Level to which Slices are saved
-  * @param A     System matrix on all levels
-  * @param Pointvector  Vector of points on all levels
-  */
-  void slice_build(unsigned int level, InternalT1 const & A, InternalT2 const & pointvector)
-  {
-    typedef typename SparseMatrixType::const_iterator1 ConstRowIterator;
-    typedef typename SparseMatrixType::const_iterator2 ConstColIterator;
+/** @brief Copies an internal sparse matrix to a host matrix type providing resize(), clear() and operator()(i,j) (e.g. ublas). */
+template<typename NumericT, typename MatrixT>
+void amg_copy(amg_sparsematrix<NumericT> const & src, MatrixT & dst)
+{
+  dst.resize(src.size1(), src.size2(), false);
+  dst.clear();
+  for (unsigned int i=0; i<src.size1(); ++i)
+    for (unsigned int k=src.row_buffer()[i]; k<src.row_buffer()[i+1]; ++k)
+      dst(i, src.col_buffer()[k]) = src.elements()[k];
+}
 
-    unsigned int x, y;
-    amg_point *point;
+/** @brief Copies an internal sparse matrix to a compressed_matrix in the memory context of the destination. The CSR arrays are transferred as a whole. */
+template<typename NumericT, unsigned int AlignmentV>
+void amg_copy(amg_sparsematrix<NumericT> const & src, viennacl::compressed_matrix<NumericT, AlignmentV> & dst)
+{
+  if (src.nnz() == 0)
+  {
+    dst.resize(src.size1(), src.size2(), false);
+    return;
+  }
 
-  #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for private (x,y,point)
-  #endif
-    for (long i=0; i<static_cast<long>(threads_); ++i)
-    {
-      // Allocate space for the matrix slice and the pointvector.
-      A_slice_[i][level] = SparseMatrixType(offset_[i+1][level]-offset_[i][level], offset_[i+1][level]-offset_[i][level]);
-      pointvector_slice_[i][level] = PointVectorType(offset_[i+1][level]-offset_[i][level]);
+  viennacl::backend::typesafe_host_array<unsigned int> row_buffer(dst.handle1(), src.size1() + 1);
+  viennacl::backend::typesafe_host_array<unsigned int> col_buffer(dst.handle2(), src.nnz());
+  for (vcl_size_t i=0; i<=src.size1(); ++i)
+    row_buffer.set(i, src.row_buffer()[i]);
+  for (vcl_size_t i=0; i<src.nnz(); ++i)
+    col_buffer.set(i, src.col_buffer()[i]);
 
-      // Iterate over the part that belongs to thread i (from Offset[i][level] to Offset[i+1][level]).
-      ConstRowIterator row_iter = A[level].begin1();
-      row_iter += offset_[i][level];
-      x = static_cast<unsigned int>(row_iter.index1());
+  dst.set(row_buffer.get(), col_buffer.get(), &(src.elements()[0]), src.size1(), src.size2(), src.nnz());
+}
 
-      while (x < offset_[i+1][level] && row_iter != A[level].end1())
+/** @brief Reads the CSR arrays of a compressed_matrix into an internal sparse matrix. Explicit zeros are not stored. */
+template<typename NumericT, unsigned int AlignmentV>
+void amg_copy(viennacl::compressed_matrix<NumericT, AlignmentV> const & src, amg_sparsematrix<NumericT> & dst)
+{
+  dst.resize(static_cast<unsigned int>(src.size1()), static_cast<unsigned int>(src.size2()));
+  if (src.size1() == 0 || src.nnz() == 0)
+    return;
+
+  viennacl::backend::typesafe_host_array<unsigned int> row_buffer(src.handle1(), src.size1() + 1);
+  viennacl::backend::typesafe_host_array<unsigned int> col_buffer(src.handle2(), src.nnz());
+  std::vector<NumericT> elements(src.nnz());
+
+  viennacl::backend::memory_read(src.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+  viennacl::backend::memory_read(src.handle2(), 0, col_buffer.raw_size(), col_buffer.get());
+  viennacl::backend::memory_read(src.handle(),  0, sizeof(NumericT) * src.nnz(), &(elements[0]));
+
+  std::vector<unsigned int> & dst_row_buffer = dst.row_buffer();
+  for (vcl_size_t i=0; i<src.size1(); ++i)
+    for (vcl_size_t k=row_buffer[i]; k<row_buffer[i+1]; ++k)
+      if (elements[k] != 0)
+        ++dst_row_buffer[i+1];
+  for (vcl_size_t i=0; i<src.size1(); ++i)
+    dst_row_buffer[i+1] += dst_row_buffer[i];
+  dst.reserve_from_row_buffer();
+
+  unsigned int pos = 0;
+  for (vcl_size_t i=0; i<src.size1(); ++i)
+    for (vcl_size_t k=row_buffer[i]; k<row_buffer[i+1]; ++k)
+      if (elements[k] != 0)
       {
-        // Set offset for point index and save point for the respective thread
-        point = pointvector[level][x];
-        point->set_offset(offset_[i][level]);
-        pointvector_slice_[i][level].add_point(point);
+        dst.col_buffer()[pos] = static_cast<unsigned int>(col_buffer[k]);
+        dst.elements()[pos]   = elements[k];
+        ++pos;
+      }
+}
+
+/** @brief Writes the values of an internal sparse matrix to a compressed_matrix with the same sparsity pattern. Only the value array is transferred. */
+template<typename NumericT, unsigned int AlignmentV>
+void amg_copy_values(amg_sparsematrix<NumericT> const & src, viennacl::compressed_matrix<NumericT, AlignmentV> & dst)
+{
+  assert( (dst.nnz() == src.nnz()) && bool("Sparsity pattern mismatch") );
+  if (src.nnz() > 0)
+    viennacl::backend::memory_write(dst.handle(), 0, sizeof(NumericT) * src.nnz(), &(src.elements()[0]));
+}
 
-        ConstColIterator col_iter = row_iter.begin();
-        y = static_cast<unsigned int>(col_iter.index2());
+/** @brief Assigns the values of src to the sparsity pattern of dst. Entries of dst which are not in src are set to zero.
+*
+* @return False if src has a nonzero entry outside of the pattern of dst (dst is left in an undefined state then)
+*/
+template<typename NumericT>
+bool amg_assign_values(amg_sparsematrix<NumericT> const & src, amg_sparsematrix<NumericT> & dst)
+{
+  if (src.size1() != dst.size1() || src.size2() != dst.size2())
+    return false;
 
-        // Save all coefficients from the matrix slice
-        while (y < offset_[i+1][level] && col_iter != row_iter.end())
-        {
-          if (y >= offset_[i][level])
-            A_slice_[i][level](x-offset_[i][level], y-offset_[i][level]) = *col_iter;
+  std::vector<unsigned int> const & src_row_buffer = src.row_buffer();
+  std::vector<unsigned int> const & src_col_buffer = src.col_buffer();
+  std::vector<NumericT>     const & src_elements   = src.elements();
+  std::vector<unsigned int> const & dst_row_buffer = dst.row_buffer();
+  std::vector<unsigned int> const & dst_col_buffer = dst.col_buffer();
+  std::vector<NumericT>           & dst_elements   = dst.elements();
 
-          ++col_iter;
-          y = static_cast<unsigned int>(col_iter.index2());
-        }
+  long outside_pattern = 0;
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for reduction(+: outside_pattern)
+#endif
+  for (long i=0; i<static_cast<long>(src.size1()); ++i)
+  {
+    // Both rows are sorted, so they are merged
+    unsigned int k = src_row_buffer[i];
+    for (unsigned int l=dst_row_buffer[i]; l<dst_row_buffer[i+1]; ++l)
+    {
+      for (; k<src_row_buffer[i+1] && src_col_buffer[k] < dst_col_buffer[l]; ++k)
+        if (src_elements[k] != 0)
+          ++outside_pattern;
 
-        ++row_iter;
-        x = static_cast<unsigned int>(row_iter.index1());
-      }
+      if (k<src_row_buffer[i+1] && src_col_buffer[k] == dst_col_buffer[l])
+        dst_elements[l] = src_elements[k++];
+      else
+        dst_elements[l] = 0;
     }
+    for (; k<src_row_buffer[i+1]; ++k)
+      if (src_elements[k] != 0)
+        ++outside_pattern;
   }
-};
+
+  return outside_pattern == 0;
+}
 
 /** @brief Sparse matrix product. Calculates RES = A*B.
+  *
+  *  Row-wise product with a symbolic pass, which determines an upper bound for the number of nonzeros in each row, followed by a numeric pass.
+  *  Each thread uses a dense accumulator. Entries which cancel exactly are not stored.
+  *
   * @param A    Left Matrix
   * @param B    Right Matrix
   * @param RES    Result Matrix
   */
-template<typename SparseMatrixT>
-void amg_mat_prod (SparseMatrixT & A, SparseMatrixT & B, SparseMatrixT & RES)
+template<typename NumericT>
+void amg_mat_prod(amg_sparsematrix<NumericT> const & A, amg_sparsematrix<NumericT> const & B, amg_sparsematrix<NumericT> & RES)
 {
-  typedef typename SparseMatrixT::value_type ScalarType;
-  typedef typename SparseMatrixT::iterator1 InternalRowIterator;
-  typedef typename SparseMatrixT::iterator2 InternalColIterator;
+  unsigned int const * A_row_buffer = &(A.row_buffer()[0]);
+  unsigned int const * A_col_buffer = A.nnz() > 0 ? &(A.col_buffer()[0]) : NULL;
+  NumericT     const * A_elements   = A.nnz() > 0 ? &(A.elements()[0])   : NULL;
+  unsigned int const * B_row_buffer = &(B.row_buffer()[0]);
+  unsigned int const * B_col_buffer = B.nnz() > 0 ? &(B.col_buffer()[0]) : NULL;
+  NumericT     const * B_elements   = B.nnz() > 0 ? &(B.elements()[0])   : NULL;
 
-  long x,y,z;
-  ScalarType prod;
-  RES = SparseMatrixT(static_cast<unsigned int>(A.size1()), static_cast<unsigned int>(B.size2()));
-  RES.clear();
+  long size1 = static_cast<long>(A.size1());
+  unsigned int size2 = static_cast<unsigned int>(B.size2());
 
+  amg_sparsematrix<NumericT> result(static_cast<unsigned int>(size1), size2);
+  std::vector<unsigned int> & result_row_buffer = result.row_buffer();
+
+  // Symbolic pass: Count the number of distinct columns per row
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for private (x,y,z,prod)
+  #pragma omp parallel
 #endif
-  for (x=0; x<static_cast<long>(A.size1()); ++x)
   {
-    InternalRowIterator row_iter = A.begin1();
-    row_iter += x;
-    for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+    std::vector<unsigned int> marker(size2, static_cast<unsigned int>(size1));
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for schedule(dynamic, 64)
+#endif
+    for (long x=0; x<size1; ++x)
     {
-      y = static_cast<unsigned int>(col_iter.index2());
-      InternalRowIterator row_iter2 = B.begin1();
-      row_iter2 += y;
+      unsigned int count = 0;
+      for (unsigned int i=A_row_buffer[x]; i<A_row_buffer[x+1]; ++i)
+      {
+        unsigned int y = A_col_buffer[i];
+        for (unsigned int j=B_row_buffer[y]; j<B_row_buffer[y+1]; ++j)
+          if (marker[B_col_buffer[j]] != static_cast<unsigned int>(x))
+          {
+            marker[B_col_buffer[j]] = static_cast<unsigned int>(x);
+            ++count;
+          }
+      }
+      result_row_buffer[x] = count;
+    }
+  }
+  amg_exclusive_scan(result_row_buffer);
+  result.reserve_from_row_buffer();
 
-      for (InternalColIterator col_iter2 = row_iter2.begin(); col_iter2 != row_iter2.end(); ++col_iter2)
+  std::vector<unsigned int> row_lengths(size1);
+
+  // Numeric pass
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    std::vector<unsigned int> marker(size2, static_cast<unsigned int>(size1));
+    std::vector<NumericT>     values(size2);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for schedule(dynamic, 64)
+#endif
+    for (long x=0; x<size1; ++x)
+    {
+      unsigned int * row_cols = result.nnz() > 0 ? &(result.col_buffer()[0]) + result_row_buffer[x] : NULL;
+      unsigned int count = 0;
+      for (unsigned int i=A_row_buffer[x]; i<A_row_buffer[x+1]; ++i)
       {
-        z = static_cast<unsigned int>(col_iter2.index2());
-        prod = *col_iter * *col_iter2;
-        RES.add(x,z,prod);
+        unsigned int y = A_col_buffer[i];
+        for (unsigned int j=B_row_buffer[y]; j<B_row_buffer[y+1]; ++j)
+        {
+          unsigned int z = B_col_buffer[j];
+          if (marker[z] != static_cast<unsigned int>(x))
+          {
+            marker[z] = static_cast<unsigned int>(x);
+            row_cols[count++] = z;
+            values[z] = A_elements[i] * B_elements[j];
+          }
+          else
+            values[z] += A_elements[i] * B_elements[j];
+        }
       }
+      std::sort(row_cols, row_cols + count);
+
+      // Write values and skip exact zeros
+      unsigned int nonzeros = 0;
+      NumericT * row_elements = result.nnz() > 0 ? &(result.elements()[0]) + result_row_buffer[x] : NULL;
+      for (unsigned int i=0; i<count; ++i)
+      {
+        NumericT value = values[row_cols[i]];
+        if (value != 0)
+        {
+          row_cols[nonzeros]     = row_cols[i];
+          row_elements[nonzeros] = value;
+          ++nonzeros;
+        }
+      }
+      row_lengths[x] = nonzeros;
     }
   }
+  result.compress(row_lengths);
+
+  RES.swap(result);
 }
 
-/** @brief Sparse Galerkin product: Calculates RES = trans(P)*A*P
-  * @param A    Operator matrix (quadratic)
-  * @param P    Prolongation/Interpolation matrix
-  * @param RES    Result Matrix (Galerkin operator)
+/** @brief Sparse matrix product within a given sparsity pattern. Recomputes the values of RES = A*B, where RES keeps the pattern of a previous product.
+  *
+  *  Entries of the pattern which do not occur in A*B are set to zero.
+  *
+  * @param A    Left Matrix
+  * @param B    Right Matrix
+  * @param RES  Result Matrix with the pattern of A*B
+  * @return     False if A*B has a nonzero entry outside of the pattern of RES. RES needs to be recomputed by amg_mat_prod() then.
   */
-template<typename SparseMatrixT>
-void amg_galerkin_prod (SparseMatrixT & A, SparseMatrixT & P, SparseMatrixT & RES)
+template<typename NumericT>
+bool amg_mat_prod_values(amg_sparsematrix<NumericT> const & A, amg_sparsematrix<NumericT> const & B, amg_sparsematrix<NumericT> & RES)
 {
-  typedef typename SparseMatrixT::value_type   ScalarType;
-  typedef typename SparseMatrixT::iterator1    InternalRowIterator;
-  typedef typename SparseMatrixT::iterator2    InternalColIterator;
-
-  long x,y1,y2,z;
-  amg_sparsevector<ScalarType> row;
-  RES = SparseMatrixT(static_cast<unsigned int>(P.size2()), static_cast<unsigned int>(P.size2()));
-  RES.clear();
+  if (RES.size1() != A.size1() || RES.size2() != B.size2())
+    return false;
+
+  unsigned int const * A_row_buffer = &(A.row_buffer()[0]);
+  unsigned int const * A_col_buffer = A.nnz() > 0 ? &(A.col_buffer()[0]) : NULL;
+  NumericT     const * A_elements   = A.nnz() > 0 ? &(A.elements()[0])   : NULL;
+  unsigned int const * B_row_buffer = &(B.row_buffer()[0]);
+  unsigned int const * B_col_buffer = B.nnz() > 0 ? &(B.col_buffer()[0]) : NULL;
+  NumericT     const * B_elements   = B.nnz() > 0 ? &(B.elements()[0])   : NULL;
+  unsigned int const * RES_row_buffer = &(RES.row_buffer()[0]);
+  unsigned int const * RES_col_buffer = RES.nnz() > 0 ? &(RES.col_buffer()[0]) : NULL;
+  NumericT           * RES_elements   = RES.nnz() > 0 ? &(RES.elements()[0])   : NULL;
+
+  long size1 = static_cast<long>(A.size1());
+  unsigned int size2 = static_cast<unsigned int>(B.size2());
+  long outside_pattern = 0;
 
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for private (x,y1,y2,z,row)
+  #pragma omp parallel reduction(+: outside_pattern)
 #endif
-  for (x=0; x<static_cast<long>(P.size2()); ++x)
   {
-    row = amg_sparsevector<ScalarType>(static_cast<unsigned int>(A.size2()));
-    InternalRowIterator row_iter = P.begin1(true);
-    row_iter += x;
+    std::vector<unsigned int> marker(size2, static_cast<unsigned int>(size1));
+    std::vector<NumericT>     values(size2);
+    std::vector<unsigned int> row_cols;
 
-    for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for schedule(dynamic, 64)
+#endif
+    for (long x=0; x<size1; ++x)
     {
-      y1 = static_cast<long>(col_iter.index2());
-      InternalRowIterator row_iter2 = A.begin1();
-      row_iter2 += y1;
-
-      for (InternalColIterator col_iter2 = row_iter2.begin(); col_iter2 != row_iter2.end(); ++col_iter2)
+      row_cols.clear();
+      for (unsigned int i=A_row_buffer[x]; i<A_row_buffer[x+1]; ++i)
       {
-        y2 = static_cast<long>(col_iter2.index2());
-        row.add (y2, *col_iter * *col_iter2);
+        unsigned int y = A_col_buffer[i];
+        for (unsigned int j=B_row_buffer[y]; j<B_row_buffer[y+1]; ++j)
+        {
+          unsigned int z = B_col_buffer[j];
+          if (marker[z] != static_cast<unsigned int>(x))
+          {
+            marker[z] = static_cast<unsigned int>(x);
+            row_cols.push_back(z);
+            values[z] = A_elements[i] * B_elements[j];
+          }
+          else
+            values[z] += A_elements[i] * B_elements[j];
+        }
       }
-    }
-    for (typename amg_sparsevector<ScalarType>::iterator iter = row.begin(); iter != row.end(); ++iter)
-    {
-      y2 = iter.index();
-      InternalRowIterator row_iter3 = P.begin1();
-      row_iter3 += y2;
 
-      for (InternalColIterator col_iter3 = row_iter3.begin(); col_iter3 != row_iter3.end(); ++col_iter3)
+      // Gather into the pattern and release the used entries of the accumulator
+      for (unsigned int k=RES_row_buffer[x]; k<RES_row_buffer[x+1]; ++k)
       {
-        z = static_cast<long>(col_iter3.index2());
-        RES.add (x, z, *col_iter3 * *iter);
+        unsigned int z = RES_col_buffer[k];
+        RES_elements[k] = (marker[z] == static_cast<unsigned int>(x)) ? values[z] : NumericT(0);
+        marker[z] = static_cast<unsigned int>(size1);
       }
+
+      // Remaining nonzeros are outside of the pattern
+      for (std::size_t i=0; i<row_cols.size(); ++i)
+        if (marker[row_cols[i]] == static_cast<unsigned int>(x) && values[row_cols[i]] != 0)
+          ++outside_pattern;
     }
   }
 
+  return outside_pattern == 0;
+}
+
+/** @brief Sparse Galerkin product: Calculates RES = trans(P)*A*P
+  * @param A    Operator matrix (quadratic)
+  * @param P    Prolongation/Interpolation matrix
+  * @param RES    Result Matrix (Galerkin operator)
+  */
+template<typename NumericT>
+void amg_galerkin_prod(amg_sparsematrix<NumericT> const & A, amg_sparsematrix<NumericT> const & P, amg_sparsematrix<NumericT> & RES)
+{
+  amg_sparsematrix<NumericT> R;
+  P.trans(R);
+
+  amg_sparsematrix<NumericT> AP;
+  amg_mat_prod(A, P, AP);
+  amg_mat_prod(R, AP, RES);
+
   #ifdef VIENNACL_AMG_DEBUG
   std::cout << "Galerkin Operator: " << std::endl;
   printmatrix (RES);
   #endif
 }
 
+/** @brief Recomputes the values of the Galerkin product RES = trans(P)*A*P within the pattern of RES obtained from a previous call of amg_galerkin_prod().
+  * @param A    Operator matrix (quadratic)
+  * @param P    Prolongation/Interpolation matrix
+  * @param RES  Result Matrix (Galerkin operator)
+  * @return     True if the pattern of RES was kept. Otherwise RES is recomputed including its pattern.
+  */
+template<typename NumericT>
+bool amg_galerkin_prod_values(amg_sparsematrix<NumericT> const & A, amg_sparsematrix<NumericT> const & P, amg_sparsematrix<NumericT> & RES)
+{
+  amg_sparsematrix<NumericT> R;
+  P.trans(R);
+
+  amg_sparsematrix<NumericT> AP;
+  amg_mat_prod(A, P, AP);
+  if (amg_mat_prod_values(R, AP, RES))
+    return true;
+
+  amg_mat_prod(R, AP, RES);
+  return false;
+}
+
 /** @brief Test triple-matrix product by comparing it to ublas functions. Very slow for large matrices!
   * @param A    Operator matrix (quadratic)
   * @param P    Prolongation/Interpolation matrix
@@ -1414,14 +922,11 @@ void test_triplematprod(SparseMatrixT & A, SparseMatrixT & P, SparseMatrixT  & A
 {
   typedef typename SparseMatrixT::value_type ScalarType;
 
-  boost::numeric::ublas::compressed_matrix<ScalarType> A_temp (A.size1(), A.size2());
-  A_temp = A;
-  boost::numeric::ublas::compressed_matrix<ScalarType> P_temp (P.size1(), P.size2());
-  P_temp = P;
-  P.set_trans(true);
-  boost::numeric::ublas::compressed_matrix<ScalarType> R_temp (P.size1(), P.size2());
-  R_temp = P;
-  P.set_trans(false);
+  boost::numeric::ublas::compressed_matrix<ScalarType> A_temp = A;
+  boost::numeric::ublas::compressed_matrix<ScalarType> P_temp = P;
+  SparseMatrixT R;
+  P.trans(R);
+  boost::numeric::ublas::compressed_matrix<ScalarType> R_temp = R;
 
   boost::numeric::ublas::compressed_matrix<ScalarType> RA (R_temp.size1(),A_temp.size2());
   RA = boost::numeric::ublas::prod(R_temp,A_temp);
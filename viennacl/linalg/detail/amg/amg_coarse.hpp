@@ -23,9 +23,10 @@
 */
 
 #include <cmath>
+#include <vector>
+#include <algorithm>
 #include "viennacl/linalg/detail/amg/amg_base.hpp"
 
-#include <map>
 #ifdef VIENNACL_WITH_OPENMP
 #include <omp.h>
 #endif
@@ -44,8 +45,8 @@ namespace amg
 /** @brief Calls the right coarsening procedure
 * @param level    Coarse level identifier
 * @param A    Operator matrix on all levels
-* @param Pointvector   Vector of points on all levels
-* @param Slicing    Partitioning of the system matrix to different processors (only used in RS0 and RS3)
+* @param pointvector   Vector of points on all levels
+* @param slicing    Partitioning of the system matrix to different processors (only used in RS0 and RS3)
 * @param tag    AMG preconditioner tag
 */
 template<typename InternalT1, typename InternalT2, typename InternalT3>
@@ -61,159 +62,286 @@ void amg_coarse(unsigned int level, InternalT1 & A, InternalT2 & pointvector, In
   }
 }
 
-/** @brief Determines strong influences in system matrix, classical approach (RS). Multithreaded!
-* @param level    Coarse level identifier
-* @param A      Operator matrix on all levels
-* @param Pointvector   Vector of points on all levels
-* @param tag    AMG preconditioner tag
-*/
-template<typename InternalT1, typename InternalT2>
-void amg_influence(unsigned int level, InternalT1 const & A, InternalT2 & pointvector, amg_tag & tag)
+/** @brief Checks whether a_ij is a strong connection in row i (Yang, p.5). Only columns in [col_begin, col_end) are considered. */
+template<typename NumericT>
+class amg_strength_rs
 {
-  typedef typename InternalT1::value_type             SparseMatrixType;
-  typedef typename InternalT2::value_type             PointVectorType;
-  typedef typename SparseMatrixType::value_type       ScalarType;
-  typedef typename SparseMatrixType::value_type       ScalarType;
-  typedef typename SparseMatrixType::const_iterator1  ConstRowIterator;
-  typedef typename SparseMatrixType::const_iterator2  ConstColIterator;
-
-  ScalarType max;
-  int diag_sign;
+public:
+  amg_strength_rs(unsigned int const * row_buffer, unsigned int const * col_buffer, NumericT const * elements, double threshold)
+    : row_buffer_(row_buffer), col_buffer_(col_buffer), elements_(elements), threshold_(threshold) {}
 
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for private (max,diag_sign)
-#endif
-  for (long i=0; i<static_cast<long>(A[level].size1()); ++i)
+  // Computes the threshold value for row i and returns false if the row does not have strong connections.
+  bool init_row(unsigned int i, unsigned int col_begin, unsigned int col_end)
   {
-    diag_sign = 1;
-    if (A[level](i,i) < 0)
-      diag_sign = -1;
+    diag_sign_ = 1;
+    for (unsigned int k=row_buffer_[i]; k<row_buffer_[i+1]; ++k)
+      if (col_buffer_[k] == i && elements_[k] < 0)
+        diag_sign_ = -1;
 
-    ConstRowIterator row_iter = A[level].begin1();
-    row_iter += i;
     // Find greatest non-diagonal negative value (positive if diagonal is negative) in row
-    max = 0;
-    for (ConstColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+    NumericT max = 0;
+    for (unsigned int k=row_buffer_[i]; k<row_buffer_[i+1]; ++k)
     {
-        if (i == (unsigned int) col_iter.index2()) continue;
-        if (diag_sign == 1)
-          if (max > *col_iter)  max = *col_iter;
-        if (diag_sign == -1)
-          if (max < *col_iter)  max = *col_iter;
+      unsigned int j = col_buffer_[k];
+      if (j == i || j < col_begin || j >= col_end) continue;
+      if (diag_sign_ == 1 && max > elements_[k]) max = elements_[k];
+      if (diag_sign_ == -1 && max < elements_[k]) max = elements_[k];
     }
 
     // If maximum is 0 then the row is independent of the others
-    if (max == 0)
-      continue;
+    bound_ = static_cast<NumericT>(threshold_) * (static_cast<NumericT>(diag_sign_) * (-max));
+    return max != 0;
+  }
 
-    // Find all points that strongly influence current point (Yang, p.5)
-    for (ConstColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-    {
-      unsigned int j = static_cast<unsigned int>(col_iter.index2());
+  bool operator()(unsigned int k) const { return static_cast<NumericT>(diag_sign_) * (-elements_[k]) >= bound_; }
 
-      if (i == j)
-        continue;
+private:
+  unsigned int const * row_buffer_;
+  unsigned int const * col_buffer_;
+  NumericT     const * elements_;
+  double threshold_;
+  int diag_sign_;
+  NumericT bound_;
+};
+
+/** @brief Determines strong influences in system matrix, classical approach (RS). Multithreaded!
+*
+* Only connections within the same slice are considered (the slice of a point is given by the offsets). Supply offsets {0, size} for the whole matrix.
+*
+* @param A            Operator matrix
+* @param pointvector  Points of the respective level
+* @param threshold    Strength of dependence threshold
+* @param offsets      Slice boundaries
+*/
+template<typename NumericT>
+void amg_influence_sliced(amg_sparsematrix<NumericT> const & A, amg_pointvector & pointvector, double threshold, std::vector<unsigned int> const & offsets)
+{
+  unsigned int const * row_buffer = &(A.row_buffer()[0]);
+  unsigned int const * col_buffer = A.nnz() > 0 ? &(A.col_buffer()[0]) : NULL;
+  NumericT     const * elements   = A.nnz() > 0 ? &(A.elements()[0])   : NULL;
+
+  long size = static_cast<long>(A.size1());
+  std::vector<unsigned int> & influencing_offsets = pointvector.influencing_offsets();
+
+  // Count strong influences
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i=0; i<size; ++i)
+  {
+    amg_strength_rs<NumericT> strong(row_buffer, col_buffer, elements, threshold);
+    std::vector<unsigned int>::const_iterator slice = std::upper_bound(offsets.begin(), offsets.end(), static_cast<unsigned int>(i)) - 1;
 
-      if (diag_sign * (-*col_iter) >= tag.get_threshold() * (diag_sign * (-max)))
+    unsigned int count = 0;
+    if (strong.init_row(static_cast<unsigned int>(i), *slice, *(slice+1)))
+    {
+      for (unsigned int k=row_buffer[i]; k<row_buffer[i+1]; ++k)
       {
-        // Strong influence from j to i found, save information
-        pointvector[level][i]->add_influencing_point(pointvector[level][j]);
+        unsigned int j = col_buffer[k];
+        if (j != i && j >= *slice && j < *(slice+1) && strong(k))
+          ++count;
       }
     }
+    influencing_offsets[i] = count;
   }
+  amg_exclusive_scan(influencing_offsets);
+  pointvector.reserve_influencing();
+  unsigned int * influencing_points = &(pointvector.influencing_points()[0]);
 
-  #ifdef VIENNACL_AMG_DEBUG
-  std::cout << "Influence Matrix: " << std::endl;
-  boost::numeric::ublas::matrix<bool> mat;
-  Pointvector[level].get_influence_matrix(mat);
-  printmatrix (mat);
-  #endif
+  // Save strong influences (j influences i)
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i=0; i<size; ++i)
+  {
+    amg_strength_rs<NumericT> strong(row_buffer, col_buffer, elements, threshold);
+    std::vector<unsigned int>::const_iterator slice = std::upper_bound(offsets.begin(), offsets.end(), static_cast<unsigned int>(i)) - 1;
 
-  // Save influenced points
-  for (typename PointVectorType::iterator iter = pointvector[level].begin(); iter != pointvector[level].end(); ++iter)
-    for (typename amg_point::iterator iter2 = (*iter)->begin_influencing(); iter2 != (*iter)->end_influencing(); ++iter2)
-      (*iter2)->add_influenced_point(*iter);
+    if (influencing_offsets[i] == influencing_offsets[i+1])
+      continue;
 
-  #ifdef VIENNACL_AMG_DEBUG
-  std::cout << "Influence Measures: " << std::endl;
-  boost::numeric::ublas::vector<unsigned int> temp;
-  pointvector[level].get_influence(temp);
-  printvector(temp);
-  std::cout << "Point Sorting: " << std::endl;
-  Pointvector[level].get_sorting(temp);
-  printvector (temp);
-  #endif
+    strong.init_row(static_cast<unsigned int>(i), *slice, *(slice+1));
+    unsigned int pos = influencing_offsets[i];
+    for (unsigned int k=row_buffer[i]; k<row_buffer[i+1]; ++k)
+    {
+      unsigned int j = col_buffer[k];
+      if (j != i && j >= *slice && j < *(slice+1) && strong(k))
+        influencing_points[pos++] = j;
+    }
+  }
 
+  // Save influenced points
+  pointvector.build_influenced();
 }
 
+/** @brief Comparison for the priority queue of points in the one-pass coarsening. Points are sorted by influence measure from lower to higher with the point-index as tie-breaker. */
+struct amg_influence_less
+{
+  bool operator()(std::pair<unsigned int, unsigned int> const & l, std::pair<unsigned int, unsigned int> const & r) const
+  {
+    // Queue is sorted by influence number starting with the highest
+    // If influence number is the same then lowest point index comes first
+    return l.first < r.first || (l.first == r.first && l.second > r.second);
+  }
+};
 
-/** @brief Classical (RS) one-pass coarsening. Single-Threaded! (VIENNACL_AMG_COARSE_CLASSIC_ONEPASS)
-* @param level     Course level identifier
-* @param A      Operator matrix on all levels
-* @param Pointvector   Vector of points on all levels
-* @param tag    AMG preconditioner tag
+/** @brief Classical (RS) one-pass coarsening for the points in [begin, end). Single-Threaded!
+*
+* The undecided points are kept in a binary heap sorted by their influence measure.
+* An increased influence measure is handled by inserting the point again, outdated entries are skipped when they reach the top of the heap.
 */
-template<typename InternalT1, typename InternalT2>
-void amg_coarse_classic_onepass(unsigned int level, InternalT1 & A, InternalT2 & pointvector, amg_tag & tag)
+inline void amg_coarse_classic_onepass_range(amg_pointvector & pointvector, unsigned int begin, unsigned int end)
 {
-  amg_point* c_point, *point1, *point2;
+  typedef std::pair<unsigned int, unsigned int>  EntryType;
 
-  // Check and save all strong influences
-  amg_influence(level, A, pointvector, tag);
+  // Initial influence measure is equal to the number of influenced points.
+  std::vector<unsigned int> influence(end - begin);
+  std::vector<EntryType>    queue(end - begin);
+  for (unsigned int i=begin; i<end; ++i)
+  {
+    influence[i - begin] = pointvector.number_influenced(i);
+    queue[i - begin] = EntryType(influence[i - begin], i);
+  }
+  std::make_heap(queue.begin(), queue.end(), amg_influence_less());
 
-  // Traverse through points and calculate initial influence measure
-  long i;
-  #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for private (i)
-  #endif
-  for (i=0; i<static_cast<long>(pointvector[level].size()); ++i)
-  pointvector[level][i]->calc_influence();
+  while (!queue.empty())
+  {
+    // Get undecided point with highest influence measure
+    EntryType entry = queue.front();
+    std::pop_heap(queue.begin(), queue.end(), amg_influence_less());
+    queue.pop_back();
 
-  // Do initial sorting
-  pointvector[level].sort();
+    unsigned int c_point = entry.second;
+    if (!pointvector.is_undecided(c_point) || entry.first != influence[c_point - begin])
+      continue;
+
+    // If point with highest influence measure has measure of zero, then no further C points can be constructed.
+    if (entry.first == 0)
+      break;
 
-  // Get undecided point with highest influence measure
-  while ((c_point = pointvector[level].get_nextpoint()) != NULL)
-  {
     // Make this point C point
-    pointvector[level].make_cpoint(c_point);
+    pointvector.make_cpoint(c_point);
 
     // All strongly influenced points become F points
-    for (typename amg_point::iterator iter = c_point->begin_influenced(); iter != c_point->end_influenced(); ++iter)
+    for (unsigned int const * iter = pointvector.begin_influenced(c_point); iter != pointvector.end_influenced(c_point); ++iter)
     {
-      point1 = *iter;
+      unsigned int point1 = *iter;
       // Found strong influence from C point (c_point influences point1), check whether point is still undecided, otherwise skip
-      if (!point1->is_undecided()) continue;
+      if (!pointvector.is_undecided(point1)) continue;
       // Make this point F point if it is still undecided point
-      pointvector[level].make_fpoint(point1);
+      pointvector.make_fpoint(point1);
 
       // Add +1 to influence measure for all undecided points that strongly influence new F point
-      for (typename amg_point::iterator iter2 = point1->begin_influencing(); iter2 != point1->end_influencing(); ++iter2)
+      for (unsigned int const * iter2 = pointvector.begin_influencing(point1); iter2 != pointvector.end_influencing(point1); ++iter2)
       {
-        point2 = *iter2;
+        unsigned int point2 = *iter2;
         // Found strong influence to F point (point2 influences point1)
-        if (point2->is_undecided())
-          pointvector[level].add_influence(point2,1);
+        if (pointvector.is_undecided(point2))
+        {
+          ++influence[point2 - begin];
+          queue.push_back(EntryType(influence[point2 - begin], point2));
+          std::push_heap(queue.begin(), queue.end(), amg_influence_less());
+        }
       }
     }
   }
+}
 
-  // If a point is neither C nor F point but is nevertheless influenced by other points make it F point
-  // (this situation can happen when this point does not influence other points and the points that influence this point became F points already)
-  /*#pragma omp parallel for private (i,point1)
-  for (long i=0; i<static_cast<long>(Pointvector[level].size()); ++i)
+/** @brief Checks whether F points point1 and point2 have a common C point, i.e. a C point strongly influencing both. */
+inline bool amg_common_cpoint(amg_pointvector const & pointvector, unsigned int point1, unsigned int point2)
+{
+  // Compare strong influences for point1 and point2.
+  for (unsigned int const * iter = pointvector.begin_influencing(point1); iter != pointvector.end_influencing(point1); ++iter)
   {
-  point1 = pointvector[level][i];
-  if (point1->is_undecided())
+    // Stop search when strong common influence is found via a C point.
+    if (pointvector.is_cpoint(*iter) && pointvector.is_influencing(point2, *iter))
+      return true;
+  }
+  return false;
+}
+
+/** @brief Second pass of the classical (RS) coarsening: Adds C points if a strong F-F connection does not have a common C point.
+*
+* Only F points in [begin, end) are checked. Connections to points in [skip_begin, skip_end) are skipped (used by RS3 to check connections between slices only).
+*/
+inline void amg_coarse_classic_secondpass(amg_pointvector & pointvector, unsigned int begin, unsigned int end, unsigned int skip_begin, unsigned int skip_end)
+{
+  for (unsigned int point1 = begin; point1 < end; ++point1)
   {
-    // Undecided point found. Check whether it is influenced by other point and if so: Make it F point.
-    if (point1->number_influencing() > 0)
+    // If point is F point, check for strong connections.
+    if (!pointvector.is_fpoint(point1))
+      continue;
+
+    // Check for strong connections from influencing and influenced points.
+    unsigned int const * iter2 = pointvector.begin_influencing(point1);
+    unsigned int const * iter3 = pointvector.begin_influenced(point1);
+    unsigned int const * end2  = pointvector.end_influencing(point1);
+    unsigned int const * end3  = pointvector.end_influenced(point1);
+
+    // Iterate over both lists at once. This makes sure that points are no checked twice when influence relation is symmetric (which is often the case).
+    // Note: Only works because influencing and influenced lists are sorted by point-index.
+    while (iter2 != end2 || iter3 != end3)
     {
-      #pragma omp critical
-      pointvector[level].make_fpoint(point1);
+      unsigned int point2;
+      if (iter2 == end2)
+        point2 = *iter3++;
+      else if (iter3 == end3)
+        point2 = *iter2++;
+      else if (*iter2 == *iter3)
+      {
+        point2 = *iter2++;
+        ++iter3;
+      }
+      else if (*iter2 < *iter3)
+        point2 = *iter2++;
+      else
+        point2 = *iter3++;
+
+      // Only check points with higher index as points with lower index have been checked already.
+      if (point2 < point1)
+        continue;
+
+      if (point2 >= skip_begin && point2 < skip_end)
+        continue;
+
+      // If there is a strong connection then it has to either be a C point or a F point with common C point.
+      // F point without common C point? Then make second F point to C point.
+      if (pointvector.is_fpoint(point2) && !amg_common_cpoint(pointvector, point1, point2))
+        pointvector.switch_ftoc(point2);
     }
   }
-  }*/
+}
+
+/** @brief Determines strong influences in system matrix, classical approach (RS). Multithreaded!
+* @param level    Coarse level identifier
+* @param A      Operator matrix on all levels
+* @param pointvector   Vector of points on all levels
+* @param tag    AMG preconditioner tag
+*/
+template<typename InternalT1, typename InternalT2>
+void amg_influence(unsigned int level, InternalT1 const & A, InternalT2 & pointvector, amg_tag & tag)
+{
+  std::vector<unsigned int> offsets(2);
+  offsets[0] = 0;
+  offsets[1] = static_cast<unsigned int>(A[level].size1());
+  amg_influence_sliced(A[level], pointvector[level], tag.get_threshold(), offsets);
+}
+
+
+/** @brief Classical (RS) one-pass coarsening. Single-Threaded! (VIENNACL_AMG_COARSE_CLASSIC_ONEPASS)
+* @param level     Course level identifier
+* @param A      Operator matrix on all levels
+* @param pointvector   Vector of points on all levels
+* @param tag    AMG preconditioner tag
+*/
+template<typename InternalT1, typename InternalT2>
+void amg_coarse_classic_onepass(unsigned int level, InternalT1 & A, InternalT2 & pointvector, amg_tag & tag)
+{
+  // Check and save all strong influences
+  amg_influence(level, A, pointvector, tag);
+
+  amg_coarse_classic_onepass_range(pointvector[level], 0, pointvector[level].size());
+  pointvector[level].update_cf();
 
   #if defined (VIENNACL_AMG_DEBUG)//  or defined (VIENNACL_AMG_DEBUGBENCH)
   unsigned int c_points = pointvector[level].get_cpoints();
@@ -222,433 +350,221 @@ void amg_coarse_classic_onepass(unsigned int level, InternalT1 & A, InternalT2 &
   std::cout << "No of C points = " << c_points << ", ";
   std::cout << "No of F points = " << f_points << std::endl;
   #endif
-
-  #ifdef VIENNACL_AMG_DEBUG
-  std::cout << "Coarse Points:" << std::endl;
-  boost::numeric::ublas::vector<bool> C;
-  pointvector[level].get_C(C);
-  printvector(C);
-  std::cout << "Fine Points:" << std::endl;
-  boost::numeric::ublas::vector<bool> F;
-  pointvector[level].get_F(F);
-  printvector(F);
-  #endif
 }
 
 /** @brief Classical (RS) two-pass coarsening. Single-Threaded! (VIENNACL_AMG_COARSE_CLASSIC)
 * @param level    Coarse level identifier
 * @param A      Operator matrix on all levels
-* @param Pointvector   Vector of points on all levels
+* @param pointvector   Vector of points on all levels
 * @param tag    AMG preconditioner tag
 */
 template<typename InternalT1, typename InternalT2>
 void amg_coarse_classic(unsigned int level, InternalT1 & A, InternalT2 & pointvector, amg_tag & tag)
 {
-  typedef typename InternalT2::value_type PointVectorType;
-
-  bool add_C;
-  amg_point *c_point, *point1, *point2;
-
   // Use one-pass-coarsening as first pass.
   amg_coarse_classic_onepass(level, A, pointvector, tag);
 
   // 2nd pass: Add more C points if F-F connection does not have a common C point.
-  for (typename PointVectorType::iterator iter = pointvector[level].begin(); iter != pointvector[level].end(); ++iter)
-  {
-    point1 = *iter;
-    // If point is F point, check for strong connections.
-    if (point1->is_fpoint())
-    {
-      // Check for strong connections from influencing and influenced points.
-      amg_point::iterator iter2 = point1->begin_influencing();
-      amg_point::iterator iter3 = point1->begin_influenced();
+  amg_coarse_classic_secondpass(pointvector[level], 0, pointvector[level].size(), 0, 0);
+  pointvector[level].update_cf();
 
-      // Iterate over both lists at once. This makes sure that points are no checked twice when influence relation is symmetric (which is often the case).
-      // Note: Only works because influencing and influenced lists are sorted by point-index.
-      while (iter2 != point1->end_influencing() || iter3 != point1->end_influenced())
-      {
-        if (iter2 == point1->end_influencing())
-        {
-          point2 = *iter3;
-          ++iter3;
-        }
-        else if (iter3 == point1->end_influenced())
-        {
-          point2 = *iter2;
-          ++iter2;
-        }
-        else
-        {
-          if ((*iter2)->get_index() == (*iter3)->get_index())
-          {
-            point2 = *iter2;
-            ++iter2;
-            ++iter3;
-          }
-          else if ((*iter2)->get_index() < (*iter3)->get_index())
-          {
-            point2 = *iter2;
-            ++iter2;
-          }
-          else
-          {
-            point2 = *iter3;
-            ++iter3;
-          }
-        }
-        // Only check points with higher index as points with lower index have been checked already.
-        if (point2->get_index() < point1->get_index())
-          continue;
-
-        // If there is a strong connection then it has to either be a C point or a F point with common C point.
-        // C point? Then skip as everything is ok.
-        if (point2->is_cpoint())
-          continue;
-        // F point? Then check whether F points point1 and point2 have a common C point.
-        if (point2->is_fpoint())
-        {
-          add_C = true;
-          // C point is common for two F points if they are both strongly influenced by that C point.
-          // Compare strong influences for point1 and point2.
-          for (amg_point::iterator iter3 = point1->begin_influencing(); iter3 != point1 -> end_influencing(); ++iter3)
-          {
-            c_point = *iter3;
-            // Stop search when strong common influence is found via c_point.
-            if (c_point->is_cpoint())
-            {
-              if (point2->is_influencing(c_point))
-              {
-                add_C = false;
-                break;
-              }
-            }
-          }
-          // No common C point found? Then make second F point to C point.
-          if (add_C == true)
-            pointvector[level].switch_ftoc(point2);
-        }
-      }
-    }
-  }
-
-  #ifdef VIENNACL_AMG_DEBUG
-  std::cout << "After 2nd pass:" << std::endl;
-  std::cout << "Coarse Points:" << std::endl;
-  boost::numeric::ublas::vector<bool> C;
-  pointvector[level].get_C(C);
-  printvector(C);
-  std::cout << "Fine Points:" << std::endl;
-  boost::numeric::ublas::vector<bool> F;
-  pointvector[level].get_F(F);
-  printvector(F);
-  #endif
-
-  #ifdef VIENNACL_AMG_DEBUG
-  #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp critical
-  #endif
-  {
-  std::cout << "No C and no F point: ";
-  for (typename PointVectorType::iterator iter = pointvector[level].begin(); iter != pointvector[level].end(); ++iter)
-  if ((*iter)->is_undecided())
-    std::cout << (*iter)->get_index() << " ";
-  std::cout << std::endl;
-  }
+  #if defined (VIENNACL_AMG_DEBUG)
+  std::cout << "After 2nd pass: ";
+  std::cout << "No of C points = " << pointvector[level].get_cpoints() << ", ";
+  std::cout << "No of F points = " << pointvector[level].get_fpoints() << std::endl;
   #endif
 }
 
 /** @brief Parallel classical RS0 coarsening. Multi-Threaded! (VIENNACL_AMG_COARSE_RS0 || VIENNACL_AMG_COARSE_RS3)
+*
+* The points are sliced into contiguous index ranges, one per thread. Each thread runs the classical two-pass coarsening on its slice, ignoring connections to other slices.
+*
 * @param level    Coarse level identifier
 * @param A      Operator matrix on all level
-* @param Pointvector   Vector of points on all levels
-* @param Slicing    Partitioning of the system matrix and the other data structures to different processors
+* @param pointvector   Vector of points on all levels
+* @param slicing    Partitioning of the system matrix and the other data structures to different processors
 * @param tag    AMG preconditioner tag
 */
 template<typename InternalT1, typename InternalT2, typename InternalT3>
 void amg_coarse_rs0(unsigned int level, InternalT1 & A, InternalT2 & pointvector, InternalT3 & slicing, amg_tag & tag)
 {
-  unsigned int total_points;
+  // Slice points such that they are distributed among threads
+  slicing.slice(level, static_cast<unsigned int>(A[level].size1()));
+  std::vector<unsigned int> const & offsets = slicing.offset_[level];
 
-  // Slice matrix into parts such that points are distributed among threads
-  slicing.slice(level, A, pointvector);
+  // Strong influences within each slice
+  amg_influence_sliced(A[level], pointvector[level], tag.get_threshold(), offsets);
 
   // Run classical coarsening in parallel
-  total_points = 0;
   #ifdef VIENNACL_WITH_OPENMP
   #pragma omp parallel for
   #endif
   for (long i=0; i<static_cast<long>(slicing.threads_); ++i)
   {
-    amg_coarse_classic(level, slicing.A_slice_[i], slicing.pointvector_slice_[i],tag);
-
-    // Save C points (using Slicing.Offset on the next level as temporary memory)
-    // Note: Number of C points for point i is saved in i+1!! (makes it easier later to compute offset)
-    slicing.offset_[i+1][level+1] = slicing.pointvector_slice_[i][level].get_cpoints();
-    #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp critical
-    #endif
-    total_points += slicing.pointvector_slice_[i][level].get_cpoints();
+    amg_coarse_classic_onepass_range(pointvector[level], offsets[i], offsets[i+1]);
+    amg_coarse_classic_secondpass(pointvector[level], offsets[i], offsets[i+1], 0, 0);
   }
+  pointvector[level].update_cf();
 
-  // If no coarser level can be found on any level then resume and coarsening will stop in amg_coarse()
-  if (total_points != 0)
+  // If no coarser level can be found on any slice then resume and coarsening will stop in amg_coarse()
+  if (pointvector[level].get_cpoints() != 0)
   {
     #ifdef VIENNACL_WITH_OPENMP
     #pragma omp parallel for
     #endif
     for (long i=0; i<static_cast<long>(slicing.threads_); ++i)
     {
-      // If no higher coarse level can be found on slice i (saved in Slicing.Offset[i+1][level+1]) then pull C point(s) to the next level
-      if (slicing.offset_[i+1][level+1] == 0)
-      {
-        // All points become C points
-        for (unsigned int j=0; j<slicing.A_slice_[i][level].size1(); ++j)
-          slicing.pointvector_slice_[i][level].make_cpoint(slicing.pointvector_slice_[i][level][j]);
-        slicing.offset_[i+1][level+1] = static_cast<unsigned int>(slicing.A_slice_[i][level].size1());
-      }
+      bool has_cpoint = false;
+      for (unsigned int j=offsets[i]; j<offsets[i+1]; ++j)
+        has_cpoint = has_cpoint || pointvector[level].is_cpoint(j);
+
+      // If no higher coarse level can be found on slice i then pull all points of the slice to the next level
+      if (!has_cpoint)
+        for (unsigned int j=offsets[i]; j<offsets[i+1]; ++j)
+          pointvector[level].make_cpoint(j);
     }
-
-    // Build slicing offset from number of C points (offset = total sum of C points on threads with lower number)
-    for (unsigned int i=2; i<=slicing.threads_; ++i)
-      slicing.offset_[i][level+1] += slicing.offset_[i-1][level+1];
-
-    // Join C and F points
-    slicing.join(level, pointvector);
+    pointvector[level].update_cf();
   }
 
   // Calculate global influence measures for interpolation and/or RS3.
   amg_influence(level, A, pointvector, tag);
 
+  // Slicing on the next level
+  slicing.build_next(level, pointvector[level]);
+
   #if defined(VIENNACL_AMG_DEBUG)// or defined (VIENNACL_AMG_DEBUGBENCH)
-  for (unsigned int i=0; i<slicing._threads; ++i)
-  {
-    unsigned int c_points = slicing.pointvector_slice_[i][level].get_cpoints();
-    unsigned int f_points = slicing.pointvector_slice_[i][level].get_fpoints();
-    std::cout << "Thread " << i << ": ";
-    std::cout << "No of C points = " << c_points << ", ";
-    std::cout << "No of F points = " << f_points << std::endl;
-  }
+  for (unsigned int i=0; i<slicing.threads_; ++i)
+    std::cout << "Thread " << i << ": No of C points = " << slicing.offset_[level+1][i+1] - slicing.offset_[level+1][i] << std::endl;
   #endif
 }
 
 /** @brief RS3 coarsening. Single-Threaded! (VIENNACL_AMG_COARSE_RS3)
 * @param level    Coarse level identifier
 * @param A      Operator matrix on all levels
-* @param Pointvector   Vector of points on all levels
-* @param Slicing    Partitioning of the system matrix and the other data structures to different processors
+* @param pointvector   Vector of points on all levels
+* @param slicing    Partitioning of the system matrix and the other data structures to different processors
 * @param tag    AMG preconditioner tag
 */
 template<typename InternalT1, typename InternalT2, typename InternalT3>
 void amg_coarse_rs3(unsigned int level, InternalT1 & A, InternalT2 & pointvector, InternalT3 & slicing, amg_tag & tag)
 {
-  amg_point *c_point, *point1, *point2;
-  bool add_C;
-  unsigned int i, j;
-
   // Run RS0 first (parallel).
   amg_coarse_rs0(level, A, pointvector, slicing, tag);
 
-  // Save slicing offset
-  boost::numeric::ublas::vector<unsigned int> offset = boost::numeric::ublas::vector<unsigned int> (slicing.offset_.size());
-  for (i=0; i<slicing.offset_.size(); ++i)
-    offset[i] = slicing.offset_[i][level];
+  // Correct the coarsening with a third pass: Don't allow strong F-F connections without common C point.
+  // Interior F-F connections have already been checked in the second pass, so only connections between slices are checked.
+  std::vector<unsigned int> const & offsets = slicing.offset_[level];
+  for (unsigned int i=0; i<slicing.threads_; ++i)
+    amg_coarse_classic_secondpass(pointvector[level], offsets[i], offsets[i+1], offsets[i], offsets[i+1]);
 
-  // Correct the coarsening with a third pass: Don't allow strong F-F connections without common C point
-  for (i=0; i<slicing.threads_; ++i)
-  {
-    //for (j=Slicing.Offset[i][level]; j<Slicing.Offset[i+1][level]; ++j)
-    for (j=offset[i]; j<offset[i+1]; ++j)
-    {
-      point1 = pointvector[level][j];
-      // If point is F point, check for strong connections.
-      if (point1->is_fpoint())
-      {
-        // Check for strong connections from influencing and influenced points.
-        amg_point::iterator iter2 = point1->begin_influencing();
-        amg_point::iterator iter3 = point1->begin_influenced();
+  pointvector[level].update_cf();
+  slicing.build_next(level, pointvector[level]);
 
-        // Iterate over both lists at once. This makes sure that points are no checked twice when influence relation is symmetric (which is often the case).
-        // Note: Only works because influencing and influenced lists are sorted by point-index.
-        while (iter2 != point1->end_influencing() || iter3 != point1->end_influenced())
-        {
-          if (iter2 == point1->end_influencing())
-          {
-            point2 = *iter3;
-            ++iter3;
-          }
-          else if (iter3 == point1->end_influenced())
-          {
-            point2 = *iter2;
-            ++iter2;
-          }
-          else
-          {
-            if ((*iter2)->get_index() == (*iter3)->get_index())
-            {
-              point2 = *iter2;
-              ++iter2;
-              ++iter3;
-            }
-            else if ((*iter2)->get_index() < (*iter3)->get_index())
-            {
-              point2 = *iter2;
-              ++iter2;
-            }
-            else
-            {
-              point2 = *iter3;
-              ++iter3;
-            }
-          }
-
-          // Only check points with higher index as points with lower index have been checked already.
-          if (point2->get_index() < point1->get_index())
-            continue;
-
-          // Only check points that are outside the slicing boundaries (interior F-F connections have already been checked in second pass)
-          //if (point2->get_index() >= Slicing.Offset[i][level] || point2->get_index() < Slicing.Offset[i+1][level])
-          if (point2->get_index() >= offset[i] && point2->get_index() < offset[i+1])
-            continue;
-
-          // If there is a strong connection then it has to either be a C point or a F point with common C point.
-          // C point? Then skip as everything is ok.
-          if (point2->is_cpoint())
-            continue;
-          // F point? Then check whether F points point1 and point2 have a common C point.
-          if (point2->is_fpoint())
-          {
-            add_C = true;
-            // C point is common for two F points if they are both strongly influenced by that C point.
-            // Compare strong influences for point1 and point2.
-            for (amg_point::iterator iter3 = point1->begin_influencing(); iter3 != point1 -> end_influencing(); ++iter3)
-            {
-              c_point = *iter3;
-              // Stop search when strong common influence is found via c_point.
-              if (c_point->is_cpoint())
-              {
-                if (point2->is_influencing(c_point))
-                {
-                  add_C = false;
-                  break;
-                }
-              }
-            }
-            // No common C point found? Then make second F point to C point.
-            if (add_C == true)
-            {
-              pointvector[level].switch_ftoc(point2);
-              // Add +1 to offsets as one C point has been added.
-              for (unsigned int j=i+1; j<=slicing.threads_; ++j)
-                slicing.offset_[j][level+1]++;
-            }
-          }
-        }
-      }
-    }
-  }
-
-  #ifdef VIENNACL_AMG_DEBUG
-  std::cout << "After 3rd pass:" << std::endl;
-  std::cout << "Coarse Points:" << std::endl;
-  boost::numeric::ublas::vector<bool> C;
-  pointvector[level].get_C(C);
-  printvector (C);
-  std::cout << "Fine Points:" << std::endl;
-  boost::numeric::ublas::vector<bool> F;
-  pointvector[level].get_F(F);
-  printvector (F);
+  #if defined (VIENNACL_AMG_DEBUG)
+  std::cout << "After 3rd pass: ";
+  std::cout << "No of C points = " << pointvector[level].get_cpoints() << ", ";
+  std::cout << "No of F points = " << pointvector[level].get_fpoints() << std::endl;
   #endif
 }
 
-/** @brief AG (aggregation based) coarsening. Single-Threaded! (VIENNACL_AMG_COARSE_SA)
+/** @brief AG (aggregation based) coarsening. Multi-Threaded! (VIENNACL_AMG_COARSE_SA)
+*
+* The neighborhoods are built in parallel. The greedy aggregation itself is a single sequential pass over the neighborhoods,
+* since its quality depends on the order in which the points are visited.
 *
 * @param level    Coarse level identifier
 * @param A      Operator matrix on all levels
-* @param Pointvector   Vector of points on all levels
+* @param pointvector   Vector of points on all levels
 * @param tag    AMG preconditioner tag
 */
 template<typename InternalT1, typename InternalT2>
 void amg_coarse_ag(unsigned int level, InternalT1 & A, InternalT2 & pointvector, amg_tag & tag)
 {
   typedef typename InternalT1::value_type         SparseMatrixType;
-  typedef typename InternalT2::value_type         PointVectorType;
   typedef typename SparseMatrixType::value_type   ScalarType;
 
-  typedef typename SparseMatrixType::iterator1    InternalRowIterator;
-  typedef typename SparseMatrixType::iterator2    InternalColIterator;
-
-  long x,y;
-  ScalarType diag;
-  amg_point *pointx, *pointy;
-
   // Cannot determine aggregates if size == 1 as then a new aggregate would always consist of this point (infinite loop)
   if (A[level].size1() == 1)
     return;
 
-  // SA algorithm (Vanek et al. p.6)
-  // Build neighborhoods
+  SparseMatrixType const & A_level = A[level];
+  amg_pointvector & points = pointvector[level];
+
+  unsigned int const * row_buffer = &(A_level.row_buffer()[0]);
+  unsigned int const * col_buffer = A_level.nnz() > 0 ? &(A_level.col_buffer()[0]) : NULL;
+  ScalarType   const * elements   = A_level.nnz() > 0 ? &(A_level.elements()[0])   : NULL;
+  long size = static_cast<long>(A_level.size1());
+
+  // Diagonal entries
+  std::vector<ScalarType> diag(size);
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for private (x,y,diag)
+  #pragma omp parallel for
 #endif
-  for (x=0; x<static_cast<long>(A[level].size1()); ++x)
+  for (long x=0; x<size; ++x)
+    diag[x] = A_level(static_cast<unsigned int>(x), static_cast<unsigned int>(x));
+
+  ScalarType threshold = static_cast<ScalarType>(tag.get_threshold()*pow(0.5, static_cast<double>(level-1)));
+
+  // SA algorithm (Vanek et al. p.6)
+  // Build neighborhoods: Count neighbors first, then store them.
+  std::vector<unsigned int> & neighbor_offsets = points.influencing_offsets();
+  for (int pass = 0; pass < 2; ++pass)
   {
-    InternalRowIterator row_iter = A[level].begin1();
-    row_iter += x;
-    diag = A[level](x,x);
-    for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+    if (pass == 1)
+    {
+      amg_exclusive_scan(neighbor_offsets);
+      points.reserve_influencing();
+    }
+    unsigned int * neighbors = &(points.influencing_points()[0]);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long x=0; x<size; ++x)
     {
-      y = static_cast<long>(col_iter.index2());
-      if (y == x || (std::fabs(*col_iter) >= tag.get_threshold()*pow(0.5, static_cast<double>(level-1)) * std::sqrt(std::fabs(diag*A[level](y,y)))))
+      unsigned int count = 0;
+      for (unsigned int k=row_buffer[x]; k<row_buffer[x+1]; ++k)
       {
-        // Neighborhood x includes point y
-        pointvector[level][x]->add_influencing_point(pointvector[level][y]);
+        unsigned int y = col_buffer[k];
+        if (y == x || (std::fabs(elements[k]) >= threshold * std::sqrt(std::fabs(diag[x]*diag[y]))))
+        {
+          // Neighborhood x includes point y
+          if (pass == 1)
+            neighbors[neighbor_offsets[x] + count] = y;
+          ++count;
+        }
       }
+      if (pass == 0)
+        neighbor_offsets[x] = count;
     }
   }
 
-  #ifdef VIENNACL_AMG_DEBUG
-  std::cout << "Neighborhoods:" << std::endl;
-  boost::numeric::ublas::matrix<bool> mat;
-  pointvector[level].get_influence_matrix(mat);
-  printmatrix(mat);
-  #endif
-
   // Build aggregates from neighborhoods
-  for (typename PointVectorType::iterator iter = pointvector[level].begin(); iter != pointvector[level].end(); ++iter)
+  for (unsigned int x=0; x<static_cast<unsigned int>(size); ++x)
   {
-    pointx = (*iter);
-
-    if (pointx->is_undecided())
+    if (points.is_undecided(x))
     {
       // Make center of aggregate to C point and include it to aggregate x.
-      pointvector[level].make_cpoint(pointx);
-      pointx->set_aggregate (pointx->get_index());
-      for (amg_point::iterator iter2 = pointx->begin_influencing(); iter2 != pointx->end_influencing(); ++iter2)
+      points.make_cpoint(x);
+      points.set_aggregate(x, x);
+      for (unsigned int const * iter = points.begin_influencing(x); iter != points.end_influencing(x); ++iter)
       {
-      pointy = (*iter2);
-
-        if (pointy->is_undecided())
+        unsigned int y = *iter;
+        if (points.is_undecided(y))
         {
           // Make neighbor y to F point and include it to aggregate x.
-          pointvector[level].make_fpoint(pointy);
-          pointy->set_aggregate(pointx->get_index());
+          points.make_fpoint(y);
+          points.set_aggregate(y, x);
         }
       }
     }
   }
+  points.update_cf();
 
   #ifdef VIENNACL_AMG_DEBUG
-  std::cout << "After aggregation:" << std::endl;
-  std::cout << "Coarse Points:" << std::endl;
-  boost::numeric::ublas::vector<bool> C;
-  pointvector[level].get_C(C);
-  printvector(C);
-  std::cout << "Fine Points:" << std::endl;
-  boost::numeric::ublas::vector<bool> F;
-  pointvector[level].get_F(F);
-  printvector(F);
-  std::cout << "Aggregates:" << std::endl;
-  printvector(Aggregates[level]);
+  std::cout << "After aggregation: ";
+  std::cout << "No of C points = " << points.get_cpoints() << ", ";
+  std::cout << "No of F points = " << points.get_fpoints() << std::endl;
   #endif
 }
 
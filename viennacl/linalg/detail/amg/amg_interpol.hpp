@@ -24,9 +24,9 @@
 
 #include <boost/numeric/ublas/vector.hpp>
 #include <cmath>
+#include <vector>
 #include "viennacl/linalg/detail/amg/amg_base.hpp"
 
-#include <map>
 #ifdef VIENNACL_WITH_OPENMP
 #include <omp.h>
 #endif
@@ -46,7 +46,7 @@ namespace amg
  * @param level    Coarse level identifier
  * @param A      Operator matrix on all levels
  * @param P      Prolongation matrices. P[level] is constructed
- * @param Pointvector  Vector of points on all levels
+ * @param pointvector  Vector of points on all levels
  * @param tag    AMG preconditioner tag
 */
 template<typename InternalT1, typename InternalT2>
@@ -61,101 +61,129 @@ void amg_interpol(unsigned int level, InternalT1 & A, InternalT1 & P, InternalT2
   }
 }
 
+/** @brief Sets up the row structure of the interpolation matrix for direct and classical interpolation.
+*
+*  C points are interpolated from their own coarse point only, F points from at most all of their strongly influencing points.
+*  The rows are filled in a second pass, after which unused entries are removed by amg_sparsematrix::compress().
+*/
+template<typename SparseMatrixT>
+void amg_interpol_reserve(SparseMatrixT & P, amg_pointvector const & pointvector)
+{
+  P.resize(pointvector.size(), pointvector.get_cpoints());
+
+  std::vector<unsigned int> & row_buffer = P.row_buffer();
+  for (unsigned int x=0; x<pointvector.size(); ++x)
+  {
+    if (pointvector.is_cpoint(x))
+      row_buffer[x] = 1;
+    else if (pointvector.is_fpoint(x))
+      row_buffer[x] = pointvector.number_influencing(x);
+  }
+  amg_exclusive_scan(row_buffer);
+  P.reserve_from_row_buffer();
+}
+
 /** @brief Direct interpolation. Multi-threaded! (VIENNACL_AMG_INTERPOL_DIRECT)
  * @param level    Coarse level identifier
  * @param A      Operator matrix on all levels
  * @param P      Prolongation matrices. P[level] is constructed
- * @param Pointvector  Vector of points on all levels
+ * @param pointvector  Vector of points on all levels
  * @param tag    AMG preconditioner tag
 */
 template<typename InternalT1, typename InternalT2>
 void amg_interpol_direct(unsigned int level, InternalT1 & A, InternalT1 & P, InternalT2 & pointvector, amg_tag & tag)
 {
   typedef typename InternalT1::value_type         SparseMatrixType;
-  //typedef typename InternalType2::value_type    PointVectorType;
   typedef typename SparseMatrixType::value_type   ScalarType;
-  typedef typename SparseMatrixType::iterator1    InternalRowIterator;
-  typedef typename SparseMatrixType::iterator2    InternalColIterator;
 
-  ScalarType temp_res;
-  ScalarType row_sum, c_sum, diag;
-  //int diag_sign;
-  long x, y;
-  amg_point *pointx, *pointy;
-  unsigned int c_points = pointvector[level].get_cpoints();
+  SparseMatrixType const & A_level = A[level];
+  SparseMatrixType & P_level = P[level];
+  amg_pointvector & points = pointvector[level];
+
+  // Assign indices to C points
+  points.build_index();
 
   // Setup Prolongation/Interpolation matrix
-  P[level] = SparseMatrixType(static_cast<unsigned int>(A[level].size1()), c_points);
-  P[level].clear();
+  amg_interpol_reserve(P_level, points);
 
-  // Assign indices to C points
-  pointvector[level].build_index();
+  unsigned int const * A_row_buffer = &(A_level.row_buffer()[0]);
+  unsigned int const * A_col_buffer = A_level.nnz() > 0 ? &(A_level.col_buffer()[0]) : NULL;
+  ScalarType   const * A_elements   = A_level.nnz() > 0 ? &(A_level.elements()[0])   : NULL;
+  unsigned int const * P_row_buffer = &(P_level.row_buffer()[0]);
+  unsigned int       * P_col_buffer = P_level.nnz() > 0 ? &(P_level.col_buffer()[0]) : NULL;
+  ScalarType         * P_elements   = P_level.nnz() > 0 ? &(P_level.elements()[0])   : NULL;
+
+  std::vector<unsigned int> row_lengths(points.size());
 
   // Direct Interpolation (Yang, p.14)
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for private (pointx, pointy, row_sum, c_sum, temp_res, y, x, diag)
+  #pragma omp parallel for
 #endif
-  for (x=0; x < static_cast<long>(pointvector[level].size()); ++x)
+  for (long x=0; x < static_cast<long>(points.size()); ++x)
   {
-    pointx = pointvector[level][x];
-    /*if (A[level](x,x) > 0)
-      diag_sign = 1;
-    else
-      diag_sign = -1;*/
+    unsigned int count = 0;
+    unsigned int row_start = P_row_buffer[x];
 
     // When the current line corresponds to a C point then the diagonal coefficient is 1 and the rest 0
-    if (pointx->is_cpoint())
-      P[level](x,pointx->get_coarse_index()) = 1;
+    if (points.is_cpoint(static_cast<unsigned int>(x)))
+    {
+      P_col_buffer[row_start] = points.get_coarse_index(static_cast<unsigned int>(x));
+      P_elements[row_start] = 1;
+      count = 1;
+    }
 
     // When the current line corresponds to a F point then the diagonal is 0 and the rest has to be computed (Yang, p.14)
-    if (pointx->is_fpoint())
+    if (points.is_fpoint(static_cast<unsigned int>(x)))
     {
-      // Jump to row x
-      InternalRowIterator row_iter = A[level].begin1();
-      row_iter += x;
-
       // Row sum of coefficients (without diagonal) and sum of influencing C point coefficients has to be computed
-      row_sum = c_sum = diag = 0;
-      for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+      ScalarType row_sum = 0, c_sum = 0, diag = 0;
+      for (unsigned int k=A_row_buffer[x]; k<A_row_buffer[x+1]; ++k)
       {
-        y = static_cast<long>(col_iter.index2());
-        if (x == y)// || *col_iter * diag_sign > 0)
+        unsigned int y = A_col_buffer[k];
+        if (x == y)
         {
-          diag += *col_iter;
+          diag += A_elements[k];
           continue;
         }
 
         // Sum all other coefficients in line x
-        row_sum += *col_iter;
+        row_sum += A_elements[k];
 
-        pointy = pointvector[level][y];
         // Sum all coefficients that correspond to a strongly influencing C point
-        if (pointy->is_cpoint())
-          if (pointx->is_influencing(pointy))
-            c_sum += *col_iter;
+        if (points.is_cpoint(y) && points.is_influencing(static_cast<unsigned int>(x), y))
+          c_sum += A_elements[k];
       }
-      temp_res = -row_sum/(c_sum*diag);
+      ScalarType temp_res = -row_sum/(c_sum*diag);
 
-      // Iterate over all strongly influencing points of point x
-      for (amg_point::iterator iter = pointx->begin_influencing(); iter != pointx->end_influencing(); ++iter)
+      // Iterate over all strongly influencing points of point x. The value is only non-zero for columns that correspond to a C point
+      if (temp_res != 0)
       {
-        pointy = *iter;
-        // The value is only non-zero for columns that correspond to a C point
-        if (pointy->is_cpoint())
+        for (unsigned int const * iter = points.begin_influencing(static_cast<unsigned int>(x)); iter != points.end_influencing(static_cast<unsigned int>(x)); ++iter)
         {
-          if (temp_res != 0)
-            P[level](x, pointy->get_coarse_index()) = temp_res * A[level](x,pointy->get_index());
+          if (!points.is_cpoint(*iter))
+            continue;
+
+          ScalarType value = temp_res * A_level(static_cast<unsigned int>(x), *iter);
+          if (value != 0)
+          {
+            P_col_buffer[row_start + count] = points.get_coarse_index(*iter);
+            P_elements[row_start + count] = value;
+            ++count;
+          }
         }
       }
 
       //Truncate interpolation if chosen
       if (tag.get_interpolweight() != 0)
-        amg_truncate_row(P[level], x, tag);
+        amg_truncate_row(P_elements + row_start, count, tag);
     }
+
+    row_lengths[x] = count;
   }
+  P_level.compress(row_lengths);
 
   // P test
-  //test_interpolation(A[level], P[level], Pointvector[level]);
+  //test_interpolation(A[level], P[level], pointvector[level]);
 
   #ifdef VIENNACL_AMG_DEBUG
   std::cout << "Prolongation Matrix:" << std::endl;
@@ -167,120 +195,133 @@ void amg_interpol_direct(unsigned int level, InternalT1 & A, InternalT1 & P, Int
  * @param level    Coarse level identifier
  * @param A      Operator matrix on all levels
  * @param P      Prolongation matrices. P[level] is constructed
- * @param Pointvector  Vector of points on all levels
+ * @param pointvector  Vector of points on all levels
  * @param tag    AMG preconditioner tag
 */
 template<typename InternalT1, typename InternalT2>
 void amg_interpol_classic(unsigned int level, InternalT1 & A, InternalT1 & P, InternalT2 & pointvector, amg_tag & tag)
 {
   typedef typename InternalT1::value_type           SparseMatrixType;
-  //typedef typename InternalType2::value_type      PointVectorType;
   typedef typename SparseMatrixType::value_type     ScalarType;
-  typedef typename SparseMatrixType::iterator1      InternalRowIterator;
-  typedef typename SparseMatrixType::iterator2      InternalColIterator;
 
-  ScalarType temp_res;
-  ScalarType weak_sum, strong_sum;
-  int diag_sign;
-  amg_sparsevector<ScalarType> c_sum_row;
-  amg_point *pointx, *pointy, *pointk, *pointm;
-  long x, y, k, m;
+  SparseMatrixType const & A_level = A[level];
+  SparseMatrixType & P_level = P[level];
+  amg_pointvector & points = pointvector[level];
 
-  unsigned int c_points = pointvector[level].get_cpoints();
+  // Assign indices to C points
+  points.build_index();
 
   // Setup Prolongation/Interpolation matrix
-  P[level] = SparseMatrixType(static_cast<unsigned int>(A[level].size1()), c_points);
-  P[level].clear();
+  amg_interpol_reserve(P_level, points);
 
-  // Assign indices to C points
-  pointvector[level].build_index();
+  unsigned int const * A_row_buffer = &(A_level.row_buffer()[0]);
+  unsigned int const * A_col_buffer = A_level.nnz() > 0 ? &(A_level.col_buffer()[0]) : NULL;
+  ScalarType   const * A_elements   = A_level.nnz() > 0 ? &(A_level.elements()[0])   : NULL;
+  unsigned int const * P_row_buffer = &(P_level.row_buffer()[0]);
+  unsigned int       * P_col_buffer = P_level.nnz() > 0 ? &(P_level.col_buffer()[0]) : NULL;
+  ScalarType         * P_elements   = P_level.nnz() > 0 ? &(P_level.elements()[0])   : NULL;
+
+  std::vector<unsigned int> row_lengths(points.size());
 
   // Classical Interpolation (Yang, p.13-14)
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for private (pointx,pointy,pointk,pointm,weak_sum,strong_sum,c_sum_row,temp_res,x,y,k,m,diag_sign)
+  #pragma omp parallel
 #endif
-  for (x=0; x < static_cast<long>(pointvector[level].size()); ++x)
   {
-    pointx = pointvector[level][x];
-    if (A[level](x,x) > 0)
-      diag_sign = 1;
-    else
-      diag_sign = -1;
-
-    // When the current line corresponds to a C point then the diagonal coefficient is 1 and the rest 0
-    if (pointx->is_cpoint())
-      P[level](x,pointx->get_coarse_index()) = 1;
+    // Sums of coefficients of C point neighbors of x in rows k of strongly influencing F neighbors, stored as pairs (k, sum)
+    std::vector<std::pair<unsigned int, ScalarType> > c_sum_row;
 
-    // When the current line corresponds to a F point then the diagonal is 0 and the rest has to be computed (Yang, p.14)
-    if (pointx->is_fpoint())
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for
+#endif
+    for (long x=0; x < static_cast<long>(points.size()); ++x)
     {
-      // Jump to row x
-      InternalRowIterator row_iter = A[level].begin1();
-      row_iter += x;
-
-      weak_sum = 0;
-      c_sum_row = amg_sparsevector<ScalarType>(static_cast<unsigned int>(A[level].size1()));
-      c_sum_row.clear();
-      for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+      unsigned int count = 0;
+      unsigned int row_start = P_row_buffer[x];
+      int diag_sign = (A_level(static_cast<unsigned int>(x), static_cast<unsigned int>(x)) > 0) ? 1 : -1;
+
+      // When the current line corresponds to a C point then the diagonal coefficient is 1 and the rest 0
+      if (points.is_cpoint(static_cast<unsigned int>(x)))
       {
-        k = static_cast<unsigned int>(col_iter.index2());
-        pointk = pointvector[level][k];
+        P_col_buffer[row_start] = points.get_coarse_index(static_cast<unsigned int>(x));
+        P_elements[row_start] = 1;
+        count = 1;
+      }
 
-        // Sum of weakly influencing neighbors + diagonal coefficient
-        if (x == k || !pointx->is_influencing(pointk))// || *col_iter * diag_sign > 0)
+      // When the current line corresponds to a F point then the diagonal is 0 and the rest has to be computed (Yang, p.14)
+      if (points.is_fpoint(static_cast<unsigned int>(x)))
+      {
+        ScalarType weak_sum = 0;
+        c_sum_row.clear();
+        for (unsigned int i=A_row_buffer[x]; i<A_row_buffer[x+1]; ++i)
         {
-          weak_sum += *col_iter;
-          continue;
-        }
+          unsigned int k = A_col_buffer[i];
 
-        // Sums of coefficients in row k (strongly influening F neighbors) of C point neighbors of x are calculated
-        if (pointk->is_fpoint() && pointx->is_influencing(pointk))
-        {
-          for (amg_point::iterator iter = pointx->begin_influencing(); iter != pointx->end_influencing(); ++iter)
+          // Sum of weakly influencing neighbors + diagonal coefficient
+          if (x == k || !points.is_influencing(static_cast<unsigned int>(x), k))
           {
-            pointm = *iter;
-            m = pointm->get_index();
+            weak_sum += A_elements[i];
+            continue;
+          }
 
-            if (pointm->is_cpoint())
-              // Only use coefficients that have opposite sign of diagonal.
-              if (A[level](k,m) * diag_sign < 0)
-                c_sum_row[k] += A[level](k,m);
+          // Sums of coefficients in row k (strongly influening F neighbors) of C point neighbors of x are calculated
+          if (points.is_fpoint(k))
+          {
+            ScalarType sum = 0;
+            for (unsigned int const * iter = points.begin_influencing(static_cast<unsigned int>(x)); iter != points.end_influencing(static_cast<unsigned int>(x)); ++iter)
+            {
+              if (points.is_cpoint(*iter))
+              {
+                // Only use coefficients that have opposite sign of diagonal.
+                ScalarType a_km = A_level(k, *iter);
+                if (a_km * static_cast<ScalarType>(diag_sign) < 0)
+                  sum += a_km;
+              }
+            }
+            if (sum != 0)
+              c_sum_row.push_back(std::make_pair(k, sum));
           }
-          continue;
         }
-      }
-
-      // Iterate over all strongly influencing points of point x
-      for (amg_point::iterator iter = pointx->begin_influencing(); iter != pointx->end_influencing(); ++iter)
-      {
-        pointy = *iter;
-        y = pointy->get_index();
 
-        // The value is only non-zero for columns that correspond to a C point
-        if (pointy->is_cpoint())
+        // Iterate over all strongly influencing points of point x
+        for (unsigned int const * iter = points.begin_influencing(static_cast<unsigned int>(x)); iter != points.end_influencing(static_cast<unsigned int>(x)); ++iter)
         {
-          strong_sum = 0;
-          // Calculate term for strongly influencing F neighbors
-          for (typename amg_sparsevector<ScalarType>::iterator iter2 = c_sum_row.begin(); iter2 != c_sum_row.end(); ++iter2)
+          unsigned int y = *iter;
+
+          // The value is only non-zero for columns that correspond to a C point
+          if (points.is_cpoint(y))
           {
-            k = iter2.index();
-            // Only use coefficients that have opposite sign of diagonal.
-            if (A[level](k,y) * diag_sign < 0)
-              strong_sum += (A[level](x,k) * A[level](k,y)) / (*iter2);
+            ScalarType strong_sum = 0;
+            // Calculate term for strongly influencing F neighbors
+            for (std::size_t i=0; i<c_sum_row.size(); ++i)
+            {
+              unsigned int k = c_sum_row[i].first;
+              // Only use coefficients that have opposite sign of diagonal.
+              ScalarType a_ky = A_level(k, y);
+              if (a_ky * static_cast<ScalarType>(diag_sign) < 0)
+                strong_sum += (A_level(static_cast<unsigned int>(x), k) * a_ky) / c_sum_row[i].second;
+            }
+
+            // Calculate coefficient
+            ScalarType temp_res = - (A_level(static_cast<unsigned int>(x), y) + strong_sum) / (weak_sum);
+            if (temp_res != 0)
+            {
+              P_col_buffer[row_start + count] = points.get_coarse_index(y);
+              P_elements[row_start + count] = temp_res;
+              ++count;
+            }
           }
-
-          // Calculate coefficient
-          temp_res = - (A[level](x,y) + strong_sum) / (weak_sum);
-          if (temp_res != 0)
-            P[level](x,pointy->get_coarse_index()) = temp_res;
         }
+
+        //Truncate iteration if chosen
+        if (tag.get_interpolweight() != 0)
+          amg_truncate_row(P_elements + row_start, count, tag);
       }
 
-      //Truncate iteration if chosen
-      if (tag.get_interpolweight() != 0)
-        amg_truncate_row(P[level], x, tag);
+      row_lengths[x] = count;
     }
   }
+  P_level.compress(row_lengths);
 
   #ifdef VIENNACL_AMG_DEBUG
   std::cout << "Prolongation Matrix:" << std::endl;
@@ -290,21 +331,14 @@ void amg_interpol_classic(unsigned int level, InternalT1 & A, InternalT1 & P, In
 
 /** @brief Interpolation truncation (for VIENNACL_AMG_INTERPOL_DIRECT and VIENNACL_AMG_INTERPOL_CLASSIC)
 *
-* @param P    Interpolation matrix
-* @param row  Row which has to be truncated
-* @param tag  AMG preconditioner tag
+* @param row_elements   Values of the row which has to be truncated
+* @param row_length     Number of values in the row
+* @param tag            AMG preconditioner tag
 */
-template<typename SparseMatrixT>
-void amg_truncate_row(SparseMatrixT & P, unsigned int row, amg_tag & tag)
+template<typename NumericT>
+void amg_truncate_row(NumericT * row_elements, unsigned int row_length, amg_tag & tag)
 {
-  typedef typename SparseMatrixT::value_type   ScalarType;
-  typedef typename SparseMatrixT::iterator1    InternalRowIterator;
-  typedef typename SparseMatrixT::iterator2    InternalColIterator;
-
-  ScalarType row_max, row_min, row_sum_pos, row_sum_neg, row_sum_pos_scale, row_sum_neg_scale;
-
-  InternalRowIterator row_iter = P.begin1();
-  row_iter += row;
+  NumericT row_max, row_min, row_sum_pos, row_sum_neg, row_sum_pos_scale, row_sum_neg_scale;
 
   row_max = 0;
   row_min = 0;
@@ -313,43 +347,43 @@ void amg_truncate_row(SparseMatrixT & P, unsigned int row, amg_tag & tag)
 
   // Truncate interpolation by making values to zero that are a lot smaller than the biggest value in a row
   // Determine max entry and sum of row (seperately for negative and positive entries)
-  for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+  for (unsigned int i=0; i<row_length; ++i)
   {
-    if (*col_iter > row_max)
-      row_max = *col_iter;
-    if (*col_iter < row_min)
-      row_min = *col_iter;
-    if (*col_iter > 0)
-      row_sum_pos += *col_iter;
-    if (*col_iter < 0)
-      row_sum_neg += *col_iter;
+    if (row_elements[i] > row_max)
+      row_max = row_elements[i];
+    if (row_elements[i] < row_min)
+      row_min = row_elements[i];
+    if (row_elements[i] > 0)
+      row_sum_pos += row_elements[i];
+    if (row_elements[i] < 0)
+      row_sum_neg += row_elements[i];
   }
 
   row_sum_pos_scale = row_sum_pos;
   row_sum_neg_scale = row_sum_neg;
 
   // Make certain values to zero (seperately for negative and positive entries)
-  for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+  for (unsigned int i=0; i<row_length; ++i)
   {
-    if (*col_iter > 0 && *col_iter < tag.get_interpolweight() * row_max)
+    if (row_elements[i] > 0 && row_elements[i] < tag.get_interpolweight() * row_max)
     {
-      row_sum_pos_scale -= *col_iter;
-      *col_iter = 0;
+      row_sum_pos_scale -= row_elements[i];
+      row_elements[i] = 0;
     }
-    if (*col_iter < 0 && *col_iter > tag.get_interpolweight() * row_min)
+    if (row_elements[i] < 0 && row_elements[i] > tag.get_interpolweight() * row_min)
     {
-      row_sum_pos_scale -= *col_iter;
-      *col_iter = 0;
+      row_sum_pos_scale -= row_elements[i];
+      row_elements[i] = 0;
     }
   }
 
   // Scale remaining values such that row sum is unchanged
-  for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+  for (unsigned int i=0; i<row_length; ++i)
   {
-    if (*col_iter > 0)
-      *col_iter = *col_iter *(row_sum_pos/row_sum_pos_scale);
-    if (*col_iter < 0)
-      *col_iter = *col_iter *(row_sum_neg/row_sum_neg_scale);
+    if (row_elements[i] > 0)
+      row_elements[i] = row_elements[i] *(row_sum_pos/row_sum_pos_scale);
+    if (row_elements[i] < 0)
+      row_elements[i] = row_elements[i] *(row_sum_neg/row_sum_neg_scale);
   }
 }
 
@@ -357,37 +391,40 @@ void amg_truncate_row(SparseMatrixT & P, unsigned int row, amg_tag & tag)
  * @param level    Coarse level identifier
  * @param A      Operator matrix on all levels
  * @param P      Prolongation matrices. P[level] is constructed
- * @param Pointvector  Vector of points on all levels
+ * @param pointvector  Vector of points on all levels
 */
 template<typename InternalT1, typename InternalT2>
 void amg_interpol_ag(unsigned int level, InternalT1 & A, InternalT1 & P, InternalT2 & pointvector, amg_tag)
 {
-  typedef typename InternalT1::value_type SparseMatrixType;
-  //typedef typename InternalType2::value_type PointVectorType;
-  //typedef typename SparseMatrixType::value_type ScalarType;
-  //typedef typename SparseMatrixType::iterator1 InternalRowIterator;
-  //typedef typename SparseMatrixType::iterator2 InternalColIterator;
-
-  long x;
-  amg_point *pointx, *pointy;
-  unsigned int c_points = pointvector[level].get_cpoints();
+  typedef typename InternalT1::value_type         SparseMatrixType;
+  typedef typename SparseMatrixType::value_type   ScalarType;
 
-  P[level] = SparseMatrixType(static_cast<unsigned int>(A[level].size1()), c_points);
-  P[level].clear();
+  amg_pointvector & points = pointvector[level];
 
   // Assign indices to C points
-  pointvector[level].build_index();
+  points.build_index();
+
+  // Each point is interpolated from exactly one coarse point
+  SparseMatrixType & P_level = P[level];
+  P_level.resize(static_cast<unsigned int>(A[level].size1()), points.get_cpoints());
+
+  std::vector<unsigned int> & row_buffer = P_level.row_buffer();
+  for (unsigned int x=0; x<=points.size(); ++x)
+    row_buffer[x] = x;
+  P_level.reserve_from_row_buffer();
+
+  unsigned int * P_col_buffer = P_level.nnz() > 0 ? &(P_level.col_buffer()[0]) : NULL;
+  ScalarType   * P_elements   = P_level.nnz() > 0 ? &(P_level.elements()[0])   : NULL;
 
   // Set prolongation such that F point is interpolated (weight=1) by the aggregate it belongs to (Vanek et al p.6)
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for private (x,pointx)
+  #pragma omp parallel for
 #endif
-  for (x=0; x<static_cast<long>(pointvector[level].size()); ++x)
+  for (long x=0; x<static_cast<long>(points.size()); ++x)
   {
-    pointx = pointvector[level][x];
-    pointy = pointvector[level][pointx->get_aggregate()];
     // Point x belongs to aggregate y.
-    P[level](x,pointy->get_coarse_index()) = 1;
+    P_col_buffer[x] = points.get_coarse_index(points.get_aggregate(static_cast<unsigned int>(x)));
+    P_elements[x] = 1;
   }
 
   #ifdef VIENNACL_AMG_DEBUG
@@ -396,72 +433,113 @@ void amg_interpol_ag(unsigned int level, InternalT1 & A, InternalT1 & P, Interna
   #endif
 }
 
-/** @brief SA (smoothed aggregate) interpolation. Multi-Threaded! (VIENNACL_INTERPOL_SA)
- * @param level    Coarse level identifier
- * @param A      Operator matrix on all levels
- * @param P      Prolongation matrices. P[level] is constructed
- * @param Pointvector  Vector of points on all levels
- * @param tag    AMG preconditioner tag
+/** @brief Builds the Jacobi smoother for the tentative prolongation of SA interpolation from the filtered operator matrix (Vanek et al. p.6). Multi-Threaded!
+ * @param A_level  Operator matrix on the respective level
+ * @param points   Points on the respective level. The influencing lists hold the neighborhoods from aggregation.
+ * @param tag      AMG preconditioner tag
+ * @param Jacobi   The resulting Jacobi matrix
 */
-template<typename InternalT1, typename InternalT2>
-void amg_interpol_sa(unsigned int level, InternalT1 & A, InternalT1 & P, InternalT2 & pointvector, amg_tag & tag)
+template<typename SparseMatrixT>
+void amg_jacobi_filter(SparseMatrixT const & A_level, amg_pointvector const & points, amg_tag const & tag, SparseMatrixT & Jacobi)
 {
-  typedef typename InternalT1::value_type         SparseMatrixType;
-  //typedef typename InternalType2::value_type    PointVectorType;
-  typedef typename SparseMatrixType::value_type   ScalarType;
-  typedef typename SparseMatrixType::iterator1    InternalRowIterator;
-  typedef typename SparseMatrixType::iterator2    InternalColIterator;
+  typedef typename SparseMatrixT::value_type   ScalarType;
 
-  long x,y;
-  ScalarType diag = 0;
-  unsigned int c_points = pointvector[level].get_cpoints();
+  unsigned int const * A_row_buffer = &(A_level.row_buffer()[0]);
+  unsigned int const * A_col_buffer = A_level.nnz() > 0 ? &(A_level.col_buffer()[0]) : NULL;
+  ScalarType   const * A_elements   = A_level.nnz() > 0 ? &(A_level.elements()[0])   : NULL;
+  long size = static_cast<long>(A_level.size1());
 
-  InternalT1 P_tentative = InternalT1(P.size());
-  SparseMatrixType Jacobi = SparseMatrixType(static_cast<unsigned int>(A[level].size1()), static_cast<unsigned int>(A[level].size2()));
-  Jacobi.clear();
-  P[level] = SparseMatrixType(static_cast<unsigned int>(A[level].size1()), c_points);
-  P[level].clear();
+  ScalarType weight = static_cast<ScalarType>(tag.get_interpolweight());
+
+  // Each row of the Jacobi matrix holds at most the entries of A plus the diagonal
+  Jacobi.resize(static_cast<unsigned int>(A_level.size1()), static_cast<unsigned int>(A_level.size2()));
+  std::vector<unsigned int> & J_row_buffer = Jacobi.row_buffer();
+  for (long x=0; x<size; ++x)
+    J_row_buffer[x] = A_row_buffer[x+1] - A_row_buffer[x] + 1;
+  amg_exclusive_scan(J_row_buffer);
+  Jacobi.reserve_from_row_buffer();
+
+  unsigned int * J_col_buffer = &(Jacobi.col_buffer()[0]);
+  ScalarType   * J_elements   = &(Jacobi.elements()[0]);
+  std::vector<unsigned int> row_lengths(size);
 
   // Build Jacobi Matrix via filtered A matrix (Vanek et al. p.6)
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for private (x,y,diag)
+  #pragma omp parallel for
 #endif
-  for (x=0; x<static_cast<long>(A[level].size1()); ++x)
+  for (long x=0; x<size; ++x)
   {
-    diag = 0;
-    InternalRowIterator row_iter = A[level].begin1();
-    row_iter += x;
-    for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+    // Determine the structure of the Jacobi matrix by using a filtered matrix of A:
+    // The diagonal consists of the diagonal coefficient minus all coefficients of points not in the neighborhood of x.
+    // All other coefficients are the same as in A.
+    ScalarType diag = 0;
+    for (unsigned int k=A_row_buffer[x]; k<A_row_buffer[x+1]; ++k)
     {
-      y = static_cast<long>(col_iter.index2());
-      // Determine the structure of the Jacobi matrix by using a filtered matrix of A:
-      // The diagonal consists of the diagonal coefficient minus all coefficients of points not in the neighborhood of x.
-      // All other coefficients are the same as in A.
-      // Already use Jacobi matrix to save filtered A matrix to speed up computation.
+      unsigned int y = A_col_buffer[k];
       if (x == y)
-        diag += *col_iter;
-      else if (!pointvector[level][x]->is_influencing(pointvector[level][y]))
-        diag += -*col_iter;
-      else
-        Jacobi (x,y) = *col_iter;
+        diag += A_elements[k];
+      else if (!points.is_influencing(static_cast<unsigned int>(x), y))
+        diag += -A_elements[k];
     }
-    InternalRowIterator row_iter2 = Jacobi.begin1();
-    row_iter2 += x;
-    // Traverse through filtered A matrix and compute the Jacobi filtering
-    for (InternalColIterator col_iter2 = row_iter2.begin(); col_iter2 != row_iter2.end(); ++col_iter2)
+
+    // Compute the Jacobi filtering. Diagonal can be computed seperately.
+    unsigned int count = 0;
+    unsigned int row_start = J_row_buffer[x];
+    bool diag_done = false;
+    for (unsigned int k=A_row_buffer[x]; k<A_row_buffer[x+1]; ++k)
     {
-        *col_iter2 = - static_cast<ScalarType>(tag.get_interpolweight())/diag * *col_iter2;
+      unsigned int y = A_col_buffer[k];
+      if (!diag_done && y >= x)
+      {
+        if (weight != 1)
+        {
+          J_col_buffer[row_start + count] = static_cast<unsigned int>(x);
+          J_elements[row_start + count] = 1 - weight;
+          ++count;
+        }
+        diag_done = true;
+      }
+      if (x != y && A_elements[k] != 0 && points.is_influencing(static_cast<unsigned int>(x), y))
+      {
+        J_col_buffer[row_start + count] = y;
+        J_elements[row_start + count] = - weight/diag * A_elements[k];
+        ++count;
+      }
     }
-    // Diagonal can be computed seperately.
-    Jacobi (x,x) = 1 - static_cast<ScalarType>(tag.get_interpolweight());
+    if (!diag_done && weight != 1)
+    {
+      J_col_buffer[row_start + count] = static_cast<unsigned int>(x);
+      J_elements[row_start + count] = 1 - weight;
+      ++count;
+    }
+    row_lengths[x] = count;
   }
+  Jacobi.compress(row_lengths);
 
   #ifdef VIENNACL_AMG_DEBUG
   std::cout << "Jacobi Matrix:" << std::endl;
   printmatrix(Jacobi);
   #endif
 
+}
+
+/** @brief SA (smoothed aggregate) interpolation. Multi-Threaded! (VIENNACL_INTERPOL_SA)
+ * @param level    Coarse level identifier
+ * @param A      Operator matrix on all levels
+ * @param P      Prolongation matrices. P[level] is constructed
+ * @param pointvector  Vector of points on all levels
+ * @param tag    AMG preconditioner tag
+*/
+template<typename InternalT1, typename InternalT2>
+void amg_interpol_sa(unsigned int level, InternalT1 & A, InternalT1 & P, InternalT2 & pointvector, amg_tag & tag)
+{
+  typedef typename InternalT1::value_type         SparseMatrixType;
+
+  SparseMatrixType Jacobi;
+  amg_jacobi_filter(A[level], pointvector[level], tag, Jacobi);
+
   // Use AG interpolation as tentative prolongation
+  InternalT1 P_tentative = InternalT1(P.size());
   amg_interpol_ag(level, A, P_tentative, pointvector, tag);
 
   #ifdef VIENNACL_AMG_DEBUG
@@ -478,6 +556,50 @@ void amg_interpol_sa(unsigned int level, InternalT1 & A, InternalT1 & P, Interna
   #endif
 }
 
+/** @brief Recomputes the interpolation matrix P[level] for new values of A[level]. The coarsening of the previous setup (C/F splitting or aggregates and the strong influences) is reused. Multi-Threaded!
+ * @param level    Coarse level identifier
+ * @param A      Operator matrix on all levels
+ * @param P      Prolongation matrices. P[level] is updated
+ * @param pointvector  Vector of points on all levels
+ * @param tag    AMG preconditioner tag
+ * @return       True if the sparsity pattern of P[level] is unchanged
+*/
+template<typename InternalT1, typename InternalT2>
+bool amg_interpol_values(unsigned int level, InternalT1 & A, InternalT1 & P, InternalT2 & pointvector, amg_tag & tag)
+{
+  typedef typename InternalT1::value_type         SparseMatrixType;
+
+  switch (tag.get_interpol())
+  {
+  case VIENNACL_AMG_INTERPOL_AG:
+    // Only depends on the aggregates
+    return true;
+
+  case VIENNACL_AMG_INTERPOL_SA:
+  {
+    SparseMatrixType Jacobi;
+    amg_jacobi_filter(A[level], pointvector[level], tag, Jacobi);
+
+    InternalT1 P_tentative = InternalT1(P.size());
+    amg_interpol_ag(level, A, P_tentative, pointvector, tag);
+
+    if (amg_mat_prod_values(Jacobi, P_tentative[level], P[level]))
+      return true;
+    amg_mat_prod(Jacobi, P_tentative[level], P[level]);
+    return false;
+  }
+
+  default:
+  {
+    // Direct and classical interpolation drop small entries, so the pattern is obtained from a full rebuild
+    SparseMatrixType P_old;
+    P_old.swap(P[level]);
+    amg_interpol(level, A, P, pointvector, tag);
+    return P_old.same_pattern(P[level]);
+  }
+  }
+}
+
 } //namespace amg
 } //namespace detail
 } //namespace linalg
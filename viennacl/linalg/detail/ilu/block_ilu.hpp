@@ -23,6 +23,7 @@
 */
 
 #include <vector>
+#include <algorithm>
 #include <cmath>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
@@ -32,6 +33,10 @@
 
 #include <map>
 
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace viennacl
 {
 namespace linalg
@@ -68,6 +73,30 @@ namespace detail
     SizeT size_;
   };
 
+  /** @brief Returns the default number of diagonal blocks for a block ILU preconditioner.
+    *
+    * On the host, one block per OpenMP thread is used, so that the blocks are factored and applied concurrently. Otherwise, eight blocks are used.
+    *
+    * @param num_blocks   The number of blocks requested by the user. Zero selects the default.
+    * @param size         Number of rows of the system matrix
+    * @param mem_type     Memory domain of the system matrix
+    */
+  inline vcl_size_t block_ilu_num_blocks(vcl_size_t num_blocks, vcl_size_t size, viennacl::memory_types mem_type)
+  {
+    if (num_blocks == 0)
+    {
+      num_blocks = 8;
+#ifdef VIENNACL_WITH_OPENMP
+      if (mem_type == viennacl::MAIN_MEMORY)
+        num_blocks = static_cast<vcl_size_t>(omp_get_max_threads());
+#else
+      (void)mem_type;
+#endif
+      num_blocks = std::max<vcl_size_t>(1, std::min(num_blocks, size));
+    }
+    return num_blocks;
+  }
+
   /** @brief Extracts a diagonal block from a larger system matrix
     *
     * @param A                   The full matrix
@@ -137,11 +166,15 @@ public:
   typedef std::vector<std::pair<vcl_size_t, vcl_size_t> >    index_vector_type;   //the pair refers to index range [a, b) of each block
 
 
+  /** @brief Sets up the preconditioner with num_blocks blocks of (almost) equal size. If num_blocks is zero, one block per OpenMP thread is used. */
   block_ilu_precond(MatrixT const & mat,
                     ILUTag const & tag,
-                    vcl_size_t num_blocks = 8
-                   ) : tag_(tag), LU_blocks(num_blocks)
+                    vcl_size_t num_blocks = 0
+                   ) : tag_(tag)
   {
+    num_blocks = detail::block_ilu_num_blocks(num_blocks, mat.size1(), viennacl::MAIN_MEMORY);
+    LU_blocks.resize(num_blocks);
+
     // Set up vector of block indices:
     block_indices_.resize(num_blocks);
     for (vcl_size_t i=0; i<num_blocks; ++i)
@@ -173,16 +206,36 @@ public:
   template<typename VectorT>
   void apply(VectorT & vec) const
   {
-    for (vcl_size_t i=0; i<block_indices_.size(); ++i)
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
     {
-      detail::ilu_vector_range<VectorT, ScalarType>  vec_range(vec, block_indices_[i].first, LU_blocks[i].size2());
+      // thread-local contiguous copy of the current block of vec:
+      std::vector<ScalarType> block_buffer;
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for
+#endif
+      for (long i2=0; i2<static_cast<long>(block_indices_.size()); ++i2)
+      {
+        vcl_size_t i = static_cast<vcl_size_t>(i2);
+        vcl_size_t block_start = block_indices_[i].first;
+        vcl_size_t block_size  = LU_blocks[i].size2();
 
-      unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_blocks[i].handle1());
-      unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_blocks[i].handle2());
-      ScalarType   const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(LU_blocks[i].handle());
+        block_buffer.resize(block_size);
+        for (vcl_size_t j=0; j<block_size; ++j)
+          block_buffer[j] = vec[block_start + j];
 
-      viennacl::linalg::host_based::detail::csr_inplace_solve<ScalarType>(row_buffer, col_buffer, elements, vec_range, LU_blocks[i].size2(), unit_lower_tag());
-      viennacl::linalg::host_based::detail::csr_inplace_solve<ScalarType>(row_buffer, col_buffer, elements, vec_range, LU_blocks[i].size2(), upper_tag());
+        unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_blocks[i].handle1());
+        unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_blocks[i].handle2());
+        ScalarType   const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(LU_blocks[i].handle());
+
+        viennacl::linalg::host_based::detail::csr_inplace_solve<ScalarType>(row_buffer, col_buffer, elements, block_buffer, block_size, unit_lower_tag());
+        viennacl::linalg::host_based::detail::csr_inplace_solve<ScalarType>(row_buffer, col_buffer, elements, block_buffer, block_size, upper_tag());
+
+        for (vcl_size_t j=0; j<block_size; ++j)
+          vec[block_start + j] = block_buffer[j];
+      }
     }
   }
 
@@ -256,17 +309,22 @@ public:
   typedef std::vector<std::pair<vcl_size_t, vcl_size_t> >    index_vector_type;   //the pair refers to index range [a, b) of each block
 
 
+  /** @brief Sets up the preconditioner with num_blocks blocks of (almost) equal size.
+    *
+    * If num_blocks is zero, one block per OpenMP thread is used for matrices in main memory, and eight blocks otherwise.
+    */
   block_ilu_precond(MatrixType const & mat,
                     ILUTagT const & tag,
-                    vcl_size_t num_blocks = 8
+                    vcl_size_t num_blocks = 0
                    ) : tag_(tag),
-                       block_indices_(num_blocks),
                        gpu_block_indices_(),
                        gpu_L_trans_(0, 0, viennacl::traits::context(mat)),
                        gpu_U_trans_(0, 0, viennacl::traits::context(mat)),
-                       gpu_D_(mat.size1(), viennacl::traits::context(mat)),
-                       LU_blocks_(num_blocks)
+                       gpu_D_(mat.size1(), viennacl::traits::context(mat))
   {
+    num_blocks = detail::block_ilu_num_blocks(num_blocks, mat.size1(), viennacl::traits::context(mat).memory_type());
+    LU_blocks_.resize(num_blocks);
+
     // Set up vector of block indices:
     block_indices_.resize(num_blocks);
     for (vcl_size_t i=0; i<num_blocks; ++i)
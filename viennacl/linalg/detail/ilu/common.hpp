@@ -33,6 +33,7 @@
 #include "viennacl/backend/memory.hpp"
 
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/sparse_matrix_operations.hpp"
 #include "viennacl/linalg/misc_operations.hpp"
 
 namespace viennacl
@@ -249,6 +250,47 @@ void level_scheduling_substitute(viennacl::vector<NumericT> & vec,
 
 
 
+//
+// Level-scheduled substitutions on the host:
+//
+
+/** @brief Computes the host level schedules for the forward (unit lower) and backward (upper) substitution with an in-place LU factorization in main memory. */
+template<typename NumericT, unsigned int AlignmentV>
+void host_level_schedule_setup_LU(viennacl::compressed_matrix<NumericT, AlignmentV> const & LU,
+                                  viennacl::linalg::host_based::detail::csr_level_schedule<NumericT> & L_schedule,
+                                  viennacl::linalg::host_based::detail::csr_level_schedule<NumericT> & U_schedule)
+{
+  unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU.handle1());
+  unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU.handle2());
+  NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(LU.handle());
+
+  viennacl::linalg::host_based::detail::csr_level_schedule_setup<NumericT>(row_buffer, col_buffer, elements, LU.size1(), L_schedule, viennacl::linalg::unit_lower_tag());
+  viennacl::linalg::host_based::detail::csr_level_schedule_setup<NumericT>(row_buffer, col_buffer, elements, LU.size1(), U_schedule, viennacl::linalg::upper_tag());
+}
+
+/** @brief Applies (LU)^{-1} to a vector in main memory using the host level schedules computed by host_level_schedule_setup_LU().
+*
+* If jacobi_sweeps is nonzero, each triangular factor is applied approximately by the given number of Jacobi sweeps instead of a substitution.
+*/
+template<typename NumericT, typename ScalarArrayT>
+void host_level_schedule_substitute_LU(viennacl::linalg::host_based::detail::csr_level_schedule<NumericT> const & L_schedule,
+                                       viennacl::linalg::host_based::detail::csr_level_schedule<NumericT> const & U_schedule,
+                                       ScalarArrayT & vec_buffer,
+                                       vcl_size_t jacobi_sweeps = 0)
+{
+  if (jacobi_sweeps > 0)
+  {
+    viennacl::linalg::host_based::detail::csr_jacobi_scheduled_solve(L_schedule, vec_buffer, jacobi_sweeps);
+    viennacl::linalg::host_based::detail::csr_jacobi_scheduled_solve(U_schedule, vec_buffer, jacobi_sweeps);
+  }
+  else
+  {
+    viennacl::linalg::host_based::detail::csr_level_scheduled_solve(L_schedule, vec_buffer);
+    viennacl::linalg::host_based::detail::csr_level_scheduled_solve(U_schedule, vec_buffer);
+  }
+}
+
+
 
 } // namespace detail
 } // namespace linalg
@@ -36,6 +36,7 @@
 */
 
 #include <vector>
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include "viennacl/forwards.h"
@@ -54,20 +55,140 @@ namespace linalg
 {
 
 /** @brief A tag for incomplete LU factorization with static pattern (ILU0)
+*
+* By default, the factors are computed by the classical sequential elimination and applied by exact triangular substitutions.
+* If fixed_point_sweeps() is nonzero, the factors are instead computed by the given number of fixed-point sweeps in which all nonzeros are updated in parallel
+* (Chow and Patel, Fine-grained parallel incomplete LU factorization, SIAM J. Sci. Comput. 37(2), 2015). Two or three sweeps are usually sufficient.
+* If jacobi_sweeps() is nonzero, the triangular factors are applied approximately by the given number of Jacobi sweeps instead of substitutions.
 */
 class ilu0_tag
 {
 public:
-  ilu0_tag(bool with_level_scheduling = false) : use_level_scheduling_(with_level_scheduling) {}
+  ilu0_tag(bool with_level_scheduling = false,
+           vcl_size_t num_fixed_point_sweeps = 0,
+           vcl_size_t num_jacobi_sweeps = 0)
+    : use_level_scheduling_(with_level_scheduling), fixed_point_sweeps_(num_fixed_point_sweeps), jacobi_sweeps_(num_jacobi_sweeps) {}
 
   bool use_level_scheduling() const { return use_level_scheduling_; }
   void use_level_scheduling(bool b) { use_level_scheduling_ = b; }
 
+  /** @brief Number of fixed-point sweeps for computing the factors. Zero selects the sequential factorization. */
+  vcl_size_t fixed_point_sweeps() const { return fixed_point_sweeps_; }
+  void fixed_point_sweeps(vcl_size_t num) { fixed_point_sweeps_ = num; }
+
+  /** @brief Number of Jacobi sweeps for applying each triangular factor on the host. Zero selects exact substitutions. */
+  vcl_size_t jacobi_sweeps() const { return jacobi_sweeps_; }
+  void jacobi_sweeps(vcl_size_t num) { jacobi_sweeps_ = num; }
+
 private:
   bool use_level_scheduling_;
+  vcl_size_t fixed_point_sweeps_;
+  vcl_size_t jacobi_sweeps_;
 };
 
 
+namespace detail
+{
+  /** @brief Computes ILU0 by fixed-point sweeps (Chow-Patel) in which all nonzeros are updated concurrently.
+  *
+  * For each nonzero (i,j) of the pattern, the sweep evaluates
+  *   l_ij = (a_ij - sum_{k<j} l_ik u_kj) / u_jj   if i > j,
+  *   u_ij =  a_ij - sum_{k<i} l_ik u_kj           if i <= j,
+  * using the values of the previous sweep, so the result does not depend on the number of threads.
+  * The initial guess is L = tril(A) D^{-1} and U = triu(A). Column indices within each row need to be sorted.
+  *
+  * @param A       The sparse matrix in main memory. The unit lower factor L and the upper factor U are written to A.
+  * @param sweeps  Number of sweeps
+  */
+  template<typename NumericT>
+  void ilu0_fixed_point(viennacl::compressed_matrix<NumericT> & A, vcl_size_t sweeps)
+  {
+    NumericT           * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+    unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+    vcl_size_t size = A.size1();
+    vcl_size_t nnz  = row_buffer[size];
+
+    std::vector<NumericT> A_values(elements, elements + nnz);
+    A_values.push_back(0); // dummy entry for a missing diagonal, results in the same division by zero as in the sequential factorization
+
+    // locate diagonal entries and set up the column-wise access to U (rows within each column sorted ascendingly):
+    std::vector<unsigned int> diag_index(size, static_cast<unsigned int>(nnz));
+    std::vector<unsigned int> U_col_buffer(size + 1, 0);
+    for (vcl_size_t i = 0; i < size; ++i)
+      for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+      {
+        if (col_buffer[k] == i)
+          diag_index[i] = k;
+        if (col_buffer[k] >= i)
+          U_col_buffer[col_buffer[k] + 1] += 1;
+      }
+    for (vcl_size_t i = 0; i < size; ++i)
+      U_col_buffer[i+1] += U_col_buffer[i];
+
+    std::vector<unsigned int> U_row_indices(U_col_buffer[size]);
+    std::vector<unsigned int> U_entry_index(U_col_buffer[size]);
+    std::vector<unsigned int> U_col_fill(U_col_buffer.begin(), U_col_buffer.end() - 1);
+    for (vcl_size_t i = 0; i < size; ++i)
+      for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+        if (col_buffer[k] >= i)
+        {
+          unsigned int offset = U_col_fill[col_buffer[k]]++;
+          U_row_indices[offset] = static_cast<unsigned int>(i);
+          U_entry_index[offset] = k;
+        }
+
+    // initial guess:
+    for (vcl_size_t i = 0; i < size; ++i)
+      for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+        if (col_buffer[k] < i)
+          elements[k] = A_values[k] / A_values[diag_index[col_buffer[k]]];
+
+    std::vector<NumericT> old_values(nnz + 1, 0);
+    for (vcl_size_t sweep = 0; sweep < sweeps; ++sweep)
+    {
+      std::copy(elements, elements + nnz, old_values.begin());
+      NumericT const * LU_old = &(old_values[0]);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (nnz > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+      for (long i2 = 0; i2 < static_cast<long>(size); ++i2)
+      {
+        unsigned int i = static_cast<unsigned int>(i2);
+        for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+        {
+          unsigned int j = col_buffer[k];
+          unsigned int max_index = std::min(i, j);
+
+          // sparse dot product of row i of L and column j of U, restricted to indices below max_index:
+          NumericT value = A_values[k];
+          unsigned int row_iter = row_buffer[i];
+          unsigned int col_iter = U_col_buffer[j];
+          while (row_iter < row_buffer[i+1] && col_iter < U_col_buffer[j+1])
+          {
+            unsigned int row_col = col_buffer[row_iter];
+            unsigned int col_row = U_row_indices[col_iter];
+            if (row_col >= max_index || col_row >= max_index)
+              break;
+
+            if (row_col < col_row)
+              ++row_iter;
+            else if (row_col > col_row)
+              ++col_iter;
+            else
+              value -= LU_old[row_iter++] * LU_old[U_entry_index[col_iter++]];
+          }
+
+          elements[k] = (i > j) ? value / LU_old[diag_index[j]] : value;
+        }
+      }
+    }
+  }
+}
+
+
 /** @brief Implementation of a ILU-preconditioner with static pattern. Optimized version for CSR matrices.
   *
   * refer to the Algorithm in Saad's book (1996 edition)
@@ -75,12 +196,18 @@ private:
   *  @param A       The sparse matrix matrix. The result is directly written to A.
   */
 template<typename NumericT>
-void precondition(viennacl::compressed_matrix<NumericT> & A, ilu0_tag const & /* tag */)
+void precondition(viennacl::compressed_matrix<NumericT> & A, ilu0_tag const & tag)
 {
   assert( (A.handle1().get_active_handle_id() == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ILU0") );
   assert( (A.handle2().get_active_handle_id() == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ILU0") );
   assert( (A.handle().get_active_handle_id()  == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ILU0") );
 
+  if (tag.fixed_point_sweeps() > 0)
+  {
+    detail::ilu0_fixed_point(A, tag.fixed_point_sweeps());
+    return;
+  }
+
   NumericT           * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
   unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
   unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
@@ -126,7 +253,7 @@ void precondition(viennacl::compressed_matrix<NumericT> & A, ilu0_tag const & /*
         {
           if (col_buffer[buf_index_akj] == j)
           {
-            a_kk = elements[buf_index_akj];
+            a_kj = elements[buf_index_akj];
             break;
           }
         }
@@ -159,12 +286,8 @@ public:
   template<typename VectorT>
   void apply(VectorT & vec) const
   {
-    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_.handle1());
-    unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_.handle2());
-    NumericType  const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericType>(LU_.handle());
-
-    viennacl::linalg::host_based::detail::csr_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, LU_.size2(), unit_lower_tag());
-    viennacl::linalg::host_based::detail::csr_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, LU_.size2(), upper_tag());
+    //Note: Since vec can be a rather arbitrary vector type, we call the more generic version in the backend manually:
+    detail::host_level_schedule_substitute_LU(L_schedule_, U_schedule_, vec, tag_.jacobi_sweeps());
   }
 
 private:
@@ -175,10 +298,14 @@ private:
 
     viennacl::copy(mat, LU_);
     viennacl::linalg::precondition(LU_, tag_);
+
+    detail::host_level_schedule_setup_LU(LU_, L_schedule_, U_schedule_);
   }
 
-  ilu0_tag const &                           tag_;
+  ilu0_tag                                   tag_;
   viennacl::compressed_matrix<NumericType>   LU_;
+  viennacl::linalg::host_based::detail::csr_level_schedule<NumericType> L_schedule_;
+  viennacl::linalg::host_based::detail::csr_level_schedule<NumericType> U_schedule_;
 };
 
 
@@ -230,8 +357,8 @@ public:
       {
         viennacl::context old_context = viennacl::traits::context(vec);
         viennacl::switch_memory_context(vec, host_context);
-        viennacl::linalg::inplace_solve(LU_, vec, unit_lower_tag());
-        viennacl::linalg::inplace_solve(LU_, vec, upper_tag());
+        NumericT * vec_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec.handle());
+        detail::host_level_schedule_substitute_LU(L_schedule_, U_schedule_, vec_buffer, tag_.jacobi_sweeps());
         viennacl::switch_memory_context(vec, old_context);
       }
     }
@@ -258,8 +385,8 @@ public:
       }
       else
       {
-        viennacl::linalg::inplace_solve(LU_, vec, unit_lower_tag());
-        viennacl::linalg::inplace_solve(LU_, vec, upper_tag());
+        NumericT * vec_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec.handle());
+        detail::host_level_schedule_substitute_LU(L_schedule_, U_schedule_, vec_buffer, tag_.jacobi_sweeps());
       }
     }
   }
@@ -275,7 +402,10 @@ private:
     viennacl::linalg::precondition(LU_, tag_);
 
     if (!tag_.use_level_scheduling())
+    {
+      detail::host_level_schedule_setup_LU(LU_, L_schedule_, U_schedule_);
       return;
+    }
 
     // multifrontal part:
     viennacl::switch_memory_context(multifrontal_U_diagonal_, host_context);
@@ -351,8 +481,10 @@ private:
 
   }
 
-  ilu0_tag const & tag_;
+  ilu0_tag tag_;
   viennacl::compressed_matrix<NumericT> LU_;
+  viennacl::linalg::host_based::detail::csr_level_schedule<NumericT> L_schedule_;
+  viennacl::linalg::host_based::detail::csr_level_schedule<NumericT> U_schedule_;
 
   std::list<viennacl::backend::mem_handle> multifrontal_L_row_index_arrays_;
   std::list<viennacl::backend::mem_handle> multifrontal_L_row_buffers_;
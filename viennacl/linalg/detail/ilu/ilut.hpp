@@ -266,12 +266,7 @@ public:
   void apply(VectorT & vec) const
   {
     //Note: Since vec can be a rather arbitrary vector type, we call the more generic version in the backend manually:
-    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_.handle1());
-    unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_.handle2());
-    NumericType  const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericType>(LU_.handle());
-
-    viennacl::linalg::host_based::detail::csr_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, LU_.size2(), unit_lower_tag());
-    viennacl::linalg::host_based::detail::csr_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, LU_.size2(), upper_tag());
+    detail::host_level_schedule_substitute_LU(L_schedule_, U_schedule_, vec);
   }
 
 private:
@@ -289,10 +284,14 @@ private:
 
     viennacl::switch_memory_context(LU_, host_context);
     viennacl::copy(LU_temp, LU_);
+
+    detail::host_level_schedule_setup_LU(LU_, L_schedule_, U_schedule_);
   }
 
   ilut_tag const & tag_;
   viennacl::compressed_matrix<NumericType> LU_;
+  viennacl::linalg::host_based::detail::csr_level_schedule<NumericType> L_schedule_;
+  viennacl::linalg::host_based::detail::csr_level_schedule<NumericType> U_schedule_;
 };
 
 
@@ -344,15 +343,15 @@ public:
         viennacl::context host_context(viennacl::MAIN_MEMORY);
         viennacl::context old_context = viennacl::traits::context(vec);
         viennacl::switch_memory_context(vec, host_context);
-        viennacl::linalg::inplace_solve(LU_, vec, unit_lower_tag());
-        viennacl::linalg::inplace_solve(LU_, vec, upper_tag());
+        NumericT * vec_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec.handle());
+        detail::host_level_schedule_substitute_LU(L_schedule_, U_schedule_, vec_buffer);
         viennacl::switch_memory_context(vec, old_context);
       }
     }
     else //apply ILUT directly:
     {
-      viennacl::linalg::inplace_solve(LU_, vec, unit_lower_tag());
-      viennacl::linalg::inplace_solve(LU_, vec, upper_tag());
+      NumericT * vec_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec.handle());
+      detail::host_level_schedule_substitute_LU(L_schedule_, U_schedule_, vec_buffer);
     }
   }
 
@@ -381,7 +380,10 @@ private:
     viennacl::copy(LU_temp, LU_);
 
     if (!tag_.use_level_scheduling())
+    {
+      detail::host_level_schedule_setup_LU(LU_, L_schedule_, U_schedule_);
       return;
+    }
 
     //
     // multifrontal part:
@@ -464,6 +466,8 @@ private:
 
   ilut_tag const & tag_;
   viennacl::compressed_matrix<NumericT> LU_;
+  viennacl::linalg::host_based::detail::csr_level_schedule<NumericT> L_schedule_;
+  viennacl::linalg::host_based::detail::csr_level_schedule<NumericT> U_schedule_;
 
   std::list<viennacl::backend::mem_handle> multifrontal_L_row_index_arrays_;
   std::list<viennacl::backend::mem_handle> multifrontal_L_row_buffers_;
@@ -0,0 +1,280 @@
+#ifndef VIENNACL_LINALG_DETAIL_MULTI_RHS_HPP
+#define VIENNACL_LINALG_DETAIL_MULTI_RHS_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/multi_rhs.hpp
+ *
+ * @brief Helper routines for the iterative solvers operating on a dense matrix of right hand sides (one system per column).
+*/
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/matrix_operations.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+
+/** @brief Returns the offset of the first entry of the j-th column of a dense matrix within the memory buffer of the matrix */
+template<typename NumericT>
+vcl_size_t multi_rhs_column_start(viennacl::matrix_base<NumericT> const & M, vcl_size_t j)
+{
+  if (M.row_major())
+    return M.start1() * M.internal_size2() + M.start2() + j * M.stride2();
+  return M.start1() + (M.start2() + j * M.stride2()) * M.internal_size1();
+}
+
+/** @brief Returns the distance of two consecutive entries of a column of a dense matrix within the memory buffer of the matrix */
+template<typename NumericT>
+vcl_size_t multi_rhs_column_stride(viennacl::matrix_base<NumericT> const & M)
+{
+  if (M.row_major())
+    return M.stride1() * M.internal_size2();
+  return M.stride1();
+}
+
+/** @brief Refers to the j-th column of a dense matrix as a vector without copying any data.
+*
+* Allows to run the column-wise parts of the multi-RHS solvers with the usual vector operations on any backend.
+*/
+template<typename NumericT>
+class multi_rhs_column : public viennacl::vector_base<NumericT>
+{
+  typedef viennacl::vector_base<NumericT>                       base_type;
+  typedef typename viennacl::matrix_base<NumericT>::handle_type handle_type;
+
+public:
+  multi_rhs_column(viennacl::matrix_base<NumericT> const & M, vcl_size_t j)
+    : base_type(const_cast<handle_type &>(M.handle()), M.size1(), multi_rhs_column_start(M, j), multi_rhs_column_stride(M)) {}
+
+  using base_type::operator=;
+};
+
+/** @brief Returns a copy of the dense matrix 'src' of type DestMatrixT. Unlike plain assignment, the two matrices may use different memory layouts. */
+template<typename DestMatrixT, typename NumericT>
+DestMatrixT multi_rhs_convert(viennacl::matrix_base<NumericT> const & src)
+{
+  DestMatrixT dest(src.size1(), src.size2(), viennacl::traits::context(src));
+  if (src.row_major() == dest.row_major())
+    dest = src;
+  else
+    for (vcl_size_t j = 0; j < src.size2(); ++j)
+      multi_rhs_column<NumericT>(dest, j) = multi_rhs_column<NumericT>(src, j);
+  return dest;
+}
+
+/** @brief Computes Y = A * X for all columns of X at once, where A is a sparse matrix. The sparse matrix is streamed from memory only once. */
+template<typename MatrixT, typename NumericT>
+void multi_rhs_prod(MatrixT const & A, viennacl::matrix_base<NumericT> const & X, viennacl::matrix_base<NumericT> & Y)
+{
+  viennacl::linalg::prod_impl(A, X, Y);
+}
+
+/** @brief Computes Y = A * X for all columns of X at once, where A is a dense matrix. */
+template<typename NumericT>
+void multi_rhs_prod(viennacl::matrix_base<NumericT> const & A, viennacl::matrix_base<NumericT> const & X, viennacl::matrix_base<NumericT> & Y)
+{
+  viennacl::linalg::prod_impl(A, X, Y, NumericT(1), NumericT(0));
+}
+
+/** @brief Computes the 2-norms of all columns of a dense matrix */
+template<typename NumericT, typename CPUNumericT>
+void multi_rhs_column_norms(viennacl::matrix_base<NumericT> const & M, std::vector<CPUNumericT> & norms)
+{
+  norms.resize(M.size2());
+  for (vcl_size_t j = 0; j < M.size2(); ++j)
+    norms[j] = viennacl::linalg::norm_2(multi_rhs_column<NumericT>(M, j));
+}
+
+/** @brief Applies a preconditioner to all active columns of a dense matrix. The vector 'tmp' is used as temporary storage and has to be of size M.size1(). */
+template<typename NumericT, typename PreconditionerT>
+void multi_rhs_precond_apply(PreconditionerT const & precond, viennacl::matrix_base<NumericT> & M, std::vector<bool> const & active, viennacl::vector<NumericT> & tmp)
+{
+  for (vcl_size_t j = 0; j < M.size2(); ++j)
+  {
+    if (!active[j])
+      continue;
+
+    multi_rhs_column<NumericT> M_j(M, j);
+    tmp = M_j;
+    precond.apply(tmp);
+    M_j = tmp;
+  }
+}
+
+/** @brief Overload for the no_precond case: Nothing to do. */
+template<typename NumericT>
+void multi_rhs_precond_apply(viennacl::linalg::no_precond const &, viennacl::matrix_base<NumericT> &, std::vector<bool> const &, viennacl::vector<NumericT> &) {}
+
+/** @brief Computes the small matrix P^T Q and writes it row-major to host memory. 'tmp' is a P.size2() x Q.size2() matrix in the memory context of P. */
+template<typename NumericT, typename F, unsigned int AlignmentV, typename CPUNumericT>
+void multi_rhs_inner_prod(viennacl::matrix_base<NumericT> const & P, viennacl::matrix_base<NumericT> const & Q,
+                          viennacl::matrix<NumericT, F, AlignmentV> & tmp, std::vector<CPUNumericT> & result)
+{
+  viennacl::linalg::prod_impl(viennacl::trans(P), Q, tmp, NumericT(1), NumericT(0));
+
+  std::vector<std::vector<CPUNumericT> > host_tmp(tmp.size1(), std::vector<CPUNumericT>(tmp.size2()));
+  viennacl::copy(tmp, host_tmp);
+
+  result.resize(tmp.size1() * tmp.size2());
+  for (vcl_size_t i = 0; i < tmp.size1(); ++i)
+    for (vcl_size_t j = 0; j < tmp.size2(); ++j)
+      result[i * tmp.size2() + j] = host_tmp[i][j];
+}
+
+/** @brief Writes a small row-major matrix from host memory to a dense matrix of the same size */
+template<typename CPUNumericT, typename NumericT, typename F, unsigned int AlignmentV>
+void multi_rhs_copy_to_device(std::vector<CPUNumericT> const & values, viennacl::matrix<NumericT, F, AlignmentV> & M)
+{
+  std::vector<std::vector<CPUNumericT> > host_M(M.size1(), std::vector<CPUNumericT>(M.size2()));
+  for (vcl_size_t i = 0; i < M.size1(); ++i)
+    for (vcl_size_t j = 0; j < M.size2(); ++j)
+      host_M[i][j] = values[i * M.size2() + j];
+  viennacl::copy(host_M, M);
+}
+
+/** @brief Computes a Cholesky factorization with diagonal pivoting, A(pivots, pivots) = L L^T, of a small symmetric positive semidefinite matrix on the host.
+*
+* The pivot in each step is the remaining diagonal entry which is largest relative to its initial value, so that the result does not depend on the scaling of the rows and columns.
+* The factorization stops as soon as this ratio drops below rel_tol. The remaining rows and columns are numerically linearly dependent on the selected ones.
+*
+* @param A        Row-major n x n matrix, overwritten: The lower triangle holds L (in pivoted order) within the leading rank x rank block.
+* @param pivots   Returns the indices of the rows and columns of A in pivoted order
+* @param n        Size of A
+* @param rel_tol  Relative threshold for the pivots
+* @return The numerical rank, i.e. the number of selected rows and columns
+*/
+template<typename NumericT>
+vcl_size_t multi_rhs_pivoted_cholesky(std::vector<NumericT> & A, std::vector<vcl_size_t> & pivots, vcl_size_t n, NumericT rel_tol)
+{
+  std::vector<NumericT> initial_diag(n);
+  pivots.resize(n);
+  for (vcl_size_t i = 0; i < n; ++i)
+  {
+    initial_diag[i] = A[i*n + i];
+    pivots[i] = i;
+  }
+
+  for (vcl_size_t k = 0; k < n; ++k)
+  {
+    vcl_size_t pivot_row = k;
+    NumericT   pivot_ratio = 0;
+    for (vcl_size_t i = k; i < n; ++i)
+    {
+      NumericT ratio = initial_diag[pivots[i]] > 0 ? A[i*n + i] / initial_diag[pivots[i]] : 0;
+      if (ratio > pivot_ratio)
+      {
+        pivot_ratio = ratio;
+        pivot_row = i;
+      }
+    }
+
+    if (pivot_ratio <= rel_tol)
+      return k;
+
+    if (pivot_row != k)
+    {
+      std::swap(pivots[k], pivots[pivot_row]);
+      for (vcl_size_t j = 0; j < n; ++j)
+        std::swap(A[k*n + j], A[pivot_row*n + j]);
+      for (vcl_size_t i = 0; i < n; ++i)
+        std::swap(A[i*n + k], A[i*n + pivot_row]);
+    }
+
+    NumericT diag = std::sqrt(A[k*n + k]);
+    A[k*n + k] = diag;
+    for (vcl_size_t i = k + 1; i < n; ++i)
+      A[i*n + k] /= diag;
+    for (vcl_size_t i = k + 1; i < n; ++i)
+      for (vcl_size_t j = k + 1; j <= i; ++j)
+      {
+        A[i*n + j] -= A[i*n + k] * A[j*n + k];
+        A[j*n + i] = A[i*n + j];
+      }
+  }
+
+  return n;
+}
+
+/** @brief Solves L X = B on the host, where L is the lower triangle of the leading n x n block of the row-major matrix 'L' with row stride 'ld'. B is row-major n x num_rhs and overwritten with X. */
+template<typename NumericT>
+void multi_rhs_lower_solve(std::vector<NumericT> const & L, vcl_size_t ld, vcl_size_t n, std::vector<NumericT> & B, vcl_size_t num_rhs)
+{
+  for (vcl_size_t i = 0; i < n; ++i)
+    for (vcl_size_t j = 0; j < num_rhs; ++j)
+    {
+      NumericT value = B[i*num_rhs + j];
+      for (vcl_size_t k = 0; k < i; ++k)
+        value -= L[i*ld + k] * B[k*num_rhs + j];
+      B[i*num_rhs + j] = value / L[i*ld + i];
+    }
+}
+
+/** @brief Solves L^T X = B on the host, where L is the lower triangle of the leading n x n block of the row-major matrix 'L' with row stride 'ld'. B is row-major n x num_rhs and overwritten with X. */
+template<typename NumericT>
+void multi_rhs_lower_trans_solve(std::vector<NumericT> const & L, vcl_size_t ld, vcl_size_t n, std::vector<NumericT> & B, vcl_size_t num_rhs)
+{
+  for (vcl_size_t i2 = 0; i2 < n; ++i2)
+  {
+    vcl_size_t i = n - i2 - 1;
+    for (vcl_size_t j = 0; j < num_rhs; ++j)
+    {
+      NumericT value = B[i*num_rhs + j];
+      for (vcl_size_t k = i + 1; k < n; ++k)
+        value -= L[k*ld + i] * B[k*num_rhs + j];
+      B[i*num_rhs + j] = value / L[i*ld + i];
+    }
+  }
+}
+
+/** @brief Solves A(pivots, pivots) X = B(pivots, :) with the factorization from multi_rhs_pivoted_cholesky(). B is row-major n x num_rhs and overwritten with X, the rows of B not selected by the pivots are set to zero. */
+template<typename NumericT>
+void multi_rhs_pivoted_cholesky_solve(std::vector<NumericT> const & L, std::vector<vcl_size_t> const & pivots, vcl_size_t rank,
+                                      std::vector<NumericT> & B, vcl_size_t n, vcl_size_t num_rhs)
+{
+  std::vector<NumericT> X(rank * num_rhs);
+  for (vcl_size_t i = 0; i < rank; ++i)
+    for (vcl_size_t j = 0; j < num_rhs; ++j)
+      X[i*num_rhs + j] = B[pivots[i]*num_rhs + j];
+
+  multi_rhs_lower_solve(L, n, rank, X, num_rhs);
+  multi_rhs_lower_trans_solve(L, n, rank, X, num_rhs);
+
+  std::fill(B.begin(), B.end(), NumericT(0));
+  for (vcl_size_t i = 0; i < rank; ++i)
+    for (vcl_size_t j = 0; j < num_rhs; ++j)
+      B[pivots[i]*num_rhs + j] = X[i*num_rhs + j];
+}
+
+} //namespace detail
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef VIENNACL_LINALG_DETAIL_MULTI_VECTOR_HPP
+#define VIENNACL_LINALG_DETAIL_MULTI_VECTOR_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/multi_vector.hpp
+ *
+ * @brief Helper routines for the iterative solvers operating on several Krylov vectors at once (IDR(s), BiCGStab(l)).
+ *
+ * Vectors in host memory are processed by the fused kernels in viennacl/linalg/host_based/iterative_operations.hpp, which require a single pass over memory.
+ * For all other memory domains the operations are carried out vector by vector.
+*/
+
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/iterative_operations.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+
+/** @brief Returns a tuple of the vectors vecs[first], ..., vecs[first + count - 1] */
+template<typename NumericT>
+viennacl::vector_tuple<NumericT> multi_vector_tuple(std::vector< viennacl::vector<NumericT> > & vecs, vcl_size_t first, vcl_size_t count)
+{
+  std::vector<viennacl::vector_base<NumericT> *> pointers(count);
+  for (vcl_size_t i = 0; i < count; ++i)
+    pointers[i] = &(vecs[first + i]);
+  return viennacl::vector_tuple<NumericT>(pointers);
+}
+
+/** @brief Computes inner_prods[i] = (v_i, y) for all vectors v_i in 'vecs' and inner_prods[vecs.const_size()] = (y, y) */
+template<typename NumericT>
+void multi_vector_inner_prod(viennacl::vector_tuple<NumericT> const & vecs, viennacl::vector_base<NumericT> const & y, std::vector<NumericT> & inner_prods)
+{
+  if (viennacl::traits::active_handle_id(y) == viennacl::MAIN_MEMORY)
+  {
+    viennacl::linalg::pipelined_multi_inner_prod(vecs, y, inner_prods);
+    return;
+  }
+
+  inner_prods.resize(std::max(inner_prods.size(), vecs.const_size() + 1));
+  for (vcl_size_t i = 0; i < vecs.const_size(); ++i)
+    inner_prods[i] = viennacl::linalg::inner_prod(vecs.const_at(i), y);
+  inner_prods[vecs.const_size()] = viennacl::linalg::inner_prod(y, y);
+}
+
+/** @brief Computes y -= sum_i coeffs[i] * v_i for all vectors v_i in 'vecs' and returns (y, y) */
+template<typename NumericT>
+NumericT multi_vector_update(viennacl::vector_base<NumericT> & y, viennacl::vector_tuple<NumericT> const & vecs, std::vector<NumericT> const & coeffs)
+{
+  if (viennacl::traits::active_handle_id(y) == viennacl::MAIN_MEMORY)
+    return viennacl::linalg::pipelined_multi_update(y, vecs, coeffs);
+
+  for (vcl_size_t i = 0; i < vecs.const_size(); ++i)
+    y -= coeffs[i] * vecs.const_at(i);
+  return viennacl::linalg::inner_prod(y, y);
+}
+
+/** @brief Computes y_i = alpha * x_i + beta * y_i for all pairs of vectors in 'y_vecs' and 'x_vecs' */
+template<typename NumericT>
+void multi_vector_axpby(viennacl::vector_tuple<NumericT> const & y_vecs, NumericT alpha, viennacl::vector_tuple<NumericT> const & x_vecs, NumericT beta)
+{
+  if (y_vecs.size() == 0)
+    return;
+
+  if (viennacl::traits::active_handle_id(y_vecs.at(0)) == viennacl::MAIN_MEMORY)
+  {
+    viennacl::linalg::pipelined_multi_axpby(y_vecs, alpha, x_vecs, beta);
+    return;
+  }
+
+  for (vcl_size_t i = 0; i < y_vecs.size(); ++i)
+    y_vecs.at(i) = alpha * x_vecs.const_at(i) + beta * y_vecs.at(i);
+}
+
+/** @brief Computes the Gram matrix gram[i * m + j] = (v_i, v_j) of the m vectors in 'vecs' */
+template<typename NumericT>
+void multi_vector_gram_matrix(viennacl::vector_tuple<NumericT> const & vecs, std::vector<NumericT> & gram)
+{
+  vcl_size_t m = vecs.const_size();
+  if (m == 0)
+    return;
+
+  if (viennacl::traits::active_handle_id(vecs.const_at(0)) == viennacl::MAIN_MEMORY)
+  {
+    viennacl::linalg::pipelined_gram_matrix(vecs, gram);
+    return;
+  }
+
+  gram.resize(m * m);
+  for (vcl_size_t i = 0; i < m; ++i)
+    for (vcl_size_t j = 0; j <= i; ++j)
+    {
+      gram[i * m + j] = viennacl::linalg::inner_prod(vecs.const_at(i), vecs.const_at(j));
+      gram[j * m + i] = gram[i * m + j];
+    }
+}
+
+/** @brief Computes result = A * precond^{-1} * x for right-preconditioned solvers and returns precond^{-1} * x. 'temp' is used as storage for precond^{-1} * x. */
+template<typename MatrixT, typename NumericT, typename PreconditionerT>
+viennacl::vector<NumericT> const & multi_vector_precond_prod(MatrixT const & A, PreconditionerT const & precond,
+                                                             viennacl::vector<NumericT> const & x, viennacl::vector<NumericT> & result, viennacl::vector<NumericT> & temp)
+{
+  temp = x;
+  precond.apply(temp);
+  result = viennacl::linalg::prod(A, temp);
+  return temp;
+}
+
+template<typename MatrixT, typename NumericT>
+viennacl::vector<NumericT> const & multi_vector_precond_prod(MatrixT const & A, viennacl::linalg::no_precond const &,
+                                                             viennacl::vector<NumericT> const & x, viennacl::vector<NumericT> & result, viennacl::vector<NumericT> &)
+{
+  result = viennacl::linalg::prod(A, x);
+  return x;
+}
+
+} //namespace detail
+} //namespace linalg
+} //namespace viennacl
+
+#endif
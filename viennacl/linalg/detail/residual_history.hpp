@@ -0,0 +1,64 @@
+#ifndef VIENNACL_LINALG_DETAIL_RESIDUAL_HISTORY_HPP_
+#define VIENNACL_LINALG_DETAIL_RESIDUAL_HISTORY_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/residual_history.hpp
+ *  @brief Recording of the estimated relative residuals of the iterative solvers, shared by the solver tags.
+*/
+
+#include <vector>
+
+#include "viennacl/forwards.h"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+
+/** @brief Base class of the iterative solver tags. Records the estimated relative residual of each iteration in a buffer supplied by the user.
+*
+* The buffer is cleared at the start of each solver run. Reserve sufficient capacity beforehand in order to avoid reallocations during the solver run.
+*/
+class residual_history_recorder
+{
+public:
+  residual_history_recorder() : residual_history_(NULL) {}
+
+  /** @brief Sets a buffer in which the estimated relative residual of each iteration is recorded. Pass NULL (default) to disable the recording. */
+  void residual_history(std::vector<double> * history) { residual_history_ = history; }
+  /** @brief Returns the buffer in which the estimated relative residuals are recorded, or NULL if the recording is disabled */
+  std::vector<double> * residual_history() const { return residual_history_; }
+
+  /** @brief Clears the residual history (if any). Called by the solver at the start of each run. */
+  void clear_residual_history() const { if (residual_history_) residual_history_->clear(); }
+  /** @brief Appends an estimated relative residual to the residual history (if any). Called by the solver after each iteration. */
+  void record_residual(double r) const { if (residual_history_) residual_history_->push_back(r); }
+
+private:
+  std::vector<double> * residual_history_;
+};
+
+} //namespace detail
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
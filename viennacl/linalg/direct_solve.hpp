@@ -266,7 +266,8 @@ template<typename MatrixT1, typename MatrixT2, typename SolverTagT>
 void inplace_solve_lower_impl(MatrixT1 const & A, MatrixT2 & B, SolverTagT)
 {
   vcl_size_t blockSize = VIENNACL_DIRECT_SOLVE_BLOCKSIZE;
-  if (A.size1() <= blockSize)
+  // the host backend is blocked itself and solves for the right hand sides in parallel:
+  if (A.size1() <= blockSize || viennacl::traits::handle(A).get_active_handle_id() == viennacl::MAIN_MEMORY)
     inplace_solve_kernel(A, B, SolverTagT());
   else
   {
@@ -311,7 +312,8 @@ template<typename MatrixT1, typename MatrixT2, typename SolverTagT>
 void inplace_solve_upper_impl(MatrixT1 const & A, MatrixT2 & B, SolverTagT)
 {
   vcl_size_t blockSize = VIENNACL_DIRECT_SOLVE_BLOCKSIZE;
-  if (A.size1() <= blockSize)
+  // the host backend is blocked itself and solves for the right hand sides in parallel:
+  if (A.size1() <= blockSize || viennacl::traits::handle(A).get_active_handle_id() == viennacl::MAIN_MEMORY)
     inplace_solve_kernel(A, B, SolverTagT());
   else
   {
@@ -375,6 +377,12 @@ void inplace_solve(const matrix_base<NumericT> & A,
                    matrix_expression<const matrix_base<NumericT>, const matrix_base<NumericT>, op_trans> proxy_B,
                    SolverTagT)
 {
+  if (viennacl::traits::handle(A).get_active_handle_id() == viennacl::MAIN_MEMORY) // no transposed copy required
+  {
+    inplace_solve_kernel(A, proxy_B, SolverTagT());
+    return;
+  }
+
   matrix_base<NumericT> B(proxy_B);
   inplace_solve_impl(A,B,SolverTagT());
   B=trans(B);
@@ -392,6 +400,12 @@ void inplace_solve(const matrix_expression< const matrix_base<NumericT>, const m
                    matrix_base<NumericT> & B,
                    SolverTagT)
 {
+  if (viennacl::traits::handle(B).get_active_handle_id() == viennacl::MAIN_MEMORY) // no transposed copy required
+  {
+    inplace_solve_kernel(proxy_A, B, SolverTagT());
+    return;
+  }
+
   matrix_base<NumericT> A(proxy_A);
   inplace_solve_impl(A,B,SolverTagT());
 }
@@ -406,6 +420,12 @@ void inplace_solve(matrix_expression< const matrix_base<NumericT>, const matrix_
                    matrix_expression< const matrix_base<NumericT>, const matrix_base<NumericT>, op_trans>         proxy_B,
                    SolverTagT)
 {
+  if (viennacl::traits::handle(proxy_A.lhs()).get_active_handle_id() == viennacl::MAIN_MEMORY) // no transposed copies required
+  {
+    inplace_solve_kernel(proxy_A, proxy_B, SolverTagT());
+    return;
+  }
+
   matrix_base<NumericT> A(proxy_A);
   matrix_base<NumericT> B(proxy_B);
   inplace_solve_impl(A,B,SolverTagT());
@@ -26,13 +26,16 @@
 #include <cmath>
 #include <limits>
 #include "viennacl/forwards.h"
+#include "viennacl/linalg/detail/residual_history.hpp"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/iterative_operations.hpp"
 #include "viennacl/traits/clear.hpp"
 #include "viennacl/traits/size.hpp"
 #include "viennacl/meta/result_of.hpp"
+#include "viennacl/linalg/detail/multi_rhs.hpp"
 
 namespace viennacl
 {
@@ -41,7 +44,7 @@ namespace linalg
 
 /** @brief A tag for the solver GMRES. Used for supplying solver parameters and for dispatching the solve() function
 */
-class gmres_tag       //generalized minimum residual
+class gmres_tag : public detail::residual_history_recorder       //generalized minimum residual
 {
 public:
   /** @brief The constructor
@@ -155,187 +158,652 @@ namespace detail
 
 }
 
-/** @brief Implementation of the GMRES solver.
-*
-* Following the algorithm proposed by Walker in "A Simpler GMRES"
-*
-* @param matrix     The system matrix
-* @param rhs        The load vector
-* @param tag        Solver configuration tag
-* @param precond    A preconditioner. Precondition operation is done via member function apply()
-* @return The result vector
-*/
-template<typename MatrixT, typename VectorT, typename PreconditionerT>
-VectorT solve(MatrixT const & matrix, VectorT const & rhs, gmres_tag const & tag, PreconditionerT const & precond)
+namespace detail
 {
-  typedef typename viennacl::result_of::value_type<VectorT>::type            NumericType;
-  typedef typename viennacl::result_of::cpu_value_type<NumericType>::type    CPU_NumericType;
-  unsigned int problem_size = static_cast<unsigned int>(viennacl::traits::size(rhs));
-  VectorT result = rhs;
-  viennacl::traits::clear(result);
 
-  std::size_t krylov_dim = static_cast<std::size_t>(tag.krylov_dim());
-  if (problem_size < krylov_dim)
-    krylov_dim = problem_size; //A Krylov space larger than the matrix would lead to seg-faults (mathematically, error is certain to be zero already)
+  /** @brief Implementation of the GMRES solver.
+  *
+  * Following the algorithm proposed by Walker in "A Simpler GMRES"
+  *
+  * @param matrix     The system matrix
+  * @param rhs        The load vector
+  * @param tag        Solver configuration tag
+  * @param precond    A preconditioner. Precondition operation is done via member function apply()
+  * @param initial_guess  Pointer to the initial guess. A zero initial guess is used if NULL.
+  * @return The result vector
+  */
+  template<typename MatrixT, typename VectorT, typename PreconditionerT>
+  VectorT gmres_solve(MatrixT const & matrix, VectorT const & rhs, gmres_tag const & tag, PreconditionerT const & precond, VectorT const * initial_guess)
+  {
+    typedef typename viennacl::result_of::value_type<VectorT>::type            NumericType;
+    typedef typename viennacl::result_of::cpu_value_type<NumericType>::type    CPU_NumericType;
+    unsigned int problem_size = static_cast<unsigned int>(viennacl::traits::size(rhs));
+    VectorT result = rhs;
+    viennacl::traits::clear(result);
 
-  VectorT res = rhs;
-  VectorT v_k_tilde = rhs;
-  VectorT v_k_tilde_temp = rhs;
+    std::size_t krylov_dim = static_cast<std::size_t>(tag.krylov_dim());
+    if (problem_size < krylov_dim)
+      krylov_dim = problem_size; //A Krylov space larger than the matrix would lead to seg-faults (mathematically, error is certain to be zero already)
 
-  std::vector< std::vector<CPU_NumericType> > R(krylov_dim, std::vector<CPU_NumericType>(tag.krylov_dim()));
-  std::vector<CPU_NumericType> projection_rhs(krylov_dim);
+    VectorT res = rhs;
+    VectorT v_k_tilde = rhs;
+    VectorT v_k_tilde_temp = rhs;
 
-  std::vector<VectorT>          householder_reflectors(krylov_dim, rhs);
-  std::vector<CPU_NumericType>  betas(krylov_dim);
+    std::vector< std::vector<CPU_NumericType> > R(krylov_dim, std::vector<CPU_NumericType>(tag.krylov_dim()));
+    std::vector<CPU_NumericType> projection_rhs(krylov_dim);
 
-  CPU_NumericType norm_rhs = viennacl::linalg::norm_2(rhs);
+    std::vector<VectorT>          householder_reflectors(krylov_dim, rhs);
+    std::vector<CPU_NumericType>  betas(krylov_dim);
 
-  if (norm_rhs == 0) //solution is zero if RHS norm is zero
-    return result;
+    tag.iters(0);
+    tag.clear_residual_history();
 
-  tag.iters(0);
+    CPU_NumericType norm_rhs = viennacl::linalg::norm_2(rhs);
 
-  for (unsigned int it = 0; it <= tag.max_restarts(); ++it)
-  {
-    //
-    // (Re-)Initialize residual: r = b - A*x (without temporary for the result of A*x)
-    //
-    res = rhs;
-    res -= viennacl::linalg::prod(matrix, result);  //initial guess zero
-    precond.apply(res);
-
-    CPU_NumericType rho_0 = viennacl::linalg::norm_2(res);
-
-    //
-    // Check for premature convergence
-    //
-    if (rho_0 / norm_rhs < tag.tolerance() ) // norm_rhs is known to be nonzero here
+    if (norm_rhs == 0) //solution is zero if RHS norm is zero
     {
-      tag.error(rho_0 / norm_rhs);
+      tag.error(0);
       return result;
     }
 
-    //
-    // Normalize residual and set 'rho' to 1 as requested in 'A Simpler GMRES' by Walker and Zhou.
-    //
-    res /= rho_0;
-    CPU_NumericType rho = static_cast<CPU_NumericType>(1.0);
-
+    if (initial_guess)
+      result = *initial_guess;
 
-    //
-    // Iterate up until maximal Krylove space dimension is reached:
-    //
-    std::size_t k = 0;
-    for (k = 0; k < krylov_dim; ++k)
+    for (unsigned int it = 0; it <= tag.max_restarts(); ++it)
     {
-      tag.iters( tag.iters() + 1 ); //increase iteration counter
+      //
+      // (Re-)Initialize residual: r = b - A*x (without temporary for the result of A*x)
+      //
+      res = rhs;
+      res -= viennacl::linalg::prod(matrix, result);
+      precond.apply(res);
 
-      // prepare storage:
-      viennacl::traits::clear(R[k]);
-      viennacl::traits::clear(householder_reflectors[k]);
+      CPU_NumericType rho_0 = viennacl::linalg::norm_2(res);
 
-      //compute v_k = A * v_{k-1} via Householder matrices
-      if (k == 0)
+      //
+      // Check for premature convergence
+      //
+      if (rho_0 / norm_rhs < tag.tolerance() ) // norm_rhs is known to be nonzero here
       {
-        v_k_tilde = viennacl::linalg::prod(matrix, res);
-        precond.apply(v_k_tilde);
+        tag.error(rho_0 / norm_rhs);
+        return result;
       }
-      else
+
+      //
+      // Normalize residual and set 'rho' to 1 as requested in 'A Simpler GMRES' by Walker and Zhou.
+      //
+      res /= rho_0;
+      CPU_NumericType rho = static_cast<CPU_NumericType>(1.0);
+
+
+      //
+      // Iterate up until maximal Krylove space dimension is reached:
+      //
+      std::size_t k = 0;
+      for (k = 0; k < krylov_dim; ++k)
       {
-        viennacl::traits::clear(v_k_tilde);
-        v_k_tilde[k-1] = CPU_NumericType(1);
+        tag.iters( tag.iters() + 1 ); //increase iteration counter
+
+        // prepare storage:
+        viennacl::traits::clear(R[k]);
+        viennacl::traits::clear(householder_reflectors[k]);
+
+        //compute v_k = A * v_{k-1} via Householder matrices
+        if (k == 0)
+        {
+          v_k_tilde = viennacl::linalg::prod(matrix, res);
+          precond.apply(v_k_tilde);
+        }
+        else
+        {
+          viennacl::traits::clear(v_k_tilde);
+          v_k_tilde[k-1] = CPU_NumericType(1);
+
+          //Householder rotations, part 1: Compute P_1 * P_2 * ... * P_{k-1} * e_{k-1}
+          for (int i = static_cast<int>(k)-1; i > -1; --i)
+            detail::gmres_householder_reflect(v_k_tilde, householder_reflectors[i], betas[i]);
+
+          v_k_tilde_temp = viennacl::linalg::prod(matrix, v_k_tilde);
+          precond.apply(v_k_tilde_temp);
+          v_k_tilde = v_k_tilde_temp;
+
+          //Householder rotations, part 2: Compute P_{k-1} * ... * P_{1} * v_k_tilde
+          for (unsigned int i = 0; i < k; ++i)
+            detail::gmres_householder_reflect(v_k_tilde, householder_reflectors[i], betas[i]);
+        }
+
+        //
+        // Compute Householder reflection for v_k_tilde such that all entries below k-th entry are zero:
+        //
+        CPU_NumericType rho_k_k = 0;
+        detail::gmres_setup_householder_vector(v_k_tilde, householder_reflectors[k], betas[k], rho_k_k, k);
+
+        //
+        // copy first k entries from v_k_tilde to R[k] in order to fill k-th column with result of
+        // P_k * v_k_tilde = (v[0], ... , v[k-1], norm(v), 0, 0, ...) =: (rho_{1,k}, rho_{2,k}, ..., rho_{k,k}, 0, ..., 0);
+        //
+        detail::gmres_copy_helper(v_k_tilde, R[k], k);
+        R[k][k] = rho_k_k;
+
+        //
+        // Update residual: r = P_k r
+        // Set zeta_k = r[k] including machine precision considerations: mathematically we have |r[k]| <= rho
+        // Set rho *= sin(acos(r[k] / rho))
+        //
+        detail::gmres_householder_reflect(res, householder_reflectors[k], betas[k]);
+
+        if (res[k] > rho) //machine precision reached
+          res[k] = rho;
+        if (res[k] < -rho) //machine precision reached
+          res[k] = -rho;
+        projection_rhs[k] = res[k];
+
+        rho *= std::sin( std::acos(projection_rhs[k] / rho) );
+        tag.record_residual(std::fabs(rho * rho_0 / norm_rhs));
+
+        if (std::fabs(rho * rho_0 / norm_rhs) < tag.tolerance())  // Residual is sufficiently reduced, stop here
+        {
+          tag.error( std::fabs(rho*rho_0 / norm_rhs) );
+          ++k;
+          break;
+        }
+      } // for k
 
-        //Householder rotations, part 1: Compute P_1 * P_2 * ... * P_{k-1} * e_{k-1}
-        for (int i = static_cast<int>(k)-1; i > -1; --i)
-          detail::gmres_householder_reflect(v_k_tilde, householder_reflectors[i], betas[i]);
+      //
+      // Triangular solver stage:
+      //
 
-        v_k_tilde_temp = viennacl::linalg::prod(matrix, v_k_tilde);
-        precond.apply(v_k_tilde_temp);
-        v_k_tilde = v_k_tilde_temp;
+      for (int i=static_cast<int>(k)-1; i>-1; --i)
+      {
+        for (vcl_size_t j=static_cast<vcl_size_t>(i)+1; j<k; ++j)
+          projection_rhs[i] -= R[j][i] * projection_rhs[j];     //R is transposed
 
-        //Householder rotations, part 2: Compute P_{k-1} * ... * P_{1} * v_k_tilde
-        for (unsigned int i = 0; i < k; ++i)
-          detail::gmres_householder_reflect(v_k_tilde, householder_reflectors[i], betas[i]);
+        projection_rhs[i] /= R[i][i];
       }
 
       //
-      // Compute Householder reflection for v_k_tilde such that all entries below k-th entry are zero:
+      // Note: 'projection_rhs' now holds the solution (eta_1, ..., eta_k)
       //
-      CPU_NumericType rho_k_k = 0;
-      detail::gmres_setup_householder_vector(v_k_tilde, householder_reflectors[k], betas[k], rho_k_k, k);
+
+      res *= projection_rhs[0];
+
+      if (k > 0)
+      {
+        for (unsigned int i = 0; i < k-1; ++i)
+          res[i] += projection_rhs[i+1];
+      }
 
       //
-      // copy first k entries from v_k_tilde to R[k] in order to fill k-th column with result of
-      // P_k * v_k_tilde = (v[0], ... , v[k-1], norm(v), 0, 0, ...) =: (rho_{1,k}, rho_{2,k}, ..., rho_{k,k}, 0, ..., 0);
+      // Form z inplace in 'res' by applying P_1 * ... * P_{k}
       //
-      detail::gmres_copy_helper(v_k_tilde, R[k], k);
-      R[k][k] = rho_k_k;
+      for (int i=static_cast<int>(k)-1; i>=0; --i)
+        detail::gmres_householder_reflect(res, householder_reflectors[i], betas[i]);
+
+      res *= rho_0;
+      result += res;  // x += rho_0 * z    in the paper
 
       //
-      // Update residual: r = P_k r
-      // Set zeta_k = r[k] including machine precision considerations: mathematically we have |r[k]| <= rho
-      // Set rho *= sin(acos(r[k] / rho))
+      // Check for convergence:
       //
-      detail::gmres_householder_reflect(res, householder_reflectors[k], betas[k]);
+      tag.error(std::fabs(rho*rho_0 / norm_rhs));
+      if ( tag.error() < tag.tolerance() )
+        return result;
+    }
 
-      if (res[k] > rho) //machine precision reached
-        res[k] = rho;
-      if (res[k] < -rho) //machine precision reached
-        res[k] = -rho;
-      projection_rhs[k] = res[k];
+    return result;
+  }
 
-      rho *= std::sin( std::acos(projection_rhs[k] / rho) );
+  /** @brief Implementation of the GMRES solver for multiple right hand sides, given as the columns of a dense matrix.
+  *
+  * Each column runs its own restarted GMRES iteration (Arnoldi process with modified Gram-Schmidt orthogonalization and Givens rotations, see Algorithm 6.9 in
+  * "Iterative Methods for Sparse Linear Systems" by Y. Saad), but the products with the system matrix are carried out for all columns at once
+  * (sparse matrix times dense matrix), so the system matrix is read only once per iteration. Columns which have already converged are no longer updated.
+  * The estimated relative error stored in the tag is the maximum over all columns.
+  *
+  * @param matrix     The system matrix
+  * @param rhs        The right hand sides, one per column
+  * @param tag        Solver configuration tag
+  * @param precond    A preconditioner. Precondition operation is done via member function apply()
+  * @param initial_guess  Pointer to the initial guesses (one per column). Zero initial guesses are used if NULL.
+  * @return The matrix of result vectors
+  */
+  template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV, typename PreconditionerT>
+  viennacl::matrix<NumericT, F, AlignmentV> gmres_solve_multi_rhs(MatrixT const & matrix, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, gmres_tag const & tag, PreconditionerT const & precond,
+                                                                  viennacl::matrix<NumericT, F, AlignmentV> const * initial_guess)
+  {
+    typedef viennacl::matrix<NumericT, viennacl::column_major>   DenseMatrixType;   // column-major, so that the columns are contiguous in memory
 
-      if (std::fabs(rho * rho_0 / norm_rhs) < tag.tolerance())  // Residual is sufficiently reduced, stop here
-      {
-        tag.error( std::fabs(rho*rho_0 / norm_rhs) );
-        ++k;
-        break;
-      }
-    } // for k
+    vcl_size_t problem_size = rhs.size1();
+    vcl_size_t num_rhs      = rhs.size2();
 
-    //
-    // Triangular solver stage:
-    //
+    vcl_size_t krylov_dim = static_cast<vcl_size_t>(tag.krylov_dim());
+    if (problem_size < krylov_dim)
+      krylov_dim = problem_size; //A Krylov space larger than the matrix would lead to seg-faults (mathematically, error is certain to be zero already)
 
-    for (int i=static_cast<int>(k)-1; i>-1; --i)
+    DenseMatrixType B = detail::multi_rhs_convert<DenseMatrixType>(rhs);
+    DenseMatrixType result(problem_size, num_rhs, viennacl::traits::context(rhs));
+    result.clear();
+
+    DenseMatrixType w(problem_size, num_rhs, viennacl::traits::context(rhs));
+    std::vector<DenseMatrixType> V(krylov_dim + 1, w);   // Krylov basis vectors v_k of all columns
+    viennacl::vector<NumericT> precond_tmp(problem_size, viennacl::traits::context(rhs));
+
+    // Hessenberg matrices (row-major, (krylov_dim+1) x krylov_dim), Givens rotations, and projected right hand sides for each column:
+    std::vector<std::vector<NumericT> > H(num_rhs, std::vector<NumericT>((krylov_dim + 1) * krylov_dim));
+    std::vector<std::vector<NumericT> > givens_c(num_rhs, std::vector<NumericT>(krylov_dim));
+    std::vector<std::vector<NumericT> > givens_s(num_rhs, std::vector<NumericT>(krylov_dim));
+    std::vector<std::vector<NumericT> > projection_rhs(num_rhs, std::vector<NumericT>(krylov_dim + 1));
+
+    std::vector<NumericT> norm_rhs;
+    detail::multi_rhs_column_norms(B, norm_rhs);
+
+    std::vector<NumericT>   rel_error(num_rhs, NumericT(0));
+    std::vector<vcl_size_t> krylov_size(num_rhs);
+    std::vector<bool>       active(num_rhs);
+    vcl_size_t num_active = 0;
+    for (vcl_size_t j = 0; j < num_rhs; ++j)
     {
-      for (vcl_size_t j=static_cast<vcl_size_t>(i)+1; j<k; ++j)
-        projection_rhs[i] -= R[j][i] * projection_rhs[j];     //R is transposed
+      active[j] = (norm_rhs[j] > 0); //solution is zero if RHS norm is zero
+      if (active[j])
+        ++num_active;
+    }
 
-      projection_rhs[i] /= R[i][i];
+    tag.iters(0);
+    tag.clear_residual_history();
+    if (initial_guess) // the residuals are computed from the initial guesses at the first restart
+    {
+      DenseMatrixType initial_guess_colmajor = detail::multi_rhs_convert<DenseMatrixType>(*initial_guess);
+      for (vcl_size_t j = 0; j < num_rhs; ++j)
+        if (active[j])
+          detail::multi_rhs_column<NumericT>(result, j) = detail::multi_rhs_column<NumericT>(initial_guess_colmajor, j);
     }
 
-    //
-    // Note: 'projection_rhs' now holds the solution (eta_1, ..., eta_k)
-    //
+    for (unsigned int it = 0; it <= tag.max_restarts() && num_active > 0; ++it)
+    {
+      //
+      // (Re-)Initialize residuals: r = b - A*x
+      //
+      detail::multi_rhs_prod(matrix, result, w);
+      for (vcl_size_t j = 0; j < num_rhs; ++j)
+        if (active[j])
+          detail::multi_rhs_column<NumericT>(w, j) = detail::multi_rhs_column<NumericT>(B, j) - detail::multi_rhs_column<NumericT>(w, j);
+      detail::multi_rhs_precond_apply(precond, w, active, precond_tmp);
+
+      std::vector<bool> in_cycle(num_rhs, false);
+      vcl_size_t num_in_cycle = 0;
+      for (vcl_size_t j = 0; j < num_rhs; ++j)
+      {
+        krylov_size[j] = 0;
+        if (!active[j])
+          continue;
+
+        detail::multi_rhs_column<NumericT> w_j(w, j);
+        NumericT rho_0 = viennacl::linalg::norm_2(w_j);
+
+        rel_error[j] = rho_0 / norm_rhs[j];
+        if (rel_error[j] < tag.tolerance()) // Check for premature convergence
+        {
+          active[j] = false;
+          --num_active;
+          continue;
+        }
+
+        detail::multi_rhs_column<NumericT>(V[0], j) = w_j / rho_0;
+        std::fill(projection_rhs[j].begin(), projection_rhs[j].end(), NumericT(0));
+        projection_rhs[j][0] = rho_0;
+        in_cycle[j] = true;
+        ++num_in_cycle;
+      }
 
-    res *= projection_rhs[0];
+      //
+      // Arnoldi process for all columns, up until maximal Krylov space dimension is reached:
+      //
+      for (vcl_size_t k = 0; k < krylov_dim && num_in_cycle > 0; ++k)
+      {
+        tag.iters( tag.iters() + 1 ); //increase iteration counter
+
+        detail::multi_rhs_prod(matrix, V[k], w);
+        detail::multi_rhs_precond_apply(precond, w, in_cycle, precond_tmp);
+
+        for (vcl_size_t j = 0; j < num_rhs; ++j)
+        {
+          if (!in_cycle[j])
+            continue;
+
+          std::vector<NumericT> & H_j = H[j];
+          std::vector<NumericT> & g_j = projection_rhs[j];
+          detail::multi_rhs_column<NumericT> w_j(w, j);
+
+          // modified Gram-Schmidt:
+          for (vcl_size_t i = 0; i <= k; ++i)
+          {
+            detail::multi_rhs_column<NumericT> v_i(V[i], j);
+            NumericT h_ik = viennacl::linalg::inner_prod(w_j, v_i);
+            w_j -= h_ik * v_i;
+            H_j[i * krylov_dim + k] = h_ik;
+          }
+
+          NumericT h_kplus1_k = viennacl::linalg::norm_2(w_j);
+          if (h_kplus1_k > 0)
+            detail::multi_rhs_column<NumericT>(V[k+1], j) = w_j / h_kplus1_k;
+
+          // apply previous Givens rotations to the new column of the Hessenberg matrix:
+          for (vcl_size_t i = 0; i < k; ++i)
+          {
+            NumericT h_i = H_j[ i    * krylov_dim + k];
+            NumericT h_j = H_j[(i+1) * krylov_dim + k];
+            H_j[ i    * krylov_dim + k] =  givens_c[j][i] * h_i + givens_s[j][i] * h_j;
+            H_j[(i+1) * krylov_dim + k] = -givens_s[j][i] * h_i + givens_c[j][i] * h_j;
+          }
+
+          // new Givens rotation eliminating h_{k+1,k}:
+          NumericT h_kk  = H_j[k * krylov_dim + k];
+          NumericT gamma = std::sqrt(h_kk * h_kk + h_kplus1_k * h_kplus1_k);
+          givens_c[j][k] = (gamma > 0) ? h_kk / gamma : NumericT(1);
+          givens_s[j][k] = (gamma > 0) ? h_kplus1_k / gamma : NumericT(0);
+          H_j[k * krylov_dim + k] = gamma;
+
+          g_j[k+1] = -givens_s[j][k] * g_j[k];
+          g_j[k]   =  givens_c[j][k] * g_j[k];
+
+          krylov_size[j] = k + 1;
+          rel_error[j] = std::fabs(g_j[k+1]) / norm_rhs[j];
+          if (rel_error[j] < tag.tolerance() || h_kplus1_k <= 0) // Residual is sufficiently reduced (or Krylov space is invariant), stop here
+          {
+            in_cycle[j] = false;
+            --num_in_cycle;
+          }
+        }
+
+        tag.record_residual(*std::max_element(rel_error.begin(), rel_error.end()));
+      }
 
-    if (k > 0)
-    {
-      for (unsigned int i = 0; i < k-1; ++i)
-        res[i] += projection_rhs[i+1];
+      //
+      // Triangular solver stage and update of the result: x += V y
+      //
+      for (vcl_size_t j = 0; j < num_rhs; ++j)
+      {
+        vcl_size_t k = krylov_size[j];
+        if (k == 0)
+          continue;
+
+        std::vector<NumericT> & y = projection_rhs[j];
+        for (vcl_size_t i2 = 0; i2 < k; ++i2)
+        {
+          vcl_size_t i = k - i2 - 1;
+          for (vcl_size_t l = i + 1; l < k; ++l)
+            y[i] -= H[j][i * krylov_dim + l] * y[l];
+          y[i] /= H[j][i * krylov_dim + i];
+        }
+
+        detail::multi_rhs_column<NumericT> result_j(result, j);
+        for (vcl_size_t i = 0; i < k; ++i)
+          result_j += y[i] * detail::multi_rhs_column<NumericT>(V[i], j);
+
+        if (rel_error[j] < tag.tolerance())
+        {
+          active[j] = false;
+          --num_active;
+        }
+      }
     }
 
-    //
-    // Form z inplace in 'res' by applying P_1 * ... * P_{k}
-    //
-    for (int i=static_cast<int>(k)-1; i>=0; --i)
-      detail::gmres_householder_reflect(res, householder_reflectors[i], betas[i]);
+    //store last error estimate:
+    tag.error(rel_error.size() > 0 ? *std::max_element(rel_error.begin(), rel_error.end()) : 0);
 
-    res *= rho_0;
-    result += res;  // x += rho_0 * z    in the paper
+    return detail::multi_rhs_convert<viennacl::matrix<NumericT, F, AlignmentV> >(result);
+  }
+
+  /** @brief Implementation of a pipelined GMRES solver (no preconditioner) for a compressed_matrix in host memory.
+  *
+  * Uses the Arnoldi process with classical Gram-Schmidt orthogonalization and Givens rotations (see Algorithm 6.9 in "Iterative Methods for Sparse Linear Systems" by Y. Saad),
+  * which allows to compute all inner products of an orthogonalization step in a single pass over memory:
+  *  - the matrix-vector product is fused with the inner products of the new vector with all previous basis vectors,
+  *  - the orthogonalization update is fused with the computation of the norm of the new basis vector.
+  * Thus, each iteration requires only two passes over the Krylov basis instead of one per basis vector. The normalization of the basis vectors is deferred
+  * to the next pass by keeping track of the scaling factors on the host. If severe cancellation is detected (criterion by Daniel, Gragg, Kaufman, and Stewart),
+  * the new basis vector is orthogonalized once more, for which the required inner products are already available.
+  */
+  template<typename NumericT>
+  viennacl::vector<NumericT> pipelined_gmres_solve(viennacl::compressed_matrix<NumericT> const & A,
+                                                   viennacl::vector<NumericT> const & rhs,
+                                                   gmres_tag const & tag,
+                                                   viennacl::vector<NumericT> const * initial_guess)
+  {
+    vcl_size_t problem_size = rhs.size();
+    viennacl::vector<NumericT> result(problem_size, viennacl::traits::context(rhs));
+    result.clear();
 
-    //
-    // Check for convergence:
-    //
-    tag.error(std::fabs(rho*rho_0 / norm_rhs));
-    if ( tag.error() < tag.tolerance() )
+    vcl_size_t krylov_dim = static_cast<vcl_size_t>(tag.krylov_dim());
+    if (problem_size < krylov_dim)
+      krylov_dim = problem_size; //A Krylov space larger than the matrix would lead to seg-faults (mathematically, error is certain to be zero already)
+
+    tag.iters(0);
+    tag.clear_residual_history();
+
+    NumericT norm_rhs = viennacl::linalg::norm_2(rhs);
+    if (norm_rhs == 0) //solution is zero if RHS norm is zero
+    {
+      tag.error(0);
       return result;
+    }
+
+    if (initial_guess)
+      result = *initial_guess;
+
+    // Krylov basis vectors v_0, ..., v_{krylov_dim}, stored one after another. v_i is scaled by krylov_scaling[i] to obtain unit norm.
+    viennacl::vector<NumericT> krylov_basis((krylov_dim + 1) * problem_size, viennacl::traits::context(rhs));
+    viennacl::vector_range<viennacl::vector<NumericT> > v_0(krylov_basis, viennacl::range(0, problem_size));
+    std::vector<NumericT> krylov_scaling(krylov_dim + 1);
+
+    // Hessenberg matrix (row-major, (krylov_dim+1) x krylov_dim), Givens rotations, and projected right hand side:
+    std::vector<NumericT> H((krylov_dim + 1) * krylov_dim);
+    std::vector<NumericT> givens_c(krylov_dim);
+    std::vector<NumericT> givens_s(krylov_dim);
+    std::vector<NumericT> projection_rhs(krylov_dim + 1);
+
+    std::vector<NumericT> inner_prods(krylov_dim + 2);
+    std::vector<NumericT> coeffs(krylov_dim + 1);
+
+    NumericT rel_error = 1;
+    for (unsigned int it = 0; it <= tag.max_restarts(); ++it)
+    {
+      //
+      // (Re-)Initialize residual: r = b - A*x
+      //
+      v_0 = rhs;
+      v_0 -= viennacl::linalg::prod(A, result);
+
+      NumericT rho_0 = viennacl::linalg::norm_2(v_0);
+      rel_error = rho_0 / norm_rhs;
+      if (rel_error < tag.tolerance()) // Check for premature convergence
+        break;
+
+      krylov_scaling[0] = NumericT(1) / rho_0;
+      std::fill(projection_rhs.begin(), projection_rhs.end(), NumericT(0));
+      projection_rhs[0] = rho_0;
+
+      //
+      // Arnoldi process, up until maximal Krylov space dimension is reached:
+      //
+      vcl_size_t k = 0;
+      while (k < krylov_dim)
+      {
+        tag.iters( tag.iters() + 1 ); //increase iteration counter
+
+        // v_{k+1} = A v_k and inner products with all previous basis vectors:
+        viennacl::linalg::pipelined_gmres_prod(A, krylov_basis, problem_size, k, krylov_scaling[k], inner_prods);
+        NumericT norm_Av = std::sqrt(inner_prods[k+1]);
+
+        for (vcl_size_t i = 0; i <= k; ++i)
+        {
+          H[i * krylov_dim + k] = krylov_scaling[i] * inner_prods[i];
+          coeffs[i] = krylov_scaling[i] * H[i * krylov_dim + k];
+        }
+        viennacl::linalg::pipelined_gmres_gram_schmidt(krylov_basis, problem_size, k, coeffs, inner_prods);
+        NumericT h_kplus1_k = std::sqrt(inner_prods[k+1]);
+
+        if (h_kplus1_k < NumericT(0.7071) * norm_Av) // severe cancellation: orthogonalize once more
+        {
+          for (vcl_size_t i = 0; i <= k; ++i)
+          {
+            NumericT correction = krylov_scaling[i] * inner_prods[i];
+            H[i * krylov_dim + k] += correction;
+            coeffs[i] = krylov_scaling[i] * correction;
+          }
+          viennacl::linalg::pipelined_gmres_gram_schmidt(krylov_basis, problem_size, k, coeffs, inner_prods);
+          h_kplus1_k = std::sqrt(inner_prods[k+1]);
+        }
+        krylov_scaling[k+1] = (h_kplus1_k > 0) ? NumericT(1) / h_kplus1_k : NumericT(0);
+
+        // apply previous Givens rotations to the new column of the Hessenberg matrix:
+        for (vcl_size_t i = 0; i < k; ++i)
+        {
+          NumericT h_i = H[ i    * krylov_dim + k];
+          NumericT h_j = H[(i+1) * krylov_dim + k];
+          H[ i    * krylov_dim + k] =  givens_c[i] * h_i + givens_s[i] * h_j;
+          H[(i+1) * krylov_dim + k] = -givens_s[i] * h_i + givens_c[i] * h_j;
+        }
+
+        // new Givens rotation eliminating h_{k+1,k}:
+        NumericT h_kk  = H[k * krylov_dim + k];
+        NumericT gamma = std::sqrt(h_kk * h_kk + h_kplus1_k * h_kplus1_k);
+        givens_c[k] = (gamma > 0) ? h_kk / gamma : NumericT(1);
+        givens_s[k] = (gamma > 0) ? h_kplus1_k / gamma : NumericT(0);
+        H[k * krylov_dim + k] = gamma;
+
+        projection_rhs[k+1] = -givens_s[k] * projection_rhs[k];
+        projection_rhs[k]   =  givens_c[k] * projection_rhs[k];
+
+        ++k;
+        rel_error = std::fabs(projection_rhs[k]) / norm_rhs;
+        tag.record_residual(rel_error);
+        if (rel_error < tag.tolerance() || h_kplus1_k <= 0) // Residual is sufficiently reduced (or Krylov space is invariant), stop here
+          break;
+      }
+
+      //
+      // Triangular solver stage and update of the result: x += V y
+      //
+      for (vcl_size_t i2 = 0; i2 < k; ++i2)
+      {
+        vcl_size_t i = k - i2 - 1;
+        for (vcl_size_t j = i + 1; j < k; ++j)
+          projection_rhs[i] -= H[i * krylov_dim + j] * projection_rhs[j];
+        projection_rhs[i] /= H[i * krylov_dim + i];
+        coeffs[i] = krylov_scaling[i] * projection_rhs[i];
+      }
+      viennacl::linalg::pipelined_gmres_update_result(result, krylov_basis, problem_size, k, coeffs);
+
+      if (rel_error < tag.tolerance())
+        break;
+    }
+
+    //store last error estimate:
+    tag.error(rel_error);
+
+    return result;
   }
 
-  return result;
+}
+
+/** @brief Implementation of the GMRES solver.
+*
+* Following the algorithm proposed by Walker in "A Simpler GMRES"
+*
+* @param matrix     The system matrix
+* @param rhs        The load vector
+* @param tag        Solver configuration tag
+* @param precond    A preconditioner. Precondition operation is done via member function apply()
+* @return The result vector
+*/
+template<typename MatrixT, typename VectorT, typename PreconditionerT>
+VectorT solve(MatrixT const & matrix, VectorT const & rhs, gmres_tag const & tag, PreconditionerT const & precond)
+{
+  return detail::gmres_solve(matrix, rhs, tag, precond, static_cast<VectorT const *>(NULL));
+}
+
+/** @brief GMRES solver starting from the given initial guess. The relative tolerance refers to the norm of the right hand side.
+*
+* @param matrix         The system matrix
+* @param rhs            The load vector
+* @param tag            Solver configuration tag
+* @param precond        A preconditioner. Precondition operation is done via member function apply()
+* @param initial_guess  The initial guess, e.g. the solution of the previous time step
+* @return The result vector
+*/
+template<typename MatrixT, typename VectorT, typename PreconditionerT>
+VectorT solve(MatrixT const & matrix, VectorT const & rhs, gmres_tag const & tag, PreconditionerT const & precond, VectorT const & initial_guess)
+{
+  return detail::gmres_solve(matrix, rhs, tag, precond, &initial_guess);
+}
+
+/** @brief GMRES solver for multiple right hand sides (one per column of 'rhs'), all sharing the products with the system matrix.
+*
+* @param matrix     The system matrix
+* @param rhs        The right hand sides, one per column
+* @param tag        Solver configuration tag
+* @param precond    A preconditioner. Precondition operation is done via member function apply()
+* @return The matrix of result vectors
+*/
+template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV, typename PreconditionerT>
+viennacl::matrix<NumericT, F, AlignmentV> solve(MatrixT const & matrix, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, gmres_tag const & tag, PreconditionerT const & precond)
+{
+  return detail::gmres_solve_multi_rhs(matrix, rhs, tag, precond, static_cast<viennacl::matrix<NumericT, F, AlignmentV> const *>(NULL));
+}
+
+/** @brief GMRES solver for multiple right hand sides (one per column) starting from the given initial guesses.
+*
+* @param matrix         The system matrix
+* @param rhs            The right hand sides, one per column
+* @param tag            Solver configuration tag
+* @param precond        A preconditioner. Precondition operation is done via member function apply()
+* @param initial_guess  The initial guesses, one per column
+* @return The matrix of result vectors
+*/
+template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV, typename PreconditionerT>
+viennacl::matrix<NumericT, F, AlignmentV> solve(MatrixT const & matrix, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, gmres_tag const & tag, PreconditionerT const & precond,
+                                                viennacl::matrix<NumericT, F, AlignmentV> const & initial_guess)
+{
+  return detail::gmres_solve_multi_rhs(matrix, rhs, tag, precond, &initial_guess);
+}
+
+/** @brief GMRES solver (no preconditioner) for a compressed_matrix. Uses the pipelined implementation if the data resides in host memory.
+*
+* @param A          The system matrix
+* @param rhs        The load vector
+* @param tag        Solver configuration tag
+* @return The result vector
+*/
+template<typename NumericT>
+viennacl::vector<NumericT> solve(viennacl::compressed_matrix<NumericT> const & A,
+                                 viennacl::vector<NumericT> const & rhs,
+                                 gmres_tag const & tag,
+                                 viennacl::linalg::no_precond)
+{
+  if (viennacl::traits::active_handle_id(rhs) != viennacl::MAIN_MEMORY)
+    return detail::gmres_solve(A, rhs, tag, viennacl::linalg::no_precond(), static_cast<viennacl::vector<NumericT> const *>(NULL));
+  return detail::pipelined_gmres_solve(A, rhs, tag, static_cast<viennacl::vector<NumericT> const *>(NULL));
+}
+
+/** @brief GMRES solver (no preconditioner) for a compressed_matrix starting from the given initial guess. Uses the pipelined implementation if the data resides in host memory.
+*
+* @param A              The system matrix
+* @param rhs            The load vector
+* @param tag            Solver configuration tag
+* @param initial_guess  The initial guess, e.g. the solution of the previous time step
+* @return The result vector
+*/
+template<typename NumericT>
+viennacl::vector<NumericT> solve(viennacl::compressed_matrix<NumericT> const & A,
+                                 viennacl::vector<NumericT> const & rhs,
+                                 gmres_tag const & tag,
+                                 viennacl::linalg::no_precond,
+                                 viennacl::vector<NumericT> const & initial_guess)
+{
+  if (viennacl::traits::active_handle_id(rhs) != viennacl::MAIN_MEMORY)
+    return detail::gmres_solve(A, rhs, tag, viennacl::linalg::no_precond(), &initial_guess);
+  return detail::pipelined_gmres_solve(A, rhs, tag, &initial_guess);
 }
 
 /** @brief Convenience overload of the solve() function using GMRES. Per default, no preconditioner is used
@@ -0,0 +1,593 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_BATCHED_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_BATCHED_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/batched_operations.hpp
+    @brief Implementations of batched factorizations and solves of many small dense systems using a plain single-threaded or OpenMP-enabled execution on CPU.
+*/
+
+#include <vector>
+#include <cmath>
+
+#include "viennacl/forwards.h"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+  #include <omp.h>
+#endif
+
+// Minimum vector size for using OpenMP on vector operations:
+#ifndef VIENNACL_OPENMP_VECTOR_MIN_SIZE
+  #define VIENNACL_OPENMP_VECTOR_MIN_SIZE  5000
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+  /** @brief Removes the const qualifier from the value type of batched_blocks */
+  template<typename T> struct batched_blocks_value_type          { typedef T type; };
+  template<typename T> struct batched_blocks_value_type<T const> { typedef T type; };
+
+  /** @brief Provides access to the i-th block of 'block_size' consecutive entries of a vector. Strided vectors are copied to a contiguous buffer.
+  *
+  * Blocks of a const vector are accessed read-only through a const value type, e.g. batched_blocks<float const>.
+  */
+  template<typename ValueT>
+  class batched_blocks
+  {
+    typedef typename batched_blocks_value_type<ValueT>::type   NumericT;
+
+  public:
+    template<typename VectorT>
+    batched_blocks(VectorT & vec, vcl_size_t block_size)
+      : data_(detail::extract_raw_pointer<NumericT>(vec) + viennacl::traits::start(vec)),
+        inc_(viennacl::traits::stride(vec)), block_size_(block_size) {}
+
+    /** @brief Returns a pointer to block 'i', which is either located in the vector or (for strided vectors) copied to 'buffer' */
+    ValueT * load(vcl_size_t i, NumericT * buffer) const
+    {
+      if (inc_ == 1)
+        return data_ + i * block_size_;
+
+      for (vcl_size_t k = 0; k < block_size_; ++k)
+        buffer[k] = data_[(i * block_size_ + k) * inc_];
+      return buffer;
+    }
+
+    /** @brief Writes the block 'i' back to the vector if it has been copied to a buffer by load() */
+    void store(vcl_size_t i, NumericT const * buffer) const
+    {
+      if (inc_ == 1)
+        return;
+
+      for (vcl_size_t k = 0; k < block_size_; ++k)
+        data_[(i * block_size_ + k) * inc_] = buffer[k];
+    }
+
+  private:
+    ValueT * data_;
+    vcl_size_t inc_;
+    vcl_size_t block_size_;
+  };
+
+  //
+  // Kernels for a single system. The template parameter N is the system size if known at compile time (which allows the compiler to unroll the loops), or 0 otherwise.
+  //
+
+  /** @brief LU factorization with partial pivoting of the row-major n x n matrix A. Row k was exchanged with row pivots[k].
+  *
+  * @return 0 on success, or k+1 if U(k,k) is exactly zero for the first time in step k (the factorization is completed, but U is singular)
+  */
+  template<vcl_size_t N, typename NumericT>
+  unsigned int batched_lu_factorize_kernel(NumericT * A, unsigned int * pivots, vcl_size_t n_runtime)
+  {
+    vcl_size_t const n = N ? N : n_runtime;
+    unsigned int info = 0;
+
+    for (vcl_size_t k = 0; k < n; ++k)
+    {
+      vcl_size_t pivot_row = k;
+      NumericT pivot_abs = std::fabs(A[k * n + k]);
+      for (vcl_size_t i = k + 1; i < n; ++i)
+        if (std::fabs(A[i * n + k]) > pivot_abs)
+        {
+          pivot_row = i;
+          pivot_abs = std::fabs(A[i * n + k]);
+        }
+      pivots[k] = static_cast<unsigned int>(pivot_row);
+
+      if (pivot_row != k)
+        for (vcl_size_t j = 0; j < n; ++j)
+          std::swap(A[k * n + j], A[pivot_row * n + j]);
+
+      if (pivot_abs <= 0)   // singular, leave column as is
+      {
+        if (info == 0)
+          info = static_cast<unsigned int>(k + 1);
+        continue;
+      }
+
+      NumericT inv_pivot = NumericT(1) / A[k * n + k];
+      for (vcl_size_t i = k + 1; i < n; ++i)
+      {
+        NumericT l_ik = A[i * n + k] * inv_pivot;
+        A[i * n + k] = l_ik;
+        for (vcl_size_t j = k + 1; j < n; ++j)
+          A[i * n + j] -= l_ik * A[k * n + j];
+      }
+    }
+    return info;
+  }
+
+  /** @brief Solves A x = b with the LU factors and pivots computed by batched_lu_factorize_kernel(), overwriting b with x. */
+  template<vcl_size_t N, typename NumericT>
+  void batched_lu_substitute_kernel(NumericT const * LU, unsigned int const * pivots, NumericT * b, vcl_size_t n_runtime)
+  {
+    vcl_size_t const n = N ? N : n_runtime;
+
+    for (vcl_size_t k = 0; k < n; ++k)
+      if (pivots[k] != k)
+        std::swap(b[k], b[pivots[k]]);
+
+    for (vcl_size_t i = 1; i < n; ++i)
+    {
+      NumericT value = b[i];
+      for (vcl_size_t j = 0; j < i; ++j)
+        value -= LU[i * n + j] * b[j];
+      b[i] = value;
+    }
+
+    for (vcl_size_t i2 = 0; i2 < n; ++i2)
+    {
+      vcl_size_t i = n - i2 - 1;
+      NumericT value = b[i];
+      for (vcl_size_t j = i + 1; j < n; ++j)
+        value -= LU[i * n + j] * b[j];
+      b[i] = value / LU[i * n + i];
+    }
+  }
+
+  /** @brief Householder QR factorization of the row-major n x n matrix A.
+  *
+  * R is written to the upper triangle, the Householder vectors v_k (with implicit v_k[k] = 1) below the diagonal. The k-th reflection is I - tau[k] v_k v_k^T.
+  * 'work' needs to hold at least n entries.
+  *
+  * @return 0 on success, or k+1 if R(k,k) is the first diagonal entry of R which is exactly zero
+  */
+  template<vcl_size_t N, typename NumericT>
+  unsigned int batched_qr_factorize_kernel(NumericT * A, NumericT * tau, NumericT * work, vcl_size_t n_runtime)
+  {
+    vcl_size_t const n = N ? N : n_runtime;
+    unsigned int info = 0;
+
+    for (vcl_size_t k = 0; k < n; ++k)
+    {
+      NumericT x0 = A[k * n + k];
+      NumericT sigma = 0;
+      for (vcl_size_t i = k + 1; i < n; ++i)
+        sigma += A[i * n + k] * A[i * n + k];
+
+      if (sigma <= 0) // nothing to eliminate
+      {
+        tau[k] = 0;
+        if (x0 == 0 && info == 0)
+          info = static_cast<unsigned int>(k + 1);
+        continue;
+      }
+
+      NumericT norm_x = std::sqrt(x0 * x0 + sigma);
+      NumericT alpha = (x0 > 0) ? -norm_x : norm_x;
+      NumericT v0 = x0 - alpha;
+      tau[k] = -v0 / alpha;
+      A[k * n + k] = alpha;
+      for (vcl_size_t i = k + 1; i < n; ++i)
+        A[i * n + k] /= v0;
+
+      // trailing columns: A -= tau v (v^T A)
+      for (vcl_size_t j = k + 1; j < n; ++j)
+        work[j] = A[k * n + j];
+      for (vcl_size_t i = k + 1; i < n; ++i)
+      {
+        NumericT v_i = A[i * n + k];
+        for (vcl_size_t j = k + 1; j < n; ++j)
+          work[j] += v_i * A[i * n + j];
+      }
+      for (vcl_size_t j = k + 1; j < n; ++j)
+      {
+        work[j] *= tau[k];
+        A[k * n + j] -= work[j];
+      }
+      for (vcl_size_t i = k + 1; i < n; ++i)
+      {
+        NumericT v_i = A[i * n + k];
+        for (vcl_size_t j = k + 1; j < n; ++j)
+          A[i * n + j] -= v_i * work[j];
+      }
+    }
+    return info;
+  }
+
+  /** @brief Solves A x = b with the QR factorization computed by batched_qr_factorize_kernel(), overwriting b with x. */
+  template<vcl_size_t N, typename NumericT>
+  void batched_qr_solve_kernel(NumericT const * QR, NumericT const * tau, NumericT * b, vcl_size_t n_runtime)
+  {
+    vcl_size_t const n = N ? N : n_runtime;
+
+    // b <- Q^T b
+    for (vcl_size_t k = 0; k < n; ++k)
+    {
+      if (tau[k] == 0)
+        continue;
+
+      NumericT w = b[k];
+      for (vcl_size_t i = k + 1; i < n; ++i)
+        w += QR[i * n + k] * b[i];
+      w *= tau[k];
+      b[k] -= w;
+      for (vcl_size_t i = k + 1; i < n; ++i)
+        b[i] -= QR[i * n + k] * w;
+    }
+
+    // back substitution with R
+    for (vcl_size_t i2 = 0; i2 < n; ++i2)
+    {
+      vcl_size_t i = n - i2 - 1;
+      NumericT value = b[i];
+      for (vcl_size_t j = i + 1; j < n; ++j)
+        value -= QR[i * n + j] * b[j];
+      b[i] = value / QR[i * n + i];
+    }
+  }
+
+
+  /** @brief Sets the first 'batch_count' entries of 'info' to zero, i.e. marks all (empty) systems as nonsingular */
+  inline void batched_clear_info(vector_base<unsigned int> & info, vcl_size_t batch_count)
+  {
+    batched_blocks<unsigned int> info_blocks(info, 1);
+    unsigned int info_buffer;
+    for (vcl_size_t i = 0; i < batch_count; ++i)
+    {
+      unsigned int * inf = info_blocks.load(i, &info_buffer);
+      *inf = 0;
+      info_blocks.store(i, inf);
+    }
+  }
+
+
+  //
+  // Drivers: Loop over the batch, parallelized with OpenMP
+  //
+
+  template<vcl_size_t N, typename NumericT>
+  void batched_lu_factorize_impl(vector_base<NumericT> & matrices, vector_base<unsigned int> & pivots, vcl_size_t n, vcl_size_t batch_count, vector_base<unsigned int> & info)
+  {
+    batched_blocks<NumericT>     A_blocks(matrices, n * n);
+    batched_blocks<unsigned int> pivot_blocks(pivots, n);
+    batched_blocks<unsigned int> info_blocks(info, 1);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel if (batch_count * n * n > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    {
+      std::vector<NumericT>     A_buffer(n * n);
+      std::vector<unsigned int> pivot_buffer(n);
+      unsigned int              info_buffer;
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for
+#endif
+      for (long b = 0; b < static_cast<long>(batch_count); ++b)
+      {
+        vcl_size_t i = static_cast<vcl_size_t>(b);
+        NumericT     * A   = A_blocks.load(i, &(A_buffer[0]));
+        unsigned int * piv = pivot_blocks.load(i, &(pivot_buffer[0]));
+        unsigned int * inf = info_blocks.load(i, &info_buffer);
+
+        *inf = batched_lu_factorize_kernel<N>(A, piv, n);
+
+        A_blocks.store(i, A);
+        pivot_blocks.store(i, piv);
+        info_blocks.store(i, inf);
+      }
+    }
+  }
+
+  template<vcl_size_t N, typename NumericT>
+  void batched_lu_substitute_impl(vector_base<NumericT> const & matrices, vector_base<unsigned int> const & pivots, vector_base<NumericT> & rhs, vcl_size_t n, vcl_size_t batch_count)
+  {
+    batched_blocks<NumericT const>     A_blocks(matrices, n * n);
+    batched_blocks<unsigned int const> pivot_blocks(pivots, n);
+    batched_blocks<NumericT>           rhs_blocks(rhs, n);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel if (batch_count * n * n > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    {
+      std::vector<NumericT>     A_buffer(n * n);
+      std::vector<unsigned int> pivot_buffer(n);
+      std::vector<NumericT>     rhs_buffer(n);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for
+#endif
+      for (long b = 0; b < static_cast<long>(batch_count); ++b)
+      {
+        vcl_size_t i = static_cast<vcl_size_t>(b);
+        NumericT     * x = rhs_blocks.load(i, &(rhs_buffer[0]));
+
+        batched_lu_substitute_kernel<N>(A_blocks.load(i, &(A_buffer[0])), pivot_blocks.load(i, &(pivot_buffer[0])), x, n);
+
+        rhs_blocks.store(i, x);
+      }
+    }
+  }
+
+  template<vcl_size_t N, typename NumericT>
+  void batched_lu_solve_impl(vector_base<NumericT> & matrices, vector_base<NumericT> & rhs, vcl_size_t n, vcl_size_t batch_count, vector_base<unsigned int> & info)
+  {
+    batched_blocks<NumericT>     A_blocks(matrices, n * n);
+    batched_blocks<NumericT>     rhs_blocks(rhs, n);
+    batched_blocks<unsigned int> info_blocks(info, 1);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel if (batch_count * n * n > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    {
+      std::vector<NumericT>     A_buffer(n * n);
+      std::vector<unsigned int> pivot_buffer(n);
+      std::vector<NumericT>     rhs_buffer(n);
+      unsigned int              info_buffer;
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for
+#endif
+      for (long b = 0; b < static_cast<long>(batch_count); ++b)
+      {
+        vcl_size_t i = static_cast<vcl_size_t>(b);
+        NumericT     * A   = A_blocks.load(i, &(A_buffer[0]));
+        NumericT     * x   = rhs_blocks.load(i, &(rhs_buffer[0]));
+        unsigned int * inf = info_blocks.load(i, &info_buffer);
+
+        *inf = batched_lu_factorize_kernel<N>(A, &(pivot_buffer[0]), n);
+        if (*inf == 0) // singular systems keep their right hand side
+          batched_lu_substitute_kernel<N>(A, &(pivot_buffer[0]), x, n);
+
+        A_blocks.store(i, A);
+        rhs_blocks.store(i, x);
+        info_blocks.store(i, inf);
+      }
+    }
+  }
+
+  template<vcl_size_t N, typename NumericT>
+  void batched_qr_factorize_impl(vector_base<NumericT> & matrices, vector_base<NumericT> & tau, vcl_size_t n, vcl_size_t batch_count, vector_base<unsigned int> & info)
+  {
+    batched_blocks<NumericT>     A_blocks(matrices, n * n);
+    batched_blocks<NumericT>     tau_blocks(tau, n);
+    batched_blocks<unsigned int> info_blocks(info, 1);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel if (batch_count * n * n > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    {
+      std::vector<NumericT> A_buffer(n * n);
+      std::vector<NumericT> tau_buffer(n);
+      std::vector<NumericT> work(n);
+      unsigned int          info_buffer;
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for
+#endif
+      for (long b = 0; b < static_cast<long>(batch_count); ++b)
+      {
+        vcl_size_t i = static_cast<vcl_size_t>(b);
+        NumericT     * A   = A_blocks.load(i, &(A_buffer[0]));
+        NumericT     * t   = tau_blocks.load(i, &(tau_buffer[0]));
+        unsigned int * inf = info_blocks.load(i, &info_buffer);
+
+        *inf = batched_qr_factorize_kernel<N>(A, t, &(work[0]), n);
+
+        A_blocks.store(i, A);
+        tau_blocks.store(i, t);
+        info_blocks.store(i, inf);
+      }
+    }
+  }
+
+  template<vcl_size_t N, typename NumericT>
+  void batched_qr_solve_impl(vector_base<NumericT> const & matrices, vector_base<NumericT> const & tau, vector_base<NumericT> & rhs, vcl_size_t n, vcl_size_t batch_count)
+  {
+    batched_blocks<NumericT const> A_blocks(matrices, n * n);
+    batched_blocks<NumericT const> tau_blocks(tau, n);
+    batched_blocks<NumericT>       rhs_blocks(rhs, n);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel if (batch_count * n * n > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    {
+      std::vector<NumericT> A_buffer(n * n);
+      std::vector<NumericT> tau_buffer(n);
+      std::vector<NumericT> rhs_buffer(n);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for
+#endif
+      for (long b = 0; b < static_cast<long>(batch_count); ++b)
+      {
+        vcl_size_t i = static_cast<vcl_size_t>(b);
+        NumericT * x = rhs_blocks.load(i, &(rhs_buffer[0]));
+
+        batched_qr_solve_kernel<N>(A_blocks.load(i, &(A_buffer[0])), tau_blocks.load(i, &(tau_buffer[0])), x, n);
+
+        rhs_blocks.store(i, x);
+      }
+    }
+  }
+
+} //namespace detail
+
+
+/** @brief Computes the LU factorizations with partial pivoting of 'batch_count' row-major n x n matrices stored one after another in 'matrices'. The pivot indices of each matrix are written to n consecutive entries of 'pivots'.
+*
+* Entry i of 'info' is set to zero if matrix i is nonsingular, and to k+1 if U(k,k) is the first exactly zero diagonal entry of its factor U (as in LAPACK's getrf).
+*/
+template<typename NumericT>
+void batched_lu_factorize(vector_base<NumericT> & matrices, vector_base<unsigned int> & pivots, vcl_size_t n, vcl_size_t batch_count, vector_base<unsigned int> & info)
+{
+  if (n == 0)
+    detail::batched_clear_info(info, batch_count);
+  if (n == 0 || batch_count == 0)
+    return;
+
+  switch (n)
+  {
+  case  2: detail::batched_lu_factorize_impl< 2>(matrices, pivots, n, batch_count, info); break;
+  case  3: detail::batched_lu_factorize_impl< 3>(matrices, pivots, n, batch_count, info); break;
+  case  4: detail::batched_lu_factorize_impl< 4>(matrices, pivots, n, batch_count, info); break;
+  case  6: detail::batched_lu_factorize_impl< 6>(matrices, pivots, n, batch_count, info); break;
+  case  8: detail::batched_lu_factorize_impl< 8>(matrices, pivots, n, batch_count, info); break;
+  case 12: detail::batched_lu_factorize_impl<12>(matrices, pivots, n, batch_count, info); break;
+  case 16: detail::batched_lu_factorize_impl<16>(matrices, pivots, n, batch_count, info); break;
+  case 24: detail::batched_lu_factorize_impl<24>(matrices, pivots, n, batch_count, info); break;
+  case 27: detail::batched_lu_factorize_impl<27>(matrices, pivots, n, batch_count, info); break;
+  case 32: detail::batched_lu_factorize_impl<32>(matrices, pivots, n, batch_count, info); break;
+  case 64: detail::batched_lu_factorize_impl<64>(matrices, pivots, n, batch_count, info); break;
+  default: detail::batched_lu_factorize_impl< 0>(matrices, pivots, n, batch_count, info);
+  }
+}
+
+/** @brief Solves the systems with the LU factorizations computed by batched_lu_factorize(). The right hand sides are stored one after another in 'rhs' and are overwritten with the solutions. */
+template<typename NumericT>
+void batched_lu_substitute(vector_base<NumericT> const & matrices, vector_base<unsigned int> const & pivots, vector_base<NumericT> & rhs, vcl_size_t n, vcl_size_t batch_count)
+{
+  if (n == 0 || batch_count == 0)
+    return;
+
+  switch (n)
+  {
+  case  2: detail::batched_lu_substitute_impl< 2>(matrices, pivots, rhs, n, batch_count); break;
+  case  3: detail::batched_lu_substitute_impl< 3>(matrices, pivots, rhs, n, batch_count); break;
+  case  4: detail::batched_lu_substitute_impl< 4>(matrices, pivots, rhs, n, batch_count); break;
+  case  6: detail::batched_lu_substitute_impl< 6>(matrices, pivots, rhs, n, batch_count); break;
+  case  8: detail::batched_lu_substitute_impl< 8>(matrices, pivots, rhs, n, batch_count); break;
+  case 12: detail::batched_lu_substitute_impl<12>(matrices, pivots, rhs, n, batch_count); break;
+  case 16: detail::batched_lu_substitute_impl<16>(matrices, pivots, rhs, n, batch_count); break;
+  case 24: detail::batched_lu_substitute_impl<24>(matrices, pivots, rhs, n, batch_count); break;
+  case 27: detail::batched_lu_substitute_impl<27>(matrices, pivots, rhs, n, batch_count); break;
+  case 32: detail::batched_lu_substitute_impl<32>(matrices, pivots, rhs, n, batch_count); break;
+  case 64: detail::batched_lu_substitute_impl<64>(matrices, pivots, rhs, n, batch_count); break;
+  default: detail::batched_lu_substitute_impl< 0>(matrices, pivots, rhs, n, batch_count);
+  }
+}
+
+/** @brief Solves the systems A_i x_i = b_i by LU factorization with partial pivoting in a single pass over the batch. The matrices are overwritten with their LU factors, the right hand sides with the solutions.
+*
+* 'info' is set as in batched_lu_factorize(). The right hand sides of singular systems are left unchanged.
+*/
+template<typename NumericT>
+void batched_lu_solve(vector_base<NumericT> & matrices, vector_base<NumericT> & rhs, vcl_size_t n, vcl_size_t batch_count, vector_base<unsigned int> & info)
+{
+  if (n == 0)
+    detail::batched_clear_info(info, batch_count);
+  if (n == 0 || batch_count == 0)
+    return;
+
+  switch (n)
+  {
+  case  2: detail::batched_lu_solve_impl< 2>(matrices, rhs, n, batch_count, info); break;
+  case  3: detail::batched_lu_solve_impl< 3>(matrices, rhs, n, batch_count, info); break;
+  case  4: detail::batched_lu_solve_impl< 4>(matrices, rhs, n, batch_count, info); break;
+  case  6: detail::batched_lu_solve_impl< 6>(matrices, rhs, n, batch_count, info); break;
+  case  8: detail::batched_lu_solve_impl< 8>(matrices, rhs, n, batch_count, info); break;
+  case 12: detail::batched_lu_solve_impl<12>(matrices, rhs, n, batch_count, info); break;
+  case 16: detail::batched_lu_solve_impl<16>(matrices, rhs, n, batch_count, info); break;
+  case 24: detail::batched_lu_solve_impl<24>(matrices, rhs, n, batch_count, info); break;
+  case 27: detail::batched_lu_solve_impl<27>(matrices, rhs, n, batch_count, info); break;
+  case 32: detail::batched_lu_solve_impl<32>(matrices, rhs, n, batch_count, info); break;
+  case 64: detail::batched_lu_solve_impl<64>(matrices, rhs, n, batch_count, info); break;
+  default: detail::batched_lu_solve_impl< 0>(matrices, rhs, n, batch_count, info);
+  }
+}
+
+/** @brief Computes the Householder QR factorizations of 'batch_count' row-major n x n matrices stored one after another in 'matrices'. The scaling factors of the Householder reflections of each matrix are written to n consecutive entries of 'tau'.
+*
+* Entry i of 'info' is set to zero if matrix i is nonsingular, and to k+1 if R(k,k) is the first exactly zero diagonal entry of its factor R.
+*/
+template<typename NumericT>
+void batched_qr_factorize(vector_base<NumericT> & matrices, vector_base<NumericT> & tau, vcl_size_t n, vcl_size_t batch_count, vector_base<unsigned int> & info)
+{
+  if (n == 0)
+    detail::batched_clear_info(info, batch_count);
+  if (n == 0 || batch_count == 0)
+    return;
+
+  switch (n)
+  {
+  case  2: detail::batched_qr_factorize_impl< 2>(matrices, tau, n, batch_count, info); break;
+  case  3: detail::batched_qr_factorize_impl< 3>(matrices, tau, n, batch_count, info); break;
+  case  4: detail::batched_qr_factorize_impl< 4>(matrices, tau, n, batch_count, info); break;
+  case  6: detail::batched_qr_factorize_impl< 6>(matrices, tau, n, batch_count, info); break;
+  case  8: detail::batched_qr_factorize_impl< 8>(matrices, tau, n, batch_count, info); break;
+  case 12: detail::batched_qr_factorize_impl<12>(matrices, tau, n, batch_count, info); break;
+  case 16: detail::batched_qr_factorize_impl<16>(matrices, tau, n, batch_count, info); break;
+  case 24: detail::batched_qr_factorize_impl<24>(matrices, tau, n, batch_count, info); break;
+  case 27: detail::batched_qr_factorize_impl<27>(matrices, tau, n, batch_count, info); break;
+  case 32: detail::batched_qr_factorize_impl<32>(matrices, tau, n, batch_count, info); break;
+  case 64: detail::batched_qr_factorize_impl<64>(matrices, tau, n, batch_count, info); break;
+  default: detail::batched_qr_factorize_impl< 0>(matrices, tau, n, batch_count, info);
+  }
+}
+
+/** @brief Solves the systems with the QR factorizations computed by batched_qr_factorize(). The right hand sides are stored one after another in 'rhs' and are overwritten with the solutions. */
+template<typename NumericT>
+void batched_qr_solve(vector_base<NumericT> const & matrices, vector_base<NumericT> const & tau, vector_base<NumericT> & rhs, vcl_size_t n, vcl_size_t batch_count)
+{
+  if (n == 0 || batch_count == 0)
+    return;
+
+  switch (n)
+  {
+  case  2: detail::batched_qr_solve_impl< 2>(matrices, tau, rhs, n, batch_count); break;
+  case  3: detail::batched_qr_solve_impl< 3>(matrices, tau, rhs, n, batch_count); break;
+  case  4: detail::batched_qr_solve_impl< 4>(matrices, tau, rhs, n, batch_count); break;
+  case  6: detail::batched_qr_solve_impl< 6>(matrices, tau, rhs, n, batch_count); break;
+  case  8: detail::batched_qr_solve_impl< 8>(matrices, tau, rhs, n, batch_count); break;
+  case 12: detail::batched_qr_solve_impl<12>(matrices, tau, rhs, n, batch_count); break;
+  case 16: detail::batched_qr_solve_impl<16>(matrices, tau, rhs, n, batch_count); break;
+  case 24: detail::batched_qr_solve_impl<24>(matrices, tau, rhs, n, batch_count); break;
+  case 27: detail::batched_qr_solve_impl<27>(matrices, tau, rhs, n, batch_count); break;
+  case 32: detail::batched_qr_solve_impl<32>(matrices, tau, rhs, n, batch_count); break;
+  case 64: detail::batched_qr_solve_impl<64>(matrices, tau, rhs, n, batch_count); break;
+  default: detail::batched_qr_solve_impl< 0>(matrices, tau, rhs, n, batch_count);
+  }
+}
+
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
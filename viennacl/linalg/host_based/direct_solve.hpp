@@ -26,6 +26,11 @@
 #include "viennacl/matrix.hpp"
 
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/matrix_operations.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
 
 namespace viennacl
 {
@@ -36,34 +41,142 @@ namespace host_based
 
 namespace detail
 {
+  /** @brief Accessor for the submatrix of a matrix accessor starting at entry (offset1, offset2). Used for passing blocks of the triangular solvers to the matrix-matrix product. */
+  template<typename MatrixAccT>
+  class matrix_offset_wrapper
+  {
+  public:
+    typedef typename MatrixAccT::value_type   value_type;
+
+    matrix_offset_wrapper(MatrixAccT & A, vcl_size_t offset1, vcl_size_t offset2) : A_(A), offset1_(offset1), offset2_(offset2) {}
+
+    value_type & operator()(vcl_size_t i, vcl_size_t j) { return A_(i + offset1_, j + offset2_); }
+
+  private:
+    MatrixAccT & A_;
+    vcl_size_t offset1_;
+    vcl_size_t offset2_;
+  };
+
+  /** @brief Size of the diagonal blocks below which the triangular solvers do not recurse further, but run the substitution directly */
+  static const vcl_size_t trsm_block_size = 32;
+
+  /** @brief Trait indicating whether the entries of a column of the matrix accessor are consecutive in memory. Selects the loop order of the substitution. */
+  template<typename MatrixT>
+  struct trsm_column_access { static const bool value = false; };
+
+  /** \cond */
+  template<typename NumericT>
+  struct trsm_column_access< matrix_array_wrapper<NumericT, viennacl::column_major, false> > { static const bool value = true; };
+
+  template<typename NumericT>
+  struct trsm_column_access< matrix_array_wrapper<NumericT, viennacl::row_major, true> > { static const bool value = true; };
+  /** \endcond */
+
   //
   // Upper solve:
   //
+
+  /** @brief Solves A(k:k+size, k:k+size) X = B(k:k+size, col_begin:col_end) for an upper triangular A by substitution */
   template<typename MatrixT1, typename MatrixT2>
-  void upper_inplace_solve_matrix(MatrixT1 & A, MatrixT2 & B, vcl_size_t A_size, vcl_size_t B_size, bool unit_diagonal)
+  void upper_inplace_solve_matrix_block(MatrixT1 & A, MatrixT2 & B, vcl_size_t k, vcl_size_t size, vcl_size_t col_begin, vcl_size_t col_end, bool unit_diagonal)
   {
     typedef typename MatrixT2::value_type   value_type;
 
-    for (vcl_size_t i = 0; i < A_size; ++i)
+    if (trsm_column_access<MatrixT2>::value) // one right hand side at a time
     {
-      vcl_size_t current_row = A_size - i - 1;
+      for (vcl_size_t l = col_begin; l < col_end; ++l)
+        for (vcl_size_t i = 0; i < size; ++i)
+        {
+          vcl_size_t current_row = k + size - i - 1;
+          value_type value = B(current_row, l);
+          for (vcl_size_t j = current_row + 1; j < k + size; ++j)
+            value -= A(current_row, j) * B(j, l);
+          B(current_row, l) = unit_diagonal ? value : value / A(current_row, current_row);
+        }
+      return;
+    }
 
-      for (vcl_size_t j = current_row + 1; j < A_size; ++j)
+    for (vcl_size_t i = 0; i < size; ++i)
+    {
+      vcl_size_t current_row = k + size - i - 1;
+
+      for (vcl_size_t j = current_row + 1; j < k + size; ++j)
       {
         value_type A_element = A(current_row, j);
-        for (vcl_size_t k=0; k < B_size; ++k)
-          B(current_row, k) -= A_element * B(j, k);
+        for (vcl_size_t l = col_begin; l < col_end; ++l)
+          B(current_row, l) -= A_element * B(j, l);
       }
 
       if (!unit_diagonal)
       {
         value_type A_diag = A(current_row, current_row);
-        for (vcl_size_t k=0; k < B_size; ++k)
-          B(current_row, k) /= A_diag;
+        for (vcl_size_t l = col_begin; l < col_end; ++l)
+          B(current_row, l) /= A_diag;
       }
     }
   }
 
+  /** @brief Recursively blocked solve of A(k:k+size, k:k+size) X = B(k:k+size, col_begin:col_end) for an upper triangular A.
+  *
+  * The system is split into two halves. After solving for the lower half, the upper half of B is updated by a matrix-matrix product.
+  */
+  template<typename MatrixT1, typename MatrixT2>
+  void upper_inplace_solve_matrix_recursive(MatrixT1 & A, MatrixT2 & B, vcl_size_t k, vcl_size_t size, vcl_size_t col_begin, vcl_size_t col_end, bool unit_diagonal)
+  {
+    typedef typename MatrixT2::value_type   value_type;
+
+    if (size <= trsm_block_size)
+    {
+      upper_inplace_solve_matrix_block(A, B, k, size, col_begin, col_end, unit_diagonal);
+      return;
+    }
+
+    vcl_size_t size_top = (size / 2 + trsm_block_size - 1) / trsm_block_size * trsm_block_size;
+
+    upper_inplace_solve_matrix_recursive(A, B, k + size_top, size - size_top, col_begin, col_end, unit_diagonal);
+
+    // B_top -= A_12 * B_bottom
+    matrix_offset_wrapper<MatrixT1> A_12(A, k, k + size_top);
+    matrix_offset_wrapper<MatrixT2> B_bottom(B, k + size_top, col_begin);
+    matrix_offset_wrapper<MatrixT2> B_top(B, k, col_begin);
+    prod(A_12, B_bottom, B_top, size_top, col_end - col_begin, size - size_top, value_type(-1), value_type(1));
+
+    upper_inplace_solve_matrix_recursive(A, B, k, size_top, col_begin, col_end, unit_diagonal);
+  }
+
+  /** @brief Returns the number of column blocks of the right hand sides, which are solved for in parallel */
+  inline vcl_size_t trsm_num_column_blocks(vcl_size_t A_size, vcl_size_t B_size)
+  {
+    vcl_size_t num_blocks = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    if (A_size * A_size * B_size > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      num_blocks = std::min(static_cast<vcl_size_t>(omp_get_max_threads()), (B_size - 1) / trsm_block_size + 1);
+#endif
+    (void)A_size;
+    return std::max<vcl_size_t>(num_blocks, 1);
+  }
+
+  template<typename MatrixT1, typename MatrixT2>
+  void upper_inplace_solve_matrix(MatrixT1 & A, MatrixT2 & B, vcl_size_t A_size, vcl_size_t B_size, bool unit_diagonal)
+  {
+    if (A_size == 0 || B_size == 0)
+      return;
+
+    // the right hand sides are independent, hence column blocks of B are distributed over the threads:
+    vcl_size_t num_blocks = trsm_num_column_blocks(A_size, B_size);
+    vcl_size_t block_size = (B_size - 1) / num_blocks + 1;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (num_blocks > 1)
+#endif
+    for (long block = 0; block < static_cast<long>(num_blocks); ++block)
+    {
+      vcl_size_t col_begin = std::min(static_cast<vcl_size_t>(block) * block_size, B_size);
+      upper_inplace_solve_matrix_recursive(A, B, 0, A_size, col_begin, std::min(col_begin + block_size, B_size), unit_diagonal);
+    }
+  }
+
   template<typename MatrixT1, typename MatrixT2>
   void inplace_solve_matrix(MatrixT1 & A, MatrixT2 & B, vcl_size_t A_size, vcl_size_t B_size, viennacl::linalg::unit_upper_tag)
   {
@@ -79,29 +192,92 @@ namespace detail
   //
   // Lower solve:
   //
+
+  /** @brief Solves A(k:k+size, k:k+size) X = B(k:k+size, col_begin:col_end) for a lower triangular A by substitution */
   template<typename MatrixT1, typename MatrixT2>
-  void lower_inplace_solve_matrix(MatrixT1 & A, MatrixT2 & B, vcl_size_t A_size, vcl_size_t B_size, bool unit_diagonal)
+  void lower_inplace_solve_matrix_block(MatrixT1 & A, MatrixT2 & B, vcl_size_t k, vcl_size_t size, vcl_size_t col_begin, vcl_size_t col_end, bool unit_diagonal)
   {
     typedef typename MatrixT2::value_type   value_type;
 
-    for (vcl_size_t i = 0; i < A_size; ++i)
+    if (trsm_column_access<MatrixT2>::value) // one right hand side at a time
     {
-      for (vcl_size_t j = 0; j < i; ++j)
+      for (vcl_size_t l = col_begin; l < col_end; ++l)
+        for (vcl_size_t i = k; i < k + size; ++i)
+        {
+          value_type value = B(i, l);
+          for (vcl_size_t j = k; j < i; ++j)
+            value -= A(i, j) * B(j, l);
+          B(i, l) = unit_diagonal ? value : value / A(i, i);
+        }
+      return;
+    }
+
+    for (vcl_size_t i = k; i < k + size; ++i)
+    {
+      for (vcl_size_t j = k; j < i; ++j)
       {
         value_type A_element = A(i, j);
-        for (vcl_size_t k=0; k < B_size; ++k)
-          B(i, k) -= A_element * B(j, k);
+        for (vcl_size_t l = col_begin; l < col_end; ++l)
+          B(i, l) -= A_element * B(j, l);
       }
 
       if (!unit_diagonal)
       {
         value_type A_diag = A(i, i);
-        for (vcl_size_t k=0; k < B_size; ++k)
-          B(i, k) /= A_diag;
+        for (vcl_size_t l = col_begin; l < col_end; ++l)
+          B(i, l) /= A_diag;
       }
     }
   }
 
+  /** @brief Recursively blocked solve of A(k:k+size, k:k+size) X = B(k:k+size, col_begin:col_end) for a lower triangular A.
+  *
+  * The system is split into two halves. After solving for the upper half, the lower half of B is updated by a matrix-matrix product.
+  */
+  template<typename MatrixT1, typename MatrixT2>
+  void lower_inplace_solve_matrix_recursive(MatrixT1 & A, MatrixT2 & B, vcl_size_t k, vcl_size_t size, vcl_size_t col_begin, vcl_size_t col_end, bool unit_diagonal)
+  {
+    typedef typename MatrixT2::value_type   value_type;
+
+    if (size <= trsm_block_size)
+    {
+      lower_inplace_solve_matrix_block(A, B, k, size, col_begin, col_end, unit_diagonal);
+      return;
+    }
+
+    vcl_size_t size_top = (size / 2 + trsm_block_size - 1) / trsm_block_size * trsm_block_size;
+
+    lower_inplace_solve_matrix_recursive(A, B, k, size_top, col_begin, col_end, unit_diagonal);
+
+    // B_bottom -= A_21 * B_top
+    matrix_offset_wrapper<MatrixT1> A_21(A, k + size_top, k);
+    matrix_offset_wrapper<MatrixT2> B_top(B, k, col_begin);
+    matrix_offset_wrapper<MatrixT2> B_bottom(B, k + size_top, col_begin);
+    prod(A_21, B_top, B_bottom, size - size_top, col_end - col_begin, size_top, value_type(-1), value_type(1));
+
+    lower_inplace_solve_matrix_recursive(A, B, k + size_top, size - size_top, col_begin, col_end, unit_diagonal);
+  }
+
+  template<typename MatrixT1, typename MatrixT2>
+  void lower_inplace_solve_matrix(MatrixT1 & A, MatrixT2 & B, vcl_size_t A_size, vcl_size_t B_size, bool unit_diagonal)
+  {
+    if (A_size == 0 || B_size == 0)
+      return;
+
+    // the right hand sides are independent, hence column blocks of B are distributed over the threads:
+    vcl_size_t num_blocks = trsm_num_column_blocks(A_size, B_size);
+    vcl_size_t block_size = (B_size - 1) / num_blocks + 1;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (num_blocks > 1)
+#endif
+    for (long block = 0; block < static_cast<long>(num_blocks); ++block)
+    {
+      vcl_size_t col_begin = std::min(static_cast<vcl_size_t>(block) * block_size, B_size);
+      lower_inplace_solve_matrix_recursive(A, B, 0, A_size, col_begin, std::min(col_begin + block_size, B_size), unit_diagonal);
+    }
+  }
+
   template<typename MatrixT1, typename MatrixT2>
   void inplace_solve_matrix(MatrixT1 & A, MatrixT2 & B, vcl_size_t A_size, vcl_size_t B_size, viennacl::linalg::unit_lower_tag)
   {
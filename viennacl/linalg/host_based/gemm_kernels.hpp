@@ -0,0 +1,410 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_GEMM_KERNELS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_GEMM_KERNELS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/gemm_kernels.hpp
+*   @brief Blocking parameters, packing routines and register-blocked micro-kernels for the packed matrix-matrix product on the CPU.
+*
+*   The SIMD micro-kernels are selected at compile time from the instruction set the code is compiled for (e.g. -mavx2 -mfma, -mavx512f, or SSE2 on x86-64).
+*   Other architectures and numeric types fall back to a generic kernel written such that compilers can vectorize it.
+*/
+
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+
+#if defined(__AVX512F__) || defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+
+/** @brief Register and cache blocking parameters of the packed matrix-matrix product.
+  *
+  * The micro-kernel keeps an MR x NR block of C in registers while streaming through a KC x NR panel of B (held in L1).
+  * A MC x KC block of A is kept in L2, the packed KC x NC panel of B is shared by all threads and should fit into L3.
+  * MC must be a multiple of MR.
+  */
+template<typename NumericT>
+struct gemm_blocking
+{
+  static const vcl_size_t MR = 4;
+  static const vcl_size_t NR = 8;
+  static const vcl_size_t MC = 128;
+  static const vcl_size_t KC = 256;
+  static const vcl_size_t NC = 2048;
+};
+
+/** \cond */
+#if defined(__AVX512F__)
+
+template<>
+struct gemm_blocking<double>
+{
+  static const vcl_size_t MR = 8;
+  static const vcl_size_t NR = 16;
+  static const vcl_size_t MC = 128;
+  static const vcl_size_t KC = 256;
+  static const vcl_size_t NC = 2048;
+};
+
+template<>
+struct gemm_blocking<float>
+{
+  static const vcl_size_t MR = 8;
+  static const vcl_size_t NR = 32;
+  static const vcl_size_t MC = 128;
+  static const vcl_size_t KC = 384;
+  static const vcl_size_t NC = 4096;
+};
+
+#elif defined(__AVX__)
+
+template<>
+struct gemm_blocking<double>
+{
+  static const vcl_size_t MR = 6;
+  static const vcl_size_t NR = 8;
+  static const vcl_size_t MC = 96;
+  static const vcl_size_t KC = 256;
+  static const vcl_size_t NC = 2048;
+};
+
+template<>
+struct gemm_blocking<float>
+{
+  static const vcl_size_t MR = 6;
+  static const vcl_size_t NR = 16;
+  static const vcl_size_t MC = 96;
+  static const vcl_size_t KC = 384;
+  static const vcl_size_t NC = 4096;
+};
+
+#elif defined(__SSE2__)
+
+template<>
+struct gemm_blocking<double>
+{
+  static const vcl_size_t MR = 4;
+  static const vcl_size_t NR = 4;
+  static const vcl_size_t MC = 128;
+  static const vcl_size_t KC = 256;
+  static const vcl_size_t NC = 2048;
+};
+
+template<>
+struct gemm_blocking<float>
+{
+  static const vcl_size_t MR = 4;
+  static const vcl_size_t NR = 8;
+  static const vcl_size_t MC = 128;
+  static const vcl_size_t KC = 384;
+  static const vcl_size_t NC = 4096;
+};
+
+#endif
+/** \endcond */
+
+
+/** @brief Packs the block A(row_start:row_start+mc, col_start:col_start+kc) into consecutive micro-panels of MR rows each (column by column). Rows beyond mc are padded with zeros. */
+template<vcl_size_t MR, typename MatrixAccT, typename NumericT>
+void gemm_pack_A(MatrixAccT & A, vcl_size_t row_start, vcl_size_t col_start, vcl_size_t mc, vcl_size_t kc, NumericT * buffer)
+{
+  for (vcl_size_t ir = 0; ir < mc; ir += MR)
+  {
+    vcl_size_t mr = std::min(MR, mc - ir);
+    for (vcl_size_t p = 0; p < kc; ++p)
+    {
+      for (vcl_size_t i = 0; i < mr; ++i)
+        buffer[i] = A(row_start + ir + i, col_start + p);
+      for (vcl_size_t i = mr; i < MR; ++i)
+        buffer[i] = 0;
+      buffer += MR;
+    }
+  }
+}
+
+/** @brief Packs the block B(row_start:row_start+kc, col_start:col_start+nr) into a single micro-panel of NR columns (row by row). Columns beyond nr are padded with zeros. */
+template<vcl_size_t NR, typename MatrixAccT, typename NumericT>
+void gemm_pack_B(MatrixAccT & B, vcl_size_t row_start, vcl_size_t col_start, vcl_size_t kc, vcl_size_t nr, NumericT * buffer)
+{
+  for (vcl_size_t p = 0; p < kc; ++p)
+  {
+    for (vcl_size_t j = 0; j < nr; ++j)
+      buffer[j] = B(row_start + p, col_start + j);
+    for (vcl_size_t j = nr; j < NR; ++j)
+      buffer[j] = 0;
+    buffer += NR;
+  }
+}
+
+
+/** @brief Computes the MR x NR block C_block = A_panel * B_panel from packed micro-panels. C_block is stored row-major.
+  *
+  * Generic implementation: All loop bounds except kc are compile-time constants and all memory accesses are contiguous, so compilers keep the accumulators in registers.
+  */
+template<vcl_size_t MR, vcl_size_t NR, typename NumericT>
+struct gemm_micro_kernel
+{
+  static void apply(vcl_size_t kc, NumericT const * A_panel, NumericT const * B_panel, NumericT * C_block)
+  {
+    NumericT C_reg[MR * NR];
+    for (vcl_size_t i = 0; i < MR * NR; ++i)
+      C_reg[i] = 0;
+
+    for (vcl_size_t p = 0; p < kc; ++p)
+    {
+      for (vcl_size_t i = 0; i < MR; ++i)
+      {
+        NumericT val_A = A_panel[i];
+        for (vcl_size_t j = 0; j < NR; ++j)
+          C_reg[i * NR + j] += val_A * B_panel[j];
+      }
+      A_panel += MR;
+      B_panel += NR;
+    }
+
+    for (vcl_size_t i = 0; i < MR * NR; ++i)
+      C_block[i] = C_reg[i];
+  }
+};
+
+/** \cond */
+#if defined(__AVX512F__)
+
+template<>
+struct gemm_micro_kernel<8, 16, double>
+{
+  static void apply(vcl_size_t kc, double const * A_panel, double const * B_panel, double * C_block)
+  {
+    __m512d C_reg[8][2];
+    for (int i = 0; i < 8; ++i)
+      C_reg[i][0] = C_reg[i][1] = _mm512_setzero_pd();
+
+    for (vcl_size_t p = 0; p < kc; ++p)
+    {
+      __m512d B0 = _mm512_loadu_pd(B_panel);
+      __m512d B1 = _mm512_loadu_pd(B_panel + 8);
+      for (int i = 0; i < 8; ++i)
+      {
+        __m512d val_A = _mm512_set1_pd(A_panel[i]);
+        C_reg[i][0] = _mm512_fmadd_pd(val_A, B0, C_reg[i][0]);
+        C_reg[i][1] = _mm512_fmadd_pd(val_A, B1, C_reg[i][1]);
+      }
+      A_panel += 8;
+      B_panel += 16;
+    }
+
+    for (int i = 0; i < 8; ++i)
+    {
+      _mm512_storeu_pd(C_block + 16 * i,     C_reg[i][0]);
+      _mm512_storeu_pd(C_block + 16 * i + 8, C_reg[i][1]);
+    }
+  }
+};
+
+template<>
+struct gemm_micro_kernel<8, 32, float>
+{
+  static void apply(vcl_size_t kc, float const * A_panel, float const * B_panel, float * C_block)
+  {
+    __m512 C_reg[8][2];
+    for (int i = 0; i < 8; ++i)
+      C_reg[i][0] = C_reg[i][1] = _mm512_setzero_ps();
+
+    for (vcl_size_t p = 0; p < kc; ++p)
+    {
+      __m512 B0 = _mm512_loadu_ps(B_panel);
+      __m512 B1 = _mm512_loadu_ps(B_panel + 16);
+      for (int i = 0; i < 8; ++i)
+      {
+        __m512 val_A = _mm512_set1_ps(A_panel[i]);
+        C_reg[i][0] = _mm512_fmadd_ps(val_A, B0, C_reg[i][0]);
+        C_reg[i][1] = _mm512_fmadd_ps(val_A, B1, C_reg[i][1]);
+      }
+      A_panel += 8;
+      B_panel += 32;
+    }
+
+    for (int i = 0; i < 8; ++i)
+    {
+      _mm512_storeu_ps(C_block + 32 * i,      C_reg[i][0]);
+      _mm512_storeu_ps(C_block + 32 * i + 16, C_reg[i][1]);
+    }
+  }
+};
+
+#elif defined(__AVX__)
+
+#if defined(__FMA__)
+  #define VIENNACL_GEMM_AVX_MADD_PD(a, b, c)  _mm256_fmadd_pd(a, b, c)
+  #define VIENNACL_GEMM_AVX_MADD_PS(a, b, c)  _mm256_fmadd_ps(a, b, c)
+#else
+  #define VIENNACL_GEMM_AVX_MADD_PD(a, b, c)  _mm256_add_pd(_mm256_mul_pd(a, b), c)
+  #define VIENNACL_GEMM_AVX_MADD_PS(a, b, c)  _mm256_add_ps(_mm256_mul_ps(a, b), c)
+#endif
+
+template<>
+struct gemm_micro_kernel<6, 8, double>
+{
+  static void apply(vcl_size_t kc, double const * A_panel, double const * B_panel, double * C_block)
+  {
+    __m256d C_reg[6][2];
+    for (int i = 0; i < 6; ++i)
+      C_reg[i][0] = C_reg[i][1] = _mm256_setzero_pd();
+
+    for (vcl_size_t p = 0; p < kc; ++p)
+    {
+      __m256d B0 = _mm256_loadu_pd(B_panel);
+      __m256d B1 = _mm256_loadu_pd(B_panel + 4);
+      for (int i = 0; i < 6; ++i)
+      {
+        __m256d val_A = _mm256_broadcast_sd(A_panel + i);
+        C_reg[i][0] = VIENNACL_GEMM_AVX_MADD_PD(val_A, B0, C_reg[i][0]);
+        C_reg[i][1] = VIENNACL_GEMM_AVX_MADD_PD(val_A, B1, C_reg[i][1]);
+      }
+      A_panel += 6;
+      B_panel += 8;
+    }
+
+    for (int i = 0; i < 6; ++i)
+    {
+      _mm256_storeu_pd(C_block + 8 * i,     C_reg[i][0]);
+      _mm256_storeu_pd(C_block + 8 * i + 4, C_reg[i][1]);
+    }
+  }
+};
+
+template<>
+struct gemm_micro_kernel<6, 16, float>
+{
+  static void apply(vcl_size_t kc, float const * A_panel, float const * B_panel, float * C_block)
+  {
+    __m256 C_reg[6][2];
+    for (int i = 0; i < 6; ++i)
+      C_reg[i][0] = C_reg[i][1] = _mm256_setzero_ps();
+
+    for (vcl_size_t p = 0; p < kc; ++p)
+    {
+      __m256 B0 = _mm256_loadu_ps(B_panel);
+      __m256 B1 = _mm256_loadu_ps(B_panel + 8);
+      for (int i = 0; i < 6; ++i)
+      {
+        __m256 val_A = _mm256_broadcast_ss(A_panel + i);
+        C_reg[i][0] = VIENNACL_GEMM_AVX_MADD_PS(val_A, B0, C_reg[i][0]);
+        C_reg[i][1] = VIENNACL_GEMM_AVX_MADD_PS(val_A, B1, C_reg[i][1]);
+      }
+      A_panel += 6;
+      B_panel += 16;
+    }
+
+    for (int i = 0; i < 6; ++i)
+    {
+      _mm256_storeu_ps(C_block + 16 * i,     C_reg[i][0]);
+      _mm256_storeu_ps(C_block + 16 * i + 8, C_reg[i][1]);
+    }
+  }
+};
+
+#undef VIENNACL_GEMM_AVX_MADD_PD
+#undef VIENNACL_GEMM_AVX_MADD_PS
+
+#elif defined(__SSE2__)
+
+template<>
+struct gemm_micro_kernel<4, 4, double>
+{
+  static void apply(vcl_size_t kc, double const * A_panel, double const * B_panel, double * C_block)
+  {
+    __m128d C_reg[4][2];
+    for (int i = 0; i < 4; ++i)
+      C_reg[i][0] = C_reg[i][1] = _mm_setzero_pd();
+
+    for (vcl_size_t p = 0; p < kc; ++p)
+    {
+      __m128d B0 = _mm_loadu_pd(B_panel);
+      __m128d B1 = _mm_loadu_pd(B_panel + 2);
+      for (int i = 0; i < 4; ++i)
+      {
+        __m128d val_A = _mm_set1_pd(A_panel[i]);
+        C_reg[i][0] = _mm_add_pd(_mm_mul_pd(val_A, B0), C_reg[i][0]);
+        C_reg[i][1] = _mm_add_pd(_mm_mul_pd(val_A, B1), C_reg[i][1]);
+      }
+      A_panel += 4;
+      B_panel += 4;
+    }
+
+    for (int i = 0; i < 4; ++i)
+    {
+      _mm_storeu_pd(C_block + 4 * i,     C_reg[i][0]);
+      _mm_storeu_pd(C_block + 4 * i + 2, C_reg[i][1]);
+    }
+  }
+};
+
+template<>
+struct gemm_micro_kernel<4, 8, float>
+{
+  static void apply(vcl_size_t kc, float const * A_panel, float const * B_panel, float * C_block)
+  {
+    __m128 C_reg[4][2];
+    for (int i = 0; i < 4; ++i)
+      C_reg[i][0] = C_reg[i][1] = _mm_setzero_ps();
+
+    for (vcl_size_t p = 0; p < kc; ++p)
+    {
+      __m128 B0 = _mm_loadu_ps(B_panel);
+      __m128 B1 = _mm_loadu_ps(B_panel + 4);
+      for (int i = 0; i < 4; ++i)
+      {
+        __m128 val_A = _mm_set1_ps(A_panel[i]);
+        C_reg[i][0] = _mm_add_ps(_mm_mul_ps(val_A, B0), C_reg[i][0]);
+        C_reg[i][1] = _mm_add_ps(_mm_mul_ps(val_A, B1), C_reg[i][1]);
+      }
+      A_panel += 4;
+      B_panel += 8;
+    }
+
+    for (int i = 0; i < 4; ++i)
+    {
+      _mm_storeu_ps(C_block + 8 * i,     C_reg[i][0]);
+      _mm_storeu_ps(C_block + 8 * i + 4, C_reg[i][1]);
+    }
+  }
+};
+
+#endif
+/** \endcond */
+
+} //namespace detail
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
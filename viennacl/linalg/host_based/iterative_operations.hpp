@@ -23,6 +23,7 @@
 */
 
 #include <cmath>
+#include <vector>
 #include <algorithm>  //for std::max and std::min
 
 #include "viennacl/forwards.h"
@@ -33,6 +34,7 @@
 #include "viennacl/traits/size.hpp"
 #include "viennacl/traits/start.hpp"
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/sparse_matrix_operations.hpp"
 #include "viennacl/linalg/detail/op_applier.hpp"
 #include "viennacl/traits/stride.hpp"
 
@@ -78,20 +80,97 @@ namespace detail
     value_type inner_prod_ApAp = 0;
     value_type inner_prod_pAp = 0;
     value_type inner_prod_Ap_r0star = 0;
-    for (long row = 0; row < static_cast<long>(A.size1()); ++row)
+
+    if (A.blocks1() > 1
+        && detail::csr_row_blocks_valid(row_buffer, A.size1(), detail::extract_raw_pointer<unsigned int>(A.handle3()), A.blocks1()))
     {
-      value_type dot_prod = 0;
-      value_type val_p_diag = p_buf[static_cast<vcl_size_t>(row)]; //likely to be loaded from cache if required again in this row
+      // nnz-balanced partition, see prod_impl() for compressed_matrix.
+      // Rows split across blocks only contribute to the inner products after the fix-up with the carries.
+      unsigned int const * row_blocks = detail::extract_raw_pointer<unsigned int>(A.handle3());
+      vcl_size_t num_blocks = A.blocks1();
+      std::vector<value_type> block_results(4 * num_blocks); // carry, (Ap,Ap), (p,Ap), (Ap,r0star) per block
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for
+#endif
+      for (long block = 0; block < static_cast<long>(num_blocks); ++block)
+      {
+        vcl_size_t row       = row_blocks[2 * block];
+        vcl_size_t i         = row_blocks[2 * block + 1];
+        vcl_size_t row_stop  = row_blocks[2 * block + 2];
+        vcl_size_t nnz_stop  = row_blocks[2 * block + 3];
+        vcl_size_t split_row = (i > row_buffer[row]) ? row : A.size1();
+
+        value_type block_ApAp = 0;
+        value_type block_pAp = 0;
+        value_type block_Ap_r0star = 0;
+        for (; row < row_stop; ++row)
+        {
+          value_type dot_prod = 0;
+          vcl_size_t row_end = row_buffer[row+1];
+          for (; i < row_end; ++i)
+            dot_prod += elements[i] * p_buf[col_buffer[i]];
+
+          Ap_buf[row] = dot_prod;
+          if (row != split_row)
+          {
+            block_ApAp += dot_prod * dot_prod;
+            block_pAp  += p_buf[row] * dot_prod;
+            block_Ap_r0star += r0star ? dot_prod * r0star[row] : value_type(0);
+          }
+        }
 
-      vcl_size_t row_end = row_buffer[row+1];
-      for (vcl_size_t i = row_buffer[row]; i < row_end; ++i)
-        dot_prod += elements[i] * p_buf[col_buffer[i]];
+        value_type carry = 0;
+        for (; i < nnz_stop; ++i)
+          carry += elements[i] * p_buf[col_buffer[i]];
+
+        block_results[4 * static_cast<vcl_size_t>(block)    ] = carry;
+        block_results[4 * static_cast<vcl_size_t>(block) + 1] = block_ApAp;
+        block_results[4 * static_cast<vcl_size_t>(block) + 2] = block_pAp;
+        block_results[4 * static_cast<vcl_size_t>(block) + 3] = block_Ap_r0star;
+      }
+
+      for (vcl_size_t block = 0; block < num_blocks; ++block)
+      {
+        vcl_size_t carry_row = row_blocks[2 * block + 2];
+        if (carry_row < A.size1())
+          Ap_buf[carry_row] += block_results[4 * block];
+
+        inner_prod_ApAp      += block_results[4 * block + 1];
+        inner_prod_pAp       += block_results[4 * block + 2];
+        inner_prod_Ap_r0star += block_results[4 * block + 3];
+      }
 
-      // update contributions for the inner products (Ap, Ap) and (p, Ap)
-      Ap_buf[static_cast<vcl_size_t>(row)] = dot_prod;
-      inner_prod_ApAp += dot_prod * dot_prod;
-      inner_prod_pAp  += val_p_diag * dot_prod;
-      inner_prod_Ap_r0star += r0star ? dot_prod * r0star[static_cast<vcl_size_t>(row)] : value_type(0);
+      // contributions of the split rows, now that their entries in Ap are complete:
+      for (vcl_size_t block = 0; block < num_blocks; ++block)
+      {
+        vcl_size_t row = row_blocks[2 * block];
+        if (row < row_blocks[2 * block + 2] && row_blocks[2 * block + 1] > row_buffer[row])
+        {
+          value_type value_Ap = Ap_buf[row];
+          inner_prod_ApAp += value_Ap * value_Ap;
+          inner_prod_pAp  += p_buf[row] * value_Ap;
+          inner_prod_Ap_r0star += r0star ? value_Ap * r0star[row] : value_type(0);
+        }
+      }
+    }
+    else
+    {
+      for (long row = 0; row < static_cast<long>(A.size1()); ++row)
+      {
+        value_type dot_prod = 0;
+        value_type val_p_diag = p_buf[static_cast<vcl_size_t>(row)]; //likely to be loaded from cache if required again in this row
+
+        vcl_size_t row_end = row_buffer[row+1];
+        for (vcl_size_t i = row_buffer[row]; i < row_end; ++i)
+          dot_prod += elements[i] * p_buf[col_buffer[i]];
+
+        // update contributions for the inner products (Ap, Ap) and (p, Ap)
+        Ap_buf[static_cast<vcl_size_t>(row)] = dot_prod;
+        inner_prod_ApAp += dot_prod * dot_prod;
+        inner_prod_pAp  += val_p_diag * dot_prod;
+        inner_prod_Ap_r0star += r0star ? dot_prod * r0star[static_cast<vcl_size_t>(row)] : value_type(0);
+      }
     }
 
     data_buffer[    buffer_chunk_size] = inner_prod_ApAp;
@@ -121,24 +200,20 @@ namespace detail
 
     value_type         * Ap_buf       = detail::extract_raw_pointer<value_type>(Ap.handle());
     value_type   const *  p_buf       = detail::extract_raw_pointer<value_type>(p.handle());
-    value_type   const * elements     = detail::extract_raw_pointer<value_type>(A.handle());
-    unsigned int const * coord_buffer = detail::extract_raw_pointer<unsigned int>(A.handle12());
     value_type         * data_buffer  = detail::extract_raw_pointer<value_type>(inner_prod_buffer);
 
-    // flush result buffer (cannot be expected to be zero)
-    for (vcl_size_t i = 0; i< Ap.size(); ++i)
-      Ap_buf[i] = 0;
-
-    // matrix-vector product with a general COO format
-    for (vcl_size_t i = 0; i < A.nnz(); ++i)
-      Ap_buf[coord_buffer[2*i]] += elements[i] * p_buf[coord_buffer[2*i+1]];
+    // matrix-vector product with a general COO format (segmented reduction over nonzero chunks)
+    viennacl::linalg::host_based::prod_impl(A, p, Ap);
 
     // computing the inner products (Ap, Ap) and (p, Ap):
     // Note: The COO format does not allow to inject the subsequent operations into the matrix-vector product, because row and column ordering assumptions are too weak
     value_type inner_prod_ApAp = 0;
     value_type inner_prod_pAp = 0;
     value_type inner_prod_Ap_r0star = 0;
-    for (vcl_size_t i = 0; i<Ap.size(); ++i)
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for reduction(+: inner_prod_ApAp, inner_prod_pAp, inner_prod_Ap_r0star) if (Ap.size() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    for (long i = 0; i < static_cast<long>(Ap.size()); ++i)
     {
       NumericT value_Ap = Ap_buf[i];
       NumericT value_p  =  p_buf[i];
@@ -231,42 +306,39 @@ namespace detail
     IndexT     const * columns_per_block = detail::extract_raw_pointer<IndexT>(A.handle1());
     IndexT     const * column_indices    = detail::extract_raw_pointer<IndexT>(A.handle2());
     IndexT     const * block_start       = detail::extract_raw_pointer<IndexT>(A.handle3());
+    IndexT     const * row_indices       = detail::extract_raw_pointer<IndexT>(A.handle4());
     value_type         * data_buffer     = detail::extract_raw_pointer<value_type>(inner_prod_buffer);
 
-    vcl_size_t num_blocks = A.size1() / A.rows_per_block() + 1;
-    std::vector<value_type> result_values(A.rows_per_block());
+    vcl_size_t rows_per_block = A.rows_per_block();
+    vcl_size_t num_blocks     = A.size1() / rows_per_block + 1;
 
     value_type inner_prod_ApAp = 0;
     value_type inner_prod_pAp = 0;
     value_type inner_prod_Ap_r0star = 0;
-    for (vcl_size_t block_idx = 0; block_idx < num_blocks; ++block_idx)
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel reduction(+: inner_prod_ApAp, inner_prod_pAp, inner_prod_Ap_r0star) if (A.size1() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
     {
-      vcl_size_t current_columns_per_block = columns_per_block[block_idx];
-
-      for (vcl_size_t i=0; i<result_values.size(); ++i)
-        result_values[i] = 0;
+      std::vector<value_type> result_values(rows_per_block);
 
-      for (IndexT column_entry_index = 0;
-                  column_entry_index < current_columns_per_block;
-                ++column_entry_index)
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for
+#endif
+      for (long block_idx = 0; block_idx < static_cast<long>(num_blocks); ++block_idx)
       {
-        vcl_size_t stride_start = block_start[block_idx] + column_entry_index * A.rows_per_block();
-        // Note: This for-loop may be unrolled by hand for exploiting vectorization
-        //       Careful benchmarking recommended first, memory channels may be saturated already!
-        for (IndexT row_in_block = 0; row_in_block < A.rows_per_block(); ++row_in_block)
-        {
-          value_type val = elements[stride_start + row_in_block];
+        vcl_size_t current_columns_per_block = columns_per_block[block_idx];
+        vcl_size_t offset = current_columns_per_block > 0 ? block_start[block_idx] : 0;
 
-          result_values[row_in_block] += val ? p_buf[column_indices[stride_start + row_in_block]] * val : 0;
-        }
-      }
+        sliced_ell_slice_kernel<value_type, IndexT>::apply(elements + offset, column_indices + offset,
+                                                           current_columns_per_block, rows_per_block,
+                                                           p_buf, 1, p.size(),
+                                                           &(result_values[0]));
 
-      vcl_size_t first_row_in_matrix = block_idx * A.rows_per_block();
-      for (IndexT row_in_block = 0; row_in_block < A.rows_per_block(); ++row_in_block)
-      {
-        vcl_size_t row = first_row_in_matrix + row_in_block;
-        if (row < Ap.size())
+        vcl_size_t first_row_in_block = static_cast<vcl_size_t>(block_idx) * rows_per_block;
+        vcl_size_t rows_in_block      = std::min(rows_per_block, Ap.size() - std::min(first_row_in_block, Ap.size()));
+        for (vcl_size_t row_in_block = 0; row_in_block < rows_in_block; ++row_in_block)
         {
+          vcl_size_t row = row_indices[first_row_in_block + row_in_block];
           value_type row_result = result_values[row_in_block];
 
           Ap_buf[row] = row_result;
@@ -384,6 +456,9 @@ void pipelined_cg_vector_update(vector_base<NumericT> & result,
   vcl_size_t size  = viennacl::traits::size(result);
 
   value_type inner_prod_r = 0;
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for reduction(+:inner_prod_r) if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
   for (long i = 0; i < static_cast<long>(size); ++i)
   {
     value_type value_p = data_p[static_cast<vcl_size_t>(i)];
@@ -697,6 +772,541 @@ void pipelined_bicgstab_update_s(vector_base<NumericT> & s,
    viennacl::linalg::host_based::detail::pipelined_prod_impl(A, p, Ap, data_r0star, inner_prod_buffer, buffer_chunk_size, buffer_chunk_offset);
  }
 
+
+//
+// Pipelined GMRES
+//
+
+namespace detail
+{
+  /** @brief Returns the number of row chunks used for the fused reductions of the pipelined GMRES algorithm (one partial result per chunk and inner product) */
+  inline vcl_size_t pipelined_gmres_num_chunks(vcl_size_t size)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+      return std::max<vcl_size_t>(1, std::min<vcl_size_t>(static_cast<vcl_size_t>(omp_get_max_threads()), size));
+#endif
+    (void)size;
+    return 1;
+  }
+}
+
+/** @brief Performs a fused matrix-vector product with a compressed_matrix for an efficient pipelined GMRES algorithm.
+  *
+  * With v_i denoting the i-th vector stored in 'krylov_basis' (starting at i * buffer_size_per_vector), this routine computes
+  *   v_{k+1} = scale_k * prod(A, v_k);
+  * together with the inner products (v_i, v_{k+1}) for i = 0, ..., k as well as (v_{k+1}, v_{k+1}) in a single pass over memory.
+  * The inner products are written to inner_prods[0], ..., inner_prods[k+1].
+  */
+template<typename NumericT>
+void pipelined_gmres_prod(compressed_matrix<NumericT> const & A,
+                          vector_base<NumericT> & krylov_basis,
+                          vcl_size_t buffer_size_per_vector,
+                          vcl_size_t k,
+                          NumericT scale_k,
+                          std::vector<NumericT> & inner_prods)
+{
+  typedef NumericT        value_type;
+
+  value_type         * data_basis = detail::extract_raw_pointer<value_type>(krylov_basis) + viennacl::traits::start(krylov_basis);
+  value_type   const * elements   = detail::extract_raw_pointer<value_type>(A.handle());
+  unsigned int const * row_buffer = detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * col_buffer = detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  value_type const * v_k      = data_basis + k * buffer_size_per_vector;
+  value_type       * v_kplus1 = data_basis + (k+1) * buffer_size_per_vector;
+
+  vcl_size_t size       = A.size1();
+  vcl_size_t num_dots   = k + 2;
+  vcl_size_t num_chunks = detail::pipelined_gmres_num_chunks(size);
+  vcl_size_t chunk_size = (size + num_chunks - 1) / num_chunks;
+  std::vector<value_type> chunk_results(num_chunks * num_dots);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (num_chunks > 1)
+#endif
+  for (long chunk = 0; chunk < static_cast<long>(num_chunks); ++chunk)
+  {
+    vcl_size_t row_start = static_cast<vcl_size_t>(chunk) * chunk_size;
+    vcl_size_t row_stop  = std::min(size, row_start + chunk_size);
+    value_type * chunk_dots = &(chunk_results[static_cast<vcl_size_t>(chunk) * num_dots]);
+
+    for (vcl_size_t row = row_start; row < row_stop; ++row)
+    {
+      value_type dot_prod = 0;
+      vcl_size_t row_end = row_buffer[row+1];
+      for (vcl_size_t i = row_buffer[row]; i < row_end; ++i)
+        dot_prod += elements[i] * v_k[col_buffer[i]];
+      dot_prod *= scale_k;
+
+      v_kplus1[row] = dot_prod;
+      for (vcl_size_t j = 0; j <= k; ++j)
+        chunk_dots[j] += data_basis[j * buffer_size_per_vector + row] * dot_prod;
+      chunk_dots[k+1] += dot_prod * dot_prod;
+    }
+  }
+
+  inner_prods.resize(std::max(inner_prods.size(), num_dots));
+  for (vcl_size_t j = 0; j < num_dots; ++j)
+  {
+    value_type sum = 0;
+    for (vcl_size_t chunk = 0; chunk < num_chunks; ++chunk)
+      sum += chunk_results[chunk * num_dots + j];
+    inner_prods[j] = sum;
+  }
+}
+
+/** @brief Performs the classical Gram-Schmidt orthogonalization step of an efficient pipelined GMRES algorithm.
+  *
+  * With v_i denoting the i-th vector stored in 'krylov_basis', this routine computes
+  *   v_{k+1} -= sum_{i=0}^{k} coeffs[i] * v_i;
+  * and in the same pass the inner products (v_i, v_{k+1}) for i = 0, ..., k of the updated vector (required for a reorthogonalization)
+  * as well as (v_{k+1}, v_{k+1}). The inner products are written to inner_prods[0], ..., inner_prods[k+1].
+  */
+template<typename NumericT>
+void pipelined_gmres_gram_schmidt(vector_base<NumericT> & krylov_basis,
+                                  vcl_size_t buffer_size_per_vector,
+                                  vcl_size_t k,
+                                  std::vector<NumericT> const & coeffs,
+                                  std::vector<NumericT> & inner_prods)
+{
+  typedef NumericT        value_type;
+
+  value_type * data_basis = detail::extract_raw_pointer<value_type>(krylov_basis) + viennacl::traits::start(krylov_basis);
+  value_type * v_kplus1   = data_basis + (k+1) * buffer_size_per_vector;
+
+  vcl_size_t size       = buffer_size_per_vector;
+  vcl_size_t num_dots   = k + 2;
+  vcl_size_t num_chunks = detail::pipelined_gmres_num_chunks(size);
+  vcl_size_t chunk_size = (size + num_chunks - 1) / num_chunks;
+  std::vector<value_type> chunk_results(num_chunks * num_dots);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (num_chunks > 1)
+#endif
+  for (long chunk = 0; chunk < static_cast<long>(num_chunks); ++chunk)
+  {
+    vcl_size_t row_start = static_cast<vcl_size_t>(chunk) * chunk_size;
+    vcl_size_t row_stop  = std::min(size, row_start + chunk_size);
+    value_type * chunk_dots = &(chunk_results[static_cast<vcl_size_t>(chunk) * num_dots]);
+
+    for (vcl_size_t row = row_start; row < row_stop; ++row)
+    {
+      value_type value_v = v_kplus1[row];
+      for (vcl_size_t j = 0; j <= k; ++j)
+        value_v -= coeffs[j] * data_basis[j * buffer_size_per_vector + row];
+
+      v_kplus1[row] = value_v;
+      for (vcl_size_t j = 0; j <= k; ++j)
+        chunk_dots[j] += data_basis[j * buffer_size_per_vector + row] * value_v;
+      chunk_dots[k+1] += value_v * value_v;
+    }
+  }
+
+  inner_prods.resize(std::max(inner_prods.size(), num_dots));
+  for (vcl_size_t j = 0; j < num_dots; ++j)
+  {
+    value_type sum = 0;
+    for (vcl_size_t chunk = 0; chunk < num_chunks; ++chunk)
+      sum += chunk_results[chunk * num_dots + j];
+    inner_prods[j] = sum;
+  }
+}
+
+/** @brief Performs the update of the result vector at the end of a restart cycle of the pipelined GMRES algorithm.
+  *
+  * With v_i denoting the i-th vector stored in 'krylov_basis', this routine computes
+  *   result += sum_{i=0}^{k-1} coeffs[i] * v_i;
+  * in a single pass over memory.
+  */
+template<typename NumericT>
+void pipelined_gmres_update_result(vector_base<NumericT> & result,
+                                   vector_base<NumericT> const & krylov_basis,
+                                   vcl_size_t buffer_size_per_vector,
+                                   vcl_size_t k,
+                                   std::vector<NumericT> const & coeffs)
+{
+  typedef NumericT        value_type;
+
+  value_type       * data_result = detail::extract_raw_pointer<value_type>(result);
+  value_type const * data_basis  = detail::extract_raw_pointer<value_type>(krylov_basis) + viennacl::traits::start(krylov_basis);
+
+  vcl_size_t start_result = viennacl::traits::start(result);
+  vcl_size_t inc_result   = viennacl::traits::stride(result);
+  vcl_size_t size         = viennacl::traits::size(result);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long row = 0; row < static_cast<long>(size); ++row)
+  {
+    value_type value_update = 0;
+    for (vcl_size_t j = 0; j < k; ++j)
+      value_update += coeffs[j] * data_basis[j * buffer_size_per_vector + static_cast<vcl_size_t>(row)];
+    data_result[static_cast<vcl_size_t>(row) * inc_result + start_result] += value_update;
+  }
+}
+
+
+//
+// Fused multi-vector kernels for IDR(s) and BiCGStab(l)
+//
+
+namespace detail
+{
+  /** @brief Returns the number of row chunks used for the fused reductions of the multi-vector kernels (one partial result per chunk and inner product)
+    *
+    * The chunks have a fixed maximum length, so the partial sums and thus the results do not depend on the number of threads.
+    */
+  inline vcl_size_t multi_vector_num_chunks(vcl_size_t size)
+  {
+    vcl_size_t max_chunk_size = VIENNACL_OPENMP_VECTOR_MIN_SIZE;
+    return std::max<vcl_size_t>(1, (size + max_chunk_size - 1) / max_chunk_size);
+  }
+
+  /** @brief Collects the raw pointers (already shifted by the start index) and strides of the vectors in a vector_tuple */
+  template<typename NumericT>
+  void multi_vector_pointers(vector_tuple<NumericT> const & vecs,
+                             std::vector<NumericT *> & data,
+                             std::vector<vcl_size_t> & inc)
+  {
+    data.resize(vecs.const_size());
+    inc.resize(vecs.const_size());
+    for (vcl_size_t j = 0; j < vecs.const_size(); ++j)
+    {
+      data[j] = const_cast<NumericT *>(detail::extract_raw_pointer<NumericT>(vecs.const_at(j))) + viennacl::traits::start(vecs.const_at(j));
+      inc[j]  = viennacl::traits::stride(vecs.const_at(j));
+    }
+  }
+
+  /** @brief Sums up the partial results of all chunks of a fused reduction */
+  template<typename NumericT>
+  void multi_vector_sum_chunks(std::vector<NumericT> const & chunk_results, vcl_size_t num_chunks, vcl_size_t num_dots, std::vector<NumericT> & inner_prods)
+  {
+    inner_prods.resize(std::max(inner_prods.size(), num_dots));
+    for (vcl_size_t j = 0; j < num_dots; ++j)
+    {
+      NumericT sum = 0;
+      for (vcl_size_t chunk = 0; chunk < num_chunks; ++chunk)
+        sum += chunk_results[chunk * num_dots + j];
+      inner_prods[j] = sum;
+    }
+  }
+}
+
+/** @brief Computes the inner products of a vector with several other vectors in a single pass over memory.
+  *
+  * With v_i denoting the i-th vector in 'vecs', this routine computes
+  *   inner_prods[i] = (v_i, y)  for i = 0, ..., vecs.const_size() - 1,
+  *   inner_prods[vecs.const_size()] = (y, y).
+  */
+template<typename NumericT>
+void pipelined_multi_inner_prod(vector_tuple<NumericT> const & vecs,
+                                vector_base<NumericT> const & y,
+                                std::vector<NumericT> & inner_prods)
+{
+  typedef NumericT        value_type;
+
+  std::vector<value_type *> data_v;
+  std::vector<vcl_size_t>   inc_v;
+  detail::multi_vector_pointers(vecs, data_v, inc_v);
+
+  value_type const * data_y = detail::extract_raw_pointer<value_type>(y) + viennacl::traits::start(y);
+  vcl_size_t inc_y = viennacl::traits::stride(y);
+
+  vcl_size_t size       = viennacl::traits::size(y);
+  vcl_size_t num_vecs   = data_v.size();
+  vcl_size_t num_dots   = num_vecs + 1;
+  vcl_size_t num_chunks = detail::multi_vector_num_chunks(size);
+  vcl_size_t chunk_size = (size + num_chunks - 1) / num_chunks;
+  std::vector<value_type> chunk_results(num_chunks * num_dots);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (num_chunks > 1)
+#endif
+  for (long chunk = 0; chunk < static_cast<long>(num_chunks); ++chunk)
+  {
+    vcl_size_t row_start = static_cast<vcl_size_t>(chunk) * chunk_size;
+    vcl_size_t row_stop  = std::min(size, row_start + chunk_size);
+    value_type * chunk_dots = &(chunk_results[static_cast<vcl_size_t>(chunk) * num_dots]);
+
+    for (vcl_size_t row = row_start; row < row_stop; ++row)
+    {
+      value_type value_y = data_y[row * inc_y];
+      for (vcl_size_t j = 0; j < num_vecs; ++j)
+        chunk_dots[j] += data_v[j][row * inc_v[j]] * value_y;
+      chunk_dots[num_vecs] += value_y * value_y;
+    }
+  }
+
+  detail::multi_vector_sum_chunks(chunk_results, num_chunks, num_dots, inner_prods);
+}
+
+/** @brief Subtracts a linear combination of several vectors from a vector and computes the norm of the result in a single pass over memory.
+  *
+  * With v_i denoting the i-th vector in 'vecs', this routine computes
+  *   y -= sum_i coeffs[i] * v_i;
+  * and returns (y, y) of the updated vector.
+  */
+template<typename NumericT>
+NumericT pipelined_multi_update(vector_base<NumericT> & y,
+                                vector_tuple<NumericT> const & vecs,
+                                std::vector<NumericT> const & coeffs)
+{
+  typedef NumericT        value_type;
+
+  std::vector<value_type *> data_v;
+  std::vector<vcl_size_t>   inc_v;
+  detail::multi_vector_pointers(vecs, data_v, inc_v);
+
+  value_type * data_y = detail::extract_raw_pointer<value_type>(y) + viennacl::traits::start(y);
+  vcl_size_t inc_y = viennacl::traits::stride(y);
+
+  vcl_size_t size       = viennacl::traits::size(y);
+  vcl_size_t num_vecs   = data_v.size();
+  vcl_size_t num_chunks = detail::multi_vector_num_chunks(size);
+  vcl_size_t chunk_size = (size + num_chunks - 1) / num_chunks;
+  std::vector<value_type> chunk_results(num_chunks);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (num_chunks > 1)
+#endif
+  for (long chunk = 0; chunk < static_cast<long>(num_chunks); ++chunk)
+  {
+    vcl_size_t row_start = static_cast<vcl_size_t>(chunk) * chunk_size;
+    vcl_size_t row_stop  = std::min(size, row_start + chunk_size);
+    value_type chunk_y_dot_y = 0;
+
+    for (vcl_size_t row = row_start; row < row_stop; ++row)
+    {
+      value_type value_y = data_y[row * inc_y];
+      for (vcl_size_t j = 0; j < num_vecs; ++j)
+        value_y -= coeffs[j] * data_v[j][row * inc_v[j]];
+      data_y[row * inc_y] = value_y;
+      chunk_y_dot_y += value_y * value_y;
+    }
+    chunk_results[static_cast<vcl_size_t>(chunk)] = chunk_y_dot_y;
+  }
+
+  std::vector<value_type> y_dot_y;
+  detail::multi_vector_sum_chunks(chunk_results, num_chunks, 1, y_dot_y);
+  return y_dot_y[0];
+}
+
+/** @brief Updates several pairs of vectors in a single pass over memory.
+  *
+  * With y_i and x_i denoting the i-th vectors in 'y_vecs' and 'x_vecs', this routine computes
+  *   y_i = alpha * x_i + beta * y_i;
+  * for all i.
+  */
+template<typename NumericT>
+void pipelined_multi_axpby(vector_tuple<NumericT> const & y_vecs,
+                           NumericT alpha,
+                           vector_tuple<NumericT> const & x_vecs,
+                           NumericT beta)
+{
+  typedef NumericT        value_type;
+
+  std::vector<value_type *> data_y, data_x;
+  std::vector<vcl_size_t>   inc_y,  inc_x;
+  detail::multi_vector_pointers(y_vecs, data_y, inc_y);
+  detail::multi_vector_pointers(x_vecs, data_x, inc_x);
+
+  vcl_size_t num_vecs = std::min(data_x.size(), data_y.size());
+  if (num_vecs == 0)
+    return;
+  vcl_size_t size = viennacl::traits::size(y_vecs.const_at(0));
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long row = 0; row < static_cast<long>(size); ++row)
+  {
+    vcl_size_t i = static_cast<vcl_size_t>(row);
+    for (vcl_size_t j = 0; j < num_vecs; ++j)
+      data_y[j][i * inc_y[j]] = alpha * data_x[j][i * inc_x[j]] + beta * data_y[j][i * inc_y[j]];
+  }
+}
+
+/** @brief Computes the Gram matrix of several vectors in a single pass over memory.
+  *
+  * With v_i denoting the i-th of the m vectors in 'vecs', this routine computes gram[i * m + j] = (v_i, v_j).
+  */
+template<typename NumericT>
+void pipelined_gram_matrix(vector_tuple<NumericT> const & vecs,
+                           std::vector<NumericT> & gram)
+{
+  typedef NumericT        value_type;
+
+  std::vector<value_type *> data_v;
+  std::vector<vcl_size_t>   inc_v;
+  detail::multi_vector_pointers(vecs, data_v, inc_v);
+
+  vcl_size_t num_vecs = data_v.size();
+  if (num_vecs == 0)
+    return;
+
+  vcl_size_t size       = viennacl::traits::size(vecs.const_at(0));
+  vcl_size_t num_dots   = (num_vecs * (num_vecs + 1)) / 2;
+  vcl_size_t num_chunks = detail::multi_vector_num_chunks(size);
+  vcl_size_t chunk_size = (size + num_chunks - 1) / num_chunks;
+  std::vector<value_type> chunk_results(num_chunks * num_dots);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (num_chunks > 1)
+#endif
+  for (long chunk = 0; chunk < static_cast<long>(num_chunks); ++chunk)
+  {
+    vcl_size_t row_start = static_cast<vcl_size_t>(chunk) * chunk_size;
+    vcl_size_t row_stop  = std::min(size, row_start + chunk_size);
+    value_type * chunk_dots = &(chunk_results[static_cast<vcl_size_t>(chunk) * num_dots]);
+
+    for (vcl_size_t row = row_start; row < row_stop; ++row)
+    {
+      vcl_size_t index = 0;
+      for (vcl_size_t i = 0; i < num_vecs; ++i)
+      {
+        value_type value_i = data_v[i][row * inc_v[i]];
+        for (vcl_size_t j = 0; j <= i; ++j)
+          chunk_dots[index++] += value_i * data_v[j][row * inc_v[j]];
+      }
+    }
+  }
+
+  std::vector<value_type> packed_gram;
+  detail::multi_vector_sum_chunks(chunk_results, num_chunks, num_dots, packed_gram);
+
+  gram.resize(num_vecs * num_vecs);
+  vcl_size_t index = 0;
+  for (vcl_size_t i = 0; i < num_vecs; ++i)
+    for (vcl_size_t j = 0; j <= i; ++j, ++index)
+    {
+      gram[i * num_vecs + j] = packed_gram[index];
+      gram[j * num_vecs + i] = packed_gram[index];
+    }
+}
+
+
+//
+// Chebyshev and Neumann polynomials
+//
+
+/** @brief Performs one fused step of a Chebyshev (or Neumann) polynomial iteration with diagonal scaling for a compressed_matrix.
+  *
+  * This routine computes in a single pass over memory:
+  *   x += d_in;
+  *   r -= prod(A, d_in);
+  *   d_out = alpha * d_in + beta * element_prod(inv_diag, r);
+  * No inner products are computed, so the routine does not require any global synchronization.
+  */
+template<typename NumericT>
+void chebyshev_prod(compressed_matrix<NumericT> const & A,
+                    vector_base<NumericT> const & d_in,
+                    vector_base<NumericT> & d_out,
+                    vector_base<NumericT> & r,
+                    vector_base<NumericT> & x,
+                    vector_base<NumericT> const & inv_diag,
+                    NumericT alpha,
+                    NumericT beta)
+{
+  typedef NumericT        value_type;
+
+  value_type const * data_d_in     = detail::extract_raw_pointer<value_type>(d_in)     + viennacl::traits::start(d_in);
+  value_type       * data_d_out    = detail::extract_raw_pointer<value_type>(d_out)    + viennacl::traits::start(d_out);
+  value_type       * data_r        = detail::extract_raw_pointer<value_type>(r)        + viennacl::traits::start(r);
+  value_type       * data_x        = detail::extract_raw_pointer<value_type>(x)        + viennacl::traits::start(x);
+  value_type const * data_inv_diag = detail::extract_raw_pointer<value_type>(inv_diag) + viennacl::traits::start(inv_diag);
+
+  vcl_size_t inc_d_in     = viennacl::traits::stride(d_in);
+  vcl_size_t inc_d_out    = viennacl::traits::stride(d_out);
+  vcl_size_t inc_r        = viennacl::traits::stride(r);
+  vcl_size_t inc_x        = viennacl::traits::stride(x);
+  vcl_size_t inc_inv_diag = viennacl::traits::stride(inv_diag);
+
+  value_type   const * elements   = detail::extract_raw_pointer<value_type>(A.handle());
+  unsigned int const * row_buffer = detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * col_buffer = detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  vcl_size_t size = A.size1();
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long row = 0; row < static_cast<long>(size); ++row)
+  {
+    vcl_size_t i = static_cast<vcl_size_t>(row);
+
+    value_type dot_prod = 0;
+    vcl_size_t row_end = row_buffer[i+1];
+    for (vcl_size_t j = row_buffer[i]; j < row_end; ++j)
+      dot_prod += elements[j] * data_d_in[col_buffer[j] * inc_d_in];
+
+    value_type value_d = data_d_in[i * inc_d_in];
+    value_type value_r = data_r[i * inc_r] - dot_prod;
+
+    data_x[i * inc_x]         += value_d;
+    data_r[i * inc_r]          = value_r;
+    data_d_out[i * inc_d_out]  = alpha * value_d + beta * data_inv_diag[i * inc_inv_diag] * value_r;
+  }
+}
+
+
+//
+// Mixed precision
+//
+
+/** @brief Assigns a vector to a vector of different precision, i.e. vec1 = vec2. Used by the mixed precision CG solver.
+  *
+  * @param vec1   The result vector, e.g. in single precision
+  * @param vec2   The source vector, e.g. in double precision
+  */
+template<typename NumericT1, typename NumericT2>
+void mixed_precision_assign(vector_base<NumericT1> & vec1,
+                            vector_base<NumericT2> const & vec2)
+{
+  NumericT1       * data_vec1 = detail::extract_raw_pointer<NumericT1>(vec1);
+  NumericT2 const * data_vec2 = detail::extract_raw_pointer<NumericT2>(vec2);
+
+  vcl_size_t start1 = viennacl::traits::start(vec1);
+  vcl_size_t inc1   = viennacl::traits::stride(vec1);
+  vcl_size_t size1  = viennacl::traits::size(vec1);
+
+  vcl_size_t start2 = viennacl::traits::start(vec2);
+  vcl_size_t inc2   = viennacl::traits::stride(vec2);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long i = 0; i < static_cast<long>(size1); ++i)
+    data_vec1[static_cast<vcl_size_t>(i)*inc1+start1] = static_cast<NumericT1>(data_vec2[static_cast<vcl_size_t>(i)*inc2+start2]);
+}
+
+/** @brief Adds a vector of different precision to a vector, i.e. vec1 += vec2. Used for the correction step of the mixed precision CG solver.
+  *
+  * @param vec1   The updated vector, e.g. in double precision
+  * @param vec2   The correction, e.g. in single precision
+  */
+template<typename NumericT1, typename NumericT2>
+void mixed_precision_inplace_add(vector_base<NumericT1> & vec1,
+                                 vector_base<NumericT2> const & vec2)
+{
+  NumericT1       * data_vec1 = detail::extract_raw_pointer<NumericT1>(vec1);
+  NumericT2 const * data_vec2 = detail::extract_raw_pointer<NumericT2>(vec2);
+
+  vcl_size_t start1 = viennacl::traits::start(vec1);
+  vcl_size_t inc1   = viennacl::traits::stride(vec1);
+  vcl_size_t size1  = viennacl::traits::size(vec1);
+
+  vcl_size_t start2 = viennacl::traits::start(vec2);
+  vcl_size_t inc2   = viennacl::traits::stride(vec2);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long i = 0; i < static_cast<long>(size1); ++i)
+    data_vec1[static_cast<vcl_size_t>(i)*inc1+start1] += static_cast<NumericT1>(data_vec2[static_cast<vcl_size_t>(i)*inc2+start2]);
+}
+
 } //namespace host_based
 } //namespace linalg
 } //namespace viennacl
@@ -22,6 +22,9 @@
     @brief Implementations of dense matrix related operations, including matrix-vector products, using a plain single-threaded or OpenMP-enabled execution on CPU.
 */
 
+#include <vector>
+#include <algorithm>  //for std::min
+
 #include "viennacl/forwards.h"
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
@@ -36,6 +39,17 @@
 #include "viennacl/traits/stride.hpp"
 #include "viennacl/linalg/detail/op_applier.hpp"
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/gemm_kernels.hpp"
+#include "viennacl/linalg/host_based/transpose_kernels.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+// Minimum number of multiply-add operations (M*N*K) for using OpenMP on matrix-matrix products:
+#ifndef VIENNACL_OPENMP_MATRIX_MIN_SIZE
+  #define VIENNACL_OPENMP_MATRIX_MIN_SIZE  5000
+#endif
 
 namespace viennacl
 {
@@ -48,51 +62,196 @@ namespace host_based
 // Introductory note: By convention, all dimensions are already checked in the dispatcher frontend. No need to double-check again in here!
 //
 
-template<typename NumericT,
-         typename SizeT, typename DistanceT>
-void trans(const matrix_expression<const matrix_base<NumericT, SizeT, DistanceT>,
-           const matrix_base<NumericT, SizeT, DistanceT>, op_trans> & proxy, matrix_base<NumericT> & temp_trans)
+namespace detail
 {
-  const NumericT * temp_proxy = detail::extract_raw_pointer<NumericT>(proxy.lhs());
-  NumericT * temp = detail::extract_raw_pointer<NumericT>(temp_trans);
+  /** @brief Computes dst(j, i) = src(i, j) for a rows x cols matrix src, where src(i, j) = src[i * src_inc1 + j * src_inc2] and dst(j, i) = dst[j * dst_inc1 + i * dst_inc2].
+  *
+  * The matrix is processed in tiles, such that source and destination of each tile stay in cache and only a few pages are touched at a time.
+  * If rows are contiguous in source and destination, tiles are transposed by SIMD micro-kernels.
+  */
+  template<typename NumericT>
+  void transpose_strided(NumericT const * src, vcl_size_t src_inc1, vcl_size_t src_inc2,
+                         NumericT       * dst, vcl_size_t dst_inc1, vcl_size_t dst_inc2,
+                         vcl_size_t rows, vcl_size_t cols)
+  {
+    // dst(j, i) = src(i, j) is symmetric in (i, j), hence swap roles such that the source has contiguous rows if possible:
+    if (src_inc1 == 1 && src_inc2 != 1)
+    {
+      std::swap(src_inc1, src_inc2);
+      std::swap(dst_inc1, dst_inc2);
+      std::swap(rows, cols);
+    }
+
+    if (rows == 0 || cols == 0)
+      return;
 
-  unsigned int proxy_int_size1=proxy.lhs().internal_size1();
-  unsigned int proxy_int_size2=proxy.lhs().internal_size2();
-  unsigned int temp_int_size1=temp_trans.internal_size1();
-  unsigned int temp_int_size2=temp_trans.internal_size2();
+    const vcl_size_t tile_size = transpose_tile_size;
+    vcl_size_t num_tile_rows = (rows - 1) / tile_size + 1;
 
+    if (src_inc2 == 1 && dst_inc1 == 1) // rows of the source are columns of the destination in memory, i.e. plain copy
+    {
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for shared(proxy_int_size1,proxy_int_size2,temp_int_size1,temp_int_size2)
+      #pragma omp parallel for if (rows * cols > 16384)
 #endif
-  for (unsigned int i = 0; i < proxy_int_size1*proxy_int_size2;++i)
-  {
-    unsigned int row = i / proxy_int_size2;
-    unsigned int col = i % proxy_int_size2;
+      for (long i2 = 0; i2 < static_cast<long>(rows); ++i2)
+      {
+        vcl_size_t i = static_cast<vcl_size_t>(i2);
+        std::copy(src + i * src_inc1, src + i * src_inc1 + cols, dst + i * dst_inc2);
+      }
+      return;
+    }
 
-    if (row < proxy.lhs().size1() && col < proxy.lhs().size2())
+    if (src_inc2 != 1 || dst_inc2 != 1) // no contiguous rows, hence no SIMD either. Tiles are processed entry by entry.
     {
-      if (proxy.lhs().row_major())
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (rows * cols > 16384)
+#endif
+      for (long tile_row = 0; tile_row < static_cast<long>(num_tile_rows); ++tile_row)
       {
-        unsigned int pos = row_major::mem_index(proxy.lhs().start1() + proxy.lhs().stride1() * row,
-                                                proxy.lhs().start2() + proxy.lhs().stride2() * col,
-                                                proxy_int_size1, proxy_int_size2);
-        unsigned int new_pos = row_major::mem_index(temp_trans.start2() + temp_trans.stride2() * col,
-                                                temp_trans.start1() + temp_trans.stride1() * row, temp_int_size1,
-                                                temp_int_size2);
-        temp[new_pos] = temp_proxy[pos];
+        vcl_size_t i_begin = static_cast<vcl_size_t>(tile_row) * tile_size;
+        vcl_size_t i_end   = std::min(i_begin + tile_size, rows);
+
+        for (vcl_size_t j_begin = 0; j_begin < cols; j_begin += tile_size)
+        {
+          vcl_size_t j_end = std::min(j_begin + tile_size, cols);
+          for (vcl_size_t i = i_begin; i < i_end; ++i)
+            for (vcl_size_t j = j_begin; j < j_end; ++j)
+              dst[j * dst_inc1 + i * dst_inc2] = src[i * src_inc1 + j * src_inc2];
+        }
       }
-      else
+      return;
+    }
+
+    // Scattered writes to lines not in cache are expensive. Thus, blocks are transposed into a buffer first, from which full rows of the destination are written.
+    const vcl_size_t block_size = transpose_block_size;
+    vcl_size_t num_block_rows = (rows - 1) / block_size + 1;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel if (rows * cols > 16384)
+#endif
+    {
+      std::vector<NumericT> buffer(block_size * block_size);  // thread-local
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for
+#endif
+      for (long block_row = 0; block_row < static_cast<long>(num_block_rows); ++block_row)
       {
-        unsigned int pos = column_major::mem_index(proxy.lhs().start1() + proxy.lhs().stride1() * row,
-                                                   proxy.lhs().start2() + proxy.lhs().stride2() * col, proxy_int_size1,
-                                                   proxy_int_size2);
-        unsigned int new_pos = column_major::mem_index(temp_trans.start2() + temp_trans.stride2() * col,
-                                                   temp_trans.start1() + temp_trans.stride1() * row, temp_int_size1,
-                                                   temp_int_size2);
-        temp[new_pos] = temp_proxy[pos];
+        vcl_size_t i_begin = static_cast<vcl_size_t>(block_row) * block_size;
+        vcl_size_t i_size  = std::min(block_size, rows - i_begin);
+
+        for (vcl_size_t j_begin = 0; j_begin < cols; j_begin += block_size)
+        {
+          vcl_size_t j_size = std::min(block_size, cols - j_begin);
+
+          transpose_tile(src + i_begin * src_inc1 + j_begin, src_inc1, &(buffer[0]), block_size, i_size, j_size);
+          for (vcl_size_t j = 0; j < j_size; ++j)
+            std::copy(&(buffer[j * block_size]), &(buffer[j * block_size]) + i_size, dst + (j_begin + j) * dst_inc1 + i_begin);
+        }
       }
     }
   }
+
+  /** @brief Transposes the square size x size matrix A(i, j) = data[i * inc1 + j * inc2] in place.
+  *
+  * Pairs of tiles A_IJ and A_JI are exchanged via a tile-sized buffer, hence only O(tile_size^2) additional memory per thread is required.
+  */
+  template<typename NumericT>
+  void inplace_transpose_strided(NumericT * data, vcl_size_t inc1, vcl_size_t inc2, vcl_size_t size)
+  {
+    // transposition is symmetric in the layout, hence the rows can be assumed to be contiguous if any direction is:
+    if (inc1 == 1)
+      std::swap(inc1, inc2);
+
+    if (size == 0)
+      return;
+
+    const vcl_size_t tile_size = transpose_tile_size;
+    vcl_size_t num_tiles = (size - 1) / tile_size + 1;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel if (size * size > 16384)
+#endif
+    {
+      std::vector<NumericT> buffer(tile_size * tile_size);  // thread-local
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for schedule(dynamic)
+#endif
+      for (long tile_row = 0; tile_row < static_cast<long>(num_tiles); ++tile_row)
+      {
+        vcl_size_t I = static_cast<vcl_size_t>(tile_row) * tile_size;
+        vcl_size_t rows_I = std::min(tile_size, size - I);
+
+        for (vcl_size_t J = I; J < size; J += tile_size)
+        {
+          vcl_size_t rows_J = std::min(tile_size, size - J);
+
+          NumericT * A_IJ = data + I * inc1 + J * inc2;
+          NumericT * A_JI = data + J * inc1 + I * inc2;
+
+          if (inc2 == 1)
+          {
+            // buffer = A_IJ^T, A_IJ = A_JI^T, A_JI = buffer. For diagonal tiles A_IJ and A_JI coincide, which is fine since A_JI is read completely before A_IJ is written.
+            transpose_tile(A_IJ, inc1, &(buffer[0]), tile_size, rows_I, rows_J);
+            if (I != J)
+              transpose_tile(A_JI, inc1, A_IJ, inc1, rows_J, rows_I);
+            for (vcl_size_t j = 0; j < rows_J; ++j)
+              std::copy(&(buffer[j * tile_size]), &(buffer[j * tile_size]) + rows_I, A_JI + j * inc1);
+          }
+          else
+          {
+            for (vcl_size_t i = 0; i < rows_I; ++i)
+              for (vcl_size_t j = (I == J) ? i + 1 : 0; j < rows_J; ++j)
+                std::swap(A_IJ[i * inc1 + j * inc2], A_JI[j * inc1 + i * inc2]);
+          }
+        }
+      }
+    }
+  }
+
+  /** @brief Returns the offset of the first entry as well as the increments between entries in adjacent rows and columns of a dense matrix (including ranges and slices) */
+  template<typename NumericT>
+  vcl_size_t matrix_offset_and_increments(matrix_base<NumericT> const & A, vcl_size_t & inc1, vcl_size_t & inc2)
+  {
+    if (A.row_major())
+    {
+      inc1 = viennacl::traits::stride1(A) * viennacl::traits::internal_size2(A);
+      inc2 = viennacl::traits::stride2(A);
+      return viennacl::traits::start1(A) * viennacl::traits::internal_size2(A) + viennacl::traits::start2(A);
+    }
+
+    inc1 = viennacl::traits::stride1(A);
+    inc2 = viennacl::traits::stride2(A) * viennacl::traits::internal_size1(A);
+    return viennacl::traits::start1(A) + viennacl::traits::start2(A) * viennacl::traits::internal_size1(A);
+  }
+}
+
+/** @brief Computes temp_trans = trans(A) for the matrix A referenced by the transposition proxy. The layouts of A and temp_trans may differ. */
+template<typename NumericT,
+         typename SizeT, typename DistanceT>
+void trans(const matrix_expression<const matrix_base<NumericT, SizeT, DistanceT>,
+           const matrix_base<NumericT, SizeT, DistanceT>, op_trans> & proxy, matrix_base<NumericT> & temp_trans)
+{
+  matrix_base<NumericT> const & A = proxy.lhs();
+
+  vcl_size_t A_inc1, A_inc2, B_inc1, B_inc2;
+  vcl_size_t A_offset = detail::matrix_offset_and_increments(A,          A_inc1, A_inc2);
+  vcl_size_t B_offset = detail::matrix_offset_and_increments(temp_trans, B_inc1, B_inc2);
+
+  detail::transpose_strided(detail::extract_raw_pointer<NumericT>(A) + A_offset, A_inc1, A_inc2,
+                            detail::extract_raw_pointer<NumericT>(temp_trans) + B_offset, B_inc1, B_inc2,
+                            viennacl::traits::size1(A), viennacl::traits::size2(A));
+}
+
+/** @brief Transposes the square matrix A in place without allocating a second matrix. */
+template<typename NumericT>
+void inplace_trans(matrix_base<NumericT> & A)
+{
+  vcl_size_t A_inc1, A_inc2;
+  vcl_size_t A_offset = detail::matrix_offset_and_increments(A, A_inc1, A_inc2);
+
+  detail::inplace_transpose_strided(detail::extract_raw_pointer<NumericT>(A) + A_offset, A_inc1, A_inc2, viennacl::traits::size1(A));
 }
 
 template<typename NumericT, typename ScalarT1>
@@ -957,26 +1116,119 @@ void prod_impl(const matrix_base<NumericT> & mat, bool trans,
 
 namespace detail
 {
+  /** @brief Cache-blocked matrix-matrix product C = alpha * A * B + beta * C operating on packed panels (GotoBLAS scheme).
+    *
+    * The accessors A, B, C take care of layouts, transpositions, ranges and slices, hence they are only used for packing and for writing the result.
+    * Threads operate on independent macro-tiles of C, each packing its own block of A, while the packed panel of B is shared.
+    */
   template<typename MatrixAccT1, typename MatrixAccT2, typename MatrixAccT3, typename NumericT>
   void prod(MatrixAccT1 & A, MatrixAccT2 & B, MatrixAccT3 & C,
             vcl_size_t C_size1, vcl_size_t C_size2, vcl_size_t A_size2,
             NumericT alpha, NumericT beta)
   {
+    typedef gemm_blocking<NumericT>   blocking;
+
+    const vcl_size_t MR = blocking::MR;
+    const vcl_size_t NR = blocking::NR;
+    const vcl_size_t MC = blocking::MC;
+    const vcl_size_t KC = blocking::KC;
+    const vcl_size_t NC = blocking::NC;
+
+    if (C_size1 == 0 || C_size2 == 0)
+      return;
+
+    if (A_size2 == 0) // empty inner dimension: C = beta * C
+    {
+      for (vcl_size_t i = 0; i < C_size1; ++i)
+        for (vcl_size_t j = 0; j < C_size2; ++j)
+          C(i, j) = (beta != 0) ? beta * C(i, j) : NumericT(0);
+      return;
+    }
+
+    vcl_size_t num_blocks_M = (C_size1 - 1) / MC + 1;
+    vcl_size_t num_threads  = 1;
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for
+    bool use_threads = (C_size1 * C_size2 * A_size2 > VIENNACL_OPENMP_MATRIX_MIN_SIZE);
+    if (use_threads)
+      num_threads = static_cast<vcl_size_t>(omp_get_max_threads());
 #endif
-    for (long i=0; i<static_cast<long>(C_size1); ++i)
+
+    std::vector<NumericT> buffer_B(KC * ((std::min(NC, C_size2) - 1) / NR + 1) * NR);
+
+    for (vcl_size_t jc = 0; jc < C_size2; jc += NC)
     {
-      for (vcl_size_t j=0; j<C_size2; ++j)
+      vcl_size_t nc = std::min(NC, C_size2 - jc);
+      vcl_size_t num_panels_B = (nc - 1) / NR + 1;
+
+      // split the columns into several chunks if there are too few row blocks to keep all threads busy:
+      vcl_size_t num_chunks_N    = (num_blocks_M < num_threads) ? std::min(num_panels_B, (num_threads - 1) / num_blocks_M + 1) : 1;
+      vcl_size_t panels_per_chunk = (num_panels_B - 1) / num_chunks_N + 1;
+      num_chunks_N = (num_panels_B - 1) / panels_per_chunk + 1;
+
+      for (vcl_size_t pc = 0; pc < A_size2; pc += KC)
       {
-        NumericT temp = 0;
-        for (vcl_size_t k=0; k<A_size2; ++k)
-          temp += A(static_cast<vcl_size_t>(i), k) * B(k, j);
-
-        temp *= alpha;
-        if (beta != 0)
-          temp += beta * C(static_cast<vcl_size_t>(i),j);
-        C(static_cast<vcl_size_t>(i),j) = temp;
+        vcl_size_t kc = std::min(KC, A_size2 - pc);
+        bool first_pass = (pc == 0);
+
+        // pack the KC x NC panel of B (shared by all threads):
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (use_threads)
+#endif
+        for (long panel = 0; panel < static_cast<long>(num_panels_B); ++panel)
+        {
+          vcl_size_t jr = static_cast<vcl_size_t>(panel) * NR;
+          gemm_pack_B<NR>(B, pc, jc + jr, kc, std::min(NR, nc - jr), &(buffer_B[static_cast<vcl_size_t>(panel) * kc * NR]));
+        }
+
+        // run over all macro-tiles of C:
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel if (use_threads)
+#endif
+        {
+          std::vector<NumericT> buffer_A(MC * KC);  // thread-local
+          NumericT buffer_C[MR * NR];
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp for
+#endif
+          for (long tile = 0; tile < static_cast<long>(num_blocks_M * num_chunks_N); ++tile)
+          {
+            vcl_size_t ic = (static_cast<vcl_size_t>(tile) / num_chunks_N) * MC;
+            vcl_size_t mc = std::min(MC, C_size1 - ic);
+
+            vcl_size_t panel_start = (static_cast<vcl_size_t>(tile) % num_chunks_N) * panels_per_chunk;
+            vcl_size_t panel_end   = std::min(panel_start + panels_per_chunk, num_panels_B);
+
+            gemm_pack_A<MR>(A, ic, pc, mc, kc, &(buffer_A[0]));
+
+            for (vcl_size_t panel = panel_start; panel < panel_end; ++panel)
+            {
+              vcl_size_t jr = panel * NR;
+              vcl_size_t nr = std::min(NR, nc - jr);
+
+              for (vcl_size_t ir = 0; ir < mc; ir += MR)
+              {
+                vcl_size_t mr = std::min(MR, mc - ir);
+
+                gemm_micro_kernel<MR, NR, NumericT>::apply(kc, &(buffer_A[ir * kc]), &(buffer_B[panel * kc * NR]), buffer_C);
+
+                // write back register block:
+                for (vcl_size_t i = 0; i < mr; ++i)
+                  for (vcl_size_t j = 0; j < nr; ++j)
+                  {
+                    NumericT & entry_C = C(ic + ir + i, jc + jr + j);
+                    NumericT val = alpha * buffer_C[i * NR + j];
+                    if (!first_pass)
+                      entry_C += val;
+                    else if (beta != 0)
+                      entry_C = val + beta * entry_C;
+                    else
+                      entry_C = val;
+                  }
+              }
+            }
+          }
+        }
       }
     }
   }
@@ -0,0 +1,300 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_SLICED_ELL_KERNELS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_SLICED_ELL_KERNELS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/sliced_ell_kernels.hpp
+*   @brief Slice kernels for the SELL-C-sigma matrix-vector product (sliced_ell_matrix) on the CPU.
+*
+*   Each slice of C rows is stored column-wise, so one SIMD register holds consecutive rows of the slice and the entries of x are gathered.
+*   The gather-based kernels are selected at compile time from the instruction set (-mavx2 or -mavx512f) and require unit-stride vectors as well as a chunk height C divisible by the SIMD width.
+*   All other cases fall back to a generic kernel.
+*
+*   Entries with a zero value (in particular the padding) are skipped, so that inf or NaN entries of x in their columns do not turn the row sum into NaN.
+*   The SIMD kernels use masked gathers for this purpose, which also saves the loads for the padding.
+*/
+
+#include <climits>
+
+#include "viennacl/forwards.h"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+
+/** @brief Computes the partial row sums of one slice. Padding entries hold a zero value and are skipped.
+  *
+  * @param elements         The entries of the slice, stored column-wise with rows_per_block entries per column
+  * @param column_indices   The column indices of the slice, same layout as elements
+  * @param num_columns      Number of columns of the slice (i.e. the maximum number of nonzeros of a row in the slice)
+  * @param rows_per_block   The chunk height C
+  * @param x                Pointer to the first entry of the vector
+  * @param inc_x            Stride of the vector
+  * @param sums             Output array of length rows_per_block
+  */
+template<typename NumericT, typename IndexT>
+void sliced_ell_slice_generic(NumericT const * elements, IndexT const * column_indices,
+                              vcl_size_t num_columns, vcl_size_t rows_per_block,
+                              NumericT const * x, vcl_size_t inc_x,
+                              NumericT * sums)
+{
+  for (vcl_size_t row_in_block = 0; row_in_block < rows_per_block; ++row_in_block)
+    sums[row_in_block] = 0;
+
+  for (vcl_size_t column_entry_index = 0; column_entry_index < num_columns; ++column_entry_index)
+  {
+    NumericT const * val = elements       + column_entry_index * rows_per_block;
+    IndexT   const * col = column_indices + column_entry_index * rows_per_block;
+    for (vcl_size_t row_in_block = 0; row_in_block < rows_per_block; ++row_in_block)
+      sums[row_in_block] += val[row_in_block] ? val[row_in_block] * x[col[row_in_block] * inc_x] : 0;
+  }
+}
+
+/** @brief Slice kernel of the SELL-C-sigma matrix-vector product. Specialized below for SIMD instruction sets. */
+template<typename NumericT, typename IndexT>
+struct sliced_ell_slice_kernel
+{
+  static void apply(NumericT const * elements, IndexT const * column_indices,
+                    vcl_size_t num_columns, vcl_size_t rows_per_block,
+                    NumericT const * x, vcl_size_t inc_x, vcl_size_t /*size_x*/,
+                    NumericT * sums)
+  {
+    sliced_ell_slice_generic(elements, column_indices, num_columns, rows_per_block, x, inc_x, sums);
+  }
+};
+
+/** \cond */
+#if defined(__AVX512F__)
+
+template<>
+struct sliced_ell_slice_kernel<double, unsigned int>
+{
+  static void apply(double const * elements, unsigned int const * column_indices,
+                    vcl_size_t num_columns, vcl_size_t rows_per_block,
+                    double const * x, vcl_size_t inc_x, vcl_size_t size_x,
+                    double * sums)
+  {
+    if (inc_x != 1 || rows_per_block % 8 != 0 || size_x > static_cast<vcl_size_t>(INT_MAX))
+    {
+      sliced_ell_slice_generic(elements, column_indices, num_columns, rows_per_block, x, inc_x, sums);
+      return;
+    }
+
+    __m512d const zero = _mm512_setzero_pd();
+    vcl_size_t r = 0;
+    for (; r + 16 <= rows_per_block; r += 16)
+    {
+      __m512d sum0 = _mm512_setzero_pd();
+      __m512d sum1 = _mm512_setzero_pd();
+      for (vcl_size_t j = 0; j < num_columns; ++j)
+      {
+        double       const * val = elements       + j * rows_per_block + r;
+        unsigned int const * col = column_indices + j * rows_per_block + r;
+        __m512d val0 = _mm512_loadu_pd(val);
+        __m512d val1 = _mm512_loadu_pd(val + 8);
+        sum0 = _mm512_fmadd_pd(val0, _mm512_mask_i32gather_pd(zero, _mm512_cmpneq_pd_mask(val0, zero), _mm256_loadu_si256(reinterpret_cast<__m256i const *>(col)),     x, 8), sum0);
+        sum1 = _mm512_fmadd_pd(val1, _mm512_mask_i32gather_pd(zero, _mm512_cmpneq_pd_mask(val1, zero), _mm256_loadu_si256(reinterpret_cast<__m256i const *>(col + 8)), x, 8), sum1);
+      }
+      _mm512_storeu_pd(sums + r,     sum0);
+      _mm512_storeu_pd(sums + r + 8, sum1);
+    }
+    for (; r < rows_per_block; r += 8)
+    {
+      __m512d sum0 = _mm512_setzero_pd();
+      for (vcl_size_t j = 0; j < num_columns; ++j)
+      {
+        __m512d val0 = _mm512_loadu_pd(elements + j * rows_per_block + r);
+        sum0 = _mm512_fmadd_pd(val0,
+                               _mm512_mask_i32gather_pd(zero, _mm512_cmpneq_pd_mask(val0, zero), _mm256_loadu_si256(reinterpret_cast<__m256i const *>(column_indices + j * rows_per_block + r)), x, 8),
+                               sum0);
+      }
+      _mm512_storeu_pd(sums + r, sum0);
+    }
+  }
+};
+
+template<>
+struct sliced_ell_slice_kernel<float, unsigned int>
+{
+  static void apply(float const * elements, unsigned int const * column_indices,
+                    vcl_size_t num_columns, vcl_size_t rows_per_block,
+                    float const * x, vcl_size_t inc_x, vcl_size_t size_x,
+                    float * sums)
+  {
+    if (inc_x != 1 || rows_per_block % 16 != 0 || size_x > static_cast<vcl_size_t>(INT_MAX))
+    {
+      sliced_ell_slice_generic(elements, column_indices, num_columns, rows_per_block, x, inc_x, sums);
+      return;
+    }
+
+    __m512 const zero = _mm512_setzero_ps();
+    vcl_size_t r = 0;
+    for (; r + 32 <= rows_per_block; r += 32)
+    {
+      __m512 sum0 = _mm512_setzero_ps();
+      __m512 sum1 = _mm512_setzero_ps();
+      for (vcl_size_t j = 0; j < num_columns; ++j)
+      {
+        float        const * val = elements       + j * rows_per_block + r;
+        unsigned int const * col = column_indices + j * rows_per_block + r;
+        __m512 val0 = _mm512_loadu_ps(val);
+        __m512 val1 = _mm512_loadu_ps(val + 16);
+        sum0 = _mm512_fmadd_ps(val0, _mm512_mask_i32gather_ps(zero, _mm512_cmpneq_ps_mask(val0, zero), _mm512_loadu_si512(col),      x, 4), sum0);
+        sum1 = _mm512_fmadd_ps(val1, _mm512_mask_i32gather_ps(zero, _mm512_cmpneq_ps_mask(val1, zero), _mm512_loadu_si512(col + 16), x, 4), sum1);
+      }
+      _mm512_storeu_ps(sums + r,      sum0);
+      _mm512_storeu_ps(sums + r + 16, sum1);
+    }
+    for (; r < rows_per_block; r += 16)
+    {
+      __m512 sum0 = _mm512_setzero_ps();
+      for (vcl_size_t j = 0; j < num_columns; ++j)
+      {
+        __m512 val0 = _mm512_loadu_ps(elements + j * rows_per_block + r);
+        sum0 = _mm512_fmadd_ps(val0,
+                               _mm512_mask_i32gather_ps(zero, _mm512_cmpneq_ps_mask(val0, zero), _mm512_loadu_si512(column_indices + j * rows_per_block + r), x, 4),
+                               sum0);
+      }
+      _mm512_storeu_ps(sums + r, sum0);
+    }
+  }
+};
+
+#elif defined(__AVX2__)
+
+#if defined(__FMA__)
+  #define VIENNACL_SELL_AVX2_MADD_PD(a, b, c)  _mm256_fmadd_pd(a, b, c)
+  #define VIENNACL_SELL_AVX2_MADD_PS(a, b, c)  _mm256_fmadd_ps(a, b, c)
+#else
+  #define VIENNACL_SELL_AVX2_MADD_PD(a, b, c)  _mm256_add_pd(_mm256_mul_pd(a, b), c)
+  #define VIENNACL_SELL_AVX2_MADD_PS(a, b, c)  _mm256_add_ps(_mm256_mul_ps(a, b), c)
+#endif
+
+template<>
+struct sliced_ell_slice_kernel<double, unsigned int>
+{
+  static void apply(double const * elements, unsigned int const * column_indices,
+                    vcl_size_t num_columns, vcl_size_t rows_per_block,
+                    double const * x, vcl_size_t inc_x, vcl_size_t size_x,
+                    double * sums)
+  {
+    if (inc_x != 1 || rows_per_block % 4 != 0 || size_x > static_cast<vcl_size_t>(INT_MAX))
+    {
+      sliced_ell_slice_generic(elements, column_indices, num_columns, rows_per_block, x, inc_x, sums);
+      return;
+    }
+
+    __m256d const zero = _mm256_setzero_pd();
+    vcl_size_t r = 0;
+    for (; r + 8 <= rows_per_block; r += 8)
+    {
+      __m256d sum0 = _mm256_setzero_pd();
+      __m256d sum1 = _mm256_setzero_pd();
+      for (vcl_size_t j = 0; j < num_columns; ++j)
+      {
+        double       const * val = elements       + j * rows_per_block + r;
+        unsigned int const * col = column_indices + j * rows_per_block + r;
+        __m256d val0 = _mm256_loadu_pd(val);
+        __m256d val1 = _mm256_loadu_pd(val + 4);
+        sum0 = VIENNACL_SELL_AVX2_MADD_PD(val0, _mm256_mask_i32gather_pd(zero, x, _mm_loadu_si128(reinterpret_cast<__m128i const *>(col)),     _mm256_cmp_pd(val0, zero, _CMP_NEQ_UQ), 8), sum0);
+        sum1 = VIENNACL_SELL_AVX2_MADD_PD(val1, _mm256_mask_i32gather_pd(zero, x, _mm_loadu_si128(reinterpret_cast<__m128i const *>(col + 4)), _mm256_cmp_pd(val1, zero, _CMP_NEQ_UQ), 8), sum1);
+      }
+      _mm256_storeu_pd(sums + r,     sum0);
+      _mm256_storeu_pd(sums + r + 4, sum1);
+    }
+    for (; r < rows_per_block; r += 4)
+    {
+      __m256d sum0 = _mm256_setzero_pd();
+      for (vcl_size_t j = 0; j < num_columns; ++j)
+      {
+        __m256d val0 = _mm256_loadu_pd(elements + j * rows_per_block + r);
+        sum0 = VIENNACL_SELL_AVX2_MADD_PD(val0,
+                                          _mm256_mask_i32gather_pd(zero, x, _mm_loadu_si128(reinterpret_cast<__m128i const *>(column_indices + j * rows_per_block + r)), _mm256_cmp_pd(val0, zero, _CMP_NEQ_UQ), 8),
+                                          sum0);
+      }
+      _mm256_storeu_pd(sums + r, sum0);
+    }
+  }
+};
+
+template<>
+struct sliced_ell_slice_kernel<float, unsigned int>
+{
+  static void apply(float const * elements, unsigned int const * column_indices,
+                    vcl_size_t num_columns, vcl_size_t rows_per_block,
+                    float const * x, vcl_size_t inc_x, vcl_size_t size_x,
+                    float * sums)
+  {
+    if (inc_x != 1 || rows_per_block % 8 != 0 || size_x > static_cast<vcl_size_t>(INT_MAX))
+    {
+      sliced_ell_slice_generic(elements, column_indices, num_columns, rows_per_block, x, inc_x, sums);
+      return;
+    }
+
+    __m256 const zero = _mm256_setzero_ps();
+    vcl_size_t r = 0;
+    for (; r + 16 <= rows_per_block; r += 16)
+    {
+      __m256 sum0 = _mm256_setzero_ps();
+      __m256 sum1 = _mm256_setzero_ps();
+      for (vcl_size_t j = 0; j < num_columns; ++j)
+      {
+        float        const * val = elements       + j * rows_per_block + r;
+        unsigned int const * col = column_indices + j * rows_per_block + r;
+        __m256 val0 = _mm256_loadu_ps(val);
+        __m256 val1 = _mm256_loadu_ps(val + 8);
+        sum0 = VIENNACL_SELL_AVX2_MADD_PS(val0, _mm256_mask_i32gather_ps(zero, x, _mm256_loadu_si256(reinterpret_cast<__m256i const *>(col)),     _mm256_cmp_ps(val0, zero, _CMP_NEQ_UQ), 4), sum0);
+        sum1 = VIENNACL_SELL_AVX2_MADD_PS(val1, _mm256_mask_i32gather_ps(zero, x, _mm256_loadu_si256(reinterpret_cast<__m256i const *>(col + 8)), _mm256_cmp_ps(val1, zero, _CMP_NEQ_UQ), 4), sum1);
+      }
+      _mm256_storeu_ps(sums + r,     sum0);
+      _mm256_storeu_ps(sums + r + 8, sum1);
+    }
+    for (; r < rows_per_block; r += 8)
+    {
+      __m256 sum0 = _mm256_setzero_ps();
+      for (vcl_size_t j = 0; j < num_columns; ++j)
+      {
+        __m256 val0 = _mm256_loadu_ps(elements + j * rows_per_block + r);
+        sum0 = VIENNACL_SELL_AVX2_MADD_PS(val0,
+                                          _mm256_mask_i32gather_ps(zero, x, _mm256_loadu_si256(reinterpret_cast<__m256i const *>(column_indices + j * rows_per_block + r)), _mm256_cmp_ps(val0, zero, _CMP_NEQ_UQ), 4),
+                                          sum0);
+      }
+      _mm256_storeu_ps(sums + r, sum0);
+    }
+  }
+};
+
+#endif
+/** \endcond */
+
+} //namespace detail
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
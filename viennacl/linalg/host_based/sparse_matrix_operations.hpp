@@ -22,7 +22,9 @@
     @brief Implementations of operations using sparse matrices on the CPU using a single thread or OpenMP.
 */
 
+#include <algorithm>
 #include <list>
+#include <vector>
 
 #include "viennacl/forwards.h"
 #include "viennacl/scalar.hpp"
@@ -30,6 +32,16 @@
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/host_based/common.hpp"
 #include "viennacl/linalg/host_based/vector_operations.hpp"
+#include "viennacl/linalg/host_based/sliced_ell_kernels.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+// Minimum average number of rows per level for running level-scheduled triangular substitutions with OpenMP:
+#ifndef VIENNACL_OPENMP_LEVEL_SCHEDULE_MIN_LEVEL_SIZE
+  #define VIENNACL_OPENMP_LEVEL_SCHEDULE_MIN_LEVEL_SIZE  256
+#endif
 
 namespace viennacl
 {
@@ -43,6 +55,32 @@ namespace host_based
 
 namespace detail
 {
+  /** @brief Checks whether the row blocks of a compressed_matrix (see compressed_matrix::generate_row_block_information()) are consistent with the current row array.
+    *
+    * Guards against stale row blocks if the sparsity pattern was modified through the raw handles.
+    */
+  inline bool csr_row_blocks_valid(unsigned int const * row_buffer, vcl_size_t num_rows,
+                                   unsigned int const * row_blocks, vcl_size_t num_blocks)
+  {
+    if (row_blocks[0] != 0 || row_blocks[1] != 0)
+      return false;
+    if (row_blocks[2 * num_blocks] != num_rows || row_blocks[2 * num_blocks + 1] != row_buffer[num_rows])
+      return false;
+
+    for (vcl_size_t block = 1; block < num_blocks; ++block)
+    {
+      vcl_size_t row = row_blocks[2 * block];
+      vcl_size_t nnz_index = row_blocks[2 * block + 1];
+      if (row < row_blocks[2 * block - 2] || nnz_index < row_blocks[2 * block - 1] || row > num_rows)
+        return false;
+      if (row < num_rows && (nnz_index < row_buffer[row] || nnz_index > row_buffer[row + 1]))
+        return false;
+      if (row == num_rows && nnz_index != row_buffer[num_rows])
+        return false;
+    }
+    return true;
+  }
+
   template<typename NumericT, unsigned int AlignmentV>
   void row_info(compressed_matrix<NumericT, AlignmentV> const & mat,
                 vector_base<NumericT> & vec,
@@ -112,16 +150,65 @@ void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & mat,
   unsigned int const * row_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle1());
   unsigned int const * col_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle2());
 
+  vcl_size_t vec_start    = vec.start();
+  vcl_size_t vec_inc      = vec.stride();
+  vcl_size_t result_start = result.start();
+  vcl_size_t result_inc   = result.stride();
+
+  if (mat.blocks1() > 1
+      && detail::csr_row_blocks_valid(row_buffer, mat.size1(), detail::extract_raw_pointer<unsigned int>(mat.handle3()), mat.blocks1()))
+  {
+    // nnz-balanced partition: each block may start and end in the middle of a row.
+    unsigned int const * row_blocks = detail::extract_raw_pointer<unsigned int>(mat.handle3());
+    std::vector<NumericT> carries(mat.blocks1());
+
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
+    #pragma omp parallel for
 #endif
-  for (long row = 0; row < static_cast<long>(mat.size1()); ++row)
+    for (long block = 0; block < static_cast<long>(mat.blocks1()); ++block)
+    {
+      vcl_size_t row       = row_blocks[2 * block];
+      vcl_size_t i         = row_blocks[2 * block + 1];
+      vcl_size_t row_stop  = row_blocks[2 * block + 2];
+      vcl_size_t nnz_stop  = row_blocks[2 * block + 3];
+
+      for (; row < row_stop; ++row)
+      {
+        NumericT dot_prod = 0;
+        vcl_size_t row_end = row_buffer[row+1];
+        for (; i < row_end; ++i)
+          dot_prod += elements[i] * vec_buf[col_buffer[i] * vec_inc + vec_start];
+        result_buf[row * result_inc + result_start] = dot_prod;
+      }
+
+      // partial result for the row continued in the next block(s):
+      NumericT carry = 0;
+      for (; i < nnz_stop; ++i)
+        carry += elements[i] * vec_buf[col_buffer[i] * vec_inc + vec_start];
+      carries[static_cast<vcl_size_t>(block)] = carry;
+    }
+
+    // fix-up of rows split across blocks:
+    for (vcl_size_t block = 0; block < mat.blocks1(); ++block)
+    {
+      vcl_size_t carry_row = row_blocks[2 * block + 2];
+      if (carry_row < mat.size1())
+        result_buf[carry_row * result_inc + result_start] += carries[block];
+    }
+  }
+  else
   {
-    NumericT dot_prod = 0;
-    vcl_size_t row_end = row_buffer[row+1];
-    for (vcl_size_t i = row_buffer[row]; i < row_end; ++i)
-      dot_prod += elements[i] * vec_buf[col_buffer[i] * vec.stride() + vec.start()];
-    result_buf[static_cast<vcl_size_t>(row) * result.stride() + result.start()] = dot_prod;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long row = 0; row < static_cast<long>(mat.size1()); ++row)
+    {
+      NumericT dot_prod = 0;
+      vcl_size_t row_end = row_buffer[row+1];
+      for (vcl_size_t i = row_buffer[row]; i < row_end; ++i)
+        dot_prod += elements[i] * vec_buf[col_buffer[i] * vec_inc + vec_start];
+      result_buf[static_cast<vcl_size_t>(row) * result_inc + result_start] = dot_prod;
+    }
   }
 
 }
@@ -190,21 +277,22 @@ void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & sp_mat,
     }
   }
   else {
+    // rows in the outer loop, so that the sparse matrix is streamed from memory only once for all columns of d_mat:
 #ifdef VIENNACL_WITH_OPENMP
   #pragma omp parallel for
 #endif
-    for (long col = 0; col < static_cast<long>(d_mat.size2()); ++col) {
-      for (long row = 0; row < static_cast<long>(sp_mat.size1()); ++row) {
-        vcl_size_t row_start = sp_mat_row_buffer[row];
-        vcl_size_t row_end = sp_mat_row_buffer[row+1];
+    for (long row = 0; row < static_cast<long>(sp_mat.size1()); ++row) {
+      vcl_size_t row_start = sp_mat_row_buffer[row];
+      vcl_size_t row_end = sp_mat_row_buffer[row+1];
+      for (vcl_size_t col = 0; col < d_mat.size2(); ++col) {
         NumericT temp = 0;
         for (vcl_size_t k = row_start; k < row_end; ++k) {
-          temp += sp_mat_elements[k] * d_mat_wrapper_col(static_cast<vcl_size_t>(sp_mat_col_buffer[k]), static_cast<vcl_size_t>(col));
+          temp += sp_mat_elements[k] * d_mat_wrapper_col(static_cast<vcl_size_t>(sp_mat_col_buffer[k]), col);
         }
         if (result.row_major())
-          result_wrapper_row(row, col) = temp;
+          result_wrapper_row(row, static_cast<vcl_size_t>(col)) = temp;
         else
-          result_wrapper_col(row, col) = temp;
+          result_wrapper_col(row, static_cast<vcl_size_t>(col)) = temp;
       }
     }
   }
@@ -300,6 +388,138 @@ void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & sp_mat,
 }
 
 
+/** @brief Carries out the sparse matrix-sparse matrix product C = prod(A, B) with all matrices being compressed.
+*
+* Uses the row-wise (Gustavson) formulation with two passes: A symbolic pass determines the number of nonzeros in each row of C,
+* which allows to allocate the arrays of C exactly once. The numeric pass then writes each row of C directly into these arrays.
+* Each thread uses a dense accumulator of size B.size2() together with a marker array, so no synchronization is needed between rows.
+*
+* @param A     The left hand side sparse matrix
+* @param B     The right hand side sparse matrix
+* @param C     The result matrix. Any previous content is discarded.
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void prod_impl(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+               viennacl::compressed_matrix<NumericT, AlignmentV> const & B,
+               viennacl::compressed_matrix<NumericT, AlignmentV> & C)
+{
+  assert(A.size2() == B.size1() && bool("Size mismatch in sparse matrix-matrix product"));
+
+  NumericT     const * A_elements   = detail::extract_raw_pointer<NumericT>(A.handle());
+  unsigned int const * A_row_buffer = detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * A_col_buffer = detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  NumericT     const * B_elements   = detail::extract_raw_pointer<NumericT>(B.handle());
+  unsigned int const * B_row_buffer = detail::extract_raw_pointer<unsigned int>(B.handle1());
+  unsigned int const * B_col_buffer = detail::extract_raw_pointer<unsigned int>(B.handle2());
+
+  vcl_size_t C_size1 = A.size1();
+  vcl_size_t C_size2 = B.size2();
+
+  std::vector<unsigned int> C_row_nnz(C_size1);
+
+  //
+  // Symbolic pass: count the number of distinct columns in each row of C
+  //
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    std::vector<unsigned int> row_marker(C_size2, static_cast<unsigned int>(C_size1));
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for schedule(dynamic, 64)
+#endif
+    for (long row = 0; row < static_cast<long>(C_size1); ++row)
+    {
+      unsigned int row_nnz = 0;
+      for (unsigned int i = A_row_buffer[row]; i < A_row_buffer[row+1]; ++i)
+      {
+        unsigned int k = A_col_buffer[i];
+        for (unsigned int j = B_row_buffer[k]; j < B_row_buffer[k+1]; ++j)
+        {
+          unsigned int col = B_col_buffer[j];
+          if (row_marker[col] != static_cast<unsigned int>(row))
+          {
+            row_marker[col] = static_cast<unsigned int>(row);
+            ++row_nnz;
+          }
+        }
+      }
+      C_row_nnz[static_cast<vcl_size_t>(row)] = row_nnz;
+    }
+  }
+
+  vcl_size_t C_nnz = 0;
+  for (vcl_size_t row = 0; row < C_size1; ++row)
+    C_nnz += C_row_nnz[row];
+
+  // an empty product is stored with a single explicit zero, just like viennacl::copy() does for empty matrices:
+  vcl_size_t C_storage = std::max<vcl_size_t>(C_nnz, 1);
+  C.resize_uninitialized(C_size1, C_size2, C_storage, viennacl::context(viennacl::MAIN_MEMORY));
+
+  unsigned int * C_row_buffer = detail::extract_raw_pointer<unsigned int>(C.handle1());
+  unsigned int * C_col_buffer = detail::extract_raw_pointer<unsigned int>(C.handle2());
+  NumericT     * C_elements   = detail::extract_raw_pointer<NumericT>(C.handle());
+
+  // exclusive scan of the row lengths:
+  C_row_buffer[0] = 0;
+  for (vcl_size_t row = 0; row < C_size1; ++row)
+    C_row_buffer[row + 1] = C_row_buffer[row] + C_row_nnz[row];
+  if (C_nnz == 0)
+  {
+    C_col_buffer[0] = 0;
+    C_elements[0] = 0;
+  }
+
+  //
+  // Numeric pass: accumulate each row of C in a dense work array and write the sorted result to C
+  //
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    std::vector<unsigned int> row_marker(C_size2, static_cast<unsigned int>(C_size1));
+    std::vector<NumericT>     row_values(C_size2);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for schedule(dynamic, 64)
+#endif
+    for (long row = 0; row < static_cast<long>(C_size1); ++row)
+    {
+      unsigned int * row_cols = C_col_buffer + C_row_buffer[row];
+      unsigned int row_nnz = 0;
+
+      for (unsigned int i = A_row_buffer[row]; i < A_row_buffer[row+1]; ++i)
+      {
+        unsigned int k   = A_col_buffer[i];
+        NumericT     val = A_elements[i];
+        for (unsigned int j = B_row_buffer[k]; j < B_row_buffer[k+1]; ++j)
+        {
+          unsigned int col = B_col_buffer[j];
+          if (row_marker[col] != static_cast<unsigned int>(row))
+          {
+            row_marker[col] = static_cast<unsigned int>(row);
+            row_cols[row_nnz++] = col;
+            row_values[col] = val * B_elements[j];
+          }
+          else
+            row_values[col] += val * B_elements[j];
+        }
+      }
+
+      std::sort(row_cols, row_cols + row_nnz);
+
+      NumericT * row_elements = C_elements + C_row_buffer[row];
+      for (unsigned int i = 0; i < row_nnz; ++i)
+        row_elements[i] = row_values[row_cols[i]];
+    }
+  }
+
+  C.generate_row_block_information();
+}
+
+
 //
 // Triangular solve for compressed_matrix, A \ b
 //
@@ -635,34 +855,41 @@ namespace detail
   //
   // block solves
   //
+  // Note: The factors are block-diagonal with respect to block_indices, so the blocks are processed concurrently.
+  //
   template<typename NumericT, unsigned int AlignmentV>
   void block_inplace_solve(const matrix_expression<const compressed_matrix<NumericT, AlignmentV>,
                                                    const compressed_matrix<NumericT, AlignmentV>,
                                                    op_trans> & L,
-                           viennacl::backend::mem_handle const & /* block_indices */, vcl_size_t /* num_blocks */,
+                           viennacl::backend::mem_handle const & block_indices, vcl_size_t num_blocks,
                            vector_base<NumericT> const & /* L_diagonal */,  //ignored
                            vector_base<NumericT> & vec,
                            viennacl::linalg::unit_lower_tag)
   {
-    // Note: The following could be implemented more efficiently using the block structure and possibly OpenMP.
-
     unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L.lhs().handle1());
     unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L.lhs().handle2());
     NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(L.lhs().handle());
+    unsigned int const * block_buffer = detail::extract_raw_pointer<unsigned int>(block_indices);
     NumericT           * vec_buffer = detail::extract_raw_pointer<NumericT>(vec.handle());
 
-    vcl_size_t col_begin = row_buffer[0];
-    for (vcl_size_t col = 0; col < L.lhs().size1(); ++col)
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long block_id = 0; block_id < static_cast<long>(num_blocks); ++block_id)
     {
-      NumericT vec_entry = vec_buffer[col];
-      vcl_size_t col_end = row_buffer[col+1];
-      for (vcl_size_t i = col_begin; i < col_end; ++i)
+      vcl_size_t col_start = block_buffer[2*block_id];
+      vcl_size_t col_stop  = block_buffer[2*block_id+1];
+
+      for (vcl_size_t col = col_start; col < col_stop; ++col)
       {
-        unsigned int row_index = col_buffer[i];
-        if (row_index > col)
-          vec_buffer[row_index] -= vec_entry * elements[i];
+        NumericT vec_entry = vec_buffer[col];
+        for (vcl_size_t i = row_buffer[col]; i < row_buffer[col+1]; ++i)
+        {
+          unsigned int row_index = col_buffer[i];
+          if (row_index > col)
+            vec_buffer[row_index] -= vec_entry * elements[i];
+        }
       }
-      col_begin = col_end;
     }
   }
 
@@ -670,33 +897,37 @@ namespace detail
   void block_inplace_solve(const matrix_expression<const compressed_matrix<NumericT, AlignmentV>,
                                                    const compressed_matrix<NumericT, AlignmentV>,
                                                    op_trans> & L,
-                           viennacl::backend::mem_handle const & /*block_indices*/, vcl_size_t /* num_blocks */,
+                           viennacl::backend::mem_handle const & block_indices, vcl_size_t num_blocks,
                            vector_base<NumericT> const & L_diagonal,
                            vector_base<NumericT> & vec,
                            viennacl::linalg::lower_tag)
   {
-    // Note: The following could be implemented more efficiently using the block structure and possibly OpenMP.
-
     unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L.lhs().handle1());
     unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L.lhs().handle2());
     NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(L.lhs().handle());
     NumericT     const * diagonal_buffer = detail::extract_raw_pointer<NumericT>(L_diagonal.handle());
+    unsigned int const * block_buffer = detail::extract_raw_pointer<unsigned int>(block_indices);
     NumericT           * vec_buffer = detail::extract_raw_pointer<NumericT>(vec.handle());
 
-    vcl_size_t col_begin = row_buffer[0];
-    for (vcl_size_t col = 0; col < L.lhs().size1(); ++col)
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long block_id = 0; block_id < static_cast<long>(num_blocks); ++block_id)
     {
-      vcl_size_t col_end = row_buffer[col+1];
+      vcl_size_t col_start = block_buffer[2*block_id];
+      vcl_size_t col_stop  = block_buffer[2*block_id+1];
 
-      NumericT vec_entry = vec_buffer[col] / diagonal_buffer[col];
-      vec_buffer[col] = vec_entry;
-      for (vcl_size_t i = col_begin; i < col_end; ++i)
+      for (vcl_size_t col = col_start; col < col_stop; ++col)
       {
-        vcl_size_t row_index = col_buffer[i];
-        if (row_index > col)
-          vec_buffer[row_index] -= vec_entry * elements[i];
+        NumericT vec_entry = vec_buffer[col] / diagonal_buffer[col];
+        vec_buffer[col] = vec_entry;
+        for (vcl_size_t i = row_buffer[col]; i < row_buffer[col+1]; ++i)
+        {
+          vcl_size_t row_index = col_buffer[i];
+          if (row_index > col)
+            vec_buffer[row_index] -= vec_entry * elements[i];
+        }
       }
-      col_begin = col_end;
     }
   }
 
@@ -706,32 +937,37 @@ namespace detail
   void block_inplace_solve(const matrix_expression<const compressed_matrix<NumericT, AlignmentV>,
                                                    const compressed_matrix<NumericT, AlignmentV>,
                                                    op_trans> & U,
-                           viennacl::backend::mem_handle const & /*block_indices*/, vcl_size_t /* num_blocks */,
+                           viennacl::backend::mem_handle const & block_indices, vcl_size_t num_blocks,
                            vector_base<NumericT> const & /* U_diagonal */, //ignored
                            vector_base<NumericT> & vec,
                            viennacl::linalg::unit_upper_tag)
   {
-    // Note: The following could be implemented more efficiently using the block structure and possibly OpenMP.
-
     unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(U.lhs().handle1());
     unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(U.lhs().handle2());
     NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(U.lhs().handle());
+    unsigned int const * block_buffer = detail::extract_raw_pointer<unsigned int>(block_indices);
     NumericT           * vec_buffer = detail::extract_raw_pointer<NumericT>(vec.handle());
 
-    for (vcl_size_t col2 = 0; col2 < U.lhs().size1(); ++col2)
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long block_id = 0; block_id < static_cast<long>(num_blocks); ++block_id)
     {
-      vcl_size_t col = (U.lhs().size1() - col2) - 1;
+      vcl_size_t col_start = block_buffer[2*block_id];
+      vcl_size_t col_stop  = block_buffer[2*block_id+1];
 
-      NumericT vec_entry = vec_buffer[col];
-      vcl_size_t col_begin = row_buffer[col];
-      vcl_size_t col_end = row_buffer[col+1];
-      for (vcl_size_t i = col_begin; i < col_end; ++i)
+      for (vcl_size_t col2 = col_start; col2 < col_stop; ++col2)
       {
-        vcl_size_t row_index = col_buffer[i];
-        if (row_index < col)
-          vec_buffer[row_index] -= vec_entry * elements[i];
-      }
+        vcl_size_t col = (col_stop - (col2 - col_start)) - 1;
 
+        NumericT vec_entry = vec_buffer[col];
+        for (vcl_size_t i = row_buffer[col]; i < row_buffer[col+1]; ++i)
+        {
+          vcl_size_t row_index = col_buffer[i];
+          if (row_index < col)
+            vec_buffer[row_index] -= vec_entry * elements[i];
+        }
+      }
     }
   }
 
@@ -739,33 +975,38 @@ namespace detail
   void block_inplace_solve(const matrix_expression<const compressed_matrix<NumericT, AlignmentV>,
                                                    const compressed_matrix<NumericT, AlignmentV>,
                                                    op_trans> & U,
-                           viennacl::backend::mem_handle const & /* block_indices */, vcl_size_t /* num_blocks */,
+                           viennacl::backend::mem_handle const & block_indices, vcl_size_t num_blocks,
                            vector_base<NumericT> const & U_diagonal,
                            vector_base<NumericT> & vec,
                            viennacl::linalg::upper_tag)
   {
-    // Note: The following could be implemented more efficiently using the block structure and possibly OpenMP.
-
     unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(U.lhs().handle1());
     unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(U.lhs().handle2());
     NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(U.lhs().handle());
     NumericT     const * diagonal_buffer = detail::extract_raw_pointer<NumericT>(U_diagonal.handle());
+    unsigned int const * block_buffer = detail::extract_raw_pointer<unsigned int>(block_indices);
     NumericT           * vec_buffer = detail::extract_raw_pointer<NumericT>(vec.handle());
 
-    for (vcl_size_t col2 = 0; col2 < U.lhs().size1(); ++col2)
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long block_id = 0; block_id < static_cast<long>(num_blocks); ++block_id)
     {
-      vcl_size_t col = (U.lhs().size1() - col2) - 1;
-      vcl_size_t col_begin = row_buffer[col];
-      vcl_size_t col_end = row_buffer[col+1];
+      vcl_size_t col_start = block_buffer[2*block_id];
+      vcl_size_t col_stop  = block_buffer[2*block_id+1];
 
-      // Stage 2: Substitute
-      NumericT vec_entry = vec_buffer[col] / diagonal_buffer[col];
-      vec_buffer[col] = vec_entry;
-      for (vcl_size_t i = col_begin; i < col_end; ++i)
+      for (vcl_size_t col2 = col_start; col2 < col_stop; ++col2)
       {
-        vcl_size_t row_index = col_buffer[i];
-        if (row_index < col)
-          vec_buffer[row_index] -= vec_entry * elements[i];
+        vcl_size_t col = (col_stop - (col2 - col_start)) - 1;
+
+        NumericT vec_entry = vec_buffer[col] / diagonal_buffer[col];
+        vec_buffer[col] = vec_entry;
+        for (vcl_size_t i = row_buffer[col]; i < row_buffer[col+1]; ++i)
+        {
+          vcl_size_t row_index = col_buffer[i];
+          if (row_index < col)
+            vec_buffer[row_index] -= vec_entry * elements[i];
+        }
       }
     }
   }
@@ -861,6 +1102,297 @@ void inplace_solve(matrix_expression< const compressed_matrix<NumericT, Alignmen
 
 
 
+//
+// Level-scheduled triangular solves for compressed_matrix (used by the ILU and IChol preconditioners)
+//
+
+namespace detail
+{
+  /** @brief Level sets of a sparse triangular factor for repeated substitutions on the host.
+  *
+  * The rows of level k are row_indices[level_offsets[k]], ..., row_indices[level_offsets[k+1]-1] and only depend on rows of earlier levels.
+  * The off-diagonal entries of these rows are stored in the same order (CSR with row_buffer indexed by position in row_indices),
+  * so that the rows of a level can be eliminated concurrently while streaming through contiguous memory.
+  */
+  template<typename NumericT>
+  struct csr_level_schedule
+  {
+    vcl_size_t levels() const { return level_offsets.size() > 0 ? level_offsets.size() - 1 : 0; }
+    vcl_size_t size()   const { return row_indices.size(); }
+
+    std::vector<unsigned int> level_offsets;
+    std::vector<unsigned int> row_indices;
+    std::vector<unsigned int> row_buffer;
+    std::vector<unsigned int> col_buffer;
+    std::vector<NumericT>     elements;
+    std::vector<NumericT>     diagonal;   // empty for unit diagonal
+  };
+
+  inline bool level_schedule_is_lower(viennacl::linalg::unit_lower_tag) { return true;  }
+  inline bool level_schedule_is_lower(viennacl::linalg::lower_tag)      { return true;  }
+  inline bool level_schedule_is_lower(viennacl::linalg::unit_upper_tag) { return false; }
+  inline bool level_schedule_is_lower(viennacl::linalg::upper_tag)      { return false; }
+
+  inline bool level_schedule_is_unit(viennacl::linalg::unit_lower_tag) { return true;  }
+  inline bool level_schedule_is_unit(viennacl::linalg::lower_tag)      { return false; }
+  inline bool level_schedule_is_unit(viennacl::linalg::unit_upper_tag) { return true;  }
+  inline bool level_schedule_is_unit(viennacl::linalg::upper_tag)      { return false; }
+
+  /** @brief Computes the levels and the level-ordered copy of a triangular factor given by its strictly triangular rows.
+  *
+  * @param tri_row_buffer   Row offsets of the strictly triangular part (size num_rows+1)
+  * @param tri_col_buffer   Column indices of the strictly triangular part
+  * @param tri_elements     Entries of the strictly triangular part
+  * @param diagonal         Diagonal entries, empty for unit diagonal
+  * @param is_lower         Whether the factor is lower triangular (forward substitution)
+  * @param schedule         The resulting schedule
+  */
+  template<typename NumericT>
+  void csr_level_schedule_init(std::vector<unsigned int> const & tri_row_buffer,
+                               std::vector<unsigned int> const & tri_col_buffer,
+                               std::vector<NumericT>     const & tri_elements,
+                               std::vector<NumericT>     const & diagonal,
+                               bool is_lower,
+                               csr_level_schedule<NumericT> & schedule)
+  {
+    vcl_size_t num_rows = tri_row_buffer.size() - 1;
+
+    // level of each row: one more than the highest level of the rows it depends on
+    std::vector<unsigned int> row_level(num_rows);
+    unsigned int num_levels = 0;
+    for (vcl_size_t row2 = 0; row2 < num_rows; ++row2)
+    {
+      vcl_size_t row = is_lower ? row2 : (num_rows - row2) - 1;
+      unsigned int level = 0;
+      for (unsigned int i = tri_row_buffer[row]; i < tri_row_buffer[row+1]; ++i)
+        level = std::max<unsigned int>(level, row_level[tri_col_buffer[i]] + 1);
+      row_level[row] = level;
+      num_levels = std::max<unsigned int>(num_levels, level + 1);
+    }
+
+    // bucket rows by level (counting sort, rows stay in ascending order within a level)
+    schedule.level_offsets.assign(num_levels + 1, 0);
+    for (vcl_size_t row = 0; row < num_rows; ++row)
+      schedule.level_offsets[row_level[row] + 1] += 1;
+    for (vcl_size_t k = 0; k < num_levels; ++k)
+      schedule.level_offsets[k+1] += schedule.level_offsets[k];
+
+    std::vector<unsigned int> level_fill(schedule.level_offsets.begin(), schedule.level_offsets.end() - 1);
+    schedule.row_indices.resize(num_rows);
+    for (vcl_size_t row = 0; row < num_rows; ++row)
+      schedule.row_indices[level_fill[row_level[row]]++] = static_cast<unsigned int>(row);
+
+    // copy the strictly triangular rows in level order:
+    schedule.row_buffer.resize(num_rows + 1);
+    schedule.col_buffer.resize(tri_col_buffer.size());
+    schedule.elements.resize(tri_elements.size());
+    schedule.diagonal.resize(diagonal.size());
+    schedule.row_buffer[0] = 0;
+    for (vcl_size_t i = 0; i < num_rows; ++i)
+    {
+      unsigned int row = schedule.row_indices[i];
+      unsigned int offset = schedule.row_buffer[i];
+      for (unsigned int j = tri_row_buffer[row]; j < tri_row_buffer[row+1]; ++j, ++offset)
+      {
+        schedule.col_buffer[offset] = tri_col_buffer[j];
+        schedule.elements[offset]   = tri_elements[j];
+      }
+      schedule.row_buffer[i+1] = offset;
+      if (diagonal.size() > 0)
+        schedule.diagonal[i] = diagonal[row];
+    }
+  }
+
+  /** @brief Sets up the level schedule for the substitution with the triangular part of a CSR matrix selected by the tag.
+  *
+  * Entries outside of the triangle are ignored, just like in csr_inplace_solve(). Thus, an in-place LU factorization can be passed for both unit_lower_tag and upper_tag.
+  */
+  template<typename NumericT, typename ConstScalarArrayT, typename IndexArrayT, typename TagT>
+  void csr_level_schedule_setup(IndexArrayT const & row_buffer,
+                                IndexArrayT const & col_buffer,
+                                ConstScalarArrayT const & element_buffer,
+                                vcl_size_t num_rows,
+                                csr_level_schedule<NumericT> & schedule,
+                                TagT tag)
+  {
+    bool is_lower = level_schedule_is_lower(tag);
+
+    std::vector<unsigned int> tri_row_buffer(num_rows + 1);
+    std::vector<unsigned int> tri_col_buffer;
+    std::vector<NumericT>     tri_elements;
+    std::vector<NumericT>     diagonal(level_schedule_is_unit(tag) ? 0 : num_rows);
+
+    tri_col_buffer.reserve(row_buffer[num_rows]);
+    tri_elements.reserve(row_buffer[num_rows]);
+    for (vcl_size_t row = 0; row < num_rows; ++row)
+    {
+      tri_row_buffer[row] = static_cast<unsigned int>(tri_col_buffer.size());
+      for (vcl_size_t i = row_buffer[row]; i < row_buffer[row+1]; ++i)
+      {
+        vcl_size_t col = col_buffer[i];
+        if (is_lower ? (col < row) : (col > row))
+        {
+          tri_col_buffer.push_back(static_cast<unsigned int>(col));
+          tri_elements.push_back(element_buffer[i]);
+        }
+        else if (col == row && diagonal.size() > 0)
+          diagonal[row] = element_buffer[i];
+      }
+    }
+    tri_row_buffer[num_rows] = static_cast<unsigned int>(tri_col_buffer.size());
+
+    csr_level_schedule_init(tri_row_buffer, tri_col_buffer, tri_elements, diagonal, is_lower, schedule);
+  }
+
+  /** @brief Sets up the level schedule for the substitution with the transpose of a CSR matrix, i.e. the counterpart of csr_trans_inplace_solve().
+  *
+  * The transposed triangle is assembled explicitly, so that the substitution can be carried out row-wise and in parallel within each level.
+  */
+  template<typename NumericT, typename ConstScalarArrayT, typename IndexArrayT, typename TagT>
+  void csr_trans_level_schedule_setup(IndexArrayT const & row_buffer,
+                                      IndexArrayT const & col_buffer,
+                                      ConstScalarArrayT const & element_buffer,
+                                      vcl_size_t num_rows,
+                                      csr_level_schedule<NumericT> & schedule,
+                                      TagT tag)
+  {
+    bool is_lower = level_schedule_is_lower(tag);
+
+    std::vector<unsigned int> tri_row_buffer(num_rows + 1, 0);
+    std::vector<NumericT>     diagonal(level_schedule_is_unit(tag) ? 0 : num_rows);
+
+    // count entries per row of the transposed triangle:
+    for (vcl_size_t row = 0; row < num_rows; ++row)
+      for (vcl_size_t i = row_buffer[row]; i < row_buffer[row+1]; ++i)
+      {
+        vcl_size_t col = col_buffer[i];
+        if (is_lower ? (col > row) : (col < row))
+          tri_row_buffer[col + 1] += 1;
+        else if (col == row && diagonal.size() > 0)
+          diagonal[row] = element_buffer[i];
+      }
+    for (vcl_size_t row = 0; row < num_rows; ++row)
+      tri_row_buffer[row+1] += tri_row_buffer[row];
+
+    // scatter (columns of the transposed rows end up sorted):
+    std::vector<unsigned int> tri_col_buffer(tri_row_buffer[num_rows]);
+    std::vector<NumericT>     tri_elements(tri_row_buffer[num_rows]);
+    std::vector<unsigned int> row_fill(tri_row_buffer.begin(), tri_row_buffer.end() - 1);
+    for (vcl_size_t row = 0; row < num_rows; ++row)
+      for (vcl_size_t i = row_buffer[row]; i < row_buffer[row+1]; ++i)
+      {
+        vcl_size_t col = col_buffer[i];
+        if (is_lower ? (col > row) : (col < row))
+        {
+          unsigned int offset = row_fill[col]++;
+          tri_col_buffer[offset] = static_cast<unsigned int>(row);
+          tri_elements[offset]   = element_buffer[i];
+        }
+      }
+
+    csr_level_schedule_init(tri_row_buffer, tri_col_buffer, tri_elements, diagonal, is_lower, schedule);
+  }
+
+  /** @brief Inplace triangular substitution using a precomputed level schedule.
+  *
+  * Levels are processed one after another, the rows within a level are distributed over the OpenMP threads.
+  * If the levels are too narrow to amortize the synchronization after each level, the substitution runs on a single thread.
+  */
+  template<typename NumericT, typename ScalarArrayT>
+  void csr_level_scheduled_solve(csr_level_schedule<NumericT> const & schedule,
+                                 ScalarArrayT & vec_buffer)
+  {
+    if (schedule.size() == 0 || schedule.row_buffer.size() == 0)
+      return;
+
+    unsigned int const * level_offsets = &(schedule.level_offsets[0]);
+    unsigned int const * row_indices   = &(schedule.row_indices[0]);
+    unsigned int const * row_buffer    = &(schedule.row_buffer[0]);
+    unsigned int const * col_buffer    = schedule.col_buffer.size()    > 0 ? &(schedule.col_buffer[0])    : NULL;
+    NumericT     const * elements      = schedule.elements.size()      > 0 ? &(schedule.elements[0])      : NULL;
+    NumericT     const * diagonal      = schedule.diagonal.size()      > 0 ? &(schedule.diagonal[0])      : NULL;
+    vcl_size_t num_levels = schedule.levels();
+
+#ifdef VIENNACL_WITH_OPENMP
+    bool run_parallel = schedule.size() > VIENNACL_OPENMP_VECTOR_MIN_SIZE && schedule.size() > VIENNACL_OPENMP_LEVEL_SCHEDULE_MIN_LEVEL_SIZE * num_levels;
+    #pragma omp parallel if (run_parallel)
+#endif
+    for (vcl_size_t k = 0; k < num_levels; ++k)
+    {
+      long level_begin = static_cast<long>(level_offsets[k]);
+      long level_end   = static_cast<long>(level_offsets[k+1]);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for
+#endif
+      for (long i = level_begin; i < level_end; ++i)
+      {
+        unsigned int row = row_indices[i];
+        NumericT vec_entry = vec_buffer[row];
+        for (unsigned int j = row_buffer[i]; j < row_buffer[i+1]; ++j)
+          vec_entry -= vec_buffer[col_buffer[j]] * elements[j];
+        vec_buffer[row] = diagonal ? vec_entry / diagonal[i] : vec_entry;
+      }
+    }
+  }
+
+  /** @brief Approximate triangular substitution by Jacobi sweeps using the factor stored in a level schedule.
+  *
+  * Starting from x = D^{-1} b, each sweep computes x <- D^{-1} (b - T x), where T denotes the strictly triangular part.
+  * All rows are updated concurrently. After levels() - 1 sweeps the result is exact, so at most this number of sweeps is carried out.
+  */
+  template<typename NumericT, typename ScalarArrayT>
+  void csr_jacobi_scheduled_solve(csr_level_schedule<NumericT> const & schedule,
+                                  ScalarArrayT & vec_buffer,
+                                  vcl_size_t sweeps)
+  {
+    long size = static_cast<long>(schedule.size());
+    if (size == 0 || schedule.row_buffer.size() == 0)
+      return;
+
+    unsigned int const * row_indices = &(schedule.row_indices[0]);
+    unsigned int const * row_buffer  = &(schedule.row_buffer[0]);
+    unsigned int const * col_buffer  = schedule.col_buffer.size() > 0 ? &(schedule.col_buffer[0]) : NULL;
+    NumericT     const * elements    = schedule.elements.size()   > 0 ? &(schedule.elements[0])   : NULL;
+    NumericT     const * diagonal    = schedule.diagonal.size()   > 0 ? &(schedule.diagonal[0])   : NULL;
+
+    std::vector<NumericT> rhs(static_cast<vcl_size_t>(size));
+    std::vector<NumericT> x(static_cast<vcl_size_t>(size));
+    std::vector<NumericT> x_new(static_cast<vcl_size_t>(size));
+    for (long row = 0; row < size; ++row)
+      rhs[static_cast<vcl_size_t>(row)] = vec_buffer[row];
+
+    // initial guess x = D^{-1} b (schedule positions i refer to the level-ordered rows):
+    for (long i = 0; i < size; ++i)
+    {
+      unsigned int row = row_indices[i];
+      x[row] = diagonal ? rhs[row] / diagonal[i] : rhs[row];
+    }
+
+    sweeps = std::min<vcl_size_t>(sweeps, schedule.levels() - 1);
+    for (vcl_size_t sweep = 0; sweep < sweeps; ++sweep)
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+      for (long i = 0; i < size; ++i)
+      {
+        unsigned int row = row_indices[i];
+        NumericT vec_entry = rhs[row];
+        for (unsigned int j = row_buffer[i]; j < row_buffer[i+1]; ++j)
+          vec_entry -= x[col_buffer[j]] * elements[j];
+        x_new[row] = diagonal ? vec_entry / diagonal[i] : vec_entry;
+      }
+      x.swap(x_new);
+    }
+
+    for (long row = 0; row < size; ++row)
+      vec_buffer[row] = x[static_cast<vcl_size_t>(row)];
+  }
+
+} //namespace detail
+
+
 //
 // Compressed Compressed Matrix
 //
@@ -964,6 +1496,89 @@ namespace detail
 
     result_buf[last_row] = value;
   }
+
+  /** @brief Returns the number of equally sized nonzero chunks a coordinate_matrix product is split into (one per thread). */
+  inline vcl_size_t coo_num_chunks(vcl_size_t nnz)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    if (nnz > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+      return std::min<vcl_size_t>(static_cast<vcl_size_t>(omp_get_max_threads()), nnz);
+#endif
+    (void)nnz;
+    return 1;
+  }
+
+  /** @brief Computes C = A * B for a coordinate_matrix A and a dense matrix B accessed through wrappers.
+    *
+    * Relies on the nonzeros in handle12() being sorted by row. The nonzeros are split into equally sized chunks.
+    * Rows strictly inside a chunk are owned by that chunk and updated in place, while the first and the last row of a chunk
+    * may be shared with the neighboring chunks. These are accumulated in thread-private partial rows and merged afterwards.
+    */
+  template<typename NumericT, typename DenseWrapperT, typename ResultWrapperT>
+  void coo_prod_dense(NumericT const * elements, unsigned int const * coords, vcl_size_t nnz,
+                      vcl_size_t size1, vcl_size_t size2,
+                      DenseWrapperT B, ResultWrapperT C)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if ((size1 * size2) > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    for (long row = 0; row < static_cast<long>(size1); ++row)
+      for (vcl_size_t col = 0; col < size2; ++col)
+        C(row, col) = NumericT(0);
+
+    if (nnz == 0 || size2 == 0)
+      return;
+
+    vcl_size_t num_chunks = coo_num_chunks(nnz);
+    std::vector<NumericT> partial_rows(2 * num_chunks * size2);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long chunk = 0; chunk < static_cast<long>(num_chunks); ++chunk)
+    {
+      vcl_size_t begin = (nnz *  static_cast<vcl_size_t>(chunk))      / num_chunks;
+      vcl_size_t end   = (nnz * (static_cast<vcl_size_t>(chunk) + 1)) / num_chunks;
+
+      unsigned int first_row = coords[2*begin];
+      unsigned int last_row  = coords[2*(end-1)];
+      NumericT * partial_first = &partial_rows[(2 * static_cast<vcl_size_t>(chunk)    ) * size2];
+      NumericT * partial_last  = &partial_rows[(2 * static_cast<vcl_size_t>(chunk) + 1) * size2];
+
+      for (vcl_size_t i = begin; i < end; ++i)
+      {
+        NumericT x = elements[i];
+        vcl_size_t r = coords[2*i];
+        vcl_size_t c = coords[2*i+1];
+
+        if (r == first_row)
+          for (vcl_size_t col = 0; col < size2; ++col)
+            partial_first[col] += x * B(c, col);
+        else if (r == last_row)
+          for (vcl_size_t col = 0; col < size2; ++col)
+            partial_last[col] += x * B(c, col);
+        else
+          for (vcl_size_t col = 0; col < size2; ++col)
+            C(r, col) += x * B(c, col);
+      }
+    }
+
+    // merge the partial rows at the chunk boundaries:
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if ((num_chunks * size2) > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    for (long col = 0; col < static_cast<long>(size2); ++col)
+    {
+      for (vcl_size_t chunk = 0; chunk < num_chunks; ++chunk)
+      {
+        vcl_size_t begin = (nnz *  chunk     ) / num_chunks;
+        vcl_size_t end   = (nnz * (chunk + 1)) / num_chunks;
+
+        C(static_cast<vcl_size_t>(coords[2*begin]),   col) += partial_rows[(2 * chunk    ) * size2 + static_cast<vcl_size_t>(col)];
+        C(static_cast<vcl_size_t>(coords[2*(end-1)]), col) += partial_rows[(2 * chunk + 1) * size2 + static_cast<vcl_size_t>(col)];
+      }
+    }
+  }
 }
 
 /** @brief Carries out matrix-vector multiplication with a coordinate_matrix
@@ -984,12 +1599,72 @@ void prod_impl(const viennacl::coordinate_matrix<NumericT, AlignmentV> & mat,
   NumericT     const * elements     = detail::extract_raw_pointer<NumericT>(mat.handle());
   unsigned int const * coord_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle12());
 
-  for (vcl_size_t i = 0; i< result.size(); ++i)
-    result_buf[i * result.stride() + result.start()] = 0;
+  vcl_size_t result_start = result.start();
+  vcl_size_t result_inc   = result.stride();
+  vcl_size_t vec_start    = vec.start();
+  vcl_size_t vec_inc      = vec.stride();
+  vcl_size_t nnz          = mat.nnz();
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (result.size() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long i = 0; i < static_cast<long>(result.size()); ++i)
+    result_buf[static_cast<vcl_size_t>(i) * result_inc + result_start] = 0;
+
+  vcl_size_t num_chunks = detail::coo_num_chunks(nnz);
+  if (num_chunks < 2)
+  {
+    for (vcl_size_t i = 0; i < nnz; ++i)
+      result_buf[coord_buffer[2*i] * result_inc + result_start]
+        += elements[i] * vec_buf[coord_buffer[2*i+1] * vec_inc + vec_start];
+    return;
+  }
+
+  // Segmented reduction over equally sized nonzero chunks, exploiting that the entries in handle12() are sorted by row:
+  // Rows strictly inside a chunk are owned by the chunk, the first and the last row are carried out and merged afterwards.
+  std::vector<NumericT>     first_carries(num_chunks);
+  std::vector<NumericT>     last_carries(num_chunks);
+  std::vector<unsigned int> last_rows(num_chunks);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long chunk = 0; chunk < static_cast<long>(num_chunks); ++chunk)
+  {
+    vcl_size_t begin = (nnz *  static_cast<vcl_size_t>(chunk))      / num_chunks;
+    vcl_size_t end   = (nnz * (static_cast<vcl_size_t>(chunk) + 1)) / num_chunks;
+
+    unsigned int first_row = coord_buffer[2*begin];
+    unsigned int row = first_row;
+    NumericT sum = 0;
+
+    for (vcl_size_t i = begin; i < end; ++i)
+    {
+      unsigned int current_row = coord_buffer[2*i];
+      if (current_row != row)
+      {
+        if (row == first_row)
+          first_carries[static_cast<vcl_size_t>(chunk)] = sum;
+        else
+          result_buf[row * result_inc + result_start] = sum;
+        sum = 0;
+        row = current_row;
+      }
+      sum += elements[i] * vec_buf[coord_buffer[2*i+1] * vec_inc + vec_start];
+    }
+
+    if (row == first_row)
+      first_carries[static_cast<vcl_size_t>(chunk)] = sum;
+    else
+      last_carries[static_cast<vcl_size_t>(chunk)] = sum;
+    last_rows[static_cast<vcl_size_t>(chunk)] = row;
+  }
 
-  for (vcl_size_t i = 0; i < mat.nnz(); ++i)
-    result_buf[coord_buffer[2*i] * result.stride() + result.start()]
-      += elements[i] * vec_buf[coord_buffer[2*i+1] * vec.stride() + vec.start()];
+  for (vcl_size_t chunk = 0; chunk < num_chunks; ++chunk)
+  {
+    result_buf[coord_buffer[2 * ((nnz * chunk) / num_chunks)] * result_inc + result_start] += first_carries[chunk];
+    result_buf[last_rows[chunk]                                * result_inc + result_start] += last_carries[chunk];
+  }
 }
 
 /** @brief Carries out Compressed Matrix(COO)-Dense Matrix multiplication
@@ -1037,34 +1712,10 @@ void prod_impl(const viennacl::coordinate_matrix<NumericT, AlignmentV> & sp_mat,
 
   if ( d_mat.row_major() ) {
 
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-    for (long row = 0; row < static_cast<long>(sp_mat.size1()); ++row)
-    {
-      if (result.row_major())
-        for (vcl_size_t col = 0; col < d_mat.size2(); ++col)
-          result_wrapper_row(row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-      else
-        for (vcl_size_t col = 0; col < d_mat.size2(); ++col)
-          result_wrapper_col(row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-    }
-
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-    for (long i = 0; i < static_cast<long>(sp_mat.nnz()); ++i) {
-      NumericT x = static_cast<NumericT>(sp_mat_elements[i]);
-      vcl_size_t r = static_cast<vcl_size_t>(sp_mat_coords[2*i]);
-      vcl_size_t c = static_cast<vcl_size_t>(sp_mat_coords[2*i+1]);
-      for (vcl_size_t col = 0; col < d_mat.size2(); ++col) {
-        NumericT y = d_mat_wrapper_row( c, col);
-        if (result.row_major())
-          result_wrapper_row(r, col) += x * y;
-        else
-          result_wrapper_col(r, col) += x * y;
-      }
-    }
+    if (result.row_major())
+      detail::coo_prod_dense(sp_mat_elements, sp_mat_coords, sp_mat.nnz(), sp_mat.size1(), d_mat.size2(), d_mat_wrapper_row, result_wrapper_row);
+    else
+      detail::coo_prod_dense(sp_mat_elements, sp_mat_coords, sp_mat.nnz(), sp_mat.size1(), d_mat.size2(), d_mat_wrapper_row, result_wrapper_col);
   }
 
   else {
@@ -1141,9 +1792,9 @@ void prod_impl(const viennacl::coordinate_matrix<NumericT, AlignmentV> & sp_mat,
   vcl_size_t result_internal_size1  = viennacl::traits::internal_size1(result);
   vcl_size_t result_internal_size2  = viennacl::traits::internal_size2(result);
 
-  detail::matrix_array_wrapper<NumericT const, row_major, false>
+  detail::matrix_array_wrapper<NumericT const, row_major, true>
       d_mat_wrapper_row(d_mat_data, d_mat_start1, d_mat_start2, d_mat_inc1, d_mat_inc2, d_mat_internal_size1, d_mat_internal_size2);
-  detail::matrix_array_wrapper<NumericT const, column_major, false>
+  detail::matrix_array_wrapper<NumericT const, column_major, true>
       d_mat_wrapper_col(d_mat_data, d_mat_start1, d_mat_start2, d_mat_inc1, d_mat_inc2, d_mat_internal_size1, d_mat_internal_size2);
 
   detail::matrix_array_wrapper<NumericT, row_major, false>
@@ -1153,81 +1804,17 @@ void prod_impl(const viennacl::coordinate_matrix<NumericT, AlignmentV> & sp_mat,
 
   if ( d_mat.lhs().row_major() )
   {
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-    for (long row = 0; row < static_cast<long>(sp_mat.size1()); ++row)
-    {
-      if (result.row_major())
-        for (vcl_size_t col = 0; col < d_mat.size2(); ++col)
-          result_wrapper_row( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-      else
-        for (vcl_size_t col = 0; col < d_mat.size2(); ++col)
-          result_wrapper_col( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-    }
-
-#ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for
-#endif
-    for (long i = 0; i < static_cast<long>(sp_mat.nnz()); ++i) {
-      NumericT x = static_cast<NumericT>(sp_mat_elements[i]);
-      vcl_size_t r = static_cast<vcl_size_t>(sp_mat_coords[2*i]);
-      vcl_size_t c = static_cast<vcl_size_t>(sp_mat_coords[2*i+1]);
-      if (result.row_major())
-      {
-        for (vcl_size_t col = 0; col < d_mat.size2(); ++col) {
-          NumericT y = d_mat_wrapper_row( col, c);
-          result_wrapper_row(r, col) += x * y;
-        }
-      }
-      else
-      {
-        for (vcl_size_t col = 0; col < d_mat.size2(); ++col) {
-          NumericT y = d_mat_wrapper_row( col, c);
-          result_wrapper_col(r, col) += x * y;
-        }
-      }
-    }
-
-
+    if (result.row_major())
+      detail::coo_prod_dense(sp_mat_elements, sp_mat_coords, sp_mat.nnz(), sp_mat.size1(), d_mat.size2(), d_mat_wrapper_row, result_wrapper_row);
+    else
+      detail::coo_prod_dense(sp_mat_elements, sp_mat_coords, sp_mat.nnz(), sp_mat.size1(), d_mat.size2(), d_mat_wrapper_row, result_wrapper_col);
   }
   else
   {
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-    for (long col = 0; col < static_cast<long>(d_mat.size2()); ++col)
-    {
-      if (result.row_major())
-        for (vcl_size_t row = 0; row < sp_mat.size1(); ++row)
-          result_wrapper_row( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-      else
-        for (vcl_size_t row = 0; row < sp_mat.size1(); ++row)
-          result_wrapper_col( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-    }
-
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-    for (long i = 0; i < static_cast<long>(sp_mat.nnz()); ++i) {
-      NumericT x = static_cast<NumericT>(sp_mat_elements[i]);
-      vcl_size_t r = static_cast<vcl_size_t>(sp_mat_coords[2*i]);
-      vcl_size_t c = static_cast<vcl_size_t>(sp_mat_coords[2*i+1]);
-      if (result.row_major())
-      {
-        for (vcl_size_t col = 0; col < d_mat.size2(); ++col) {
-          NumericT y = d_mat_wrapper_col( col, c);
-          result_wrapper_row(r, col) += x * y;
-        }
-      }
-      else
-      {
-        for (vcl_size_t col = 0; col < d_mat.size2(); ++col) {
-          NumericT y = d_mat_wrapper_col( col, c);
-          result_wrapper_col(r, col) += x * y;
-        }
-      }
-    }
+    if (result.row_major())
+      detail::coo_prod_dense(sp_mat_elements, sp_mat_coords, sp_mat.nnz(), sp_mat.size1(), d_mat.size2(), d_mat_wrapper_col, result_wrapper_row);
+    else
+      detail::coo_prod_dense(sp_mat_elements, sp_mat_coords, sp_mat.nnz(), sp_mat.size1(), d_mat.size2(), d_mat_wrapper_col, result_wrapper_col);
   }
 
 }
@@ -1538,40 +2125,36 @@ void prod_impl(const viennacl::sliced_ell_matrix<NumericT, IndexT> & mat,
   IndexT   const * columns_per_block = detail::extract_raw_pointer<IndexT>(mat.handle1());
   IndexT   const * column_indices    = detail::extract_raw_pointer<IndexT>(mat.handle2());
   IndexT   const * block_start       = detail::extract_raw_pointer<IndexT>(mat.handle3());
+  IndexT   const * row_indices       = detail::extract_raw_pointer<IndexT>(mat.handle4());
 
-  vcl_size_t num_blocks = mat.size1() / mat.rows_per_block() + 1;
-  std::vector<NumericT> result_values(mat.rows_per_block());
+  vcl_size_t rows_per_block = mat.rows_per_block();
+  vcl_size_t num_blocks     = mat.size1() / rows_per_block + 1;
+  NumericT const * x        = vec_buf + vec.start();
 
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
+  #pragma omp parallel if (mat.size1() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
 #endif
-  for (vcl_size_t block_idx = 0; block_idx < num_blocks; ++block_idx)
   {
-    vcl_size_t current_columns_per_block = columns_per_block[block_idx];
-
-    for (vcl_size_t i=0; i<result_values.size(); ++i)
-      result_values[i] = 0;
-
-    for (IndexT column_entry_index = 0;
-                column_entry_index < current_columns_per_block;
-              ++column_entry_index)
-    {
-      vcl_size_t stride_start = block_start[block_idx] + column_entry_index * mat.rows_per_block();
-      // Note: This for-loop may be unrolled by hand for exploiting vectorization
-      //       Careful benchmarking recommended first, memory channels may be saturated already!
-      for (IndexT row_in_block = 0; row_in_block < mat.rows_per_block(); ++row_in_block)
-      {
-        NumericT val = elements[stride_start + row_in_block];
+    std::vector<NumericT> result_values(rows_per_block);
 
-        result_values[row_in_block] += val ? vec_buf[column_indices[stride_start + row_in_block] * vec.stride() + vec.start()] * val : 0;
-      }
-    }
-
-    vcl_size_t first_row_in_matrix = block_idx * mat.rows_per_block();
-    for (IndexT row_in_block = 0; row_in_block < mat.rows_per_block(); ++row_in_block)
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for
+#endif
+    for (long block_idx = 0; block_idx < static_cast<long>(num_blocks); ++block_idx)
     {
-      if (first_row_in_matrix + row_in_block < result.size())
-        result_buf[(first_row_in_matrix + row_in_block) * result.stride() + result.start()] = result_values[row_in_block];
+      vcl_size_t current_columns_per_block = columns_per_block[block_idx];
+      vcl_size_t offset = current_columns_per_block > 0 ? block_start[block_idx] : 0;
+
+      detail::sliced_ell_slice_kernel<NumericT, IndexT>::apply(elements + offset, column_indices + offset,
+                                                               current_columns_per_block, rows_per_block,
+                                                               x, vec.stride(), vec.size(),
+                                                               &(result_values[0]));
+
+      // rows may be permuted within sigma-windows, hence scatter via the row indices:
+      vcl_size_t first_row_in_block = static_cast<vcl_size_t>(block_idx) * rows_per_block;
+      vcl_size_t rows_in_block      = std::min(rows_per_block, mat.size1() - std::min(first_row_in_block, mat.size1()));
+      for (vcl_size_t row_in_block = 0; row_in_block < rows_in_block; ++row_in_block)
+        result_buf[row_indices[first_row_in_block + row_in_block] * result.stride() + result.start()] = result_values[row_in_block];
     }
   }
 }
@@ -0,0 +1,222 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_TRANSPOSE_KERNELS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_TRANSPOSE_KERNELS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/transpose_kernels.hpp
+*   @brief Register-blocked micro-kernels and cache-sized tiles for transposing dense matrices on the CPU.
+*
+*   As for the matrix-matrix product, the SIMD micro-kernels are selected at compile time from the instruction set the code is compiled for (AVX or SSE2 on x86-64).
+*   Other architectures and numeric types fall back to a generic kernel.
+*/
+
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+
+#if defined(__AVX512F__) || defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+
+/** @brief Number of rows and columns of the tiles processed at once. Source and destination tile should fit into the L1 cache. */
+static const vcl_size_t transpose_tile_size = 32;
+
+/** @brief Number of rows and columns of the blocks collected in a buffer by the out-of-place transposition, such that full cache lines of the destination are written. */
+static const vcl_size_t transpose_block_size = 128;
+
+/** @brief Transposes a square block of size x size entries held in registers: dst[j * dst_inc + i] = src[i * src_inc + j].
+  *
+  * Generic implementation for all numeric types and architectures without a SIMD specialization.
+  */
+template<typename NumericT>
+struct transpose_micro_kernel
+{
+  static const vcl_size_t size = 4;
+
+  static void apply(NumericT const * src, vcl_size_t src_inc, NumericT * dst, vcl_size_t dst_inc)
+  {
+    NumericT reg[size * size];
+    for (vcl_size_t i = 0; i < size; ++i)
+      for (vcl_size_t j = 0; j < size; ++j)
+        reg[j * size + i] = src[i * src_inc + j];
+
+    for (vcl_size_t j = 0; j < size; ++j)
+      for (vcl_size_t i = 0; i < size; ++i)
+        dst[j * dst_inc + i] = reg[j * size + i];
+  }
+};
+
+/** \cond */
+#if defined(__AVX512F__) || defined(__AVX__)
+
+template<>
+struct transpose_micro_kernel<double>
+{
+  static const vcl_size_t size = 4;
+
+  static void apply(double const * src, vcl_size_t src_inc, double * dst, vcl_size_t dst_inc)
+  {
+    __m256d r0 = _mm256_loadu_pd(src);
+    __m256d r1 = _mm256_loadu_pd(src +     src_inc);
+    __m256d r2 = _mm256_loadu_pd(src + 2 * src_inc);
+    __m256d r3 = _mm256_loadu_pd(src + 3 * src_inc);
+
+    __m256d t0 = _mm256_unpacklo_pd(r0, r1);  // r0[0] r1[0] r0[2] r1[2]
+    __m256d t1 = _mm256_unpackhi_pd(r0, r1);  // r0[1] r1[1] r0[3] r1[3]
+    __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+    __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+    _mm256_storeu_pd(dst,               _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_storeu_pd(dst +     dst_inc, _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_storeu_pd(dst + 2 * dst_inc, _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_storeu_pd(dst + 3 * dst_inc, _mm256_permute2f128_pd(t1, t3, 0x31));
+  }
+};
+
+template<>
+struct transpose_micro_kernel<float>
+{
+  static const vcl_size_t size = 8;
+
+  static void apply(float const * src, vcl_size_t src_inc, float * dst, vcl_size_t dst_inc)
+  {
+    __m256 r0 = _mm256_loadu_ps(src);
+    __m256 r1 = _mm256_loadu_ps(src +     src_inc);
+    __m256 r2 = _mm256_loadu_ps(src + 2 * src_inc);
+    __m256 r3 = _mm256_loadu_ps(src + 3 * src_inc);
+    __m256 r4 = _mm256_loadu_ps(src + 4 * src_inc);
+    __m256 r5 = _mm256_loadu_ps(src + 5 * src_inc);
+    __m256 r6 = _mm256_loadu_ps(src + 6 * src_inc);
+    __m256 r7 = _mm256_loadu_ps(src + 7 * src_inc);
+
+    __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+    __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+    __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+    __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+    r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    r4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    r5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    r6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    r7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    _mm256_storeu_ps(dst,               _mm256_permute2f128_ps(r0, r4, 0x20));
+    _mm256_storeu_ps(dst +     dst_inc, _mm256_permute2f128_ps(r1, r5, 0x20));
+    _mm256_storeu_ps(dst + 2 * dst_inc, _mm256_permute2f128_ps(r2, r6, 0x20));
+    _mm256_storeu_ps(dst + 3 * dst_inc, _mm256_permute2f128_ps(r3, r7, 0x20));
+    _mm256_storeu_ps(dst + 4 * dst_inc, _mm256_permute2f128_ps(r0, r4, 0x31));
+    _mm256_storeu_ps(dst + 5 * dst_inc, _mm256_permute2f128_ps(r1, r5, 0x31));
+    _mm256_storeu_ps(dst + 6 * dst_inc, _mm256_permute2f128_ps(r2, r6, 0x31));
+    _mm256_storeu_ps(dst + 7 * dst_inc, _mm256_permute2f128_ps(r3, r7, 0x31));
+  }
+};
+
+#elif defined(__SSE2__)
+
+template<>
+struct transpose_micro_kernel<double>
+{
+  static const vcl_size_t size = 2;
+
+  static void apply(double const * src, vcl_size_t src_inc, double * dst, vcl_size_t dst_inc)
+  {
+    __m128d r0 = _mm_loadu_pd(src);
+    __m128d r1 = _mm_loadu_pd(src + src_inc);
+
+    _mm_storeu_pd(dst,           _mm_unpacklo_pd(r0, r1));
+    _mm_storeu_pd(dst + dst_inc, _mm_unpackhi_pd(r0, r1));
+  }
+};
+
+template<>
+struct transpose_micro_kernel<float>
+{
+  static const vcl_size_t size = 4;
+
+  static void apply(float const * src, vcl_size_t src_inc, float * dst, vcl_size_t dst_inc)
+  {
+    __m128 r0 = _mm_loadu_ps(src);
+    __m128 r1 = _mm_loadu_ps(src +     src_inc);
+    __m128 r2 = _mm_loadu_ps(src + 2 * src_inc);
+    __m128 r3 = _mm_loadu_ps(src + 3 * src_inc);
+
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    _mm_storeu_ps(dst,               r0);
+    _mm_storeu_ps(dst +     dst_inc, r1);
+    _mm_storeu_ps(dst + 2 * dst_inc, r2);
+    _mm_storeu_ps(dst + 3 * dst_inc, r3);
+  }
+};
+
+#endif
+/** \endcond */
+
+
+/** @brief Transposes a tile of rows x cols entries: dst[j * dst_inc + i] = src[i * src_inc + j].
+  *
+  * Full square blocks are transposed by the micro-kernel, the remaining rows and columns entry by entry.
+  */
+template<typename NumericT>
+void transpose_tile(NumericT const * src, vcl_size_t src_inc, NumericT * dst, vcl_size_t dst_inc, vcl_size_t rows, vcl_size_t cols)
+{
+  const vcl_size_t MK = transpose_micro_kernel<NumericT>::size;
+
+  vcl_size_t rows_full = rows / MK * MK;
+  vcl_size_t cols_full = cols / MK * MK;
+
+  for (vcl_size_t i = 0; i < rows_full; i += MK)
+  {
+    for (vcl_size_t j = 0; j < cols_full; j += MK)
+      transpose_micro_kernel<NumericT>::apply(src + i * src_inc + j, src_inc, dst + j * dst_inc + i, dst_inc);
+
+    for (vcl_size_t j = cols_full; j < cols; ++j)
+      for (vcl_size_t i2 = i; i2 < i + MK; ++i2)
+        dst[j * dst_inc + i2] = src[i2 * src_inc + j];
+  }
+
+  for (vcl_size_t i = rows_full; i < rows; ++i)
+    for (vcl_size_t j = 0; j < cols; ++j)
+      dst[j * dst_inc + i] = src[i * src_inc + j];
+}
+
+} //namespace detail
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
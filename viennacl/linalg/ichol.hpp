@@ -23,6 +23,7 @@
 */
 
 #include <vector>
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include "viennacl/forwards.h"
@@ -30,6 +31,7 @@
 #include "viennacl/compressed_matrix.hpp"
 
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/sparse_matrix_operations.hpp"
 
 #include <map>
 
@@ -39,8 +41,132 @@ namespace linalg
 {
 
 /** @brief A tag for incomplete Cholesky factorization with static pattern (ILU0)
+*
+* If fixed_point_sweeps() is nonzero, the factor is computed by the given number of fixed-point sweeps updating all nonzeros in parallel (Chow and Patel, 2015)
+* instead of the sequential elimination. If jacobi_sweeps() is nonzero, the triangular factors are applied approximately by the given number of Jacobi sweeps.
 */
-class ichol0_tag {};
+class ichol0_tag
+{
+public:
+  ichol0_tag(vcl_size_t num_fixed_point_sweeps = 0,
+             vcl_size_t num_jacobi_sweeps = 0) : fixed_point_sweeps_(num_fixed_point_sweeps), jacobi_sweeps_(num_jacobi_sweeps) {}
+
+  /** @brief Number of fixed-point sweeps for computing the factor. Zero selects the sequential factorization. */
+  vcl_size_t fixed_point_sweeps() const { return fixed_point_sweeps_; }
+  void fixed_point_sweeps(vcl_size_t num) { fixed_point_sweeps_ = num; }
+
+  /** @brief Number of Jacobi sweeps for applying each triangular factor. Zero selects exact substitutions. */
+  vcl_size_t jacobi_sweeps() const { return jacobi_sweeps_; }
+  void jacobi_sweeps(vcl_size_t num) { jacobi_sweeps_ = num; }
+
+private:
+  vcl_size_t fixed_point_sweeps_;
+  vcl_size_t jacobi_sweeps_;
+};
+
+
+namespace detail
+{
+  /** @brief Computes the incomplete Cholesky factor A = R^T R by fixed-point sweeps (Chow-Patel) in which all nonzeros are updated concurrently.
+  *
+  * R is stored in the upper triangular part of A, just like for the sequential factorization. For each nonzero (i,j), j >= i, a sweep evaluates
+  *   r_ii = sqrt(a_ii - sum_{k<i} r_ki^2),   r_ij = (a_ij - sum_{k<i} r_ki r_kj) / r_ii
+  * using the values of the previous sweep. The initial guess is r_ij = a_ij / sqrt(a_ii). Column indices within each row need to be sorted.
+  *
+  * @param A       The sparse matrix in main memory
+  * @param sweeps  Number of sweeps
+  */
+  template<typename NumericT>
+  void ichol0_fixed_point(viennacl::compressed_matrix<NumericT> & A, vcl_size_t sweeps)
+  {
+    NumericT           * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+    unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+    vcl_size_t size = A.size1();
+    vcl_size_t nnz  = row_buffer[size];
+
+    std::vector<NumericT> A_values(elements, elements + nnz);
+    A_values.push_back(0); // dummy entry for a missing diagonal
+
+    // locate diagonal entries and set up the column-wise access to R (rows within each column sorted ascendingly):
+    std::vector<unsigned int> diag_index(size, static_cast<unsigned int>(nnz));
+    std::vector<unsigned int> R_col_buffer(size + 1, 0);
+    for (vcl_size_t i = 0; i < size; ++i)
+      for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+      {
+        if (col_buffer[k] == i)
+          diag_index[i] = k;
+        if (col_buffer[k] >= i)
+          R_col_buffer[col_buffer[k] + 1] += 1;
+      }
+    for (vcl_size_t i = 0; i < size; ++i)
+      R_col_buffer[i+1] += R_col_buffer[i];
+
+    std::vector<unsigned int> R_row_indices(R_col_buffer[size]);
+    std::vector<unsigned int> R_entry_index(R_col_buffer[size]);
+    std::vector<unsigned int> R_col_fill(R_col_buffer.begin(), R_col_buffer.end() - 1);
+    for (vcl_size_t i = 0; i < size; ++i)
+      for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+        if (col_buffer[k] >= i)
+        {
+          unsigned int offset = R_col_fill[col_buffer[k]]++;
+          R_row_indices[offset] = static_cast<unsigned int>(i);
+          R_entry_index[offset] = k;
+        }
+
+    // initial guess:
+    for (vcl_size_t i = 0; i < size; ++i)
+    {
+      NumericT sqrt_a_ii = std::sqrt(A_values[diag_index[i]]);
+      for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+        if (col_buffer[k] >= i)
+          elements[k] = (col_buffer[k] == i) ? sqrt_a_ii : A_values[k] / sqrt_a_ii;
+    }
+
+    std::vector<NumericT> old_values(nnz + 1, 0);
+    for (vcl_size_t sweep = 0; sweep < sweeps; ++sweep)
+    {
+      std::copy(elements, elements + nnz, old_values.begin());
+      NumericT const * R_old = &(old_values[0]);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (nnz > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+      for (long i2 = 0; i2 < static_cast<long>(size); ++i2)
+      {
+        unsigned int i = static_cast<unsigned int>(i2);
+        for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+        {
+          unsigned int j = col_buffer[k];
+          if (j < i)
+            continue;
+
+          // sparse dot product of columns i and j of R, restricted to rows above i:
+          NumericT value = A_values[k];
+          unsigned int iter_i = R_col_buffer[i];
+          unsigned int iter_j = R_col_buffer[j];
+          while (iter_i < R_col_buffer[i+1] && iter_j < R_col_buffer[j+1])
+          {
+            unsigned int row_i = R_row_indices[iter_i];
+            unsigned int row_j = R_row_indices[iter_j];
+            if (row_i >= i || row_j >= i)
+              break;
+
+            if (row_i < row_j)
+              ++iter_i;
+            else if (row_i > row_j)
+              ++iter_j;
+            else
+              value -= R_old[R_entry_index[iter_i++]] * R_old[R_entry_index[iter_j++]];
+          }
+
+          elements[k] = (j == i) ? std::sqrt(value) : value / R_old[diag_index[i]];
+        }
+      }
+    }
+  }
+}
 
 
 /** @brief Implementation of a ILU-preconditioner with static pattern. Optimized version for CSR matrices.
@@ -49,13 +175,19 @@ class ichol0_tag {};
   *  for one of many descriptions of incomplete Cholesky Factorizations
   *
   *  @param A       The input matrix in CSR format
-  *  // param tag     An ichol0_tag in order to dispatch among several other preconditioners.
+  *  @param tag     An ichol0_tag in order to dispatch among several other preconditioners and to select the fixed-point variant
   */
 template<typename NumericT>
-void precondition(viennacl::compressed_matrix<NumericT> & A, ichol0_tag const & /* tag */)
+void precondition(viennacl::compressed_matrix<NumericT> & A, ichol0_tag const & tag)
 {
   assert( (viennacl::traits::context(A).memory_type() == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ICHOL0") );
 
+  if (tag.fixed_point_sweeps() > 0)
+  {
+    detail::ichol0_fixed_point(A, tag.fixed_point_sweeps());
+    return;
+  }
+
   NumericT           * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
   unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
   unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
@@ -120,6 +252,42 @@ void precondition(viennacl::compressed_matrix<NumericT> & A, ichol0_tag const &
 
 }
 
+namespace detail
+{
+  /** @brief Computes the host level schedules for the substitutions with L and L^T, where L^T is held in the upper triangular part of LLT. */
+  template<typename NumericT>
+  void ichol0_host_schedule_setup(viennacl::compressed_matrix<NumericT> const & LLT,
+                                  viennacl::linalg::host_based::detail::csr_level_schedule<NumericT> & L_schedule,
+                                  viennacl::linalg::host_based::detail::csr_level_schedule<NumericT> & LT_schedule)
+  {
+    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LLT.handle1());
+    unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LLT.handle2());
+    NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(LLT.handle());
+
+    viennacl::linalg::host_based::detail::csr_trans_level_schedule_setup<NumericT>(row_buffer, col_buffer, elements, LLT.size1(), L_schedule, lower_tag());
+    viennacl::linalg::host_based::detail::csr_level_schedule_setup<NumericT>(row_buffer, col_buffer, elements, LLT.size1(), LT_schedule, upper_tag());
+  }
+
+  /** @brief Applies (L L^T)^{-1} to a vector in main memory, either by substitutions or by the given number of Jacobi sweeps per factor. */
+  template<typename NumericT, typename ScalarArrayT>
+  void ichol0_host_schedule_substitute(viennacl::linalg::host_based::detail::csr_level_schedule<NumericT> const & L_schedule,
+                                       viennacl::linalg::host_based::detail::csr_level_schedule<NumericT> const & LT_schedule,
+                                       ScalarArrayT & vec_buffer,
+                                       vcl_size_t jacobi_sweeps)
+  {
+    if (jacobi_sweeps > 0)
+    {
+      viennacl::linalg::host_based::detail::csr_jacobi_scheduled_solve(L_schedule,  vec_buffer, jacobi_sweeps);
+      viennacl::linalg::host_based::detail::csr_jacobi_scheduled_solve(LT_schedule, vec_buffer, jacobi_sweeps);
+    }
+    else
+    {
+      viennacl::linalg::host_based::detail::csr_level_scheduled_solve(L_schedule,  vec_buffer);
+      viennacl::linalg::host_based::detail::csr_level_scheduled_solve(LT_schedule, vec_buffer);
+    }
+  }
+}
+
 
 /** @brief Incomplete Cholesky preconditioner class with static pattern (ICHOL0), can be supplied to solve()-routines
 */
@@ -140,13 +308,9 @@ public:
   template<typename VectorT>
   void apply(VectorT & vec) const
   {
-    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LLT.handle1());
-    unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LLT.handle2());
-    NumericType  const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericType>(LLT.handle());
-
     // Note: L is stored in a column-oriented fashion, i.e. transposed w.r.t. the row-oriented layout. Thus, the factorization A = L L^T holds L in the upper triangular part of A.
-    viennacl::linalg::host_based::detail::csr_trans_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, LLT.size2(), lower_tag());
-    viennacl::linalg::host_based::detail::csr_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, LLT.size2(), upper_tag());
+    //       The substitution with L uses an explicitly transposed copy held in L_schedule_.
+    detail::ichol0_host_schedule_substitute(L_schedule_, LT_schedule_, vec, tag_.jacobi_sweeps());
   }
 
 private:
@@ -157,10 +321,14 @@ private:
 
     viennacl::copy(mat, LLT);
     viennacl::linalg::precondition(LLT, tag_);
+
+    detail::ichol0_host_schedule_setup(LLT, L_schedule_, LT_schedule_);
   }
 
-  ichol0_tag const & tag_;
+  ichol0_tag tag_;
   viennacl::compressed_matrix<NumericType> LLT;
+  viennacl::linalg::host_based::detail::csr_level_schedule<NumericType> L_schedule_;
+  viennacl::linalg::host_based::detail::csr_level_schedule<NumericType> LT_schedule_;
 };
 
 
@@ -190,15 +358,15 @@ public:
       viennacl::context old_ctx = viennacl::traits::context(vec);
 
       viennacl::switch_memory_context(vec, host_ctx);
-      viennacl::linalg::inplace_solve(trans(LLT), vec, lower_tag());
-      viennacl::linalg::inplace_solve(      LLT , vec, upper_tag());
+      NumericT * vec_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec.handle());
+      detail::ichol0_host_schedule_substitute(L_schedule_, LT_schedule_, vec_buffer, tag_.jacobi_sweeps());
       viennacl::switch_memory_context(vec, old_ctx);
     }
     else //apply ILU0 directly:
     {
       // Note: L is stored in a column-oriented fashion, i.e. transposed w.r.t. the row-oriented layout. Thus, the factorization A = L L^T holds L in the upper triangular part of A.
-      viennacl::linalg::inplace_solve(trans(LLT), vec, lower_tag());
-      viennacl::linalg::inplace_solve(      LLT , vec, upper_tag());
+      NumericT * vec_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec.handle());
+      detail::ichol0_host_schedule_substitute(L_schedule_, LT_schedule_, vec_buffer, tag_.jacobi_sweeps());
     }
   }
 
@@ -210,10 +378,14 @@ private:
     LLT = mat;
 
     viennacl::linalg::precondition(LLT, tag_);
+
+    detail::ichol0_host_schedule_setup(LLT, L_schedule_, LT_schedule_);
   }
 
-  ichol0_tag const & tag_;
+  ichol0_tag tag_;
   viennacl::compressed_matrix<NumericT> LLT;
+  viennacl::linalg::host_based::detail::csr_level_schedule<NumericT> L_schedule_;
+  viennacl::linalg::host_based::detail::csr_level_schedule<NumericT> LT_schedule_;
 };
 
 }
@@ -0,0 +1,378 @@
+#ifndef VIENNACL_LINALG_IDRS_HPP_
+#define VIENNACL_LINALG_IDRS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file idrs.hpp
+    @brief The induced dimension reduction method IDR(s) is implemented here
+*/
+
+#include <vector>
+#include <cmath>
+
+#include "viennacl/forwards.h"
+#include "viennacl/linalg/detail/residual_history.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/traits/context.hpp"
+#include "viennacl/linalg/detail/multi_vector.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for the induced dimension reduction method IDR(s). Used for supplying solver parameters and for dispatching the solve() function
+*/
+class idrs_tag : public detail::residual_history_recorder
+{
+public:
+  /** @brief The constructor
+  *
+  * @param tol              Relative tolerance for the residual (solver quits if ||r|| < tol * ||rhs||)
+  * @param max_iters        The maximum number of iterations, i.e. products with the system matrix
+  * @param s                Dimension of the shadow space. Larger values need fewer iterations, but more memory (3s+4 vectors in total) and more vector operations per iteration.
+  */
+  idrs_tag(double tol = 1e-8, vcl_size_t max_iters = 1000, vcl_size_t s = 4)
+    : tol_(tol), iterations_(max_iters), s_(s > 0 ? s : 1) {}
+
+  /** @brief Returns the relative tolerance */
+  double tolerance() const { return tol_; }
+  /** @brief Returns the maximum number of iterations */
+  vcl_size_t max_iterations() const { return iterations_; }
+  /** @brief Returns the dimension of the shadow space */
+  vcl_size_t s() const { return s_; }
+
+  /** @brief Return the number of solver iterations: */
+  vcl_size_t iters() const { return iters_taken_; }
+  void iters(vcl_size_t i) const { iters_taken_ = i; }
+
+  /** @brief Returns the estimated relative error at the end of the solver run */
+  double error() const { return last_error_; }
+  /** @brief Sets the estimated relative error at the end of the solver run */
+  void error(double e) const { last_error_ = e; }
+
+private:
+  double tol_;
+  vcl_size_t iterations_;
+  vcl_size_t s_;
+
+  //return values from solver
+  mutable vcl_size_t iters_taken_;
+  mutable double last_error_;
+};
+
+
+namespace detail
+{
+
+  /** @brief Sets up s orthonormal pseudo-random shadow vectors of the given size (deterministic, so that solver runs are reproducible) */
+  template<typename NumericT>
+  void idrs_shadow_space(vcl_size_t size, vcl_size_t s, std::vector< viennacl::vector<NumericT> > & P, viennacl::context ctx)
+  {
+    std::vector<NumericT> host_P(size * s);
+    unsigned long state = 12345;
+    for (vcl_size_t i = 0; i < host_P.size(); ++i)
+    {
+      state = (1103515245ul * state + 12345ul) % 2147483648ul;
+      host_P[i] = NumericT(state) / NumericT(2147483648.0) - NumericT(0.5);
+    }
+
+    // modified Gram-Schmidt:
+    for (vcl_size_t k = 0; k < s; ++k)
+    {
+      NumericT * p_k = &(host_P[k * size]);
+      for (vcl_size_t j = 0; j < k; ++j)
+      {
+        NumericT const * p_j = &(host_P[j * size]);
+        NumericT alpha = 0;
+        for (vcl_size_t i = 0; i < size; ++i)
+          alpha += p_j[i] * p_k[i];
+        for (vcl_size_t i = 0; i < size; ++i)
+          p_k[i] -= alpha * p_j[i];
+      }
+      NumericT norm = 0;
+      for (vcl_size_t i = 0; i < size; ++i)
+        norm += p_k[i] * p_k[i];
+      norm = std::sqrt(norm);
+      for (vcl_size_t i = 0; i < size; ++i)
+        p_k[i] /= norm;
+    }
+
+    P.resize(s);
+    for (vcl_size_t k = 0; k < s; ++k)
+    {
+      P[k] = viennacl::vector<NumericT>(size, ctx);
+      viennacl::fast_copy(host_P.begin() + static_cast<long>(k * size), host_P.begin() + static_cast<long>((k + 1) * size), P[k].begin());
+    }
+  }
+
+  /** @brief Implementation of the right-preconditioned IDR(s) method with biorthogonalization.
+  *
+  * Follows Algorithm 913 by M. B. van Gijzen and P. Sonneveld, ACM Trans. Math. Softw. 38(1), 2011, including the strategy for maintaining convergence
+  * when computing omega. The s inner products with the shadow space required after each product with the system matrix are computed in a single pass over memory,
+  * the biorthogonalization coefficients are then obtained from these by forward substitution on the host (which is equivalent to the sequential
+  * biorthogonalization in exact arithmetic). Convergence of the recursively updated residual is verified with the true residual.
+  *
+  * @param A              The system matrix
+  * @param rhs            The load vector
+  * @param tag            Solver configuration tag
+  * @param precond        A preconditioner. Precondition operation is done via member function apply()
+  * @param initial_guess  Pointer to the initial guess. A zero initial guess is used if NULL.
+  * @return The result vector
+  */
+  template<typename MatrixT, typename NumericT, typename PreconditionerT>
+  viennacl::vector<NumericT> idrs_solve(MatrixT const & A,
+                                        viennacl::vector<NumericT> const & rhs,
+                                        idrs_tag const & tag,
+                                        PreconditionerT const & precond,
+                                        viennacl::vector<NumericT> const * initial_guess)
+  {
+    vcl_size_t size = rhs.size();
+    vcl_size_t s = tag.s();
+    viennacl::context ctx = viennacl::traits::context(rhs);
+
+    viennacl::vector<NumericT> result = viennacl::zero_vector<NumericT>(size, ctx);
+
+    tag.iters(0);
+    tag.clear_residual_history();
+
+    NumericT norm_rhs = viennacl::linalg::norm_2(rhs);
+    if (norm_rhs <= 0) //solution is zero if RHS norm is zero
+    {
+      tag.error(0);
+      return result;
+    }
+
+    viennacl::vector<NumericT> residual = rhs;
+    if (initial_guess)
+    {
+      result = *initial_guess;
+      residual -= viennacl::linalg::prod(A, result);
+    }
+    NumericT norm_r = viennacl::linalg::norm_2(residual);
+
+    std::vector< viennacl::vector<NumericT> > P;
+    detail::idrs_shadow_space(size, s, P, ctx);
+    viennacl::vector_tuple<NumericT> P_tuple = detail::multi_vector_tuple(P, 0, s);
+
+    std::vector< viennacl::vector<NumericT> > G(s, viennacl::vector<NumericT>(size, ctx));
+    std::vector< viennacl::vector<NumericT> > U(s, viennacl::vector<NumericT>(size, ctx));
+    for (vcl_size_t k = 0; k < s; ++k)
+    {
+      G[k].clear();
+      U[k].clear();
+    }
+    viennacl::vector<NumericT> v(size, ctx);
+    viennacl::vector<NumericT> t(size, ctx);
+    viennacl::vector<NumericT> precond_temp(size, ctx);
+
+    // M = P^T G (lower triangular because of the biorthogonalization), stored row-major:
+    std::vector<NumericT> M(s * s, NumericT(0));
+    for (vcl_size_t i = 0; i < s; ++i)
+      M[i * s + i] = NumericT(1);
+
+    std::vector<NumericT> f(s + 1);
+    std::vector<NumericT> c(s);
+    std::vector<NumericT> d(s + 1);
+    std::vector<NumericT> alpha(s);
+    std::vector<NumericT> single_coeff(1);
+
+    NumericT omega = 1;
+    NumericT const kappa = NumericT(0.7); // threshold for maintaining convergence
+    vcl_size_t iters = 0;
+    bool breakdown = false;
+
+    while (norm_r > tag.tolerance() * norm_rhs && iters < tag.max_iterations() && !breakdown)
+    {
+      // f = P^T r
+      detail::multi_vector_inner_prod(P_tuple, residual, f);
+
+      for (vcl_size_t k = 0; k < s; ++k)
+      {
+        // solve lower triangular system M(k:s, k:s) c = f(k:s)
+        for (vcl_size_t i = k; i < s; ++i)
+        {
+          NumericT value = f[i];
+          for (vcl_size_t j = k; j < i; ++j)
+            value -= M[i * s + j] * c[j - k];
+          c[i - k] = value / M[i * s + i];
+        }
+
+        // v = precond^{-1} (r - G(:, k:s) c)
+        v = residual;
+        detail::multi_vector_update(v, detail::multi_vector_tuple(G, k, s - k), c);
+        precond.apply(v);
+
+        // U(:, k) = omega * v + U(:, k:s) c
+        v *= omega;
+        for (vcl_size_t i = 0; i < s - k; ++i)
+          c[i] = -c[i];
+        detail::multi_vector_update(v, detail::multi_vector_tuple(U, k, s - k), c);
+        U[k] = v;
+
+        // G(:, k) = A U(:, k) and d = P^T G(:, k)
+        G[k] = viennacl::linalg::prod(A, U[k]);
+        ++iters;
+        detail::multi_vector_inner_prod(P_tuple, G[k], d);
+
+        // biorthogonalization: make G(:, k) orthogonal to P(:, 0:k)
+        if (k > 0)
+        {
+          for (vcl_size_t i = 0; i < k; ++i)
+          {
+            NumericT value = d[i];
+            for (vcl_size_t j = 0; j < i; ++j)
+              value -= M[i * s + j] * alpha[j];
+            alpha[i] = value / M[i * s + i];
+          }
+          alpha.resize(k);
+          detail::multi_vector_update(G[k], detail::multi_vector_tuple(G, 0, k), alpha);
+          detail::multi_vector_update(U[k], detail::multi_vector_tuple(U, 0, k), alpha);
+          alpha.resize(s);
+        }
+
+        // M(k:s, k) = P(:, k:s)^T G(:, k)
+        for (vcl_size_t i = k; i < s; ++i)
+        {
+          NumericT value = d[i];
+          for (vcl_size_t j = 0; j < k; ++j)
+            value -= M[i * s + j] * alpha[j];
+          M[i * s + k] = value;
+        }
+
+        if (M[k * s + k] == 0) // breakdown: shadow space is orthogonal to the new vector
+        {
+          breakdown = true;
+          break;
+        }
+
+        // make r orthogonal to P(:, 0:k+1)
+        NumericT beta = f[k] / M[k * s + k];
+        single_coeff[0] = beta;
+        norm_r = std::sqrt(detail::multi_vector_update(residual, detail::multi_vector_tuple(G, k, 1), single_coeff));
+        result += beta * U[k];
+
+        tag.record_residual(norm_r / norm_rhs);
+        if (norm_r <= tag.tolerance() * norm_rhs || iters >= tag.max_iterations())
+          break;
+
+        for (vcl_size_t i = k + 1; i < s; ++i)
+          f[i] -= beta * M[i * s + k];
+      }
+
+      if (iters >= tag.max_iterations() || breakdown)
+        break;
+
+      if (norm_r > tag.tolerance() * norm_rhs)
+      {
+        //
+        // Dimension reduction step: t = A v with v = precond^{-1} r
+        //
+        viennacl::vector<NumericT> const & precond_residual = detail::multi_vector_precond_prod(A, precond, residual, t, precond_temp);
+        ++iters;
+
+        std::vector<viennacl::vector_base<NumericT> const *> r_t(2);
+        r_t[0] = &residual;
+        r_t[1] = &t;
+        detail::multi_vector_inner_prod(viennacl::vector_tuple<NumericT>(r_t), t, d); // d = [(r, t), (t, t)]
+
+        NumericT t_dot_r = d[0];
+        NumericT t_dot_t = d[1];
+        if (t_dot_t <= 0)
+        {
+          breakdown = true;
+          break;
+        }
+
+        omega = t_dot_r / t_dot_t;
+        NumericT rho = std::fabs(t_dot_r) / (std::sqrt(t_dot_t) * norm_r);
+        if (rho < kappa)
+          omega *= kappa / rho;
+        if (omega == 0)
+        {
+          breakdown = true;
+          break;
+        }
+
+        result += omega * precond_residual;
+        single_coeff[0] = omega;
+        std::vector<viennacl::vector_base<NumericT> const *> t_only(1, &t);
+        norm_r = std::sqrt(detail::multi_vector_update(residual, viennacl::vector_tuple<NumericT>(t_only), single_coeff));
+        tag.record_residual(norm_r / norm_rhs);
+      }
+
+      // the recursively updated residual may drift away from the true residual (in particular in single precision). Verify convergence and continue from the true residual if necessary.
+      if (norm_r <= tag.tolerance() * norm_rhs)
+      {
+        residual = rhs;
+        residual -= viennacl::linalg::prod(A, result);
+        norm_r = viennacl::linalg::norm_2(residual);
+      }
+    }
+
+    tag.iters(iters);
+    tag.error(norm_r / norm_rhs);
+
+    return result;
+  }
+
+}
+
+/** @brief Implementation of the preconditioned IDR(s) solver
+*
+* @param A          The system matrix
+* @param rhs        The load vector
+* @param tag        Solver configuration tag
+* @param precond    A preconditioner. Precondition operation is done via member function apply()
+* @return The result vector
+*/
+template<typename MatrixT, typename NumericT, typename PreconditionerT>
+viennacl::vector<NumericT> solve(MatrixT const & A, viennacl::vector<NumericT> const & rhs, idrs_tag const & tag, PreconditionerT const & precond)
+{
+  return detail::idrs_solve(A, rhs, tag, precond, static_cast<viennacl::vector<NumericT> const *>(NULL));
+}
+
+/** @brief Implementation of the IDR(s) solver without preconditioner */
+template<typename MatrixT, typename NumericT>
+viennacl::vector<NumericT> solve(MatrixT const & A, viennacl::vector<NumericT> const & rhs, idrs_tag const & tag)
+{
+  return detail::idrs_solve(A, rhs, tag, viennacl::linalg::no_precond(), static_cast<viennacl::vector<NumericT> const *>(NULL));
+}
+
+/** @brief Preconditioned IDR(s) solver starting from the given initial guess. The relative tolerance refers to the norm of the right hand side.
+*
+* @param A              The system matrix
+* @param rhs            The load vector
+* @param tag            Solver configuration tag
+* @param precond        A preconditioner. Precondition operation is done via member function apply()
+* @param initial_guess  The initial guess, e.g. the solution of the previous time step
+* @return The result vector
+*/
+template<typename MatrixT, typename NumericT, typename PreconditionerT>
+viennacl::vector<NumericT> solve(MatrixT const & A, viennacl::vector<NumericT> const & rhs, idrs_tag const & tag, PreconditionerT const & precond,
+                                 viennacl::vector<NumericT> const & initial_guess)
+{
+  return detail::idrs_solve(A, rhs, tag, precond, &initial_guess);
+}
+
+}
+}
+
+#endif
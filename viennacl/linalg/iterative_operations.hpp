@@ -22,6 +22,8 @@
     @brief Implementations of specialized routines for the iterative solvers.
 */
 
+#include <vector>
+
 #include "viennacl/forwards.h"
 #include "viennacl/range.hpp"
 #include "viennacl/scalar.hpp"
@@ -236,6 +238,185 @@ void pipelined_bicgstab_prod(MatrixT const & A,
 }
 
 
+/** @brief Performs a fused matrix-vector product needed for an efficient pipelined GMRES algorithm.
+  *
+  * With v_i denoting the i-th vector stored in 'krylov_basis' (starting at i * buffer_size_per_vector), this routine computes
+  *   v_{k+1} = scale_k * prod(A, v_k);
+  * and the inner products (v_i, v_{k+1}) for i = 0, ..., k as well as (v_{k+1}, v_{k+1}), written to inner_prods[0], ..., inner_prods[k+1].
+  */
+template<typename MatrixT, typename NumericT>
+void pipelined_gmres_prod(MatrixT const & A,
+                          vector_base<NumericT> & krylov_basis,
+                          vcl_size_t buffer_size_per_vector,
+                          vcl_size_t k,
+                          NumericT scale_k,
+                          std::vector<NumericT> & inner_prods)
+{
+  switch (viennacl::traits::handle(krylov_basis).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::pipelined_gmres_prod(A, krylov_basis, buffer_size_per_vector, k, scale_k, inner_prods);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Performs the classical Gram-Schmidt orthogonalization step needed for an efficient pipelined GMRES algorithm.
+  *
+  * With v_i denoting the i-th vector stored in 'krylov_basis', this routine computes
+  *   v_{k+1} -= sum_{i=0}^{k} coeffs[i] * v_i;
+  * and the inner products (v_i, v_{k+1}) for i = 0, ..., k as well as (v_{k+1}, v_{k+1}) of the updated vector, written to inner_prods[0], ..., inner_prods[k+1].
+  */
+template<typename NumericT>
+void pipelined_gmres_gram_schmidt(vector_base<NumericT> & krylov_basis,
+                                  vcl_size_t buffer_size_per_vector,
+                                  vcl_size_t k,
+                                  std::vector<NumericT> const & coeffs,
+                                  std::vector<NumericT> & inner_prods)
+{
+  switch (viennacl::traits::handle(krylov_basis).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::pipelined_gmres_gram_schmidt(krylov_basis, buffer_size_per_vector, k, coeffs, inner_prods);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Performs the update of the result vector needed for an efficient pipelined GMRES algorithm.
+  *
+  * With v_i denoting the i-th vector stored in 'krylov_basis', this routine computes
+  *   result += sum_{i=0}^{k-1} coeffs[i] * v_i;
+  */
+template<typename NumericT>
+void pipelined_gmres_update_result(vector_base<NumericT> & result,
+                                   vector_base<NumericT> const & krylov_basis,
+                                   vcl_size_t buffer_size_per_vector,
+                                   vcl_size_t k,
+                                   std::vector<NumericT> const & coeffs)
+{
+  switch (viennacl::traits::handle(result).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::pipelined_gmres_update_result(result, krylov_basis, buffer_size_per_vector, k, coeffs);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Computes the inner products of a vector with several other vectors in a single pass over memory.
+  *
+  * With v_i denoting the i-th vector in 'vecs', this routine computes inner_prods[i] = (v_i, y) for i = 0, ..., vecs.const_size() - 1,
+  * as well as inner_prods[vecs.const_size()] = (y, y).
+  */
+template<typename NumericT>
+void pipelined_multi_inner_prod(vector_tuple<NumericT> const & vecs,
+                                vector_base<NumericT> const & y,
+                                std::vector<NumericT> & inner_prods)
+{
+  switch (viennacl::traits::handle(y).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::pipelined_multi_inner_prod(vecs, y, inner_prods);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Subtracts a linear combination of several vectors from a vector, i.e. y -= sum_i coeffs[i] * v_i, and returns (y, y) of the result. Requires a single pass over memory. */
+template<typename NumericT>
+NumericT pipelined_multi_update(vector_base<NumericT> & y,
+                                vector_tuple<NumericT> const & vecs,
+                                std::vector<NumericT> const & coeffs)
+{
+  switch (viennacl::traits::handle(y).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    return viennacl::linalg::host_based::pipelined_multi_update(y, vecs, coeffs);
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Computes y_i = alpha * x_i + beta * y_i for all pairs of vectors in 'y_vecs' and 'x_vecs' in a single pass over memory. */
+template<typename NumericT>
+void pipelined_multi_axpby(vector_tuple<NumericT> const & y_vecs,
+                           NumericT alpha,
+                           vector_tuple<NumericT> const & x_vecs,
+                           NumericT beta)
+{
+  switch (viennacl::traits::handle(y_vecs.const_at(0)).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::pipelined_multi_axpby(y_vecs, alpha, x_vecs, beta);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Computes the Gram matrix gram[i * m + j] = (v_i, v_j) of the m vectors in 'vecs' in a single pass over memory. */
+template<typename NumericT>
+void pipelined_gram_matrix(vector_tuple<NumericT> const & vecs,
+                           std::vector<NumericT> & gram)
+{
+  switch (viennacl::traits::handle(vecs.const_at(0)).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::pipelined_gram_matrix(vecs, gram);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Performs one fused step of a Chebyshev (or Neumann) polynomial iteration with diagonal scaling. No inner products are computed.
+  *
+  * This routine computes
+  *   x += d_in;
+  *   r -= prod(A, d_in);
+  *   d_out = alpha * d_in + beta * element_prod(inv_diag, r);
+  */
+template<typename MatrixT, typename NumericT>
+void chebyshev_prod(MatrixT const & A,
+                    vector_base<NumericT> const & d_in,
+                    vector_base<NumericT> & d_out,
+                    vector_base<NumericT> & r,
+                    vector_base<NumericT> & x,
+                    vector_base<NumericT> const & inv_diag,
+                    NumericT alpha,
+                    NumericT beta)
+{
+  switch (viennacl::traits::handle(x).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::chebyshev_prod(A, d_in, d_out, r, x, inv_diag, alpha, beta);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
 } //namespace linalg
 } //namespace viennacl
 
@@ -23,12 +23,19 @@
 */
 
 #include <algorithm>    //for std::min
+#include <vector>
+#include <cmath>
 
 #include "viennacl/matrix.hpp"
 #include "viennacl/matrix_proxy.hpp"
 
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
 
 namespace viennacl
 {
@@ -188,6 +195,304 @@ void lu_factorize(matrix<NumericT, viennacl::column_major> & A)
 }
 
 
+namespace detail
+{
+  /** @brief Access to the entries of a dense matrix in host memory, independent of the memory layout. */
+  template<typename NumericT>
+  class lu_host_accessor
+  {
+  public:
+    lu_host_accessor(NumericT * data, vcl_size_t inc_row, vcl_size_t inc_col) : data_(data), inc_row_(inc_row), inc_col_(inc_col) {}
+
+    NumericT & operator()(vcl_size_t i, vcl_size_t j) const { return data_[i * inc_row_ + j * inc_col_]; }
+
+    bool row_major() const { return inc_col_ == 1; }
+
+  private:
+    NumericT * data_;
+    vcl_size_t inc_row_;
+    vcl_size_t inc_col_;
+  };
+
+  /** @brief Applies the row interchanges pivots[k_begin], ..., pivots[k_end - 1] in this order to the columns [col_begin, col_end) of a matrix in host memory. */
+  template<typename NumericT>
+  void lu_apply_pivots(lu_host_accessor<NumericT> const & A, std::vector<unsigned int> const & pivots,
+                       vcl_size_t k_begin, vcl_size_t k_end, vcl_size_t col_begin, vcl_size_t col_end)
+  {
+    if (col_begin >= col_end || k_begin >= k_end)
+      return;
+
+    // interchanges are independent for each column, hence columns are processed in blocks:
+    vcl_size_t block_size = 64;
+    long num_blocks = static_cast<long>((col_end - col_begin - 1) / block_size + 1);
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if ((col_end - col_begin) * (k_end - k_begin) > 16384)
+#endif
+    for (long block = 0; block < num_blocks; ++block)
+    {
+      vcl_size_t j_begin = col_begin + static_cast<vcl_size_t>(block) * block_size;
+      vcl_size_t j_end   = std::min(j_begin + block_size, col_end);
+      if (A.row_major())
+      {
+        for (vcl_size_t k = k_begin; k < k_end; ++k)
+        {
+          vcl_size_t p = pivots[k];
+          if (p != k)
+            for (vcl_size_t j = j_begin; j < j_end; ++j)
+              std::swap(A(k, j), A(p, j));
+        }
+      }
+      else
+      {
+        for (vcl_size_t j = j_begin; j < j_end; ++j)
+          for (vcl_size_t k = k_begin; k < k_end; ++k)
+            std::swap(A(k, j), A(pivots[k], j));
+      }
+    }
+  }
+
+  /** @brief Right-looking LU factorization with partial pivoting of the panel A(k:size, k:k+panel_size), used for narrow panels. */
+  template<typename NumericT>
+  void lu_panel_unblocked(lu_host_accessor<NumericT> const & A, vcl_size_t size, vcl_size_t k, vcl_size_t panel_size, std::vector<unsigned int> & pivots)
+  {
+    vcl_size_t col_end = k + panel_size;
+    for (vcl_size_t j = k; j < col_end; ++j)
+    {
+      // find pivot:
+      vcl_size_t p = j;
+      NumericT max_value = std::fabs(A(j, j));
+      for (vcl_size_t i = j + 1; i < size; ++i)
+      {
+        NumericT value = std::fabs(A(i, j));
+        if (value > max_value)
+        {
+          max_value = value;
+          p = i;
+        }
+      }
+      pivots[j] = static_cast<unsigned int>(p);
+
+      if (p != j)
+        for (vcl_size_t l = k; l < col_end; ++l)
+          std::swap(A(j, l), A(p, l));
+
+      NumericT a_jj = A(j, j);
+      if (a_jj == 0) // singular matrix: U has a zero on the diagonal, nothing to eliminate
+        continue;
+
+      for (vcl_size_t i = j + 1; i < size; ++i)
+        A(i, j) /= a_jj;
+
+      if (A.row_major())
+      {
+        for (vcl_size_t i = j + 1; i < size; ++i)
+        {
+          NumericT l_ij = A(i, j);
+          for (vcl_size_t l = j + 1; l < col_end; ++l)
+            A(i, l) -= l_ij * A(j, l);
+        }
+      }
+      else
+      {
+        for (vcl_size_t l = j + 1; l < col_end; ++l)
+        {
+          NumericT a_jl = A(j, l);
+          for (vcl_size_t i = j + 1; i < size; ++i)
+            A(i, l) -= A(i, j) * a_jl;
+        }
+      }
+    }
+  }
+
+  /** @brief Computes A(k:k+block_size, cols) = L^{-1} A(k:k+block_size, cols) with the unit lower triangular matrix L stored in A(k:k+block_size, k:k+block_size).
+  *
+  * The diagonal block is split recursively, such that most of the work is carried out by matrix-matrix products.
+  */
+  template<typename MatrixT>
+  void lu_unit_lower_solve(MatrixT & A, vcl_size_t k, vcl_size_t block_size, viennacl::range const & cols)
+  {
+    if (block_size <= 16)
+    {
+      viennacl::range block_range(k, k + block_size);
+      viennacl::matrix_range<MatrixT> L(A, block_range, block_range);
+      viennacl::matrix_range<MatrixT> B(A, block_range, cols);
+      viennacl::linalg::inplace_solve(L, B, viennacl::linalg::unit_lower_tag());
+      return;
+    }
+
+    vcl_size_t n1 = block_size / 2;
+    viennacl::range upper_range(k, k + n1);
+    viennacl::range lower_range(k + n1, k + block_size);
+
+    lu_unit_lower_solve(A, k, n1, cols);
+
+    viennacl::matrix_range<MatrixT> B_lower(A, lower_range, cols);
+    B_lower -= viennacl::linalg::prod(viennacl::matrix_range<MatrixT>(A, lower_range, upper_range),
+                                      viennacl::matrix_range<MatrixT>(A, upper_range, cols));
+
+    lu_unit_lower_solve(A, k + n1, block_size - n1, cols);
+  }
+
+  /** @brief Recursive LU factorization with partial pivoting of the panel A(k:size, k:k+panel_size).
+  *
+  * The left half of the panel is factored first, then the right half is updated by a triangular solve and a matrix-matrix product and factored.
+  * Row interchanges are only applied to the columns of the panel.
+  */
+  template<typename MatrixT, typename NumericT>
+  void lu_panel_recursive(MatrixT & A, lu_host_accessor<NumericT> const & A_host, vcl_size_t k, vcl_size_t panel_size, std::vector<unsigned int> & pivots)
+  {
+    vcl_size_t size = A.size1();
+    if (panel_size <= 16)
+    {
+      lu_panel_unblocked(A_host, size, k, panel_size, pivots);
+      return;
+    }
+
+    vcl_size_t n1 = panel_size / 2;
+    vcl_size_t n2 = panel_size - n1;
+
+    lu_panel_recursive(A, A_host, k, n1, pivots);
+    lu_apply_pivots(A_host, pivots, k, k + n1, k + n1, k + panel_size);
+
+    viennacl::range     left_range(k, k + n1);
+    viennacl::range    right_range(k + n1, k + panel_size);
+    viennacl::range remainder_range(k + n1, size);
+
+    viennacl::matrix_range<MatrixT> A_12(A, left_range,      right_range);
+    viennacl::matrix_range<MatrixT> L_21(A, remainder_range, left_range);
+    viennacl::matrix_range<MatrixT> A_22(A, remainder_range, right_range);
+
+    lu_unit_lower_solve(A, k, n1, right_range);
+    A_22 -= viennacl::linalg::prod(L_21, A_12);
+
+    lu_panel_recursive(A, A_host, k + n1, n2, pivots);
+    lu_apply_pivots(A_host, pivots, k + n1, k + panel_size, k, k + n1);
+  }
+
+  /** @brief Blocked LU factorization with partial pivoting and look-ahead of a square dense matrix in host memory.
+  *
+  * Once the block row of U for the current panel is computed, the columns of the next panel are updated first.
+  * The next panel is then factored by one thread while the other threads update the remaining columns of the trailing matrix.
+  */
+  template<typename MatrixT>
+  void lu_factorize_host(MatrixT & A, std::vector<unsigned int> & pivots)
+  {
+    typedef typename MatrixT::cpu_value_type   NumericT;
+
+    vcl_size_t size = A.size1();
+    pivots.resize(size);
+    if (size == 0)
+      return;
+
+    NumericT * data = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+    lu_host_accessor<NumericT> A_host(data,
+                                      A.row_major() ? A.internal_size2() : 1,
+                                      A.row_major() ? 1 : A.internal_size1());
+
+    vcl_size_t block_size = 128;
+    vcl_size_t num_threads = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    num_threads = static_cast<vcl_size_t>(omp_get_max_threads());
+#endif
+
+    lu_panel_recursive(A, A_host, 0, std::min(block_size, size), pivots);
+
+    for (vcl_size_t k = 0; k < size; k += block_size)
+    {
+      vcl_size_t k_end = std::min(k + block_size, size);
+
+      if (k_end < size)
+      {
+        viennacl::range     block_range(k, k_end);
+        viennacl::range remainder_range(k_end, size);
+
+        // block row of U:
+        lu_apply_pivots(A_host, pivots, k, k_end, k_end, size);
+        lu_unit_lower_solve(A, k, k_end - k, remainder_range);
+
+        // look-ahead: update the next panel
+        viennacl::matrix_range<MatrixT> L_21(A, remainder_range, block_range);
+        vcl_size_t next_end = std::min(k_end + block_size, size);
+        viennacl::range next_range(k_end, next_end);
+        viennacl::matrix_range<MatrixT> A_next(A, remainder_range, next_range);
+        A_next -= viennacl::linalg::prod(L_21, viennacl::matrix_range<MatrixT>(A, block_range, next_range));
+
+        // factor the next panel while the remaining columns are updated:
+        vcl_size_t chunk_size = std::max(block_size, (size - next_end) / (2 * num_threads) + 1);
+        long num_chunks = static_cast<long>((size - next_end + chunk_size - 1) / chunk_size);
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel if (num_threads > 1 && num_chunks > 0)
+#endif
+        {
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp single nowait
+#endif
+          lu_panel_recursive(A, A_host, k_end, next_end - k_end, pivots);
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp for schedule(dynamic)
+#endif
+          for (long chunk = 0; chunk < num_chunks; ++chunk)
+          {
+            vcl_size_t col_begin = next_end + static_cast<vcl_size_t>(chunk) * chunk_size;
+            viennacl::range chunk_range(col_begin, std::min(col_begin + chunk_size, size));
+            viennacl::matrix_range<MatrixT> A_chunk(A, remainder_range, chunk_range);
+            A_chunk -= viennacl::linalg::prod(L_21, viennacl::matrix_range<MatrixT>(A, block_range, chunk_range));
+          }
+        }
+      }
+
+      // apply the interchanges of this panel to the columns of L to the left:
+      lu_apply_pivots(A_host, pivots, k, k_end, 0, k);
+    }
+  }
+
+  /** @brief Applies the row interchanges in 'pivots' to all columns of a dense matrix. */
+  template<typename NumericT, typename F, unsigned int AlignmentV>
+  void lu_permute_rows(matrix<NumericT, F, AlignmentV> & B, std::vector<unsigned int> const & pivots)
+  {
+    std::vector<NumericT> buffer(B.internal_size());
+    viennacl::backend::memory_read(B.handle(), 0, sizeof(NumericT) * buffer.size(), &(buffer[0]));
+
+    lu_host_accessor<NumericT> B_host(&(buffer[0]),
+                                      B.row_major() ? B.internal_size2() : 1,
+                                      B.row_major() ? 1 : B.internal_size1());
+    lu_apply_pivots(B_host, pivots, 0, pivots.size(), 0, B.size2());
+
+    viennacl::backend::memory_write(B.handle(), 0, sizeof(NumericT) * buffer.size(), &(buffer[0]));
+  }
+}
+
+/** @brief LU factorization with partial pivoting of a dense matrix, i.e. P A = L U.
+*
+* The factorization is recursively blocked. Triangular solves and trailing updates are computed with matrix-matrix operations.
+* Matrices which do not reside in host memory are factored in host memory and copied back.
+*
+* @param A        The system matrix, where the LU matrices are directly written to. The implicit unit diagonal of L is not written.
+* @param pivots   Row interchanges (at least A.size1() entries, as for batched_lu_factorize()): In step k, row k was interchanged with row pivots[k] >= k
+*/
+template<typename NumericT, typename F, unsigned int AlignmentV>
+void lu_factorize(matrix<NumericT, F, AlignmentV> & A, vector_base<unsigned int> & pivots)
+{
+  assert(A.size1() == A.size2() && bool("Matrix must be square"));
+  assert(pivots.size() >= A.size1() && bool("Size of pivot buffer too small"));
+
+  std::vector<unsigned int> host_pivots;
+  if (viennacl::traits::active_handle_id(A) == viennacl::MAIN_MEMORY)
+    detail::lu_factorize_host(A, host_pivots);
+  else
+  {
+    matrix<NumericT, F, AlignmentV> A_host(A.size1(), A.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+    viennacl::backend::memory_read(A.handle(), 0, sizeof(NumericT) * A.internal_size(),
+                                   viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A_host.handle()));
+    detail::lu_factorize_host(A_host, host_pivots);
+    viennacl::backend::memory_write(A.handle(), 0, sizeof(NumericT) * A.internal_size(),
+                                    viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A_host.handle()));
+  }
+  viennacl::copy(host_pivots.begin(), host_pivots.end(), pivots.begin());
+}
+
+
 //
 // Convenience layer:
 //
@@ -221,6 +526,55 @@ void lu_substitute(matrix<NumericT, F, MatAlignmentV> const & A,
   inplace_solve(A, vec, upper_tag());
 }
 
+/** @brief LU substitution for the system LU = P rhs, where the factorization was computed with partial pivoting.
+*
+* @param A        The system matrix, where the LU matrices are directly written to. The implicit unit diagonal of L is not written.
+* @param pivots   The row interchanges returned by lu_factorize()
+* @param B        The matrix of load vectors, where the solution is directly written to
+*/
+template<typename NumericT, typename F1, typename F2, unsigned int AlignmentV1, unsigned int AlignmentV2>
+void lu_substitute(matrix<NumericT, F1, AlignmentV1> const & A,
+                   vector_base<unsigned int> const & pivots,
+                   matrix<NumericT, F2, AlignmentV2> & B)
+{
+  assert(A.size1() == A.size2() && bool("Matrix must be square"));
+  assert(A.size1() == B.size1() && bool("Matrix must be square"));
+  assert(pivots.size() >= A.size1() && bool("Size of pivot buffer too small"));
+
+  std::vector<unsigned int> host_pivots(A.size1());
+  viennacl::copy(pivots.begin(), pivots.begin() + static_cast<long>(A.size1()), host_pivots.begin());
+  detail::lu_permute_rows(B, host_pivots);
+  inplace_solve(A, B, unit_lower_tag());
+  inplace_solve(A, B, upper_tag());
+}
+
+/** @brief LU substitution for the system LU = P rhs, where the factorization was computed with partial pivoting.
+*
+* @param A        The system matrix, where the LU matrices are directly written to. The implicit unit diagonal of L is not written.
+* @param pivots   The row interchanges returned by lu_factorize()
+* @param vec      The load vector, where the solution is directly written to
+*/
+template<typename NumericT, typename F, unsigned int MatAlignmentV, unsigned int VecAlignmentV>
+void lu_substitute(matrix<NumericT, F, MatAlignmentV> const & A,
+                   vector_base<unsigned int> const & pivots,
+                   vector<NumericT, VecAlignmentV> & vec)
+{
+  assert(A.size1() == A.size2() && bool("Matrix must be square"));
+  assert(pivots.size() >= A.size1() && bool("Size of pivot buffer too small"));
+
+  std::vector<unsigned int> host_pivots(A.size1());
+  viennacl::copy(pivots.begin(), pivots.begin() + static_cast<long>(A.size1()), host_pivots.begin());
+
+  std::vector<NumericT> buffer(vec.size());
+  viennacl::copy(vec, buffer);
+  for (vcl_size_t k = 0; k < host_pivots.size(); ++k)
+    std::swap(buffer[k], buffer[host_pivots[k]]);
+  viennacl::copy(buffer, vec);
+
+  inplace_solve(A, vec, unit_lower_tag());
+  inplace_solve(A, vec, upper_tag());
+}
+
 }
 }
 
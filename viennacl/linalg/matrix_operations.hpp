@@ -78,6 +78,43 @@ namespace viennacl
       }
     }
 
+    /** @brief Transposes the square matrix A in place.
+    *
+    * For matrices in host memory no second matrix is allocated, which matters for very large matrices. For other memory domains, the transpose is computed via a temporary.
+    *
+    * @param A     The square matrix to be transposed
+    */
+    template<typename NumericT>
+    void inplace_trans(matrix_base<NumericT> & A)
+    {
+      assert(viennacl::traits::size1(A) == viennacl::traits::size2(A) && bool("In-place transposition requires a square matrix"));
+
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::inplace_trans(A);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+#endif
+#ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+#endif
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+        {
+          matrix_base<NumericT> temp(A.size2(), A.size1(), A.row_major(), viennacl::traits::context(A));
+          viennacl::linalg::trans(matrix_expression<const matrix_base<NumericT>, const matrix_base<NumericT>, op_trans>(A, A), temp);
+          A = temp;
+          break;
+        }
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
 
     template<typename NumericT,
               typename ScalarType1>
@@ -25,18 +25,27 @@
 #include <vector>
 #include <map>
 #include <cmath>
+#include <numeric>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
+#include "viennacl/compressed_matrix.hpp"
 #include "viennacl/linalg/ilu.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/iterative_operations.hpp"
+#include "viennacl/linalg/host_based/iterative_operations.hpp"
 #include "viennacl/traits/clear.hpp"
 #include "viennacl/traits/size.hpp"
+#include "viennacl/traits/context.hpp"
 #include "viennacl/meta/result_of.hpp"
-#include "viennacl/ocl/backend.hpp"
-#include "viennacl/ocl/kernel.hpp"
 #include "viennacl/backend/memory.hpp"
 
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/ocl/backend.hpp"
+  #include "viennacl/ocl/kernel.hpp"
+#endif
+
 #include "viennacl/vector_proxy.hpp"
 
 namespace viennacl
@@ -85,6 +94,7 @@ namespace viennacl
     };
 
 
+#ifdef VIENNACL_WITH_OPENCL
     static const char * double_float_conversion_program =
     "#if defined(cl_khr_fp64)\n"
     "#  pragma OPENCL EXTENSION cl_khr_fp64: enable\n"
@@ -107,13 +117,92 @@ namespace viennacl
     "  for (unsigned int i = get_global_id(0); i < size; i += get_global_size(0))\n"
     "    vec1[i] += (double)(vec2[i]);\n"
     "};\n";
+#endif
+
+    namespace detail
+    {
+      /** @brief Assigns a double precision vector to a single precision vector, i.e. vec1 = vec2. Both vectors are expected to be unit-strided and to start at zero. */
+      template<typename NumericT>
+      void assign_double_to_float(viennacl::vector_base<float> & vec1, viennacl::vector_base<NumericT> const & vec2)
+      {
+        switch (viennacl::traits::handle(vec1).get_active_handle_id())
+        {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::mixed_precision_assign(vec1, vec2);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+        {
+          viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(vec1).context());
+          if (!ctx.has_program("double_float_conversion_program"))
+            ctx.add_program(double_float_conversion_program, "double_float_conversion_program");
+
+          viennacl::ocl::kernel & k = ctx.get_kernel("double_float_conversion_program", "assign_double_to_float");
+          viennacl::ocl::enqueue(k(vec1.handle().opencl_handle(), vec2.handle().opencl_handle(), cl_uint(vec1.size())));
+          break;
+        }
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+        }
+      }
+
+      /** @brief Adds a single precision vector to a double precision vector, i.e. vec1 += vec2. Both vectors are expected to be unit-strided and to start at zero. */
+      template<typename NumericT>
+      void inplace_add_float_to_double(viennacl::vector_base<NumericT> & vec1, viennacl::vector_base<float> const & vec2)
+      {
+        switch (viennacl::traits::handle(vec1).get_active_handle_id())
+        {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::mixed_precision_inplace_add(vec1, vec2);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+        {
+          viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(vec1).context());
+          if (!ctx.has_program("double_float_conversion_program"))
+            ctx.add_program(double_float_conversion_program, "double_float_conversion_program");
+
+          viennacl::ocl::kernel & k = ctx.get_kernel("double_float_conversion_program", "inplace_add_float_to_double");
+          viennacl::ocl::enqueue(k(vec1.handle().opencl_handle(), vec2.handle().opencl_handle(), cl_uint(vec1.size())));
+          break;
+        }
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+        }
+      }
+
+      /** @brief Sets up a single precision copy of a double precision compressed_matrix in the same memory domain. The sparsity pattern is copied, the entries are converted. */
+      template<typename NumericT, unsigned int AlignmentV>
+      void mixed_precision_matrix_copy(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                                       viennacl::compressed_matrix<float> & A_low_precision)
+      {
+        viennacl::backend::typesafe_host_array<unsigned int> index_array(A.handle1());
 
+        viennacl::backend::memory_copy(A.handle1(), A_low_precision.handle1(), 0, 0, index_array.element_size() * (A.size1() + 1));
+        viennacl::backend::memory_copy(A.handle2(), A_low_precision.handle2(), 0, 0, index_array.element_size() * A.nnz());
 
-    /** @brief Implementation of the conjugate gradient solver without preconditioner
+        viennacl::vector_base<NumericT> A_values(const_cast<viennacl::backend::mem_handle &>(A.handle()), A.nnz(), 0, 1);
+        viennacl::vector_base<float>  A_low_precision_values(A_low_precision.handle(), A.nnz(), 0, 1);
+        assign_double_to_float(A_low_precision_values, A_values);
+
+        A_low_precision.generate_row_block_information();
+      }
+    }
+
+
+    /** @brief Implementation of the mixed precision conjugate gradient solver without preconditioner
     *
-    * Following the algorithm in the book by Y. Saad "Iterative Methods for sparse linear systems"
+    * The inner iterations run the pipelined CG method in single precision on a single precision copy of the system matrix set up at the beginning of the solver run.
+    * Whenever the inner residual is reduced by the inner tolerance, the single precision correction is added to the double precision result and the residual is recomputed in double precision.
+    * All kernels are available for main memory (host) and OpenCL.
     *
-    * @param matrix     The system matrix
+    * @param matrix     The system matrix (compressed_matrix in double precision)
     * @param rhs        The load vector
     * @param tag        Solver configuration tag
     * @return The result vector
@@ -121,13 +210,9 @@ namespace viennacl
     template<typename MatrixType, typename VectorType>
     VectorType solve(const MatrixType & matrix, VectorType const & rhs, mixed_precision_cg_tag const & tag)
     {
-      //typedef typename VectorType::value_type      ScalarType;
       typedef typename viennacl::result_of::value_type<VectorType>::type        ScalarType;
       typedef typename viennacl::result_of::cpu_value_type<ScalarType>::type    CPU_ScalarType;
 
-      //TODO: Assert CPU_ScalarType == double
-
-      //std::cout << "Starting CG" << std::endl;
       vcl_size_t problem_size = viennacl::traits::size(rhs);
       VectorType result(rhs);
       viennacl::traits::clear(result);
@@ -141,79 +226,59 @@ namespace viennacl
       if (norm_rhs_squared == 0) //solution is zero if RHS norm is zero
         return result;
 
-      static bool first = true;
-
-      viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(matrix).context());
-      if (first)
-      {
-        ctx.add_program(double_float_conversion_program, "double_float_conversion_program");
-      }
+      // transfer matrix to single precision:
+      viennacl::compressed_matrix<float> matrix_low_precision(matrix.size1(), matrix.size2(), matrix.nnz(), viennacl::traits::context(matrix));
+      detail::mixed_precision_matrix_copy(matrix, matrix_low_precision);
 
       viennacl::vector<float> residual_low_precision(problem_size, viennacl::traits::context(rhs));
       viennacl::vector<float> result_low_precision(problem_size, viennacl::traits::context(rhs));
       viennacl::vector<float> p_low_precision(problem_size, viennacl::traits::context(rhs));
-      viennacl::vector<float> tmp_low_precision(problem_size, viennacl::traits::context(rhs));
-      float inner_ip_rr = static_cast<float>(ip_rr);
-      float new_inner_ip_rr = 0;
-      float initial_inner_rhs_norm_squared = static_cast<float>(ip_rr);
-      float alpha;
-      float beta;
-
-      viennacl::ocl::kernel & assign_double_to_float      = ctx.get_kernel("double_float_conversion_program", "assign_double_to_float");
-      viennacl::ocl::kernel & inplace_add_float_to_double = ctx.get_kernel("double_float_conversion_program", "inplace_add_float_to_double");
+      viennacl::vector<float> Ap_low_precision(problem_size, viennacl::traits::context(rhs));
+      viennacl::vector<float> inner_prod_buffer = viennacl::zero_vector<float>(3*256, viennacl::traits::context(rhs)); // temporary buffer
+      std::vector<float>      host_inner_prod_buffer(inner_prod_buffer.size());
+      vcl_size_t              buffer_size_per_vector = inner_prod_buffer.size() / 3;
 
       // transfer rhs to single precision:
-      viennacl::ocl::enqueue( assign_double_to_float(p_low_precision.handle().opencl_handle(),
-                                                     rhs.handle().opencl_handle(),
-                                                     cl_uint(rhs.size())
-                                                    ) );
-      //std::cout << "copying p_low_precision..." << std::endl;
-      //assign_double_to_float(p_low_precision.handle(), residual.handle(), residual.size());
-      residual_low_precision = p_low_precision;
-
-      // transfer matrix to single precision:
-      viennacl::compressed_matrix<float> matrix_low_precision(matrix.size1(), matrix.size2(), matrix.nnz(), viennacl::traits::context(rhs));
-      viennacl::backend::memory_copy(matrix.handle1(), const_cast<viennacl::backend::mem_handle &>(matrix_low_precision.handle1()), 0, 0, sizeof(cl_uint) * (matrix.size1() + 1) );
-      viennacl::backend::memory_copy(matrix.handle2(), const_cast<viennacl::backend::mem_handle &>(matrix_low_precision.handle2()), 0, 0, sizeof(cl_uint) * (matrix.nnz()) );
-
-      viennacl::ocl::enqueue( assign_double_to_float(matrix_low_precision.handle().opencl_handle(),
-                                                     matrix.handle().opencl_handle(),
-                                                     cl_uint(matrix.nnz())
-                                                    ) );
-      //std::cout << "copying matrix_low_precision..." << std::endl;
-      //assign_double_to_float(const_cast<viennacl::backend::mem_handle &>(matrix_low_precision.handle()), matrix.handle(), matrix.nnz());
-
-      //std::cout << "Starting CG solver iterations... " << std::endl;
+      detail::assign_double_to_float(residual_low_precision, rhs);
+      result_low_precision.clear();
 
+      float initial_inner_rhs_norm_squared = static_cast<float>(ip_rr);
+      float inner_ip_rr = initial_inner_rhs_norm_squared;
+      float inner_ip_ApAp = 0;
+      float inner_ip_pAp = 0;
+      float alpha = 0;
+      float beta = 0;
+      bool restart = true;
 
       for (unsigned int i = 0; i < tag.max_iterations(); ++i)
       {
         tag.iters(i+1);
 
-        // lower precision 'inner iteration'
-        tmp_low_precision = viennacl::linalg::prod(matrix_low_precision, p_low_precision);
-
-        alpha = inner_ip_rr / viennacl::linalg::inner_prod(tmp_low_precision, p_low_precision);
-        result_low_precision += alpha * p_low_precision;
-        residual_low_precision -= alpha * tmp_low_precision;
-
-        new_inner_ip_rr = viennacl::linalg::inner_prod(residual_low_precision, residual_low_precision);
+        // (re)start the pipelined inner iteration from p = r:
+        if (restart)
+        {
+          p_low_precision  = residual_low_precision;
+          Ap_low_precision = viennacl::linalg::prod(matrix_low_precision, p_low_precision);
 
-        beta = new_inner_ip_rr / inner_ip_rr;
-        inner_ip_rr = new_inner_ip_rr;
+          alpha = inner_ip_rr / viennacl::linalg::inner_prod(p_low_precision, Ap_low_precision);
+          beta  = viennacl::linalg::norm_2(Ap_low_precision); beta = (alpha * alpha * beta * beta - inner_ip_rr) / inner_ip_rr;
+          restart = false;
+        }
 
-        p_low_precision = residual_low_precision + beta * p_low_precision;
+        // lower precision 'inner iteration' with fused vector updates and matrix-vector product:
+        viennacl::linalg::pipelined_cg_vector_update(result_low_precision, alpha, p_low_precision, residual_low_precision, Ap_low_precision, beta, inner_prod_buffer);
+        viennacl::linalg::pipelined_cg_prod(matrix_low_precision, p_low_precision, Ap_low_precision, inner_prod_buffer);
 
+        viennacl::fast_copy(inner_prod_buffer.begin(), inner_prod_buffer.end(), host_inner_prod_buffer.begin());
 
+        inner_ip_rr   = std::accumulate(host_inner_prod_buffer.begin(),                              host_inner_prod_buffer.begin() +     buffer_size_per_vector, 0.0f);
+        inner_ip_ApAp = std::accumulate(host_inner_prod_buffer.begin() +     buffer_size_per_vector, host_inner_prod_buffer.begin() + 2 * buffer_size_per_vector, 0.0f);
+        inner_ip_pAp  = std::accumulate(host_inner_prod_buffer.begin() + 2 * buffer_size_per_vector, host_inner_prod_buffer.begin() + 3 * buffer_size_per_vector, 0.0f);
 
-        if (new_inner_ip_rr < tag.inner_tolerance() * initial_inner_rhs_norm_squared || i == tag.max_iterations()-1)
+        if (inner_ip_rr < tag.inner_tolerance() * initial_inner_rhs_norm_squared || i == tag.max_iterations()-1)
         {
-          //std::cout << "outer correction at i=" << i << std::endl;
-          //result += result_low_precision;
-          viennacl::ocl::enqueue( inplace_add_float_to_double(result.handle().opencl_handle(),
-                                                              result_low_precision.handle().opencl_handle(),
-                                                              cl_uint(result.size())
-                                                             ) );
+          // outer correction: result += result_low_precision
+          detail::inplace_add_float_to_double(result, result_low_precision);
 
           // residual = b - Ax  (without introducing a temporary)
           residual = viennacl::linalg::prod(matrix, result);
@@ -223,15 +288,16 @@ namespace viennacl
           if (new_ip_rr / norm_rhs_squared < tag.tolerance() *  tag.tolerance())//squared norms involved here
             break;
 
-          // p_low_precision = residual;
-          viennacl::ocl::enqueue( assign_double_to_float(p_low_precision.handle().opencl_handle(),
-                                                         residual.handle().opencl_handle(),
-                                                         cl_uint(residual.size())
-                                                        ) );
+          detail::assign_double_to_float(residual_low_precision, residual);
           result_low_precision.clear();
-          residual_low_precision = p_low_precision;
           initial_inner_rhs_norm_squared = static_cast<float>(new_ip_rr);
           inner_ip_rr = static_cast<float>(new_ip_rr);
+          restart = true;
+        }
+        else
+        {
+          alpha = inner_ip_rr / inner_ip_pAp;
+          beta  = (alpha * alpha * inner_ip_ApAp - inner_ip_rr) / inner_ip_rr;
         }
       }
 
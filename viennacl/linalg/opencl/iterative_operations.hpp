@@ -187,6 +187,7 @@ void pipelined_cg_prod(sliced_ell_matrix<NumericT> const & A,
   viennacl::ocl::enqueue(k(A.handle1().opencl_handle(),
                            A.handle2().opencl_handle(),
                            A.handle3().opencl_handle(),
+                           A.handle4().opencl_handle(),
                            A.handle().opencl_handle(),
                            viennacl::traits::opencl_handle(p),
                            viennacl::traits::opencl_handle(Ap),
@@ -435,6 +436,7 @@ void pipelined_bicgstab_prod(sliced_ell_matrix<NumericT> const & A,
   viennacl::ocl::enqueue(k(A.handle1().opencl_handle(),
                            A.handle2().opencl_handle(),
                            A.handle3().opencl_handle(),
+                           A.handle4().opencl_handle(),
                            A.handle().opencl_handle(),
                            viennacl::traits::opencl_handle(p),
                            viennacl::traits::opencl_handle(Ap),
@@ -288,6 +288,7 @@ void generate_sliced_ell_matrix_pipelined_cg_prod(StringT & source, std::string
   source.append("  __global const unsigned int * columns_per_block, \n");
   source.append("  __global const unsigned int * column_indices, \n");
   source.append("  __global const unsigned int * block_start, \n");
+  source.append("  __global const unsigned int * row_indices, \n");
   source.append("  __global const "); source.append(numeric_string); source.append(" * elements, \n");
   source.append("  __global const "); source.append(numeric_string); source.append(" * p, \n");
   source.append("  __global "); source.append(numeric_string); source.append(" * Ap, \n");
@@ -315,9 +316,10 @@ void generate_sliced_ell_matrix_pipelined_cg_prod(StringT & source, std::string
   source.append("    } \n");
 
   source.append("    if (row < size) {\n");
-  source.append("      Ap[row] = sum; \n");
+  source.append("      uint row_index = row_indices[row]; \n");
+  source.append("      Ap[row_index] = sum; \n");
   source.append("      inner_prod_ApAp += sum * sum; \n");
-  source.append("      inner_prod_pAp  += p[row] * sum; \n");
+  source.append("      inner_prod_pAp  += p[row_index] * sum; \n");
   source.append("    }  \n");
   source.append("  }  \n");
 
@@ -771,6 +773,7 @@ void generate_sliced_ell_matrix_pipelined_bicgstab_prod(StringT & source, std::s
   source.append("  __global const unsigned int * columns_per_block, \n");
   source.append("  __global const unsigned int * column_indices, \n");
   source.append("  __global const unsigned int * block_start, \n");
+  source.append("  __global const unsigned int * row_indices, \n");
   source.append("  __global const "); source.append(numeric_string); source.append(" * elements, \n");
   source.append("  __global const "); source.append(numeric_string); source.append(" * p, \n");
   source.append("  __global "); source.append(numeric_string); source.append(" * Ap, \n");
@@ -802,10 +805,11 @@ void generate_sliced_ell_matrix_pipelined_bicgstab_prod(StringT & source, std::s
   source.append("    } \n");
 
   source.append("    if (row < size) {\n");
-  source.append("      Ap[row] = sum; \n");
+  source.append("      uint row_index = row_indices[row]; \n");
+  source.append("      Ap[row_index] = sum; \n");
   source.append("      inner_prod_ApAp += sum * sum; \n");
-  source.append("      inner_prod_pAp  += p[row] * sum; \n");
-  source.append("      inner_prod_r0Ap += r0star[row] * sum; \n");
+  source.append("      inner_prod_pAp  += p[row_index] * sum; \n");
+  source.append("      inner_prod_r0Ap += r0star[row_index] * sum; \n");
   source.append("    }  \n");
   source.append("  }  \n");
 
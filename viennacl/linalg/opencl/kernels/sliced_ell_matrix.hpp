@@ -28,6 +28,7 @@ void generate_sliced_ell_vec_mul(StringT & source, std::string const & numeric_s
   source.append("  __global const unsigned int * columns_per_block, \n");
   source.append("  __global const unsigned int * column_indices, \n");
   source.append("  __global const unsigned int * block_start, \n");
+  source.append("  __global const unsigned int * row_indices, \n");
   source.append("  __global const "); source.append(numeric_string); source.append(" * elements, \n");
   source.append("  __global const "); source.append(numeric_string); source.append(" * x, \n");
   source.append("  uint4 layout_x, \n");
@@ -51,7 +52,7 @@ void generate_sliced_ell_vec_mul(StringT & source, std::string const & numeric_s
   source.append("    } \n");
 
   source.append("    if (row < num_rows) \n");
-  source.append("      result[row * layout_result.y + layout_result.x] = sum; \n");
+  source.append("      result[row_indices[row] * layout_result.y + layout_result.x] = sum; \n");
   source.append("  } \n");
   source.append("} \n");
 }
@@ -841,6 +841,7 @@ void prod_impl(viennacl::sliced_ell_matrix<ScalarT, IndexT> const & A,
   viennacl::ocl::enqueue(k(A.handle1().opencl_handle(),
                            A.handle2().opencl_handle(),
                            A.handle3().opencl_handle(),
+                           A.handle4().opencl_handle(),
                            A.handle().opencl_handle(),
                            viennacl::traits::opencl_handle(x),
                            layout_x,
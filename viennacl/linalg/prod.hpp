@@ -301,6 +301,19 @@ namespace viennacl
                                           viennacl::op_prod >(A, B);
     }
 
+    // sparse matrix - sparse matrix product
+    template<typename NumericT, unsigned int AlignmentV>
+    viennacl::matrix_expression<const viennacl::compressed_matrix<NumericT, AlignmentV>,
+                                const viennacl::compressed_matrix<NumericT, AlignmentV>,
+                                op_prod >
+    prod(const viennacl::compressed_matrix<NumericT, AlignmentV> & A,
+         const viennacl::compressed_matrix<NumericT, AlignmentV> & B)
+    {
+      return viennacl::matrix_expression<const viennacl::compressed_matrix<NumericT, AlignmentV>,
+                                         const viennacl::compressed_matrix<NumericT, AlignmentV>,
+                                         op_prod >(A, B);
+    }
+
     template<typename StructuredMatrixType, class SCALARTYPE>
     typename viennacl::enable_if< viennacl::is_any_dense_structured_matrix<StructuredMatrixType>::value,
                                   vector_expression<const StructuredMatrixType,
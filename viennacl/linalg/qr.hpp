@@ -40,12 +40,35 @@
 #include "viennacl/matrix.hpp"
 #include "viennacl/matrix_proxy.hpp"
 #include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
 #include "viennacl/range.hpp"
 
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace viennacl
 {
   namespace linalg
   {
+    /** @brief Implicit representation of the orthogonal factor Q of a tall-skinny QR factorization computed by inplace_tsqr()
+    *
+    * The rows of the matrix are split into blocks of (at least) block_rows rows, which are factored independently.
+    * The R factors of all blocks are then stacked and factored again, until a single block remains.
+    */
+    template<typename NumericT>
+    struct tsqr_factors
+    {
+      tsqr_factors(vcl_size_t block_rows_ = 0) : block_rows(block_rows_) {}
+
+      /** @brief Number of rows per block. Chosen automatically by inplace_tsqr() if zero. */
+      vcl_size_t block_rows;
+      /** @brief The coefficients of the Householder reflectors for each level of the reduction tree, stored as betas[level][block * cols + k] */
+      std::vector< std::vector<NumericT> > betas;
+      /** @brief The Householder reflectors of the stacked R factors (column-major) for each level of the reduction tree except for the first. The Householder reflectors for the first level are stored in the input matrix. */
+      std::vector< std::vector<NumericT> > stacked_factors;
+    };
+
     namespace detail
     {
 
@@ -308,251 +331,455 @@ namespace viennacl
         return betas;
       }
 
-
-      /** @brief Implementation of a OpenCL-only QR factorization for GPUs (or multi-core CPU). DEPRECATED! Use only if you're curious and interested in playing a bit with a GPU-only implementation.
-      *
-      * Performance is rather poor at small matrix sizes.
-      * Prefer the use of the hybrid version, which is automatically chosen using the interface function inplace_qr()
-      *
-      * @param A            A dense ViennaCL matrix to be factored
-      * @param block_size   The block size to be used. The number of columns of A must be a multiple of block_size
-      */
-      template<typename MatrixType>
-      std::vector< typename viennacl::result_of::cpu_value_type< typename MatrixType::value_type >::type >
-      inplace_qr_viennacl(MatrixType & A, vcl_size_t block_size = 16)
+      /** @brief Access to the entries of a dense matrix in host memory, independent of the memory layout. */
+      template<typename NumericT>
+      class qr_host_accessor
       {
-        typedef typename viennacl::result_of::cpu_value_type< typename MatrixType::value_type >::type   ScalarType;
-        typedef viennacl::matrix_range<MatrixType>  MatrixRange;
+      public:
+        qr_host_accessor(NumericT * data, vcl_size_t inc_row, vcl_size_t inc_col) : data_(data), inc_row_(inc_row), inc_col_(inc_col) {}
 
-        using viennacl::range;
-        using viennacl::project;
+        NumericT & operator()(vcl_size_t i, vcl_size_t j) const { return data_[i * inc_row_ + j * inc_col_]; }
 
-        std::vector<ScalarType> betas(A.size2());
-        MatrixType v(A.size1(), 1);
-        MatrixType matrix_1x1(1,1);
+        /** @brief Returns true if consecutive entries in a column are consecutive in memory */
+        bool column_major() const { return inc_row_ == 1; }
 
-        MatrixType Y(A.size1(), block_size); Y.clear();
-        MatrixType W(A.size1(), block_size); W.clear();
+        /** @brief Returns an accessor to the submatrix starting at entry (i, j) */
+        qr_host_accessor offset(vcl_size_t i, vcl_size_t j) const { return qr_host_accessor(data_ + i * inc_row_ + j * inc_col_, inc_row_, inc_col_); }
 
-        MatrixType YT_prod_v(block_size, 1);
-        MatrixType z(A.size1(), 1);
+      private:
+        NumericT * data_;
+        vcl_size_t inc_row_;
+        vcl_size_t inc_col_;
+      };
 
-        //run over A in a block-wise manner:
-        for (vcl_size_t j = 0; j < std::min(A.size1(), A.size2()); j += block_size)
-        {
-          vcl_size_t effective_block_size = std::min(std::min(A.size1(), A.size2()), j+block_size) - j;
+      /** @brief Returns an accessor to the entries of a ViennaCL matrix residing in host memory */
+      template<typename T, typename F, unsigned int ALIGNMENT>
+      qr_host_accessor<T> qr_host_matrix(viennacl::matrix<T, F, ALIGNMENT> & A)
+      {
+        T * data = viennacl::linalg::host_based::detail::extract_raw_pointer<T>(A.handle());
+        return qr_host_accessor<T>(data,
+                                   viennacl::is_row_major<F>::value ? A.internal_size2() : 1,
+                                   viennacl::is_row_major<F>::value ? 1 : A.internal_size1());
+      }
 
-          //determine Householder vectors:
-          for (vcl_size_t k = 0; k < effective_block_size; ++k)
-          {
-            betas[j+k] = detail::setup_householder_vector_viennacl(A, v, matrix_1x1, j+k);
-            for (vcl_size_t l = k; l < effective_block_size; ++l)
-              detail::householder_reflect_viennacl(A, v, matrix_1x1, betas[j+k], j+k, j+l);
+      /** @brief Returns a read-only accessor to the entries of a ViennaCL matrix residing in host memory */
+      template<typename T, typename F, unsigned int ALIGNMENT>
+      qr_host_accessor<T const> qr_host_matrix(viennacl::matrix<T, F, ALIGNMENT> const & A)
+      {
+        T const * data = viennacl::linalg::host_based::detail::extract_raw_pointer<T>(A.handle());
+        return qr_host_accessor<T const>(data,
+                                         viennacl::is_row_major<F>::value ? A.internal_size2() : 1,
+                                         viennacl::is_row_major<F>::value ? 1 : A.internal_size1());
+      }
 
-            detail::write_householder_to_A_viennacl(A, v, j+k);
-          }
+      /** @brief Unblocked Householder QR factorization of the rows x cols matrix X in host memory.
+      *
+      * Uses the same conventions as inplace_qr(): The Householder vectors (with implicit unit diagonal) are written below the diagonal,
+      * R is written to the upper triangular part, and betas[k] is the coefficient of the k-th reflector (I - beta_k v_k v_k^T).
+      * If 'use_threads' is true, the rows are distributed over the OpenMP threads, which pays off for tall panels.
+      */
+      template<typename NumericT>
+      void householder_qr_host(qr_host_accessor<NumericT> const & X, vcl_size_t rows, vcl_size_t cols, NumericT * betas, bool use_threads)
+      {
+        vcl_size_t num_chunks = 1;
+#ifdef VIENNACL_WITH_OPENMP
+        if (use_threads)
+          num_chunks = static_cast<vcl_size_t>(omp_get_max_threads());
+#endif
+        (void)use_threads;
+        std::vector<NumericT> partial_sums(num_chunks * (cols + 1));
+
+        vcl_size_t k_max = std::min(rows, cols);
+        for (vcl_size_t k = 0; k < k_max; ++k)
+        {
+          vcl_size_t chunk_size = (rows - k - 1) / num_chunks + 1;
 
           //
-          // Setup Y:
+          // compute norm of column below diagonal:
           //
-          Y.clear();
-          for (vcl_size_t k = 0; k < effective_block_size; ++k)
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (num_chunks > 1)
+#endif
+          for (long chunk = 0; chunk < static_cast<long>(num_chunks); ++chunk)
           {
-            //write Householder to Y:
-            Y(j+k,k) = 1.0;
-            project(Y, range(j+k+1, A.size1()), range(k, k+1)) = project(A, range(j+k+1, A.size1()), range(j+k, j+k+1));
+            vcl_size_t row_begin = std::min(k + 1 + static_cast<vcl_size_t>(chunk) * chunk_size, rows);
+            vcl_size_t row_end   = std::min(row_begin + chunk_size, rows);
+            NumericT sum = 0;
+            for (vcl_size_t i = row_begin; i < row_end; ++i)
+              sum += X(i, k) * X(i, k);
+            partial_sums[static_cast<vcl_size_t>(chunk)] = sum;
           }
 
-          //
-          // Setup W:
-          //
+          NumericT sigma = 0;
+          for (vcl_size_t chunk = 0; chunk < num_chunks; ++chunk)
+            sigma += partial_sums[chunk];
 
-          //first vector:
-          W.clear();
-          W(j, 0) = -betas[j];
-          //project(W, range(j+1, A.size1()), range(0, 1)) = -betas[j] * project(A, range(j+1, A.size1()), range(j, j+1));
-          project(W, range(j+1, A.size1()), range(0, 1)) = project(A, range(j+1, A.size1()), range(j, j+1));
-          project(W, range(j+1, A.size1()), range(0, 1)) *= -betas[j];
+          NumericT A_kk = X(k, k);
+          if (sigma == 0)
+          {
+            betas[k] = 0;
+            continue;
+          }
 
+          NumericT mu = std::sqrt(sigma + A_kk * A_kk);
+          NumericT v1 = (A_kk <= 0) ? (A_kk - mu) : (-sigma / (A_kk + mu));
+          NumericT beta = NumericT(2) * v1 * v1 / (sigma + v1 * v1);
+          betas[k] = beta;
+          X(k, k) = mu;
 
-          //k-th column of W is given by -beta * (Id + W*Y^T) v_k, where W and Y have k-1 columns
-          for (vcl_size_t k = 1; k < effective_block_size; ++k)
+          //
+          // scale Householder vector and compute v^T X(:, l) for the remaining columns l of the panel (loop order depends on the memory layout):
+          //
+          vcl_size_t num_remaining = cols - k - 1;
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (num_chunks > 1)
+#endif
+          for (long chunk = 0; chunk < static_cast<long>(num_chunks); ++chunk)
           {
-            MatrixRange Y_old = project(Y, range(j, A.size1()), range(0, k));
-            MatrixRange v_k   = project(Y, range(j, A.size1()), range(k, k+1));
-            MatrixRange W_old = project(W, range(j, A.size1()), range(0, k));
+            vcl_size_t row_begin = std::min(k + 1 + static_cast<vcl_size_t>(chunk) * chunk_size, rows);
+            vcl_size_t row_end   = std::min(row_begin + chunk_size, rows);
+            NumericT * sums = &(partial_sums[static_cast<vcl_size_t>(chunk) * (cols + 1)]);
+            for (vcl_size_t i = row_begin; i < row_end; ++i)
+              X(i, k) /= v1;
+
+            if (X.column_major())
+            {
+              for (vcl_size_t l = 0; l < num_remaining; ++l)
+              {
+                NumericT sum = 0;
+                for (vcl_size_t i = row_begin; i < row_end; ++i)
+                  sum += X(i, k) * X(i, k + 1 + l);
+                sums[l] = sum;
+              }
+            }
+            else
+            {
+              for (vcl_size_t l = 0; l < num_remaining; ++l)
+                sums[l] = 0;
+              for (vcl_size_t i = row_begin; i < row_end; ++i)
+              {
+                NumericT v_i = X(i, k);
+                for (vcl_size_t l = 0; l < num_remaining; ++l)
+                  sums[l] += v_i * X(i, k + 1 + l);
+              }
+            }
+          }
 
-            project(YT_prod_v, range(0, k), range(0,1)) = prod(trans(Y_old), v_k);
-            project(z, range(j, A.size1()), range(0,1)) = prod(W_old, project(YT_prod_v, range(0, k), range(0,1)));
-            project(W, range(j, A.size1()), range(k, k+1)) = project(z, range(j, A.size1()), range(0,1));
-            project(W, range(j, A.size1()), range(k, k+1)) += v_k;
-            project(W, range(j, A.size1()), range(k, k+1)) *= - betas[j+k];
+          for (vcl_size_t l = 0; l < num_remaining; ++l)
+          {
+            NumericT v_in_col = X(k, k + 1 + l);
+            for (vcl_size_t chunk = 0; chunk < num_chunks; ++chunk)
+              v_in_col += partial_sums[chunk * (cols + 1) + l];
+            partial_sums[l] = beta * v_in_col;   // chunk 0 is no longer needed
+            X(k, k + 1 + l) -= partial_sums[l];
           }
 
           //
-          //apply (I+WY^T)^T = I + Y W^T to the remaining columns of A:
+          // apply reflector to the remaining columns of the panel:
           //
-
-          if (A.size2() > j + effective_block_size)
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (num_chunks > 1)
+#endif
+          for (long chunk = 0; chunk < static_cast<long>(num_chunks); ++chunk)
           {
-
-            MatrixRange A_part(A, range(j, A.size1()), range(j+effective_block_size, A.size2()));
-            MatrixRange W_part(W, range(j, A.size1()), range(0, effective_block_size));
-            MatrixType temp = prod(trans(W_part), A_part);
-
-            A_part += prod(project(Y, range(j, A.size1()), range(0, effective_block_size)),
-                          temp);
+            vcl_size_t row_begin = std::min(k + 1 + static_cast<vcl_size_t>(chunk) * chunk_size, rows);
+            vcl_size_t row_end   = std::min(row_begin + chunk_size, rows);
+            if (X.column_major())
+            {
+              for (vcl_size_t l = 0; l < num_remaining; ++l)
+                for (vcl_size_t i = row_begin; i < row_end; ++i)
+                  X(i, k + 1 + l) -= partial_sums[l] * X(i, k);
+            }
+            else
+            {
+              for (vcl_size_t i = row_begin; i < row_end; ++i)
+              {
+                NumericT v_i = X(i, k);
+                for (vcl_size_t l = 0; l < num_remaining; ++l)
+                  X(i, k + 1 + l) -= partial_sums[l] * v_i;
+              }
+            }
           }
         }
-
-        return betas;
       }
 
+      /** @brief Applies Q^T = (I - beta_{n-1} v_{n-1} v_{n-1}^T) ... (I - beta_0 v_0 v_0^T) to the vector x, where the reflectors are stored in the rows x cols matrix X as computed by householder_qr_host() */
+      template<typename AccessorT, typename NumericT>
+      void householder_apply_trans_Q_host(AccessorT const & X, vcl_size_t rows, vcl_size_t cols, NumericT const * betas, NumericT * x)
+      {
+        vcl_size_t k_max = std::min(rows, cols);
+        for (vcl_size_t k = 0; k < k_max; ++k)
+        {
+          if (betas[k] == 0)
+            continue;
 
+          NumericT v_in_x = x[k];
+          for (vcl_size_t i = k + 1; i < rows; ++i)
+            v_in_x += X(i, k) * x[i];
 
+          v_in_x *= betas[k];
+          x[k] -= v_in_x;
+          for (vcl_size_t i = k + 1; i < rows; ++i)
+            x[i] -= v_in_x * X(i, k);
+        }
+      }
 
+      /** @brief Returns an accessor to the entries of the matrix in host memory. For matrices in other memory domains, the entries are copied to 'buffer' first. */
+      template<typename T, typename F, unsigned int ALIGNMENT>
+      qr_host_accessor<T> qr_read_to_host(viennacl::matrix<T, F, ALIGNMENT> & A, std::vector<T> & buffer)
+      {
+        if (viennacl::traits::active_handle_id(A) == viennacl::MAIN_MEMORY)
+          return qr_host_matrix(A);
+
+        buffer.resize(A.internal_size());
+        viennacl::backend::memory_read(A.handle(), 0, sizeof(T) * A.internal_size(), &(buffer[0]));
+        return qr_host_accessor<T>(&(buffer[0]),
+                                   viennacl::is_row_major<F>::value ? A.internal_size2() : 1,
+                                   viennacl::is_row_major<F>::value ? 1 : A.internal_size1());
+      }
 
+      /** @brief Writes the entries in 'buffer' back to A if A does not reside in host memory. Counterpart of qr_read_to_host(). */
+      template<typename T, typename F, unsigned int ALIGNMENT>
+      void qr_write_from_host(viennacl::matrix<T, F, ALIGNMENT> & A, std::vector<T> const & buffer)
+      {
+        if (viennacl::traits::active_handle_id(A) != viennacl::MAIN_MEMORY)
+          viennacl::backend::memory_write(A.handle(), 0, sizeof(T) * A.internal_size(), &(buffer[0]));
+      }
 
-      //MatrixType is ViennaCL-matrix
-      /** @brief Implementation of a hybrid QR factorization using uBLAS on the CPU and ViennaCL for GPUs (or multi-core CPU)
-      *
-      * Prefer the use of the convenience interface inplace_qr()
+      /** @brief Blocked Householder QR factorization with compact WY representation.
       *
-      * @param A            A dense ViennaCL matrix to be factored
-      * @param block_size   The block size to be used. The number of columns of A must be a multiple of block_size
+      * The reflectors of each panel of width block_size are computed on the host. With V holding the Householder vectors of the panel,
+      * the block reflector is I - V T V^T with upper triangular T. It is applied to the trailing matrix C as C -= V (T^T (V^T C)) via matrix-matrix products,
+      * which are carried out in the memory domain of A.
       */
-      template<typename MatrixType>
-      std::vector< typename viennacl::result_of::cpu_value_type< typename MatrixType::value_type >::type >
-      inplace_qr_hybrid(MatrixType & A, vcl_size_t block_size = 16)
+      template<typename T, typename F, unsigned int ALIGNMENT>
+      std::vector<T> inplace_qr_compact_wy(viennacl::matrix<T, F, ALIGNMENT> & A, vcl_size_t block_size)
       {
-        typedef typename viennacl::result_of::cpu_value_type< typename MatrixType::value_type >::type   ScalarType;
-
-        typedef viennacl::matrix_range<MatrixType>                    VCLMatrixRange;
-        typedef boost::numeric::ublas::matrix<ScalarType>             UblasMatrixType;
-        typedef boost::numeric::ublas::matrix_range<UblasMatrixType>  UblasMatrixRange;
+        typedef viennacl::matrix<T, F, ALIGNMENT>   MatrixType;
+        typedef viennacl::matrix_range<MatrixType>  MatrixRange;
 
-        std::vector<ScalarType> betas(A.size2());
-        UblasMatrixType v(A.size1(), 1);
-        UblasMatrixType matrix_1x1(1,1);
+        vcl_size_t rows = A.size1();
+        vcl_size_t cols = A.size2();
+        vcl_size_t k_max = std::min(rows, cols);
 
-        UblasMatrixType ublasW(A.size1(), block_size); ublasW.clear(); ublasW.resize(A.size1(), block_size);
-        UblasMatrixType ublasY(A.size1(), block_size); ublasY.clear(); ublasY.resize(A.size1(), block_size);
+        std::vector<T> betas(cols);
+        if (k_max == 0)
+          return betas;
 
-        UblasMatrixType ublasA(A.size1(), A.size1());
+        block_size = std::max<vcl_size_t>(1, std::min(block_size, k_max));
 
-        MatrixType vclW(ublasW.size1(), ublasW.size2());
-        MatrixType vclY(ublasY.size1(), ublasY.size2());
+        viennacl::context ctx = viennacl::traits::context(A);
+        MatrixType V(rows, block_size, ctx);      // panel, later holding the Householder vectors with explicit unit diagonal and zeros above
+        MatrixType Tmat(block_size, block_size, ctx);
+        MatrixType G(block_size, block_size, ctx);
+        MatrixType W(block_size, cols, ctx);
+        MatrixType W2(block_size, cols, ctx);
 
+        std::vector<T> V_buffer, T_buffer, G_buffer;
+        Tmat.clear();
 
-        //run over A in a block-wise manner:
-        for (vcl_size_t j = 0; j < std::min(A.size1(), A.size2()); j += block_size)
+        for (vcl_size_t j = 0; j < k_max; j += block_size)
         {
-          vcl_size_t effective_block_size = std::min(std::min(A.size1(), A.size2()), j+block_size) - j;
-          UblasMatrixRange ublasA_part = boost::numeric::ublas::project(ublasA,
-                                                                        boost::numeric::ublas::range(0, A.size1()),
-                                                                        boost::numeric::ublas::range(j, j + effective_block_size));
-          viennacl::copy(viennacl::project(A,
-                                          viennacl::range(0, A.size1()),
-                                          viennacl::range(j, j+effective_block_size)),
-                         ublasA_part
-                        );
+          vcl_size_t nb = std::min(block_size, k_max - j);
+          vcl_size_t panel_rows = rows - j;
 
-          //determine Householder vectors:
-          for (vcl_size_t k = 0; k < effective_block_size; ++k)
-          {
-            betas[j+k] = detail::setup_householder_vector_ublas(ublasA, v, matrix_1x1, j+k);
+          viennacl::range row_range(j, rows);
+          viennacl::range panel_range(0, nb);
+          viennacl::range panel_cols_range(j, j + nb);
 
-            for (vcl_size_t l = k; l < effective_block_size; ++l)
-              detail::householder_reflect_ublas(ublasA, v, matrix_1x1, betas[j+k], j+k, j+l);
+          MatrixRange A_panel(A, row_range, panel_cols_range);
+          MatrixRange V_part(V, row_range, panel_range);
 
-            detail::write_householder_to_A_ublas(ublasA, v, j+k);
-          }
+          //
+          // Panel factorization on the host:
+          //
+          V_part = A_panel;
+          qr_host_accessor<T> V_host = qr_read_to_host(V, V_buffer);
+          householder_qr_host(V_host.offset(j, 0), panel_rows, nb, &(betas[j]), panel_rows * nb > 16384);
+          qr_write_from_host(V, V_buffer);
+          A_panel = V_part;
+
+          if (j + nb >= cols)
+            break;
 
           //
-          // Setup Y:
+          // Set up V:
           //
-          ublasY.clear();  ublasY.resize(A.size1(), block_size);
-          for (vcl_size_t k = 0; k < effective_block_size; ++k)
+          for (vcl_size_t k = 0; k < nb; ++k)
+            for (vcl_size_t i = 0; i <= k; ++i)
+              V_host(j + i, k) = (i == k) ? T(1) : T(0);
+          qr_write_from_host(V, V_buffer);
+
+          //
+          // Set up T from G = V^T V: T(k,k) = beta_k, T(0:k, k) = -beta_k T(0:k, 0:k) V(:, 0:k)^T v_k
+          //
+          MatrixRange G_part(G, panel_range, panel_range);
+          G_part = viennacl::linalg::prod(trans(V_part), V_part);
+
+          qr_host_accessor<T> G_host = qr_read_to_host(G, G_buffer);
+          qr_host_accessor<T> T_host = qr_read_to_host(Tmat, T_buffer);
+          for (vcl_size_t k = 0; k < nb; ++k)
           {
-            //write Householder to Y:
-            ublasY(j+k,k) = 1.0;
-            boost::numeric::ublas::project(ublasY,
-                                           boost::numeric::ublas::range(j+k+1, A.size1()),
-                                           boost::numeric::ublas::range(k, k+1))
-              = boost::numeric::ublas::project(ublasA,
-                                               boost::numeric::ublas::range(j+k+1, A.size1()),
-                                               boost::numeric::ublas::range(j+k, j+k+1));
+            for (vcl_size_t i = 0; i < k; ++i)
+            {
+              T t_ik = 0;
+              for (vcl_size_t l = i; l < k; ++l)
+                t_ik += T_host(i, l) * G_host(l, k);
+              T_host(i, k) = -betas[j + k] * t_ik;
+            }
+            T_host(k, k) = betas[j + k];
+            for (vcl_size_t i = k + 1; i < nb; ++i)
+              T_host(i, k) = 0;
           }
+          qr_write_from_host(Tmat, T_buffer);
 
           //
-          // Setup W:
+          // Apply (I - V T V^T)^T to the trailing matrix C: C -= V (T^T (V^T C))
           //
+          viennacl::range trailing_range(j + nb, cols);
+          viennacl::range W_range(0, cols - j - nb);
 
-          //first vector:
-          ublasW.clear();  ublasW.resize(A.size1(), block_size);
-          ublasW(j, 0) = -betas[j];
-          boost::numeric::ublas::project(ublasW,
-                                        boost::numeric::ublas::range(j+1, A.size1()),
-                                        boost::numeric::ublas::range(0, 1))
-            = -betas[j] * boost::numeric::ublas::project(ublasA,
-                                                          boost::numeric::ublas::range(j+1, A.size1()),
-                                                          boost::numeric::ublas::range(j, j+1));
+          MatrixRange C(A, row_range, trailing_range);
+          MatrixRange W_part(W, panel_range, W_range);
+          MatrixRange W2_part(W2, panel_range, W_range);
+          MatrixRange T_part(Tmat, panel_range, panel_range);
 
+          W_part  = viennacl::linalg::prod(trans(V_part), C);
+          W2_part = viennacl::linalg::prod(trans(T_part), W_part);
+          C -= viennacl::linalg::prod(V_part, W2_part);
+        }
 
-          //k-th column of W is given by -beta * (Id + W*Y^T) v_k, where W and Y have k-1 columns
-          for (vcl_size_t k = 1; k < effective_block_size; ++k)
-          {
-            UblasMatrixRange Y_old = boost::numeric::ublas::project(ublasY,
-                                                                    boost::numeric::ublas::range(j, A.size1()),
-                                                                    boost::numeric::ublas::range(0, k));
-            UblasMatrixRange v_k   = boost::numeric::ublas::project(ublasY,
-                                                                    boost::numeric::ublas::range(j, A.size1()),
-                                                                    boost::numeric::ublas::range(k, k+1));
-            UblasMatrixRange W_old = boost::numeric::ublas::project(ublasW,
-                                                                    boost::numeric::ublas::range(j, A.size1()),
-                                                                    boost::numeric::ublas::range(0, k));
-            UblasMatrixRange z     = boost::numeric::ublas::project(ublasW,
-                                                                    boost::numeric::ublas::range(j, A.size1()),
-                                                                    boost::numeric::ublas::range(k, k+1));
-
-            UblasMatrixType YT_prod_v = boost::numeric::ublas::prod(boost::numeric::ublas::trans(Y_old), v_k);
-            z = - betas[j+k] * (v_k + prod(W_old, YT_prod_v));
-          }
+        return betas;
+      }
 
+      /** @brief Returns the number of row blocks of a level of the TSQR reduction tree with the given number of rows */
+      inline vcl_size_t tsqr_num_blocks(vcl_size_t rows, vcl_size_t block_rows)
+      {
+        return std::max<vcl_size_t>(1, rows / block_rows);
+      }
 
+      /** @brief Factors all row blocks of a level of the TSQR reduction tree and writes their R factors to the column-major matrix 'stacked_R' */
+      template<typename NumericT>
+      void tsqr_factor_level(qr_host_accessor<NumericT> const & X, vcl_size_t rows, vcl_size_t cols, vcl_size_t block_rows,
+                             std::vector<NumericT> & betas, std::vector<NumericT> & stacked_R)
+      {
+        vcl_size_t num_blocks = tsqr_num_blocks(rows, block_rows);
+        betas.resize(num_blocks * cols);
+        stacked_R.resize(num_blocks * cols * cols);
+        vcl_size_t stacked_rows = num_blocks * cols;
 
-          //
-          //apply (I+WY^T)^T = I + Y W^T to the remaining columns of A:
-          //
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for schedule(dynamic) if (num_blocks > 1)
+#endif
+        for (long block2 = 0; block2 < static_cast<long>(num_blocks); ++block2)
+        {
+          vcl_size_t block = static_cast<vcl_size_t>(block2);
+          vcl_size_t row_begin = block * block_rows;
+          vcl_size_t row_end   = (block + 1 == num_blocks) ? rows : row_begin + block_rows;
 
-          VCLMatrixRange A_part = viennacl::project(A,
-                                                    viennacl::range(0, A.size1()),
-                                                    viennacl::range(j, j+effective_block_size));
+          householder_qr_host(X.offset(row_begin, 0), row_end - row_begin, cols, &(betas[block * cols]), false);
 
-          viennacl::copy(boost::numeric::ublas::project(ublasA,
-                                                        boost::numeric::ublas::range(0, A.size1()),
-                                                        boost::numeric::ublas::range(j, j+effective_block_size)),
-                        A_part);
+          for (vcl_size_t j = 0; j < cols; ++j)
+            for (vcl_size_t i = 0; i < cols; ++i)
+              stacked_R[block * cols + i + j * stacked_rows] = (i <= j) ? X(row_begin + i, j) : NumericT(0);
+        }
+      }
 
-          viennacl::copy(ublasW, vclW);
-          viennacl::copy(ublasY, vclY);
+      /** @brief Applies Q^T of all row blocks of a level of the TSQR reduction tree to x and gathers the first 'cols' entries of each block in 'stacked_x' */
+      template<typename AccessorT, typename NumericT>
+      void tsqr_apply_level(AccessorT const & X, vcl_size_t rows, vcl_size_t cols, vcl_size_t block_rows,
+                            std::vector<NumericT> const & betas, NumericT * x, std::vector<NumericT> & stacked_x)
+      {
+        vcl_size_t num_blocks = tsqr_num_blocks(rows, block_rows);
+        stacked_x.resize(num_blocks * cols);
 
-          if (A.size2() > j + effective_block_size)
-          {
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for schedule(dynamic) if (num_blocks > 1)
+#endif
+        for (long block2 = 0; block2 < static_cast<long>(num_blocks); ++block2)
+        {
+          vcl_size_t block = static_cast<vcl_size_t>(block2);
+          vcl_size_t row_begin = block * block_rows;
+          vcl_size_t row_end   = (block + 1 == num_blocks) ? rows : row_begin + block_rows;
 
-            VCLMatrixRange A_part(A, viennacl::range(j, A.size1()), viennacl::range(j+effective_block_size, A.size2()));
-            VCLMatrixRange W_part(vclW, viennacl::range(j, A.size1()), viennacl::range(0, effective_block_size));
-            MatrixType temp = viennacl::linalg::prod(trans(W_part), A_part);
+          householder_apply_trans_Q_host(X.offset(row_begin, 0), row_end - row_begin, cols, &(betas[block * cols]), x + row_begin);
+          for (vcl_size_t i = 0; i < cols; ++i)
+            stacked_x[block * cols + i] = x[row_begin + i];
+        }
+      }
 
-            A_part += viennacl::linalg::prod(viennacl::project(vclY, viennacl::range(j, A.size1()), viennacl::range(0, effective_block_size)),
-                                             temp);
-          }
+      /** @brief Writes the entries of 'stacked_x' back to the first 'cols' entries of each row block of x. Inverse of the gather step in tsqr_apply_level(). */
+      template<typename NumericT>
+      void tsqr_scatter_level(vcl_size_t rows, vcl_size_t cols, vcl_size_t block_rows, std::vector<NumericT> const & stacked_x, NumericT * x)
+      {
+        vcl_size_t num_blocks = tsqr_num_blocks(rows, block_rows);
+        for (vcl_size_t block = 0; block < num_blocks; ++block)
+          for (vcl_size_t i = 0; i < cols; ++i)
+            x[block * block_rows + i] = stacked_x[block * cols + i];
+      }
+
+      /** @brief Tall-skinny QR factorization of a dense matrix in host memory. See inplace_tsqr() for details. */
+      template<typename T, typename F, unsigned int ALIGNMENT>
+      void inplace_tsqr_host(viennacl::matrix<T, F, ALIGNMENT> & A, tsqr_factors<T> & factors)
+      {
+        vcl_size_t rows = A.size1();
+        vcl_size_t cols = A.size2();
+
+        factors.betas.clear();
+        factors.stacked_factors.clear();
+        if (cols == 0)
+          return;
+
+        factors.betas.push_back(std::vector<T>());
+        std::vector<T> stacked_R;
+        tsqr_factor_level(qr_host_matrix(A), rows, cols, factors.block_rows, factors.betas.back(), stacked_R);
+
+        // reduction tree: factor the stacked R factors until a single block remains
+        vcl_size_t level_rows = rows;
+        while (tsqr_num_blocks(level_rows, factors.block_rows) > 1)
+        {
+          level_rows = tsqr_num_blocks(level_rows, factors.block_rows) * cols;
+          factors.stacked_factors.push_back(stacked_R);
+          factors.betas.push_back(std::vector<T>());
+
+          std::vector<T> & level_data = factors.stacked_factors.back();
+          tsqr_factor_level(qr_host_accessor<T>(&(level_data[0]), 1, level_rows), level_rows, cols, factors.block_rows, factors.betas.back(), stacked_R);
         }
 
-        return betas;
+        // the R factor of the last level is the R factor of A:
+        qr_host_accessor<T> A_host = qr_host_matrix(A);
+        for (vcl_size_t j = 0; j < cols; ++j)
+          for (vcl_size_t i = 0; i <= j; ++i)
+            A_host(i, j) = stacked_R[i + j * cols];
       }
 
+      /** @brief Computes Q^T b for a tall-skinny QR factorization of a dense matrix in host memory. See inplace_tsqr_apply_trans_Q() for details. */
+      template<typename T, typename F, unsigned int ALIGNMENT>
+      void inplace_tsqr_apply_trans_Q_host(viennacl::matrix<T, F, ALIGNMENT> const & A, tsqr_factors<T> const & factors, std::vector<T> & b)
+      {
+        vcl_size_t cols = A.size2();
+        vcl_size_t num_levels = factors.betas.size();
+        if (num_levels == 0)
+          return;
+
+        // go up the reduction tree:
+        std::vector<vcl_size_t> level_rows(num_levels);
+        std::vector< std::vector<T> > stacked_b(num_levels);
+        level_rows[0] = A.size1();
+        tsqr_apply_level(qr_host_matrix(A), level_rows[0], cols, factors.block_rows, factors.betas[0], &(b[0]), stacked_b[0]);
+
+        for (vcl_size_t level = 1; level < num_levels; ++level)
+        {
+          level_rows[level] = stacked_b[level - 1].size();
+          std::vector<T> const & level_data = factors.stacked_factors[level - 1];
+          tsqr_apply_level(qr_host_accessor<T const>(&(level_data[0]), 1, level_rows[level]), level_rows[level], cols, factors.block_rows,
+                           factors.betas[level], &(stacked_b[level - 1][0]), stacked_b[level]);
+        }
 
+        // go down the reduction tree:
+        for (vcl_size_t level2 = num_levels - 1; level2 > 0; --level2)
+          tsqr_scatter_level(level_rows[level2 - 1], cols, factors.block_rows, stacked_b[level2 - 1], level2 > 1 ? &(stacked_b[level2 - 2][0]) : &(b[0]));
+      }
 
     } //namespace detail
 
@@ -639,14 +866,87 @@ namespace viennacl
     }
 
     /** @brief Overload of inplace-QR factorization of a ViennaCL matrix A
+     *
+     * Blocked Householder QR with compact WY representation: Panels are factored on the host, the trailing matrix is updated using matrix-matrix products.
+     * The result is compatible with recoverQ() and inplace_qr_apply_trans_Q().
      *
      * @param A            A dense ViennaCL matrix to be factored
      * @param block_size   The block size to be used.
      */
     template<typename T, typename F, unsigned int ALIGNMENT>
-    std::vector<T> inplace_qr(viennacl::matrix<T, F, ALIGNMENT> & A, vcl_size_t block_size = 16)
+    std::vector<T> inplace_qr(viennacl::matrix<T, F, ALIGNMENT> & A, vcl_size_t block_size = 32)
+    {
+      return detail::inplace_qr_compact_wy(A, block_size);
+    }
+
+    /** @brief Tall-skinny QR factorization (TSQR) of a dense ViennaCL matrix A with many more rows than columns.
+     *
+     * The rows of A are split into blocks, which are factored independently (in parallel if OpenMP is enabled).
+     * The R factors of the blocks are stacked and factored again until a single block is left. This requires a single pass over A
+     * and is considerably faster than a column-oriented QR factorization for matrices with a few dozen columns and millions of rows.
+     *
+     * On return, the upper triangular part of A(0:n, 0:n) holds R, while the remaining entries of A and 'factors' hold the implicit representation of Q.
+     * Use inplace_tsqr_apply_trans_Q() to compute Q^T b, e.g. for the solution of least-squares problems.
+     * Note that Householder reflectors in A are *not* compatible with recoverQ() and inplace_qr_apply_trans_Q().
+     *
+     * @param A            A dense ViennaCL matrix with A.size1() >= A.size2() to be factored
+     * @param factors      The Householder coefficients and the factors of the reduction tree. If factors.block_rows is zero, a suitable block size is chosen.
+     */
+    template<typename T, typename F, unsigned int ALIGNMENT>
+    void inplace_tsqr(viennacl::matrix<T, F, ALIGNMENT> & A, tsqr_factors<T> & factors)
     {
-      return detail::inplace_qr_hybrid(A, block_size);
+      assert(A.size1() >= A.size2() && bool("TSQR requires a matrix with at least as many rows as columns"));
+
+      vcl_size_t cols = A.size2();
+      if (factors.block_rows == 0)
+        factors.block_rows = std::max<vcl_size_t>(2 * cols, 32768 / std::max<vcl_size_t>(cols, 1));
+      factors.block_rows = std::max<vcl_size_t>(factors.block_rows, 2 * cols); // each level of the reduction tree must reduce the number of rows
+
+      if (viennacl::traits::active_handle_id(A) == viennacl::MAIN_MEMORY)
+      {
+        detail::inplace_tsqr_host(A, factors);
+        return;
+      }
+
+      viennacl::matrix<T, F, ALIGNMENT> A_host(A.size1(), A.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+      viennacl::backend::memory_read(A.handle(), 0, sizeof(T) * A.internal_size(), viennacl::linalg::host_based::detail::extract_raw_pointer<T>(A_host.handle()));
+      detail::inplace_tsqr_host(A_host, factors);
+      viennacl::backend::memory_write(A.handle(), 0, sizeof(T) * A.internal_size(), viennacl::linalg::host_based::detail::extract_raw_pointer<T>(A_host.handle()));
+    }
+
+    /** @brief Computes Q^T b, where Q is the implicit orthogonal matrix of a tall-skinny QR factorization obtained from inplace_tsqr().
+     *
+     *  The first A.size2() entries of the result are the entries of (Q^T b) with respect to the range of A, i.e. the least-squares solution x of A x = b is obtained from R x = b(0:n).
+     *
+     *  @param A        The matrix as returned by inplace_tsqr()
+     *  @param factors  The factors as returned by inplace_tsqr()
+     *  @param b        The vector b to which the result Q^T b is directly written to
+     */
+    template<typename T, typename F, unsigned int ALIGNMENT>
+    void inplace_tsqr_apply_trans_Q(viennacl::matrix<T, F, ALIGNMENT> const & A, tsqr_factors<T> const & factors, std::vector<T> & b)
+    {
+      assert(b.size() == A.size1() && bool("Size mismatch"));
+
+      if (viennacl::traits::active_handle_id(A) == viennacl::MAIN_MEMORY)
+      {
+        detail::inplace_tsqr_apply_trans_Q_host(A, factors, b);
+        return;
+      }
+
+      viennacl::matrix<T, F, ALIGNMENT> A_host(A.size1(), A.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+      viennacl::backend::memory_read(A.handle(), 0, sizeof(T) * A.internal_size(), viennacl::linalg::host_based::detail::extract_raw_pointer<T>(A_host.handle()));
+      detail::inplace_tsqr_apply_trans_Q_host(A_host, factors, b);
+    }
+
+    template<typename T, typename F, unsigned int ALIGNMENT, unsigned int A2>
+    void inplace_tsqr_apply_trans_Q(viennacl::matrix<T, F, ALIGNMENT> const & A, tsqr_factors<T> const & factors, viennacl::vector<T, A2> & b)
+    {
+      std::vector<T> stl_b(b.size());
+      viennacl::fast_copy(b, stl_b);
+
+      inplace_tsqr_apply_trans_Q(A, factors, stl_b);
+
+      viennacl::fast_copy(stl_b, b);
     }
 
     /** @brief Overload of inplace-QR factorization for a general Boost.uBLAS compatible matrix A
@@ -0,0 +1,813 @@
+#ifndef VIENNACL_LINALG_SPARSE_CHOLESKY_HPP_
+#define VIENNACL_LINALG_SPARSE_CHOLESKY_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/sparse_cholesky.hpp
+    @brief Implementation of a supernodal sparse Cholesky factorization A = L L^T for symmetric positive definite compressed_matrix objects. Computations are carried out in host memory.
+*/
+
+#include <vector>
+#include <map>
+#include <cmath>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/misc/cuthill_mckee.hpp"
+#include "viennacl/misc/nested_dissection.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+  #include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for the supernodal sparse Cholesky factorization. Used for supplying parameters and for dispatching the solve() function
+*/
+class sparse_cholesky_tag
+{
+public:
+
+  enum
+  {
+    natural_ordering = 0,
+    reverse_cuthill_mckee_ordering,
+    nested_dissection_ordering
+  };
+
+  /** @brief The constructor
+  *
+  * @param ordering                     Fill-reducing ordering: natural_ordering, reverse_cuthill_mckee_ordering, or nested_dissection_ordering (default)
+  * @param max_supernode_size           Maximum number of columns per supernode
+  * @param nested_dissection_leaf_size  Subgraphs with at most this number of vertices are not dissected further
+  */
+  sparse_cholesky_tag(int ordering = nested_dissection_ordering,
+                      vcl_size_t max_supernode_size = 128,
+                      vcl_size_t nested_dissection_leaf_size = 64)
+    : ordering_(ordering), max_supernode_size_(max_supernode_size), nested_dissection_leaf_size_(nested_dissection_leaf_size) {}
+
+  /** @brief Returns the fill-reducing ordering */
+  int ordering() const { return ordering_; }
+  /** @brief Sets the fill-reducing ordering */
+  void ordering(int value) { ordering_ = value; }
+
+  /** @brief Returns the maximum number of columns per supernode */
+  vcl_size_t max_supernode_size() const { return max_supernode_size_; }
+  /** @brief Sets the maximum number of columns per supernode */
+  void max_supernode_size(vcl_size_t value) { max_supernode_size_ = std::max<vcl_size_t>(value, 1); }
+
+  /** @brief Returns the size of the subgraphs which are not dissected further by the nested dissection ordering */
+  vcl_size_t nested_dissection_leaf_size() const { return nested_dissection_leaf_size_; }
+  /** @brief Sets the size of the subgraphs which are not dissected further by the nested dissection ordering */
+  void nested_dissection_leaf_size(vcl_size_t value) { nested_dissection_leaf_size_ = value; }
+
+private:
+  int ordering_;
+  vcl_size_t max_supernode_size_;
+  vcl_size_t nested_dissection_leaf_size_;
+};
+
+
+namespace detail
+{
+
+  /** @brief Computes the lower triangular part of W = A * B^T, where A is m x k, B is q x k (q <= m, both column-major with leading dimensions lda and ldb), and W is m x q (column-major).
+  *
+  * Rows of A are processed in blocks such that a block of A stays in cache while being multiplied with all columns of B^T.
+  */
+  template<typename NumericT>
+  void sparse_cholesky_gemm_nt(NumericT const * A, vcl_size_t lda,
+                               NumericT const * B, vcl_size_t ldb,
+                               vcl_size_t m, vcl_size_t q, vcl_size_t k,
+                               NumericT * W)
+  {
+    vcl_size_t const block_size = 128;
+
+    std::fill(W, W + m * q, NumericT(0));
+    for (vcl_size_t block_start = 0; block_start < m; block_start += block_size)
+    {
+      vcl_size_t block_stop = std::min(m, block_start + block_size);
+      for (vcl_size_t c = 0; c < std::min(q, block_stop); ++c)
+      {
+        NumericT * W_col = W + c * m;
+        vcl_size_t row_start = std::max(c, block_start);
+        for (vcl_size_t l = 0; l < k; ++l)
+        {
+          NumericT b = B[c + l * ldb];
+          if (b == 0)
+            continue;
+          NumericT const * A_col = A + l * lda;
+          for (vcl_size_t r = row_start; r < block_stop; ++r)
+            W_col[r] += A_col[r] * b;
+        }
+      }
+    }
+  }
+
+  /** @brief Factors a supernodal panel in place: The nr x nc column-major block [A11; A21] is overwritten by [L11; L21] with A11 = L11 L11^T and L21 = A21 L11^{-T}.
+  *
+  * @return false if the matrix is not positive definite
+  */
+  template<typename NumericT>
+  bool sparse_cholesky_panel(NumericT * L, vcl_size_t nr, vcl_size_t nc)
+  {
+    for (vcl_size_t c = 0; c < nc; ++c)
+    {
+      NumericT * L_col = L + c * nr;
+      for (vcl_size_t k = 0; k < c; ++k)
+      {
+        NumericT factor = L[c + k * nr];
+        if (factor == 0)
+          continue;
+        NumericT const * L_k = L + k * nr;
+        for (vcl_size_t r = c; r < nr; ++r)
+          L_col[r] -= L_k[r] * factor;
+      }
+
+      if (!(L_col[c] > 0))
+        return false;
+
+      NumericT diag = std::sqrt(L_col[c]);
+      L_col[c] = diag;
+      for (vcl_size_t r = c + 1; r < nr; ++r)
+        L_col[r] /= diag;
+    }
+    return true;
+  }
+
+  /** @brief Sets up the strictly lower triangular pattern of P (A + A^T) P^T row by row, where P is given by the inverse permutation 'iperm' (iperm[old] = new). Column indices may be duplicated. */
+  inline void sparse_cholesky_lower_pattern(vcl_size_t n,
+                                            unsigned int const * row_buffer, unsigned int const * col_buffer,
+                                            std::vector<vcl_size_t> const & iperm,
+                                            std::vector<vcl_size_t> & offsets, std::vector<vcl_size_t> & cols)
+  {
+    offsets.assign(n + 1, 0);
+    for (vcl_size_t row = 0; row < n; ++row)
+      for (vcl_size_t k = row_buffer[row]; k < row_buffer[row+1]; ++k)
+      {
+        vcl_size_t i = iperm[row];
+        vcl_size_t j = iperm[col_buffer[k]];
+        if (i != j)
+          ++offsets[std::max(i, j) + 1];
+      }
+    for (vcl_size_t i = 0; i < n; ++i)
+      offsets[i+1] += offsets[i];
+
+    cols.resize(offsets[n]);
+    std::vector<vcl_size_t> insert_pos(offsets.begin(), offsets.end() - 1);
+    for (vcl_size_t row = 0; row < n; ++row)
+      for (vcl_size_t k = row_buffer[row]; k < row_buffer[row+1]; ++k)
+      {
+        vcl_size_t i = iperm[row];
+        vcl_size_t j = iperm[col_buffer[k]];
+        if (i != j)
+          cols[insert_pos[std::max(i, j)]++] = std::min(i, j);
+      }
+  }
+
+  /** @brief Computes the elimination tree from the strictly lower triangular pattern (Liu's algorithm with path compression). Roots have parent n. */
+  inline void sparse_cholesky_etree(vcl_size_t n, std::vector<vcl_size_t> const & offsets, std::vector<vcl_size_t> const & cols, std::vector<vcl_size_t> & parent)
+  {
+    parent.assign(n, n);
+    std::vector<vcl_size_t> ancestor(n, n);
+    for (vcl_size_t i = 0; i < n; ++i)
+      for (vcl_size_t k = offsets[i]; k < offsets[i+1]; ++k)
+      {
+        vcl_size_t r = cols[k];
+        while (ancestor[r] != n && ancestor[r] != i)
+        {
+          vcl_size_t t = ancestor[r];
+          ancestor[r] = i;
+          r = t;
+        }
+        if (ancestor[r] == n)
+        {
+          ancestor[r] = i;
+          parent[r] = i;
+        }
+      }
+  }
+
+  /** @brief Computes a postordering of the elimination tree: post[k] is the k-th node in postorder. */
+  inline void sparse_cholesky_postorder(vcl_size_t n, std::vector<vcl_size_t> const & parent, std::vector<vcl_size_t> & post)
+  {
+    std::vector<vcl_size_t> first_child(n + 1, n);
+    std::vector<vcl_size_t> next_sibling(n, n);
+    for (vcl_size_t j2 = 0; j2 < n; ++j2)
+    {
+      vcl_size_t j = n - j2 - 1;    // reverse order results in children sorted ascendingly
+      next_sibling[j] = first_child[parent[j]];
+      first_child[parent[j]] = j;
+    }
+
+    post.clear();
+    post.reserve(n);
+    std::vector<vcl_size_t> stack;
+    for (vcl_size_t root = first_child[n]; root != n; root = next_sibling[root])
+    {
+      stack.push_back(root);
+      while (!stack.empty())
+      {
+        vcl_size_t node = stack.back();
+        if (first_child[node] != n)  // descend into first unvisited child
+        {
+          vcl_size_t child = first_child[node];
+          first_child[node] = next_sibling[child];
+          stack.push_back(child);
+        }
+        else
+        {
+          post.push_back(node);
+          stack.pop_back();
+        }
+      }
+    }
+  }
+
+} //namespace detail
+
+
+/** @brief Supernodal sparse Cholesky factorization A = P^T L L^T P of a symmetric positive definite compressed_matrix.
+*
+* The factorization consists of a symbolic analysis (fill-reducing ordering, elimination tree, supernodes, and the sparsity pattern of L),
+* which only depends on the sparsity pattern of A and is reused by subsequent numeric factorizations, and the numeric factorization.
+* The numeric factorization is left-looking: Each supernode gathers the updates from its descendants by dense matrix-matrix products
+* and then factors its dense panel. All supernodes on the same level of the supernodal elimination tree are processed in parallel, as are the triangular solves.
+*
+* Both triangles of A need to be stored. All computations are carried out in host memory.
+*/
+template<typename NumericT>
+class sparse_cholesky
+{
+public:
+  sparse_cholesky(sparse_cholesky_tag const & tag = sparse_cholesky_tag()) : tag_(tag), size_(0), factorized_(false) {}
+
+  /** @brief Runs the symbolic analysis and the numeric factorization of A */
+  template<unsigned int AlignmentV>
+  sparse_cholesky(viennacl::compressed_matrix<NumericT, AlignmentV> const & A, sparse_cholesky_tag const & tag = sparse_cholesky_tag()) : tag_(tag), size_(0), factorized_(false)
+  {
+    factorize(A);
+  }
+
+  /** @brief Runs the symbolic analysis for the sparsity pattern of A. */
+  template<unsigned int AlignmentV>
+  void analyze(viennacl::compressed_matrix<NumericT, AlignmentV> const & A)
+  {
+    if (viennacl::traits::context(A).memory_type() == viennacl::MAIN_MEMORY)
+      analyze_impl(A);
+    else
+    {
+      viennacl::compressed_matrix<NumericT, AlignmentV> A_host(A.size1(), A.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+      A_host = A;
+      analyze_impl(A_host);
+    }
+  }
+
+  /** @brief Computes the numeric factorization of A. The symbolic analysis is reused if the sparsity pattern of A is the same as in the last analysis and carried out otherwise. */
+  template<unsigned int AlignmentV>
+  void factorize(viennacl::compressed_matrix<NumericT, AlignmentV> const & A)
+  {
+    if (viennacl::traits::context(A).memory_type() == viennacl::MAIN_MEMORY)
+      factorize_impl(A);
+    else
+    {
+      viennacl::compressed_matrix<NumericT, AlignmentV> A_host(A.size1(), A.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+      A_host = A;
+      factorize_impl(A_host);
+    }
+  }
+
+  /** @brief Solves A x = vec, overwriting vec with x */
+  void solve(viennacl::vector<NumericT> & vec) const
+  {
+    assert(factorized_ && bool("Sparse Cholesky factorization not computed!"));
+    assert(vec.size() == size_ && bool("Size mismatch"));
+
+    viennacl::context old_context = viennacl::traits::context(vec);
+    bool on_host = (old_context.memory_type() == viennacl::MAIN_MEMORY);
+    if (!on_host)
+      viennacl::switch_memory_context(vec, viennacl::context(viennacl::MAIN_MEMORY));
+
+    NumericT * data_vec = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec.handle()) + vec.start();
+    vcl_size_t inc_vec = vec.stride();
+
+    std::vector<NumericT> x(size_);
+    for (vcl_size_t k = 0; k < size_; ++k)
+      x[k] = data_vec[perm_[k] * inc_vec];
+
+    if (size_ > 0)
+    {
+      solve_lower(&(x[0]));
+      solve_upper(&(x[0]));
+    }
+
+    for (vcl_size_t k = 0; k < size_; ++k)
+      data_vec[perm_[k] * inc_vec] = x[k];
+
+    if (!on_host)
+      viennacl::switch_memory_context(vec, old_context);
+  }
+
+  /** @brief Applies the inverse of the factored matrix to the vector. Allows to use the factorization as a preconditioner, e.g. of a slightly perturbed system. */
+  void apply(viennacl::vector<NumericT> & vec) const { solve(vec); }
+
+  /** @brief Returns the number of rows of the factored matrix */
+  vcl_size_t size() const { return size_; }
+  /** @brief Returns the number of nonzeros in the factor L (including the diagonal) */
+  vcl_size_t nnz() const
+  {
+    vcl_size_t result = 0;
+    for (vcl_size_t s = 0; s + 1 < sn_start_.size(); ++s)
+    {
+      vcl_size_t nc = sn_start_[s+1] - sn_start_[s];
+      vcl_size_t nr = sn_row_offsets_[s+1] - sn_row_offsets_[s];
+      result += nr * nc - (nc * (nc - 1)) / 2;
+    }
+    return result;
+  }
+  /** @brief Returns the number of supernodes */
+  vcl_size_t supernodes() const { return sn_start_.size() > 0 ? sn_start_.size() - 1 : 0; }
+  /** @brief Returns the number of levels of the supernodal elimination tree, i.e. the number of parallel steps of the factorization and of each triangular solve */
+  vcl_size_t levels() const { return level_offsets_.size() > 0 ? level_offsets_.size() - 1 : 0; }
+  /** @brief Returns the fill-reducing permutation: Row k of the factor corresponds to row permutation()[k] of A */
+  std::vector<vcl_size_t> const & permutation() const { return perm_; }
+
+private:
+
+  template<unsigned int AlignmentV>
+  void analyze_impl(viennacl::compressed_matrix<NumericT, AlignmentV> const & A)
+  {
+    assert(A.size1() == A.size2() && bool("Sparse Cholesky factorization requires a square matrix"));
+
+    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+    unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+    vcl_size_t n = A.size1();
+    size_ = n;
+    factorized_ = false;
+    A_row_buffer_.assign(row_buffer, row_buffer + n + 1);
+    A_col_buffer_.assign(col_buffer, col_buffer + row_buffer[n]);
+
+    //
+    // Step 1: Fill-reducing ordering
+    //
+    std::vector<vcl_size_t> iperm(n);
+    if (tag_.ordering() == sparse_cholesky_tag::natural_ordering)
+    {
+      for (vcl_size_t i = 0; i < n; ++i)
+        iperm[i] = i;
+    }
+    else
+    {
+      std::vector< std::map<unsigned int, NumericT> > graph(n);
+      for (vcl_size_t row = 0; row < n; ++row)
+      {
+        graph[row][static_cast<unsigned int>(row)] = NumericT(1);
+        for (vcl_size_t k = row_buffer[row]; k < row_buffer[row+1]; ++k)
+        {
+          graph[row][col_buffer[k]] = NumericT(1);
+          graph[col_buffer[k]][static_cast<unsigned int>(row)] = NumericT(1);
+        }
+      }
+
+      std::vector<unsigned int> r;
+      if (tag_.ordering() == sparse_cholesky_tag::reverse_cuthill_mckee_ordering)
+      {
+        r = viennacl::reorder(graph, viennacl::cuthill_mckee_tag());
+        for (vcl_size_t i = 0; i < n; ++i)
+          r[i] = static_cast<unsigned int>(n - 1 - r[i]);
+      }
+      else
+        r = viennacl::reorder(graph, viennacl::nested_dissection_tag(tag_.nested_dissection_leaf_size()));
+
+      for (vcl_size_t i = 0; i < n; ++i)
+        iperm[i] = r[i];
+    }
+
+    //
+    // Step 2: Elimination tree, postordered such that the columns of each supernode are numbered consecutively
+    //
+    std::vector<vcl_size_t> lower_offsets, lower_cols, parent, post;
+    detail::sparse_cholesky_lower_pattern(n, row_buffer, col_buffer, iperm, lower_offsets, lower_cols);
+    detail::sparse_cholesky_etree(n, lower_offsets, lower_cols, parent);
+    detail::sparse_cholesky_postorder(n, parent, post);
+
+    std::vector<vcl_size_t> perm(n);
+    for (vcl_size_t i = 0; i < n; ++i)
+      perm[iperm[i]] = i;
+    perm_.resize(n);
+    for (vcl_size_t k = 0; k < n; ++k)
+      perm_[k] = perm[post[k]];
+    for (vcl_size_t k = 0; k < n; ++k)
+      iperm[perm_[k]] = k;
+
+    detail::sparse_cholesky_lower_pattern(n, row_buffer, col_buffer, iperm, lower_offsets, lower_cols);
+    detail::sparse_cholesky_etree(n, lower_offsets, lower_cols, parent);
+
+    //
+    // Step 3: Column structure of L by traversing the row subtrees of the elimination tree (strictly lower part, rows sorted ascendingly)
+    //
+    std::vector<vcl_size_t> col_offsets(n + 1, 0);
+    std::vector<vcl_size_t> mark(n, n);
+    for (vcl_size_t i = 0; i < n; ++i)
+    {
+      mark[i] = i;
+      for (vcl_size_t k = lower_offsets[i]; k < lower_offsets[i+1]; ++k)
+        for (vcl_size_t j = lower_cols[k]; mark[j] != i; j = parent[j])
+        {
+          ++col_offsets[j + 1];
+          mark[j] = i;
+        }
+    }
+    for (vcl_size_t j = 0; j < n; ++j)
+      col_offsets[j+1] += col_offsets[j];
+
+    std::vector<vcl_size_t> col_rows(col_offsets[n]);
+    std::vector<vcl_size_t> insert_pos(col_offsets.begin(), col_offsets.end() - 1);
+    std::fill(mark.begin(), mark.end(), n);
+    for (vcl_size_t i = 0; i < n; ++i)
+    {
+      mark[i] = i;
+      for (vcl_size_t k = lower_offsets[i]; k < lower_offsets[i+1]; ++k)
+        for (vcl_size_t j = lower_cols[k]; mark[j] != i; j = parent[j])
+        {
+          col_rows[insert_pos[j]++] = i;
+          mark[j] = i;
+        }
+    }
+
+    //
+    // Step 4: Supernodes: Column j is merged with column j-1 if the structure of column j-1 is {j-1} and the structure of column j
+    //
+    sn_start_.clear();
+    for (vcl_size_t j = 0; j < n; ++j)
+    {
+      bool merge = j > 0
+                && parent[j-1] == j
+                && col_offsets[j] - col_offsets[j-1] == col_offsets[j+1] - col_offsets[j] + 1
+                && j - sn_start_.back() < tag_.max_supernode_size();
+      if (!merge)
+        sn_start_.push_back(j);
+    }
+    sn_start_.push_back(n);
+    vcl_size_t num_sn = sn_start_.size() - 1;
+
+    col_to_sn_.resize(n);
+    for (vcl_size_t s = 0; s < num_sn; ++s)
+      for (vcl_size_t j = sn_start_[s]; j < sn_start_[s+1]; ++j)
+        col_to_sn_[j] = s;
+
+    // row structure of each supernode: structure of its first column
+    sn_row_offsets_.assign(num_sn + 1, 0);
+    sn_value_offsets_.assign(num_sn + 1, 0);
+    for (vcl_size_t s = 0; s < num_sn; ++s)
+    {
+      vcl_size_t f = sn_start_[s];
+      vcl_size_t nr = 1 + col_offsets[f+1] - col_offsets[f];
+      sn_row_offsets_[s+1] = sn_row_offsets_[s] + nr;
+      sn_value_offsets_[s+1] = sn_value_offsets_[s] + nr * (sn_start_[s+1] - f);
+    }
+    sn_rows_.resize(sn_row_offsets_[num_sn]);
+    for (vcl_size_t s = 0; s < num_sn; ++s)
+    {
+      vcl_size_t f = sn_start_[s];
+      vcl_size_t offset = sn_row_offsets_[s];
+      sn_rows_[offset] = f;
+      std::copy(col_rows.begin() + static_cast<long>(col_offsets[f]), col_rows.begin() + static_cast<long>(col_offsets[f+1]), sn_rows_.begin() + static_cast<long>(offset + 1));
+    }
+
+    //
+    // Step 5: For each supernode J the list of supernodes K with nonzeros in the rows of J (these update J)
+    //
+    sn_update_offsets_.assign(num_sn + 1, 0);
+    for (int pass = 0; pass < 2; ++pass)
+    {
+      std::vector<vcl_size_t> fill_pos(sn_update_offsets_.begin(), sn_update_offsets_.end() - 1);
+      for (vcl_size_t K = 0; K < num_sn; ++K)
+      {
+        vcl_size_t last_target = num_sn;
+        vcl_size_t nc = sn_start_[K+1] - sn_start_[K];
+        for (vcl_size_t k = sn_row_offsets_[K] + nc; k < sn_row_offsets_[K+1]; ++k)
+        {
+          vcl_size_t J = col_to_sn_[sn_rows_[k]];
+          if (J == last_target)
+            continue;
+          last_target = J;
+          if (pass == 0)
+            ++sn_update_offsets_[J + 1];
+          else
+            sn_updates_[fill_pos[J]++] = K;
+        }
+      }
+
+      if (pass == 0)
+      {
+        for (vcl_size_t s = 0; s < num_sn; ++s)
+          sn_update_offsets_[s+1] += sn_update_offsets_[s];
+        sn_updates_.resize(sn_update_offsets_[num_sn]);
+      }
+    }
+
+    //
+    // Step 6: Levels of the supernodal elimination tree (leaves first). Supernodes on the same level are independent.
+    //
+    std::vector<vcl_size_t> sn_level(num_sn, 0);
+    vcl_size_t num_levels = (num_sn > 0) ? 1 : 0;
+    for (vcl_size_t s = 0; s < num_sn; ++s)
+    {
+      vcl_size_t parent_col = parent[sn_start_[s+1] - 1];
+      if (parent_col < n)
+      {
+        vcl_size_t parent_sn = col_to_sn_[parent_col];
+        sn_level[parent_sn] = std::max(sn_level[parent_sn], sn_level[s] + 1);
+        num_levels = std::max(num_levels, sn_level[parent_sn] + 1);
+      }
+    }
+    level_offsets_.assign(num_levels + 1, 0);
+    for (vcl_size_t s = 0; s < num_sn; ++s)
+      ++level_offsets_[sn_level[s] + 1];
+    for (vcl_size_t l = 0; l < num_levels; ++l)
+      level_offsets_[l+1] += level_offsets_[l];
+    level_sn_.resize(num_sn);
+    std::vector<vcl_size_t> level_pos(level_offsets_.begin(), level_offsets_.end() - 1);
+    for (vcl_size_t s = 0; s < num_sn; ++s)
+      level_sn_[level_pos[sn_level[s]]++] = s;
+
+    //
+    // Step 7: Positions of the entries of A in the supernodal storage of L (entries in the upper triangle are skipped)
+    //
+    vcl_size_t const skip = sn_value_offsets_[num_sn];
+    assembly_map_.resize(row_buffer[n]);
+    for (vcl_size_t row = 0; row < n; ++row)
+      for (vcl_size_t k = row_buffer[row]; k < row_buffer[row+1]; ++k)
+      {
+        vcl_size_t i = iperm[row];
+        vcl_size_t j = iperm[col_buffer[k]];
+        if (i < j)
+        {
+          assembly_map_[k] = skip;
+          continue;
+        }
+        vcl_size_t J = col_to_sn_[j];
+        vcl_size_t const * rows_begin = &(sn_rows_[0]) + sn_row_offsets_[J];
+        vcl_size_t const * rows_end   = &(sn_rows_[0]) + sn_row_offsets_[J+1];
+        vcl_size_t local_row = static_cast<vcl_size_t>(std::lower_bound(rows_begin, rows_end, i) - rows_begin);
+        assembly_map_[k] = sn_value_offsets_[J] + (j - sn_start_[J]) * static_cast<vcl_size_t>(rows_end - rows_begin) + local_row;
+      }
+  }
+
+  template<unsigned int AlignmentV>
+  void factorize_impl(viennacl::compressed_matrix<NumericT, AlignmentV> const & A)
+  {
+    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+    unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+    NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+
+    // rerun the symbolic analysis if the sparsity pattern has changed:
+    if (A.size1() != size_
+        || A_col_buffer_.size() != row_buffer[A.size1()]
+        || !std::equal(A_row_buffer_.begin(), A_row_buffer_.end(), row_buffer)
+        || !std::equal(A_col_buffer_.begin(), A_col_buffer_.end(), col_buffer))
+      analyze_impl(A);
+
+    factorized_ = false;
+    vcl_size_t num_sn = supernodes();
+    vcl_size_t const skip = sn_value_offsets_[num_sn];
+
+    values_.assign(skip + 1, NumericT(0));  // last entry collects the skipped entries of the upper triangle
+    for (vcl_size_t k = 0; k < assembly_map_.size(); ++k)
+      values_[assembly_map_[k]] += elements[k];
+
+    bool success = true;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    {
+      std::vector<vcl_size_t> relative_index(size_);
+      std::vector<NumericT> W;
+
+      for (vcl_size_t level = 0; level < levels(); ++level)
+      {
+        long level_start = static_cast<long>(level_offsets_[level]);
+        long level_stop  = static_cast<long>(level_offsets_[level+1]);
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp for schedule(dynamic)
+#endif
+        for (long k = level_start; k < level_stop; ++k)
+        {
+          if (!factorize_supernode(level_sn_[static_cast<vcl_size_t>(k)], relative_index, W))
+          {
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp critical
+#endif
+            success = false;
+          }
+        }
+      }
+    }
+
+    if (!success)
+      throw "ViennaCL: Matrix not positive definite in sparse Cholesky factorization!";
+    factorized_ = true;
+  }
+
+  /** @brief Gathers the updates from all descendants and factors the panel of supernode J */
+  bool factorize_supernode(vcl_size_t J, std::vector<vcl_size_t> & relative_index, std::vector<NumericT> & W)
+  {
+    vcl_size_t f  = sn_start_[J];
+    vcl_size_t nc = sn_start_[J+1] - f;
+    vcl_size_t nr = sn_row_offsets_[J+1] - sn_row_offsets_[J];
+    vcl_size_t const * rows_J = &(sn_rows_[0]) + sn_row_offsets_[J];
+    NumericT * L_J = &(values_[0]) + sn_value_offsets_[J];
+
+    for (vcl_size_t t = 0; t < nr; ++t)
+      relative_index[rows_J[t]] = t;
+
+    for (vcl_size_t u = sn_update_offsets_[J]; u < sn_update_offsets_[J+1]; ++u)
+    {
+      vcl_size_t K = sn_updates_[u];
+      vcl_size_t nc_K = sn_start_[K+1] - sn_start_[K];
+      vcl_size_t nr_K = sn_row_offsets_[K+1] - sn_row_offsets_[K];
+      vcl_size_t const * rows_K = &(sn_rows_[0]) + sn_row_offsets_[K];
+      NumericT const * L_K = &(values_[0]) + sn_value_offsets_[K];
+
+      // rows p1, ..., p2-1 of K are located in the columns of J, rows p1, ..., nr_K-1 in the structure of J
+      vcl_size_t p1 = static_cast<vcl_size_t>(std::lower_bound(rows_K + nc_K, rows_K + nr_K, f) - rows_K);
+      vcl_size_t p2 = static_cast<vcl_size_t>(std::lower_bound(rows_K + p1, rows_K + nr_K, f + nc) - rows_K);
+      vcl_size_t m = nr_K - p1;
+      vcl_size_t q = p2 - p1;
+
+      W.resize(m * q);
+      detail::sparse_cholesky_gemm_nt(L_K + p1, nr_K, L_K + p1, nr_K, m, q, nc_K, &(W[0]));
+
+      for (vcl_size_t c = 0; c < q; ++c)
+      {
+        NumericT * L_J_col = L_J + (rows_K[p1 + c] - f) * nr;
+        NumericT const * W_col = &(W[0]) + c * m;
+        for (vcl_size_t r = c; r < m; ++r)
+          L_J_col[relative_index[rows_K[p1 + r]]] -= W_col[r];
+      }
+    }
+
+    return detail::sparse_cholesky_panel(L_J, nr, nc);
+  }
+
+  /** @brief Forward substitution L y = x, overwriting x with y. Supernodes on the same level are processed in parallel. */
+  void solve_lower(NumericT * x) const
+  {
+    for (vcl_size_t level = 0; level < levels(); ++level)
+    {
+      long level_start = static_cast<long>(level_offsets_[level]);
+      long level_stop  = static_cast<long>(level_offsets_[level+1]);
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for schedule(dynamic) if (level_stop - level_start > 1)
+#endif
+      for (long k = level_start; k < level_stop; ++k)
+      {
+        vcl_size_t J  = level_sn_[static_cast<vcl_size_t>(k)];
+        vcl_size_t f  = sn_start_[J];
+        vcl_size_t nc = sn_start_[J+1] - f;
+        vcl_size_t nr = sn_row_offsets_[J+1] - sn_row_offsets_[J];
+        NumericT const * L_J = &(values_[0]) + sn_value_offsets_[J];
+
+        // gather contributions of the descendants:
+        for (vcl_size_t u = sn_update_offsets_[J]; u < sn_update_offsets_[J+1]; ++u)
+        {
+          vcl_size_t K = sn_updates_[u];
+          vcl_size_t f_K  = sn_start_[K];
+          vcl_size_t nc_K = sn_start_[K+1] - f_K;
+          vcl_size_t nr_K = sn_row_offsets_[K+1] - sn_row_offsets_[K];
+          vcl_size_t const * rows_K = &(sn_rows_[0]) + sn_row_offsets_[K];
+          NumericT const * L_K = &(values_[0]) + sn_value_offsets_[K];
+
+          vcl_size_t p1 = static_cast<vcl_size_t>(std::lower_bound(rows_K + nc_K, rows_K + nr_K, f) - rows_K);
+          vcl_size_t p2 = static_cast<vcl_size_t>(std::lower_bound(rows_K + p1, rows_K + nr_K, f + nc) - rows_K);
+          for (vcl_size_t c = 0; c < nc_K; ++c)
+          {
+            NumericT x_c = x[f_K + c];
+            if (x_c == 0)
+              continue;
+            NumericT const * L_K_col = L_K + c * nr_K;
+            for (vcl_size_t r = p1; r < p2; ++r)
+              x[rows_K[r]] -= L_K_col[r] * x_c;
+          }
+        }
+
+        // triangular solve with the diagonal block:
+        for (vcl_size_t c = 0; c < nc; ++c)
+        {
+          NumericT const * L_J_col = L_J + c * nr;
+          NumericT x_c = x[f + c] / L_J_col[c];
+          x[f + c] = x_c;
+          for (vcl_size_t r = c + 1; r < nc; ++r)
+            x[f + r] -= L_J_col[r] * x_c;
+        }
+      }
+    }
+  }
+
+  /** @brief Backward substitution L^T x = y, overwriting y with x. Supernodes on the same level are processed in parallel. */
+  void solve_upper(NumericT * x) const
+  {
+    for (vcl_size_t level2 = 0; level2 < levels(); ++level2)
+    {
+      vcl_size_t level = levels() - level2 - 1;
+      long level_start = static_cast<long>(level_offsets_[level]);
+      long level_stop  = static_cast<long>(level_offsets_[level+1]);
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for schedule(dynamic) if (level_stop - level_start > 1)
+#endif
+      for (long k = level_start; k < level_stop; ++k)
+      {
+        vcl_size_t J  = level_sn_[static_cast<vcl_size_t>(k)];
+        vcl_size_t f  = sn_start_[J];
+        vcl_size_t nc = sn_start_[J+1] - f;
+        vcl_size_t nr = sn_row_offsets_[J+1] - sn_row_offsets_[J];
+        vcl_size_t const * rows_J = &(sn_rows_[0]) + sn_row_offsets_[J];
+        NumericT const * L_J = &(values_[0]) + sn_value_offsets_[J];
+
+        for (vcl_size_t c2 = 0; c2 < nc; ++c2)
+        {
+          vcl_size_t c = nc - c2 - 1;
+          NumericT const * L_J_col = L_J + c * nr;
+          NumericT value = x[f + c];
+          for (vcl_size_t r = c + 1; r < nr; ++r)
+            value -= L_J_col[r] * x[rows_J[r]];
+          x[f + c] = value / L_J_col[c];
+        }
+      }
+    }
+  }
+
+  sparse_cholesky_tag tag_;
+  vcl_size_t size_;
+  bool factorized_;
+
+  // sparsity pattern of the last analysis:
+  std::vector<unsigned int> A_row_buffer_;
+  std::vector<unsigned int> A_col_buffer_;
+
+  // symbolic analysis:
+  std::vector<vcl_size_t> perm_;               // row k of L corresponds to row perm_[k] of A
+  std::vector<vcl_size_t> sn_start_;           // first column of each supernode
+  std::vector<vcl_size_t> col_to_sn_;
+  std::vector<vcl_size_t> sn_row_offsets_;
+  std::vector<vcl_size_t> sn_rows_;            // row indices of each supernode, starting with its own columns
+  std::vector<vcl_size_t> sn_value_offsets_;   // each supernode is stored as a dense column-major block
+  std::vector<vcl_size_t> sn_update_offsets_;
+  std::vector<vcl_size_t> sn_updates_;         // descendants updating each supernode
+  std::vector<vcl_size_t> level_offsets_;
+  std::vector<vcl_size_t> level_sn_;           // supernodes sorted by level
+  std::vector<vcl_size_t> assembly_map_;
+
+  // numeric factorization:
+  std::vector<NumericT> values_;
+};
+
+
+/** @brief Solves the symmetric positive definite system A x = rhs by a supernodal sparse Cholesky factorization.
+*
+* In order to reuse the factorization (or its symbolic analysis) for several right hand sides or matrices with the same sparsity pattern, use the class sparse_cholesky directly.
+*
+* @param A      The system matrix (both triangles stored)
+* @param rhs    The right hand side
+* @param tag    Parameters for the factorization
+* @return The solution vector
+*/
+template<typename NumericT, unsigned int AlignmentV>
+viennacl::vector<NumericT> solve(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                                 viennacl::vector<NumericT> const & rhs,
+                                 sparse_cholesky_tag const & tag)
+{
+  sparse_cholesky<NumericT> factorization(A, tag);
+  viennacl::vector<NumericT> result(rhs);
+  factorization.solve(result);
+  return result;
+}
+
+}
+}
+
+#endif
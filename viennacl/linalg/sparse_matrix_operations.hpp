@@ -201,6 +201,45 @@ namespace viennacl
       }
     }
 
+    // A * B with both sparse
+    /** @brief Carries out the sparse matrix-sparse matrix product C = prod(A, B) for compressed matrices
+    *
+    * The sparsity pattern of C is computed from the patterns of A and B. Any previous content of C is discarded.
+    * At present, there are no OpenCL and CUDA kernels for this operation, hence the product is computed on the host for these backends.
+    *
+    * @param A   The left hand side sparse matrix
+    * @param B   The right hand side sparse matrix
+    * @param C   The result matrix (sparse)
+    */
+    template<typename NumericT, unsigned int AlignmentV>
+    void prod_impl(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                   viennacl::compressed_matrix<NumericT, AlignmentV> const & B,
+                   viennacl::compressed_matrix<NumericT, AlignmentV> & C)
+    {
+      assert( (A.size2() == B.size1()) && bool("Size check failed for compressed matrix - compressed matrix product: size2(A) != size1(B)"));
+
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::prod_impl(A, B, C);
+          break;
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+        {
+          // compute on the host and transfer the result back:
+          viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+          viennacl::compressed_matrix<NumericT, AlignmentV> A_host(A.size1(), A.size2(), host_ctx);
+          viennacl::compressed_matrix<NumericT, AlignmentV> B_host(B.size1(), B.size2(), host_ctx);
+          viennacl::compressed_matrix<NumericT, AlignmentV> C_host(0, 0, host_ctx);
+          A_host = A;
+          B_host = B;
+          viennacl::linalg::host_based::prod_impl(A_host, B_host, C_host);
+          C = C_host;
+        }
+      }
+    }
+
     /** @brief Carries out triangular inplace solves
     *
     * @param mat    The matrix
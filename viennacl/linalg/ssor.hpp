@@ -0,0 +1,324 @@
+#ifndef VIENNACL_LINALG_SSOR_HPP_
+#define VIENNACL_LINALG_SSOR_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/ssor.hpp
+    @brief Implementation of a multicolor Gauss-Seidel/SOR/SSOR preconditioner and smoother for compressed_matrix
+*/
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/traits/clear.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/sparse_matrix_operations.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+  #include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for the multicolor SSOR preconditioner
+*/
+class ssor_tag
+{
+public:
+  /** @brief The constructor
+  *
+  * @param omega       The relaxation parameter in (0, 2). A value of 1 results in (symmetric) Gauss-Seidel.
+  * @param sweeps      The number of sweeps per application of the preconditioner
+  * @param symmetric   If true (default), each forward sweep is followed by a backward sweep (SSOR), resulting in a symmetric preconditioner suitable for CG. Otherwise only forward sweeps are carried out (SOR).
+  */
+  ssor_tag(double omega = 1.0, unsigned int sweeps = 1, bool symmetric = true) : omega_(omega), sweeps_(sweeps), symmetric_(symmetric) {}
+
+  /** @brief Returns the relaxation parameter */
+  double omega() const { return omega_; }
+  /** @brief Sets the relaxation parameter. Values outside (0, 2) are ignored. */
+  void omega(double value) { if (value > 0 && value < 2) omega_ = value; }
+
+  /** @brief Returns the number of sweeps per application */
+  unsigned int sweeps() const { return sweeps_; }
+  /** @brief Sets the number of sweeps per application */
+  void sweeps(unsigned int value) { sweeps_ = value; }
+
+  /** @brief Returns true if symmetric sweeps (SSOR) are used */
+  bool symmetric() const { return symmetric_; }
+  /** @brief Selects symmetric sweeps (SSOR, true) or forward sweeps only (SOR, false) */
+  void symmetric(bool value) { symmetric_ = value; }
+
+private:
+  double omega_;
+  unsigned int sweeps_;
+  bool symmetric_;
+};
+
+
+namespace detail
+{
+
+  /** @brief Computes a multicolor ordering of the rows of a sparse matrix in host memory by a greedy (first fit) coloring of the symmetrized adjacency graph.
+  *
+  * No two rows of the same color are coupled by a nonzero entry of A or A^T, hence all rows of one color can be relaxed in parallel.
+  * On exit, the rows of color c are color_rows[color_offsets[c]], ..., color_rows[color_offsets[c+1] - 1] in increasing order.
+  *
+  * @param A               The sparse matrix (in host memory)
+  * @param color_offsets   Offsets of the colors in 'color_rows'. Has (number of colors + 1) entries on exit.
+  * @param color_rows      The row indices, grouped by color
+  */
+  template<typename NumericT, unsigned int AlignmentV>
+  void multicolor_setup(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                        std::vector<unsigned int> & color_offsets,
+                        std::vector<unsigned int> & color_rows)
+  {
+    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+    unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+    vcl_size_t size = A.size1();
+
+    // pattern of A^T (required if the pattern of A is not symmetric):
+    std::vector<unsigned int> trans_row_buffer(size + 1, 0);
+    for (vcl_size_t i = 0; i < A.nnz(); ++i)
+      if (col_buffer[i] < size)
+        ++trans_row_buffer[col_buffer[i] + 1];
+    for (vcl_size_t i = 0; i < size; ++i)
+      trans_row_buffer[i+1] += trans_row_buffer[i];
+
+    std::vector<unsigned int> trans_col_buffer(trans_row_buffer[size]);
+    std::vector<unsigned int> trans_insert_pos(trans_row_buffer.begin(), trans_row_buffer.end() - 1);
+    for (vcl_size_t row = 0; row < size; ++row)
+      for (vcl_size_t i = row_buffer[row]; i < row_buffer[row+1]; ++i)
+        if (col_buffer[i] < size)
+          trans_col_buffer[trans_insert_pos[col_buffer[i]]++] = static_cast<unsigned int>(row);
+
+    // greedy coloring:
+    unsigned int const uncolored = static_cast<unsigned int>(-1);
+    std::vector<unsigned int> colors(size, uncolored);
+    std::vector<vcl_size_t>   color_last_used_by;   //stores the row for which a color has been marked as forbidden last
+    unsigned int num_colors = 0;
+
+    for (vcl_size_t row = 0; row < size; ++row)
+    {
+      for (vcl_size_t i = row_buffer[row]; i < row_buffer[row+1]; ++i)
+        if (col_buffer[i] < size && colors[col_buffer[i]] != uncolored)
+          color_last_used_by[colors[col_buffer[i]]] = row;
+      for (vcl_size_t i = trans_row_buffer[row]; i < trans_row_buffer[row+1]; ++i)
+        if (colors[trans_col_buffer[i]] != uncolored)
+          color_last_used_by[colors[trans_col_buffer[i]]] = row;
+
+      unsigned int c = 0;
+      while (c < num_colors && color_last_used_by[c] == row)
+        ++c;
+      if (c == num_colors)
+      {
+        ++num_colors;
+        color_last_used_by.push_back(size);
+      }
+      colors[row] = c;
+    }
+
+    // group rows by color:
+    color_offsets.assign(num_colors + 1, 0);
+    for (vcl_size_t row = 0; row < size; ++row)
+      ++color_offsets[colors[row] + 1];
+    for (unsigned int c = 0; c < num_colors; ++c)
+      color_offsets[c+1] += color_offsets[c];
+
+    color_rows.resize(size);
+    std::vector<unsigned int> insert_pos(color_offsets.begin(), color_offsets.end() - 1);
+    for (vcl_size_t row = 0; row < size; ++row)
+      color_rows[insert_pos[colors[row]]++] = static_cast<unsigned int>(row);
+  }
+
+  /** @brief Carries out one forward or backward SOR sweep over all colors for the system A x = rhs. All data needs to reside in host memory.
+  *
+  * The rows of each color are relaxed in parallel:
+  *   x_i += omega * (rhs_i - sum_j a_ij x_j) / a_ii
+  */
+  template<typename NumericT, unsigned int AlignmentV>
+  void multicolor_sor_sweep(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                            viennacl::vector<NumericT> const & diag,
+                            std::vector<unsigned int> const & color_offsets,
+                            std::vector<unsigned int> const & color_rows,
+                            viennacl::vector<NumericT> & x,
+                            viennacl::vector<NumericT> const & rhs,
+                            NumericT omega,
+                            bool forward)
+  {
+    NumericT           * x_buffer    = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(x.handle());
+    NumericT     const * rhs_buffer  = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(rhs.handle());
+    NumericT     const * diag_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(diag.handle());
+    NumericT     const * elements    = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+    unsigned int const * row_buffer  = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+    unsigned int const * col_buffer  = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+    vcl_size_t num_colors = color_offsets.size() - 1;
+    for (vcl_size_t c2 = 0; c2 < num_colors; ++c2)
+    {
+      vcl_size_t c = forward ? c2 : num_colors - c2 - 1;
+      long color_start = static_cast<long>(color_offsets[c]);
+      long color_stop  = static_cast<long>(color_offsets[c+1]);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (color_stop - color_start > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+      for (long k = color_start; k < color_stop; ++k)
+      {
+        unsigned int row = color_rows[static_cast<vcl_size_t>(k)];
+        NumericT residual = rhs_buffer[row];
+        unsigned int row_end = row_buffer[row+1];
+        for (unsigned int i = row_buffer[row]; i < row_end; ++i)
+          residual -= elements[i] * x_buffer[col_buffer[i]];
+        x_buffer[row] += omega * residual / diag_buffer[row];
+      }
+    }
+  }
+
+} //namespace detail
+
+
+/** @brief Multicolor SSOR preconditioner for compressed_matrix, can be supplied to solve()-routines.
+*
+* A multicolor ordering of the rows is computed once in the constructor. Each sweep then relaxes the rows color by color, where all rows of one color are processed in parallel.
+* The sweeps are carried out in host memory. For other backends, the matrix is copied to the host once and the vector is transferred on each application (as for ILU0 without level scheduling).
+*/
+template<typename MatrixT>
+class ssor_precond;
+
+template<typename NumericT, unsigned int AlignmentV>
+class ssor_precond< viennacl::compressed_matrix<NumericT, AlignmentV> >
+{
+  typedef viennacl::compressed_matrix<NumericT, AlignmentV>   MatrixType;
+
+public:
+  ssor_precond(MatrixType const & mat, ssor_tag const & tag) : tag_(tag)
+  {
+    init(mat);
+  }
+
+  /** @brief Applies the preconditioner, i.e. computes tag.sweeps() (symmetric) sweeps for A x = vec starting from x = 0 and overwrites vec with x. */
+  void apply(viennacl::vector<NumericT> & vec) const
+  {
+    viennacl::context old_context = viennacl::traits::context(vec);
+    bool on_host = (vec.handle().get_active_handle_id() == viennacl::MAIN_MEMORY);
+    if (!on_host)
+      viennacl::switch_memory_context(vec, viennacl::context(viennacl::MAIN_MEMORY));
+
+    rhs_ = vec;
+    viennacl::traits::clear(vec);
+    for (unsigned int i = 0; i < tag_.sweeps(); ++i)
+    {
+      detail::multicolor_sor_sweep(A_, diag_, color_offsets_, color_rows_, vec, rhs_, NumericT(tag_.omega()), true);
+      if (tag_.symmetric())
+        detail::multicolor_sor_sweep(A_, diag_, color_offsets_, color_rows_, vec, rhs_, NumericT(tag_.omega()), false);
+    }
+
+    if (!on_host)
+      viennacl::switch_memory_context(vec, old_context);
+  }
+
+  /** @brief Carries out 'sweeps' forward (or backward) sweeps with the relaxation parameter of the tag for A x = rhs. Used as a smoother in multigrid methods.
+  *
+  * @param x        The current approximation, updated in place
+  * @param rhs      The right hand side
+  * @param sweeps   Number of sweeps
+  * @param forward  Relax the colors in forward (true) or backward (false) order
+  */
+  void smooth(viennacl::vector<NumericT> & x, viennacl::vector<NumericT> const & rhs, unsigned int sweeps, bool forward) const
+  {
+    if (sweeps == 0)
+      return;
+
+    viennacl::context old_context = viennacl::traits::context(x);
+    bool on_host = (x.handle().get_active_handle_id() == viennacl::MAIN_MEMORY);
+    if (!on_host)
+      viennacl::switch_memory_context(x, viennacl::context(viennacl::MAIN_MEMORY));
+
+    if (on_host)
+      rhs_ = rhs;
+    else
+    {
+      viennacl::vector<NumericT> rhs_host(rhs);
+      viennacl::switch_memory_context(rhs_host, viennacl::context(viennacl::MAIN_MEMORY));
+      rhs_ = rhs_host;
+    }
+    for (unsigned int i = 0; i < sweeps; ++i)
+      detail::multicolor_sor_sweep(A_, diag_, color_offsets_, color_rows_, x, rhs_, NumericT(tag_.omega()), forward);
+
+    if (!on_host)
+      viennacl::switch_memory_context(x, old_context);
+  }
+
+  /** @brief Updates the preconditioner for new values of a system matrix with the same sparsity pattern. The multicolor ordering is kept.
+  *
+  * @param mat  System matrix with new values and the sparsity pattern of the matrix passed to the constructor
+  */
+  void update_values(MatrixType const & mat)
+  {
+    assert(mat.size1() == A_.size1() && mat.nnz() == A_.nnz() && bool("Sparsity pattern of the system matrix changed"));
+
+    // only the entries are transferred, the row and column arrays are unchanged:
+    viennacl::backend::memory_read(mat.handle(), 0, sizeof(NumericT) * mat.nnz(),
+                                   viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A_.handle()));
+    viennacl::linalg::host_based::detail::row_info(A_, diag_, viennacl::linalg::detail::SPARSE_ROW_DIAGONAL);
+  }
+
+  /** @brief Returns the number of colors of the multicolor ordering */
+  vcl_size_t colors() const { return color_offsets_.size() - 1; }
+
+private:
+  void init(MatrixType const & mat)
+  {
+    viennacl::context host_context(viennacl::MAIN_MEMORY);
+    viennacl::switch_memory_context(A_, host_context);
+    viennacl::switch_memory_context(diag_, host_context);
+    viennacl::switch_memory_context(rhs_, host_context);
+
+    A_ = mat;
+    diag_.resize(A_.size1(), false);
+    rhs_.resize(A_.size1(), false);
+    viennacl::linalg::host_based::detail::row_info(A_, diag_, viennacl::linalg::detail::SPARSE_ROW_DIAGONAL);
+
+    detail::multicolor_setup(A_, color_offsets_, color_rows_);
+  }
+
+  ssor_tag tag_;
+  MatrixType A_;
+  viennacl::vector<NumericT> diag_;
+  std::vector<unsigned int> color_offsets_;
+  std::vector<unsigned int> color_rows_;
+
+  mutable viennacl::vector<NumericT> rhs_;
+};
+
+}
+}
+
+
+
+
+#endif
@@ -302,9 +302,14 @@ matrix_base<NumericT, SizeT, DistanceT> & matrix_base<NumericT, SizeT, DistanceT
     internal_size2_ = viennacl::tools::align_to_multiple<size_type>(size2_, dense_padding_size);
     if (!row_major_fixed_)
       row_major_ = viennacl::traits::row_major(proxy);
+    viennacl::backend::memory_create(elements_, sizeof(NumericT)*internal_size(), viennacl::traits::context(proxy));
+    if (size1_ != internal_size1_ || size2_ != internal_size2_)
+      clear();
   }
 
-  if ( handle() == proxy.lhs().handle() )
+  if ( &proxy.lhs() == this && size1() == size2() && viennacl::traits::active_handle_id(*this) == viennacl::MAIN_MEMORY )
+    viennacl::linalg::inplace_trans(*this); // A = trans(A) for square A in host memory: no temporary required
+  else if ( handle() == proxy.lhs().handle() )
   {
     viennacl::matrix_base<NumericT> temp(proxy.lhs().size2(), proxy.lhs().size1(),proxy.lhs().row_major());
     viennacl::linalg::trans(proxy, temp);
@@ -678,8 +683,14 @@ public:
   explicit matrix(cl_mem mem, size_type rows, size_type columns) : base_type(mem, rows, columns, viennacl::is_row_major<F>::value) {}
 #endif
 
+  /** @brief Creates the matrix from the result of an expression. The layout is given by F, not by the operands of the expression. */
   template<typename LHS, typename RHS, typename OP>
-  matrix(matrix_expression< LHS, RHS, OP> const & proxy) : base_type(proxy) {}
+  matrix(matrix_expression< LHS, RHS, OP> const & proxy)
+    : base_type(viennacl::traits::size1(proxy), viennacl::traits::size2(proxy), viennacl::is_row_major<F>::value, viennacl::traits::context(proxy))
+  {
+    if (base_type::internal_size() > 0)
+      base_type::operator=(proxy);
+  }
 
   /** @brief Creates the matrix from the supplied identity matrix. */
   matrix(identity_matrix<NumericT> const & m) : base_type(m.size1(), m.size2(), viennacl::is_row_major<F>::value, m.context())
@@ -0,0 +1,212 @@
+#ifndef VIENNACL_MISC_NESTED_DISSECTION_HPP
+#define VIENNACL_MISC_NESTED_DISSECTION_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/misc/nested_dissection.hpp
+*    @brief Implementation of a nested dissection ordering based on level structures for reducing the fill-in of sparse factorizations.  Experimental.
+*/
+
+#include <map>
+#include <vector>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+
+namespace viennacl
+{
+namespace detail
+{
+
+  /** @brief Breadth-first search within the vertices marked with 'subset_id', starting at 'root'.
+  *
+  * @return The vertices in the order visited. The level of each visited vertex is stored in 'level'.
+  */
+  inline std::vector<vcl_size_t> nested_dissection_bfs(std::vector<vcl_size_t> const & adj_offsets,
+                                                       std::vector<vcl_size_t> const & adj,
+                                                       std::vector<vcl_size_t> const & subset,
+                                                       vcl_size_t subset_id,
+                                                       vcl_size_t root,
+                                                       std::vector<vcl_size_t> & visited,
+                                                       vcl_size_t & visit_id,
+                                                       std::vector<vcl_size_t> & level)
+  {
+    ++visit_id;
+    std::vector<vcl_size_t> queue;
+    queue.push_back(root);
+    visited[root] = visit_id;
+    level[root] = 0;
+
+    for (vcl_size_t k = 0; k < queue.size(); ++k)
+    {
+      vcl_size_t v = queue[k];
+      for (vcl_size_t i = adj_offsets[v]; i < adj_offsets[v+1]; ++i)
+      {
+        vcl_size_t w = adj[i];
+        if (subset[w] == subset_id && visited[w] != visit_id)
+        {
+          visited[w] = visit_id;
+          level[w] = level[v] + 1;
+          queue.push_back(w);
+        }
+      }
+    }
+    return queue;
+  }
+
+  /** @brief Recursively orders the vertices in 'vertices': Both parts of the graph separated by the middle level of a level structure rooted at a pseudo-peripheral vertex are ordered first, the separator last. */
+  inline void nested_dissection_recurse(std::vector<vcl_size_t> const & adj_offsets,
+                                        std::vector<vcl_size_t> const & adj,
+                                        std::vector<vcl_size_t> const & vertices,
+                                        vcl_size_t leaf_size,
+                                        std::vector<vcl_size_t> & subset,
+                                        vcl_size_t & subset_counter,
+                                        std::vector<vcl_size_t> & visited,
+                                        vcl_size_t & visit_id,
+                                        std::vector<vcl_size_t> & level,
+                                        std::vector<vcl_size_t> & order)
+  {
+    if (vertices.size() <= std::max<vcl_size_t>(leaf_size, 2))
+    {
+      order.insert(order.end(), vertices.begin(), vertices.end());
+      return;
+    }
+
+    vcl_size_t subset_id = ++subset_counter;
+    for (vcl_size_t k = 0; k < vertices.size(); ++k)
+      subset[vertices[k]] = subset_id;
+
+    // pseudo-peripheral root: repeatedly restart from a vertex in the last level as long as the number of levels increases
+    std::vector<vcl_size_t> bfs = nested_dissection_bfs(adj_offsets, adj, subset, subset_id, vertices[0], visited, visit_id, level);
+    for (vcl_size_t iter = 0; iter < 4 && bfs.size() == vertices.size(); ++iter)
+    {
+      vcl_size_t eccentricity = level[bfs.back()];
+      bfs = nested_dissection_bfs(adj_offsets, adj, subset, subset_id, bfs.back(), visited, visit_id, level);
+      if (level[bfs.back()] <= eccentricity)
+        break;
+    }
+
+    if (bfs.size() < vertices.size()) // graph not connected: the connected component of the root and the rest are independent
+    {
+      std::vector<vcl_size_t> rest;
+      rest.reserve(vertices.size() - bfs.size());
+      for (vcl_size_t k = 0; k < vertices.size(); ++k)
+        if (visited[vertices[k]] != visit_id)
+          rest.push_back(vertices[k]);
+
+      nested_dissection_recurse(adj_offsets, adj, bfs,  leaf_size, subset, subset_counter, visited, visit_id, level, order);
+      nested_dissection_recurse(adj_offsets, adj, rest, leaf_size, subset, subset_counter, visited, visit_id, level, order);
+      return;
+    }
+
+    vcl_size_t num_levels = level[bfs.back()] + 1;
+    if (num_levels < 3) // no separator with two nonempty parts available
+    {
+      order.insert(order.end(), vertices.begin(), vertices.end());
+      return;
+    }
+
+    vcl_size_t separator_level = num_levels / 2;
+    std::vector<vcl_size_t> part1, part2, separator;
+    for (vcl_size_t k = 0; k < bfs.size(); ++k)
+    {
+      vcl_size_t v = bfs[k];
+      if (level[v] < separator_level)
+        part1.push_back(v);
+      else if (level[v] > separator_level)
+        part2.push_back(v);
+      else
+        separator.push_back(v);
+    }
+
+    nested_dissection_recurse(adj_offsets, adj, part1, leaf_size, subset, subset_counter, visited, visit_id, level, order);
+    nested_dissection_recurse(adj_offsets, adj, part2, leaf_size, subset, subset_counter, visited, visit_id, level, order);
+    order.insert(order.end(), separator.begin(), separator.end());
+  }
+
+} //namespace detail
+
+
+/** @brief A tag class for selecting the nested dissection ordering for reducing the fill-in of sparse Cholesky or LU factorizations. */
+class nested_dissection_tag
+{
+public:
+  /** @brief The constructor
+  *
+  * @param leaf_size   Subgraphs with at most this number of vertices are not dissected further
+  */
+  nested_dissection_tag(vcl_size_t leaf_size = 64) : leaf_size_(leaf_size) {}
+
+  vcl_size_t leaf_size() const { return leaf_size_; }
+  void leaf_size(vcl_size_t value) { leaf_size_ = value; }
+
+private:
+  vcl_size_t leaf_size_;
+};
+
+
+/** @brief Function for the calculation of a node number permutation reducing the fill-in of a factorization of a sparse matrix with symmetric sparsity pattern by nested dissection
+ *
+ * The graph is dissected recursively by the middle level of a level structure rooted at a pseudo-peripheral node,
+ * cf. A. George, Nested Dissection of a Regular Finite Element Mesh, SIAM J. Numer. Anal. 10(2), 345-363 (1973).
+ * The separator vertices are numbered after the vertices of the two parts.
+ *
+ * @param matrix  vector of n matrix rows, where each row is a map<int, double> containing only the nonzero elements
+ * @return permutation vector r. r[l] = i means that the new label of node i will be l.
+ */
+template<typename IndexT, typename ValueT>
+std::vector<IndexT> reorder(std::vector< std::map<IndexT, ValueT> > const & matrix, nested_dissection_tag const & tag)
+{
+  vcl_size_t n = matrix.size();
+
+  // adjacency lists without self-loops:
+  std::vector<vcl_size_t> adj_offsets(n + 1, 0);
+  std::vector<vcl_size_t> adj;
+  for (vcl_size_t i = 0; i < n; ++i)
+  {
+    for (typename std::map<IndexT, ValueT>::const_iterator it = matrix[i].begin(); it != matrix[i].end(); ++it)
+      if (static_cast<vcl_size_t>(it->first) != i && static_cast<vcl_size_t>(it->first) < n)
+        adj.push_back(static_cast<vcl_size_t>(it->first));
+    adj_offsets[i+1] = adj.size();
+  }
+
+  std::vector<vcl_size_t> vertices(n);
+  for (vcl_size_t i = 0; i < n; ++i)
+    vertices[i] = i;
+
+  std::vector<vcl_size_t> subset(n, 0);
+  std::vector<vcl_size_t> visited(n, 0);
+  std::vector<vcl_size_t> level(n, 0);
+  vcl_size_t subset_counter = 0;
+  vcl_size_t visit_id = 0;
+
+  std::vector<vcl_size_t> order;
+  order.reserve(n);
+  detail::nested_dissection_recurse(adj_offsets, adj, vertices, tag.leaf_size(), subset, subset_counter, visited, visit_id, level, order);
+
+  std::vector<IndexT> permutation(n);
+  for (vcl_size_t k = 0; k < n; ++k)
+    permutation[order[k]] = static_cast<IndexT>(k);
+  return permutation;
+}
+
+} //namespace viennacl
+
+
+#endif
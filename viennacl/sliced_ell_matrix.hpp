@@ -25,6 +25,9 @@
 */
 
 
+#include <vector>
+#include <algorithm>
+
 #include "viennacl/forwards.h"
 #include "viennacl/vector.hpp"
 
@@ -34,13 +37,30 @@
 
 namespace viennacl
 {
+namespace detail
+{
+  /** @brief Orders row indices by decreasing number of nonzeros. Used for the sigma-window sorting of SELL-C-sigma. */
+  struct sliced_ell_row_length_greater
+  {
+    sliced_ell_row_length_greater(std::vector<vcl_size_t> const & entries_per_row) : entries_per_row_(entries_per_row) {}
+
+    bool operator()(vcl_size_t a, vcl_size_t b) const { return entries_per_row_[a] > entries_per_row_[b]; }
+
+    std::vector<vcl_size_t> const & entries_per_row_;
+  };
+}
+
 /** @brief Sparse matrix class using the sliced ELLPACK with parameters C, \sigma
   *
   * Based on the SELL-C-\sigma format provided by Kreutzer et al., 2014
   * Can be seen as a block-wise ELLPACK format, where C rows are accumulated into the same block
   * for which a column-wise storage is used. Enables fully-coalesced reads from global memory.
   *
-  * Note: Currently \sigma is fixed to 1, since the sorting of rows
+  * Within windows of \sigma consecutive rows, the rows are sorted by decreasing number of nonzeros before being assigned to blocks.
+  * This reduces the zero-padding of each block. The resulting row permutation is stored in handle4(), which maps the i-th stored row to its row index in the matrix.
+  * With \sigma = 1 (default) no sorting takes place.
+  *
+  * On the CPU, C should be a multiple of the SIMD width (4, 8, or 16), and \sigma a multiple of C.
   */
 template<typename ScalarT, typename IndexT /* see forwards.h = unsigned int */>
 class sliced_ell_matrix
@@ -50,20 +70,23 @@ public:
   typedef scalar<typename viennacl::tools::CHECK_SCALAR_TEMPLATE_ARGUMENT<ScalarT>::ResultType>   value_type;
   typedef vcl_size_t                                                                              size_type;
 
-  explicit sliced_ell_matrix() : rows_(0), cols_(0), rows_per_block_(128) {}
+  explicit sliced_ell_matrix() : rows_(0), cols_(0), rows_per_block_(128), sigma_(1) {}
 
   sliced_ell_matrix(size_type num_rows,
                     size_type num_cols,
-                    size_type num_rows_per_block_ = 128)
+                    size_type num_rows_per_block_ = 128,
+                    size_type sigma = 1)
     : rows_(num_rows),
       cols_(num_cols),
-      rows_per_block_(num_rows_per_block_) {}
+      rows_per_block_(num_rows_per_block_),
+      sigma_(std::max<size_type>(sigma, 1)) {}
 
-  explicit sliced_ell_matrix(viennacl::context ctx) : rows_(0), cols_(0), rows_per_block_(128)
+  explicit sliced_ell_matrix(viennacl::context ctx) : rows_(0), cols_(0), rows_per_block_(128), sigma_(1)
   {
     columns_per_block_.switch_active_handle_id(ctx.memory_type());
     column_indices_.switch_active_handle_id(ctx.memory_type());
     block_start_.switch_active_handle_id(ctx.memory_type());
+    row_indices_.switch_active_handle_id(ctx.memory_type());
     elements_.switch_active_handle_id(ctx.memory_type());
 
 #ifdef VIENNACL_WITH_OPENCL
@@ -72,6 +95,7 @@ public:
       columns_per_block_.opencl_handle().context(ctx.opencl_context());
       column_indices_.opencl_handle().context(ctx.opencl_context());
       block_start_.opencl_handle().context(ctx.opencl_context());
+      row_indices_.opencl_handle().context(ctx.opencl_context());
       elements_.opencl_handle().context(ctx.opencl_context());
     }
 #endif
@@ -83,11 +107,16 @@ public:
     viennacl::backend::typesafe_host_array<IndexT> host_columns_per_block_buffer(columns_per_block_, rows_ / rows_per_block_ + 1);
     viennacl::backend::typesafe_host_array<IndexT> host_column_buffer(column_indices_, internal_size1());
     viennacl::backend::typesafe_host_array<IndexT> host_block_start_buffer(block_start_, (rows_ - 1) / rows_per_block_ + 1);
+    viennacl::backend::typesafe_host_array<IndexT> host_row_indices_buffer(row_indices_, rows_);
     std::vector<ScalarT> host_elements(1);
 
+    for (vcl_size_t i = 0; i < rows_; ++i)
+      host_row_indices_buffer.set(i, i);
+
     viennacl::backend::memory_create(columns_per_block_, host_columns_per_block_buffer.element_size() * (rows_ / rows_per_block_ + 1), viennacl::traits::context(columns_per_block_), host_columns_per_block_buffer.get());
     viennacl::backend::memory_create(column_indices_,    host_column_buffer.element_size() * internal_size1(),                         viennacl::traits::context(column_indices_),    host_column_buffer.get());
     viennacl::backend::memory_create(block_start_,       host_block_start_buffer.element_size() * ((rows_ - 1) / rows_per_block_ + 1), viennacl::traits::context(block_start_),       host_block_start_buffer.get());
+    viennacl::backend::memory_create(row_indices_,       host_row_indices_buffer.raw_size(),                                           viennacl::traits::context(row_indices_),       host_row_indices_buffer.get());
     viennacl::backend::memory_create(elements_,          sizeof(ScalarT) * 1,                                                          viennacl::traits::context(elements_),          &(host_elements[0]));
   }
 
@@ -99,6 +128,9 @@ public:
 
   vcl_size_t rows_per_block() const { return rows_per_block_; }
 
+  /** @brief Returns the size of the windows within which rows are sorted by their number of nonzeros (parameter sigma of SELL-C-sigma) */
+  vcl_size_t sigma() const { return sigma_; }
+
   //vcl_size_t nnz() const { return rows_ * maxnnz_; }
   //vcl_size_t internal_nnz() const { return internal_size1() * internal_maxnnz(); }
 
@@ -111,6 +143,10 @@ public:
   handle_type & handle3()       { return block_start_; }
   const handle_type & handle3() const { return block_start_; }
 
+  /** @brief Returns the handle to the row permutation: Entry i holds the row index of the i-th stored row. */
+  handle_type & handle4()       { return row_indices_; }
+  const handle_type & handle4() const { return row_indices_; }
+
   handle_type & handle()       { return elements_; }
   const handle_type & handle() const { return elements_; }
 
@@ -126,10 +162,12 @@ private:
   vcl_size_t rows_;
   vcl_size_t cols_;
   vcl_size_t rows_per_block_; //parameter C in the paper by Kreutzer et al.
+  vcl_size_t sigma_;          //parameter sigma in the paper by Kreutzer et al.
 
   handle_type columns_per_block_;
   handle_type column_indices_;
   handle_type block_start_;
+  handle_type row_indices_;
   handle_type elements_;
 };
 
@@ -141,27 +179,56 @@ void copy(CPUMatrixT const & cpu_matrix, sliced_ell_matrix<ScalarT, IndexT> & gp
 
   if (viennacl::traits::size1(cpu_matrix) > 0 && viennacl::traits::size2(cpu_matrix) > 0)
   {
-    //determine max capacity for row
-    IndexT columns_in_current_block = 0;
-    vcl_size_t row_counter_in_current_block = 0;
-    vcl_size_t total_element_buffer_size = 0;
-    viennacl::backend::typesafe_host_array<IndexT> columns_in_block_buffer(gpu_matrix.handle1(), viennacl::traits::size1(cpu_matrix) / gpu_matrix.rows_per_block() + 1);
+    vcl_size_t num_rows       = viennacl::traits::size1(cpu_matrix);
+    vcl_size_t rows_per_block = gpu_matrix.rows_per_block();
+    vcl_size_t num_blocks     = num_rows / rows_per_block + 1;
+
+    //determine number of entries per row
+    std::vector<vcl_size_t> entries_per_row(num_rows);
     for (typename CPUMatrixT::const_iterator1 row_it = cpu_matrix.begin1(); row_it != cpu_matrix.end1(); ++row_it)
     {
-      ++row_counter_in_current_block;
       vcl_size_t entries_in_row = 0;
       for (typename CPUMatrixT::const_iterator2 col_it = row_it.begin(); col_it != row_it.end(); ++col_it)
         ++entries_in_row;
+      entries_per_row[row_it.index1()] = entries_in_row;
+    }
 
-      columns_in_current_block = std::max(columns_in_current_block, static_cast<IndexT>(entries_in_row));
+    //sort rows by decreasing number of entries within each window of sigma rows
+    std::vector<vcl_size_t> stored_row_to_row(num_rows);
+    for (vcl_size_t i = 0; i < num_rows; ++i)
+      stored_row_to_row[i] = i;
+    if (gpu_matrix.sigma() > 1)
+    {
+      for (vcl_size_t window_start = 0; window_start < num_rows; window_start += gpu_matrix.sigma())
+        std::stable_sort(stored_row_to_row.begin() + static_cast<long>(window_start),
+                         stored_row_to_row.begin() + static_cast<long>(std::min(window_start + gpu_matrix.sigma(), num_rows)),
+                         detail::sliced_ell_row_length_greater(entries_per_row));
+    }
 
-      if ( (row_it.index1() % gpu_matrix.rows_per_block() == gpu_matrix.rows_per_block() - 1)
-           || row_it.index1() == viennacl::traits::size1(cpu_matrix) - 1)
-      {
-        total_element_buffer_size += columns_in_current_block * gpu_matrix.rows_per_block();
-        columns_in_block_buffer.set(row_it.index1() / gpu_matrix.rows_per_block(), columns_in_current_block);
-        columns_in_current_block = 0;
-      }
+    std::vector<vcl_size_t> row_to_stored_row(num_rows);
+    viennacl::backend::typesafe_host_array<IndexT> row_indices(gpu_matrix.handle4(), num_rows);
+    for (vcl_size_t i = 0; i < num_rows; ++i)
+    {
+      row_to_stored_row[stored_row_to_row[i]] = i;
+      row_indices.set(i, stored_row_to_row[i]);
+    }
+
+    //determine max capacity for each block
+    viennacl::backend::typesafe_host_array<IndexT> columns_in_block_buffer(gpu_matrix.handle1(), num_blocks);
+    viennacl::backend::typesafe_host_array<IndexT> block_start(gpu_matrix.handle3(), (num_rows - 1) / rows_per_block + 1);
+    std::vector<vcl_size_t> block_offsets(num_blocks);
+    vcl_size_t total_element_buffer_size = 0;
+    for (vcl_size_t block_index = 0; block_index < num_blocks; ++block_index)
+    {
+      vcl_size_t columns_in_current_block = 0;
+      for (vcl_size_t i = block_index * rows_per_block; i < std::min((block_index + 1) * rows_per_block, num_rows); ++i)
+        columns_in_current_block = std::max(columns_in_current_block, entries_per_row[stored_row_to_row[i]]);
+
+      columns_in_block_buffer.set(block_index, columns_in_current_block);
+      block_offsets[block_index] = total_element_buffer_size;
+      if (block_index * rows_per_block < num_rows)
+        block_start.set(block_index, total_element_buffer_size);
+      total_element_buffer_size += columns_in_current_block * rows_per_block;
     }
 
     //setup GPU matrix
@@ -169,40 +236,35 @@ void copy(CPUMatrixT const & cpu_matrix, sliced_ell_matrix<ScalarT, IndexT> & gp
     gpu_matrix.cols_ = cpu_matrix.size2();
 
     viennacl::backend::typesafe_host_array<IndexT> coords(gpu_matrix.handle2(), total_element_buffer_size);
-    viennacl::backend::typesafe_host_array<IndexT> block_start(gpu_matrix.handle3(), (viennacl::traits::size1(cpu_matrix) - 1) / gpu_matrix.rows_per_block() + 1);
     std::vector<ScalarT> elements(total_element_buffer_size, 0);
 
-    vcl_size_t block_offset = 0;
-    vcl_size_t block_index  = 0;
-    vcl_size_t row_in_block = 0;
     for (typename CPUMatrixT::const_iterator1 row_it = cpu_matrix.begin1(); row_it != cpu_matrix.end1(); ++row_it)
     {
+      vcl_size_t stored_row   = row_to_stored_row[row_it.index1()];
+      vcl_size_t block_index  = stored_row / rows_per_block;
+      vcl_size_t block_offset = block_offsets[block_index];
+      vcl_size_t row_in_block = stored_row % rows_per_block;
       vcl_size_t entry_in_row = 0;
+      vcl_size_t last_column  = 0;
 
       for (typename CPUMatrixT::const_iterator2 col_it = row_it.begin(); col_it != row_it.end(); ++col_it)
       {
-        vcl_size_t buffer_index = block_offset + entry_in_row * gpu_matrix.rows_per_block() + row_in_block;
+        vcl_size_t buffer_index = block_offset + entry_in_row * rows_per_block + row_in_block;
         coords.set(buffer_index, col_it.index2());
         elements[buffer_index] = *col_it;
+        last_column = col_it.index2();
         entry_in_row++;
       }
 
-      ++row_in_block;
-
-      // check for end of block:
-      if ( (row_it.index1() % gpu_matrix.rows_per_block() == gpu_matrix.rows_per_block() - 1)
-           || row_it.index1() == viennacl::traits::size1(cpu_matrix) - 1)
-      {
-        block_start.set(block_index, static_cast<IndexT>(block_offset));
-        block_offset += columns_in_block_buffer[block_index] * gpu_matrix.rows_per_block();
-        ++block_index;
-        row_in_block = 0;
-      }
+      // padding entries carry a zero value and repeat the last column index, so that they stay in cache lines already loaded. Kernels skip them by their zero value:
+      for (; entry_in_row < columns_in_block_buffer[block_index]; ++entry_in_row)
+        coords.set(block_offset + entry_in_row * rows_per_block + row_in_block, last_column);
     }
 
     viennacl::backend::memory_create(gpu_matrix.handle1(), columns_in_block_buffer.raw_size(), traits::context(gpu_matrix.handle1()), columns_in_block_buffer.get());
     viennacl::backend::memory_create(gpu_matrix.handle2(), coords.raw_size(),                  traits::context(gpu_matrix.handle2()), coords.get());
     viennacl::backend::memory_create(gpu_matrix.handle3(), block_start.raw_size(),             traits::context(gpu_matrix.handle3()), block_start.get());
+    viennacl::backend::memory_create(gpu_matrix.handle4(), row_indices.raw_size(),             traits::context(gpu_matrix.handle4()), row_indices.get());
     viennacl::backend::memory_create(gpu_matrix.handle(),  sizeof(ScalarT) * elements.size(),  traits::context(gpu_matrix.handle()), &(elements[0]));
   }
 }